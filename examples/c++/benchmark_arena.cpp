@@ -0,0 +1,161 @@
+/**
+ * @file    benchmark_arena.cpp
+ * @brief   Compares reading and freeing documents with and without an arena
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <sedml/SedTypes.h>
+LIBSEDML_CPP_NAMESPACE_USE
+
+using namespace std;
+using namespace std::chrono;
+
+// 
+// creates a parameter scan: one repeated task per parameter value, each
+// with a set value change, and a data generator per repeated task
+// 
+string createDocument(unsigned int numScans)
+{
+  ostringstream str;
+  str << "<?xml version='1.0' encoding='UTF-8'?>\n"
+      << "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version4' "
+      << "xmlns:math='http://www.w3.org/1998/Math/MathML' "
+      << "level='1' version='4'>\n"
+      << "  <listOfModels>\n"
+      << "    <model id='model1' language='urn:sedml:language:sbml' source='model1.xml'/>\n"
+      << "  </listOfModels>\n"
+      << "  <listOfSimulations>\n"
+      << "    <uniformTimeCourse id='sim1' initialTime='0' outputStartTime='0' "
+      << "outputEndTime='10' numberOfSteps='100'>\n"
+      << "      <algorithm kisaoID='KISAO:0000019'/>\n"
+      << "    </uniformTimeCourse>\n"
+      << "  </listOfSimulations>\n"
+      << "  <listOfTasks>\n"
+      << "    <task id='task1' modelReference='model1' simulationReference='sim1'/>\n";
+
+  for (unsigned int i = 0; i < numScans; ++i)
+  {
+    str << "    <repeatedTask id='repeat" << i << "' range='range" << i
+        << "' resetModel='true'>\n"
+        << "      <listOfRanges>\n"
+        << "        <uniformRange id='range" << i
+        << "' start='0' end='1' numberOfPoints='10' type='linear'/>\n"
+        << "      </listOfRanges>\n"
+        << "      <listOfChanges>\n"
+        << "        <setValue modelReference='model1' range='range" << i
+        << "' target=\"/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']\"/>\n"
+        << "      </listOfChanges>\n"
+        << "      <listOfSubTasks>\n"
+        << "        <subTask order='1' task='task1'/>\n"
+        << "      </listOfSubTasks>\n"
+        << "    </repeatedTask>\n";
+  }
+
+  str << "  </listOfTasks>\n"
+      << "  <listOfDataGenerators>\n";
+
+  for (unsigned int i = 0; i < numScans; ++i)
+  {
+    str << "    <dataGenerator id='dg" << i << "'>\n"
+        << "      <listOfVariables>\n"
+        << "        <variable id='var" << i << "' taskReference='repeat" << i
+        << "' target=\"/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S1']\"/>\n"
+        << "      </listOfVariables>\n"
+        << "      <math:math><math:ci>var" << i << "</math:ci></math:math>\n"
+        << "    </dataGenerator>\n";
+  }
+
+  str << "  </listOfDataGenerators>\n"
+      << "</sedML>\n";
+
+  return str.str();
+}
+
+void run(const char* label, const string& xml, bool useArena, unsigned int repeats)
+{
+  SedReader reader;
+  reader.setUseArena(useArena);
+
+  duration<double> parse(0);
+  duration<double> release(0);
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    steady_clock::time_point start = steady_clock::now();
+    SedDocument* doc = reader.readSedMLFromString(xml);
+    steady_clock::time_point parsed = steady_clock::now();
+    delete doc;
+    steady_clock::time_point freed = steady_clock::now();
+
+    parse += parsed - start;
+    release += freed - parsed;
+  }
+
+  double mb = (double)xml.size() * repeats / (1024.0 * 1024.0);
+  cout << label << ": parse " << parse.count() << " s, free "
+       << release.count() << " s, "
+       << mb / (parse + release).count() << " MB/s" << endl;
+}
+
+int
+main (int argc, char* argv[])
+{
+  unsigned int numScans = 20000;
+  unsigned int repeats = 5;
+
+  if (argc > 3)
+  {
+    cout << endl << "Usage: benchmark_arena [number-of-scans [repeats]]"
+    << endl << endl;
+    return 2;
+  }
+
+  if (argc >= 2)
+    numScans = (unsigned int)atoi(argv[1]);
+  if (argc == 3)
+    repeats = (unsigned int)atoi(argv[2]);
+
+  string xml = createDocument(numScans);
+  cout << "document with " << numScans << " repeated tasks, "
+       << xml.size() << " bytes" << endl;
+
+  run("heap ", xml, false, repeats);
+  run("arena", xml, true, repeats);
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file    benchmark_batch_read.cpp
+ * @brief   Measures the throughput of reading many documents in parallel
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sedml/SedTypes.h>
+LIBSEDML_CPP_NAMESPACE_USE
+
+using namespace std;
+using namespace std::chrono;
+
+unsigned int countErrors(const vector<SedDocument*>& documents)
+{
+  unsigned int numErrors = 0;
+  for (size_t i = 0; i < documents.size(); ++i)
+  {
+    numErrors += documents[i]->getNumErrors(LIBSEDML_SEV_ERROR);
+    numErrors += documents[i]->getNumErrors(LIBSEDML_SEV_FATAL);
+    delete documents[i];
+  }
+  return numErrors;
+}
+
+int
+main (int argc, char* argv[])
+{
+  if (argc < 4)
+  {
+    cout << endl << "Usage: benchmark_batch_read number-of-threads repeats file ..."
+    << endl << endl;
+    return 2;
+  }
+
+  unsigned int numThreads = (unsigned int)atoi(argv[1]);
+  unsigned int repeats = (unsigned int)atoi(argv[2]);
+
+  vector<string> files;
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    for (int n = 3; n < argc; ++n)
+    {
+      files.push_back(argv[n]);
+    }
+  }
+
+  SedReader reader;
+
+  steady_clock::time_point start = steady_clock::now();
+  vector<SedDocument*> documents;
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    documents.push_back(reader.readSedMLFromFile(files[i]));
+  }
+  duration<double> serial = steady_clock::now() - start;
+  unsigned int serialErrors = countErrors(documents);
+
+  cout << files.size() << " documents" << endl;
+  cout << "one after another: " << serial.count() << " s, "
+       << files.size() / serial.count() << " documents/s" << endl;
+
+  for (unsigned int threads = 1; threads <= numThreads; threads *= 2)
+  {
+    start = steady_clock::now();
+    documents = reader.readSedMLBatch(files, threads);
+    duration<double> batch = steady_clock::now() - start;
+    unsigned int batchErrors = countErrors(documents);
+
+    cout << "batch, " << threads << " thread(s): " << batch.count() << " s, "
+         << files.size() / batch.count() << " documents/s, speedup "
+         << serial.count() / batch.count() << endl;
+
+    if (batchErrors != serialErrors)
+    {
+      cout << "the batch read logged " << batchErrors << " errors instead of "
+           << serialErrors << endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
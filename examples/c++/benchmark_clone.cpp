@@ -0,0 +1,193 @@
+/**
+ * @file    benchmark_clone.cpp
+ * @brief   Compares deep and copy-on-write clones of a template document
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <sedml/SedTypes.h>
+LIBSEDML_CPP_NAMESPACE_USE
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Generates a template document, as a parameter sweep service would hold
+ * it: models with changes, a repeated task scanning a vector range, and
+ * data generators with a report.
+ */
+SedDocument*
+createTemplate (unsigned int numModels, unsigned int numValues)
+{
+  SedDocument* doc = new SedDocument(1, 4);
+
+  SedUniformTimeCourse* simulation = doc->createUniformTimeCourse();
+  simulation->setId("sim");
+  simulation->setInitialTime(0);
+  simulation->setOutputStartTime(0);
+  simulation->setOutputEndTime(100);
+  simulation->setNumberOfSteps(1000);
+  simulation->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedReport* report = doc->createReport();
+  report->setId("report");
+
+  for (unsigned int i = 0; i < numModels; ++i)
+  {
+    string suffix = to_string(i);
+
+    SedModel* model = doc->createModel();
+    model->setId("model" + suffix);
+    model->setLanguage("urn:sedml:language:sbml");
+    model->setSource("model.xml");
+    for (unsigned int c = 0; c < 10; ++c)
+    {
+      SedChangeAttribute* change = model->createChangeAttribute();
+      change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                        "sbml:parameter[@id='k" + to_string(c) + "']/@value");
+      change->setNewValue("1.0");
+    }
+
+    SedTask* task = doc->createTask();
+    task->setId("task" + suffix);
+    task->setModelReference("model" + suffix);
+    task->setSimulationReference("sim");
+
+    SedRepeatedTask* scan = doc->createRepeatedTask();
+    scan->setId("scan" + suffix);
+    scan->setRangeId("values" + suffix);
+    SedVectorRange* range = scan->createVectorRange();
+    range->setId("values" + suffix);
+    for (unsigned int v = 0; v < numValues; ++v) range->addValue(v * 0.5);
+    SedSetValue* setValue = scan->createTaskChange();
+    setValue->setModelReference("model" + suffix);
+    setValue->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                        "sbml:parameter[@id='k0']/@value");
+    setValue->setRange("values" + suffix);
+    ASTNode* math = SBML_parseL3Formula(("values" + suffix).c_str());
+    setValue->setMath(math);
+    delete math;
+    SedSubTask* subTask = scan->createSubTask();
+    subTask->setTask("task" + suffix);
+
+    SedDataGenerator* dg = doc->createDataGenerator();
+    dg->setId("dg" + suffix);
+    SedVariable* variable = dg->createVariable();
+    variable->setId("S" + suffix);
+    variable->setTaskReference("scan" + suffix);
+    variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/"
+                        "sbml:species[@id='S1']");
+    math = SBML_parseL3Formula(("S" + suffix).c_str());
+    dg->setMath(math);
+    delete math;
+
+    SedDataSet* dataSet = report->createDataSet();
+    dataSet->setId("ds" + suffix);
+    dataSet->setLabel("S" + suffix);
+    dataSet->setDataReference("dg" + suffix);
+  }
+
+  return doc;
+}
+
+
+/*
+ * Clones the template the given number of times and changes the source of
+ * one model in each clone, as a request to the sweep service would; returns
+ * the average time per request in microseconds.
+ */
+double
+cloneAndModify (const SedDocument* doc, unsigned int repeats, bool copyOnWrite)
+{
+  steady_clock::time_point start = steady_clock::now();
+
+  for (unsigned int r = 0; r < repeats; ++r)
+  {
+    SedDocument* copy = copyOnWrite ? doc->cloneCopyOnWrite() : doc->clone();
+    SedModel* model = copy->getModel(r % copy->getNumModels());
+    model->setSource("model_" + to_string(r) + ".xml");
+    delete copy;
+  }
+
+  duration<double, micro> elapsed = steady_clock::now() - start;
+  return elapsed.count() / repeats;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 4)
+  {
+    cout << endl << "Usage: benchmark_clone [models] [values] [repeats]"
+         << endl << endl;
+    return 2;
+  }
+
+  unsigned int numModels = (argc > 1) ? (unsigned int)atoi(argv[1]) : 500;
+  unsigned int numValues = (argc > 2) ? (unsigned int)atoi(argv[2]) : 100;
+  unsigned int repeats = (argc > 3) ? (unsigned int)atoi(argv[3]) : 100;
+  if (numModels == 0) numModels = 1;
+  if (repeats == 0) repeats = 1;
+
+  SedDocument* doc = createTemplate(numModels, numValues);
+  cout << numModels << " models, " << numValues << " values per range, "
+       << repeats << " repeats" << endl;
+
+  // both kinds of copies have to write the same document
+  SedDocument* deep = doc->clone();
+  SedDocument* shared = doc->cloneCopyOnWrite();
+  deep->getModel(0)->setSource("changed.xml");
+  shared->getModel(0)->setSource("changed.xml");
+  bool same = writeSedMLToStdString(deep) == writeSedMLToStdString(shared);
+  delete shared;
+  delete deep;
+  if (!same)
+  {
+    cout << "copy-on-write clone differs from the deep clone" << endl;
+    delete doc;
+    return 1;
+  }
+
+  double deepTime = cloneAndModify(doc, repeats, false);
+  double sharedTime = cloneAndModify(doc, repeats, true);
+
+  cout << "deep clone and modify:          " << deepTime << " us" << endl;
+  cout << "copy-on-write clone and modify: " << sharedTime << " us" << endl;
+  cout << "speedup:                        " << deepTime / sharedTime << endl;
+
+  delete doc;
+  return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file    benchmark_error_pruning.cpp
+ * @brief   Times reading documents that log many errors
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <sedml/SedTypes.h>
+LIBSEDML_CPP_NAMESPACE_USE
+
+using namespace std;
+using namespace std::chrono;
+
+// 
+// creates a document in which every model carries an unknown attribute, so
+// that each of them logs an error. If requested, the document is cut off
+// at the end, so that the reader also runs into a critical XML error and
+// has to drop all the other errors.
+// 
+string createDocument(unsigned int numModels, bool truncate)
+{
+  ostringstream str;
+  str << "<?xml version='1.0' encoding='UTF-8'?>\n"
+      << "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version4' "
+      << "level='1' version='4'>\n"
+      << "  <listOfModels>\n";
+
+  for (unsigned int i = 0; i < numModels; ++i)
+  {
+    str << "    <model id='model" << i << "' language='urn:sedml:language:sbml' "
+        << "source='model.xml' unknown='" << i << "'/>\n";
+  }
+
+  str << "  </listOfModels>\n";
+
+  if (!truncate)
+    str << "</sedML>\n";
+
+  return str.str();
+}
+
+double readDocument(const string& xml, unsigned int& numErrors)
+{
+  steady_clock::time_point start = steady_clock::now();
+  SedDocument* doc = readSedMLFromString(xml.c_str());
+  duration<double> elapsed = steady_clock::now() - start;
+
+  numErrors = doc->getNumErrors();
+  delete doc;
+  return elapsed.count();
+}
+
+// 
+// the pruning as it used to be done: one call to remove() per error
+// 
+double pruneOneByOne(SedErrorLog& log)
+{
+  steady_clock::time_point start = steady_clock::now();
+  for (int n = (int)log.getNumErrors() - 1; n >= 0; --n)
+  {
+    if (log.getError((unsigned int)n)->getErrorId() != XMLUnexpectedEOF)
+      log.remove(log.getError((unsigned int)n)->getErrorId());
+  }
+  duration<double> elapsed = steady_clock::now() - start;
+  return elapsed.count();
+}
+
+struct IsNotEOF
+{
+  bool operator() (const XMLError* error) const
+  {
+    return error->getErrorId() != XMLUnexpectedEOF;
+  }
+};
+
+double pruneAtOnce(SedErrorLog& log)
+{
+  steady_clock::time_point start = steady_clock::now();
+  log.removeIf(IsNotEOF());
+  duration<double> elapsed = steady_clock::now() - start;
+  return elapsed.count();
+}
+
+void fillLog(SedErrorLog& log, unsigned int numErrors)
+{
+  for (unsigned int i = 0; i < numErrors; ++i)
+  {
+    log.logError(SedUnknownCoreAttribute + (i % 2), 1, 4, "", i + 1);
+  }
+  log.logError(XMLUnexpectedEOF, 1, 4);
+}
+
+int
+main (int argc, char* argv[])
+{
+  unsigned int numModels = 50000;
+
+  if (argc > 2)
+  {
+    cout << endl << "Usage: benchmark_error_pruning [number-of-errors]"
+    << endl << endl;
+    return 2;
+  }
+
+  if (argc == 2)
+    numModels = (unsigned int)atoi(argv[1]);
+
+  unsigned int numErrors = 0;
+  double seconds = readDocument(createDocument(numModels, false), numErrors);
+  cout << "well-formed document: " << numErrors << " errors, "
+       << seconds << " s" << endl;
+
+  seconds = readDocument(createDocument(numModels, true), numErrors);
+  cout << "truncated document:   " << numErrors << " errors, "
+       << seconds << " s" << endl;
+
+  SedErrorLog log;
+  fillLog(log, numModels);
+  seconds = pruneOneByOne(log);
+  cout << "remove() per error:   " << log.getNumErrors() << " errors left, "
+       << seconds << " s" << endl;
+
+  SedErrorLog log2;
+  fillLog(log2, numModels);
+  seconds = pruneAtOnce(log2);
+  cout << "removeIf():           " << log2.getNumErrors() << " errors left, "
+       << seconds << " s" << endl;
+
+  return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file    benchmark_executor.cpp
+ * @brief   Measures how task execution scales with the number of threads
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <sedml/SedTypes.h>
+#include <sbml/xml/XMLNode.h>
+LIBSEDML_CPP_NAMESPACE_USE
+
+using namespace std;
+using namespace std::chrono;
+
+int
+main (int argc, char* argv[])
+{
+  unsigned int numTasks = 64;
+  unsigned int numIterations = 256;
+  unsigned int workPerPoint = 2000;
+  unsigned int maxThreads = std::thread::hardware_concurrency();
+
+  if (argc > 5)
+  {
+    cout << endl << "Usage: benchmark_executor [number-of-tasks] "
+         << "[number-of-iterations] [work-per-point] [max-threads]"
+         << endl << endl;
+    return 2;
+  }
+
+  if (argc > 1) numTasks = (unsigned int)atoi(argv[1]);
+  if (argc > 2) numIterations = (unsigned int)atoi(argv[2]);
+  if (argc > 3) workPerPoint = (unsigned int)atoi(argv[3]);
+  if (argc > 4) maxThreads = (unsigned int)atoi(argv[4]);
+  if (maxThreads == 0) maxThreads = 1;
+
+  SedDocument doc(1, 4);
+
+  SedModel* model = doc.createModel();
+  model->setId("model");
+  model->setSource("urn:benchmark:model");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setInitialTime(0);
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(10);
+  sim->setNumberOfSteps(100);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  for (unsigned int i = 0; i < numTasks; ++i)
+  {
+    ostringstream id;
+    id << "task" << i;
+    SedTask* task = doc.createTask();
+    task->setId(id.str());
+    task->setModelReference("model");
+    task->setSimulationReference("sim");
+  }
+
+  // a parameter scan whose iterations are independent of each other
+  SedRepeatedTask* scan = doc.createRepeatedTask();
+  scan->setId("scan");
+  scan->setResetModel(true);
+  scan->setConcatenate(true);
+  scan->setRangeId("range");
+  SedUniformRange* range = scan->createUniformRange();
+  range->setId("range");
+  range->setStart(0);
+  range->setEnd(1);
+  range->setNumberOfSteps(numIterations > 0 ? numIterations - 1 : 0);
+  range->setType("linear");
+  SedSetValue* change = scan->createTaskChange();
+  change->setModelReference("model");
+  change->setRange("range");
+  change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k']");
+  ASTNode* math = SBML_parseL3Formula("range");
+  change->setMath(math);
+  delete math;
+  scan->createSubTask()->setTask("task0");
+
+  XMLNode* sbml = XMLNode::convertStringToXMLNode(
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    "<model id='model'><listOfParameters>"
+    "<parameter id='k' value='1' constant='true'/>"
+    "<parameter id='x' value='1' constant='true'/>"
+    "</listOfParameters></model></sbml>");
+
+  cout << numTasks << " tasks, a scan of " << numIterations
+       << " iterations, " << workPerPoint << " operations per point" << endl;
+
+  double serial = 0;
+  for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    SedTaskExecutor executor(&doc);
+    executor.getModelBuilder().setModelSource("urn:benchmark:model", *sbml);
+    executor.registerSimulator("KISAO:0000019", [workPerPoint]()
+      -> SedSimulator* { return new SedMockSimulator(workPerPoint); });
+    executor.setNumThreads(threads);
+
+    steady_clock::time_point start = steady_clock::now();
+    int status = executor.execute();
+    duration<double> elapsed = steady_clock::now() - start;
+
+    if (status != LIBSEDML_OPERATION_SUCCESS)
+    {
+      cout << "the execution failed" << endl;
+      delete sbml;
+      return 1;
+    }
+
+    if (threads == 1) serial = elapsed.count();
+    cout << threads << " thread(s): " << elapsed.count() << " s, speedup "
+         << serial / elapsed.count() << endl;
+  }
+
+  delete sbml;
+  return 0;
+}
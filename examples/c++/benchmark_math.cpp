@@ -0,0 +1,135 @@
+/**
+ * @file    benchmark_math.cpp
+ * @brief   Compares compiled data generator math with evaluating the AST
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include <sedml/SedTypes.h>
+#include <sbml/SBMLTransforms.h>
+LIBSEDML_CPP_NAMESPACE_USE
+
+using namespace std;
+using namespace std::chrono;
+
+int
+main (int argc, char* argv[])
+{
+  size_t numPoints = 1000000;
+
+  if (argc > 2)
+  {
+    cout << endl << "Usage: benchmark_math [number-of-points]"
+    << endl << endl;
+    return 2;
+  }
+
+  if (argc == 2)
+    numPoints = (size_t)atol(argv[1]);
+
+  SedDocument doc(1, 4);
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("dg");
+  dg->createVariable()->setId("x");
+  dg->createVariable()->setId("y");
+  SedParameter* scale = dg->createParameter();
+  scale->setId("scale");
+  scale->setValue(0.5);
+  ASTNode* math = SBML_parseL3Formula(
+    "scale * (x - y) / (1 + exp(-x)) + piecewise(x, x > y, y)");
+  dg->setMath(math);
+  delete math;
+
+  vector<double> x(numPoints);
+  vector<double> y(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    x[i] = sin(0.001 * i);
+    y[i] = cos(0.002 * i);
+  }
+
+  vector<double> naive(numPoints);
+  vector<double> compiled(numPoints);
+
+  // evaluating the AST once per point, as done before
+  steady_clock::time_point start = steady_clock::now();
+  map<const string, pair<double, bool> > values;
+  values["scale"] = make_pair(scale->getValue(), true);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    values["x"] = make_pair(x[i], true);
+    values["y"] = make_pair(y[i], true);
+    naive[i] = SBMLTransforms::evaluateASTNode(dg->getMath(), values);
+  }
+  duration<double> naiveTime = steady_clock::now() - start;
+
+  start = steady_clock::now();
+  SedCompiledMath program;
+  if (program.compile(dg) != LIBSEDML_OPERATION_SUCCESS)
+  {
+    cout << "the math could not be compiled" << endl;
+    return 1;
+  }
+  program.setSlotValues(program.getSlotIndex("x"), &x[0]);
+  program.setSlotValues(program.getSlotIndex("y"), &y[0]);
+  program.evaluate(numPoints, &compiled[0]);
+  duration<double> compiledTime = steady_clock::now() - start;
+
+  double maxError = 0;
+  for (size_t i = 0; i < numPoints; ++i)
+    maxError = max(maxError, fabs(naive[i] - compiled[i]));
+
+  cout << numPoints << " points" << endl;
+  cout << "AST     : " << naiveTime.count() << " s, "
+       << numPoints / naiveTime.count() / 1e6 << " Mpoints/s" << endl;
+  cout << "compiled: " << compiledTime.count() << " s, "
+       << numPoints / compiledTime.count() / 1e6 << " Mpoints/s" << endl;
+  cout << "largest difference: " << maxError << endl;
+
+  // aggregates have no counterpart in the AST evaluation
+  math = SBML_parseL3Formula("(x - min(x)) / (max(x) - min(x))");
+  program.compile(math);
+  delete math;
+  program.setSlotValues(program.getSlotIndex("x"), &x[0]);
+
+  start = steady_clock::now();
+  program.evaluate(numPoints, &compiled[0]);
+  duration<double> aggregateTime = steady_clock::now() - start;
+  cout << "normalized with aggregates: " << aggregateTime.count() << " s" << endl;
+
+  return 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file    benchmark_namespaces.cpp
+ * @brief   Reports the heap memory used per SED-ML element
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include <sbml/SBMLTypes.h>
+LIBSBML_CPP_NAMESPACE_USE
+
+#include <sedml/SedTypes.h>
+LIBSEDML_CPP_NAMESPACE_USE
+
+using namespace std;
+
+// 
+// all allocations of the program go through these operators, so that the
+// bytes and allocations needed by the SED-ML objects can be counted. The
+// size of each block is stored in front of it, so it can be subtracted 
+// again on delete.
+// 
+static size_t numAllocations = 0;
+static size_t numBytes = 0;
+
+void* operator new(size_t size)
+{
+  void* block = malloc(size + sizeof(max_align_t));
+  if (block == NULL) throw bad_alloc();
+  *static_cast<size_t*>(block) = size;
+  ++numAllocations;
+  numBytes += size;
+  return static_cast<char*>(block) + sizeof(max_align_t);
+}
+
+void operator delete(void* ptr) throw()
+{
+  if (ptr == NULL) return;
+  void* block = static_cast<char*>(ptr) - sizeof(max_align_t);
+  numBytes -= *static_cast<size_t*>(block);
+  free(block);
+}
+
+void* operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete[](void* ptr) throw()
+{
+  operator delete(ptr);
+}
+
+
+string makeId(const char* prefix, unsigned int i)
+{
+  ostringstream str;
+  str << prefix << i;
+  return str.str();
+}
+
+ASTNode* parseMath(const string& formula)
+{
+  return SBML_parseFormula(formula.c_str());
+}
+
+SedDocument* createDocument(unsigned int numTasks)
+{
+  SedDocument* doc = new SedDocument(1, 4);
+
+  SedModel* model = doc->createModel();
+  model->setId("model1");
+  model->setLanguage("urn:sedml:language:sbml");
+  model->setSource("model1.xml");
+
+  SedUniformTimeCourse* tc = doc->createUniformTimeCourse();
+  tc->setId("sim1");
+  tc->setInitialTime(0);
+  tc->setOutputStartTime(0);
+  tc->setOutputEndTime(10);
+  tc->setNumberOfPoints(100);
+  tc->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  for (unsigned int i = 0; i < numTasks; ++i)
+  {
+    SedTask* task = doc->createTask();
+    task->setId(makeId("task", i));
+    task->setModelReference("model1");
+    task->setSimulationReference("sim1");
+
+    SedRepeatedTask* repeat = doc->createRepeatedTask();
+    repeat->setId(makeId("repeat", i));
+    repeat->setRangeId(makeId("range", i));
+    repeat->setResetModel(true);
+
+    SedUniformRange* range = repeat->createUniformRange();
+    range->setId(makeId("range", i));
+    range->setStart(0);
+    range->setEnd(1);
+    range->setNumberOfPoints(10);
+    range->setType("linear");
+
+    SedSetValue* change = repeat->createTaskChange();
+    change->setModelReference("model1");
+    change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']");
+    change->setRange(makeId("range", i));
+    ASTNode* math = parseMath(makeId("range", i));
+    change->setMath(math);
+    delete math;
+
+    SedSubTask* subTask = repeat->createSubTask();
+    subTask->setTask(makeId("task", i));
+    subTask->setOrder(1);
+
+    SedDataGenerator* dg = doc->createDataGenerator();
+    dg->setId(makeId("dg", i));
+    SedVariable* var = dg->createVariable();
+    var->setId(makeId("var", i));
+    var->setTaskReference(makeId("repeat", i));
+    var->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S1']");
+    math = parseMath(makeId("var", i));
+    dg->setMath(math);
+    delete math;
+  }
+
+  return doc;
+}
+
+unsigned int countElements(SedDocument* doc)
+{
+  List* elements = doc->getAllElements();
+  unsigned int count = elements->getSize() + 1;
+  delete elements;
+  return count;
+}
+
+void report(const char* label, size_t bytes, size_t allocations, unsigned int numElements)
+{
+  cout << label << ": " << numElements << " elements, "
+       << bytes << " bytes (" << (double)bytes / numElements << " bytes/element), "
+       << allocations << " allocations (" << (double)allocations / numElements
+       << " allocations/element)" << endl;
+}
+
+int
+main (int argc, char* argv[])
+{
+  unsigned int numTasks = 10000;
+
+  if (argc > 2)
+  {
+    cout << endl << "Usage: benchmark_namespaces [number-of-tasks]"
+    << endl << endl;
+    return 2;
+  }
+
+  if (argc == 2)
+    numTasks = (unsigned int)atoi(argv[1]);
+
+  // elements created through the API
+  size_t bytesBefore = numBytes;
+  size_t allocationsBefore = numAllocations;
+  SedDocument* doc = createDocument(numTasks);
+  size_t bytes = numBytes - bytesBefore;
+  size_t allocations = numAllocations - allocationsBefore;
+  unsigned int numElements = countElements(doc);
+  report("created", bytes, allocations, numElements);
+
+  // elements created by the reader
+  string xml = writeSedMLToStdString(doc);
+  delete doc;
+
+  bytesBefore = numBytes;
+  allocationsBefore = numAllocations;
+  doc = readSedMLFromString(xml.c_str());
+  bytes = numBytes - bytesBefore;
+  allocations = numAllocations - allocationsBefore;
+  numElements = countElements(doc);
+  report("read", bytes, allocations, numElements);
+
+  delete doc;
+  return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file    benchmark_validator.cpp
+ * @brief   Measures how checking the references of a document scales with threads
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <sedml/SedTypes.h>
+LIBSEDML_CPP_NAMESPACE_USE
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Generates a document with the given number of tasks, each with a model,
+ * a data generator and a curve; every 100th curve refers to a data
+ * generator that does not exist.
+ */
+SedDocument*
+createDocument (unsigned int numTasks)
+{
+  SedDocument* doc = new SedDocument(1, 4);
+
+  SedUniformTimeCourse* simulation = doc->createUniformTimeCourse();
+  simulation->setId("sim");
+  simulation->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedPlot2D* plot = doc->createPlot2D();
+  plot->setId("plot");
+
+  SedDataGenerator* time = doc->createDataGenerator();
+  time->setId("time");
+  SedVariable* variable = time->createVariable();
+  variable->setId("t");
+  variable->setSymbol("urn:sedml:symbol:time");
+  variable->setTaskReference("task0");
+  ASTNode* math = SBML_parseL3Formula("t");
+  time->setMath(math);
+  delete math;
+
+  for (unsigned int i = 0; i < numTasks; ++i)
+  {
+    string suffix = to_string(i);
+
+    SedModel* model = doc->createModel();
+    model->setId("model" + suffix);
+    model->setLanguage("urn:sedml:language:sbml");
+    model->setSource("model.xml");
+
+    SedTask* task = doc->createTask();
+    task->setId("task" + suffix);
+    task->setModelReference("model" + suffix);
+    task->setSimulationReference("sim");
+
+    SedDataGenerator* dg = doc->createDataGenerator();
+    dg->setId("dg" + suffix);
+    variable = dg->createVariable();
+    variable->setId("S" + suffix);
+    variable->setTaskReference("task" + suffix);
+    variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/"
+                        "sbml:species[@id='S1']");
+    math = SBML_parseL3Formula(("S" + suffix).c_str());
+    dg->setMath(math);
+    delete math;
+
+    SedCurve* curve = plot->createCurve();
+    curve->setId("curve" + suffix);
+    curve->setXDataReference("time");
+    curve->setYDataReference(i % 100 == 99 ? "missing" + suffix : "dg" + suffix);
+  }
+
+  return doc;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 4)
+  {
+    cout << endl << "Usage: benchmark_validator [tasks] [repeats] [threads]"
+         << endl << endl;
+    return 2;
+  }
+
+  unsigned int numTasks = (argc > 1) ? (unsigned int)atoi(argv[1]) : 100000;
+  unsigned int repeats = (argc > 2) ? (unsigned int)atoi(argv[2]) : 5;
+  unsigned int maxThreads = (argc > 3) ? (unsigned int)atoi(argv[3])
+                                       : thread::hardware_concurrency();
+  if (repeats == 0) repeats = 1;
+  if (maxThreads == 0) maxThreads = 1;
+
+  SedDocument* doc = createDocument(numTasks);
+  cout << numTasks << " tasks, " << repeats << " repeats" << endl;
+
+  SedValidator validator;
+  double singleTime = 0;
+  unsigned int expected = 0;
+  for (unsigned int numThreads = 1; ; numThreads *= 2)
+  {
+    if (numThreads > maxThreads) numThreads = maxThreads;
+    validator.setNumThreads(numThreads);
+
+    unsigned int numFailures = 0;
+    steady_clock::time_point start = steady_clock::now();
+    for (unsigned int r = 0; r < repeats; ++r)
+    {
+      numFailures = validator.validate(doc);
+    }
+    duration<double, milli> elapsed = steady_clock::now() - start;
+    double time = elapsed.count() / repeats;
+
+    if (numThreads == 1)
+    {
+      singleTime = time;
+      expected = numFailures;
+    }
+    else if (numFailures != expected)
+    {
+      cout << "found " << numFailures << " failures with " << numThreads
+           << " threads, but " << expected << " with one" << endl;
+      delete doc;
+      return 1;
+    }
+
+    cout << numThreads << " thread(s): " << time << " ms, speedup "
+         << singleTime / time << ", " << numFailures << " failures" << endl;
+
+    if (numThreads == maxThreads) break;
+  }
+
+  delete doc;
+  return 0;
+}
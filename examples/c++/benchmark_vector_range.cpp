@@ -0,0 +1,152 @@
+/**
+ * @file    benchmark_vector_range.cpp
+ * @brief   Measures writing and reading large vector ranges, plain and compact
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sedml/SedTypes.h>
+LIBSEDML_CPP_NAMESPACE_USE
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Writes the document and reads it back the given number of times, and
+ * returns the seconds spent writing and reading as well as the size of the
+ * document.  Returns false if the values did not survive the round trip.
+ */
+bool
+roundTrip (SedDocument& doc, const vector<double>& values, unsigned int repeats,
+           double& writeTime, double& readTime, size_t& size)
+{
+  writeTime = 0;
+  readTime = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    steady_clock::time_point start = steady_clock::now();
+    string xml = writeSedMLToStdString(&doc);
+    steady_clock::time_point written = steady_clock::now();
+    SedDocument* read = readSedMLFromString(xml.c_str());
+    steady_clock::time_point end = steady_clock::now();
+
+    writeTime += duration<double>(written - start).count();
+    readTime += duration<double>(end - written).count();
+    size = xml.size();
+
+    SedRepeatedTask* task = static_cast<SedRepeatedTask*>(read->getTask(0));
+    SedVectorRange* range = static_cast<SedVectorRange*>(task->getRange(0));
+    bool same = range != NULL && range->getValues() == values;
+    delete read;
+    if (!same) return false;
+  }
+
+  return true;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    cout << endl << "Usage: benchmark_vector_range [values] [repeats]"
+         << endl << endl;
+    return 2;
+  }
+
+  unsigned int numValues = (argc > 1) ? (unsigned int)atoi(argv[1]) : 100000;
+  unsigned int repeats = (argc > 2) ? (unsigned int)atoi(argv[2]) : 5;
+  if (numValues == 0) numValues = 1;
+  if (repeats == 0) repeats = 1;
+
+  // values that need all 17 digits, as a parameter scan would produce them
+  vector<double> values(numValues);
+  for (unsigned int i = 0; i < numValues; ++i)
+  {
+    values[i] = exp(-0.0001 * i) / 3.0;
+  }
+
+  SedDocument doc(1, 4);
+  SedRepeatedTask* task = doc.createRepeatedTask();
+  task->setId("scan");
+  task->setRangeId("v");
+  SedVectorRange* range = task->createVectorRange();
+  range->setId("v");
+  range->setValues(values);
+
+  cout << numValues << " values, " << repeats << " repeats" << endl;
+
+  // the per value conversions the reader and writer used to do
+  steady_clock::time_point start = steady_clock::now();
+  for (unsigned int r = 0; r < repeats; ++r)
+  {
+    for (unsigned int i = 0; i < numValues; ++i)
+    {
+      stringstream text;
+      text.precision(17);
+      text << values[i];
+      double value;
+      text >> value;
+    }
+  }
+  duration<double> streams = steady_clock::now() - start;
+  cout << "stringstream conversions: " << streams.count() << " s" << endl;
+
+  double writeTime, readTime;
+  size_t size = 0;
+  if (!roundTrip(doc, values, repeats, writeTime, readTime, size))
+  {
+    cout << "values changed in the plain form" << endl;
+    return 1;
+  }
+  cout << "plain   write: " << writeTime << " s, read: " << readTime
+       << " s, size: " << size << " bytes" << endl;
+
+  range->setUseCompactEncoding(true);
+  if (!roundTrip(doc, values, repeats, writeTime, readTime, size))
+  {
+    cout << "values changed in the compact form" << endl;
+    return 1;
+  }
+  cout << "compact write: " << writeTime << " s, read: " << readTime
+       << " s, size: " << size << " bytes" << endl;
+
+  return 0;
+}
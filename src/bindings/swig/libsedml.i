@@ -114,6 +114,42 @@ LIBNUML_CPP_NAMESPACE_USE
  */
 %ignore *::accept;
 
+/**
+ * Ignore the streaming reader methods, they need a C++ SedReaderHandler.
+ */
+%ignore SedReader::readSedML(const std::string&, SedReaderHandler&);
+%ignore SedReader::readSedMLFromFile(const std::string&, SedReaderHandler&);
+%ignore SedReader::readSedMLFromString(const std::string&, SedReaderHandler&);
+%ignore SedDocument::setReaderHandler;
+%ignore SedDocument::getReaderHandler;
+
+/**
+ * Ignore the batch reader, the documents it returns would not be owned.
+ */
+%ignore SedReader::readSedMLBatch;
+
+/**
+ * Ignore the dependency graph, which is not wrapped.
+ */
+%ignore SedDocument::buildDependencyGraph;
+
+/**
+ * Ignore the internal methods used to read lists on first access.
+ */
+%ignore SedDocument::setLazyListLoader;
+%ignore SedDocument::loadLazyList;
+%ignore SedListOf::setHasLazyItems;
+%ignore SedListOf::getHasLazyItems;
+
+/**
+ * Ignore the allocation operators and the internal arena accessor.
+ */
+%ignore SedBase::operator new;
+%ignore SedBase::operator delete;
+%ignore SedDocument::getArena;
+%ignore SedArena;
+%ignore SedArenaScope;
+
 /**
  * Ignore internal implementation methods in ASTNode.h
  */
@@ -77,7 +77,7 @@ SedAbstractCurve::SedAbstractCurve(unsigned int level, unsigned int version)
  * Creates a new SedAbstractCurve using the given SedNamespaces object @p
  * sedmlns.
  */
-SedAbstractCurve::SedAbstractCurve(SedNamespaces *sedmlns)
+SedAbstractCurve::SedAbstractCurve(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mLogX (false)
   , mIsSetLogX (false)
@@ -321,6 +321,8 @@ SedAbstractCurve::setOrder(int order)
 int
 SedAbstractCurve::setStyle(const std::string& style)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(style)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -350,6 +352,8 @@ SedAbstractCurve::setYAxis(const std::string& yAxis)
 int
 SedAbstractCurve::setXDataReference(const std::string& xDataReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(xDataReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -408,6 +412,8 @@ SedAbstractCurve::unsetOrder()
 int
 SedAbstractCurve::unsetStyle()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mStyle.erase();
 
   if (mStyle.empty() == true)
@@ -446,6 +452,8 @@ SedAbstractCurve::unsetYAxis()
 int
 SedAbstractCurve::unsetXDataReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mXDataReference.erase();
 
   if (mXDataReference.empty() == true)
@@ -573,7 +581,11 @@ SedAbstractCurve::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedAbstractCurve::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
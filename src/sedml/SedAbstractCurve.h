@@ -103,7 +103,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedAbstractCurve(SedNamespaces *sedmlns);
+  SedAbstractCurve(const SedNamespaces *sedmlns);
 
 
   /**
@@ -70,7 +70,7 @@ SedAbstractTask::SedAbstractTask(unsigned int level, unsigned int version)
  * Creates a new SedAbstractTask using the given SedNamespaces object @p
  * sedmlns.
  */
-SedAbstractTask::SedAbstractTask(SedNamespaces *sedmlns)
+SedAbstractTask::SedAbstractTask(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mElementName("task")
 {
@@ -235,7 +235,11 @@ SedAbstractTask::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedAbstractTask::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -97,7 +97,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedAbstractTask(SedNamespaces *sedmlns);
+  SedAbstractTask(const SedNamespaces *sedmlns);
 
 
   /**
@@ -62,7 +62,7 @@ SedAddXML::SedAddXML(unsigned int level, unsigned int version)
 /*
  * Creates a new SedAddXML using the given SedNamespaces object @p sedmlns.
  */
-SedAddXML::SedAddXML(SedNamespaces *sedmlns)
+SedAddXML::SedAddXML(const SedNamespaces *sedmlns)
   : SedChange(sedmlns)
   , mNewXML (NULL)
 {
@@ -284,7 +284,11 @@ SedAddXML::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedAddXML::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
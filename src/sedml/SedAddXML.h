@@ -92,7 +92,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedAddXML(SedNamespaces *sedmlns);
+  SedAddXML(const SedNamespaces *sedmlns);
 
 
   /**
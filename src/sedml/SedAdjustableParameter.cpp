@@ -71,7 +71,7 @@ SedAdjustableParameter::SedAdjustableParameter(unsigned int level,
  * Creates a new SedAdjustableParameter using the given SedNamespaces object @p
  * sedmlns.
  */
-SedAdjustableParameter::SedAdjustableParameter(SedNamespaces *sedmlns)
+SedAdjustableParameter::SedAdjustableParameter(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mInitialValue (util_NaN())
   , mIsSetInitialValue (false)
@@ -243,6 +243,8 @@ SedAdjustableParameter::setInitialValue(double initialValue)
 int
 SedAdjustableParameter::setModelReference(const std::string& modelReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(modelReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -294,6 +296,8 @@ SedAdjustableParameter::unsetInitialValue()
 int
 SedAdjustableParameter::unsetModelReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -665,7 +669,48 @@ SedAdjustableParameter::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedAdjustableParameter::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedAdjustableParameter
+ */
+unsigned int
+SedAdjustableParameter::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    mBounds,
+    &mExperimentReferences
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 2);
+}
+
+
+/*
+ * Returns the nth child object of this SedAdjustableParameter
+ */
+const SedBase*
+SedAdjustableParameter::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    mBounds,
+    &mExperimentReferences
+  };
+
+  return selectChildElement(children, 2, n - inherited);
 }
 
 /** @endcond */
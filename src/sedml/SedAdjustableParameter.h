@@ -100,7 +100,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedAdjustableParameter(SedNamespaces *sedmlns);
+  SedAdjustableParameter(const SedNamespaces *sedmlns);
 
 
   /**
@@ -601,6 +601,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedAdjustableParameter
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedAdjustableParameter
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
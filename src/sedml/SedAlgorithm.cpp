@@ -67,7 +67,7 @@ SedAlgorithm::SedAlgorithm(unsigned int level, unsigned int version)
 /*
  * Creates a new SedAlgorithm using the given SedNamespaces object @p sedmlns.
  */
-SedAlgorithm::SedAlgorithm(SedNamespaces *sedmlns)
+SedAlgorithm::SedAlgorithm(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mKisaoID ("")
   , mAlgorithmParameters (sedmlns)
@@ -383,7 +383,46 @@ SedAlgorithm::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedAlgorithm::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedAlgorithm
+ */
+unsigned int
+SedAlgorithm::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mAlgorithmParameters
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedAlgorithm
+ */
+const SedBase*
+SedAlgorithm::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mAlgorithmParameters
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
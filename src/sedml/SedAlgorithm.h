@@ -95,7 +95,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedAlgorithm(SedNamespaces *sedmlns);
+  SedAlgorithm(const SedNamespaces *sedmlns);
 
 
   /**
@@ -410,6 +410,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedAlgorithm
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedAlgorithm
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
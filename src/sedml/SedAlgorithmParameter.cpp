@@ -69,7 +69,7 @@ SedAlgorithmParameter::SedAlgorithmParameter(unsigned int level,
  * Creates a new SedAlgorithmParameter using the given SedNamespaces object @p
  * sedmlns.
  */
-SedAlgorithmParameter::SedAlgorithmParameter(SedNamespaces *sedmlns)
+SedAlgorithmParameter::SedAlgorithmParameter(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mKisaoID ("")
   , mValue ("")
@@ -452,7 +452,46 @@ SedAlgorithmParameter::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedAlgorithmParameter::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedAlgorithmParameter
+ */
+unsigned int
+SedAlgorithmParameter::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    mAlgorithmParameters
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedAlgorithmParameter
+ */
+const SedBase*
+SedAlgorithmParameter::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    mAlgorithmParameters
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
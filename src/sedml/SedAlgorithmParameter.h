@@ -97,7 +97,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedAlgorithmParameter(SedNamespaces *sedmlns);
+  SedAlgorithmParameter(const SedNamespaces *sedmlns);
 
 
   /**
@@ -446,6 +446,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedAlgorithmParameter
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedAlgorithmParameter
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
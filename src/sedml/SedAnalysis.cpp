@@ -62,7 +62,7 @@ SedAnalysis::SedAnalysis(unsigned int level, unsigned int version)
  * Creates a new SedAnalysis using the given SedNamespaces object @p
  * sedmlns.
  */
-SedAnalysis::SedAnalysis(SedNamespaces *sedmlns)
+SedAnalysis::SedAnalysis(const SedNamespaces *sedmlns)
   : SedSimulation(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -170,7 +170,11 @@ SedAnalysis::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedAnalysis::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -66,7 +66,7 @@ SedAppliedDimension::SedAppliedDimension(unsigned int level,
  * Creates a new SedAppliedDimension using the given SedNamespaces object @p
  * sedmlns.
  */
-SedAppliedDimension::SedAppliedDimension(SedNamespaces *sedmlns)
+SedAppliedDimension::SedAppliedDimension(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mTarget ("")
   , mDimensionTarget ("")
@@ -318,7 +318,11 @@ SedAppliedDimension::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedAppliedDimension::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
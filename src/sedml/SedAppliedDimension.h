@@ -94,7 +94,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedAppliedDimension(SedNamespaces *sedmlns);
+  SedAppliedDimension(const SedNamespaces *sedmlns);
 
 
   /**
@@ -0,0 +1,378 @@
+/**
+ * @file SedArena.cpp
+ * @brief Implementation of the SedArena class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedArena.h>
+#include <sedml/SedDocument.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+static const unsigned int SED_ARENA_BLOCK_SHIFT = 16;
+static const size_t SED_ARENA_BLOCK_SIZE = size_t(1) << SED_ARENA_BLOCK_SHIFT;
+static const size_t SED_ARENA_ALIGNMENT = alignof(max_align_t);
+
+/*
+ * Elements are added to the live count of an arena in batches of this
+ * size, so that allocating does not touch the atomic count every time.
+ */
+static const long long SED_ARENA_CREDIT = 4096;
+
+/*
+ * The blocks of the block map, which covers the first 2^48 bytes of the
+ * address space: block numbers are split into the index of the middle
+ * table, the index of the leaf and the index in the leaf.
+ */
+static const unsigned int SED_ARENA_ROOT_BITS = 12;
+static const unsigned int SED_ARENA_MIDDLE_BITS = 10;
+static const unsigned int SED_ARENA_LEAF_BITS = 10;
+
+static thread_local SedArena* sCurrentArena = NULL;
+
+/*
+ * The arena whose owner is deleting its elements on this thread, and the
+ * number of its elements freed so far; see startRelease().
+ */
+static thread_local SedArena* sReleasingArena = NULL;
+static thread_local long long sNumReleased = 0;
+
+
+/*
+ * The arena of every block, by block number.  Blocks are aligned to their
+ * size, so the block number of an element is its address shifted by
+ * SED_ARENA_BLOCK_SHIFT.  Like a page table, the map is read without
+ * locking, and tables are only ever added, under the mutex, when a block
+ * is registered; elements from the heap usually stop at an empty entry of
+ * the root.
+ */
+struct SedArenaLeaf
+{
+  atomic<SedArena*> mArenas[1 << SED_ARENA_LEAF_BITS];
+};
+
+struct SedArenaMiddle
+{
+  atomic<SedArenaLeaf*> mLeaves[1 << SED_ARENA_MIDDLE_BITS];
+};
+
+struct SedArenaMap
+{
+  mutex mMutex;
+  atomic<SedArenaMiddle*> mRoot[1 << SED_ARENA_ROOT_BITS];
+};
+
+
+/*
+ * The map is never destroyed, as elements may still be freed by the
+ * destructors of other static objects.
+ */
+static SedArenaMap&
+getMap ()
+{
+  static SedArenaMap* map = new SedArenaMap();
+  return *map;
+}
+
+
+/*
+ * Returns the entry of the map for the block containing @p address, or
+ * NULL if there is none.  The tables on the way are created if @p create
+ * is true, in which case the mutex of the map has to be locked.
+ */
+static atomic<SedArena*>*
+getEntry (const void* address, bool create)
+{
+  uint64_t block =
+    uint64_t(reinterpret_cast<uintptr_t>(address)) >> SED_ARENA_BLOCK_SHIFT;
+  if ((block >> (SED_ARENA_ROOT_BITS + SED_ARENA_MIDDLE_BITS
+                 + SED_ARENA_LEAF_BITS)) != 0)
+  {
+    return NULL;
+  }
+
+  atomic<SedArenaMiddle*>& root = getMap().mRoot[
+    block >> (SED_ARENA_MIDDLE_BITS + SED_ARENA_LEAF_BITS)];
+  SedArenaMiddle* middle = root.load(memory_order_acquire);
+  if (middle == NULL)
+  {
+    if (!create) return NULL;
+    middle = new SedArenaMiddle();
+    root.store(middle, memory_order_release);
+  }
+
+  atomic<SedArenaLeaf*>& entry = middle->mLeaves[
+    (block >> SED_ARENA_LEAF_BITS) & ((1 << SED_ARENA_MIDDLE_BITS) - 1)];
+  SedArenaLeaf* leaf = entry.load(memory_order_acquire);
+  if (leaf == NULL)
+  {
+    if (!create) return NULL;
+    leaf = new SedArenaLeaf();
+    entry.store(leaf, memory_order_release);
+  }
+
+  return &leaf->mArenas[block & ((1 << SED_ARENA_LEAF_BITS) - 1)];
+}
+
+
+/*
+ * Allocates a block aligned to its size, or returns NULL.
+ */
+static char*
+allocateBlock ()
+{
+#ifdef _WIN32
+  return static_cast<char*>(
+    _aligned_malloc(SED_ARENA_BLOCK_SIZE, SED_ARENA_BLOCK_SIZE));
+#else
+  void* block = NULL;
+  if (posix_memalign(&block, SED_ARENA_BLOCK_SIZE, SED_ARENA_BLOCK_SIZE) != 0)
+  {
+    return NULL;
+  }
+  return static_cast<char*>(block);
+#endif
+}
+
+
+static void
+freeBlock (char* block)
+{
+#ifdef _WIN32
+  _aligned_free(block);
+#else
+  free(block);
+#endif
+}
+
+
+SedArena::SedArena ()
+  : mBlocks()
+  , mNext(NULL)
+  , mAvailable(0)
+  , mNumBytes(0)
+  , mCredit(0)
+  , mNumLive(1)
+{
+}
+
+
+SedArena::~SedArena ()
+{
+  for (vector<char*>::iterator it = mBlocks.begin(); it != mBlocks.end(); ++it)
+  {
+    getEntry(*it, false)->store(NULL, memory_order_release);
+    freeBlock(*it);
+  }
+}
+
+
+void
+SedArena::startRelease ()
+{
+  if (sReleasingArena != NULL) return;
+
+  sReleasingArena = this;
+  sNumReleased = 0;
+}
+
+
+void
+SedArena::release ()
+{
+  // the reference of the owner, the credit not used up by allocations, and
+  // the elements freed in bulk are given back at once
+  long long returned = 1 + mCredit;
+  mCredit = 0;
+  if (sReleasingArena == this)
+  {
+    returned += sNumReleased;
+    sReleasingArena = NULL;
+    sNumReleased = 0;
+  }
+
+  if (mNumLive.fetch_sub(returned, memory_order_acq_rel) == returned)
+  {
+    delete this;
+  }
+}
+
+
+size_t
+SedArena::getNumBytes () const
+{
+  return mNumBytes;
+}
+
+
+/*
+ * Hands out @p size bytes, which must fit into a block, or returns NULL if
+ * no block can be had.
+ */
+void*
+SedArena::allocate (size_t size)
+{
+  size = (size + SED_ARENA_ALIGNMENT - 1) / SED_ARENA_ALIGNMENT
+    * SED_ARENA_ALIGNMENT;
+
+  if (size > mAvailable)
+  {
+    char* block = allocateBlock();
+    if (block == NULL) return NULL;
+
+    {
+      SedArenaMap& map = getMap();
+      lock_guard<mutex> lock(map.mMutex);
+      atomic<SedArena*>* entry = getEntry(block, true);
+      if (entry == NULL)
+      {
+        // beyond the addresses covered by the map
+        freeBlock(block);
+        return NULL;
+      }
+      entry->store(this, memory_order_release);
+    }
+
+    mBlocks.push_back(block);
+    mNumBytes += SED_ARENA_BLOCK_SIZE;
+    mNext = block;
+    mAvailable = SED_ARENA_BLOCK_SIZE;
+  }
+
+  if (mCredit == 0)
+  {
+    mNumLive.fetch_add(SED_ARENA_CREDIT, memory_order_relaxed);
+    mCredit = SED_ARENA_CREDIT;
+  }
+  --mCredit;
+
+  void* result = mNext;
+  mNext += size;
+  mAvailable -= size;
+  return result;
+}
+
+
+void*
+SedArena::allocateObject (size_t size)
+{
+  SedArena* arena = sCurrentArena;
+
+  // large elements are rare, and are left to the heap so that all blocks
+  // have the same size
+  if (arena != NULL && size <= SED_ARENA_BLOCK_SIZE / 4)
+  {
+    void* result = arena->allocate(size);
+    if (result != NULL) return result;
+  }
+
+  return ::operator new(size);
+}
+
+
+void
+SedArena::deallocateObject (void* ptr)
+{
+  if (ptr == NULL) return;
+
+  atomic<SedArena*>* entry = getEntry(ptr, false);
+  SedArena* arena =
+    (entry != NULL) ? entry->load(memory_order_acquire) : NULL;
+
+  if (arena == NULL)
+  {
+    ::operator delete(ptr);
+  }
+  else if (arena == sReleasingArena)
+  {
+    ++sNumReleased;
+  }
+  else if (arena->mNumLive.fetch_sub(1, memory_order_acq_rel) == 1)
+  {
+    delete arena;
+  }
+}
+
+
+SedArena*
+SedArena::getCurrent ()
+{
+  return sCurrentArena;
+}
+
+
+void
+SedArena::setCurrent (SedArena* arena)
+{
+  sCurrentArena = arena;
+}
+
+/** @endcond */
+
+
+SedArenaScope::SedArenaScope (const SedDocument* document)
+  : mPrevious(SedArena::getCurrent())
+{
+  SedArena::setCurrent(document != NULL ? document->getArena() : NULL);
+}
+
+
+SedArenaScope::~SedArenaScope ()
+{
+  SedArena::setCurrent(mPrevious);
+}
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
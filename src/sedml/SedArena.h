@@ -0,0 +1,218 @@
+/**
+ * @file SedArena.h
+ * @brief Definition of the SedArena class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedArena
+ * @sbmlbrief{} Memory arena from which the elements of a SedDocument can
+ * be allocated.
+ *
+ * A SedArena hands out memory from large blocks, which makes allocating
+ * the many small elements of a document much cheaper than going through
+ * the global heap.  Memory is never returned to the arena; instead the
+ * arena counts the elements allocated from it, and all blocks are released
+ * at once when the last element (and the SedDocument that owns the arena)
+ * is gone.  Elements that are removed from the document thus stay valid
+ * for as long as they are needed.
+ *
+ * Elements carry no bookkeeping of their own: the blocks of all arenas
+ * are aligned to their size and entered into a map that is read without
+ * locking, so freeing an element finds its arena from its address alone.
+ * When a SedDocument is deleted, the elements it frees itself are counted
+ * on the deleting thread and given back to the arena at once, see
+ * startRelease().
+ *
+ * SedBase allocates from the arena that is current on the calling thread,
+ * see SedArenaScope.  Use SedDocument::setUseArena() to give a document an
+ * arena, and SedReader::setUseArena() to read documents into one.
+ *
+ * Only SED-ML elements are allocated from the arena; math, notes and
+ * annotations are still allocated by libSBML.
+ */
+
+
+#ifndef SedArena_h
+#define SedArena_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+/** @cond doxygenLibsedmlInternal */
+class LIBSEDML_EXTERN SedArena
+{
+public:
+
+  /**
+   * Creates a new SedArena, owned by the caller.
+   */
+  SedArena ();
+
+
+  /**
+   * Starts giving up the ownership of this SedArena: until release() is
+   * called, elements of this arena freed on the calling thread are only
+   * counted, to be given back together.  Used by the owner before it
+   * deletes its elements.
+   */
+  void startRelease ();
+
+
+  /**
+   * Gives up the ownership of this SedArena, which is destroyed together
+   * with all its memory once no elements allocated from it are left.
+   */
+  void release ();
+
+
+  /**
+   * @return the number of bytes in the blocks of this arena.
+   */
+  size_t getNumBytes () const;
+
+
+  /**
+   * Allocates memory for a SED-ML element, either from the current arena
+   * of the calling thread or, if there is none or the element is too
+   * large for the blocks of an arena, from the heap.  Used by
+   * SedBase::operator new.
+   */
+  static void* allocateObject (size_t size);
+
+
+  /**
+   * Frees memory obtained from allocateObject().  Memory from an arena is
+   * only released together with the arena.  Used by SedBase::operator
+   * delete.
+   */
+  static void deallocateObject (void* ptr);
+
+
+  /**
+   * @return the arena that elements created on the calling thread are
+   * allocated from, or @c NULL.
+   */
+  static SedArena* getCurrent ();
+
+
+  /**
+   * Sets the arena that elements created on the calling thread are
+   * allocated from.
+   */
+  static void setCurrent (SedArena* arena);
+
+
+private:
+
+  SedArena (const SedArena& orig);
+  SedArena& operator= (const SedArena& rhs);
+  ~SedArena ();
+
+  void* allocate (size_t size);
+
+  std::vector<char*> mBlocks;
+  char* mNext;
+  size_t mAvailable;
+  size_t mNumBytes;
+
+  // elements that may still be allocated before the live count has to be
+  // raised again; only touched by the thread allocating from the arena
+  long long mCredit;
+
+  // the elements allocated from the arena and not yet freed, plus the
+  // unused credit and one for the owner; the arena is deleted at zero
+  std::atomic<long long> mNumLive;
+};
+/** @endcond */
+
+
+/**
+ * Makes the arena of a SedDocument the current one on the calling thread
+ * for as long as it exists, so that elements created in the meantime are
+ * allocated from it:
+ *
+ * @code{.cpp}
+ * doc->setUseArena(true);
+ * {
+ *   SedArenaScope scope(doc);
+ *   for (int i = 0; i < 1000; ++i)
+ *     doc->createDataGenerator()->createVariable();
+ * }
+ * @endcode
+ *
+ * Elements allocated from an arena must not be created concurrently from
+ * several threads.
+ */
+class LIBSEDML_EXTERN SedArenaScope
+{
+public:
+
+  /**
+   * Makes the arena of @p document current; if the document does not use
+   * an arena, elements are allocated from the heap.
+   */
+  SedArenaScope (const SedDocument* document);
+
+
+  /**
+   * Restores the arena that was current before.
+   */
+  ~SedArenaScope ();
+
+
+private:
+
+  SedArenaScope (const SedArenaScope& orig);
+  SedArenaScope& operator= (const SedArenaScope& rhs);
+
+  SedArena* mPrevious;
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedArena_h */
@@ -71,7 +71,7 @@ SedAxis::SedAxis(unsigned int level, unsigned int version)
 /*
  * Creates a new SedAxis using the given SedNamespaces object @p sedmlns.
  */
-SedAxis::SedAxis(SedNamespaces *sedmlns)
+SedAxis::SedAxis(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mType (SEDML_AXISTYPE_INVALID)
   , mMin (util_NaN())
@@ -374,6 +374,8 @@ SedAxis::setReverse(bool reverse)
 int
 SedAxis::setStyle(const std::string& style)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(style)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -483,6 +485,8 @@ SedAxis::unsetReverse()
 int
 SedAxis::unsetStyle()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mStyle.erase();
 
   if (mStyle.empty() == true)
@@ -587,7 +591,11 @@ SedAxis::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream& stream)
 bool
 SedAxis::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
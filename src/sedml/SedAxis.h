@@ -126,7 +126,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedAxis(SedNamespaces *sedmlns);
+  SedAxis(const SedNamespaces *sedmlns);
 
 
   /**
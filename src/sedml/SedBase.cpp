@@ -50,6 +50,8 @@
 #include <sedml/SedDocument.h>
 #include <sedml/SedListOf.h>
 #include <sedml/SedBase.h>
+#include <sedml/SedReaderHandler.h>
+#include <sedml/SedArena.h>
 
 
 /** @cond doxygenIgnored */
@@ -101,6 +103,92 @@ SedBase::getAllElements(SedElementFilter* filter)
   return NULL;
 }
 
+
+unsigned int
+SedBase::getNumChildElements() const
+{
+  return 0;
+}
+
+
+const SedBase*
+SedBase::getChildElement(unsigned int n) const
+{
+  return NULL;
+}
+
+
+unsigned int
+SedBase::getChanges() const
+{
+  return mChanges;
+}
+
+
+bool
+SedBase::hasChanges() const
+{
+  return mChanges != 0;
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+void
+SedBase::acceptChildElements(SedVisitor& v) const
+{
+  unsigned int count = getNumChildElements();
+  for (unsigned int n = 0; n < count; ++n)
+  {
+    getChildElement(n)->accept(v);
+  }
+}
+
+
+/*
+ * Lists only count as present if they have items, as they are only
+ * written then.
+ */
+static bool
+isPresentChild(const SedBase* child)
+{
+  if (child == NULL) return false;
+  if (child->getTypeCode() != SEDML_LIST_OF) return true;
+
+  return static_cast<const SedListOf*>(child)->size() > 0;
+}
+
+
+unsigned int
+SedBase::countChildElements(const SedBase* const* children,
+                            unsigned int count)
+{
+  unsigned int present = 0;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    if (isPresentChild(children[i])) ++present;
+  }
+
+  return present;
+}
+
+
+const SedBase*
+SedBase::selectChildElement(const SedBase* const* children,
+                            unsigned int count, unsigned int n)
+{
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    if (!isPresentChild(children[i])) continue;
+    if (n == 0) return children[i];
+    --n;
+  }
+
+  return NULL;
+}
+
+/** @endcond */
+
 /** @cond doxygenLibsedmlInternal */
 /*
  * Creates a new SedBase object with the given level and version.
@@ -121,10 +209,11 @@ SedBase::SedBase (unsigned int level, unsigned int version)
  , mColumn    ( 0 )
  , mParentSedObject (NULL)
   , mHasBeenDeleted(false)
+  , mChanges(CHANGE_STRUCTURE)
   , mEmptyString("")
- , mURI("")
+ , mURI(&SedNamespaces::internURI(""))
 {
-  mSedNamespaces = new SedNamespaces(level, version);
+  mSedNamespaces = SedNamespaces::acquireShared(level, version);
 
   //
   // Sets the XMLNS URI of corresponding SED-ML Level/Version to
@@ -140,7 +229,7 @@ SedBase::SedBase (unsigned int level, unsigned int version)
  * Creates a new SedBase object with the given SedNamespaces.
  * Only subclasses may create SedBase objects.
  */
-SedBase::SedBase (SedNamespaces *sedmlns) 
+SedBase::SedBase (const SedNamespaces *sedmlns) 
  : mMetaId("")
  , mId("")
  , mName("")
@@ -155,17 +244,18 @@ SedBase::SedBase (SedNamespaces *sedmlns)
  , mColumn(0)
  , mParentSedObject(NULL)
  , mHasBeenDeleted(false)
+ , mChanges(CHANGE_STRUCTURE)
  , mEmptyString("")
- , mURI("")
+ , mURI(&SedNamespaces::internURI(""))
 {
   if (!sedmlns)
   {
-    std::string err("SedBase::SedBase(SedNamespaces*) : SedNamespaces is null");
+    std::string err("SedBase::SedBase(const SedNamespaces*) : SedNamespaces is null");
     throw SedConstructorException(err);
   }
-  mSedNamespaces = sedmlns->clone();
+  mSedNamespaces = SedNamespaces::acquireShared(sedmlns);
 
-  setElementNamespace(static_cast<SedNamespaces>(*mSedNamespaces).getURI());
+  setElementNamespace(mSedNamespaces->getURI());
 }
 /** @endcond */
 
@@ -188,7 +278,8 @@ SedBase::SedBase(const SedBase& orig)
   , mLine(orig.mLine)
   , mColumn(orig.mColumn)
   , mParentSedObject(NULL)
-  , mURI(orig.mURI)
+  , mChanges(CHANGE_STRUCTURE)
+  , mURI(&SedNamespaces::internURI(*orig.mURI))
 {
   if(orig.mNotes != NULL)
     this->mNotes = new LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode(*const_cast<SedBase&>(orig).getNotes());
@@ -200,11 +291,8 @@ SedBase::SedBase(const SedBase& orig)
   else
     this->mAnnotation = NULL;
 
-  if(orig.getSedNamespaces() != NULL)
-    this->mSedNamespaces =
-    new SedNamespaces(*const_cast<SedBase&>(orig).getSedNamespaces());
-  else
-    this->mSedNamespaces = NULL;
+  this->mSedNamespaces =
+    SedNamespaces::acquireShared(orig.getSedNamespaces());
 
   this->mHasBeenDeleted = false;
 }
@@ -216,11 +304,74 @@ SedBase::SedBase(const SedBase& orig)
  */
 SedBase::~SedBase ()
 {
+  // the document-wide id index must not hold on to deleted elements
+  SedDocument* doc = getSedDocument();
+  if (doc != NULL && doc != this)
+  {
+    doc->invalidateIdIndex();
+
+    // nor must the record of changed elements
+    markParentsChanged();
+    doc->recordRemoval(this);
+  }
+
   if (mNotes != NULL)       delete mNotes;
   if (mAnnotation != NULL)  delete mAnnotation;
-  if (mSedNamespaces != NULL)  delete mSedNamespaces;
+  SedNamespaces::releaseShared(mSedNamespaces);
+  SedNamespaces::releaseURI(*mURI);
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+void*
+SedBase::operator new (size_t size)
+{
+  return SedArena::allocateObject(size);
+}
+
+
+void*
+SedBase::operator new (size_t size, const std::nothrow_t&) throw()
+{
+  try
+  {
+    return SedArena::allocateObject(size);
+  }
+  catch (...)
+  {
+    return NULL;
+  }
+}
+
+
+void*
+SedBase::operator new (size_t, void* place) throw()
+{
+  return place;
+}
+
+
+void
+SedBase::operator delete (void* ptr)
+{
+  SedArena::deallocateObject(ptr);
+}
+
+
+void
+SedBase::operator delete (void* ptr, const std::nothrow_t&) throw()
+{
+  SedArena::deallocateObject(ptr);
 }
 
+
+void
+SedBase::operator delete (void*, void*) throw()
+{
+}
+/** @endcond */
+
+
 /*
  * Assignment operator
  */
@@ -254,16 +405,16 @@ SedBase& SedBase::operator=(const SedBase& rhs)
     this->mParentSedObject = rhs.mParentSedObject;
     this->mUserData   = rhs.mUserData;
 
-    delete this->mSedNamespaces;
+    SedNamespaces* sedmlns = SedNamespaces::acquireShared(rhs.mSedNamespaces);
+    SedNamespaces::releaseShared(this->mSedNamespaces);
+    this->mSedNamespaces = sedmlns;
 
-    if(rhs.mSedNamespaces != NULL)
-      this->mSedNamespaces =
-      new SedNamespaces(*const_cast<SedBase&>(rhs).mSedNamespaces);
-    else
-      this->mSedNamespaces = NULL;
 
+    const std::string* uri = &SedNamespaces::internURI(*rhs.mURI);
+    SedNamespaces::releaseURI(*this->mURI);
+    this->mURI = uri;
 
-    this->mURI = rhs.mURI;
+    markChanged(CHANGE_ALL);
   }
 
   return *this;
@@ -387,7 +538,7 @@ SedBase::getURI() const
   if (doc == NULL)
     return getElementNamespace();
 
-  SedNamespaces* sedmlns = doc->getSedNamespaces();
+  const SedNamespaces* sedmlns = doc->getSedNamespaces();
 
   if (sedmlns == NULL)
     return getElementNamespace();
@@ -455,10 +606,10 @@ SedBase::unsetUserData()
 LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces*
 SedBase::getNamespaces()
 {
-  if (mSed != NULL)
-    return mSed->getSedNamespaces()->getNamespaces();
-  else
-    return mSedNamespaces->getNamespaces();
+  // the caller may modify the namespaces, so they must not be shared
+  SedBase* owner = (mSed != NULL) ? static_cast<SedBase*>(mSed) : this;
+  owner->detachSedNamespaces();
+  return owner->mSedNamespaces->getNamespaces();
 }
 
 
@@ -468,17 +619,18 @@ SedBase::getNamespaces()
 const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces*
 SedBase::getElementNamespaces() const
 {
-  if (mSedNamespaces == NULL) return NULL;
-  return mSedNamespaces->getNamespaces();
+  const SedNamespaces* sedmlns = mSedNamespaces;
+  if (sedmlns == NULL) return NULL;
+  return sedmlns->getNamespaces();
 }
 
 const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces*
 SedBase::getNamespaces() const
 {
-  if (mSed != NULL)
-    return mSed->getSedNamespaces()->getNamespaces();
-  else
-    return mSedNamespaces->getNamespaces();
+  // the const accessor of SedNamespaces does not unshare the namespaces
+  const SedNamespaces* sedmlns =
+    (mSed != NULL) ? mSed->getSedNamespaces() : mSedNamespaces;
+  return sedmlns->getNamespaces();
 }
 
 
@@ -690,8 +842,7 @@ SedBase::setId (const std::string& sid)
 {
   if (sid.empty())
   {
-    mId.erase();
-    return LIBSEDML_OPERATION_SUCCESS;
+    return unsetId();
   }
   else if (!(SyntaxChecker::isValidXMLID(sid)))
   {
@@ -701,12 +852,16 @@ SedBase::setId (const std::string& sid)
   {
       return LIBSEDML_UNEXPECTED_ATTRIBUTE;
   }
+  const std::string oldId = getId();
   mId = sid;
+  updateIdIndexes(oldId);
   return LIBSEDML_OPERATION_SUCCESS;
 }
 
 int SedBase::setName(const std::string& name)
 {
+    invalidateEffectiveStyles();
+
     if (name.empty())
     {
         mName.erase();
@@ -763,7 +918,8 @@ SedBase::setAnnotation (const std::string& annotation)
   // you might not have a document !!
   if (getSedDocument() != NULL)
   {
-    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns = getSedDocument()->getNamespaces();
+    const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns =
+      static_cast<const SedDocument*>(getSedDocument())->getNamespaces();
     annt_xmln = LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode::convertStringToXMLNode(annotation,xmlns);
   }
   else
@@ -879,7 +1035,8 @@ SedBase::appendAnnotation (const std::string& annotation)
   LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* annt_xmln;
   if (getSedDocument() != NULL)
   {
-    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns = getSedDocument()->getNamespaces();
+    const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns =
+      static_cast<const SedDocument*>(getSedDocument())->getNamespaces();
     annt_xmln = LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode::convertStringToXMLNode(annotation,xmlns);
   }
   else
@@ -1013,7 +1170,8 @@ SedBase::replaceTopLevelAnnotationElement(const std::string& annotation)
   LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* annt_xmln;
   if (getSedDocument() != NULL)
   {
-    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns = getSedDocument()->getNamespaces();
+    const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns =
+      static_cast<const SedDocument*>(getSedDocument())->getNamespaces();
     annt_xmln = LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode::convertStringToXMLNode(annotation,xmlns);
   }
   else
@@ -1116,7 +1274,8 @@ SedBase::setNotes(const std::string& notes, bool addXHTMLMarkup)
     // you might not have a document !!
     if (getSedDocument() != NULL)
     {
-      LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns = getSedDocument()->getNamespaces();
+      const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns =
+        static_cast<const SedDocument*>(getSedDocument())->getNamespaces();
       notes_xmln = LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode::convertStringToXMLNode(notes,xmlns);
     }
     else
@@ -1524,7 +1683,8 @@ SedBase::appendNotes(const std::string& notes)
   // you might not have a document !!
   if (getSedDocument() != NULL)
   {
-      LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns = getSedDocument()->getNamespaces();
+      const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns =
+        static_cast<const SedDocument*>(getSedDocument())->getNamespaces();
       notes_xmln = LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode::convertStringToXMLNode(notes,xmlns);
   }
   else
@@ -1548,6 +1708,13 @@ SedBase::appendNotes(const std::string& notes)
 void
 SedBase::setSedDocument (SedDocument* d)
 {
+  // an object leaving a document must not stay in its record of changes
+  SedDocument* oldDoc = getSedDocument();
+  if (oldDoc != NULL && oldDoc != d && oldDoc != this)
+  {
+    oldDoc->recordRemoval(this);
+  }
+
   mSed = d;
 }
 
@@ -1560,6 +1727,12 @@ SedBase::setSedDocument (SedDocument* d)
 void
 SedBase::connectToParent (SedBase* parent)
 {
+  // a style leaving a document changes the styles based on it
+  invalidateEffectiveStyles();
+
+  // the parent losing this object has to be checked again
+  markParentsChanged();
+
   mParentSedObject = parent;
   if (mParentSedObject)
   {
@@ -1567,7 +1740,12 @@ SedBase::connectToParent (SedBase* parent)
     cout << "[DEBUG] connectToParent " << this << " (parent) " << SedTypeCode_toString(parent->getTypeCode(),"core")
          << " " << parent->getSedDocument() << endl;
 #endif
-    setSedDocument(mParentSedObject->getSedDocument());
+    SedDocument* doc = mParentSedObject->getSedDocument();
+    if (doc != NULL) doc->invalidateIdIndex();
+    setSedDocument(doc);
+    invalidateEffectiveStyles();
+    markChanged(CHANGE_STRUCTURE);
+    markParentsChanged();
   }
   else
   {
@@ -1589,6 +1767,99 @@ void
 SedBase::connectToChild()
 {
 }
+
+
+/*
+ * Informs the id indexes of the parent SedListOf and of the SedDocument
+ * that the id of this object changed from oldId.
+ */
+void
+SedBase::updateIdIndexes(const std::string& oldId)
+{
+  if (getId() == oldId) return;
+
+  invalidateEffectiveStyles();
+  markChanged(CHANGE_ID);
+
+  SedBase* parent = getParentSedObject();
+  if (parent != NULL && parent->getTypeCode() == SEDML_LIST_OF)
+  {
+    static_cast<SedListOf*>(parent)->updateIdIndex(this, oldId);
+  }
+
+  SedDocument* doc = getSedDocument();
+  if (doc != NULL && doc != this)
+  {
+    doc->updateIdIndex(this, oldId);
+    doc->recordIdChange(oldId);
+  }
+}
+
+
+/*
+ * Discards the effective styles cached by the SedDocument if this object
+ * is a style or part of one.
+ */
+void
+SedBase::invalidateEffectiveStyles()
+{
+  switch (getTypeCode())
+  {
+  case SEDML_STYLE:
+  case SEDML_LINE:
+  case SEDML_MARKER:
+  case SEDML_FILL:
+    break;
+  default:
+    return;
+  }
+
+  SedDocument* doc = getSedDocument();
+  if (doc != NULL && doc != this)
+  {
+    doc->invalidateEffectiveStyles();
+  }
+}
+
+
+/*
+ * Records the given changes to this object, and the object itself with
+ * the SedDocument.
+ */
+void
+SedBase::markChanged(unsigned int changes)
+{
+  mChanges |= changes;
+
+  SedDocument* doc = getSedDocument();
+  if (doc != NULL)
+  {
+    doc->recordChange(this, changes);
+  }
+}
+
+
+/*
+ * Records that the parent of this object gained or lost a child.  The
+ * parent of a SedListOf is marked as well, as it is the object that
+ * requires the child.  Nothing is marked unless the SedDocument tracks its
+ * changes, which also guarantees that the parents are still alive.
+ */
+void
+SedBase::markParentsChanged()
+{
+  SedDocument* doc = getSedDocument();
+  if (doc == NULL || !doc->getTrackChanges() || mParentSedObject == NULL)
+  {
+    return;
+  }
+
+  mParentSedObject->markChanged(CHANGE_CHILDREN);
+  if (mParentSedObject->mParentSedObject != NULL)
+  {
+    mParentSedObject->mParentSedObject->markChanged(CHANGE_CHILDREN);
+  }
+}
 /** @endcond */
 
 SedBase*
@@ -1657,11 +1928,21 @@ SedBase::setNamespaces(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* xmlns)
 {
   if (xmlns == NULL)
   {
-    mSedNamespaces->setNamespaces(NULL);
+    // elements without namespace declarations of their own (the most
+    // common case when reading) share an interned object
+    unsigned int level = (mSedNamespaces != NULL) ?
+      mSedNamespaces->getLevel() : getLevel();
+    unsigned int version = (mSedNamespaces != NULL) ?
+      mSedNamespaces->getVersion() : getVersion();
+    SedNamespaces* sedmlns =
+      SedNamespaces::acquireSharedWithoutNamespaces(level, version);
+    SedNamespaces::releaseShared(mSedNamespaces);
+    mSedNamespaces = sedmlns;
     return LIBSEDML_OPERATION_SUCCESS;
   }
   else
   {
+    detachSedNamespaces();
     mSedNamespaces->setNamespaces(xmlns);
     return LIBSEDML_OPERATION_SUCCESS;
   }
@@ -1686,12 +1967,15 @@ SedBase::unsetMetaId ()
 int
 SedBase::unsetId ()
 {
+  const std::string oldId = getId();
   mId.erase();
+  updateIdIndexes(oldId);
   return LIBSEDML_OPERATION_SUCCESS;
 }
 
 int SedBase::unsetName()
 {
+    invalidateEffectiveStyles();
     mName.erase();
     return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -1773,9 +2057,12 @@ bool
 SedBase::hasValidLevelVersionNamespaceCombination()
 {
   int typecode = getTypeCode();
-  LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces *xmlns = getNamespaces();
+  // only reads the namespaces, so do not force a private copy of them
+  const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces *xmlns =
+    static_cast<const SedBase*>(this)->getNamespaces();
 
-  return hasValidLevelVersionNamespaceCombination(typecode, xmlns);
+  return hasValidLevelVersionNamespaceCombination(typecode,
+    const_cast<LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces*>(xmlns));
 }
 
 /** @cond doxygenLibsedmlInternal */
@@ -1821,8 +2108,8 @@ SedBase::matchesCoreSedNamespace(const SedBase * sb)
 {
   bool match = false;
 
-  SedNamespaces *sedmlns = getSedNamespaces();
-  SedNamespaces *sedmlns_rhs = sb->getSedNamespaces();
+  const SedNamespaces *sedmlns = getSedNamespaces();
+  const SedNamespaces *sedmlns_rhs = sb->getSedNamespaces();
 
   if (sedmlns->getLevel() != sedmlns_rhs->getLevel())
     return match;
@@ -1848,8 +2135,8 @@ SedBase::matchesCoreSedNamespace(const SedBase * sb) const
 {
   bool match = false;
 
-  SedNamespaces *sedmlns = getSedNamespaces();
-  SedNamespaces *sedmlns_rhs = sb->getSedNamespaces();
+  const SedNamespaces *sedmlns = getSedNamespaces();
+  const SedNamespaces *sedmlns_rhs = sb->getSedNamespaces();
 
   if (sedmlns->getLevel() != sedmlns_rhs->getLevel())
     return match;
@@ -1934,28 +2221,30 @@ SedBase::setSedNamespaces(SedNamespaces * sedmlns)
 void
 SedBase::setSedNamespacesAndOwn(SedNamespaces * sedmlns)
 {
-    XMLNamespaces* names = mSedNamespaces->getNamespaces();
-    XMLNamespaces* newnames = sedmlns->getNamespaces();
+    // only read the namespaces here, so that they can stay shared
+    const SedNamespaces* oldns = mSedNamespaces;
+    const SedNamespaces* newns = sedmlns;
+    const XMLNamespaces* names = oldns->getNamespaces();
     for (int name = 0; name < names->getNumNamespaces(); name++)
     {
         if (!names->getPrefix(name).empty())
         {
-            if (!newnames->containsUri(names->getURI(name)))
+            if (!newns->getNamespaces()->containsUri(names->getURI(name)))
             {
                 sedmlns->addNamespace(names->getURI(name), names->getPrefix(name));
             }
         }
     }
-    delete mSedNamespaces;
-    mSedNamespaces = sedmlns;
+    SedNamespaces::releaseShared(mSedNamespaces);
+    mSedNamespaces = SedNamespaces::adoptShared(sedmlns);
 
-    if (sedmlns != NULL)
-        setElementNamespace(sedmlns->getURI());
+    if (mSedNamespaces != NULL)
+        setElementNamespace(mSedNamespaces->getURI());
 }
 
 
 /* gets the Sednamespaces - internal use only*/
-SedNamespaces *
+const SedNamespaces *
 SedBase::getSedNamespaces() const
 {
   if (mSed != NULL)
@@ -1963,9 +2252,33 @@ SedBase::getSedNamespaces() const
   
   // initialize SED-ML namespace if need be
   if (mSedNamespaces == NULL)
-    const_cast<SedBase*>(this)->mSedNamespaces = new SedNamespaces(getLevel(), getVersion());
+    const_cast<SedBase*>(this)->mSedNamespaces =
+      SedNamespaces::acquireShared(getLevel(), getVersion());
   return mSedNamespaces;  
 }
+
+
+/*
+ * makes sure the Sednamespaces of this object are not shared with
+ * other objects, so that they can be modified - internal use only
+ */
+void
+SedBase::detachSedNamespaces()
+{
+  if (mSedNamespaces == NULL)
+    mSedNamespaces = SedNamespaces::acquireShared(getLevel(), getVersion());
+  mSedNamespaces = SedNamespaces::detachShared(mSedNamespaces);
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsedmlInternal */
+/* forgets the changes returned by getChanges() - internal use only */
+void
+SedBase::clearChanges()
+{
+  mChanges = 0;
+}
 /** @endcond */
 
 
@@ -2222,7 +2535,8 @@ SedBase::read (LIBSBML_CPP_NAMESPACE_QUALIFIER XMLInputStream& stream)
     // need to check that any prefix on the sedmlns also occurs on element
     // remembering the horrible situation where the sedmlns might be declared
     // with more than one prefix
-    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces * xmlns = this->getSedNamespaces()->getNamespaces();
+    const SedNamespaces* sedmlns = this->getSedNamespaces();
+    const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces * xmlns = sedmlns->getNamespaces();
     if (xmlns != NULL)
     {
       int i = xmlns->getIndexByPrefix(element.getPrefix());
@@ -2265,8 +2579,7 @@ SedBase::read (LIBSBML_CPP_NAMESPACE_QUALIFIER XMLInputStream& stream)
 
         if (error == true && errorLoggedAlready == false)
         {
-          static ostringstream errMsg;
-          errMsg.str("");
+          ostringstream errMsg;
           errMsg << "The prefix for the <sedml> element does not match "
             << "the prefix for the SED-ML namespace.  This means that "
             << "the <sedml> element in not in the SedNamespace."<< endl;
@@ -2284,7 +2597,8 @@ SedBase::read (LIBSBML_CPP_NAMESPACE_QUALIFIER XMLInputStream& stream)
     // checks if the given default namespace (if any) is a valid
     // SED-ML namespace
     //
-    checkDefaultNamespace(mSedNamespaces->getNamespaces(), element.getName());
+    const SedNamespaces* sedmlns = mSedNamespaces;
+    checkDefaultNamespace(sedmlns->getNamespaces(), element.getName());
     if (!element.getPrefix().empty())
     {
       LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces * prefixedNS = new LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces();
@@ -2294,6 +2608,13 @@ SedBase::read (LIBSBML_CPP_NAMESPACE_QUALIFIER XMLInputStream& stream)
     }
   }
 
+  SedReaderHandler* handler = (mSed != NULL) ? mSed->getReaderHandler() : NULL;
+
+  if (handler != NULL && mSed == this)
+  {
+    handler->startDocument(mSed);
+  }
+
   if ( element.isEnd() ) return;
 
   while ( stream.isGood() )
@@ -2322,6 +2643,12 @@ SedBase::read (LIBSBML_CPP_NAMESPACE_QUALIFIER XMLInputStream& stream)
     {
       const std::string nextName = next.getName();
 
+      if (handler != NULL && handler->skipElement(this, nextName))
+      {
+        stream.skipPastEnd( stream.next() );
+        continue;
+      }
+
       SedBase * object = createObject(stream);
 
       if (object != NULL)
@@ -2334,6 +2661,25 @@ SedBase::read (LIBSBML_CPP_NAMESPACE_QUALIFIER XMLInputStream& stream)
 
         if ( !stream.isGood() ) break;
 
+        // when streaming, the children of the top-level lists are passed
+        // on as soon as they are complete, rather than kept in the document
+        if (handler != NULL && mParentSedObject != NULL
+          && mParentSedObject == mSed && getTypeCode() == SEDML_LIST_OF)
+        {
+          bool keep = handler->handleElement(object);
+
+          SedListOf* list = static_cast<SedListOf*>(this);
+          SedBase* removed = NULL;
+          for (unsigned int n = list->size(); n > 0 && removed == NULL; --n)
+          {
+            if (list->get(n - 1) == object)
+              removed = list->remove(n - 1);
+          }
+
+          if (removed != NULL && !keep)
+            delete removed;
+        }
+
         // checkSedListOfPopulated(object);
       }
       else if ( !( readOtherXML(stream)
@@ -2718,10 +3064,13 @@ SedBase::readAttributes (const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLAttributes& at
   // id SId (use = "optional" )
   // 
 
+  const std::string oldId = getId();
   bool assigned = attributes.readInto("id", mId, getErrorLog(), false, getLine(), getColumn());
 
   if (assigned == true)
   {
+    updateIdIndexes(oldId);
+
     if (mId.empty() == true)
     {
       logEmptyString(mId, level, version, (string)"<" + getElementName() + ">");
@@ -2944,16 +3293,18 @@ SedBase::checkMathMLNamespace(const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLToken ele
   }
   if (match == 0)
   {
-    if( mSed->getNamespaces() != NULL)
+    const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* docns =
+      static_cast<const SedDocument*>(mSed)->getNamespaces();
+    if( docns != NULL)
     /* check for implicit declaration */
     {
-      for (n = 0; n < mSed->getNamespaces()->getLength(); n++)
+      for (n = 0; n < docns->getLength(); n++)
       {
-        if (!strcmp(mSed->getNamespaces()->getURI(n).c_str(),
+        if (!strcmp(docns->getURI(n).c_str(),
                     "http://www.w3.org/1998/Math/MathML"))
         {
           match = 1;
-          prefix = mSed->getNamespaces()->getPrefix(n);
+          prefix = docns->getPrefix(n);
           break;
         }
       }
@@ -2983,18 +3334,17 @@ SedBase::checkDefaultNamespace(const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespac
     return;
 
   const std::string defaultURI = xmlns->getURI(prefix);
-  if (defaultURI.empty() || mURI == defaultURI)
+  if (defaultURI.empty() || *mURI == defaultURI)
     return;
 
   // if this element (SedBase derived) has notes or annotation elements,
   // it is ok for them to be in the SED-ML namespace!
   if ( SedNamespaces::isSedNamespace(defaultURI)
-       && !SedNamespaces::isSedNamespace(mURI)
+       && !SedNamespaces::isSedNamespace(*mURI)
        && (elementName == "notes" || elementName == "annotation"))
     return;
 
-  static ostringstream errMsg;
-  errMsg.str("");
+  ostringstream errMsg;
   errMsg << "xmlns=\"" << defaultURI << "\" in <" << elementName
          << "> element is an invalid namespace." << endl;
 
@@ -3069,12 +3419,14 @@ SedBase::checkAnnotation()
     if (topLevel.getNamespaces().getLength() == 0)
     {
       // not on actual element - is it explicit ??
-      if(mSed != NULL && mSed->getNamespaces() != NULL)
+      const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* docns = (mSed != NULL)
+        ? static_cast<const SedDocument*>(mSed)->getNamespaces() : NULL;
+      if(docns != NULL)
       /* check for implicit declaration */
       {
-        for (n = 0; n < mSed->getNamespaces()->getLength(); n++)
+        for (n = 0; n < docns->getLength(); n++)
         {
-          if (!strcmp(mSed->getNamespaces()->getPrefix(n).c_str(),
+          if (!strcmp(docns->getPrefix(n).c_str(),
                         prefix.c_str()))
           {
             implicitNSdecl = true;
@@ -3161,7 +3513,8 @@ SedBase::checkXHTML(const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode * xhtml)
     }
   }
 
-  LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* toplevelNS = (mSed) ? mSed->getNamespaces() : NULL;
+  const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces* toplevelNS = (mSed)
+    ? static_cast<const SedDocument*>(mSed)->getNamespaces() : NULL;
 
   /*
   * namespace declaration is variable
@@ -3292,7 +3645,9 @@ SedBase::setSedBaseFields (const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLToken& eleme
 int
 SedBase::setElementNamespace(const std::string &uri)
 {
-  mURI = uri;
+  const std::string* interned = &SedNamespaces::internURI(uri);
+  SedNamespaces::releaseURI(*mURI);
+  mURI = interned;
 
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -3303,7 +3658,7 @@ SedBase::setElementNamespace(const std::string &uri)
 const std::string&
 SedBase::getElementNamespace() const
 {
-  return mURI;
+  return *mURI;
 }
 /** @endcond */
 
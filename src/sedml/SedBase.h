@@ -56,6 +56,7 @@
 #ifdef __cplusplus
 
 
+#include <new>
 #include <string>
 #include <stdexcept>
 #include <algorithm>
@@ -101,6 +102,26 @@ public:
   SedBase& operator=(const SedBase& rhs);
 
 
+  /** @cond doxygenLibsedmlInternal */
+  /**
+   * Allocates SED-ML objects from the SedArena that is current on the
+   * calling thread, or from the heap if there is none.
+   */
+  static void* operator new (size_t size);
+  static void* operator new (size_t size, const std::nothrow_t&) throw();
+  static void* operator new (size_t size, void* place) throw();
+
+
+  /**
+   * Frees SED-ML objects; memory from a SedArena is only released
+   * together with the arena.
+   */
+  static void operator delete (void* ptr);
+  static void operator delete (void* ptr, const std::nothrow_t&) throw();
+  static void operator delete (void* ptr, void* place) throw();
+  /** @endcond */
+
+
   /** @cond doxygenLibsedmlInternal */
   /**
    * Accepts the given SedVisitor for this SedBase object.
@@ -176,6 +197,71 @@ public:
   virtual List* getAllElements(SedElementFilter* filter = NULL);
 
 
+  /**
+   * Returns the number of SED-ML objects directly contained in this object.
+   *
+   * The children are the non-empty lists and the single child objects of
+   * this object, or the items if this object is a SedListOf.  Together
+   * with getChildElement() this allows walking a document without
+   * building any lists; see SedElementIterator.
+   *
+   * @return the number of child objects.
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth SED-ML object directly contained in this object, in
+   * the order in which getAllElements() lists them.
+   *
+   * @param n the index of the child object.
+   *
+   * @return the nth child object, or @c NULL if there is no such object.
+   *
+   * @see getNumChildElements()
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
+
+  /**
+   * The kinds of change recorded for a SED-ML object; see getChanges().
+   */
+  enum ChangeType
+  {
+    CHANGE_ID         = 0x01  /*!< The id was set, changed or unset. */
+  , CHANGE_REFERENCES = 0x02  /*!< An attribute referring to another object changed. */
+  , CHANGE_CHILDREN   = 0x04  /*!< The math or a child object was set, added or removed. */
+  , CHANGE_STRUCTURE  = 0x08  /*!< The object was created or added to a parent. */
+  , CHANGE_ALL        = 0x0f  /*!< All of the above. */
+  };
+
+
+  /**
+   * Returns the kinds of change made to this object since they were last
+   * cleared.
+   *
+   * The setters of the id, of the attributes that refer to other objects
+   * and of the math record their change here, as do adding and removing
+   * child objects.  If the object belongs to a SedDocument whose changes
+   * are tracked, the document records the object as well, so that a
+   * SedValidator can check just the objects that changed; see
+   * SedValidator::revalidate().
+   *
+   * @return a combination of the values of ChangeType, or @c 0 if this
+   * object has not changed.
+   */
+  unsigned int getChanges() const;
+
+
+  /**
+   * @return @c true if this object has changed since its changes were last
+   * cleared.
+   *
+   * @see getChanges()
+   */
+  bool hasChanges() const;
+
+
   /**
    * Returns the value of the "metaid" attribute of this object.
    *
@@ -455,6 +541,10 @@ public:
    * information.  It is used to communicate the SED-ML Level, Version, and (in
    * Level&nbsp;3) packages used in addition to SED-ML Level&nbsp;3 Core.
    *
+   * As the returned namespaces may be modified, this makes sure they are
+   * no longer shared with other objects.  Use the const version where
+   * possible.
+   *
    * @return the XML Namespaces associated with this SED-ML object, or @c NULL
    * in certain very usual circumstances where a namespace is not set.
    *
@@ -1682,7 +1772,16 @@ public:
 
   /** @cond doxygenLibsedmlInternal */
   /* gets the Sednamespaces - internal use only*/
-  virtual SedNamespaces * getSedNamespaces() const;
+  virtual const SedNamespaces * getSedNamespaces() const;
+
+  /* unshares the Sednamespaces before they are modified - internal use only */
+  void detachSedNamespaces();
+  /** @endcond */
+
+
+  /** @cond doxygenLibsedmlInternal */
+  /* forgets the changes returned by getChanges() - internal use only */
+  void clearChanges();
   /** @endcond */
 
 
@@ -1816,6 +1915,32 @@ protected:
 
   bool getHasBeenDeleted() const;
 
+
+  /** @cond doxygenLibsedmlInternal */
+  /**
+   * Calls accept() with the given SedVisitor on all child objects, for
+   * implementations of accept() to do between visit() and leave().
+   */
+  void acceptChildElements (SedVisitor& v) const;
+
+
+  /**
+   * Returns the number of the given child objects that are present, i.e.
+   * that are not @c NULL and, for lists, not empty.
+   */
+  static unsigned int countChildElements (const SedBase* const* children,
+                                          unsigned int count);
+
+
+  /**
+   * Returns the nth of the given child objects that are present, or @c NULL
+   * if fewer are present.
+   */
+  static const SedBase* selectChildElement (const SedBase* const* children,
+                                            unsigned int count,
+                                            unsigned int n);
+  /** @endcond */
+
   /** 
    * When overridden allows SedBase elements to use the text included in between
    * the elements tags. The default implementation does nothing.
@@ -1841,7 +1966,7 @@ protected:
    * Creates a new SedBase object with the given SedNamespaces.
    * Only subclasses may create SedBase objects.
    */
-  SedBase (SedNamespaces* sedmlns);
+  SedBase (const SedNamespaces *sedmlns);
 
 
   /**
@@ -2068,6 +2193,36 @@ protected:
   SedBase* getRootElement();
 
 
+  /**
+   * Informs the id indexes of the parent SedListOf and of the SedDocument
+   * (if any) that the id of this object changed from @p oldId.
+   */
+  void updateIdIndexes(const std::string& oldId);
+
+
+  /**
+   * Discards the effective styles cached by the SedDocument, if this object
+   * is a style or part of one.
+   */
+  void invalidateEffectiveStyles();
+
+
+  /**
+   * Records the given changes to this object, and the object itself with
+   * the SedDocument (if any).
+   *
+   * @param changes a combination of the values of ChangeType.
+   */
+  void markChanged(unsigned int changes);
+
+
+  /**
+   * Records that the parent of this object gained or lost a child, if the
+   * changes of the SedDocument are tracked.
+   */
+  void markParentsChanged();
+
+
   // ------------------------------------------------------------------
 
 
@@ -2079,6 +2234,7 @@ protected:
   LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode*        mNotes;
   LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode*        mAnnotation;
   SedDocument*   mSed;
+  // shared with other elements, see SedNamespaces::acquireShared()
   SedNamespaces* mSedNamespaces;
   void*          mUserData;
 
@@ -2088,6 +2244,7 @@ protected:
   /* store the parent SED-ML object */
   SedBase* mParentSedObject;
   bool mHasBeenDeleted;
+  unsigned int mChanges;
 
   std::string mEmptyString;
 
@@ -2107,7 +2264,11 @@ protected:
   // if the prefix needs to be added when printing elements in some package extension.
   // (i.e. used in getPrefix function)
   //
-  std::string mURI;
+  // The URI is interned (see SedNamespaces::internURI), so that elements do
+  // not each hold a copy of the same string; each element holds one
+  // reference to it, released with SedNamespaces::releaseURI.
+  //
+  const std::string* mURI;
 
   
   /** @endcond */
@@ -65,7 +65,7 @@ SedBounds::SedBounds(unsigned int level, unsigned int version)
 /*
  * Creates a new SedBounds using the given SedNamespaces object @p sedmlns.
  */
-SedBounds::SedBounds(SedNamespaces *sedmlns)
+SedBounds::SedBounds(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mLowerBound (util_NaN())
   , mIsSetLowerBound (false)
@@ -372,7 +372,11 @@ SedBounds::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedBounds::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
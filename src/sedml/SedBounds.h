@@ -123,7 +123,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedBounds(SedNamespaces *sedmlns);
+  SedBounds(const SedNamespaces *sedmlns);
 
 
   /**
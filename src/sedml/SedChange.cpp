@@ -69,7 +69,7 @@ SedChange::SedChange(unsigned int level, unsigned int version)
 /*
  * Creates a new SedChange using the given SedNamespaces object @p sedmlns.
  */
-SedChange::SedChange(SedNamespaces *sedmlns)
+SedChange::SedChange(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mTarget ("")
   , mElementName("change")
@@ -307,7 +307,11 @@ SedChange::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedChange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -98,7 +98,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedChange(SedNamespaces *sedmlns);
+  SedChange(const SedNamespaces *sedmlns);
 
 
   /**
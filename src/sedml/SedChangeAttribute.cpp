@@ -64,7 +64,7 @@ SedChangeAttribute::SedChangeAttribute(unsigned int level,
  * Creates a new SedChangeAttribute using the given SedNamespaces object @p
  * sedmlns.
  */
-SedChangeAttribute::SedChangeAttribute(SedNamespaces *sedmlns)
+SedChangeAttribute::SedChangeAttribute(const SedNamespaces *sedmlns)
   : SedChange(sedmlns)
   , mNewValue ("")
 {
@@ -231,7 +231,11 @@ SedChangeAttribute::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedChangeAttribute::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
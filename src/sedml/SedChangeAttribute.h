@@ -93,7 +93,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedChangeAttribute(SedNamespaces *sedmlns);
+  SedChangeAttribute(const SedNamespaces *sedmlns);
 
 
   /**
@@ -63,7 +63,7 @@ SedChangeXML::SedChangeXML(unsigned int level, unsigned int version)
 /*
  * Creates a new SedChangeXML using the given SedNamespaces object @p sedmlns.
  */
-SedChangeXML::SedChangeXML(SedNamespaces *sedmlns)
+SedChangeXML::SedChangeXML(const SedNamespaces *sedmlns)
   : SedChange(sedmlns)
   , mNewXML (NULL)
 {
@@ -280,7 +280,11 @@ SedChangeXML::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedChangeXML::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -94,7 +94,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedChangeXML(SedNamespaces *sedmlns);
+  SedChangeXML(const SedNamespaces *sedmlns);
 
 
   /**
@@ -0,0 +1,975 @@
+/**
+ * @file SedCompiledMath.cpp
+ * @brief Implementation of the SedCompiledMath class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedFunctionalRange.h>
+#include <sedml/SedParameter.h>
+
+#include <sbml/math/ASTNode.h>
+#include <sbml/xml/XMLAttributes.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Number of points each instruction processes at a time; small enough for
+ * the stack of a program to stay in the cache.
+ */
+static const size_t SED_MATH_BLOCK = 256;
+
+static const double SED_NAN = numeric_limits<double>::quiet_NaN();
+
+/*
+ * The instructions of the stack machine.
+ */
+enum SedMathOp
+{
+  SED_OP_CONST
+, SED_OP_SLOT
+, SED_OP_AGGREGATE
+, SED_OP_NEG
+, SED_OP_ADD
+, SED_OP_SUB
+, SED_OP_MUL
+, SED_OP_DIV
+, SED_OP_POW
+, SED_OP_MIN
+, SED_OP_MAX
+, SED_OP_QUOTIENT
+, SED_OP_REM
+, SED_OP_EQ
+, SED_OP_NEQ
+, SED_OP_LT
+, SED_OP_GT
+, SED_OP_LEQ
+, SED_OP_GEQ
+, SED_OP_AND
+, SED_OP_OR
+, SED_OP_XOR
+, SED_OP_NOT
+, SED_OP_SELECT
+, SED_OP_ABS
+, SED_OP_EXP
+, SED_OP_LN
+, SED_OP_LOG10
+, SED_OP_SQRT
+, SED_OP_FLOOR
+, SED_OP_CEIL
+, SED_OP_FACTORIAL
+, SED_OP_SIN
+, SED_OP_COS
+, SED_OP_TAN
+, SED_OP_SEC
+, SED_OP_CSC
+, SED_OP_COT
+, SED_OP_SINH
+, SED_OP_COSH
+, SED_OP_TANH
+, SED_OP_SECH
+, SED_OP_CSCH
+, SED_OP_COTH
+, SED_OP_ASIN
+, SED_OP_ACOS
+, SED_OP_ATAN
+, SED_OP_ASEC
+, SED_OP_ACSC
+, SED_OP_ACOT
+, SED_OP_ASINH
+, SED_OP_ACOSH
+, SED_OP_ATANH
+, SED_OP_ASECH
+, SED_OP_ACSCH
+, SED_OP_ACOTH
+};
+
+/*
+ * The aggregate functions of SED-ML.
+ */
+enum SedMathAggregate
+{
+  SED_AGGREGATE_MIN
+, SED_AGGREGATE_MAX
+, SED_AGGREGATE_SUM
+, SED_AGGREGATE_PRODUCT
+, SED_AGGREGATE_MEAN
+};
+
+
+/*
+ * Returns the aggregate function with the given name, or -1.  The name is
+ * either that of a function call or the definitionURL of a csymbol, as in
+ * "http://sed-ml.org/#sum".
+ */
+static int
+getAggregateFunction(const std::string& name)
+{
+  string function = name;
+  size_t hash = function.rfind('#');
+  if (hash != string::npos) function = function.substr(hash + 1);
+
+  if (function == "min")     return SED_AGGREGATE_MIN;
+  if (function == "max")     return SED_AGGREGATE_MAX;
+  if (function == "sum")     return SED_AGGREGATE_SUM;
+  if (function == "product") return SED_AGGREGATE_PRODUCT;
+  if (function == "mean")    return SED_AGGREGATE_MEAN;
+  return -1;
+}
+
+
+/*
+ * Returns the instruction computing the given unary function, or -1.
+ */
+static int
+getUnaryOp(int type)
+{
+  switch (type)
+  {
+  case AST_FUNCTION_ABS:      return SED_OP_ABS;
+  case AST_FUNCTION_EXP:      return SED_OP_EXP;
+  case AST_FUNCTION_LN:       return SED_OP_LN;
+  case AST_FUNCTION_FLOOR:    return SED_OP_FLOOR;
+  case AST_FUNCTION_CEILING:  return SED_OP_CEIL;
+  case AST_FUNCTION_FACTORIAL: return SED_OP_FACTORIAL;
+  case AST_FUNCTION_SIN:      return SED_OP_SIN;
+  case AST_FUNCTION_COS:      return SED_OP_COS;
+  case AST_FUNCTION_TAN:      return SED_OP_TAN;
+  case AST_FUNCTION_SEC:      return SED_OP_SEC;
+  case AST_FUNCTION_CSC:      return SED_OP_CSC;
+  case AST_FUNCTION_COT:      return SED_OP_COT;
+  case AST_FUNCTION_SINH:     return SED_OP_SINH;
+  case AST_FUNCTION_COSH:     return SED_OP_COSH;
+  case AST_FUNCTION_TANH:     return SED_OP_TANH;
+  case AST_FUNCTION_SECH:     return SED_OP_SECH;
+  case AST_FUNCTION_CSCH:     return SED_OP_CSCH;
+  case AST_FUNCTION_COTH:     return SED_OP_COTH;
+  case AST_FUNCTION_ARCSIN:   return SED_OP_ASIN;
+  case AST_FUNCTION_ARCCOS:   return SED_OP_ACOS;
+  case AST_FUNCTION_ARCTAN:   return SED_OP_ATAN;
+  case AST_FUNCTION_ARCSEC:   return SED_OP_ASEC;
+  case AST_FUNCTION_ARCCSC:   return SED_OP_ACSC;
+  case AST_FUNCTION_ARCCOT:   return SED_OP_ACOT;
+  case AST_FUNCTION_ARCSINH:  return SED_OP_ASINH;
+  case AST_FUNCTION_ARCCOSH:  return SED_OP_ACOSH;
+  case AST_FUNCTION_ARCTANH:  return SED_OP_ATANH;
+  case AST_FUNCTION_ARCSECH:  return SED_OP_ASECH;
+  case AST_FUNCTION_ARCCSCH:  return SED_OP_ACSCH;
+  case AST_FUNCTION_ARCCOTH:  return SED_OP_ACOTH;
+  default:                    return -1;
+  }
+}
+
+/** @endcond */
+
+
+SedCompiledMath::SedCompiledMath ()
+  : mProgram()
+  , mAggregates()
+  , mSlotNames()
+  , mSlotValues()
+  , mSlotArrays()
+  , mIsCompiled(false)
+{
+  mProgram.maxDepth = 0;
+}
+
+
+SedCompiledMath::~SedCompiledMath ()
+{
+}
+
+
+int
+SedCompiledMath::compile (const ASTNode* math)
+{
+  clear();
+
+  unsigned int depth = 0;
+  if (!compileNode(math, mProgram, depth))
+  {
+    clear();
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  mIsCompiled = true;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedCompiledMath::compile (const SedDataGenerator* dataGenerator)
+{
+  return compileElement(dataGenerator);
+}
+
+
+int
+SedCompiledMath::compile (const SedComputeChange* computeChange)
+{
+  return compileElement(computeChange);
+}
+
+
+int
+SedCompiledMath::compile (const SedSetValue* setValue)
+{
+  return compileElement(setValue);
+}
+
+
+int
+SedCompiledMath::compile (const SedFunctionalRange* functionalRange)
+{
+  return compileElement(functionalRange);
+}
+
+
+bool
+SedCompiledMath::isCompiled () const
+{
+  return mIsCompiled;
+}
+
+
+unsigned int
+SedCompiledMath::getNumSlots () const
+{
+  return (unsigned int)mSlotNames.size();
+}
+
+
+const std::string&
+SedCompiledMath::getSlotName (unsigned int n) const
+{
+  static const string empty;
+  return (n < mSlotNames.size()) ? mSlotNames[n] : empty;
+}
+
+
+int
+SedCompiledMath::getSlotIndex (const std::string& name) const
+{
+  vector<string>::const_iterator it =
+    find(mSlotNames.begin(), mSlotNames.end(), name);
+  return (it == mSlotNames.end()) ? -1 : (int)(it - mSlotNames.begin());
+}
+
+
+int
+SedCompiledMath::setSlotValue (int slot, double value)
+{
+  if (slot < 0 || (unsigned int)slot >= mSlotNames.size())
+  {
+    return LIBSEDML_INDEX_EXCEEDS_SIZE;
+  }
+
+  mSlotValues[(unsigned int)slot] = value;
+  mSlotArrays[(unsigned int)slot] = NULL;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedCompiledMath::setSlotValues (int slot, const double* values)
+{
+  if (slot < 0 || (unsigned int)slot >= mSlotNames.size())
+  {
+    return LIBSEDML_INDEX_EXCEEDS_SIZE;
+  }
+
+  mSlotArrays[(unsigned int)slot] = values;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedCompiledMath::evaluate (size_t numPoints, double* result) const
+{
+  if (!mIsCompiled || result == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  unsigned int maxDepth = mProgram.maxDepth;
+  for (vector<Aggregate>::const_iterator it = mAggregates.begin();
+       it != mAggregates.end(); ++it)
+  {
+    maxDepth = max(maxDepth, it->program.maxDepth);
+  }
+
+  vector<double> stack(maxDepth * SED_MATH_BLOCK);
+  vector<double> aggregates(mAggregates.size(), SED_NAN);
+  const double* aggregateValues = aggregates.empty() ? NULL : &aggregates[0];
+
+  // aggregates are compiled before the aggregates using them, so that
+  // they can be reduced in order
+  for (size_t n = 0; n < mAggregates.size(); ++n)
+  {
+    const Aggregate& aggregate = mAggregates[n];
+    double value = 0.0;
+
+    switch (aggregate.function)
+    {
+    case SED_AGGREGATE_MIN:     value = numeric_limits<double>::infinity(); break;
+    case SED_AGGREGATE_MAX:     value = -numeric_limits<double>::infinity(); break;
+    case SED_AGGREGATE_PRODUCT: value = 1.0; break;
+    default:                    value = 0.0; break;
+    }
+
+    for (size_t start = 0; start < numPoints; start += SED_MATH_BLOCK)
+    {
+      size_t length = min(SED_MATH_BLOCK, numPoints - start);
+      run(aggregate.program, start, length, SED_MATH_BLOCK, aggregateValues,
+          &stack[0]);
+
+      const double* values = &stack[0];
+      switch (aggregate.function)
+      {
+      case SED_AGGREGATE_MIN:
+        for (size_t i = 0; i < length; ++i) value = min(value, values[i]);
+        break;
+      case SED_AGGREGATE_MAX:
+        for (size_t i = 0; i < length; ++i) value = max(value, values[i]);
+        break;
+      case SED_AGGREGATE_PRODUCT:
+        for (size_t i = 0; i < length; ++i) value *= values[i];
+        break;
+      default:
+        for (size_t i = 0; i < length; ++i) value += values[i];
+        break;
+      }
+    }
+
+    if (aggregate.function == SED_AGGREGATE_MEAN)
+    {
+      value = (numPoints > 0) ? value / numPoints : SED_NAN;
+    }
+    else if (numPoints == 0 && (aggregate.function == SED_AGGREGATE_MIN
+                             || aggregate.function == SED_AGGREGATE_MAX))
+    {
+      value = SED_NAN;
+    }
+
+    aggregates[n] = value;
+  }
+
+  for (size_t start = 0; start < numPoints; start += SED_MATH_BLOCK)
+  {
+    size_t length = min(SED_MATH_BLOCK, numPoints - start);
+    run(mProgram, start, length, SED_MATH_BLOCK, aggregateValues, &stack[0]);
+    copy(stack.begin(), stack.begin() + length, result + start);
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+double
+SedCompiledMath::evaluate (size_t point) const
+{
+  if (!mIsCompiled) return SED_NAN;
+
+  unsigned int maxDepth = mProgram.maxDepth;
+  for (vector<Aggregate>::const_iterator it = mAggregates.begin();
+       it != mAggregates.end(); ++it)
+  {
+    maxDepth = max(maxDepth, it->program.maxDepth);
+  }
+
+  vector<double> stack(maxDepth);
+  vector<double> aggregates(mAggregates.size(), SED_NAN);
+  const double* aggregateValues = aggregates.empty() ? NULL : &aggregates[0];
+
+  // over a single point, every aggregate is just the value of its argument
+  for (size_t n = 0; n < mAggregates.size(); ++n)
+  {
+    run(mAggregates[n].program, point, 1, 1, aggregateValues, &stack[0]);
+    aggregates[n] = stack[0];
+  }
+
+  run(mProgram, point, 1, 1, aggregateValues, &stack[0]);
+  return stack[0];
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+void
+SedCompiledMath::clear ()
+{
+  mProgram.code.clear();
+  mProgram.maxDepth = 0;
+  mAggregates.clear();
+  mSlotNames.clear();
+  mSlotValues.clear();
+  mSlotArrays.clear();
+  mIsCompiled = false;
+}
+
+
+unsigned int
+SedCompiledMath::getSlot (const std::string& name)
+{
+  int slot = getSlotIndex(name);
+  if (slot >= 0) return (unsigned int)slot;
+
+  mSlotNames.push_back(name);
+  mSlotValues.push_back(SED_NAN);
+  mSlotArrays.push_back(NULL);
+  return (unsigned int)mSlotNames.size() - 1;
+}
+
+
+void
+SedCompiledMath::emit (Program& program, unsigned int& depth, unsigned int op,
+                       unsigned int arg, double value)
+{
+  Instruction instruction;
+  instruction.op = op;
+  instruction.arg = arg;
+  instruction.value = value;
+  program.code.push_back(instruction);
+
+  switch (op)
+  {
+  case SED_OP_CONST:
+  case SED_OP_SLOT:
+  case SED_OP_AGGREGATE:
+    ++depth;
+    break;
+
+  case SED_OP_SELECT:
+    depth -= 2;
+    break;
+
+  case SED_OP_NEG:
+  case SED_OP_NOT:
+    break;
+
+  default:
+    // the remaining instructions are binary, or unary functions
+    if (op < SED_OP_ABS) --depth;
+    break;
+  }
+
+  program.maxDepth = max(program.maxDepth, depth);
+}
+
+
+bool
+SedCompiledMath::compileNode (const ASTNode* node, Program& program,
+                              unsigned int& depth)
+{
+  if (node == NULL) return false;
+
+  unsigned int numChildren = node->getNumChildren();
+  int type = node->getType();
+
+  switch (type)
+  {
+  case AST_INTEGER:
+    emit(program, depth, SED_OP_CONST, 0, (double)node->getInteger());
+    return true;
+
+  case AST_REAL:
+  case AST_REAL_E:
+  case AST_RATIONAL:
+    emit(program, depth, SED_OP_CONST, 0, node->getReal());
+    return true;
+
+  case AST_CONSTANT_E:
+    emit(program, depth, SED_OP_CONST, 0, exp(1.0));
+    return true;
+
+  case AST_CONSTANT_PI:
+    emit(program, depth, SED_OP_CONST, 0, 4.0 * atan(1.0));
+    return true;
+
+  case AST_NAME_AVOGADRO:
+    emit(program, depth, SED_OP_CONST, 0, 6.02214179e23);
+    return true;
+
+  case AST_CONSTANT_TRUE:
+    emit(program, depth, SED_OP_CONST, 0, 1.0);
+    return true;
+
+  case AST_CONSTANT_FALSE:
+    emit(program, depth, SED_OP_CONST, 0, 0.0);
+    return true;
+
+  case AST_NAME:
+  case AST_NAME_TIME:
+  {
+    const char* name = node->getName();
+    if (name == NULL) return false;
+    emit(program, depth, SED_OP_SLOT, getSlot(name));
+    return true;
+  }
+
+  case AST_PLUS:
+    return compileChain(node, SED_OP_ADD, 0.0, program, depth);
+
+  case AST_TIMES:
+    return compileChain(node, SED_OP_MUL, 1.0, program, depth);
+
+  case AST_MINUS:
+    if (numChildren == 1)
+    {
+      if (!compileNode(node->getChild(0), program, depth)) return false;
+      emit(program, depth, SED_OP_NEG);
+      return true;
+    }
+    if (numChildren != 2) return false;
+    return compileChain(node, SED_OP_SUB, 0.0, program, depth);
+
+  case AST_DIVIDE:
+    if (numChildren != 2) return false;
+    return compileChain(node, SED_OP_DIV, 0.0, program, depth);
+
+  case AST_POWER:
+  case AST_FUNCTION_POWER:
+    if (numChildren != 2) return false;
+    return compileChain(node, SED_OP_POW, 0.0, program, depth);
+
+  case AST_FUNCTION_QUOTIENT:
+    if (numChildren != 2) return false;
+    return compileChain(node, SED_OP_QUOTIENT, 0.0, program, depth);
+
+  case AST_FUNCTION_REM:
+    if (numChildren != 2) return false;
+    return compileChain(node, SED_OP_REM, 0.0, program, depth);
+
+  case AST_FUNCTION_ROOT:
+    if (numChildren == 1)
+    {
+      if (!compileNode(node->getChild(0), program, depth)) return false;
+      emit(program, depth, SED_OP_SQRT);
+      return true;
+    }
+    if (numChildren != 2) return false;
+    // x^(1/degree)
+    if (!compileNode(node->getChild(1), program, depth)) return false;
+    emit(program, depth, SED_OP_CONST, 0, 1.0);
+    if (!compileNode(node->getChild(0), program, depth)) return false;
+    emit(program, depth, SED_OP_DIV);
+    emit(program, depth, SED_OP_POW);
+    return true;
+
+  case AST_FUNCTION_LOG:
+    if (numChildren == 1)
+    {
+      if (!compileNode(node->getChild(0), program, depth)) return false;
+      emit(program, depth, SED_OP_LOG10);
+      return true;
+    }
+    if (numChildren != 2) return false;
+    // ln(x)/ln(base)
+    if (!compileNode(node->getChild(1), program, depth)) return false;
+    emit(program, depth, SED_OP_LN);
+    if (!compileNode(node->getChild(0), program, depth)) return false;
+    emit(program, depth, SED_OP_LN);
+    emit(program, depth, SED_OP_DIV);
+    return true;
+
+  case AST_FUNCTION_PIECEWISE:
+  {
+    // value1 condition1 ... otherwise, folded from the back into selects
+    unsigned int numPieces = numChildren / 2;
+    for (unsigned int i = 0; i < numPieces; ++i)
+    {
+      if (!compileNode(node->getChild(2 * i), program, depth)) return false;
+      if (!compileNode(node->getChild(2 * i + 1), program, depth)) return false;
+    }
+
+    if (numChildren % 2 == 1)
+    {
+      if (!compileNode(node->getChild(numChildren - 1), program, depth))
+        return false;
+    }
+    else
+    {
+      emit(program, depth, SED_OP_CONST, 0, SED_NAN);
+    }
+
+    for (unsigned int i = 0; i < numPieces; ++i)
+    {
+      emit(program, depth, SED_OP_SELECT);
+    }
+    return true;
+  }
+
+  case AST_LOGICAL_AND:
+    return compileChain(node, SED_OP_AND, 1.0, program, depth);
+
+  case AST_LOGICAL_OR:
+    return compileChain(node, SED_OP_OR, 0.0, program, depth);
+
+  case AST_LOGICAL_XOR:
+    return compileChain(node, SED_OP_XOR, 0.0, program, depth);
+
+  case AST_LOGICAL_NOT:
+    if (numChildren != 1) return false;
+    if (!compileNode(node->getChild(0), program, depth)) return false;
+    emit(program, depth, SED_OP_NOT);
+    return true;
+
+  case AST_RELATIONAL_EQ:
+    return compileRelational(node, SED_OP_EQ, program, depth);
+
+  case AST_RELATIONAL_NEQ:
+    if (numChildren != 2) return false;
+    return compileRelational(node, SED_OP_NEQ, program, depth);
+
+  case AST_RELATIONAL_LT:
+    return compileRelational(node, SED_OP_LT, program, depth);
+
+  case AST_RELATIONAL_GT:
+    return compileRelational(node, SED_OP_GT, program, depth);
+
+  case AST_RELATIONAL_LEQ:
+    return compileRelational(node, SED_OP_LEQ, program, depth);
+
+  case AST_RELATIONAL_GEQ:
+    return compileRelational(node, SED_OP_GEQ, program, depth);
+
+  case AST_FUNCTION_MIN:
+    if (numChildren == 1)
+      return compileAggregate(node, SED_AGGREGATE_MIN, program, depth);
+    if (numChildren == 0) return false;
+    return compileChain(node, SED_OP_MIN, 0.0, program, depth);
+
+  case AST_FUNCTION_MAX:
+    if (numChildren == 1)
+      return compileAggregate(node, SED_AGGREGATE_MAX, program, depth);
+    if (numChildren == 0) return false;
+    return compileChain(node, SED_OP_MAX, 0.0, program, depth);
+
+  case AST_FUNCTION:
+  {
+    int function = -1;
+
+    const XMLAttributes* url = node->getDefinitionURL();
+    if (url != NULL && url->hasAttribute("definitionURL"))
+    {
+      function = getAggregateFunction(url->getValue("definitionURL"));
+    }
+    if (function < 0 && node->getName() != NULL)
+    {
+      function = getAggregateFunction(node->getName());
+    }
+
+    if (function < 0 || numChildren != 1) return false;
+    return compileAggregate(node, (unsigned int)function, program, depth);
+  }
+
+  default:
+    break;
+  }
+
+  int op = getUnaryOp(type);
+  if (op < 0 || numChildren != 1) return false;
+
+  if (!compileNode(node->getChild(0), program, depth)) return false;
+  emit(program, depth, (unsigned int)op);
+  return true;
+}
+
+
+/*
+ * Compiles an n-ary operator into a chain of binary instructions.
+ */
+bool
+SedCompiledMath::compileChain (const ASTNode* node, unsigned int op,
+                               double empty, Program& program,
+                               unsigned int& depth)
+{
+  unsigned int numChildren = node->getNumChildren();
+  if (numChildren == 0)
+  {
+    emit(program, depth, SED_OP_CONST, 0, empty);
+    return true;
+  }
+
+  if (!compileNode(node->getChild(0), program, depth)) return false;
+
+  for (unsigned int i = 1; i < numChildren; ++i)
+  {
+    if (!compileNode(node->getChild(i), program, depth)) return false;
+    emit(program, depth, op);
+  }
+
+  return true;
+}
+
+
+/*
+ * Compiles a relation between several arguments, e.g. a < b < c, as
+ * (a < b) and (b < c).
+ */
+bool
+SedCompiledMath::compileRelational (const ASTNode* node, unsigned int op,
+                                    Program& program, unsigned int& depth)
+{
+  unsigned int numChildren = node->getNumChildren();
+  if (numChildren < 2) return false;
+
+  for (unsigned int i = 0; i + 1 < numChildren; ++i)
+  {
+    if (!compileNode(node->getChild(i), program, depth)) return false;
+    if (!compileNode(node->getChild(i + 1), program, depth)) return false;
+    emit(program, depth, op);
+
+    if (i > 0) emit(program, depth, SED_OP_AND);
+  }
+
+  return true;
+}
+
+
+/*
+ * Compiles the argument of an aggregate function into a program of its
+ * own, which is reduced over all points before the main program runs.
+ */
+bool
+SedCompiledMath::compileAggregate (const ASTNode* node, unsigned int function,
+                                   Program& program, unsigned int& depth)
+{
+  Aggregate aggregate;
+  aggregate.function = function;
+  aggregate.program.maxDepth = 0;
+
+  unsigned int aggregateDepth = 0;
+  if (!compileNode(node->getChild(0), aggregate.program, aggregateDepth))
+  {
+    return false;
+  }
+
+  mAggregates.push_back(aggregate);
+  emit(program, depth, SED_OP_AGGREGATE, (unsigned int)mAggregates.size() - 1);
+  return true;
+}
+
+
+/*
+ * Runs the given program for @p length points starting at @p start.  The
+ * stack holds one row of @p stride values per level; the result is left in
+ * the first row.
+ */
+void
+SedCompiledMath::run (const Program& program, size_t start, size_t length,
+                      size_t stride, const double* aggregates,
+                      double* stack) const
+{
+  size_t level = 0;
+
+#define SED_MATH_UNARY(OP, EXPR)                                     \
+  case OP:                                                           \
+  {                                                                  \
+    double* a = stack + (level - 1) * stride;                        \
+    for (size_t i = 0; i < length; ++i)                              \
+    {                                                                \
+      const double x = a[i];                                         \
+      a[i] = (EXPR);                                                 \
+    }                                                                \
+    break;                                                           \
+  }
+
+#define SED_MATH_BINARY(OP, EXPR)                                    \
+  case OP:                                                           \
+  {                                                                  \
+    double* a = stack + (level - 2) * stride;                        \
+    const double* b = stack + (level - 1) * stride;                  \
+    for (size_t i = 0; i < length; ++i)                              \
+    {                                                                \
+      const double x = a[i];                                         \
+      const double y = b[i];                                         \
+      a[i] = (EXPR);                                                 \
+    }                                                                \
+    --level;                                                         \
+    break;                                                           \
+  }
+
+  for (vector<Instruction>::const_iterator it = program.code.begin();
+       it != program.code.end(); ++it)
+  {
+    switch (it->op)
+    {
+    case SED_OP_CONST:
+    {
+      fill(stack + level * stride, stack + level * stride + length, it->value);
+      ++level;
+      break;
+    }
+
+    case SED_OP_SLOT:
+    {
+      double* a = stack + level * stride;
+      const double* values = mSlotArrays[it->arg];
+      if (values != NULL)
+        copy(values + start, values + start + length, a);
+      else
+        fill(a, a + length, mSlotValues[it->arg]);
+      ++level;
+      break;
+    }
+
+    case SED_OP_AGGREGATE:
+    {
+      fill(stack + level * stride, stack + level * stride + length,
+           aggregates[it->arg]);
+      ++level;
+      break;
+    }
+
+    case SED_OP_SELECT:
+    {
+      double* value = stack + (level - 3) * stride;
+      const double* condition = stack + (level - 2) * stride;
+      const double* otherwise = stack + (level - 1) * stride;
+      for (size_t i = 0; i < length; ++i)
+      {
+        value[i] = (condition[i] != 0.0) ? value[i] : otherwise[i];
+      }
+      level -= 2;
+      break;
+    }
+
+    SED_MATH_UNARY(SED_OP_NEG, -x)
+    SED_MATH_UNARY(SED_OP_NOT, (x == 0.0) ? 1.0 : 0.0)
+    SED_MATH_UNARY(SED_OP_ABS, fabs(x))
+    SED_MATH_UNARY(SED_OP_EXP, exp(x))
+    SED_MATH_UNARY(SED_OP_LN, log(x))
+    SED_MATH_UNARY(SED_OP_LOG10, log10(x))
+    SED_MATH_UNARY(SED_OP_SQRT, sqrt(x))
+    SED_MATH_UNARY(SED_OP_FLOOR, floor(x))
+    SED_MATH_UNARY(SED_OP_CEIL, ceil(x))
+    SED_MATH_UNARY(SED_OP_FACTORIAL, tgamma(x + 1.0))
+    SED_MATH_UNARY(SED_OP_SIN, sin(x))
+    SED_MATH_UNARY(SED_OP_COS, cos(x))
+    SED_MATH_UNARY(SED_OP_TAN, tan(x))
+    SED_MATH_UNARY(SED_OP_SEC, 1.0 / cos(x))
+    SED_MATH_UNARY(SED_OP_CSC, 1.0 / sin(x))
+    SED_MATH_UNARY(SED_OP_COT, 1.0 / tan(x))
+    SED_MATH_UNARY(SED_OP_SINH, sinh(x))
+    SED_MATH_UNARY(SED_OP_COSH, cosh(x))
+    SED_MATH_UNARY(SED_OP_TANH, tanh(x))
+    SED_MATH_UNARY(SED_OP_SECH, 1.0 / cosh(x))
+    SED_MATH_UNARY(SED_OP_CSCH, 1.0 / sinh(x))
+    SED_MATH_UNARY(SED_OP_COTH, 1.0 / tanh(x))
+    SED_MATH_UNARY(SED_OP_ASIN, asin(x))
+    SED_MATH_UNARY(SED_OP_ACOS, acos(x))
+    SED_MATH_UNARY(SED_OP_ATAN, atan(x))
+    SED_MATH_UNARY(SED_OP_ASEC, acos(1.0 / x))
+    SED_MATH_UNARY(SED_OP_ACSC, asin(1.0 / x))
+    SED_MATH_UNARY(SED_OP_ACOT, atan(1.0 / x))
+    SED_MATH_UNARY(SED_OP_ASINH, asinh(x))
+    SED_MATH_UNARY(SED_OP_ACOSH, acosh(x))
+    SED_MATH_UNARY(SED_OP_ATANH, atanh(x))
+    SED_MATH_UNARY(SED_OP_ASECH, acosh(1.0 / x))
+    SED_MATH_UNARY(SED_OP_ACSCH, asinh(1.0 / x))
+    SED_MATH_UNARY(SED_OP_ACOTH, atanh(1.0 / x))
+
+    SED_MATH_BINARY(SED_OP_ADD, x + y)
+    SED_MATH_BINARY(SED_OP_SUB, x - y)
+    SED_MATH_BINARY(SED_OP_MUL, x * y)
+    SED_MATH_BINARY(SED_OP_DIV, x / y)
+    SED_MATH_BINARY(SED_OP_POW, pow(x, y))
+    SED_MATH_BINARY(SED_OP_MIN, (y < x) ? y : x)
+    SED_MATH_BINARY(SED_OP_MAX, (y > x) ? y : x)
+    SED_MATH_BINARY(SED_OP_QUOTIENT, trunc(x / y))
+    SED_MATH_BINARY(SED_OP_REM, fmod(x, y))
+    SED_MATH_BINARY(SED_OP_EQ, (x == y) ? 1.0 : 0.0)
+    SED_MATH_BINARY(SED_OP_NEQ, (x != y) ? 1.0 : 0.0)
+    SED_MATH_BINARY(SED_OP_LT, (x < y) ? 1.0 : 0.0)
+    SED_MATH_BINARY(SED_OP_GT, (x > y) ? 1.0 : 0.0)
+    SED_MATH_BINARY(SED_OP_LEQ, (x <= y) ? 1.0 : 0.0)
+    SED_MATH_BINARY(SED_OP_GEQ, (x >= y) ? 1.0 : 0.0)
+    SED_MATH_BINARY(SED_OP_AND, (x != 0.0 && y != 0.0) ? 1.0 : 0.0)
+    SED_MATH_BINARY(SED_OP_OR, (x != 0.0 || y != 0.0) ? 1.0 : 0.0)
+    SED_MATH_BINARY(SED_OP_XOR, ((x != 0.0) != (y != 0.0)) ? 1.0 : 0.0)
+
+    default:
+      break;
+    }
+  }
+
+#undef SED_MATH_UNARY
+#undef SED_MATH_BINARY
+}
+
+
+/*
+ * Compiles the math of a SED-ML element, and binds its parameters.
+ */
+template <class Element>
+int
+SedCompiledMath::compileElement (const Element* element)
+{
+  if (element == NULL)
+  {
+    clear();
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  int result = compile(element->getMath());
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  for (unsigned int i = 0; i < element->getNumParameters(); ++i)
+  {
+    const SedParameter* parameter = element->getParameter(i);
+    setSlotValue(getSlotIndex(parameter->getId()), parameter->getValue());
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,307 @@
+/**
+ * @file SedCompiledMath.h
+ * @brief Definition of the SedCompiledMath class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedCompiledMath
+ * @sbmlbrief{} Math of a SED-ML element, compiled for fast evaluation over
+ * many points.
+ *
+ * Data generators, compute changes, set values and functional ranges store
+ * their math as a libSBML ASTNode tree.  Walking that tree for each point
+ * of a simulation result is slow, so SedCompiledMath translates the tree
+ * once into a flat program for a stack machine.  Every name used in the
+ * math becomes a numbered slot, which is bound either to a single value
+ * (for instance a parameter) or to an array holding one value per point
+ * (for instance the results for a variable).  evaluate() then runs the
+ * program over blocks of points, each instruction being a simple loop
+ * over the block that the compiler can vectorize.
+ *
+ * The aggregate functions of SED-ML (@c min, @c max, @c sum, @c product
+ * and @c mean, applied to a single argument) reduce their argument over
+ * all points, and the result is used for every point.  Called with more
+ * than one argument, @c min and @c max are evaluated point by point.
+ *
+ * @code{.cpp}
+SedCompiledMath math;
+if (math.compile(dataGenerator) == LIBSEDML_OPERATION_SUCCESS)
+{
+  // the parameters of the data generator have been bound already
+  for (unsigned int i = 0; i < dataGenerator->getNumVariables(); ++i)
+  {
+    const SedVariable* var = dataGenerator->getVariable(i);
+    math.setSlotValues(math.getSlotIndex(var->getId()), getResults(var));
+  }
+
+  std::vector<double> result(numPoints);
+  math.evaluate(numPoints, &result[0]);
+}
+ * @endcode
+ */
+
+
+#ifndef SedCompiledMath_h
+#define SedCompiledMath_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sbml/common/libsbml-namespace.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+class ASTNode;
+LIBSBML_CPP_NAMESPACE_END
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDataGenerator;
+class SedComputeChange;
+class SedSetValue;
+class SedFunctionalRange;
+
+
+class LIBSEDML_EXTERN SedCompiledMath
+{
+public:
+
+  /**
+   * Creates a new, empty SedCompiledMath.
+   */
+  SedCompiledMath ();
+
+
+  /**
+   * Destroys this SedCompiledMath.
+   */
+  ~SedCompiledMath ();
+
+
+  /**
+   * Compiles the given math.  Each name used in @p math is assigned a
+   * slot, all of which are initially bound to NaN.
+   *
+   * @param math the math to compile.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if @p math is @c NULL or uses constructs that cannot be evaluated
+   * (such as user-defined functions or delays).
+   */
+  int compile (const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* math);
+
+
+  /**
+   * Compiles the math of the given data generator, and binds the slots of
+   * its parameters to their values.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  int compile (const SedDataGenerator* dataGenerator);
+
+
+  /**
+   * Compiles the math of the given compute change, and binds the slots of
+   * its parameters to their values.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  int compile (const SedComputeChange* computeChange);
+
+
+  /**
+   * Compiles the math of the given set value, and binds the slots of its
+   * parameters to their values.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  int compile (const SedSetValue* setValue);
+
+
+  /**
+   * Compiles the math of the given functional range, and binds the slots
+   * of its parameters to their values.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  int compile (const SedFunctionalRange* functionalRange);
+
+
+  /**
+   * @return @c true if math has been compiled successfully.
+   */
+  bool isCompiled () const;
+
+
+  /**
+   * @return the number of slots, i.e. of distinct names used in the math.
+   */
+  unsigned int getNumSlots () const;
+
+
+  /**
+   * @return the name of the nth slot, or an empty string.
+   */
+  const std::string& getSlotName (unsigned int n) const;
+
+
+  /**
+   * @return the index of the slot with the given name, or -1 if the math
+   * does not use that name.
+   */
+  int getSlotIndex (const std::string& name) const;
+
+
+  /**
+   * Binds the given slot to a single value, used for all points.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INDEX_EXCEEDS_SIZE, OperationReturnValues_t}
+   */
+  int setSlotValue (int slot, double value);
+
+
+  /**
+   * Binds the given slot to an array with one value per point.  The array
+   * is not copied; it must stay valid, and hold at least as many values as
+   * points are evaluated, until the slot is bound to something else.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INDEX_EXCEEDS_SIZE, OperationReturnValues_t}
+   */
+  int setSlotValues (int slot, const double* values);
+
+
+  /**
+   * Evaluates the math for the given number of points.
+   *
+   * @param numPoints the number of points.
+   * @param result array receiving @p numPoints values.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if no math has been compiled.
+   */
+  int evaluate (size_t numPoints, double* result) const;
+
+
+  /**
+   * Evaluates the math for a single point.  Aggregate functions reduce
+   * over this point only.
+   *
+   * @param point the index of the point in the arrays bound to the slots.
+   *
+   * @return the value of the math, or NaN if no math has been compiled.
+   */
+  double evaluate (size_t point = 0) const;
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  struct Instruction
+  {
+    unsigned int op;
+    unsigned int arg;
+    double value;
+  };
+
+  struct Program
+  {
+    std::vector<Instruction> code;
+    unsigned int maxDepth;
+  };
+
+  struct Aggregate
+  {
+    unsigned int function;
+    Program program;
+  };
+
+  void clear ();
+  unsigned int getSlot (const std::string& name);
+  bool compileNode (const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* node,
+                    Program& program, unsigned int& depth);
+  bool compileChain (const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* node,
+                     unsigned int op, double empty,
+                     Program& program, unsigned int& depth);
+  bool compileRelational (const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* node,
+                          unsigned int op,
+                          Program& program, unsigned int& depth);
+  bool compileAggregate (const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* node,
+                         unsigned int function,
+                         Program& program, unsigned int& depth);
+  void emit (Program& program, unsigned int& depth, unsigned int op,
+             unsigned int arg = 0, double value = 0.0);
+
+  void run (const Program& program, size_t start, size_t length,
+            size_t stride, const double* aggregates, double* stack) const;
+
+  template <class Element>
+  int compileElement (const Element* element);
+
+  Program mProgram;
+  std::vector<Aggregate> mAggregates;
+  std::vector<std::string> mSlotNames;
+  std::vector<double> mSlotValues;
+  std::vector<const double*> mSlotArrays;
+  bool mIsCompiled;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedCompiledMath_h */
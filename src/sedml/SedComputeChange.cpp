@@ -69,7 +69,7 @@ SedComputeChange::SedComputeChange(unsigned int level, unsigned int version)
  * Creates a new SedComputeChange using the given SedNamespaces object @p
  * sedmlns.
  */
-SedComputeChange::SedComputeChange(SedNamespaces *sedmlns)
+SedComputeChange::SedComputeChange(const SedNamespaces *sedmlns)
   : SedChange(sedmlns)
   , mMath (NULL)
   , mVariables (sedmlns)
@@ -246,6 +246,8 @@ SedComputeChange::isSetMath() const
 int
 SedComputeChange::setMath(const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* math)
 {
+  markChanged(CHANGE_CHILDREN);
+
   if (mMath == math)
   {
     return LIBSEDML_OPERATION_SUCCESS;
@@ -275,6 +277,8 @@ SedComputeChange::setMath(const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* math)
 int
 SedComputeChange::unsetMath()
 {
+  markChanged(CHANGE_CHILDREN);
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -739,7 +743,48 @@ SedComputeChange::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedComputeChange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedComputeChange
+ */
+unsigned int
+SedComputeChange::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mVariables,
+    &mParameters
+  };
+
+  return SedChange::getNumChildElements() +
+    countChildElements(children, 2);
+}
+
+
+/*
+ * Returns the nth child object of this SedComputeChange
+ */
+const SedBase*
+SedComputeChange::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedChange::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedChange::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mVariables,
+    &mParameters
+  };
+
+  return selectChildElement(children, 2, n - inherited);
 }
 
 /** @endcond */
@@ -99,7 +99,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedComputeChange(SedNamespaces *sedmlns);
+  SedComputeChange(const SedNamespaces *sedmlns);
 
 
   /**
@@ -811,6 +811,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedComputeChange
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedComputeChange
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
@@ -69,7 +69,7 @@ SedCurve::SedCurve(unsigned int level, unsigned int version)
 /*
  * Creates a new SedCurve using the given SedNamespaces object @p sedmlns.
  */
-SedCurve::SedCurve(SedNamespaces *sedmlns)
+SedCurve::SedCurve(const SedNamespaces *sedmlns)
   : SedAbstractCurve(sedmlns)
   , mLogY (false)
   , mIsSetLogY (false)
@@ -352,6 +352,8 @@ SedCurve::setLogY(bool logY)
 int
 SedCurve::setYDataReference(const std::string& yDataReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(yDataReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -406,6 +408,8 @@ SedCurve::setType(const std::string& type)
 int
 SedCurve::setXErrorUpper(const std::string& xErrorUpper)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(xErrorUpper)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -424,6 +428,8 @@ SedCurve::setXErrorUpper(const std::string& xErrorUpper)
 int
 SedCurve::setXErrorLower(const std::string& xErrorLower)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(xErrorLower)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -442,6 +448,8 @@ SedCurve::setXErrorLower(const std::string& xErrorLower)
 int
 SedCurve::setYErrorUpper(const std::string& yErrorUpper)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(yErrorUpper)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -460,6 +468,8 @@ SedCurve::setYErrorUpper(const std::string& yErrorUpper)
 int
 SedCurve::setYErrorLower(const std::string& yErrorLower)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(yErrorLower)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -498,6 +508,8 @@ SedCurve::unsetLogY()
 int
 SedCurve::unsetYDataReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mYDataReference.erase();
 
   if (mYDataReference.empty() == true)
@@ -528,6 +540,8 @@ SedCurve::unsetType()
 int
 SedCurve::unsetXErrorUpper()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mXErrorUpper.erase();
 
   if (mXErrorUpper.empty() == true)
@@ -547,6 +561,8 @@ SedCurve::unsetXErrorUpper()
 int
 SedCurve::unsetXErrorLower()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mXErrorLower.erase();
 
   if (mXErrorLower.empty() == true)
@@ -566,6 +582,8 @@ SedCurve::unsetXErrorLower()
 int
 SedCurve::unsetYErrorUpper()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mYErrorUpper.erase();
 
   if (mYErrorUpper.empty() == true)
@@ -585,6 +603,8 @@ SedCurve::unsetYErrorUpper()
 int
 SedCurve::unsetYErrorLower()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mYErrorLower.erase();
 
   if (mYErrorLower.empty() == true)
@@ -700,7 +720,11 @@ SedCurve::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedCurve::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -129,7 +129,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedCurve(SedNamespaces *sedmlns);
+  SedCurve(const SedNamespaces *sedmlns);
 
 
   /**
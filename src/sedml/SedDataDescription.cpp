@@ -71,7 +71,7 @@ SedDataDescription::SedDataDescription(unsigned int level,
  * Creates a new SedDataDescription using the given SedNamespaces object @p
  * sedmlns.
  */
-SedDataDescription::SedDataDescription(SedNamespaces *sedmlns)
+SedDataDescription::SedDataDescription(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mFormat ("")
   , mSource ("")
@@ -607,7 +607,46 @@ SedDataDescription::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedDataDescription::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedDataDescription
+ */
+unsigned int
+SedDataDescription::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mDataSources
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedDataDescription
+ */
+const SedBase*
+SedDataDescription::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mDataSources
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
@@ -99,7 +99,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedDataDescription(SedNamespaces *sedmlns);
+  SedDataDescription(const SedNamespaces *sedmlns);
 
 
   /**
@@ -600,6 +600,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedDataDescription
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedDataDescription
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
@@ -71,7 +71,7 @@ SedDataGenerator::SedDataGenerator(unsigned int level, unsigned int version)
  * Creates a new SedDataGenerator using the given SedNamespaces object @p
  * sedmlns.
  */
-SedDataGenerator::SedDataGenerator(SedNamespaces *sedmlns)
+SedDataGenerator::SedDataGenerator(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mVariables (sedmlns)
   , mParameters (sedmlns)
@@ -187,6 +187,8 @@ SedDataGenerator::isSetMath() const
 int
 SedDataGenerator::setMath(const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* math)
 {
+  markChanged(CHANGE_CHILDREN);
+
   if (mMath == math)
   {
     return LIBSEDML_OPERATION_SUCCESS;
@@ -216,6 +218,8 @@ SedDataGenerator::setMath(const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* math)
 int
 SedDataGenerator::unsetMath()
 {
+  markChanged(CHANGE_CHILDREN);
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -672,7 +676,48 @@ SedDataGenerator::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedDataGenerator::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedDataGenerator
+ */
+unsigned int
+SedDataGenerator::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mVariables,
+    &mParameters
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 2);
+}
+
+
+/*
+ * Returns the nth child object of this SedDataGenerator
+ */
+const SedBase*
+SedDataGenerator::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mVariables,
+    &mParameters
+  };
+
+  return selectChildElement(children, 2, n - inherited);
 }
 
 /** @endcond */
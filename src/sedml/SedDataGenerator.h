@@ -98,7 +98,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedDataGenerator(SedNamespaces *sedmlns);
+  SedDataGenerator(const SedNamespaces *sedmlns);
 
 
   /**
@@ -758,6 +758,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedDataGenerator
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedDataGenerator
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
@@ -0,0 +1,452 @@
+/**
+ * @file SedDataLoader.cpp
+ * @brief Implementation of the SedDataLoader class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedDataLoader.h>
+#include <sedml/SedDataDescription.h>
+#include <sedml/SedDataRange.h>
+#include <sedml/SedDocument.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <numl/CompositeDescription.h>
+
+#include <cmath>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+LIBNUML_CPP_NAMESPACE_USE
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/*
+ * Creates a new SedDataLoader.
+ */
+SedDataLoader::SedDataLoader ()
+  : SedValueProvider()
+  , mBaseDirectory()
+  , mSuppliedSources()
+  , mTables()
+  , mMutex()
+{
+}
+
+
+/*
+ * Destroys this SedDataLoader.
+ */
+SedDataLoader::~SedDataLoader ()
+{
+  clearCache();
+}
+
+
+void
+SedDataLoader::setBaseDirectory (const std::string& directory)
+{
+  lock_guard<mutex> lock(mMutex);
+  mBaseDirectory = directory;
+}
+
+
+const std::string&
+SedDataLoader::getBaseDirectory () const
+{
+  return mBaseDirectory;
+}
+
+
+int
+SedDataLoader::setSourceContents (const std::string& source,
+                                  const std::string& contents)
+{
+  if (source.empty()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  lock_guard<mutex> lock(mMutex);
+  mSuppliedSources[source] = contents;
+
+  // tables are keyed by source and format
+  const string prefix = source + '\n';
+  for (TableMap::iterator it = mTables.begin(); it != mTables.end(); )
+  {
+    if (it->first.compare(0, prefix.size(), prefix) == 0)
+    {
+      delete it->second;
+      it = mTables.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+std::string
+SedDataLoader::getFormat (const SedDataDescription* description)
+{
+  if (description == NULL) return string();
+  if (description->isSetFormat()) return description->getFormat();
+
+  const string& source = description->getSource();
+  size_t dot = source.find_last_of('.');
+  string extension = (dot == string::npos) ? string() : source.substr(dot + 1);
+  for (size_t i = 0; i < extension.size(); ++i)
+  {
+    extension[i] = (char)tolower((unsigned char)extension[i]);
+  }
+
+  if (extension == "csv") return "urn:sedml:format:csv";
+  if (extension == "tsv") return "urn:sedml:format:tsv";
+  return "urn:sedml:format:numl";
+}
+
+
+const SedDataTable*
+SedDataLoader::getTable (const SedDataDescription* description)
+{
+  if (description == NULL || !description->isSetSource()) return NULL;
+  return getTable(description->getSource(), getFormat(description));
+}
+
+
+const SedDataTable*
+SedDataLoader::getTable (const std::string& source, const std::string& format)
+{
+  if (source.empty()) return NULL;
+
+  lock_guard<mutex> lock(mMutex);
+
+  const string key = source + '\n' + format;
+  TableMap::const_iterator it = mTables.find(key);
+  if (it != mTables.end()) return it->second;
+
+  SedDataTable* table = new SedDataTable();
+  int result = LIBSEDML_OPERATION_FAILED;
+
+  ContentsMap::const_iterator supplied = mSuppliedSources.find(source);
+  if (supplied != mSuppliedSources.end())
+  {
+    result = table->readFromString(supplied->second, format);
+  }
+  else
+  {
+    string path = source;
+    if (path.compare(0, 7, "file://") == 0) path = path.substr(7);
+
+    bool isAbsolute = !path.empty() && (path[0] == '/' || path[0] == '\\'
+      || (path.size() > 1 && path[1] == ':'));
+    if (!isAbsolute && !mBaseDirectory.empty())
+    {
+      path = mBaseDirectory + "/" + path;
+    }
+
+    result = table->readFile(path, format);
+  }
+
+  if (result != LIBSEDML_OPERATION_SUCCESS)
+  {
+    delete table;
+    return NULL;
+  }
+
+  mTables[key] = table;
+  return table;
+}
+
+
+int
+SedDataLoader::getValues (const SedDataSource* source, SedDataView& values,
+                          const IndexValues* indexValues)
+{
+  values = SedDataView();
+
+  const SedDataDescription* description = getDescription(source);
+  if (description == NULL || source->isSetIndexSet())
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  const SedDataTable* table = getTable(description);
+  if (table == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  vector<string> dimensions;
+  getDimensionIds(description, dimensions);
+
+  const unsigned int extent[2] = { table->getNumRows(), table->getNumColumns() };
+  int fixed[2] = { -1, -1 };
+  int first[2] = { 0, 0 };
+  int last[2] = { (int)extent[0] - 1, (int)extent[1] - 1 };
+
+  for (unsigned int i = 0; i < source->getNumSlices(); ++i)
+  {
+    const SedSlice* slice = source->getSlice(i);
+
+    int dimension = -1;
+    for (size_t d = 0; d < dimensions.size() && d < 2; ++d)
+    {
+      if (dimensions[d] == slice->getReference()) dimension = (int)d;
+    }
+    if (dimension < 0 && slice->isSetValue()
+      && table->getColumnIndex(slice->getValue()) >= 0)
+    {
+      dimension = 1;
+    }
+    if (dimension < 0) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+    int position = -1;
+    if (slice->isSetValue())
+    {
+      position = (dimension == 0)
+        ? table->getRowIndex(slice->getValue())
+        : table->getColumnIndex(slice->getValue());
+      if (position < 0) return LIBSEDML_OPERATION_FAILED;
+    }
+    else if (slice->isSetIndex())
+    {
+      if (indexValues == NULL) return LIBSEDML_INVALID_OBJECT;
+
+      IndexValues::const_iterator it = indexValues->find(slice->getIndex());
+      if (it == indexValues->end()) return LIBSEDML_INVALID_OBJECT;
+
+      double index = it->second;
+      if (!(index >= 0) || index >= extent[dimension] || floor(index) != index)
+      {
+        return LIBSEDML_OPERATION_FAILED;
+      }
+      position = (int)index;
+    }
+
+    if (position >= 0)
+    {
+      if (fixed[dimension] >= 0 && fixed[dimension] != position)
+      {
+        return LIBSEDML_OPERATION_FAILED;
+      }
+      fixed[dimension] = position;
+      continue;
+    }
+
+    // several ranges on one dimension select their intersection
+    if (slice->isSetStartIndex() && slice->getStartIndex() > first[dimension])
+    {
+      first[dimension] = slice->getStartIndex();
+    }
+    if (slice->isSetEndIndex() && slice->getEndIndex() < last[dimension])
+    {
+      last[dimension] = slice->getEndIndex();
+    }
+  }
+
+  for (int d = 0; d < 2; ++d)
+  {
+    if (fixed[d] >= 0)
+    {
+      if (fixed[d] < first[d] || fixed[d] > last[d]) return LIBSEDML_OPERATION_FAILED;
+      first[d] = last[d] = fixed[d];
+    }
+    if (first[d] > last[d]) return LIBSEDML_OPERATION_FAILED;
+  }
+
+  // a single column, or part of one, unless a row is chosen explicitly
+  if (first[1] == last[1] && (fixed[0] < 0 || fixed[1] >= 0))
+  {
+    values = table->getColumn((unsigned int)first[1]).getSubView(
+      (unsigned int)first[0], (unsigned int)(last[0] - first[0] + 1));
+  }
+  else if (first[0] == last[0])
+  {
+    values = table->getRow((unsigned int)first[0]).getSubView(
+      (unsigned int)first[1], (unsigned int)(last[1] - first[1] + 1));
+  }
+  else
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedDataLoader::getIndexSet (const SedDataSource* source,
+                            std::vector<std::string>& values)
+{
+  values.clear();
+
+  const SedDataDescription* description = getDescription(source);
+  if (description == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (!source->isSetIndexSet()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  vector<string> dimensions;
+  getDimensionIds(description, dimensions);
+
+  int dimension = -1;
+  for (size_t d = 0; d < dimensions.size() && d < 2; ++d)
+  {
+    if (dimensions[d] == source->getIndexSet()) dimension = (int)d;
+  }
+  if (dimension < 0) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  const SedDataTable* table = getTable(description);
+  if (table == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  if (dimension == 0)
+  {
+    values.reserve(table->getNumRows());
+    for (unsigned int i = 0; i < table->getNumRows(); ++i)
+    {
+      values.push_back(table->getRowName(i));
+    }
+  }
+  else
+  {
+    values.reserve(table->getNumColumns());
+    for (unsigned int i = 0; i < table->getNumColumns(); ++i)
+    {
+      values.push_back(table->getColumnName(i));
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+bool
+SedDataLoader::getDataRangeValues (const SedDataRange* range,
+                                   std::vector<double>& values)
+{
+  if (range == NULL || !range->isSetSourceReference()) return false;
+
+  const SedDocument* document = range->getSedDocument();
+  if (document == NULL) return false;
+
+  const SedDataSource* source = NULL;
+  {
+    // the id indexes of the document are built on first use
+    lock_guard<mutex> lock(mMutex);
+    for (unsigned int i = 0;
+         i < document->getNumDataDescriptions() && source == NULL; ++i)
+    {
+      source = document->getDataDescription(i)->getDataSource(
+        range->getSourceReference());
+    }
+  }
+
+  SedDataView view;
+  if (getValues(source, view) != LIBSEDML_OPERATION_SUCCESS) return false;
+
+  view.copyTo(values);
+  return true;
+}
+
+
+unsigned int
+SedDataLoader::getNumTables () const
+{
+  lock_guard<mutex> lock(mMutex);
+  return (unsigned int)mTables.size();
+}
+
+
+void
+SedDataLoader::clearCache ()
+{
+  lock_guard<mutex> lock(mMutex);
+
+  for (TableMap::iterator it = mTables.begin(); it != mTables.end(); ++it)
+  {
+    delete it->second;
+  }
+  mTables.clear();
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Returns the data description the given data source belongs to.
+ */
+const SedDataDescription*
+SedDataLoader::getDescription (const SedDataSource* source)
+{
+  if (source == NULL) return NULL;
+
+  const SedBase* list = source->getParentSedObject();
+  const SedBase* parent = (list != NULL) ? list->getParentSedObject() : NULL;
+  if (parent == NULL || parent->getTypeCode() != SEDML_DATA_DESCRIPTION)
+  {
+    return NULL;
+  }
+
+  return static_cast<const SedDataDescription*>(parent);
+}
+
+
+/*
+ * Collects the ids of the nested composite descriptions of the given data
+ * description, outermost first.
+ */
+void
+SedDataLoader::getDimensionIds (const SedDataDescription* description,
+                                 std::vector<std::string>& ids)
+{
+  ids.clear();
+
+  const DimensionDescription* dimensions =
+    description->getDimensionDescription();
+  if (dimensions == NULL || dimensions->size() == 0) return;
+
+  const CompositeDescription* composite =
+    dynamic_cast<const CompositeDescription*>(dimensions->get(0));
+  while (composite != NULL)
+  {
+    ids.push_back(composite->getId());
+    composite = (composite->size() > 0)
+      ? dynamic_cast<const CompositeDescription*>(composite->get(0)) : NULL;
+  }
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
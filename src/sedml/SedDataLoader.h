@@ -0,0 +1,296 @@
+/**
+ * @file SedDataLoader.h
+ * @brief Definition of the SedDataLoader class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedDataLoader
+ * @sbmlbrief{} Loads the data that SedDataDescription objects refer to,
+ * and selects the values of their data sources.
+ *
+ * A SedDataLoader reads the source of a SedDataDescription into a
+ * SedDataTable, which is cached by source and format, so that data
+ * descriptions sharing a file read it only once.  Files are mapped into
+ * memory, and the values of a column are only parsed once they are
+ * selected.
+ *
+ * The slices of a SedDataSource are applied when its values are
+ * requested, and the result is a SedDataView into the cached table rather
+ * than a copy.  The first dimension of the data are the rows, the second
+ * the columns; a slice refers to a dimension by the id of the matching
+ * CompositeDescription of the NuML dimension description.  A slice whose
+ * reference is not such an id but whose value is the name of a column
+ * selects that column.  A slice selects a single row or column by its
+ * "value", by the current value of the range named by its "index", or a
+ * range of them from its "startIndex" to its "endIndex", inclusive.
+ *
+ * The format of a data description is taken from its "format" attribute,
+ * or from the extension of its source if that is not set (files ending in
+ * <code>.csv</code> or <code>.tsv</code>); NuML is assumed otherwise.
+ *
+ * As a SedValueProvider, a SedDataLoader supplies the values of
+ * SedDataRange objects, for example to a SedTaskExecutor.  Its methods may
+ * be called from several threads.
+ *
+ * @code{.cpp}
+SedDataLoader loader;
+loader.setBaseDirectory("/path/to/archive");
+
+SedDataView values;
+if (loader.getValues(doc->getDataDescription(0)->getDataSource(0), values)
+    == LIBSEDML_OPERATION_SUCCESS)
+{
+  for (unsigned int i = 0; i < values.size(); ++i)
+  {
+    // ... use values[i]
+  }
+}
+ * @endcode
+ */
+
+
+#ifndef SedDataLoader_h
+#define SedDataLoader_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sedml/SedValueProvider.h>
+#include <sedml/SedDataTable.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDataDescription;
+class SedDataSource;
+
+
+class LIBSEDML_EXTERN SedDataLoader : public SedValueProvider
+{
+public:
+
+  /**
+   * The current values of the ranges that slices refer to by their
+   * "index" attribute, by range id.
+   */
+  typedef std::unordered_map<std::string, double> IndexValues;
+
+
+  /**
+   * Creates a new SedDataLoader.
+   */
+  SedDataLoader ();
+
+
+  /**
+   * Destroys this SedDataLoader, along with all cached tables.
+   */
+  virtual ~SedDataLoader ();
+
+
+  /**
+   * Sets the directory that relative data sources are resolved against.
+   *
+   * @param directory the base directory.
+   */
+  void setBaseDirectory (const std::string& directory);
+
+
+  /**
+   * @return the directory that relative data sources are resolved against.
+   */
+  const std::string& getBaseDirectory () const;
+
+
+  /**
+   * Supplies the contents of the given data source, so that it is not
+   * read from disk.  Tables loaded from the source before are discarded.
+   *
+   * @param source the value of the "source" attribute of a data
+   * description.
+   * @param contents the data.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if @p source is empty.
+   */
+  int setSourceContents (const std::string& source,
+                         const std::string& contents);
+
+
+  /**
+   * Returns the format of the given data description: its "format"
+   * attribute if set, and otherwise the format implied by the extension of
+   * its source.
+   *
+   * @param description the data description.
+   *
+   * @return the format, such as <code>urn:sedml:format:csv</code>.
+   */
+  static std::string getFormat (const SedDataDescription* description);
+
+
+  /**
+   * Returns the table holding the data of the given data description,
+   * reading it on first use.
+   *
+   * @param description the data description.
+   *
+   * @return the table, owned by this loader, or @c NULL if the source
+   * cannot be read.
+   */
+  const SedDataTable* getTable (const SedDataDescription* description);
+
+
+  /**
+   * Returns the table holding the data of the given source, reading it on
+   * first use.
+   *
+   * @param source the source, a file name or a source supplied with
+   * setSourceContents().
+   * @param format the format of the source.
+   *
+   * @return the table, owned by this loader, or @c NULL if the source
+   * cannot be read.
+   */
+  const SedDataTable* getTable (const std::string& source,
+                                const std::string& format);
+
+
+  /**
+   * Selects the values of the given data source by applying its slices.
+   *
+   * @param source the data source, which must be part of a data
+   * description.
+   * @param values view that receives the values; it remains valid as long
+   * as this loader, and its cache, exist.
+   * @param indexValues the current values of ranges that slices refer to,
+   * or @c NULL.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if @p source is not part of a data description, names an index set,
+   * refers to a range that has no value, or does not select a
+   * one-dimensional set of values.
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if a slice refers to an unknown dimension.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if the data cannot be read or a slice selects nothing.
+   */
+  int getValues (const SedDataSource* source, SedDataView& values,
+                 const IndexValues* indexValues = NULL);
+
+
+  /**
+   * Retrieves the index values of the dimension named by the "indexSet" of
+   * the given data source: the row names or the column names.
+   *
+   * @param source the data source.
+   * @param values vector that receives the index values.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if @p source is not part of a data description.
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if the index set of @p source is not set or names no dimension.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if the data cannot be read.
+   */
+  int getIndexSet (const SedDataSource* source,
+                   std::vector<std::string>& values);
+
+
+  /**
+   * Retrieves the values of the data source the given data range refers
+   * to.
+   *
+   * @param range the data range.
+   * @param values vector that receives the values.
+   *
+   * @return @c true if the values could be retrieved, @c false otherwise.
+   */
+  virtual bool getDataRangeValues (const SedDataRange* range,
+                                   std::vector<double>& values);
+
+
+  /**
+   * @return the number of tables in the cache.
+   */
+  unsigned int getNumTables () const;
+
+
+  /**
+   * Discards all cached tables.  Sources supplied with setSourceContents()
+   * are kept.
+   */
+  void clearCache ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  SedDataLoader (const SedDataLoader& orig);
+  SedDataLoader& operator= (const SedDataLoader& rhs);
+
+  typedef std::unordered_map<std::string, SedDataTable*> TableMap;
+  typedef std::unordered_map<std::string, std::string> ContentsMap;
+
+  static const SedDataDescription* getDescription (const SedDataSource* source);
+  static void getDimensionIds (const SedDataDescription* description,
+                               std::vector<std::string>& ids);
+
+  std::string mBaseDirectory;
+  ContentsMap mSuppliedSources;
+  TableMap mTables;
+  mutable std::mutex mMutex;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedDataLoader_h */
@@ -62,7 +62,7 @@ SedDataRange::SedDataRange(unsigned int level, unsigned int version)
 /*
  * Creates a new SedDataRange using the given SedNamespaces object @p sedmlns.
  */
-SedDataRange::SedDataRange(SedNamespaces *sedmlns)
+SedDataRange::SedDataRange(const SedNamespaces *sedmlns)
   : SedRange(sedmlns)
   , mSourceReference ("")
 {
@@ -141,6 +141,8 @@ SedDataRange::isSetSourceReference() const
 int
 SedDataRange::setSourceReference(const std::string& sourceReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(sourceReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -159,6 +161,8 @@ SedDataRange::setSourceReference(const std::string& sourceReference)
 int
 SedDataRange::unsetSourceReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mSourceReference.erase();
 
   if (mSourceReference.empty() == true)
@@ -250,7 +254,11 @@ SedDataRange::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedDataRange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -65,7 +65,7 @@ SedDataSet::SedDataSet(unsigned int level, unsigned int version)
 /*
  * Creates a new SedDataSet using the given SedNamespaces object @p sedmlns.
  */
-SedDataSet::SedDataSet(SedNamespaces *sedmlns)
+SedDataSet::SedDataSet(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mLabel ("")
   , mDataReference ("")
@@ -180,6 +180,8 @@ SedDataSet::setLabel(const std::string& label)
 int
 SedDataSet::setDataReference(const std::string& dataReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(dataReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -217,6 +219,8 @@ SedDataSet::unsetLabel()
 int
 SedDataSet::unsetDataReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mDataReference.erase();
 
   if (mDataReference.empty() == true)
@@ -317,7 +321,11 @@ SedDataSet::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedDataSet::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
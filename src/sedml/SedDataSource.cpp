@@ -67,7 +67,7 @@ SedDataSource::SedDataSource(unsigned int level, unsigned int version)
 /*
  * Creates a new SedDataSource using the given SedNamespaces object @p sedmlns.
  */
-SedDataSource::SedDataSource(SedNamespaces *sedmlns)
+SedDataSource::SedDataSource(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mIndexSet ("")
   , mSlices (sedmlns)
@@ -431,7 +431,46 @@ SedDataSource::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedDataSource::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedDataSource
+ */
+unsigned int
+SedDataSource::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mSlices
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedDataSource
+ */
+const SedBase*
+SedDataSource::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mSlices
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
@@ -0,0 +1,791 @@
+/**
+ * @file SedDataTable.cpp
+ * @brief Implementation of the SedDataTable class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedDataTable.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+namespace
+{
+
+const double NOT_A_NUMBER = numeric_limits<double>::quiet_NaN();
+
+
+/*
+ * Removes surrounding white space and one pair of double quotes.
+ */
+void
+trimField (const char*& begin, const char*& end)
+{
+  while (begin < end && (*begin == ' ' || *begin == '\t')) ++begin;
+  while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) --end;
+
+  if (end - begin >= 2 && *begin == '"' && end[-1] == '"')
+  {
+    ++begin;
+    --end;
+  }
+}
+
+
+/*
+ * Parses the number between begin and end; returns NaN if the text is
+ * empty or no number.
+ */
+double
+parseNumber (const char* begin, const char* end)
+{
+  trimField(begin, end);
+  if (begin == end) return NOT_A_NUMBER;
+
+  // the mapped data is not null terminated
+  char buffer[64];
+  string copy;
+  const char* text = buffer;
+  size_t length = (size_t)(end - begin);
+  if (length < sizeof(buffer))
+  {
+    memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+  }
+  else
+  {
+    copy.assign(begin, end);
+    text = copy.c_str();
+  }
+
+  char* stop = NULL;
+  double value = strtod(text, &stop);
+  return (stop == text + length) ? value : NOT_A_NUMBER;
+}
+
+
+/*
+ * Returns the end of the line starting at begin, excluding a carriage
+ * return.
+ */
+const char*
+findLineEnd (const char* begin, const char* end)
+{
+  const char* newline = static_cast<const char*>(
+    memchr(begin, '\n', (size_t)(end - begin)));
+  const char* lineEnd = (newline != NULL) ? newline : end;
+  if (lineEnd > begin && lineEnd[-1] == '\r') --lineEnd;
+  return lineEnd;
+}
+
+
+/*
+ * Replaces the predefined XML entities in the given text.
+ */
+string
+decodeEntities (const char* begin, const char* end)
+{
+  string result;
+  result.reserve((size_t)(end - begin));
+
+  while (begin < end)
+  {
+    if (*begin != '&')
+    {
+      result += *begin++;
+      continue;
+    }
+
+    static const char* const entities[][2] = {
+      { "&amp;", "&" }, { "&lt;", "<" }, { "&gt;", ">" },
+      { "&quot;", "\"" }, { "&apos;", "'" }
+    };
+
+    bool replaced = false;
+    for (size_t i = 0; i < sizeof(entities) / sizeof(entities[0]); ++i)
+    {
+      size_t length = strlen(entities[i][0]);
+      if ((size_t)(end - begin) >= length
+        && strncmp(begin, entities[i][0], length) == 0)
+      {
+        result += entities[i][1];
+        begin += length;
+        replaced = true;
+        break;
+      }
+    }
+
+    if (!replaced) result += *begin++;
+  }
+
+  return result;
+}
+
+
+/*
+ * Finds the value of the attribute with the given name in the start tag
+ * between begin and end.
+ */
+bool
+findAttribute (const char* begin, const char* end, const char* name,
+               string& value)
+{
+  size_t length = strlen(name);
+  const char* p = begin;
+
+  while (p < end)
+  {
+    const char* match = static_cast<const char*>(
+      memchr(p, name[0], (size_t)(end - p)));
+    if (match == NULL || (size_t)(end - match) < length) return false;
+
+    p = match + 1;
+    if (strncmp(match, name, length) != 0) continue;
+    if (match == begin || (match[-1] != ' ' && match[-1] != '\t'
+      && match[-1] != '\n' && match[-1] != '\r')) continue;
+
+    const char* q = match + length;
+    while (q < end && isspace((unsigned char)*q)) ++q;
+    if (q == end || *q != '=') continue;
+    ++q;
+    while (q < end && isspace((unsigned char)*q)) ++q;
+    if (q == end || (*q != '"' && *q != '\'')) continue;
+
+    const char* close = static_cast<const char*>(
+      memchr(q + 1, *q, (size_t)(end - q - 1)));
+    if (close == NULL) return false;
+
+    value = decodeEntities(q + 1, close);
+    return true;
+  }
+
+  return false;
+}
+
+
+/*
+ * Returns the index of the given name, adding it if it is new.
+ */
+unsigned int
+addName (const string& name, vector<string>& names,
+         unordered_map<string, unsigned int>& index)
+{
+  pair<unordered_map<string, unsigned int>::iterator, bool> result =
+    index.insert(make_pair(name, (unsigned int)names.size()));
+  if (result.second) names.push_back(name);
+  return result.first->second;
+}
+
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedDataView.
+ */
+SedDataView::SedDataView ()
+  : mData(NULL)
+  , mSize(0)
+  , mStride(1)
+{
+}
+
+
+/*
+ * Creates a new SedDataView of the given values.
+ */
+SedDataView::SedDataView (const double* data, unsigned int size,
+                          unsigned int stride)
+  : mData(size > 0 ? data : NULL)
+  , mSize(data != NULL ? size : 0)
+  , mStride(stride > 0 ? stride : 1)
+{
+}
+
+
+unsigned int
+SedDataView::size () const
+{
+  return mSize;
+}
+
+
+bool
+SedDataView::empty () const
+{
+  return mSize == 0;
+}
+
+
+unsigned int
+SedDataView::getStride () const
+{
+  return mStride;
+}
+
+
+const double*
+SedDataView::getData () const
+{
+  return mData;
+}
+
+
+SedDataView
+SedDataView::getSubView (unsigned int first, unsigned int count) const
+{
+  if (first >= mSize) return SedDataView();
+  if (count > mSize - first) count = mSize - first;
+  return SedDataView(mData + (size_t)first * mStride, count, mStride);
+}
+
+
+void
+SedDataView::copyTo (std::vector<double>& values) const
+{
+  values.resize(mSize);
+  if (mStride == 1)
+  {
+    if (mSize > 0) memcpy(&values[0], mData, mSize * sizeof(double));
+    return;
+  }
+
+  for (unsigned int i = 0; i < mSize; ++i)
+  {
+    values[i] = mData[(size_t)i * mStride];
+  }
+}
+
+
+/*
+ * Creates a new, empty SedDataTable.
+ */
+SedDataTable::SedDataTable ()
+  : mFile()
+  , mFormat()
+  , mDelimiter(',')
+  , mColumnNames()
+  , mColumnIndex()
+  , mRowNames()
+  , mRowIndex()
+  , mRowOffsets()
+  , mNumRows(0)
+  , mValues()
+  , mIsParsed()
+  , mMutex()
+{
+}
+
+
+/*
+ * Destroys this SedDataTable.
+ */
+SedDataTable::~SedDataTable ()
+{
+}
+
+
+int
+SedDataTable::readFile (const std::string& fileName,
+                        const std::string& format)
+{
+  clear();
+
+  if (format != "urn:sedml:format:csv" && format != "urn:sedml:format:tsv"
+    && format != "urn:sedml:format:numl")
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  if (!mFile.open(fileName)) return LIBSEDML_OPERATION_FAILED;
+  return read(format);
+}
+
+
+int
+SedDataTable::readFromString (const std::string& contents,
+                              const std::string& format)
+{
+  clear();
+
+  if (format != "urn:sedml:format:csv" && format != "urn:sedml:format:tsv"
+    && format != "urn:sedml:format:numl")
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  mFile.assign(contents);
+  return read(format);
+}
+
+
+const std::string&
+SedDataTable::getFormat () const
+{
+  return mFormat;
+}
+
+
+bool
+SedDataTable::isMapped () const
+{
+  return mFile.isMapped();
+}
+
+
+unsigned int
+SedDataTable::getNumRows () const
+{
+  return mNumRows;
+}
+
+
+unsigned int
+SedDataTable::getNumColumns () const
+{
+  return (unsigned int)mColumnNames.size();
+}
+
+
+const std::string&
+SedDataTable::getColumnName (unsigned int n) const
+{
+  static const string empty;
+  return (n < mColumnNames.size()) ? mColumnNames[n] : empty;
+}
+
+
+int
+SedDataTable::getColumnIndex (const std::string& name) const
+{
+  NameMap::const_iterator it = mColumnIndex.find(name);
+  return (it == mColumnIndex.end()) ? -1 : (int)it->second;
+}
+
+
+std::string
+SedDataTable::getRowName (unsigned int n) const
+{
+  if (n >= mNumRows) return string();
+  if (!mRowNames.empty()) return mRowNames[n];
+
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%u", n);
+  return buffer;
+}
+
+
+int
+SedDataTable::getRowIndex (const std::string& name) const
+{
+  if (!mRowNames.empty())
+  {
+    NameMap::const_iterator it = mRowIndex.find(name);
+    return (it == mRowIndex.end()) ? -1 : (int)it->second;
+  }
+
+  if (name.empty() || name[0] < '0' || name[0] > '9') return -1;
+
+  char* stop = NULL;
+  unsigned long row = strtoul(name.c_str(), &stop, 10);
+  if (*stop != '\0' || row >= mNumRows) return -1;
+  return (int)row;
+}
+
+
+SedDataView
+SedDataTable::getColumn (unsigned int n) const
+{
+  if (n >= mColumnNames.size() || mNumRows == 0) return SedDataView();
+
+  lock_guard<mutex> lock(mMutex);
+  if (!mIsParsed[n]) parseColumn(n);
+  return SedDataView(&mValues[(size_t)n * mNumRows], mNumRows);
+}
+
+
+SedDataView
+SedDataTable::getRow (unsigned int n) const
+{
+  if (n >= mNumRows || mColumnNames.empty()) return SedDataView();
+
+  lock_guard<mutex> lock(mMutex);
+  parseColumn((unsigned int)mColumnNames.size());
+  return SedDataView(&mValues[n], (unsigned int)mColumnNames.size(), mNumRows);
+}
+
+
+double
+SedDataTable::getValue (unsigned int row, unsigned int column) const
+{
+  if (row >= mNumRows) return NOT_A_NUMBER;
+
+  SedDataView values = getColumn(column);
+  return values.empty() ? NOT_A_NUMBER : values[row];
+}
+
+
+void
+SedDataTable::clear ()
+{
+  lock_guard<mutex> lock(mMutex);
+
+  mFile.close();
+  mFormat.clear();
+  mColumnNames.clear();
+  mColumnIndex.clear();
+  mRowNames.clear();
+  mRowIndex.clear();
+  mRowOffsets.clear();
+  mNumRows = 0;
+  mValues.clear();
+  mIsParsed.clear();
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Indexes the data that has been mapped, in the given format.
+ */
+int
+SedDataTable::read (const std::string& format)
+{
+  bool success = (format == "urn:sedml:format:numl")
+    ? readNuML()
+    : indexDelimited(format == "urn:sedml:format:tsv" ? '\t' : ',');
+
+  if (!success)
+  {
+    clear();
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  mFormat = format;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Reads the column names of CSV or TSV data, and records where each row
+ * starts; the values are parsed later.
+ */
+bool
+SedDataTable::indexDelimited (char delimiter)
+{
+  mDelimiter = delimiter;
+
+  const char* begin = mFile.getData();
+  const char* end = begin + mFile.getSize();
+  if (end - begin >= 3 && memcmp(begin, "\xEF\xBB\xBF", 3) == 0) begin += 3;
+
+  bool hasHeader = false;
+  for (const char* line = begin; line < end; )
+  {
+    const char* lineEnd = findLineEnd(line, end);
+
+    const char* first = line;
+    while (first < lineEnd && *first == ' ') ++first;
+
+    if (first == lineEnd || *first == '#')
+    {
+      // skip empty lines and comments
+    }
+    else if (!hasHeader)
+    {
+      for (const char* field = line; ; )
+      {
+        const char* fieldEnd = static_cast<const char*>(
+          memchr(field, delimiter, (size_t)(lineEnd - field)));
+        if (fieldEnd == NULL) fieldEnd = lineEnd;
+
+        const char* nameBegin = field;
+        const char* nameEnd = fieldEnd;
+        trimField(nameBegin, nameEnd);
+        string name(nameBegin, nameEnd);
+        mColumnIndex.insert(make_pair(name, (unsigned int)mColumnNames.size()));
+        mColumnNames.push_back(name);
+
+        if (fieldEnd == lineEnd) break;
+        field = fieldEnd + 1;
+      }
+
+      hasHeader = true;
+    }
+    else
+    {
+      mRowOffsets.push_back((size_t)(line - mFile.getData()));
+    }
+
+    const char* newline = static_cast<const char*>(
+      memchr(lineEnd, '\n', (size_t)(end - lineEnd)));
+    line = (newline != NULL) ? newline + 1 : end;
+  }
+
+  mNumRows = (unsigned int)mRowOffsets.size();
+  mIsParsed.assign(mColumnNames.size(), 0);
+  return hasHeader;
+}
+
+
+/*
+ * Reads the first result component of NuML data.
+ */
+bool
+SedDataTable::readNuML ()
+{
+  struct Entry
+  {
+    unsigned int row;
+    unsigned int column;
+    double value;
+  };
+
+  vector<Entry> entries;
+  unsigned int depth = 0;
+  unsigned int row = 0;
+  unsigned int column = 0;
+  bool inComponent = false;
+
+  const char* p = mFile.getData();
+  const char* end = p + mFile.getSize();
+
+  while (p < end)
+  {
+    p = static_cast<const char*>(memchr(p, '<', (size_t)(end - p)));
+    if (p == NULL) break;
+
+    if (end - p >= 4 && strncmp(p, "<!--", 4) == 0)
+    {
+      const char* close = p + 4;
+      while (close + 3 <= end && strncmp(close, "-->", 3) != 0) ++close;
+      p = close + 3;
+      continue;
+    }
+
+    // find the end of the tag, skipping quoted attribute values
+    const char* tagEnd = p + 1;
+    char quote = 0;
+    for (; tagEnd < end; ++tagEnd)
+    {
+      if (quote != 0)
+      {
+        if (*tagEnd == quote) quote = 0;
+      }
+      else if (*tagEnd == '"' || *tagEnd == '\'')
+      {
+        quote = *tagEnd;
+      }
+      else if (*tagEnd == '>')
+      {
+        break;
+      }
+    }
+    if (tagEnd == end) return false;
+
+    const char* name = p + 1;
+    bool isEndTag = (*name == '/');
+    if (isEndTag) ++name;
+    bool isEmpty = (tagEnd[-1] == '/');
+
+    const char* nameEnd = name;
+    while (nameEnd < tagEnd && !isspace((unsigned char)*nameEnd)
+      && *nameEnd != '/')
+    {
+      if (*nameEnd == ':') name = nameEnd + 1;
+      ++nameEnd;
+    }
+    string localName(name, nameEnd);
+    p = tagEnd + 1;
+
+    if (*name == '?' || *name == '!')
+    {
+      continue;
+    }
+    else if (localName == "resultComponent")
+    {
+      if (isEndTag || inComponent) break;
+      inComponent = true;
+    }
+    else if (!inComponent)
+    {
+      continue;
+    }
+    else if (localName == "compositeValue")
+    {
+      if (isEndTag)
+      {
+        if (depth > 0) --depth;
+        continue;
+      }
+
+      string indexValue;
+      findAttribute(nameEnd, tagEnd, "indexValue", indexValue);
+      if (depth == 0)
+      {
+        row = addName(indexValue, mRowNames, mRowIndex);
+      }
+      else if (depth == 1)
+      {
+        column = addName(indexValue, mColumnNames, mColumnIndex);
+      }
+      else
+      {
+        // more than two dimensions
+        return false;
+      }
+
+      if (!isEmpty) ++depth;
+    }
+    else if (localName == "atomicValue")
+    {
+      if (isEndTag || isEmpty) continue;
+      if (depth == 0) return false;
+
+      // a single composite level holds one unnamed column
+      if (depth == 1) column = addName("", mColumnNames, mColumnIndex);
+
+      const char* textEnd = static_cast<const char*>(
+        memchr(p, '<', (size_t)(end - p)));
+      if (textEnd == NULL) return false;
+
+      Entry entry = { row, column, parseNumber(p, textEnd) };
+      entries.push_back(entry);
+      p = textEnd;
+    }
+    else if (localName == "tupleValue")
+    {
+      return false;
+    }
+  }
+
+  if (!inComponent) return false;
+
+  mNumRows = (unsigned int)mRowNames.size();
+  mValues.assign(mColumnNames.size() * mNumRows, NOT_A_NUMBER);
+  for (vector<Entry>::const_iterator it = entries.begin();
+       it != entries.end(); ++it)
+  {
+    mValues[(size_t)it->column * mNumRows + it->row] = it->value;
+  }
+
+  mIsParsed.assign(mColumnNames.size(), 1);
+  return true;
+}
+
+
+/*
+ * Parses the values of the given column of CSV or TSV data; a column
+ * index equal to the number of columns parses all columns in one pass.
+ * Must be called with the mutex held.
+ */
+void
+SedDataTable::parseColumn (unsigned int n) const
+{
+  const size_t numColumns = mColumnNames.size();
+  const bool all = (n >= numColumns);
+  if (all)
+  {
+    bool parsed = true;
+    for (size_t i = 0; i < numColumns && parsed; ++i) parsed = mIsParsed[i] != 0;
+    if (parsed) return;
+  }
+  else if (mIsParsed[n])
+  {
+    return;
+  }
+
+  // allocated once, so that views stay valid
+  if (mValues.empty())
+  {
+    mValues.assign(numColumns * mNumRows, NOT_A_NUMBER);
+  }
+
+  const char* data = mFile.getData();
+  const char* end = data + mFile.getSize();
+
+  for (unsigned int row = 0; row < mNumRows; ++row)
+  {
+    const char* field = data + mRowOffsets[row];
+    const char* lineEnd = findLineEnd(field, end);
+
+    for (size_t column = 0; column < numColumns; ++column)
+    {
+      const char* fieldEnd = static_cast<const char*>(
+        memchr(field, mDelimiter, (size_t)(lineEnd - field)));
+      if (fieldEnd == NULL) fieldEnd = lineEnd;
+
+      if (all ? !mIsParsed[column] : column == n)
+      {
+        mValues[column * mNumRows + row] = parseNumber(field, fieldEnd);
+        if (!all) break;
+      }
+
+      // missing values stay NaN
+      if (fieldEnd == lineEnd) break;
+      field = fieldEnd + 1;
+    }
+  }
+
+  if (all)
+  {
+    mIsParsed.assign(numColumns, 1);
+  }
+  else
+  {
+    mIsParsed[n] = 1;
+  }
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
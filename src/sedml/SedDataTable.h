@@ -0,0 +1,333 @@
+/**
+ * @file SedDataTable.h
+ * @brief Definition of the SedDataTable class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedDataTable
+ * @sbmlbrief{} Two-dimensional numerical data read from the source of a
+ * SedDataDescription.
+ *
+ * A SedDataTable holds the data of one CSV, TSV or NuML file as a table of
+ * rows and named columns: the first dimension of the data are the rows,
+ * the second the columns.  The file is mapped into memory and only
+ * indexed when it is read; the values of a CSV or TSV column are parsed
+ * the first time they are requested, so that tables with many columns of
+ * which only few are used are cheap to load.  All values are stored column
+ * by column in a single buffer, and columns and rows are returned as
+ * SedDataView objects pointing into that buffer.
+ *
+ * CSV and TSV files start with a line holding the column names, followed
+ * by one line of values per row.  Empty lines and lines starting with
+ * <code>#</code> are skipped, and missing or unreadable values are NaN.
+ * The rows of a CSV or TSV file are identified by their position, starting
+ * at 0.  Of a NuML file the first result component is read; its outer
+ * composite values are the rows and the inner composite values the
+ * columns.
+ *
+ * SedDataTable objects are normally created and cached by a
+ * SedDataLoader.  Their methods may be called from several threads.
+ *
+ * @class SedDataView
+ * @sbmlbrief{} Read-only view of a sequence of values of a SedDataTable.
+ *
+ * A SedDataView refers to values owned by a SedDataTable without copying
+ * them; it remains valid as long as the table exists.  Consecutive values
+ * are @c getStride() apart, so that the view can refer to a column, or
+ * part of one, as well as to a row.
+ */
+
+
+#ifndef SedDataTable_h
+#define SedDataTable_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <sedml/SedMappedFile.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedDataView
+{
+public:
+
+  /**
+   * Creates a new, empty SedDataView.
+   */
+  SedDataView ();
+
+
+  /**
+   * Creates a new SedDataView of @p size values, starting at @p data and
+   * @p stride values apart.
+   */
+  SedDataView (const double* data, unsigned int size, unsigned int stride = 1);
+
+
+  /**
+   * @return the number of values of this view.
+   */
+  unsigned int size () const;
+
+
+  /**
+   * @return @c true if this view has no values.
+   */
+  bool empty () const;
+
+
+  /**
+   * @return the distance between consecutive values of this view in the
+   * underlying buffer.
+   */
+  unsigned int getStride () const;
+
+
+  /**
+   * @return the first value of this view, or @c NULL if it is empty.
+   */
+  const double* getData () const;
+
+
+  /**
+   * @return the value with the given index; the index is not checked.
+   */
+  double operator[] (unsigned int n) const
+  {
+    return mData[(size_t)n * mStride];
+  }
+
+
+  /**
+   * @return a view of @p count values of this view, starting at @p first;
+   * the range is clipped to this view.
+   */
+  SedDataView getSubView (unsigned int first, unsigned int count) const;
+
+
+  /**
+   * Replaces the content of the given vector with the values of this
+   * view.
+   */
+  void copyTo (std::vector<double>& values) const;
+
+
+private:
+
+  const double* mData;
+  unsigned int mSize;
+  unsigned int mStride;
+};
+
+
+class LIBSEDML_EXTERN SedDataTable
+{
+public:
+
+  /**
+   * Creates a new, empty SedDataTable.
+   */
+  SedDataTable ();
+
+
+  /**
+   * Destroys this SedDataTable.
+   */
+  ~SedDataTable ();
+
+
+  /**
+   * Reads the file with the given name.
+   *
+   * @param fileName the name of the file.
+   * @param format the format of the file, one of
+   * <code>urn:sedml:format:csv</code>, <code>urn:sedml:format:tsv</code>
+   * and <code>urn:sedml:format:numl</code>.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if @p format is not supported.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if the file cannot be read or its content is not understood.
+   */
+  int readFile (const std::string& fileName, const std::string& format);
+
+
+  /**
+   * Reads the data from the given string.
+   *
+   * @param contents the data.
+   * @param format the format of the data, see readFile().
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if @p format is not supported.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if the content is not understood.
+   */
+  int readFromString (const std::string& contents, const std::string& format);
+
+
+  /**
+   * @return the format of the data that has been read.
+   */
+  const std::string& getFormat () const;
+
+
+  /**
+   * @return @c true if the data is mapped from a file rather than copied.
+   */
+  bool isMapped () const;
+
+
+  /**
+   * @return the number of rows of this table.
+   */
+  unsigned int getNumRows () const;
+
+
+  /**
+   * @return the number of columns of this table.
+   */
+  unsigned int getNumColumns () const;
+
+
+  /**
+   * @return the name of the column with the given index, or an empty
+   * string if there is no such column.
+   */
+  const std::string& getColumnName (unsigned int n) const;
+
+
+  /**
+   * @return the index of the first column with the given name, or -1 if
+   * there is no such column.
+   */
+  int getColumnIndex (const std::string& name) const;
+
+
+  /**
+   * @return the index value of the row with the given index: its position
+   * for CSV and TSV data, or the index value of its composite value for
+   * NuML data.
+   */
+  std::string getRowName (unsigned int n) const;
+
+
+  /**
+   * @return the index of the first row with the given index value (see
+   * getRowName()), or -1 if there is no such row.
+   */
+  int getRowIndex (const std::string& name) const;
+
+
+  /**
+   * @return a view of the column with the given index, which is empty if
+   * there is no such column.
+   */
+  SedDataView getColumn (unsigned int n) const;
+
+
+  /**
+   * @return a view of the row with the given index, which is empty if
+   * there is no such row.
+   */
+  SedDataView getRow (unsigned int n) const;
+
+
+  /**
+   * @return the value in the given row and column, or NaN if there is no
+   * such value.
+   */
+  double getValue (unsigned int row, unsigned int column) const;
+
+
+  /**
+   * Removes all data from this table.
+   */
+  void clear ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  SedDataTable (const SedDataTable& orig);
+  SedDataTable& operator= (const SedDataTable& rhs);
+
+  int read (const std::string& format);
+  bool indexDelimited (char delimiter);
+  bool readNuML ();
+  void parseColumn (unsigned int n) const;
+
+  typedef std::unordered_map<std::string, unsigned int> NameMap;
+
+  SedMappedFile mFile;
+  std::string mFormat;
+  char mDelimiter;
+
+  std::vector<std::string> mColumnNames;
+  NameMap mColumnIndex;
+  std::vector<std::string> mRowNames;
+  NameMap mRowIndex;
+
+  // start of each row in the mapped file, for CSV and TSV data
+  std::vector<size_t> mRowOffsets;
+  unsigned int mNumRows;
+
+  // column-major values, and whether each column has been parsed
+  mutable std::vector<double> mValues;
+  mutable std::vector<unsigned char> mIsParsed;
+  mutable std::mutex mMutex;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedDataTable_h */
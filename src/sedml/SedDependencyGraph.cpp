@@ -0,0 +1,651 @@
+/**
+ * @file SedDependencyGraph.cpp
+ * @brief Implementation of the SedDependencyGraph class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedSubTask.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedDataRange.h>
+#include <sedml/SedDataDescription.h>
+#include <sedml/SedDataSource.h>
+#include <sedml/SedAdjustableParameter.h>
+#include <sedml/SedFitMapping.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedShadedArea.h>
+#include <sedml/SedSurface.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedSubPlot.h>
+#include <sedml/SedParameterEstimationReport.h>
+#include <sedml/SedParameterEstimationResultPlot.h>
+#include <sedml/SedWaterfallPlot.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <algorithm>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+SedDependencyGraph::SedDependencyGraph ()
+  : mNodes()
+  , mDependencies()
+  , mDependents()
+  , mStageOf()
+  , mStages()
+  , mCycles()
+  , mDanglingReferences()
+  , mIds()
+  , mLastSource()
+{
+}
+
+
+SedDependencyGraph::~SedDependencyGraph ()
+{
+}
+
+
+int
+SedDependencyGraph::build (const SedDocument* document)
+{
+  clear();
+  if (document == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  for (unsigned int i = 0; i < document->getNumDataDescriptions(); ++i)
+  {
+    const SedDataDescription* description = document->getDataDescription(i);
+    unsigned int node = addNode(description, KIND_COUNT);
+
+    // data sources are referenced, but executed with their description
+    for (unsigned int n = 0; n < description->getNumDataSources(); ++n)
+    {
+      const string& id = description->getDataSource(n)->getId();
+      if (!id.empty()) mKindIds[KIND_DATA_SOURCE].insert(IdMap::value_type(id, node));
+    }
+  }
+
+  for (unsigned int i = 0; i < document->getNumModels(); ++i)
+  {
+    addNode(document->getModel(i), KIND_MODEL);
+  }
+
+  for (unsigned int i = 0; i < document->getNumSimulations(); ++i)
+  {
+    addNode(document->getSimulation(i), KIND_SIMULATION);
+  }
+
+  for (unsigned int i = 0; i < document->getNumTasks(); ++i)
+  {
+    addNode(document->getTask(i), KIND_TASK);
+  }
+
+  for (unsigned int i = 0; i < document->getNumDataGenerators(); ++i)
+  {
+    addNode(document->getDataGenerator(i), KIND_DATA_GENERATOR);
+  }
+
+  for (unsigned int i = 0; i < document->getNumOutputs(); ++i)
+  {
+    addNode(document->getOutput(i), KIND_OUTPUT);
+  }
+
+  mDependencies.resize(mNodes.size());
+  mDependents.resize(mNodes.size());
+  mLastSource.assign(mNodes.size(), (unsigned int)mNodes.size());
+
+  for (unsigned int node = 0; node < mNodes.size(); ++node)
+  {
+    SedBase* element = const_cast<SedBase*>(mNodes[node]);
+    addReferences(node, element);
+
+    SedElementIterator<SedBase> end;
+    for (SedElementIterator<SedBase> it(element); it != end; ++it)
+    {
+      addReferences(node, *it);
+    }
+  }
+
+  mLastSource.clear();
+
+  sort();
+  findCycles();
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+void
+SedDependencyGraph::clear ()
+{
+  mNodes.clear();
+  mDependencies.clear();
+  mDependents.clear();
+  mStageOf.clear();
+  mStages.clear();
+  mCycles.clear();
+  mDanglingReferences.clear();
+  mIds.clear();
+  for (int kind = 0; kind < KIND_COUNT; ++kind)
+  {
+    mKindIds[kind].clear();
+  }
+}
+
+
+unsigned int
+SedDependencyGraph::getNumNodes () const
+{
+  return (unsigned int)mNodes.size();
+}
+
+
+const SedBase*
+SedDependencyGraph::getNode (unsigned int n) const
+{
+  return (n < mNodes.size()) ? mNodes[n] : NULL;
+}
+
+
+int
+SedDependencyGraph::getNodeIndex (const std::string& id) const
+{
+  IdMap::const_iterator it = mIds.find(id);
+  return (it == mIds.end()) ? -1 : (int)it->second;
+}
+
+
+const std::vector<unsigned int>&
+SedDependencyGraph::getDependencies (unsigned int n) const
+{
+  static const vector<unsigned int> empty;
+  return (n < mDependencies.size()) ? mDependencies[n] : empty;
+}
+
+
+const std::vector<unsigned int>&
+SedDependencyGraph::getDependents (unsigned int n) const
+{
+  static const vector<unsigned int> empty;
+  return (n < mDependents.size()) ? mDependents[n] : empty;
+}
+
+
+unsigned int
+SedDependencyGraph::getNumDanglingReferences () const
+{
+  return (unsigned int)mDanglingReferences.size();
+}
+
+
+const SedDependencyGraph::DanglingReference&
+SedDependencyGraph::getDanglingReference (unsigned int n) const
+{
+  static const DanglingReference empty = { 0, NULL, "", "" };
+  return (n < mDanglingReferences.size()) ? mDanglingReferences[n] : empty;
+}
+
+
+unsigned int
+SedDependencyGraph::getNumCycles () const
+{
+  return (unsigned int)mCycles.size();
+}
+
+
+const std::vector<unsigned int>&
+SedDependencyGraph::getCycle (unsigned int n) const
+{
+  static const vector<unsigned int> empty;
+  return (n < mCycles.size()) ? mCycles[n] : empty;
+}
+
+
+unsigned int
+SedDependencyGraph::getNumStages () const
+{
+  return (unsigned int)mStages.size();
+}
+
+
+const std::vector<unsigned int>&
+SedDependencyGraph::getStage (unsigned int n) const
+{
+  static const vector<unsigned int> empty;
+  return (n < mStages.size()) ? mStages[n] : empty;
+}
+
+
+int
+SedDependencyGraph::getStageOf (unsigned int n) const
+{
+  return (n < mStageOf.size()) ? mStageOf[n] : -1;
+}
+
+
+void
+SedDependencyGraph::getAffectedNodes (const std::vector<unsigned int>& changed,
+                                      std::vector<unsigned int>& affected) const
+{
+  affected.clear();
+
+  vector<bool> isAffected(mNodes.size(), false);
+  for (size_t i = 0; i < changed.size(); ++i)
+  {
+    if (changed[i] < mNodes.size() && !isAffected[changed[i]])
+    {
+      isAffected[changed[i]] = true;
+      affected.push_back(changed[i]);
+    }
+  }
+
+  for (size_t i = 0; i < affected.size(); ++i)
+  {
+    const vector<unsigned int>& dependents = mDependents[affected[i]];
+    for (size_t n = 0; n < dependents.size(); ++n)
+    {
+      if (!isAffected[dependents[n]])
+      {
+        isAffected[dependents[n]] = true;
+        affected.push_back(dependents[n]);
+      }
+    }
+  }
+
+  // nodes that cannot be executed go last
+  const vector<int>& stageOf = mStageOf;
+  std::sort(affected.begin(), affected.end(),
+    [&stageOf](unsigned int a, unsigned int b)
+    {
+      unsigned int stageA = (unsigned int)stageOf[a];
+      unsigned int stageB = (unsigned int)stageOf[b];
+      return (stageA != stageB) ? stageA < stageB : a < b;
+    });
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+unsigned int
+SedDependencyGraph::addNode (const SedBase* element, Kind kind)
+{
+  unsigned int node = (unsigned int)mNodes.size();
+  mNodes.push_back(element);
+
+  // the first element with an id wins, as with SedDocument::getElementBySId
+  const string& id = element->getId();
+  if (!id.empty())
+  {
+    mIds.insert(IdMap::value_type(id, node));
+    if (kind != KIND_COUNT) mKindIds[kind].insert(IdMap::value_type(id, node));
+  }
+
+  return node;
+}
+
+
+/*
+ * Adds the references held by the given element, which is the given node
+ * or one of its descendants.
+ */
+void
+SedDependencyGraph::addReferences (unsigned int node, const SedBase* element)
+{
+  switch (element->getTypeCode())
+  {
+  case SEDML_MODEL:
+  {
+    const string& source = static_cast<const SedModel*>(element)->getSource();
+    if (!source.empty() && source[0] == '#')
+    {
+      addReference(node, element, "source", source.substr(1), KIND_MODEL);
+    }
+    break;
+  }
+
+  case SEDML_TASK:
+  {
+    const SedTask* task = static_cast<const SedTask*>(element);
+    addReference(node, element, "modelReference", task->getModelReference(),
+                 KIND_MODEL);
+    addReference(node, element, "simulationReference",
+                 task->getSimulationReference(), KIND_SIMULATION);
+    break;
+  }
+
+  case SEDML_TASK_SUBTASK:
+    addReference(node, element, "task",
+                 static_cast<const SedSubTask*>(element)->getTask(), KIND_TASK);
+    break;
+
+  case SEDML_VARIABLE:
+  {
+    const SedVariable* variable = static_cast<const SedVariable*>(element);
+    addReference(node, element, "taskReference",
+                 variable->getTaskReference(), KIND_TASK);
+    addReference(node, element, "modelReference",
+                 variable->getModelReference(), KIND_MODEL);
+    break;
+  }
+
+  case SEDML_TASK_SETVALUE:
+    addReference(node, element, "modelReference",
+      static_cast<const SedSetValue*>(element)->getModelReference(), KIND_MODEL);
+    break;
+
+  case SEDML_DATA_RANGE:
+    addReference(node, element, "sourceReference",
+      static_cast<const SedDataRange*>(element)->getSourceReference(),
+      KIND_DATA_SOURCE);
+    break;
+
+  case SEDML_ADJUSTABLE_PARAMETER:
+    addReference(node, element, "modelReference",
+      static_cast<const SedAdjustableParameter*>(element)->getModelReference(),
+      KIND_MODEL);
+    break;
+
+  case SEDML_FITMAPPING:
+  {
+    const SedFitMapping* mapping = static_cast<const SedFitMapping*>(element);
+    addReference(node, element, "dataSource", mapping->getDataSource(),
+                 KIND_DATA_GENERATOR, KIND_DATA_SOURCE);
+    addReference(node, element, "target", mapping->getTarget(),
+                 KIND_DATA_GENERATOR);
+    break;
+  }
+
+  case SEDML_OUTPUT_CURVE:
+  {
+    const SedCurve* curve = static_cast<const SedCurve*>(element);
+    addReference(node, element, "xDataReference", curve->getXDataReference(),
+                 KIND_DATA_GENERATOR);
+    addReference(node, element, "yDataReference", curve->getYDataReference(),
+                 KIND_DATA_GENERATOR);
+    addReference(node, element, "xErrorUpper", curve->getXErrorUpper(),
+                 KIND_DATA_GENERATOR);
+    addReference(node, element, "xErrorLower", curve->getXErrorLower(),
+                 KIND_DATA_GENERATOR);
+    addReference(node, element, "yErrorUpper", curve->getYErrorUpper(),
+                 KIND_DATA_GENERATOR);
+    addReference(node, element, "yErrorLower", curve->getYErrorLower(),
+                 KIND_DATA_GENERATOR);
+    break;
+  }
+
+  case SEDML_SHADEDAREA:
+  {
+    const SedShadedArea* area = static_cast<const SedShadedArea*>(element);
+    addReference(node, element, "xDataReference", area->getXDataReference(),
+                 KIND_DATA_GENERATOR);
+    addReference(node, element, "yDataReferenceFrom",
+                 area->getYDataReferenceFrom(), KIND_DATA_GENERATOR);
+    addReference(node, element, "yDataReferenceTo",
+                 area->getYDataReferenceTo(), KIND_DATA_GENERATOR);
+    break;
+  }
+
+  case SEDML_OUTPUT_SURFACE:
+  {
+    const SedSurface* surface = static_cast<const SedSurface*>(element);
+    addReference(node, element, "xDataReference",
+                 surface->getXDataReference(), KIND_DATA_GENERATOR);
+    addReference(node, element, "yDataReference",
+                 surface->getYDataReference(), KIND_DATA_GENERATOR);
+    addReference(node, element, "zDataReference",
+                 surface->getZDataReference(), KIND_DATA_GENERATOR);
+    break;
+  }
+
+  case SEDML_OUTPUT_DATASET:
+    addReference(node, element, "dataReference",
+      static_cast<const SedDataSet*>(element)->getDataReference(),
+      KIND_DATA_GENERATOR);
+    break;
+
+  case SEDML_SUBPLOT:
+    addReference(node, element, "plot",
+      static_cast<const SedSubPlot*>(element)->getPlot(), KIND_OUTPUT);
+    break;
+
+  case SEDML_PARAMETERESTIMATIONREPORT:
+    addReference(node, element, "taskReference",
+      static_cast<const SedParameterEstimationReport*>(element)
+        ->getTaskReference(), KIND_TASK);
+    break;
+
+  case SEDML_PARAMETERESTIMATIONRESULTPLOT:
+    addReference(node, element, "taskReference",
+      static_cast<const SedParameterEstimationResultPlot*>(element)
+        ->getTaskReference(), KIND_TASK);
+    break;
+
+  case SEDML_WATERFALLPLOT:
+    addReference(node, element, "taskReference",
+      static_cast<const SedWaterfallPlot*>(element)->getTaskReference(), KIND_TASK);
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+/*
+ * Adds an edge from the given node to the element of the given kind with
+ * the given id, or records a dangling reference.
+ */
+void
+SedDependencyGraph::addReference (unsigned int node, const SedBase* element,
+                                  const std::string& attribute,
+                                  const std::string& reference, Kind kind,
+                                  Kind alternative)
+{
+  if (reference.empty()) return;
+
+  IdMap::const_iterator it = mKindIds[kind].find(reference);
+  if (it == mKindIds[kind].end() && alternative != KIND_COUNT)
+  {
+    it = mKindIds[alternative].find(reference);
+    if (it == mKindIds[alternative].end()) it = mKindIds[kind].end();
+  }
+
+  if (it == mKindIds[kind].end())
+  {
+    DanglingReference dangling = { node, element, attribute, reference };
+    mDanglingReferences.push_back(dangling);
+    return;
+  }
+
+  // the references of a node are added together, so a single marker per
+  // target is enough to avoid duplicate edges
+  unsigned int target = it->second;
+  if (mLastSource[target] == node) return;
+  mLastSource[target] = node;
+
+  mDependencies[node].push_back(target);
+  mDependents[target].push_back(node);
+}
+
+
+/*
+ * Assigns each node the length of the longest path to a node without
+ * dependencies, which is the earliest stage it can be executed in.
+ */
+void
+SedDependencyGraph::sort ()
+{
+  size_t numNodes = mNodes.size();
+  mStageOf.assign(numNodes, -1);
+
+  vector<size_t> remaining(numNodes);
+  vector<unsigned int> ready;
+  ready.reserve(numNodes);
+
+  for (unsigned int n = 0; n < numNodes; ++n)
+  {
+    remaining[n] = mDependencies[n].size();
+    if (remaining[n] == 0)
+    {
+      mStageOf[n] = 0;
+      ready.push_back(n);
+    }
+  }
+
+  vector<int> stage(numNodes, 0);
+  for (size_t i = 0; i < ready.size(); ++i)
+  {
+    unsigned int node = ready[i];
+    const vector<unsigned int>& dependents = mDependents[node];
+
+    for (size_t n = 0; n < dependents.size(); ++n)
+    {
+      unsigned int dependent = dependents[n];
+      stage[dependent] = max(stage[dependent], mStageOf[node] + 1);
+
+      if (--remaining[dependent] == 0)
+      {
+        mStageOf[dependent] = stage[dependent];
+        ready.push_back(dependent);
+      }
+    }
+  }
+
+  for (unsigned int n = 0; n < numNodes; ++n)
+  {
+    if (mStageOf[n] < 0) continue;
+
+    if ((size_t)mStageOf[n] >= mStages.size()) mStages.resize(mStageOf[n] + 1);
+    mStages[mStageOf[n]].push_back(n);
+  }
+}
+
+
+/*
+ * Finds the strongly connected components among the nodes that could not
+ * be sorted; those with more than one node, or with a node referring to
+ * itself, are cycles.
+ */
+void
+SedDependencyGraph::findCycles ()
+{
+  size_t numNodes = mNodes.size();
+  vector<int> index(numNodes, -1);
+  vector<int> low(numNodes, 0);
+  vector<bool> isOnStack(numNodes, false);
+  vector<unsigned int> stack;
+  vector< pair<unsigned int, size_t> > calls;
+  int counter = 0;
+
+  for (unsigned int start = 0; start < numNodes; ++start)
+  {
+    if (mStageOf[start] >= 0 || index[start] >= 0) continue;
+
+    index[start] = low[start] = counter++;
+    stack.push_back(start);
+    isOnStack[start] = true;
+    calls.push_back(make_pair(start, (size_t)0));
+
+    while (!calls.empty())
+    {
+      unsigned int node = calls.back().first;
+      const vector<unsigned int>& dependencies = mDependencies[node];
+
+      if (calls.back().second < dependencies.size())
+      {
+        unsigned int next = dependencies[calls.back().second++];
+        if (mStageOf[next] >= 0) continue;
+
+        if (index[next] < 0)
+        {
+          index[next] = low[next] = counter++;
+          stack.push_back(next);
+          isOnStack[next] = true;
+          calls.push_back(make_pair(next, (size_t)0));
+        }
+        else if (isOnStack[next])
+        {
+          low[node] = min(low[node], index[next]);
+        }
+        continue;
+      }
+
+      calls.pop_back();
+      if (!calls.empty())
+      {
+        unsigned int caller = calls.back().first;
+        low[caller] = min(low[caller], low[node]);
+      }
+
+      if (low[node] != index[node]) continue;
+
+      vector<unsigned int> component;
+      unsigned int member;
+      do
+      {
+        member = stack.back();
+        stack.pop_back();
+        isOnStack[member] = false;
+        component.push_back(member);
+      }
+      while (member != node);
+
+      if (component.size() > 1
+        || find(dependencies.begin(), dependencies.end(), node)
+           != dependencies.end())
+      {
+        std::sort(component.begin(), component.end());
+        mCycles.push_back(component);
+      }
+    }
+  }
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,280 @@
+/**
+ * @file SedDependencyGraph.h
+ * @brief Definition of the SedDependencyGraph class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedDependencyGraph
+ * @sbmlbrief{} The graph of references between the elements of a SED-ML
+ * document.
+ *
+ * The elements of a SED-ML document refer to each other by id only: a
+ * model to the model it is derived from, a task to its model and
+ * simulation, a repeated task to its subtasks, a variable to a task or
+ * model, a data generator's variables to tasks, and an output to data
+ * generators.  A SedDependencyGraph resolves all of these references in
+ * one pass over the document.
+ *
+ * The nodes of the graph are the data descriptions, models, simulations,
+ * tasks, data generators and outputs of the document; each reference
+ * found within a node (or within any of its children) becomes an edge to
+ * the node it refers to.  References that do not resolve to an element of
+ * the expected kind are recorded as dangling references, and groups of
+ * nodes that depend on each other are recorded as cycles.
+ *
+ * The remaining nodes are sorted into stages: every node depends only on
+ * nodes of earlier stages, so that all elements of a stage (for instance
+ * all tasks of it) can be executed concurrently once the previous stages
+ * are done.  getAffectedNodes() returns everything that has to be
+ * recomputed after some elements changed, so that outputs whose inputs
+ * did not change can be skipped.
+ *
+ * @code{.cpp}
+SedDependencyGraph graph;
+doc->buildDependencyGraph(graph);
+
+for (unsigned int s = 0; s < graph.getNumStages(); ++s)
+{
+  const std::vector<unsigned int>& stage = graph.getStage(s);
+  // run the tasks of the stage in parallel ...
+}
+ * @endcode
+ */
+
+
+#ifndef SedDependencyGraph_h
+#define SedDependencyGraph_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedDependencyGraph
+{
+public:
+
+  /**
+   * A reference that does not resolve to an element of the expected kind.
+   */
+  struct DanglingReference
+  {
+    /** the node containing the reference */
+    unsigned int node;
+
+    /** the element holding the reference; the node or one of its children */
+    const SedBase* element;
+
+    /** the name of the attribute holding the reference */
+    std::string attribute;
+
+    /** the value of the attribute */
+    std::string reference;
+  };
+
+
+  /**
+   * Creates a new, empty SedDependencyGraph.
+   */
+  SedDependencyGraph ();
+
+
+  /**
+   * Destroys this SedDependencyGraph.
+   */
+  ~SedDependencyGraph ();
+
+
+  /**
+   * Builds the graph for the given document, replacing any previous
+   * content.  The document must not be modified while the graph is in use.
+   *
+   * @param document the document.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if @p document is @c NULL.
+   */
+  int build (const SedDocument* document);
+
+
+  /**
+   * Removes all nodes from this graph.
+   */
+  void clear ();
+
+
+  /**
+   * @return the number of nodes of this graph.
+   */
+  unsigned int getNumNodes () const;
+
+
+  /**
+   * @return the element of the nth node, or @c NULL if @p n is out of
+   * range.
+   */
+  const SedBase* getNode (unsigned int n) const;
+
+
+  /**
+   * @return the index of the node with the given id, or @c -1 if there is
+   * no such node.
+   */
+  int getNodeIndex (const std::string& id) const;
+
+
+  /**
+   * @return the indices of the nodes that the nth node refers to.
+   */
+  const std::vector<unsigned int>& getDependencies (unsigned int n) const;
+
+
+  /**
+   * @return the indices of the nodes that refer to the nth node.
+   */
+  const std::vector<unsigned int>& getDependents (unsigned int n) const;
+
+
+  /**
+   * @return the number of references that could not be resolved.
+   */
+  unsigned int getNumDanglingReferences () const;
+
+
+  /**
+   * @return the nth reference that could not be resolved.
+   */
+  const DanglingReference& getDanglingReference (unsigned int n) const;
+
+
+  /**
+   * @return the number of groups of nodes that depend on each other.
+   */
+  unsigned int getNumCycles () const;
+
+
+  /**
+   * @return the indices of the nodes of the nth cycle.
+   */
+  const std::vector<unsigned int>& getCycle (unsigned int n) const;
+
+
+  /**
+   * @return the number of stages of the execution plan.
+   */
+  unsigned int getNumStages () const;
+
+
+  /**
+   * @return the indices of the nodes of the nth stage, in document order.
+   */
+  const std::vector<unsigned int>& getStage (unsigned int n) const;
+
+
+  /**
+   * @return the stage of the nth node, or @c -1 if the node is part of a
+   * cycle or depends on one, so that it cannot be executed.
+   */
+  int getStageOf (unsigned int n) const;
+
+
+  /**
+   * Returns the given nodes together with all nodes that depend on them,
+   * directly or indirectly, in the order of the execution plan.
+   *
+   * @param changed the indices of the nodes that changed.
+   * @param affected vector receiving the indices of the affected nodes.
+   */
+  void getAffectedNodes (const std::vector<unsigned int>& changed,
+                         std::vector<unsigned int>& affected) const;
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  enum Kind
+  {
+    KIND_DATA_SOURCE
+  , KIND_MODEL
+  , KIND_SIMULATION
+  , KIND_TASK
+  , KIND_DATA_GENERATOR
+  , KIND_OUTPUT
+  , KIND_COUNT
+  };
+
+  typedef std::unordered_map<std::string, unsigned int> IdMap;
+
+  unsigned int addNode (const SedBase* element, Kind kind);
+  void addReferences (unsigned int node, const SedBase* element);
+  void addReference (unsigned int node, const SedBase* element,
+                     const std::string& attribute,
+                     const std::string& reference, Kind kind,
+                     Kind alternative = KIND_COUNT);
+  void sort ();
+  void findCycles ();
+
+  std::vector<const SedBase*> mNodes;
+  std::vector< std::vector<unsigned int> > mDependencies;
+  std::vector< std::vector<unsigned int> > mDependents;
+  std::vector<int> mStageOf;
+  std::vector< std::vector<unsigned int> > mStages;
+  std::vector< std::vector<unsigned int> > mCycles;
+  std::vector<DanglingReference> mDanglingReferences;
+  IdMap mIds;
+  IdMap mKindIds[KIND_COUNT];
+  std::vector<unsigned int> mLastSource;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedDependencyGraph_h */
@@ -33,6 +33,11 @@
  */
 #include <sedml/SedDocument.h>
 #include <sbml/xml/XMLInputStream.h>
+#include <sedml/SedLazyListLoader.h>
+#include <sedml/SedArena.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedValidator.h>
 
 #include <sedml/SedUniformTimeCourse.h>
 #include <sedml/SedOneStep.h>
@@ -47,6 +52,10 @@
 #include <sedml/SedFigure.h>
 #include <sedml/SedParameterEstimationResultPlot.h>
 
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
 
 using namespace std;
 
@@ -78,6 +87,15 @@ SedDocument::SedDocument(unsigned int level, unsigned int version)
   , mDataGenerators (level, version)
   , mOutputs (level, version)
   , mStyles (level, version)
+  , mReaderHandler (NULL)
+  , mLazyListLoader (NULL)
+  , mArena (NULL)
+  , mEffectiveStyles ()
+  , mEffectiveStylesMutex ()
+  , mChangedElements ()
+  , mChangedIds ()
+  , mStructureChanged (false)
+  , mTrackChanges (false)
 {
   setSedNamespacesAndOwn(new SedNamespaces(level, version));
   setLevel(level);
@@ -90,7 +108,7 @@ SedDocument::SedDocument(unsigned int level, unsigned int version)
 /*
  * Creates a new SedDocument using the given SedNamespaces object @p sedmlns.
  */
-SedDocument::SedDocument(SedNamespaces *sedmlns)
+SedDocument::SedDocument(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mLevel (SEDML_INT_MAX)
   , mIsSetLevel (false)
@@ -104,6 +122,15 @@ SedDocument::SedDocument(SedNamespaces *sedmlns)
   , mDataGenerators (sedmlns)
   , mOutputs (sedmlns)
   , mStyles (sedmlns)
+  , mReaderHandler (NULL)
+  , mLazyListLoader (NULL)
+  , mArena (NULL)
+  , mEffectiveStyles ()
+  , mEffectiveStylesMutex ()
+  , mChangedElements ()
+  , mChangedIds ()
+  , mStructureChanged (false)
+  , mTrackChanges (false)
 {
   setElementNamespace(sedmlns->getURI());
   setLevel(sedmlns->getLevel());
@@ -130,6 +157,15 @@ SedDocument::SedDocument(const SedDocument& orig)
   , mDataGenerators ( orig.mDataGenerators )
   , mOutputs ( orig.mOutputs )
   , mStyles ( orig.mStyles )
+  , mReaderHandler (NULL)
+  , mLazyListLoader (NULL)
+  , mArena (NULL)
+  , mEffectiveStyles ()
+  , mEffectiveStylesMutex ()
+  , mChangedElements ()
+  , mChangedIds ()
+  , mStructureChanged (false)
+  , mTrackChanges (false)
 {
   setSedDocument(this);
 
@@ -158,6 +194,9 @@ SedDocument::operator=(const SedDocument& rhs)
     mDataGenerators = rhs.mDataGenerators;
     mOutputs = rhs.mOutputs;
     mStyles = rhs.mStyles;
+    // the lists have been replaced, so their pending content is obsolete
+    delete mLazyListLoader;
+    mLazyListLoader = NULL;
     connectToChild();
     setSedDocument(this);
   }
@@ -176,11 +215,43 @@ SedDocument::clone() const
 }
 
 
+/*
+ * Creates and returns a copy of this SedDocument object that shares its
+ * elements until they are accessed.
+ */
+SedDocument*
+SedDocument::cloneCopyOnWrite() const
+{
+  SedSharedItemsScope share;
+  return new SedDocument(*this);
+}
+
+
 /*
  * Destructor for SedDocument.
  */
 SedDocument::~SedDocument()
 {
+  // elements torn down with the document must not call back into it
+  mHasBeenDeleted = true;
+  delete mLazyListLoader;
+  invalidateEffectiveStyles();
+
+  // elements allocated from the arena keep it alive until they are gone;
+  // those deleted along with the document are given back to it at once
+  if (mArena != NULL)
+  {
+    mArena->startRelease();
+    mAlgorithmParameters.clear();
+    mDataDescriptions.clear();
+    mModels.clear();
+    mSimulations.clear();
+    mAbstractTasks.clear();
+    mDataGenerators.clear();
+    mOutputs.clear();
+    mStyles.clear();
+    mArena->release();
+  }
 }
 
 
@@ -239,6 +310,9 @@ SedDocument::setLevel(unsigned int level)
     setSedNamespacesAndOwn(new SedNamespaces(level, mVersion));
   }
 
+  // elements without an id attribute in this level/version hide their ids
+  invalidateAllIdIndexes();
+
   return LIBSEDML_OPERATION_SUCCESS;
 }
 
@@ -257,6 +331,9 @@ SedDocument::setVersion(unsigned int version)
     setSedNamespacesAndOwn(new SedNamespaces(mLevel, version));
   }
 
+  // elements without an id attribute in this level/version hide their ids
+  invalidateAllIdIndexes();
+
   return LIBSEDML_OPERATION_SUCCESS;
 }
 
@@ -1704,109 +1781,234 @@ SedDocument::getStyle(const std::string& sid) const
 SedStyle
 SedDocument::getEffectiveStyle(const std::string& sid) const
 {
-    const SedStyle* top =  mStyles.get(sid);
-    if (top == NULL)
+  const SedStyle* style = getResolvedStyle(sid);
+  if (style == NULL)
+  {
+    return SedStyle(mLevel, mVersion);
+  }
+
+  return SedStyle(*style);
+}
+
+
+/** @cond doxygenLibSEDMLInternal */
+
+/*
+ * Returns a new style with the attributes of @p top applied to the already
+ * resolved style @p base, which may be NULL.
+ */
+static SedStyle*
+applyStyle(const SedStyle* top, const SedStyle* base)
+{
+  if (base == NULL)
+  {
+    SedStyle* style = new SedStyle(*top);
+    style->unsetBaseStyle();
+    return style;
+  }
+
+  SedStyle* result = new SedStyle(*base);
+  result->setId(top->getId());
+  result->setName(top->getName());
+  result->unsetBaseStyle();
+
+  if (top->isSetLineStyle())
+  {
+    if (result->isSetLineStyle())
     {
-        return SedStyle(mLevel, mVersion);
+      const SedLine* topline = top->getLineStyle();
+      SedLine* baseline = result->getLineStyle();
+
+      if (topline->isSetColor())
+      {
+        baseline->setColor(topline->getColor());
+      }
+
+      if (topline->isSetType())
+      {
+        baseline->setType(topline->getType());
+      }
+
+      if (topline->isSetThickness())
+      {
+        baseline->setThickness(topline->getThickness());
+      }
     }
-    if (!top->isSetBaseStyle())
+    else
     {
-        return SedStyle(*top);
+      result->setLineStyle(top->getLineStyle());
     }
-    SedStyle base = getEffectiveStyle(top->getBaseStyle());
-    base.setId(top->getId());
-    base.setName(top->getName());
-    base.unsetBaseStyle();
+  }
 
-    if (top->isSetLineStyle())
+  if (top->isSetMarkerStyle())
+  {
+    if (result->isSetMarkerStyle())
     {
-        if (base.isSetLineStyle())
-        {
-            const SedLine* topline = top->getLineStyle();
-            SedLine* baseline = base.getLineStyle();
+      const SedMarker* topmarker = top->getMarkerStyle();
+      SedMarker* basemarker = result->getMarkerStyle();
 
-            if (topline->isSetColor())
-            {
-                baseline->setColor(topline->getColor());
-            }
+      if (topmarker->isSetType())
+      {
+        basemarker->setType(topmarker->getType());
+      }
 
-            if (topline->isSetType())
-            {
-                baseline->setType(topline->getType());
-            }
+      if (topmarker->isSetSize())
+      {
+        basemarker->setSize(topmarker->getSize());
+      }
 
-            if (topline->isSetThickness())
-            {
-                baseline->setThickness(topline->getThickness());
-            }
-        }
-        else
-        {
-            base.setLineStyle(top->getLineStyle());
-        }
+      if (topmarker->isSetFill())
+      {
+        basemarker->setFill(topmarker->getFill());
+      }
+
+      if (topmarker->isSetLineColor())
+      {
+        basemarker->setLineColor(topmarker->getLineColor());
+      }
+
+      if (topmarker->isSetLineThickness())
+      {
+        basemarker->setLineThickness(topmarker->getLineThickness());
+      }
+    }
+    else
+    {
+      result->setMarkerStyle(top->getMarkerStyle());
     }
+  }
 
-    if (top->isSetMarkerStyle())
+  if (top->isSetFillStyle())
+  {
+    if (result->isSetFillStyle())
     {
-        if (base.isSetMarkerStyle())
-        {
-            const SedMarker* topmarker = top->getMarkerStyle();
-            SedMarker* basemarker = base.getMarkerStyle();
+      const SedFill* topfill = top->getFillStyle();
+      SedFill* basefill = result->getFillStyle();
 
-            if (topmarker->isSetType())
-            {
-                basemarker->setType(topmarker->getType());
-            }
+      if (topfill->isSetColor())
+      {
+        basefill->setColor(topfill->getColor());
+      }
 
-            if (topmarker->isSetSize())
-            {
-                basemarker->setSize(topmarker->getSize());
-            }
+      //if (topfill->isSetSecondColor())
+      //{
+      //    basefill->setSecondColor(topfill->getSecondColor());
+      //}
+    }
+    else
+    {
+      result->setFillStyle(top->getFillStyle());
+    }
+  }
+  return result;
+}
 
-            if (topmarker->isSetFill())
-            {
-                basemarker->setFill(topmarker->getFill());
-            }
+/** @endcond */
 
-            if (topmarker->isSetLineColor())
-            {
-                basemarker->setLineColor(topmarker->getLineColor());
-            }
 
-            if (topmarker->isSetLineThickness())
-            {
-                basemarker->setLineThickness(topmarker->getLineThickness());
-            }
-        }
-        else
-        {
-            base.setMarkerStyle(top->getMarkerStyle());
-        }
+/*
+ * Get the effective SedStyle from the SedDocument based on its identifier.
+ */
+const SedStyle*
+SedDocument::getResolvedStyle(const std::string& sid) const
+{
+  // the styles are loaded before the cache is locked, as loading them
+  // discards the cache; the lookups below then only read the list
+  mStyles.loadLazyItems();
+
+  const SedStyle* top = mStyles.get(sid);
+  if (top == NULL)
+  {
+    return NULL;
+  }
+
+  lock_guard<mutex> lock(mEffectiveStylesMutex);
+
+  StyleMap::const_iterator found = mEffectiveStyles.find(sid);
+  if (found != mEffectiveStyles.end())
+  {
+    return found->second;
+  }
+
+  // follow the base styles until one without a base style, or one that
+  // has been resolved already
+  vector<const SedStyle*> chain;
+  const SedStyle* base = NULL;
+  bool isCircular = false;
+  size_t cycle = 0;
+
+  for (const SedStyle* style = top; style != NULL; )
+  {
+    vector<const SedStyle*>::iterator seen =
+      find(chain.begin(), chain.end(), style);
+    if (seen != chain.end())
+    {
+      // the styles from here on form a new cycle
+      isCircular = true;
+      cycle = seen - chain.begin();
+      break;
     }
 
-    if (top->isSetFillStyle())
+    chain.push_back(style);
+    if (!style->isSetBaseStyle())
     {
-        if (base.isSetFillStyle())
-        {
-            const SedFill* topfill = top->getFillStyle();
-            SedFill* basefill = base.getFillStyle();
+      break;
+    }
 
-            if (topfill->isSetColor())
-            {
-                basefill->setColor(topfill->getColor());
-            }
+    found = mEffectiveStyles.find(style->getBaseStyle());
+    if (found != mEffectiveStyles.end())
+    {
+      // a NULL entry is a style whose base styles lead into a cycle that
+      // has been reported already
+      base = found->second;
+      isCircular = (base == NULL);
+      cycle = chain.size();
+      break;
+    }
 
-            //if (topfill->isSetSecondColor())
-            //{
-            //    basefill->setSecondColor(topfill->getSecondColor());
-            //}
-        }
-        else
-        {
-            base.setFillStyle(top->getFillStyle());
-        }
+    style = mStyles.get(style->getBaseStyle());
+  }
+
+  if (isCircular)
+  {
+    for (vector<const SedStyle*>::iterator it = chain.begin();
+         it != chain.end(); ++it)
+    {
+      mEffectiveStyles[(*it)->getId()] = NULL;
+    }
+
+    // styles that only lead into the cycle are not part of it
+    if (cycle < chain.size())
+    {
+      const SedStyle* first = chain[cycle];
+      ostringstream msg;
+      msg << "The base styles of the <style> with the id '" << first->getId()
+          << "' refer back to it";
+      for (size_t n = cycle + 1; n < chain.size(); ++n)
+      {
+        msg << ((n == cycle + 1) ? ", through '" : "', '")
+            << chain[n]->getId();
+      }
+      msg << ((cycle + 1 < chain.size()) ? "'." : ".");
+
+      SedDocument* self = const_cast<SedDocument*>(this);
+      self->getErrorLog()->logError(SedmlStyleBaseStyleMustNotBeCircular,
+        getLevel(), getVersion(), msg.str(), first->getLine(),
+        first->getColumn());
     }
-    return base;
+    return NULL;
+  }
+
+  // resolve the chain starting with the style closest to the base
+  for (vector<const SedStyle*>::reverse_iterator it = chain.rbegin();
+       it != chain.rend(); ++it)
+  {
+    SedStyle* resolved = applyStyle(*it, base);
+    mEffectiveStyles[(*it)->getId()] = resolved;
+    base = resolved;
+  }
+
+  return base;
 }
 
 
@@ -2036,7 +2238,60 @@ SedDocument::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedDocument::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/*
+ * Returns the number of child objects of this SedDocument
+ */
+unsigned int
+SedDocument::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mAlgorithmParameters,
+    &mDataDescriptions,
+    &mModels,
+    &mSimulations,
+    &mAbstractTasks,
+    &mDataGenerators,
+    &mOutputs,
+    &mStyles
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 8);
+}
+
+
+/*
+ * Returns the nth child object of this SedDocument
+ */
+const SedBase*
+SedDocument::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mAlgorithmParameters,
+    &mDataDescriptions,
+    &mModels,
+    &mSimulations,
+    &mAbstractTasks,
+    &mDataGenerators,
+    &mOutputs,
+    &mStyles
+  };
+
+  return selectChildElement(children, 8, n - inherited);
 }
 
 /** @endcond */
@@ -2728,6 +2983,16 @@ SedDocument::getObject(const std::string& elementName, unsigned int index)
 /** @endcond */
 
 
+/*
+ * Builds the graph of references between the elements of this SedDocument.
+ */
+int
+SedDocument::buildDependencyGraph(SedDependencyGraph& graph) const
+{
+  return graph.build(this);
+}
+
+
 /*
  * Returns the first child element that has the given @p id in the model-wide
  * SId namespace, or @c NULL if no such object is found.
@@ -2740,67 +3005,322 @@ SedDocument::getElementBySId(const std::string& id)
     return NULL;
   }
 
-  SedBase* obj = NULL;
+  if (!mIdIndex.isValid())
+  {
+    // the elements are visited in the same order in which the lists used
+    // to be searched, so the first match still wins
+    mIdIndex.startBuild();
+    SedElementIterator<SedBase> end;
+    for (SedElementIterator<SedBase> it(this); it != end; ++it)
+    {
+      if ((*it)->getTypeCode() != SEDML_LIST_OF)
+      {
+        mIdIndex.add(*it);
+      }
+    }
+  }
 
-  obj = mAlgorithmParameters.getElementBySId(id);
+  SedBase* element = mIdIndex.get(id);
 
-  if (obj != NULL)
+  // copies of this document must not see the element change, so the lists
+  // on the way to it stop sharing their items
+  for (SedBase* parent = (element != NULL) ? element->getParentSedObject() : NULL;
+       parent != NULL && parent != this; parent = parent->getParentSedObject())
   {
-      return obj;
+    if (parent->getTypeCode() == SEDML_LIST_OF)
+    {
+      static_cast<SedListOf*>(parent)->loadLazyItems();
+    }
   }
 
-  obj = mDataDescriptions.getElementBySId(id);
+  return element;
+}
+
 
-  if (obj != NULL)
+/** @cond doxygenLibSEDMLInternal */
+
+/*
+ * Discards the document-wide id index as well as the id indexes of all
+ * lists in this document.
+ */
+void
+SedDocument::invalidateAllIdIndexes()
+{
+  mIdIndex.invalidate();
+
+  SedElementIterator<SedBase> end;
+  for (SedElementIterator<SedBase> it(this); it != end; ++it)
   {
-    return obj;
+    if ((*it)->getTypeCode() == SEDML_LIST_OF)
+    {
+      static_cast<SedListOf*>(*it)->invalidateIdIndexes();
+    }
   }
+}
 
-  obj = mModels.getElementBySId(id);
 
-  if (obj != NULL)
+/*
+ * Discards the document-wide id index.
+ */
+void
+SedDocument::invalidateIdIndex()
+{
+  mIdIndex.invalidate();
+}
+
+
+/*
+ * Updates the document-wide id index after an element has been renamed.
+ */
+void
+SedDocument::updateIdIndex(SedBase* element, const std::string& oldId)
+{
+  mIdIndex.rename(element, oldId);
+}
+
+
+/*
+ * Discards the effective styles cached by getResolvedStyle().
+ */
+void
+SedDocument::invalidateEffectiveStyles()
+{
+  lock_guard<mutex> lock(mEffectiveStylesMutex);
+
+  for (StyleMap::iterator it = mEffectiveStyles.begin();
+       it != mEffectiveStyles.end(); ++it)
   {
-    return obj;
+    delete it->second;
   }
 
-  obj = mSimulations.getElementBySId(id);
+  mEffectiveStyles.clear();
+}
+
+
+/*
+ * Sets whether the elements that change are recorded.
+ */
+void
+SedDocument::setTrackChanges(bool track)
+{
+  mTrackChanges = track;
+  mChangedElements.clear();
+  mChangedIds.clear();
+  mStructureChanged = false;
+}
+
+
+bool
+SedDocument::getTrackChanges() const
+{
+  return mTrackChanges;
+}
+
+
+void
+SedDocument::recordChange(SedBase* element, unsigned int changes)
+{
+  if (!mTrackChanges) return;
 
-  if (obj != NULL)
+  mChangedElements.insert(element);
+  if ((changes & CHANGE_STRUCTURE) != 0)
   {
-    return obj;
+    mStructureChanged = true;
   }
+}
+
+
+void
+SedDocument::recordIdChange(const std::string& oldId)
+{
+  if (!mTrackChanges || oldId.empty()) return;
 
-  obj = mAbstractTasks.getElementBySId(id);
+  mChangedIds.push_back(oldId);
+}
+
+
+/*
+ * A removed element may be deleted before the changes are taken, so it
+ * must not stay in the record.
+ */
+void
+SedDocument::recordRemoval(SedBase* element)
+{
+  if (!mTrackChanges) return;
+
+  mChangedElements.erase(element);
+  mStructureChanged = true;
+}
+
+
+/*
+ * Hands over the changes recorded since the last call.
+ */
+bool
+SedDocument::takeChanges(std::vector<SedBase*>& elements,
+                         std::vector<std::string>& oldIds)
+{
+  elements.insert(elements.end(), mChangedElements.begin(),
+                  mChangedElements.end());
+  oldIds.insert(oldIds.end(), mChangedIds.begin(), mChangedIds.end());
+
+  bool structureChanged = mStructureChanged;
+  mChangedElements.clear();
+  mChangedIds.clear();
+  mStructureChanged = false;
+
+  return structureChanged;
+}
+
+
+/*
+ * Sets the handler that receives the top-level elements while reading.
+ */
+void
+SedDocument::setReaderHandler(SedReaderHandler* handler)
+{
+  mReaderHandler = handler;
+}
 
-  if (obj != NULL)
+
+/*
+ * Returns the handler that receives the top-level elements while reading.
+ */
+SedReaderHandler*
+SedDocument::getReaderHandler() const
+{
+  return mReaderHandler;
+}
+
+
+/*
+ * Sets whether elements of this SedDocument are allocated from an arena.
+ */
+void
+SedDocument::setUseArena(bool useArena)
+{
+  if (useArena && mArena == NULL)
   {
-    return obj;
+    mArena = new SedArena();
   }
+  else if (!useArena && mArena != NULL)
+  {
+    mArena->release();
+    mArena = NULL;
+  }
+}
+
+
+/*
+ * Returns whether elements of this SedDocument are allocated from an arena.
+ */
+bool
+SedDocument::getUseArena() const
+{
+  return mArena != NULL;
+}
 
-  obj = mDataGenerators.getElementBySId(id);
 
-  if (obj != NULL)
+/*
+ * Returns the arena of this SedDocument.
+ */
+SedArena*
+SedDocument::getArena() const
+{
+  return mArena;
+}
+
+
+/*
+ * Takes ownership of the given loader and marks the lists it knows about
+ * as not read yet.
+ */
+void
+SedDocument::setLazyListLoader(SedLazyListLoader* loader)
+{
+  delete mLazyListLoader;
+  mLazyListLoader = loader;
+
+  if (mLazyListLoader == NULL) return;
+
+  for (unsigned int i = 0; i < mLazyListLoader->getNumLists(); ++i)
   {
-    return obj;
+    SedListOf* list = getListByElementName(mLazyListLoader->getListName(i));
+    if (list != NULL)
+    {
+      list->setHasLazyItems(true);
+    }
   }
+}
 
-  obj = mOutputs.getElementBySId(id);
 
-  if (obj != NULL)
+/*
+ * Reads the items of the given list, which were skipped when this
+ * SedDocument was read.
+ */
+void
+SedDocument::loadLazyList(SedListOf* list)
+{
+  if (mLazyListLoader == NULL || list == NULL) return;
+
+  std::string document;
+  if (mLazyListLoader->extract(list->getElementName(), document))
   {
-    return obj;
-  }
+    SedArenaScope scope(this);
+
+    XMLInputStream stream(document.c_str(), false, "", getErrorLog());
+
+    // skip the root element, and anything before the list
+    stream.next();
+    while (stream.isGood() && !stream.peek().isStart())
+    {
+      stream.next();
+    }
 
-  obj = mStyles.getElementBySId(id);
+    if (stream.isGood())
+    {
+      SedBase* object = createObject(stream);
+      if (object == list)
+      {
+        object->connectToParent(this);
+        object->read(stream);
+      }
+    }
+  }
+  else
+  {
+    getErrorLog()->logError(XMLFileUnreadable, getLevel(), getVersion(),
+      "The " + list->getElementName() + " could not be read, as the file "
+      "has been changed or removed since the document was read.");
+  }
 
-  if (obj != NULL)
+  if (mLazyListLoader->getNumLists() == 0)
   {
-    return obj;
+    delete mLazyListLoader;
+    mLazyListLoader = NULL;
   }
+}
 
-  return obj;
+
+/*
+ * Returns the list of this SedDocument with the given element name.
+ */
+SedListOf*
+SedDocument::getListByElementName(const std::string& name)
+{
+  if (name == "listOfAlgorithmParameters") return &mAlgorithmParameters;
+  if (name == "listOfDataDescriptions") return &mDataDescriptions;
+  if (name == "listOfModels") return &mModels;
+  if (name == "listOfSimulations") return &mSimulations;
+  if (name == "listOfTasks") return &mAbstractTasks;
+  if (name == "listOfDataGenerators") return &mDataGenerators;
+  if (name == "listOfOutputs") return &mOutputs;
+  if (name == "listOfStyles") return &mStyles;
+  return NULL;
 }
 
+/** @endcond */
+
 
 /*
  * Returns a List of all child SedBase objects, including those nested to an
@@ -2831,7 +3351,8 @@ SedDocument::getAllElements(SedElementFilter* filter)
 const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces*
 SedDocument::getNamespaces() const
 {
-  return mSedNamespaces->getNamespaces();
+  const SedNamespaces* sedmlns = mSedNamespaces;
+  return sedmlns->getNamespaces();
 }
 
 
@@ -2841,6 +3362,9 @@ SedDocument::getNamespaces() const
 LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces*
 SedDocument::getNamespaces()
 {
+  // the elements of the document share its namespaces until they are
+  // modified
+  detachSedNamespaces();
   return mSedNamespaces->getNamespaces();
 }
 
@@ -2905,6 +3429,20 @@ SedDocument::getNumErrors(unsigned int severity) const
   return getErrorLog()->getNumFailsWithSeverity(severity);
 }
 
+
+/*
+ * Checks the references between the elements of this SedDocument.
+ */
+unsigned int
+SedDocument::checkConsistency()
+{
+  SedValidator validator;
+  unsigned int numFailures = validator.validate(this);
+  mErrorLog.add(validator.getFailures());
+
+  return numFailures;
+}
+
 void SedDocument::sortOrderedObjects()
 {
     for (unsigned int o = 0; o < mOutputs.size(); o++)
@@ -3193,6 +3731,10 @@ SedDocument::writeXMLNS(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
   LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces * thisNs =
     const_cast<LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces *>(getNamespaces());
 
+  // the namespaces are shared with the elements of the document, so they
+  // are only modified through the non-const accessors, which unshare them
+  SedDocument* self = const_cast<SedDocument*>(this);
+
   // the SED-ML namespace is missing - add it
   if (thisNs == NULL)
     {
@@ -3207,11 +3749,12 @@ SedDocument::writeXMLNS(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
       else
         xmlns.add(SEDML_XMLNS_L1V4);
 
-      mSedNamespaces->setNamespaces(&xmlns);
+      self->setNamespaces(&xmlns);
       thisNs =  const_cast<LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces *>(getNamespaces());
     }
   else if (thisNs->getLength() == 0)
     {
+      thisNs = self->getNamespaces();
       if (getVersion() == 1)
         thisNs->add(SEDML_XMLNS_L1V1);
       else if (getVersion() == 2)
@@ -3230,6 +3773,7 @@ SedDocument::writeXMLNS(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
       if (thisNs->hasNS(sedmlURI, sedmlPrefix) == false)
         {
           // the SED-ML ns is not present
+          thisNs = self->getNamespaces();
           std::string other = thisNs->getURI(sedmlPrefix);
 
           if (other.empty() == false)
@@ -4176,6 +4720,17 @@ SedDocument_hasRequiredAttributes(const SedDocument_t * sd)
 }
 
 
+/*
+ * Checks the references between the elements of this SedDocument_t.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_checkConsistency(SedDocument_t * sd)
+{
+  return (sd != NULL) ? sd->checkConsistency() : 0;
+}
+
+
 
 
 LIBSEDML_CPP_NAMESPACE_END
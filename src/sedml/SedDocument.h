@@ -60,11 +60,23 @@
 #include <sedml/SedListOfOutputs.h>
 #include <sedml/SedListOfStyles.h>
 #include <sedml/SedErrorLog.h>
+#include <sedml/SedIdIndex.h>
+#include <sedml/SedReaderHandler.h>
+#include <sedml/SedLazyListLoader.h>
+#include <sedml/SedArena.h>
 #include <sbml/common/libsbml-namespace.h>
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
+class SedDependencyGraph;
+
 
 class LIBSEDML_EXTERN SedDocument : public SedBase
 {
@@ -85,6 +97,17 @@ protected:
   SedListOfOutputs mOutputs;
   SedListOfStyles mStyles;
   SedErrorLog mErrorLog;
+  SedIdIndex mIdIndex;
+  SedReaderHandler* mReaderHandler;
+  SedLazyListLoader* mLazyListLoader;
+  SedArena* mArena;
+  typedef std::unordered_map<std::string, SedStyle*> StyleMap;
+  mutable StyleMap mEffectiveStyles;
+  mutable std::mutex mEffectiveStylesMutex;
+  std::unordered_set<SedBase*> mChangedElements;
+  std::vector<std::string> mChangedIds;
+  bool mStructureChanged;
+  bool mTrackChanges;
 
   /** @endcond */
 
@@ -113,7 +136,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedDocument(SedNamespaces *sedmlns);
+  SedDocument(const SedNamespaces *sedmlns);
 
 
   /**
@@ -141,6 +164,37 @@ public:
   virtual SedDocument* clone() const;
 
 
+#ifndef SWIG
+  /**
+   * Creates and returns a copy of this SedDocument object that shares the
+   * elements of this one until they are accessed.
+   *
+   * Each list of the copy refers to a reference-counted store holding the
+   * items of the corresponding list of this SedDocument, and clones them
+   * on first access, so that every element read through the copy belongs
+   * to the copy.  The clones in turn share the items of their own lists.
+   * Changing a few attributes of the copy thus only duplicates the lists on
+   * the way to the changed elements.
+   *
+   * This SedDocument keeps its elements, which it lends to the store.  A
+   * list that is about to be changed through its methods gives the store
+   * copies of its items first, and a list that is deleted hands its items
+   * over to the store, so either document may be changed or deleted
+   * independently of the other.  Several threads may make copies of the
+   * same SedDocument at once.
+   *
+   * @warning Changes made to elements of this SedDocument through pointers
+   * obtained before this call, or through a SedElementIterator, are seen by
+   * copies that have not copied these elements yet.
+   *
+   * @return a copy-on-write copy of this SedDocument object.
+   *
+   * @see clone()
+   */
+  SedDocument* cloneCopyOnWrite() const;
+#endif
+
+
   /**
    * Destructor for SedDocument.
    */
@@ -2079,12 +2133,41 @@ public:
    *
    * @return a new SedStyle based on the SedStyle in the 
    * SedListOfStyles, but changed so that any referenced styles
-   * are applied.
+   * are applied.  If there is no such style, or its base styles form a
+   * cycle, an empty SedStyle is returned.
    *
+   * @see getResolvedStyle(const std::string& sid)
    */
   SedStyle getEffectiveStyle(const std::string& sid) const;
 
 
+  /**
+   * Get the effective SedStyle from the SedDocument based on its
+   * identifier, without copying it.
+   *
+   * The effective styles are computed once and cached by this SedDocument
+   * until any of its styles is changed, added or removed; several threads
+   * may call this method at the same time, as long as none of them
+   * changes the styles.  Each cycle of "baseStyle" attributes is reported
+   * once, at one of the styles on the cycle, as a
+   * @sedmlconstant{SedmlStyleBaseStyleMustNotBeCircular, SedErrorCode_t}
+   * error in the error log of this SedDocument.  Styles whose base styles
+   * only lead into a cycle cannot be resolved either, but are not
+   * reported.
+   *
+   * @param sid a string representing the identifier of the SedStyle to
+   * retrieve.
+   *
+   * @return the SedStyle in the SedListOfStyles with all referenced styles
+   * applied, or @c NULL if there is no such style or its base styles form
+   * a cycle.  The pointer stays valid until the styles of this SedDocument
+   * are modified.
+   *
+   * @copydetails doc_returned_unowned_pointer
+   */
+  const SedStyle* getResolvedStyle(const std::string& sid) const;
+
+
   /**
    * Get a SedStyle from the SedDocument based on the BaseStyle to which it
    * refers.
@@ -2275,6 +2358,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedDocument
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedDocument
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
@@ -2636,10 +2731,182 @@ public:
    *
    * @return a pointer to the SedBase element with the given @p id. If no such
    * object is found, this method returns @c NULL.
+   *
+   * @note The first call builds a document-wide index of all ids, which is
+   * then kept up to date as elements are added, removed or renamed, so
+   * that subsequent lookups take constant time.
    */
   virtual SedBase* getElementBySId(const std::string& id);
 
 
+  /**
+   * Resolves the references between the models, simulations, tasks, data
+   * generators, outputs and data descriptions of this SedDocument.
+   *
+   * The graph is built in a single pass over the document.  It lists the
+   * references that cannot be resolved and the elements that depend on
+   * each other, and sorts all other elements into stages that can be
+   * executed one after the other.
+   *
+   * @param graph the SedDependencyGraph to fill; any previous content is
+   * replaced.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   *
+   * @see SedDependencyGraph
+   */
+  int buildDependencyGraph(SedDependencyGraph& graph) const;
+
+
+  /**
+   * Sets whether the elements of this SedDocument are allocated from a
+   * memory arena.
+   *
+   * Allocating from an arena makes creating and freeing large documents
+   * considerably faster, at the expense of memory: the memory of elements
+   * that are deleted is only released once all elements allocated from
+   * the arena, and this SedDocument, have been deleted.  Elements are
+   * allocated from the arena while they are read by a SedReader, or while
+   * a SedArenaScope for this document exists.
+   *
+   * Switching the arena off does not affect elements that have already
+   * been allocated from it.
+   *
+   * @param useArena @c true to allocate elements from an arena.
+   */
+  void setUseArena(bool useArena);
+
+
+  /**
+   * @return @c true if elements of this SedDocument are allocated from a
+   * memory arena.
+   *
+   * @see setUseArena(bool useArena)
+   */
+  bool getUseArena() const;
+
+
+  /** @cond doxygenLibSEDMLInternal */
+
+  /**
+   * @return the arena elements of this SedDocument are allocated from, or
+   * @c NULL.
+   */
+  SedArena* getArena() const;
+
+
+  /**
+   * Discards the document-wide id index; it will be rebuilt by the next
+   * call to getElementBySId().
+   */
+  void invalidateIdIndex();
+
+
+  /**
+   * Discards the document-wide id index and the id indexes of all lists
+   * contained in this SedDocument.
+   */
+  void invalidateAllIdIndexes();
+
+
+  /**
+   * Informs this SedDocument that the id of the given element changed from
+   * @p oldId, so that the document-wide id index can be updated.
+   */
+  void updateIdIndex(SedBase* element, const std::string& oldId);
+
+
+  /**
+   * Discards the effective styles cached by getResolvedStyle().
+   */
+  void invalidateEffectiveStyles();
+
+
+  /**
+   * Sets whether the elements of this SedDocument that change are
+   * recorded, for SedValidator::revalidate().  Switching tracking on or off
+   * discards the changes recorded so far.
+   */
+  void setTrackChanges(bool track);
+
+
+  /**
+   * @return @c true if the elements of this SedDocument that change are
+   * recorded.
+   */
+  bool getTrackChanges() const;
+
+
+  /**
+   * Records that the given element changed, if changes are tracked.
+   *
+   * @param element the element that changed.
+   * @param changes a combination of the values of SedBase::ChangeType.
+   */
+  void recordChange(SedBase* element, unsigned int changes);
+
+
+  /**
+   * Records that an element no longer uses the id @p oldId, if changes are
+   * tracked.
+   */
+  void recordIdChange(const std::string& oldId);
+
+
+  /**
+   * Records that the given element is deleted or removed from this
+   * SedDocument, if changes are tracked.
+   */
+  void recordRemoval(SedBase* element);
+
+
+  /**
+   * Hands over the changes recorded since the last call and clears them.
+   *
+   * @param elements the vector to which the elements that changed are
+   * appended, in no particular order; they all still belong to this
+   * SedDocument.
+   * @param oldIds the vector to which the ids that elements no longer use
+   * are appended.
+   *
+   * @return @c true if elements were added to or removed from this
+   * SedDocument.
+   */
+  bool takeChanges(std::vector<SedBase*>& elements,
+                   std::vector<std::string>& oldIds);
+
+
+  /**
+   * Sets the handler that receives the top-level elements while this
+   * SedDocument is read by SedReader; @c NULL reads the whole document.
+   */
+  void setReaderHandler(SedReaderHandler* handler);
+
+
+  /**
+   * @return the handler set by setReaderHandler(), or @c NULL.
+   */
+  SedReaderHandler* getReaderHandler() const;
+
+
+  /**
+   * Hands over the loader for the lists that have not been read yet;
+   * the lists it refers to are read from it on first access.  This
+   * SedDocument takes ownership of @p loader.
+   */
+  void setLazyListLoader(SedLazyListLoader* loader);
+
+
+  /**
+   * Reads the items of the given list from the lazy list loader.  Called
+   * by the list itself the first time its items are needed.
+   */
+  void loadLazyList(SedListOf* list);
+
+  /** @endcond */
+
+
   /**
    * Returns the value of the "Namespaces" element of this SedDocument.
    *
@@ -2732,6 +2999,18 @@ public:
   unsigned int getNumErrors(unsigned int severity) const;
 
 
+  /**
+   * Checks the references between the elements of this SedDocument and
+   * the other rules of SedValidator, and adds the failures to the error
+   * log of this SedDocument.
+   *
+   * @return the number of failures found.
+   *
+   * @see SedValidator
+   */
+  unsigned int checkConsistency();
+
+
   /**
   * Sort any SubTasks or Curves in the document according to
   * their 'order' attributes.
@@ -2767,6 +3046,18 @@ protected:
 
 
 
+  /** @cond doxygenLibSEDMLInternal */
+
+  /**
+   * Returns the list of this SedDocument with the given element name, or
+   * @c NULL if there is no such list.
+   */
+  SedListOf* getListByElementName(const std::string& name);
+
+  /** @endcond */
+
+
+
   /** @cond doxygenLibSEDMLInternal */
 
   /**
@@ -4495,6 +4786,22 @@ int
 SedDocument_hasRequiredAttributes(const SedDocument_t * sd);
 
 
+/**
+ * Checks the references between the elements of this SedDocument_t and the
+ * other rules of SedValidator, and adds the failures to the error log of
+ * this SedDocument_t.
+ *
+ * @param sd the SedDocument_t structure.
+ *
+ * @return the number of failures found.
+ *
+ * @memberof SedDocument_t
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_checkConsistency(SedDocument_t * sd);
+
+
 
 
 END_C_DECLS
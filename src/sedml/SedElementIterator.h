@@ -0,0 +1,348 @@
+/**
+ * @file SedElementIterator.h
+ * @brief Definition of the SedElementIterator and SedElementRange classes.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ *
+ * @class SedElementIterator
+ * @sbmlbrief{} Iterator over all SED-ML objects contained in an object.
+ *
+ * A SedElementIterator visits the objects below a root object depth first,
+ * in the same order as SedBase::getAllElements() lists them, including the
+ * SedListOf objects themselves.  Instead of building a List it keeps the
+ * path from the root to the current object, which for the first 32 levels
+ * is held inside the iterator itself; iterating over a document thus does
+ * not allocate any memory.
+ *
+ * The objects are found with SedBase::getNumChildElements() and
+ * SedBase::getChildElement().  The document must not be changed while it
+ * is being iterated over.
+ *
+ * The easiest way to use the iterator is through SedElementRange or
+ * forEachElement():
+ *
+ * @code{.cpp}
+for (const SedBase* element : SedElementRange<const SedBase>(doc))
+{
+  std::cout << element->getElementName() << std::endl;
+}
+
+forEachElement(doc, [&](SedBase* element) { element->unsetMetaId(); });
+ * @endcode
+ */
+
+
+#ifndef SedElementIterator_h
+#define SedElementIterator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <sedml/SedBase.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+template <class Element>
+class SedElementIterator
+{
+public:
+
+  typedef std::forward_iterator_tag iterator_category;
+  typedef Element* value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Element* const* pointer;
+  typedef Element* const& reference;
+
+
+  /**
+   * Creates the end iterator.
+   */
+  SedElementIterator ()
+    : mCurrent(NULL)
+    , mDepth(0)
+    , mInline()
+    , mOverflow()
+  {
+  }
+
+
+  /**
+   * Creates an iterator at the first object below the given root.
+   *
+   * @param root the object whose descendants are iterated over; the root
+   * itself is not visited.
+   */
+  explicit SedElementIterator (Element* root)
+    : mCurrent(root)
+    , mDepth(0)
+    , mInline()
+    , mOverflow()
+  {
+    if (mCurrent != NULL)
+    {
+      advance();
+    }
+  }
+
+
+  /**
+   * @return the current object.
+   */
+  reference operator* () const
+  {
+    return mCurrent;
+  }
+
+
+  /**
+   * Moves to the next object.
+   */
+  SedElementIterator& operator++ ()
+  {
+    advance();
+    return *this;
+  }
+
+
+  /**
+   * Moves to the next object, returning a copy of this iterator from
+   * before the move.
+   */
+  SedElementIterator operator++ (int)
+  {
+    SedElementIterator result(*this);
+    advance();
+    return result;
+  }
+
+
+  bool operator== (const SedElementIterator& rhs) const
+  {
+    return mCurrent == rhs.mCurrent;
+  }
+
+
+  bool operator!= (const SedElementIterator& rhs) const
+  {
+    return mCurrent != rhs.mCurrent;
+  }
+
+
+  /**
+   * @return the depth of the current object below the root, 1 for the
+   * objects directly contained in the root.
+   */
+  unsigned int getDepth () const
+  {
+    return mDepth;
+  }
+
+
+private:
+  /** @cond doxygenLibsedmlInternal */
+
+  struct Frame
+  {
+    Element* element;
+    unsigned int next;
+    unsigned int count;
+  };
+
+  static const unsigned int INLINE_DEPTH = 32;
+
+
+  Frame& top ()
+  {
+    return (mDepth <= INLINE_DEPTH) ? mInline[mDepth - 1] : mOverflow.back();
+  }
+
+
+  void push (Element* element, unsigned int count)
+  {
+    Frame frame = { element, 0, count };
+    if (mDepth < INLINE_DEPTH)
+    {
+      mInline[mDepth] = frame;
+    }
+    else
+    {
+      mOverflow.push_back(frame);
+    }
+    ++mDepth;
+  }
+
+
+  void pop ()
+  {
+    if (mDepth > INLINE_DEPTH)
+    {
+      mOverflow.pop_back();
+    }
+    --mDepth;
+  }
+
+
+  /*
+   * Descends into the children of the current object if it has any,
+   * otherwise moves on to the next sibling of the closest ancestor that
+   * has one left.
+   */
+  void advance ()
+  {
+    unsigned int count = mCurrent->getNumChildElements();
+    if (count > 0)
+    {
+      push(mCurrent, count);
+    }
+
+    while (mDepth > 0)
+    {
+      Frame& frame = top();
+      if (frame.next < frame.count)
+      {
+        mCurrent = const_cast<Element*>(
+          frame.element->getChildElement(frame.next++));
+        return;
+      }
+      pop();
+    }
+
+    mCurrent = NULL;
+  }
+
+
+  Element* mCurrent;
+  unsigned int mDepth;
+  Frame mInline[INLINE_DEPTH];
+  std::vector<Frame> mOverflow;
+
+  /** @endcond */
+};
+
+
+/**
+ * The SED-ML objects below a root object, for use in range-based for
+ * loops; see SedElementIterator.
+ */
+template <class Element>
+class SedElementRange
+{
+public:
+
+  typedef SedElementIterator<Element> iterator;
+
+
+  /**
+   * Creates the range of objects below the given root.
+   *
+   * @param root the object whose descendants are iterated over.
+   */
+  explicit SedElementRange (Element* root)
+    : mRoot(root)
+  {
+  }
+
+
+  iterator begin () const
+  {
+    return iterator(mRoot);
+  }
+
+
+  iterator end () const
+  {
+    return iterator();
+  }
+
+
+private:
+  /** @cond doxygenLibsedmlInternal */
+
+  Element* mRoot;
+
+  /** @endcond */
+};
+
+
+/**
+ * Calls the given function with every SED-ML object below the given root,
+ * in the order of SedElementIterator.
+ *
+ * @param root the object whose descendants are visited.
+ * @param function the function, called with a <code>SedBase*</code>.
+ */
+template <class Function>
+void
+forEachElement (SedBase* root, Function function)
+{
+  SedElementIterator<SedBase> end;
+  for (SedElementIterator<SedBase> it(root); it != end; ++it)
+  {
+    function(*it);
+  }
+}
+
+
+/**
+ * Calls the given function with every SED-ML object below the given root,
+ * in the order of SedElementIterator.
+ *
+ * @param root the object whose descendants are visited.
+ * @param function the function, called with a <code>const SedBase*</code>.
+ */
+template <class Function>
+void
+forEachElement (const SedBase* root, Function function)
+{
+  SedElementIterator<const SedBase> end;
+  for (SedElementIterator<const SedBase> it(root); it != end; ++it)
+  {
+    function(*it);
+  }
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedElementIterator_h */
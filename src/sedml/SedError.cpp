@@ -82,6 +82,54 @@ getSeverityForEntry(unsigned int index,
 }
 
 
+/*
+ * The sedmlErrorTable entry of every SED-ML error code, indexed by the code
+ * minus SedUnknown.  Codes without an entry map to 0, the entry for
+ * SedUnknown.  The array is zero-initialized, so only the pages holding the
+ * codes in use are ever written to.
+ */
+static const size_t SED_ERROR_INDEX_SIZE = SedCodesUpperBound - SedUnknown + 1;
+static unsigned short sErrorTableIndex[SED_ERROR_INDEX_SIZE];
+
+
+/*
+ * Helper for getIndexForCode(); enters the first entry of each error code
+ * of sedmlErrorTable into sErrorTableIndex.
+ */
+static bool
+fillErrorTableIndex()
+{
+  unsigned int tableSize = sizeof(sedmlErrorTable)/sizeof(sedmlErrorTable[0]);
+
+  for ( unsigned int i = tableSize; i-- > 0; )
+  {
+    unsigned int code = sedmlErrorTable[i].code;
+    if (code >= SedUnknown && code <= SedCodesUpperBound)
+    {
+      sErrorTableIndex[code - SedUnknown] = (unsigned short)i;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Helper function for SedError().  Returns the index of the sedmlErrorTable
+ * entry for the given code, or 0 (the entry for SedUnknown) if there is none.
+ */
+static unsigned int
+getIndexForCode(unsigned int code)
+{
+  // the table never changes, so the index is filled once and shared
+  static const bool filled = fillErrorTableIndex();
+  (void)filled;
+
+  if (code < SedUnknown || code > SedCodesUpperBound) return 0;
+  return sErrorTableIndex[code - SedUnknown];
+}
+
+
 /*
  * @return the severity as a string for the given @n code.
  */
@@ -177,17 +225,7 @@ SedError::SedError (  const unsigned int errorId
   else if ( mErrorId > XMLErrorCodesUpperBound
             && mErrorId < SedCodesUpperBound )
   {
-    unsigned int tableSize = sizeof(sedmlErrorTable)/sizeof(sedmlErrorTable[0]);
-    unsigned int index = 0;
-
-    for ( unsigned int i = 0; i < tableSize; i++ )
-    {
-      if ( mErrorId == sedmlErrorTable[i].code )
-      {
-        index = i;
-        break;
-      }
-    }
+    unsigned int index = getIndexForCode(mErrorId);
 
     if ( index == 0 && mErrorId != SedUnknown )
     {
@@ -213,7 +251,7 @@ SedError::SedError (  const unsigned int errorId
     mCategory     = sedmlErrorTable[index].category;
     mShortMessage = sedmlErrorTable[index].shortMessage;
 
-    ostringstream newMsg;
+    string newMsg;
     mSeverity = getSeverityForEntry(index, level, version);
 
     if (mValidError == false)
@@ -223,22 +261,23 @@ SedError::SedError (  const unsigned int errorId
     {
       mErrorId  = SedNotSchemaConformant;
       mSeverity = LIBSEDML_SEV_ERROR;
-      newMsg << sedmlErrorTable[3].message << " "; // FIXME
+      newMsg.append(sedmlErrorTable[3].message).append(" "); // FIXME
     }
     else if (mSeverity == LIBSEDML_SEV_GENERAL_WARNING)
     {
 
       mSeverity = LIBSEDML_SEV_WARNING;
-      newMsg << "[Although SED-ML Level " << level
-             << " Version " << version << " does not explicitly define the "
-             << "following as an error, other Levels and/or Versions "
-             << "of SED-ML do.] " << endl;
+      newMsg.append("[Although SED-ML Level ").append(to_string(level))
+            .append(" Version ").append(to_string(version))
+            .append(" does not explicitly define the ")
+            .append("following as an error, other Levels and/or Versions ")
+            .append("of SED-ML do.] \n");
     }
 
     // Finish updating the (full) error message.
 
-    if (!((string)sedmlErrorTable[index].message).empty()) {
-      newMsg << sedmlErrorTable[index].message << endl;
+    if (sedmlErrorTable[index].message[0] != '\0') {
+      newMsg.append(sedmlErrorTable[index].message).append("\n");
     }
 
     // look for individual references
@@ -247,7 +286,7 @@ SedError::SedError (  const unsigned int errorId
     if (sedmlErrorTable[index].reference.ref_l1v1 != NULL)
     {
 
-      std::string ref;
+      const char* ref = "";
       switch(level)
       {
       case 1:
@@ -262,19 +301,19 @@ SedError::SedError (  const unsigned int errorId
        break;
       }
 
-      if (!ref.empty())
+      if (ref[0] != '\0')
       {
-        newMsg << "Reference: " << ref << endl;
+        newMsg.append("Reference: ").append(ref).append("\n");
       }
     }
     if (!details.empty())
     {
-      newMsg << " " << details;
+      newMsg.append(" ").append(details);
       if (details[details.size()-1] != '\n') {
-        newMsg << endl;
+        newMsg.append("\n");
       }
     }      
-    mMessage  = newMsg.str();
+    mMessage.swap(newMsg);
 
     // We mucked around with the severity code and (maybe) category code
     // after creating the XMLError object, so we may have to update the
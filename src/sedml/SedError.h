@@ -415,6 +415,7 @@ typedef enum
 , SedmlStyleAllowedAttributes      = 25103
 , SedmlStyleAllowedElements      = 25104
 , SedmlStyleBaseStyleMustBeStyle      = 25105
+, SedmlStyleBaseStyleMustNotBeCircular      = 25106
 , SedmlLineAllowedCoreAttributes      = 25201
 , SedmlLineAllowedCoreElements      = 25202
 , SedmlLineAllowedAttributes      = 25203
@@ -174,7 +174,7 @@ class MatchErrorId
 public:
   MatchErrorId(const unsigned int theId) : idToFind(theId) {};
 
-  bool operator() (XMLError* e) const
+  bool operator() (const XMLError* e) const
   {
     return e->getErrorId() == idToFind;
   };
@@ -210,24 +210,13 @@ SedErrorLog::remove (const unsigned int errorId)
   }
 }
 
+/*
+ * Removes all errors having errorId from the SedError list.
+ */
 void
 SedErrorLog::removeAll (const unsigned int errorId)
 {
-  vector<XMLError*>::iterator delIter;
-
-  // finds an item with the given errorId (the first item will be found if
-  // there are two or more items with the same Id)
-  delIter = find_if(mErrors.begin(), mErrors.end(), MatchErrorId(errorId));
-
-  while ( delIter != mErrors.end() )
-  {
-    // deletes (invoke delete operator for the matched item) and erases (removes
-    // the pointer from mErrors) the matched item (if any)
-    delete *delIter;
-    mErrors.erase(delIter);
-
-    delIter = find_if(mErrors.begin(), mErrors.end(), MatchErrorId(errorId));
-  }
+  removeIf(MatchErrorId(errorId));
 }
 
 
@@ -249,6 +249,46 @@ public:
    */
   void removeAll(const unsigned int errorId);
 
+
+#ifndef SWIG
+
+  /**
+   * Removes all errors for which @p predicate returns @c true.
+   *
+   * The remaining errors keep their order.  Unlike repeated calls to
+   * remove(), this takes linear time in the number of logged errors.
+   *
+   * @param predicate a function or function object that is called with
+   * each error as <code>const XMLError*</code> and returns @c true if the
+   * error is to be removed.
+   *
+   * @return the number of errors that have been removed.
+   */
+  template <class Predicate>
+  unsigned int removeIf (Predicate predicate)
+  {
+    std::vector<XMLError*>::iterator keep = mErrors.begin();
+
+    for (std::vector<XMLError*>::iterator it = mErrors.begin();
+         it != mErrors.end(); ++it)
+    {
+      if (predicate(static_cast<const XMLError*>(*it)))
+      {
+        delete *it;
+      }
+      else
+      {
+        *keep++ = *it;
+      }
+    }
+
+    unsigned int numRemoved = (unsigned int)(mErrors.end() - keep);
+    mErrors.erase(keep, mErrors.end());
+    return numRemoved;
+  }
+
+#endif  /* !SWIG */
+
   /**
    * Returns true if SedErrorLog contains an errorId
    *
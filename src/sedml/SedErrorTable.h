@@ -4408,6 +4408,17 @@ static const sedmlErrorTableEntry sedmlErrorTable[] =
     }
   },
 
+  // 25106
+  { SedmlStyleBaseStyleMustNotBeCircular,
+    "The 'baseStyle' attributes of Style objects must not form a cycle.",
+    LIBSEDML_CAT_GENERAL_CONSISTENCY,
+    LIBSEDML_SEV_ERROR,
+    "Following the 'sedml:baseStyle' attributes from a <style> object must "
+    "not lead back to that <style> object.",
+    { "L3V1 Sedml V1 Section"
+    }
+  },
+
   // 25201
   { SedmlLineAllowedCoreAttributes,
     "Core attributes allowed on <line>.",
@@ -64,7 +64,7 @@ SedExperimentReference::SedExperimentReference(unsigned int level, unsigned int
  * Creates a new SedExperimentReference using the given SedNamespaces object @p
  * sedmlns.
  */
-SedExperimentReference::SedExperimentReference(SedNamespaces *sedmlns)
+SedExperimentReference::SedExperimentReference(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mExperimentId ("")
 {
@@ -143,6 +143,8 @@ SedExperimentReference::isSetExperimentId() const
 int
 SedExperimentReference::setExperimentId(const std::string& experimentId)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(experimentId)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -161,6 +163,8 @@ SedExperimentReference::setExperimentId(const std::string& experimentId)
 int
 SedExperimentReference::unsetExperimentId()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mExperimentId.erase();
 
   if (mExperimentId.empty() == true)
@@ -247,7 +251,11 @@ SedExperimentReference::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedExperimentReference::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -66,7 +66,7 @@ SedFigure::SedFigure(unsigned int level, unsigned int version)
 /*
  * Creates a new SedFigure using the given SedNamespaces object @p sedmlns.
  */
-SedFigure::SedFigure(SedNamespaces *sedmlns)
+SedFigure::SedFigure(const SedNamespaces *sedmlns)
   : SedOutput(sedmlns)
   , mNumRows (SEDML_INT_MAX)
   , mIsSetNumRows (false)
@@ -454,7 +454,46 @@ SedFigure::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedFigure::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedFigure
+ */
+unsigned int
+SedFigure::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mSubPlots
+  };
+
+  return SedOutput::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedFigure
+ */
+const SedBase*
+SedFigure::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedOutput::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedOutput::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mSubPlots
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
@@ -62,7 +62,7 @@ SedFill::SedFill(unsigned int level, unsigned int version)
 /*
  * Creates a new SedFill using the given SedNamespaces object @p sedmlns.
  */
-SedFill::SedFill(SedNamespaces *sedmlns)
+SedFill::SedFill(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mColor ("")
   //, mSecondColor ("")
@@ -164,6 +164,8 @@ SedFill::isSetColor() const
 int
 SedFill::setColor(const std::string& color)
 {
+  invalidateEffectiveStyles();
+
   mColor = color;
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -186,6 +188,8 @@ SedFill::setColor(const std::string& color)
 int
 SedFill::unsetColor()
 {
+  invalidateEffectiveStyles();
+
   mColor.erase();
 
   if (mColor.empty() == true)
@@ -282,7 +286,11 @@ SedFill::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream& stream)
 bool
 SedFill::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
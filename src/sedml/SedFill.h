@@ -91,7 +91,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedFill(SedNamespaces *sedmlns);
+  SedFill(const SedNamespaces *sedmlns);
 
 
   /**
@@ -67,7 +67,7 @@ SedFitExperiment::SedFitExperiment(unsigned int level, unsigned int version)
  * Creates a new SedFitExperiment using the given SedNamespaces object @p
  * sedmlns.
  */
-SedFitExperiment::SedFitExperiment(SedNamespaces *sedmlns)
+SedFitExperiment::SedFitExperiment(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mType (SEDML_EXPERIMENTTYPE_INVALID)
   , mAlgorithm (NULL)
@@ -572,7 +572,48 @@ SedFitExperiment::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedFitExperiment::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedFitExperiment
+ */
+unsigned int
+SedFitExperiment::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    mAlgorithm,
+    &mFitMappings
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 2);
+}
+
+
+/*
+ * Returns the nth child object of this SedFitExperiment
+ */
+const SedBase*
+SedFitExperiment::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    mAlgorithm,
+    &mFitMappings
+  };
+
+  return selectChildElement(children, 2, n - inherited);
 }
 
 /** @endcond */
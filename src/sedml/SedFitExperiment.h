@@ -124,7 +124,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedFitExperiment(SedNamespaces *sedmlns);
+  SedFitExperiment(const SedNamespaces *sedmlns);
 
 
   /**
@@ -608,6 +608,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedFitExperiment
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedFitExperiment
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
@@ -68,7 +68,7 @@ SedFitMapping::SedFitMapping(unsigned int level, unsigned int version)
 /*
  * Creates a new SedFitMapping using the given SedNamespaces object @p sedmlns.
  */
-SedFitMapping::SedFitMapping(SedNamespaces *sedmlns)
+SedFitMapping::SedFitMapping(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mDataSource ("")
   , mTarget ("")
@@ -256,6 +256,8 @@ SedFitMapping::isSetPointWeight() const
 int
 SedFitMapping::setDataSource(const std::string& dataSource)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(dataSource)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -274,6 +276,8 @@ SedFitMapping::setDataSource(const std::string& dataSource)
 int
 SedFitMapping::setTarget(const std::string& target)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(target)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -340,6 +344,8 @@ SedFitMapping::setWeight(double weight)
 int
 SedFitMapping::setPointWeight(const std::string& pointWeight)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(pointWeight)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -358,6 +364,8 @@ SedFitMapping::setPointWeight(const std::string& pointWeight)
 int
 SedFitMapping::unsetDataSource()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mDataSource.erase();
 
   if (mDataSource.empty() == true)
@@ -377,6 +385,8 @@ SedFitMapping::unsetDataSource()
 int
 SedFitMapping::unsetTarget()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mTarget.erase();
 
   if (mTarget.empty() == true)
@@ -427,6 +437,8 @@ SedFitMapping::unsetWeight()
 int
 SedFitMapping::unsetPointWeight()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mPointWeight.erase();
 
   if (mPointWeight.empty() == true)
@@ -538,7 +550,11 @@ SedFitMapping::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedFitMapping::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
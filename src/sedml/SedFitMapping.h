@@ -127,7 +127,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedFitMapping(SedNamespaces *sedmlns);
+  SedFitMapping(const SedNamespaces *sedmlns);
 
 
   /**
@@ -70,7 +70,7 @@ SedFunctionalRange::SedFunctionalRange(unsigned int level,
  * Creates a new SedFunctionalRange using the given SedNamespaces object @p
  * sedmlns.
  */
-SedFunctionalRange::SedFunctionalRange(SedNamespaces *sedmlns)
+SedFunctionalRange::SedFunctionalRange(const SedNamespaces *sedmlns)
   : SedRange(sedmlns)
   , mRange ("")
   , mMath (NULL)
@@ -177,6 +177,8 @@ SedFunctionalRange::isSetRange() const
 int
 SedFunctionalRange::setRange(const std::string& range)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(range)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -195,6 +197,8 @@ SedFunctionalRange::setRange(const std::string& range)
 int
 SedFunctionalRange::unsetRange()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mRange.erase();
 
   if (mRange.empty() == true)
@@ -246,6 +250,8 @@ int
 SedFunctionalRange::setMath(const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode*
   math)
 {
+  markChanged(CHANGE_CHILDREN);
+
   if (mMath == math)
   {
     return LIBSEDML_OPERATION_SUCCESS;
@@ -275,6 +281,8 @@ SedFunctionalRange::setMath(const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode*
 int
 SedFunctionalRange::unsetMath()
 {
+  markChanged(CHANGE_CHILDREN);
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -748,7 +756,48 @@ SedFunctionalRange::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedFunctionalRange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedFunctionalRange
+ */
+unsigned int
+SedFunctionalRange::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mVariables,
+    &mParameters
+  };
+
+  return SedRange::getNumChildElements() +
+    countChildElements(children, 2);
+}
+
+
+/*
+ * Returns the nth child object of this SedFunctionalRange
+ */
+const SedBase*
+SedFunctionalRange::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedRange::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedRange::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mVariables,
+    &mParameters
+  };
+
+  return selectChildElement(children, 2, n - inherited);
 }
 
 /** @endcond */
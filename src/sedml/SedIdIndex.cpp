@@ -0,0 +1,235 @@
+/**
+ * @file SedIdIndex.cpp
+ * @brief Implementation of the SedIdIndex class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedIdIndex.h>
+#include <sedml/SedBase.h>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Creates a new, invalid SedIdIndex.
+ */
+SedIdIndex::SedIdIndex ()
+  : mMap()
+  , mIsValid(false)
+  , mHasDuplicates(false)
+{
+}
+
+
+/*
+ * Copy constructor; the copy starts out invalid.
+ */
+SedIdIndex::SedIdIndex (const SedIdIndex&)
+  : mMap()
+  , mIsValid(false)
+  , mHasDuplicates(false)
+{
+}
+
+
+/*
+ * Assignment operator; this index is invalidated.
+ */
+SedIdIndex&
+SedIdIndex::operator= (const SedIdIndex& rhs)
+{
+  if (&rhs != this)
+  {
+    invalidate();
+  }
+
+  return *this;
+}
+
+
+/*
+ * Destroys this SedIdIndex.
+ */
+SedIdIndex::~SedIdIndex ()
+{
+}
+
+
+bool
+SedIdIndex::isValid () const
+{
+  return mIsValid;
+}
+
+
+void
+SedIdIndex::invalidate ()
+{
+  if (!mIsValid) return;
+
+  mMap.clear();
+  mIsValid = false;
+  mHasDuplicates = false;
+}
+
+
+void
+SedIdIndex::startBuild ()
+{
+  mMap.clear();
+  mIsValid = true;
+  mHasDuplicates = false;
+}
+
+
+void
+SedIdIndex::add (SedBase* element)
+{
+  if (!mIsValid || element == NULL) return;
+
+  const string& id = element->getId();
+  if (id.empty()) return;
+
+  // the first element in document order wins, just as with a linear search
+  if (!mMap.insert(IdMap::value_type(id, element)).second)
+  {
+    mHasDuplicates = true;
+  }
+}
+
+
+void
+SedIdIndex::insert (SedBase* element)
+{
+  if (!mIsValid || element == NULL) return;
+
+  const string& id = element->getId();
+  if (id.empty()) return;
+
+  if (mMap.find(id) != mMap.end())
+  {
+    invalidate();
+    return;
+  }
+
+  mMap[id] = element;
+}
+
+
+void
+SedIdIndex::remove (SedBase* element)
+{
+  if (!mIsValid || element == NULL) return;
+
+  const string& id = element->getId();
+  if (id.empty()) return;
+
+  // another element with the same id might have to take its place
+  if (mHasDuplicates)
+  {
+    invalidate();
+    return;
+  }
+
+  IdMap::iterator it = mMap.find(id);
+  if (it != mMap.end() && it->second == element)
+  {
+    mMap.erase(it);
+  }
+}
+
+
+void
+SedIdIndex::rename (SedBase* element, const std::string& oldId)
+{
+  if (!mIsValid || element == NULL) return;
+
+  const string& newId = element->getId();
+  if (newId == oldId) return;
+
+  if (mHasDuplicates)
+  {
+    invalidate();
+    return;
+  }
+
+  if (!oldId.empty())
+  {
+    IdMap::iterator it = mMap.find(oldId);
+    if (it != mMap.end() && it->second == element)
+    {
+      mMap.erase(it);
+    }
+  }
+
+  if (newId.empty()) return;
+
+  // we cannot tell cheaply which of the two elements comes first
+  if (mMap.find(newId) != mMap.end())
+  {
+    invalidate();
+    return;
+  }
+
+  mMap[newId] = element;
+}
+
+
+SedBase*
+SedIdIndex::get (const std::string& id) const
+{
+  IdMap::const_iterator it = mMap.find(id);
+  return (it == mMap.end()) ? NULL : it->second;
+}
+
+
+unsigned int
+SedIdIndex::size () const
+{
+  return (unsigned int)mMap.size();
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
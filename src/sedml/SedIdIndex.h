@@ -0,0 +1,184 @@
+/**
+ * @file SedIdIndex.h
+ * @brief Definition of the SedIdIndex class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedIdIndex
+ * @sbmlbrief{} Hash index from "id" attribute values to SED-ML objects.
+ *
+ * The SedIdIndex is used internally by SedListOf and SedDocument so that
+ * looking up an element by its identifier does not require a linear scan.
+ * The index is filled lazily on the first lookup and afterwards kept up to
+ * date as elements are added, removed or renamed.  Whenever an update cannot
+ * be applied cheaply (for example because several indexed elements share
+ * the same id) the index is simply invalidated and rebuilt on the next
+ * lookup, so that lookups always return the first matching element in
+ * document order, just like the linear search did.
+ */
+
+
+#ifndef SedIdIndex_h
+#define SedIdIndex_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <unordered_map>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+
+
+/** @cond doxygenLibsedmlInternal */
+class LIBSEDML_EXTERN SedIdIndex
+{
+public:
+
+  /**
+   * Creates a new, invalid (i.e. not yet built) SedIdIndex.
+   */
+  SedIdIndex ();
+
+
+  /**
+   * Copy constructor; the copy is never valid, as the indexed elements
+   * belong to the original.
+   */
+  SedIdIndex (const SedIdIndex& orig);
+
+
+  /**
+   * Assignment operator; invalidates this index, as the indexed elements
+   * belong to the original.
+   */
+  SedIdIndex& operator= (const SedIdIndex& rhs);
+
+
+  /**
+   * Destroys this SedIdIndex.
+   */
+  ~SedIdIndex ();
+
+
+  /**
+   * @return @c true if this index has been built and is up to date.
+   */
+  bool isValid () const;
+
+
+  /**
+   * Discards the content of this index; it will be rebuilt on the next
+   * lookup.
+   */
+  void invalidate ();
+
+
+  /**
+   * Clears the index and marks it as valid, so that it can be filled by
+   * successive calls to add() in document order.
+   */
+  void startBuild ();
+
+
+  /**
+   * Adds the given element under its current id, unless an earlier element
+   * already uses that id.  Elements without an id are ignored, as are
+   * calls made while this index is invalid.
+   *
+   * @param element the element to be added.
+   */
+  void add (SedBase* element);
+
+
+  /**
+   * Adds an element that has been inserted in front of already indexed
+   * elements.  If the id of the element is in use the index is invalidated,
+   * since the inserted element might now be the first match.
+   *
+   * @param element the inserted element.
+   */
+  void insert (SedBase* element);
+
+
+  /**
+   * Removes the given element from this index.
+   *
+   * @param element the element that has been removed.
+   */
+  void remove (SedBase* element);
+
+
+  /**
+   * Updates the index after the id of the given element changed.
+   *
+   * @param element the element whose id has changed.
+   * @param oldId the previous id of @p element.
+   */
+  void rename (SedBase* element, const std::string& oldId);
+
+
+  /**
+   * @return the element with the given id, or @c NULL if no such element
+   * is indexed.
+   */
+  SedBase* get (const std::string& id) const;
+
+
+  /**
+   * @return the number of ids in this index.
+   */
+  unsigned int size () const;
+
+
+private:
+
+  typedef std::unordered_map<std::string, SedBase*> IdMap;
+
+  IdMap mMap;
+  bool mIsValid;
+  bool mHasDuplicates;
+};
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedIdIndex_h */
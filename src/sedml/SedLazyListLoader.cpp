@@ -0,0 +1,427 @@
+/**
+ * @file SedLazyListLoader.cpp
+ * @brief Implementation of the SedLazyListLoader class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedLazyListLoader.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * The top-level lists that may be loaded on demand.
+ */
+static const char* LAZY_LIST_NAMES[] = {
+  "listOfAlgorithmParameters",
+  "listOfDataDescriptions",
+  "listOfModels",
+  "listOfSimulations",
+  "listOfTasks",
+  "listOfDataGenerators",
+  "listOfOutputs",
+  "listOfStyles"
+};
+
+
+static bool
+isLazyListName(const std::string& name)
+{
+  for (size_t i = 0; i < sizeof(LAZY_LIST_NAMES) / sizeof(LAZY_LIST_NAMES[0]); ++i)
+  {
+    if (name == LAZY_LIST_NAMES[i]) return true;
+  }
+  return false;
+}
+
+
+enum MarkupType
+{
+  MARKUP_INVALID,
+  MARKUP_OTHER,   // comments, CDATA sections, processing instructions, ...
+  MARKUP_START,
+  MARKUP_EMPTY,
+  MARKUP_END
+};
+
+
+/*
+ * Scans the markup starting with the '<' at position @p pos; sets @p end
+ * to the position after its closing '>' and @p name to its qualified
+ * name (for start, empty and end tags).
+ */
+static MarkupType
+scanMarkup(const std::string& s, size_t pos, size_t& end, std::string& name)
+{
+  if (s.compare(pos, 4, "<!--") == 0)
+  {
+    end = s.find("-->", pos + 4);
+    if (end == string::npos) return MARKUP_INVALID;
+    end += 3;
+    return MARKUP_OTHER;
+  }
+
+  if (s.compare(pos, 9, "<![CDATA[") == 0)
+  {
+    end = s.find("]]>", pos + 9);
+    if (end == string::npos) return MARKUP_INVALID;
+    end += 3;
+    return MARKUP_OTHER;
+  }
+
+  if (s.compare(pos, 2, "<?") == 0)
+  {
+    end = s.find("?>", pos + 2);
+    if (end == string::npos) return MARKUP_INVALID;
+    end += 2;
+    return MARKUP_OTHER;
+  }
+
+  if (s.compare(pos, 2, "<!") == 0)
+  {
+    // document type declaration, possibly with an internal subset
+    int brackets = 0;
+    char quote = 0;
+    for (end = pos + 2; end < s.size(); ++end)
+    {
+      char c = s[end];
+      if (quote != 0)
+      {
+        if (c == quote) quote = 0;
+      }
+      else if (c == '"' || c == '\'') quote = c;
+      else if (c == '[') ++brackets;
+      else if (c == ']') --brackets;
+      else if (c == '>' && brackets <= 0)
+      {
+        ++end;
+        return MARKUP_OTHER;
+      }
+    }
+    return MARKUP_INVALID;
+  }
+
+  bool isEnd = (s.compare(pos, 2, "</") == 0);
+  size_t nameStart = pos + (isEnd ? 2 : 1);
+  size_t nameEnd = s.find_first_of(" \t\r\n/>", nameStart);
+  if (nameEnd == string::npos || nameEnd == nameStart) return MARKUP_INVALID;
+  name = s.substr(nameStart, nameEnd - nameStart);
+
+  // skip the attributes, which may contain '>' in quoted values
+  char quote = 0;
+  for (end = nameEnd; end < s.size(); ++end)
+  {
+    char c = s[end];
+    if (quote != 0)
+    {
+      if (c == quote) quote = 0;
+    }
+    else if (c == '"' || c == '\'') quote = c;
+    else if (c == '>')
+    {
+      bool isEmpty = (s[end - 1] == '/');
+      ++end;
+      if (isEnd) return MARKUP_END;
+      return isEmpty ? MARKUP_EMPTY : MARKUP_START;
+    }
+  }
+
+  return MARKUP_INVALID;
+}
+
+
+/*
+ * Returns the FNV-1a hash of the given bytes, which extract() uses to
+ * detect sections of a file that changed after it was scanned.
+ */
+static uint64_t
+computeChecksum(const char* data, size_t length)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < length; ++i)
+  {
+    hash ^= (unsigned char)data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+
+static std::string
+getLocalName(const std::string& name)
+{
+  size_t colon = name.find(':');
+  return (colon == string::npos) ? name : name.substr(colon + 1);
+}
+
+
+/*
+ * Creates a new, empty SedLazyListLoader.
+ */
+SedLazyListLoader::SedLazyListLoader ()
+  : mSections()
+  , mFilename()
+  , mHeader()
+  , mRootName()
+  , mHeaderLines(0)
+{
+}
+
+
+/*
+ * Destroys this SedLazyListLoader.
+ */
+SedLazyListLoader::~SedLazyListLoader ()
+{
+}
+
+
+bool
+SedLazyListLoader::scan (const std::string& content,
+                         const std::string& filename)
+{
+  mSections.clear();
+  mFilename = filename;
+
+  // find the root element
+  size_t pos = 0;
+  size_t end = 0;
+  std::string name;
+  MarkupType type = MARKUP_OTHER;
+
+  while (type == MARKUP_OTHER)
+  {
+    pos = content.find('<', pos);
+    if (pos == string::npos) return false;
+
+    type = scanMarkup(content, pos, end, name);
+    pos = end;
+  }
+
+  if (type != MARKUP_START) return false;
+
+  mRootName = name;
+  mHeader = content.substr(0, end);
+  mHeaderLines = (unsigned int)std::count(mHeader.begin(), mHeader.end(), '\n');
+
+  // walk over the children of the root element
+  unsigned int line = mHeaderLines + 1;
+  size_t lineStart = mHeader.rfind('\n');
+  lineStart = (lineStart == string::npos) ? 0 : lineStart + 1;
+  size_t counted = end;
+
+  for (;;)
+  {
+    pos = content.find('<', pos);
+    if (pos == string::npos) return false;
+
+    type = scanMarkup(content, pos, end, name);
+    if (type == MARKUP_INVALID) return false;
+    if (type == MARKUP_END) break;
+    if (type == MARKUP_OTHER)
+    {
+      pos = end;
+      continue;
+    }
+
+    Section section;
+    section.name = getLocalName(name);
+    section.begin = pos;
+
+    int depth = (type == MARKUP_START) ? 1 : 0;
+    while (depth > 0)
+    {
+      size_t next = content.find('<', end);
+      if (next == string::npos) return false;
+
+      type = scanMarkup(content, next, end, name);
+      if (type == MARKUP_INVALID) return false;
+      if (type == MARKUP_START) ++depth;
+      if (type == MARKUP_END) --depth;
+    }
+
+    section.end = end;
+    pos = end;
+
+    if (!isLazyListName(section.name)) continue;
+
+    for (size_t i = 0; i < mSections.size(); ++i)
+    {
+      // the reader has to report repeated lists
+      if (mSections[i].name == section.name) return false;
+    }
+
+    for (; counted < section.begin; ++counted)
+    {
+      if (content[counted] == '\n')
+      {
+        ++line;
+        lineStart = counted + 1;
+      }
+    }
+
+    section.line = line;
+    section.column = (unsigned int)(section.begin - lineStart) + 1;
+
+    if (mFilename.empty())
+    {
+      section.text = content.substr(section.begin, section.end - section.begin);
+      section.checksum = 0;
+    }
+    else
+    {
+      section.checksum = computeChecksum(content.data() + section.begin,
+                                         section.end - section.begin);
+    }
+
+    mSections.push_back(section);
+  }
+
+  return !mSections.empty();
+}
+
+
+std::string
+SedLazyListLoader::getRemainingContent (const std::string& content) const
+{
+  std::string result;
+  result.reserve(content.size());
+
+  size_t pos = 0;
+  for (size_t i = 0; i < mSections.size(); ++i)
+  {
+    const Section& section = mSections[i];
+    result.append(content, pos, section.begin - pos);
+    result.append(std::count(content.begin() + (long)section.begin,
+                             content.begin() + (long)section.end, '\n'), '\n');
+    pos = section.end;
+  }
+  result.append(content, pos, string::npos);
+
+  return result;
+}
+
+
+unsigned int
+SedLazyListLoader::getNumLists () const
+{
+  return (unsigned int)mSections.size();
+}
+
+
+const std::string&
+SedLazyListLoader::getListName (unsigned int n) const
+{
+  return mSections.at(n).name;
+}
+
+
+bool
+SedLazyListLoader::extract (const std::string& name, std::string& document)
+{
+  std::vector<Section>::iterator it = mSections.begin();
+  while (it != mSections.end() && it->name != name) ++it;
+  if (it == mSections.end()) return false;
+
+  std::string text;
+  if (mFilename.empty())
+  {
+    text.swap(it->text);
+  }
+  else
+  {
+    // the file may have been changed or removed since it was scanned; the
+    // list is forgotten in that case, as it cannot be read any more
+    std::ifstream file(mFilename.c_str(), std::ios::in | std::ios::binary);
+    text.resize(it->end - it->begin);
+    file.seekg((std::streamoff)it->begin);
+    if (!file || !file.read(&text[0], (std::streamsize)text.size()) ||
+        computeChecksum(text.data(), text.size()) != it->checksum)
+    {
+      mSections.erase(it);
+      return false;
+    }
+  }
+
+  // pad the list, so that it starts at its original line and column
+  document = mHeader;
+  document.append(it->line - 1 - mHeaderLines, '\n');
+  document.append(it->column - 1, ' ');
+  document += text;
+  document += "</" + mRootName + ">";
+
+  mSections.erase(it);
+  return true;
+}
+
+
+bool
+SedLazyListLoader::readFile (const std::string& filename, std::string& content)
+{
+  // compressed files are left to the XML parser
+  std::string::size_type dot = filename.rfind('.');
+  if (dot != std::string::npos)
+  {
+    std::string extension = filename.substr(dot);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (extension == ".gz" || extension == ".zip" || extension == ".bz2")
+      return false;
+  }
+
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file) return false;
+
+  std::ostringstream stream;
+  stream << file.rdbuf();
+  content = stream.str();
+  return true;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,174 @@
+/**
+ * @file SedLazyListLoader.h
+ * @brief Definition of the SedLazyListLoader class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedLazyListLoader
+ * @sbmlbrief{} Keeps track of the top-level lists of a SED-ML document that
+ * have not been read yet.
+ *
+ * The SedLazyListLoader is used internally when SedReader is asked to load
+ * lists on demand (see SedReader::setLazyListLoading()).  Before the
+ * document is parsed, scan() locates the byte ranges of the top-level
+ * <code>listOf*</code> elements in the raw XML.  The document is then
+ * parsed without these sections, and each of them is only parsed once the
+ * corresponding list is first accessed, using extract() to obtain a
+ * standalone document that contains just that list.  Line and column
+ * numbers are preserved in both cases, so that errors are reported at
+ * their original position.
+ */
+
+
+#ifndef SedLazyListLoader_h
+#define SedLazyListLoader_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/** @cond doxygenLibsedmlInternal */
+class LIBSEDML_EXTERN SedLazyListLoader
+{
+public:
+
+  /**
+   * Creates a new, empty SedLazyListLoader.
+   */
+  SedLazyListLoader ();
+
+
+  /**
+   * Destroys this SedLazyListLoader.
+   */
+  ~SedLazyListLoader ();
+
+
+  /**
+   * Locates the top-level lists of the SED-ML document in @p content.
+   *
+   * @param content the XML of the document.
+   * @param filename the file @p content has been read from, from which the
+   * sections will be read again once they are needed; if empty, the
+   * sections are copied from @p content instead.  Only the position and a
+   * checksum of each section are kept for files, so that extract() can
+   * tell whether the file has changed in the meantime.
+   *
+   * @return @c true if at least one list can be loaded lazily, @c false if
+   * the document has to be read eagerly (for instance because it is not
+   * well-formed, or a list occurs more than once).
+   */
+  bool scan (const std::string& content, const std::string& filename = "");
+
+
+  /**
+   * @return a copy of @p content (as passed to scan()) in which all lazily
+   * loaded lists have been blanked out; only their line breaks are kept.
+   */
+  std::string getRemainingContent (const std::string& content) const;
+
+
+  /**
+   * @return the number of lists that have not been loaded yet.
+   */
+  unsigned int getNumLists () const;
+
+
+  /**
+   * @return the element name of the nth list that has not been loaded yet.
+   */
+  const std::string& getListName (unsigned int n) const;
+
+
+  /**
+   * Builds a standalone document containing only the list with the given
+   * element name, and forgets about that list.
+   *
+   * @param name the element name of the list, e.g. "listOfOutputs".
+   * @param document string that receives the document.
+   *
+   * @return @c true if the list was found and could be read, @c false if
+   * it is unknown, or if the file it is read from cannot be read any more
+   * or has changed since scan(); the list is forgotten in either case.
+   */
+  bool extract (const std::string& name, std::string& document);
+
+
+  /**
+   * Reads the file with the given name into @p content.
+   *
+   * @return @c true on success, @c false if the file cannot be read or is
+   * compressed.
+   */
+  static bool readFile (const std::string& filename, std::string& content);
+
+
+private:
+
+  SedLazyListLoader (const SedLazyListLoader& orig);
+  SedLazyListLoader& operator= (const SedLazyListLoader& rhs);
+
+  struct Section
+  {
+    std::string name;
+    size_t begin;
+    size_t end;
+    unsigned int line;
+    unsigned int column;
+    std::string text;
+    uint64_t checksum;
+  };
+
+  std::vector<Section> mSections;
+  std::string mFilename;
+  std::string mHeader;
+  std::string mRootName;
+  unsigned int mHeaderLines;
+};
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedLazyListLoader_h */
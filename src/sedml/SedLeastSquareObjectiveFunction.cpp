@@ -66,8 +66,8 @@ SedLeastSquareObjectiveFunction::SedLeastSquareObjectiveFunction(
  * Creates a new SedLeastSquareObjectiveFunction using the given SedNamespaces
  * object @p sedmlns.
  */
-SedLeastSquareObjectiveFunction::SedLeastSquareObjectiveFunction(SedNamespaces
-  *sedmlns)
+SedLeastSquareObjectiveFunction::SedLeastSquareObjectiveFunction(const
+  SedNamespaces *sedmlns)
   : SedObjective(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -179,7 +179,11 @@ SedLeastSquareObjectiveFunction::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedLeastSquareObjectiveFunction::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -88,7 +88,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedLeastSquareObjectiveFunction(SedNamespaces *sedmlns);
+  SedLeastSquareObjectiveFunction(const SedNamespaces *sedmlns);
 
 
   /**
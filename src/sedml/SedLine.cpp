@@ -64,7 +64,7 @@ SedLine::SedLine(unsigned int level, unsigned int version)
 /*
  * Creates a new SedLine using the given SedNamespaces object @p sedmlns.
  */
-SedLine::SedLine(SedNamespaces *sedmlns)
+SedLine::SedLine(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mType (SEDML_LINETYPE_INVALID)
   , mColor ("")
@@ -202,6 +202,8 @@ SedLine::isSetThickness() const
 int
 SedLine::setType(const LineType_t type)
 {
+  invalidateEffectiveStyles();
+
   if (LineType_isValid(type) == 0)
   {
     mType = SEDML_LINETYPE_INVALID;
@@ -221,6 +223,8 @@ SedLine::setType(const LineType_t type)
 int
 SedLine::setType(const std::string& type)
 {
+  invalidateEffectiveStyles();
+
   mType = LineType_fromString(type.c_str());
 
   if (mType == SEDML_LINETYPE_INVALID)
@@ -238,6 +242,8 @@ SedLine::setType(const std::string& type)
 int
 SedLine::setColor(const std::string& color)
 {
+  invalidateEffectiveStyles();
+
   mColor = color;
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -249,6 +255,8 @@ SedLine::setColor(const std::string& color)
 int
 SedLine::setThickness(double thickness)
 {
+  invalidateEffectiveStyles();
+
   mThickness = thickness;
   mIsSetThickness = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -261,6 +269,8 @@ SedLine::setThickness(double thickness)
 int
 SedLine::unsetType()
 {
+  invalidateEffectiveStyles();
+
   mType = SEDML_LINETYPE_INVALID;
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -272,6 +282,8 @@ SedLine::unsetType()
 int
 SedLine::unsetColor()
 {
+  invalidateEffectiveStyles();
+
   mColor.erase();
 
   if (mColor.empty() == true)
@@ -291,6 +303,8 @@ SedLine::unsetColor()
 int
 SedLine::unsetThickness()
 {
+  invalidateEffectiveStyles();
+
   mThickness = util_NaN();
   mIsSetThickness = false;
 
@@ -364,7 +378,11 @@ SedLine::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream& stream)
 bool
 SedLine::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
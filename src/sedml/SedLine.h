@@ -127,7 +127,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedLine(SedNamespaces *sedmlns);
+  SedLine(const SedNamespaces *sedmlns);
 
 
   /**
@@ -35,9 +35,12 @@
 
 #include <algorithm>
 #include <functional>
+#include <mutex>
 
 #include <sedml/SedVisitor.h>
 #include <sedml/SedListOf.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedArena.h>
 #include <sedml/common/common.h>
 
 /** @cond doxygenIgnored */
@@ -49,11 +52,86 @@ using namespace std;
 LIBSEDML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
+/** @cond doxygenLibsedmlInternal */
+
+static thread_local bool sShareItems = false;
+
+
+/*
+ * Guards reading and copying the items of lists on first access, see
+ * SedListOf::loadLazyItems().  Never destroyed, as lists may still be
+ * destroyed by the destructors of other static objects.
+ */
+static recursive_mutex&
+getLazyItemsMutex()
+{
+  static recursive_mutex* lazyItemsMutex = new recursive_mutex();
+  return *lazyItemsMutex;
+}
+
+
+/*
+ * The items shared by a list and the copies made of it while a
+ * SedSharedItemsScope existed.  While mOwner is set these are the items of
+ * that list, which keeps them connected to itself; otherwise the store
+ * owns them, and they belong to no parent or document.  Either way they
+ * are not modified while they are shared.
+ */
+struct SedSharedListItems
+{
+  SedSharedListItems()
+    : mItems()
+    , mOwner(NULL)
+  {
+  }
+
+  ~SedSharedListItems()
+  {
+    if (mOwner != NULL) return;
+
+    for (vector<SedBase*>::iterator it = mItems.begin();
+         it != mItems.end(); ++it)
+    {
+      delete *it;
+    }
+  }
+
+  vector<SedBase*> mItems;
+  const SedListOf* mOwner;
+};
+
+
+SedSharedItemsScope::SedSharedItemsScope ()
+  : mPrevious(sShareItems)
+{
+  sShareItems = true;
+}
+
+
+SedSharedItemsScope::~SedSharedItemsScope ()
+{
+  sShareItems = mPrevious;
+}
+
+
+bool
+SedSharedItemsScope::isActive ()
+{
+  return sShareItems;
+}
+
+/** @endcond */
+
+
 /*
  * Creates a new SedListOf items.
  */
 SedListOf::SedListOf (unsigned int level, unsigned int version)
 : SedBase(level,version)
+, mHasLazyItems(false)
+, mLoadingItems(false)
+, mSharedItems()
+, mLendsItems(false)
 {
     if (!hasValidLevelVersionNamespaceCombination())
     throw SedConstructorException();
@@ -63,14 +141,41 @@ SedListOf::SedListOf (unsigned int level, unsigned int version)
 /*
  * Creates a new SedListOf items.
  */
-SedListOf::SedListOf (SedNamespaces* sedmlns)
+SedListOf::SedListOf (const SedNamespaces *sedmlns)
 : SedBase(sedmlns)
+, mHasLazyItems(false)
+, mLoadingItems(false)
+, mSharedItems()
+, mLendsItems(false)
 {
     if (!hasValidLevelVersionNamespaceCombination())
     throw SedConstructorException();
 }
 
 
+/**
+ * Used by SedListOf::setSedDocument().
+ */
+struct SetSedDocument
+{
+  SedDocument* d;
+
+  SetSedDocument (SedDocument* d) : d(d) { }
+  void operator() (SedBase* sbase) { sbase->setSedDocument(d); }
+};
+
+
+/**
+ * Used by SedListOf::setParentSedObject().
+ */
+struct SetParentSedObject
+{
+  SedBase* sb;
+
+  SetParentSedObject (SedBase *sb) : sb(sb) { }
+  void operator() (SedBase* sbase) { sbase->connectToParent(sb); }
+};
+
 /**
  * Used by the Destructor to delete each item in mItems.
  */
@@ -85,6 +190,12 @@ struct Delete
  */
 SedListOf::~SedListOf ()
 {
+  if (mLendsItems)
+  {
+    lock_guard<recursive_mutex> lock(getLazyItemsMutex());
+    stopLendingItems(true);
+  }
+
   for_each( mItems.begin(), mItems.end(), Delete() );
 }
 
@@ -99,12 +210,28 @@ struct Clone
 
 
 /*
- * Copy constructor. Creates a copy of this SedListOf items.
+ * Copy constructor. Creates a copy of this SedListOf items, or one that
+ * shares them while a SedSharedItemsScope exists.
  */
-SedListOf::SedListOf (const SedListOf& orig) : SedBase(orig), mItems()
+SedListOf::SedListOf (const SedListOf& orig)
+  : SedBase(orig)
+  , mItems()
+  , mHasLazyItems(false)
+  , mLoadingItems(false)
+  , mSharedItems()
+  , mLendsItems(false)
 {
-  mItems.resize( orig.size() );
-  transform( orig.mItems.begin(), orig.mItems.end(), mItems.begin(), Clone() );
+  if (sShareItems)
+  {
+    // the items are cloned from the store on first access
+    mSharedItems = orig.lendItems();
+    mHasLazyItems = (mSharedItems != NULL);
+    return;
+  }
+
+  const ListItem& items = orig.getReadableItems();
+  mItems.resize( items.size() );
+  transform( items.begin(), items.end(), mItems.begin(), Clone() );
   connectToChild();
 }
 
@@ -117,10 +244,19 @@ SedListOf& SedListOf::operator=(const SedListOf& rhs)
   if(&rhs!=this)
   {
     this->SedBase::operator =(rhs);
+    invalidateIdIndexes();
+    {
+      // the items are replaced, so there is no need to read them
+      lock_guard<recursive_mutex> lock(getLazyItemsMutex());
+      if (mLendsItems) stopLendingItems(true);
+      mSharedItems.reset();
+      mHasLazyItems = false;
+    }
     // Deletes existing items
     for_each( mItems.begin(), mItems.end(), Delete() );
-    mItems.resize( rhs.size() );
-    transform( rhs.mItems.begin(), rhs.mItems.end(), mItems.begin(), Clone() );
+    const ListItem& items = rhs.getReadableItems();
+    mItems.resize( items.size() );
+    transform( items.begin(), items.end(), mItems.begin(), Clone() );
     connectToChild();
   }
 
@@ -131,8 +267,12 @@ SedListOf& SedListOf::operator=(const SedListOf& rhs)
 bool
 SedListOf::accept (SedVisitor& v) const
 {
+  const ListItem& items = getReadableItems();
   v.visit(*this, getItemTypeCode() );
-  for (unsigned int n = 0 ; n < mItems.size() && mItems[n]->accept(v); ++n) ;
+  for (unsigned int n = 0 ; n < items.size(); ++n)
+  {
+    items[n]->accept(v);
+  }
   v.leave(*this, getItemTypeCode() );
 
   return true;
@@ -140,6 +280,20 @@ SedListOf::accept (SedVisitor& v) const
 /** @endcond */
 
 
+unsigned int
+SedListOf::getNumChildElements () const
+{
+  return size();
+}
+
+
+const SedBase*
+SedListOf::getChildElement (unsigned int n) const
+{
+  return get(n);
+}
+
+
 /*
  * @return a (deep) copy of this SedListOf items.
  */
@@ -168,10 +322,13 @@ SedListOf::insert(int location, const SedBase* item)
 int 
 SedListOf::insertAndOwn(int location, SedBase* item)
 {
+  loadLazyItems();
+
   /* no list elements yet */
   if (this->getItemTypeCode() == SEDML_UNKNOWN )
   {
     mItems.insert( mItems.begin() + location, item );
+    mIdIndex.insert(item);
     item->connectToParent(this);
     return LIBSEDML_OPERATION_SUCCESS;
   }
@@ -182,6 +339,7 @@ SedListOf::insertAndOwn(int location, SedBase* item)
   else
   {
     mItems.insert( mItems.begin() + location, item );
+    mIdIndex.insert(item);
     item->connectToParent(this);
     return LIBSEDML_OPERATION_SUCCESS;
   }
@@ -212,10 +370,13 @@ SedListOf::append (const SedBase* item)
 int
 SedListOf::appendAndOwn (SedBase* item)
 {
+  loadLazyItems();
+
   /* no list elements yet */
   if (this->getItemTypeCode() == SEDML_UNKNOWN )
   {
     mItems.push_back( item );
+    mIdIndex.add(item);
     item->connectToParent(this);
     return LIBSEDML_OPERATION_SUCCESS;
   }
@@ -226,6 +387,7 @@ SedListOf::appendAndOwn (SedBase* item)
   else
   {
     mItems.push_back( item );
+    mIdIndex.add(item);
     item->connectToParent(this);
     return LIBSEDML_OPERATION_SUCCESS;
   }
@@ -256,7 +418,8 @@ int SedListOf::appendFrom(const SedListOf* list)
 const SedBase*
 SedListOf::get (unsigned int n) const
 {
-  return (n < mItems.size()) ? mItems[n] : NULL;
+  const ListItem& items = getReadableItems();
+  return (n < items.size()) ? items[n] : NULL;
 }
 
 
@@ -266,6 +429,7 @@ SedListOf::get (unsigned int n) const
 SedBase*
 SedListOf::get (unsigned int n)
 {
+  loadLazyItems();
   return const_cast<SedBase*>( static_cast<const SedListOf&>(*this).get(n) );
 }
 
@@ -274,16 +438,14 @@ SedBase*
 SedListOf::getElementBySId(const std::string& id)
 {
   if (id.empty()) return NULL;
+
+  loadLazyItems();
+  SedBase* item = getItemById(id);
+  if (item != NULL) return item;
   
   for (unsigned int i = 0; i < size(); i++)
   {
-    SedBase* obj = get(i);
-    if (obj->getId() == id)
-    {
-      return obj;
-    }
-    
-    obj = obj->getElementBySId(id);
+    SedBase* obj = get(i)->getElementBySId(id);
     
     if (obj != NULL) return obj;
   }
@@ -346,8 +508,19 @@ SedListOf::getAllElements(SedElementFilter* filter)
 void
 SedListOf::clear (bool doDelete)
 {
+  invalidateIdIndexes();
+  {
+    // items kept by the caller may be modified, so copies get their own
+    lock_guard<recursive_mutex> lock(getLazyItemsMutex());
+    if (mLendsItems) stopLendingItems(doDelete);
+    mSharedItems.reset();
+    mHasLazyItems = false;
+  }
+
   if (doDelete)
     for_each( mItems.begin(), mItems.end(), Delete() );
+  else
+    for_each( mItems.begin(), mItems.end(), SetParentSedObject(NULL) );
   
   mItems.clear();
 }
@@ -372,7 +545,18 @@ SedListOf::remove (unsigned int n)
 {
   SedBase* item = get(n);
   
-  if (item != NULL) mItems.erase( mItems.begin() + n );
+  if (item != NULL)
+  {
+    SedDocument* doc = getSedDocument();
+    if (doc != NULL) doc->invalidateIdIndex();
+
+    mIdIndex.remove(item);
+    mItems.erase( mItems.begin() + n );
+
+    // the removed item is owned by the caller now, and may well outlive
+    // the document it used to belong to
+    item->connectToParent(NULL);
+  }
   
   return item;
 }
@@ -384,33 +568,10 @@ SedListOf::remove (unsigned int n)
 unsigned int
 SedListOf::size () const
 {
-  return (unsigned int)mItems.size();
+  return (unsigned int)getReadableItems().size();
 }
 
 
-/**
- * Used by SedListOf::setSedDocument().
- */
-struct SetSedDocument
-{
-  SedDocument* d;
-
-  SetSedDocument (SedDocument* d) : d(d) { }
-  void operator() (SedBase* sbase) { sbase->setSedDocument(d); }
-};
-
-
-/**
- * Used by SedListOf::setParentSedObject().
- */
-struct SetParentSedObject
-{
-  SedBase* sb;
-
-  SetParentSedObject (SedBase *sb) : sb(sb) { }
-  void operator() (SedBase* sbase) { sbase->connectToParent(sb); }
-};
-
 /** @cond doxygenLibsedmlInternal */
 
 /*
@@ -435,6 +596,16 @@ SedListOf::connectToChild()
   for_each( mItems.begin(), mItems.end(), SetParentSedObject(this) );
 }
 
+
+/*
+ * Updates the id index after the id of the given item changed.
+ */
+void
+SedListOf::updateIdIndex(SedBase* item, const std::string& oldId)
+{
+  mIdIndex.rename(item, oldId);
+}
+
 /** @endcond */
 
 
@@ -494,7 +665,8 @@ void
 SedListOf::writeElements (XMLOutputStream& stream) const
 {
   SedBase::writeElements(stream);
-  for_each( mItems.begin(), mItems.end(), Write(stream) );
+  const ListItem& items = getReadableItems();
+  for_each( items.begin(), items.end(), Write(stream) );
 }
 /** @endcond */
 
@@ -545,6 +717,225 @@ SedListOf::isValidTypeForList(SedBase * item)
 
   return match;
 }
+
+
+/*
+ * Returns the item with the given id, building the id index if need be.
+ */
+SedBase*
+SedListOf::getItemById(const std::string& sid) const
+{
+  if (sid.empty()) return NULL;
+
+  getReadableItems();
+
+  if (!mIdIndex.isValid())
+  {
+    mIdIndex.startBuild();
+    for (ListItem::const_iterator it = mItems.begin(); it != mItems.end(); ++it)
+    {
+      mIdIndex.add(*it);
+    }
+  }
+
+  return mIdIndex.get(sid);
+}
+
+
+/*
+ * Removes the item with the given id and returns it.
+ */
+SedBase*
+SedListOf::removeItemById(const std::string& sid)
+{
+  loadLazyItems();
+
+  SedBase* item = getItemById(sid);
+
+  if (item == NULL) return NULL;
+
+  ListItemIter it = find(mItems.begin(), mItems.end(), item);
+
+  return remove((unsigned int)(it - mItems.begin()));
+}
+
+
+/*
+ * Discards the id index of this list and of the enclosing document.
+ */
+void
+SedListOf::invalidateIdIndexes()
+{
+  mIdIndex.invalidate();
+
+  SedDocument* doc = getSedDocument();
+  if (doc != NULL) doc->invalidateIdIndex();
+  if (doc != NULL && getItemTypeCode() == SEDML_STYLE)
+  {
+    doc->invalidateEffectiveStyles();
+  }
+}
+
+
+void
+SedListOf::setHasLazyItems(bool hasLazyItems)
+{
+  mHasLazyItems = hasLazyItems;
+}
+
+
+bool
+SedListOf::getHasLazyItems() const
+{
+  return mHasLazyItems;
+}
+
+
+bool
+SedListOf::getSharesItems() const
+{
+  lock_guard<recursive_mutex> lock(getLazyItemsMutex());
+  return mSharedItems != NULL;
+}
+
+
+/*
+ * Copies the items from the store this list was copied from, asks the
+ * document to read them, or lets the store have copies of the items of
+ * this list, if any of that is still pending.  Const methods of a list may
+ * be called from several threads at once, so the first of them does the
+ * work while the others wait for it.  One lock is shared by all lists, as
+ * lists of the same document allocate from the same arena and read from
+ * the same loader, and copies read the items of their original; it is
+ * recursive, as reading the items calls back into the list.
+ */
+void
+SedListOf::loadLazyItems() const
+{
+  if (!mHasLazyItems && !mLendsItems) return;
+
+  lock_guard<recursive_mutex> lock(getLazyItemsMutex());
+  if (mLoadingItems) return;
+
+  SedListOf* self = const_cast<SedListOf*>(this);
+  mLoadingItems = true;
+
+  if (mLendsItems)
+  {
+    self->stopLendingItems(false);
+  }
+  else if (mHasLazyItems && mSharedItems != NULL)
+  {
+    self->copySharedItems();
+  }
+  else if (mHasLazyItems)
+  {
+    SedDocument* doc = self->getSedDocument();
+    if (doc != NULL) doc->loadLazyList(self);
+  }
+
+  mLoadingItems = false;
+  mHasLazyItems = false;
+}
+
+
+const SedListOf::ListItem&
+SedListOf::getReadableItems() const
+{
+  // a list lending its items to copies can still read them
+  if (mHasLazyItems) loadLazyItems();
+  return mItems;
+}
+
+
+shared_ptr<SedSharedListItems>
+SedListOf::lendItems() const
+{
+  lock_guard<recursive_mutex> lock(getLazyItemsMutex());
+
+  // a list that still shares the items of its original passes that on
+  if (mSharedItems != NULL) return mSharedItems;
+
+  getReadableItems();
+  if (mItems.empty()) return mSharedItems;
+
+  mSharedItems.reset(new SedSharedListItems());
+  mSharedItems->mItems = mItems;
+  mSharedItems->mOwner = this;
+  mLendsItems = true;
+  return mSharedItems;
+}
+
+
+/*
+ * Clones the items of the store into this list; their own lists share
+ * their items in turn, so only the path to the accessed element is copied.
+ * The lock of loadLazyItems() has to be held.
+ */
+void
+SedListOf::copySharedItems()
+{
+  shared_ptr<SedSharedListItems> shared;
+  shared.swap(mSharedItems);
+  if (shared == NULL) return;
+
+  SedArenaScope arena(getSedDocument());
+  SedSharedItemsScope share;
+
+  mItems.reserve(shared->mItems.size());
+  for (ListItem::const_iterator it = shared->mItems.begin();
+       it != shared->mItems.end(); ++it)
+  {
+    SedBase* item = (*it)->clone();
+    mItems.push_back(item);
+    item->connectToParent(this);
+  }
+
+  mIdIndex.invalidate();
+}
+
+
+/*
+ * The lock of loadLazyItems() has to be held.  Copies of this list only
+ * ever clone the items of the store, so the store can take over the items
+ * of this list without them noticing.
+ */
+void
+SedListOf::stopLendingItems(bool discardItems)
+{
+  shared_ptr<SedSharedListItems> shared;
+  shared.swap(mSharedItems);
+  mLendsItems = false;
+
+  // references are only added under the lock, so a count of one means that
+  // no copy refers to the store any more
+  if (shared == NULL || shared.use_count() == 1) return;
+
+  if (discardItems)
+  {
+    for (ListItem::iterator it = mItems.begin(); it != mItems.end(); ++it)
+    {
+      (*it)->connectToParent(NULL);
+    }
+    mItems.clear();
+    mIdIndex.invalidate();
+  }
+  else
+  {
+    // the copies are allocated from the heap, as they may outlive the
+    // document of this list
+    SedArenaScope arena(NULL);
+    SedSharedItemsScope share;
+
+    for (ListItem::iterator it = shared->mItems.begin();
+         it != shared->mItems.end(); ++it)
+    {
+      *it = (*it)->clone();
+    }
+  }
+
+  shared->mOwner = NULL;
+}
 /** @endcond */
 
 
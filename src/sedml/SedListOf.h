@@ -51,13 +51,20 @@
 #include <vector>
 #include <algorithm>
 #include <functional>
+#include <memory>
+#include <atomic>
 
 #include <sedml/SedBase.h>
+#include <sedml/SedIdIndex.h>
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
 class SedVisitor;
 
+/** @cond doxygenLibsedmlInternal */
+struct SedSharedListItems;
+/** @endcond */
+
 
 /** @cond doxygenLibsedmlInternal */
 /**
@@ -77,6 +84,50 @@ struct SedIdEq
 /** @endcond */
 
 
+/** @cond doxygenLibsedmlInternal */
+/**
+ * While a SedSharedItemsScope exists, lists that are copied on the same
+ * thread do not clone their items.  Instead the copy refers to a reference
+ * counted store holding the items of the original list, and clones them
+ * on first access.  The original keeps its items, and only lets the store
+ * have copies of its own before it changes them.  Used by
+ * SedDocument::cloneCopyOnWrite().
+ */
+#ifndef SWIG
+class LIBSEDML_EXTERN SedSharedItemsScope
+{
+public:
+
+  /**
+   * Makes lists share their items when copied on the calling thread.
+   */
+  SedSharedItemsScope ();
+
+
+  /**
+   * Restores the previous behaviour of copying lists.
+   */
+  ~SedSharedItemsScope ();
+
+
+  /**
+   * @return @c true if lists copied on the calling thread share their
+   * items.
+   */
+  static bool isActive ();
+
+
+private:
+
+  bool mPrevious;
+
+  SedSharedItemsScope (const SedSharedItemsScope& orig);
+  SedSharedItemsScope& operator= (const SedSharedItemsScope& rhs);
+};
+#endif /* SWIG */
+/** @endcond */
+
+
 class LIBSEDML_EXTERN SedListOf : public SedBase
 {
 public:
@@ -100,7 +151,7 @@ public:
    * @param sedmlns the set of SED-ML namespaces that this SedListOf should
    * contain.
    */
-  SedListOf (SedNamespaces* sedmlns);
+  SedListOf (const SedNamespaces *sedmlns);
 
 
   /**
@@ -130,14 +181,33 @@ public:
    *
    * @param v the SedVisitor instance to be used.
    *
-   * @return the result of calling <code>v.visit()</code>, which indicates
-   * whether the Visitor would like to visit the next item in the
-   * list.
+   * All items are visited in order, whatever <code>v.visit()</code>
+   * returns for them.
+   *
+   * @return @c true.
    */
   virtual bool accept (SedVisitor& v) const;
   /** @endcond */
 
 
+  /**
+   * Returns the number of items in this SedListOf.
+   *
+   * @return the number of items, just like size().
+   */
+  virtual unsigned int getNumChildElements () const;
+
+
+  /**
+   * Returns the nth item of this SedListOf.
+   *
+   * @param n the index of the item.
+   *
+   * @return the nth item, or @c NULL if there is no such item.
+   */
+  virtual const SedBase* getChildElement (unsigned int n) const;
+
+
   /**
    * Creates and returns a deep copy of this SedListOf object.
    *
@@ -370,6 +440,59 @@ public:
   /** @endcond */
 
 
+  /** @cond doxygenLibsedmlInternal */
+  /**
+   * Informs this SedListOf that the id of one of its items has changed,
+   * so that the id index can be updated.
+   *
+   * @param item the item whose id changed.
+   * @param oldId the previous id of @p item.
+   */
+  void updateIdIndex (SedBase* item, const std::string& oldId);
+
+
+  /**
+   * Discards the id index of this SedListOf and that of its SedDocument.
+   * Subclasses must call this after reordering mItems directly.
+   */
+  void invalidateIdIndexes ();
+
+
+  /**
+   * Marks the items of this SedListOf as not read yet; they will be read
+   * by its SedDocument on first access (see SedReader::setLazyListLoading()).
+   *
+   * @param hasLazyItems whether the items still need to be read.
+   */
+  void setHasLazyItems (bool hasLazyItems);
+
+
+  /**
+   * @return @c true if the items of this SedListOf have not been read yet,
+   * or not been copied yet from the list this one was copied from.
+   */
+  bool getHasLazyItems () const;
+
+
+  /**
+   * @return @c true if this SedListOf still shares its items with the
+   * lists it was copied from or to (see SedSharedItemsScope).
+   */
+  bool getSharesItems () const;
+
+
+  /**
+   * Reads the items of this SedListOf, if they have not been read yet,
+   * copies them from the list it was copied from, if that is still
+   * pending, and lets copies made from this list have items of their own,
+   * so that the items of this list may be modified.  All methods that
+   * access mItems, or hand out items that may be modified, must call this
+   * first; const methods use getReadableItems() instead.
+   */
+  void loadLazyItems () const;
+  /** @endcond */
+
+
   /** @cond doxygenLibsedmlInternal */
   /**
    * Sets this SED-ML object to child SED-ML objects (if any).
@@ -480,8 +603,69 @@ protected:
 
   virtual bool isValidTypeForList(SedBase * item);
 
+
+  /**
+   * Returns the item of this SedListOf with the given "id" attribute value,
+   * or @c NULL if no such item exists.  Lookups go through a hash index
+   * that is built on first use and maintained as items are added, removed
+   * or renamed.
+   */
+  SedBase* getItemById (const std::string& sid) const;
+
+
+  /**
+   * Removes the item with the given "id" attribute value from this
+   * SedListOf and returns it, or returns @c NULL if no such item exists.
+   */
+  SedBase* removeItemById (const std::string& sid);
+
+
+  /**
+   * Returns the items of this SedListOf for reading, after reading them or
+   * copying them from the list this one was copied from, if need be.
+   * Unlike loadLazyItems() this lets copies keep sharing the items.
+   */
+  const ListItem& getReadableItems () const;
+
+
+  /**
+   * Returns the store through which copies of this SedListOf share its
+   * items, creating it if need be; an empty pointer if there are no items.
+   */
+  std::shared_ptr<SedSharedListItems> lendItems () const;
+
+
+  /**
+   * Clones the items of the store this SedListOf was copied from into
+   * items of its own, which in turn share the items of their lists.
+   */
+  void copySharedItems ();
+
+
+  /**
+   * Stops sharing the items of this SedListOf with its copies.  If copies
+   * still refer to them, the store gets copies of the items, or takes the
+   * items over if they are about to be discarded anyway.
+   *
+   * @param discardItems whether this list is about to drop its items.
+   */
+  void stopLendingItems (bool discardItems);
+
   ListItem mItems;
 
+  mutable SedIdIndex mIdIndex;
+
+  // set while the items still need to be read or copied, which happens
+  // under a lock shared by all lists (see loadLazyItems())
+  mutable std::atomic<bool> mHasLazyItems;
+  mutable bool mLoadingItems;
+
+  // the store shared with other lists: either the one this list still has
+  // to copy its items from, or the one through which its copies read the
+  // items of this list, in which case mLendsItems is set
+  mutable std::shared_ptr<SedSharedListItems> mSharedItems;
+  mutable std::atomic<bool> mLendsItems;
+
   /** @endcond */
 };
 
@@ -66,8 +66,8 @@ SedListOfAdjustableParameters::SedListOfAdjustableParameters(
  * Creates a new SedListOfAdjustableParameters using the given SedNamespaces
  * object @p sedmlns.
  */
-SedListOfAdjustableParameters::SedListOfAdjustableParameters(SedNamespaces
-  *sedmlns)
+SedListOfAdjustableParameters::SedListOfAdjustableParameters(const
+  SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -146,6 +146,7 @@ SedListOfAdjustableParameters::get(unsigned int n) const
 SedAdjustableParameter*
 SedListOfAdjustableParameters::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAdjustableParameter*>(static_cast<const
     SedListOfAdjustableParameters&>(*this).get(sid));
 }
@@ -158,11 +159,7 @@ SedListOfAdjustableParameters::get(const std::string& sid)
 const SedAdjustableParameter*
 SedListOfAdjustableParameters::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAdjustableParameter>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const
-    SedAdjustableParameter*> (*result);
+  return static_cast<const SedAdjustableParameter*>(getItemById(sid));
 }
 
 
@@ -184,19 +181,7 @@ SedListOfAdjustableParameters::remove(unsigned int n)
 SedAdjustableParameter*
 SedListOfAdjustableParameters::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAdjustableParameter>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedAdjustableParameter*> (item);
+  return static_cast<SedAdjustableParameter*>(removeItemById(sid));
 }
 
 
@@ -299,8 +284,9 @@ SedListOfAdjustableParameters::getByModelReference(const std::string& sid)
   const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqMR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqMR(sid));
+  return (result == items.end()) ? 0 : static_cast <const
     SedAdjustableParameter*> (*result);
 }
 
@@ -312,6 +298,7 @@ SedListOfAdjustableParameters::getByModelReference(const std::string& sid)
 SedAdjustableParameter*
 SedListOfAdjustableParameters::getByModelReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAdjustableParameter*>(static_cast<const
     SedListOfAdjustableParameters&>(*this).getByModelReference(sid));
 }
@@ -88,7 +88,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfAdjustableParameters(SedNamespaces *sedmlns);
+  SedListOfAdjustableParameters(const SedNamespaces *sedmlns);
 
 
   /**
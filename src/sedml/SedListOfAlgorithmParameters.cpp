@@ -64,8 +64,8 @@ SedListOfAlgorithmParameters::SedListOfAlgorithmParameters(unsigned int level,
  * Creates a new SedListOfAlgorithmParameters using the given SedNamespaces
  * object @p sedmlns.
  */
-SedListOfAlgorithmParameters::SedListOfAlgorithmParameters(SedNamespaces
-  *sedmlns)
+SedListOfAlgorithmParameters::SedListOfAlgorithmParameters(const
+  SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -143,6 +143,7 @@ SedListOfAlgorithmParameters::get(unsigned int n) const
 SedAlgorithmParameter*
 SedListOfAlgorithmParameters::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAlgorithmParameter*>(static_cast<const
     SedListOfAlgorithmParameters&>(*this).get(sid));
 }
@@ -155,11 +156,7 @@ SedListOfAlgorithmParameters::get(const std::string& sid)
 const SedAlgorithmParameter*
 SedListOfAlgorithmParameters::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAlgorithmParameter>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const
-    SedAlgorithmParameter*> (*result);
+  return static_cast<const SedAlgorithmParameter*>(getItemById(sid));
 }
 
 
@@ -181,19 +178,7 @@ SedListOfAlgorithmParameters::remove(unsigned int n)
 SedAlgorithmParameter*
 SedListOfAlgorithmParameters::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAlgorithmParameter>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedAlgorithmParameter*> (item);
+  return static_cast<SedAlgorithmParameter*>(removeItemById(sid));
 }
 
 
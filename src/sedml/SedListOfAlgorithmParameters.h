@@ -87,7 +87,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfAlgorithmParameters(SedNamespaces *sedmlns);
+  SedListOfAlgorithmParameters(const SedNamespaces *sedmlns);
 
 
   /**
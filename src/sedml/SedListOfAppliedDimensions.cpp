@@ -64,8 +64,8 @@ SedListOfAppliedDimensions::SedListOfAppliedDimensions(unsigned int level,
  * Creates a new SedListOfAppliedDimensions using the given SedNamespaces
  * object @p sedmlns.
  */
-SedListOfAppliedDimensions::SedListOfAppliedDimensions(SedNamespaces
-  *sedmlns)
+SedListOfAppliedDimensions::SedListOfAppliedDimensions(const
+  SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -143,6 +143,7 @@ SedListOfAppliedDimensions::get(unsigned int n) const
 SedAppliedDimension*
 SedListOfAppliedDimensions::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAppliedDimension*>(static_cast<const
     SedListOfAppliedDimensions&>(*this).get(sid));
 }
@@ -155,11 +156,7 @@ SedListOfAppliedDimensions::get(const std::string& sid)
 const SedAppliedDimension*
 SedListOfAppliedDimensions::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAppliedDimension>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const
-    SedAppliedDimension*> (*result);
+  return static_cast<const SedAppliedDimension*>(getItemById(sid));
 }
 
 
@@ -181,19 +178,7 @@ SedListOfAppliedDimensions::remove(unsigned int n)
 SedAppliedDimension*
 SedListOfAppliedDimensions::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAppliedDimension>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedAppliedDimension*> (item);
+  return static_cast<SedAppliedDimension*>(removeItemById(sid));
 }
 
 
@@ -295,8 +280,9 @@ const SedAppliedDimension*
 SedListOfAppliedDimensions::getByTarget(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqT(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqT(sid));
+  return (result == items.end()) ? 0 : static_cast <const
     SedAppliedDimension*> (*result);
 }
 
@@ -308,6 +294,7 @@ SedListOfAppliedDimensions::getByTarget(const std::string& sid) const
 SedAppliedDimension*
 SedListOfAppliedDimensions::getByTarget(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAppliedDimension*>(static_cast<const
     SedListOfAppliedDimensions&>(*this).getByTarget(sid));
 }
@@ -338,8 +325,9 @@ SedListOfAppliedDimensions::getByDimensionTarget(const std::string& sid)
   const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqDT(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqDT(sid));
+  return (result == items.end()) ? 0 : static_cast <const
     SedAppliedDimension*> (*result);
 }
 
@@ -351,6 +339,7 @@ SedListOfAppliedDimensions::getByDimensionTarget(const std::string& sid)
 SedAppliedDimension*
 SedListOfAppliedDimensions::getByDimensionTarget(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAppliedDimension*>(static_cast<const
     SedListOfAppliedDimensions&>(*this).getByDimensionTarget(sid));
 }
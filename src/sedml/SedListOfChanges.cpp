@@ -68,7 +68,7 @@ SedListOfChanges::SedListOfChanges(unsigned int level, unsigned int version)
  * Creates a new SedListOfChanges using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfChanges::SedListOfChanges(SedNamespaces *sedmlns)
+SedListOfChanges::SedListOfChanges(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -143,6 +143,7 @@ SedListOfChanges::get(unsigned int n) const
 SedChange*
 SedListOfChanges::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedChange*>(static_cast<const
     SedListOfChanges&>(*this).get(sid));
 }
@@ -154,10 +155,7 @@ SedListOfChanges::get(const std::string& sid)
 const SedChange*
 SedListOfChanges::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedChange>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedChange*>
-    (*result);
+  return static_cast<const SedChange*>(getItemById(sid));
 }
 
 
@@ -179,18 +177,7 @@ SedListOfChanges::remove(unsigned int n)
 SedChange*
 SedListOfChanges::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedChange>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedChange*> (item);
+  return static_cast<SedChange*>(removeItemById(sid));
 }
 
 
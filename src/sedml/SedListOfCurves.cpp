@@ -65,7 +65,7 @@ SedListOfCurves::SedListOfCurves(unsigned int level, unsigned int version)
  * Creates a new SedListOfCurves using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfCurves::SedListOfCurves(SedNamespaces *sedmlns)
+SedListOfCurves::SedListOfCurves(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -118,7 +118,9 @@ struct AbstractCurvesOrderComparator
 
 void SedListOfCurves::sort()
 {
+    loadLazyItems();
     std::sort(mItems.begin(), mItems.end(), AbstractCurvesOrderComparator());
+    invalidateIdIndexes();
 }
 
 /*
@@ -165,6 +167,7 @@ SedListOfCurves::get(unsigned int n) const
 SedAbstractCurve*
 SedListOfCurves::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAbstractCurve*>(static_cast<const
     SedListOfCurves&>(*this).get(sid));
 }
@@ -176,11 +179,7 @@ SedListOfCurves::get(const std::string& sid)
 const SedAbstractCurve*
 SedListOfCurves::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAbstractCurve>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedAbstractCurve*>
-    (*result);
+  return static_cast<const SedAbstractCurve*>(getItemById(sid));
 }
 
 
@@ -202,19 +201,7 @@ SedListOfCurves::remove(unsigned int n)
 SedAbstractCurve*
 SedListOfCurves::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAbstractCurve>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedAbstractCurve*> (item);
+  return static_cast<SedAbstractCurve*>(removeItemById(sid));
 }
 
 
@@ -338,8 +325,9 @@ const SedAbstractCurve*
 SedListOfCurves::getByStyle(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqS(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedAbstractCurve*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqS(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedAbstractCurve*>
     (*result);
 }
 
@@ -351,6 +339,7 @@ SedListOfCurves::getByStyle(const std::string& sid) const
 SedAbstractCurve*
 SedListOfCurves::getByStyle(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAbstractCurve*>(static_cast<const
     SedListOfCurves&>(*this).getByStyle(sid));
 }
@@ -380,8 +369,9 @@ const SedAbstractCurve*
 SedListOfCurves::getByXDataReference(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqXDR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedAbstractCurve*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqXDR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedAbstractCurve*>
     (*result);
 }
 
@@ -393,6 +383,7 @@ SedListOfCurves::getByXDataReference(const std::string& sid) const
 SedAbstractCurve*
 SedListOfCurves::getByXDataReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAbstractCurve*>(static_cast<const
     SedListOfCurves&>(*this).getByXDataReference(sid));
 }
@@ -90,7 +90,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfCurves(SedNamespaces *sedmlns);
+  SedListOfCurves(const SedNamespaces *sedmlns);
 
 
   /**
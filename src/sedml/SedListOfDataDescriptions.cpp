@@ -63,7 +63,7 @@ SedListOfDataDescriptions::SedListOfDataDescriptions(unsigned int level,
  * Creates a new SedListOfDataDescriptions using the given SedNamespaces object
  * @p sedmlns.
  */
-SedListOfDataDescriptions::SedListOfDataDescriptions(SedNamespaces *sedmlns)
+SedListOfDataDescriptions::SedListOfDataDescriptions(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -140,6 +140,7 @@ SedListOfDataDescriptions::get(unsigned int n) const
 SedDataDescription*
 SedListOfDataDescriptions::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedDataDescription*>(static_cast<const
     SedListOfDataDescriptions&>(*this).get(sid));
 }
@@ -152,11 +153,7 @@ SedListOfDataDescriptions::get(const std::string& sid)
 const SedDataDescription*
 SedListOfDataDescriptions::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedDataDescription>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedDataDescription*>
-    (*result);
+  return static_cast<const SedDataDescription*>(getItemById(sid));
 }
 
 
@@ -178,19 +175,7 @@ SedListOfDataDescriptions::remove(unsigned int n)
 SedDataDescription*
 SedListOfDataDescriptions::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedDataDescription>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedDataDescription*> (item);
+  return static_cast<SedDataDescription*>(removeItemById(sid));
 }
 
 
@@ -64,7 +64,7 @@ SedListOfDataGenerators::SedListOfDataGenerators(unsigned int level,
  * Creates a new SedListOfDataGenerators using the given SedNamespaces object
  * @p sedmlns.
  */
-SedListOfDataGenerators::SedListOfDataGenerators(SedNamespaces *sedmlns)
+SedListOfDataGenerators::SedListOfDataGenerators(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -141,6 +141,7 @@ SedListOfDataGenerators::get(unsigned int n) const
 SedDataGenerator*
 SedListOfDataGenerators::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedDataGenerator*>(static_cast<const
     SedListOfDataGenerators&>(*this).get(sid));
 }
@@ -153,11 +154,7 @@ SedListOfDataGenerators::get(const std::string& sid)
 const SedDataGenerator*
 SedListOfDataGenerators::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedDataGenerator>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedDataGenerator*>
-    (*result);
+  return static_cast<const SedDataGenerator*>(getItemById(sid));
 }
 
 
@@ -179,19 +176,7 @@ SedListOfDataGenerators::remove(unsigned int n)
 SedDataGenerator*
 SedListOfDataGenerators::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedDataGenerator>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedDataGenerator*> (item);
+  return static_cast<SedDataGenerator*>(removeItemById(sid));
 }
 
 
@@ -87,7 +87,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfDataGenerators(SedNamespaces *sedmlns);
+  SedListOfDataGenerators(const SedNamespaces *sedmlns);
 
 
   /**
@@ -62,7 +62,7 @@ SedListOfDataSets::SedListOfDataSets(unsigned int level, unsigned int version)
  * Creates a new SedListOfDataSets using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfDataSets::SedListOfDataSets(SedNamespaces *sedmlns)
+SedListOfDataSets::SedListOfDataSets(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -137,6 +137,7 @@ SedListOfDataSets::get(unsigned int n) const
 SedDataSet*
 SedListOfDataSets::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedDataSet*>(static_cast<const
     SedListOfDataSets&>(*this).get(sid));
 }
@@ -148,10 +149,7 @@ SedListOfDataSets::get(const std::string& sid)
 const SedDataSet*
 SedListOfDataSets::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataSet>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedDataSet*>
-    (*result);
+  return static_cast<const SedDataSet*>(getItemById(sid));
 }
 
 
@@ -173,18 +171,7 @@ SedListOfDataSets::remove(unsigned int n)
 SedDataSet*
 SedListOfDataSets::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataSet>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedDataSet*> (item);
+  return static_cast<SedDataSet*>(removeItemById(sid));
 }
 
 
@@ -282,8 +269,9 @@ const SedDataSet*
 SedListOfDataSets::getByDataReference(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqDR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedDataSet*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqDR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedDataSet*>
     (*result);
 }
 
@@ -295,6 +283,7 @@ SedListOfDataSets::getByDataReference(const std::string& sid) const
 SedDataSet*
 SedListOfDataSets::getByDataReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedDataSet*>(static_cast<const
     SedListOfDataSets&>(*this).getByDataReference(sid));
 }
@@ -63,7 +63,7 @@ SedListOfDataSources::SedListOfDataSources(unsigned int level,
  * Creates a new SedListOfDataSources using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfDataSources::SedListOfDataSources(SedNamespaces *sedmlns)
+SedListOfDataSources::SedListOfDataSources(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -138,6 +138,7 @@ SedListOfDataSources::get(unsigned int n) const
 SedDataSource*
 SedListOfDataSources::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedDataSource*>(static_cast<const
     SedListOfDataSources&>(*this).get(sid));
 }
@@ -149,10 +150,7 @@ SedListOfDataSources::get(const std::string& sid)
 const SedDataSource*
 SedListOfDataSources::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataSource>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedDataSource*>
-    (*result);
+  return static_cast<const SedDataSource*>(getItemById(sid));
 }
 
 
@@ -174,18 +172,7 @@ SedListOfDataSources::remove(unsigned int n)
 SedDataSource*
 SedListOfDataSources::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataSource>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedDataSource*> (item);
+  return static_cast<SedDataSource*>(removeItemById(sid));
 }
 
 
@@ -283,8 +270,9 @@ const SedDataSource*
 SedListOfDataSources::getByIndexSet(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqIS(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedDataSource*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqIS(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedDataSource*>
     (*result);
 }
 
@@ -296,6 +284,7 @@ SedListOfDataSources::getByIndexSet(const std::string& sid) const
 SedDataSource*
 SedListOfDataSources::getByIndexSet(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedDataSource*>(static_cast<const
     SedListOfDataSources&>(*this).getByIndexSet(sid));
 }
@@ -63,7 +63,7 @@ SedListOfExperimentReferences::SedListOfExperimentReferences(unsigned int level,
  * Creates a new SedListOfExperimentReferences using the given SedNamespaces object
  * @p sedmlns.
  */
-SedListOfExperimentReferences::SedListOfExperimentReferences(SedNamespaces *sedmlns)
+SedListOfExperimentReferences::SedListOfExperimentReferences(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -140,6 +140,7 @@ SedListOfExperimentReferences::get(unsigned int n) const
 SedExperimentReference*
 SedListOfExperimentReferences::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedExperimentReference*>(static_cast<const
     SedListOfExperimentReferences&>(*this).get(sid));
 }
@@ -152,11 +153,7 @@ SedListOfExperimentReferences::get(const std::string& sid)
 const SedExperimentReference*
 SedListOfExperimentReferences::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedExperimentReference>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedExperimentReference*>
-    (*result);
+  return static_cast<const SedExperimentReference*>(getItemById(sid));
 }
 
 
@@ -178,19 +175,7 @@ SedListOfExperimentReferences::remove(unsigned int n)
 SedExperimentReference*
 SedListOfExperimentReferences::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedExperimentReference>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedExperimentReference*> (item);
+  return static_cast<SedExperimentReference*>(removeItemById(sid));
 }
 
 
@@ -289,8 +274,9 @@ const SedExperimentReference*
 SedListOfExperimentReferences::getByExperimentId(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqEI(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedExperimentReference*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqEI(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedExperimentReference*>
     (*result);
 }
 
@@ -302,6 +288,7 @@ SedListOfExperimentReferences::getByExperimentId(const std::string& sid) const
 SedExperimentReference*
 SedListOfExperimentReferences::getByExperimentId(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedExperimentReference*>(static_cast<const
     SedListOfExperimentReferences&>(*this).getByExperimentId(sid));
 }
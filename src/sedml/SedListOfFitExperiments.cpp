@@ -63,7 +63,7 @@ SedListOfFitExperiments::SedListOfFitExperiments(unsigned int level,
  * Creates a new SedListOfFitExperiments using the given SedNamespaces object
  * @p sedmlns.
  */
-SedListOfFitExperiments::SedListOfFitExperiments(SedNamespaces *sedmlns)
+SedListOfFitExperiments::SedListOfFitExperiments(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -140,6 +140,7 @@ SedListOfFitExperiments::get(unsigned int n) const
 SedFitExperiment*
 SedListOfFitExperiments::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedFitExperiment*>(static_cast<const
     SedListOfFitExperiments&>(*this).get(sid));
 }
@@ -152,11 +153,7 @@ SedListOfFitExperiments::get(const std::string& sid)
 const SedFitExperiment*
 SedListOfFitExperiments::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedFitExperiment>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedFitExperiment*>
-    (*result);
+  return static_cast<const SedFitExperiment*>(getItemById(sid));
 }
 
 
@@ -178,19 +175,7 @@ SedListOfFitExperiments::remove(unsigned int n)
 SedFitExperiment*
 SedListOfFitExperiments::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedFitExperiment>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedFitExperiment*> (item);
+  return static_cast<SedFitExperiment*>(removeItemById(sid));
 }
 
 
@@ -63,7 +63,7 @@ SedListOfFitMappings::SedListOfFitMappings(unsigned int level,
  * Creates a new SedListOfFitMappings using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfFitMappings::SedListOfFitMappings(SedNamespaces *sedmlns)
+SedListOfFitMappings::SedListOfFitMappings(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -138,6 +138,7 @@ SedListOfFitMappings::get(unsigned int n) const
 SedFitMapping*
 SedListOfFitMappings::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedFitMapping*>(static_cast<const
     SedListOfFitMappings&>(*this).get(sid));
 }
@@ -149,10 +150,7 @@ SedListOfFitMappings::get(const std::string& sid)
 const SedFitMapping*
 SedListOfFitMappings::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedFitMapping>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedFitMapping*>
-    (*result);
+  return static_cast<const SedFitMapping*>(getItemById(sid));
 }
 
 
@@ -174,18 +172,7 @@ SedListOfFitMappings::remove(unsigned int n)
 SedFitMapping*
 SedListOfFitMappings::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedFitMapping>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedFitMapping*> (item);
+  return static_cast<SedFitMapping*>(removeItemById(sid));
 }
 
 
@@ -283,8 +270,9 @@ const SedFitMapping*
 SedListOfFitMappings::getByDataSource(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqDS(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedFitMapping*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqDS(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedFitMapping*>
     (*result);
 }
 
@@ -296,6 +284,7 @@ SedListOfFitMappings::getByDataSource(const std::string& sid) const
 SedFitMapping*
 SedListOfFitMappings::getByDataSource(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedFitMapping*>(static_cast<const
     SedListOfFitMappings&>(*this).getByDataSource(sid));
 }
@@ -325,8 +314,9 @@ const SedFitMapping*
 SedListOfFitMappings::getByTarget(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqT(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedFitMapping*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqT(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedFitMapping*>
     (*result);
 }
 
@@ -338,6 +328,7 @@ SedListOfFitMappings::getByTarget(const std::string& sid) const
 SedFitMapping*
 SedListOfFitMappings::getByTarget(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedFitMapping*>(static_cast<const
     SedListOfFitMappings&>(*this).getByTarget(sid));
 }
@@ -367,8 +358,9 @@ const SedFitMapping*
 SedListOfFitMappings::getByPointWeight(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqPW(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedFitMapping*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqPW(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedFitMapping*>
     (*result);
 }
 
@@ -380,6 +372,7 @@ SedListOfFitMappings::getByPointWeight(const std::string& sid) const
 SedFitMapping*
 SedListOfFitMappings::getByPointWeight(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedFitMapping*>(static_cast<const
     SedListOfFitMappings&>(*this).getByPointWeight(sid));
 }
@@ -87,7 +87,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfFitMappings(SedNamespaces *sedmlns);
+  SedListOfFitMappings(const SedNamespaces *sedmlns);
 
 
   /**
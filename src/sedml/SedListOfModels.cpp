@@ -62,7 +62,7 @@ SedListOfModels::SedListOfModels(unsigned int level, unsigned int version)
  * Creates a new SedListOfModels using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfModels::SedListOfModels(SedNamespaces *sedmlns)
+SedListOfModels::SedListOfModels(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -137,6 +137,7 @@ SedListOfModels::get(unsigned int n) const
 SedModel*
 SedListOfModels::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedModel*>(static_cast<const
     SedListOfModels&>(*this).get(sid));
 }
@@ -148,10 +149,7 @@ SedListOfModels::get(const std::string& sid)
 const SedModel*
 SedListOfModels::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedModel>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedModel*>
-    (*result);
+  return static_cast<const SedModel*>(getItemById(sid));
 }
 
 
@@ -173,18 +171,7 @@ SedListOfModels::remove(unsigned int n)
 SedModel*
 SedListOfModels::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedModel>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedModel*> (item);
+  return static_cast<SedModel*>(removeItemById(sid));
 }
 
 
@@ -69,7 +69,7 @@ SedListOfOutputs::SedListOfOutputs(unsigned int level, unsigned int version)
  * Creates a new SedListOfOutputs using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfOutputs::SedListOfOutputs(SedNamespaces *sedmlns)
+SedListOfOutputs::SedListOfOutputs(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
   , mElementName("listOfOutputs")
 {
@@ -147,6 +147,7 @@ SedListOfOutputs::get(unsigned int n) const
 SedOutput*
 SedListOfOutputs::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedOutput*>(static_cast<const
     SedListOfOutputs&>(*this).get(sid));
 }
@@ -158,10 +159,7 @@ SedListOfOutputs::get(const std::string& sid)
 const SedOutput*
 SedListOfOutputs::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedOutput>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedOutput*>
-    (*result);
+  return static_cast<const SedOutput*>(getItemById(sid));
 }
 
 
@@ -183,18 +181,7 @@ SedListOfOutputs::remove(unsigned int n)
 SedOutput*
 SedListOfOutputs::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedOutput>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedOutput*> (item);
+  return static_cast<SedOutput*>(removeItemById(sid));
 }
 
 
@@ -63,7 +63,7 @@ SedListOfParameters::SedListOfParameters(unsigned int level,
  * Creates a new SedListOfParameters using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfParameters::SedListOfParameters(SedNamespaces *sedmlns)
+SedListOfParameters::SedListOfParameters(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -138,6 +138,7 @@ SedListOfParameters::get(unsigned int n) const
 SedParameter*
 SedListOfParameters::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedParameter*>(static_cast<const
     SedListOfParameters&>(*this).get(sid));
 }
@@ -149,10 +150,7 @@ SedListOfParameters::get(const std::string& sid)
 const SedParameter*
 SedListOfParameters::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedParameter>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedParameter*>
-    (*result);
+  return static_cast<const SedParameter*>(getItemById(sid));
 }
 
 
@@ -174,18 +172,7 @@ SedListOfParameters::remove(unsigned int n)
 SedParameter*
 SedListOfParameters::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedParameter>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedParameter*> (item);
+  return static_cast<SedParameter*>(removeItemById(sid));
 }
 
 
@@ -87,7 +87,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfParameters(SedNamespaces *sedmlns);
+  SedListOfParameters(const SedNamespaces *sedmlns);
 
 
   /**
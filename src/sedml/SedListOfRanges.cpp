@@ -68,7 +68,7 @@ SedListOfRanges::SedListOfRanges(unsigned int level, unsigned int version)
  * Creates a new SedListOfRanges using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfRanges::SedListOfRanges(SedNamespaces *sedmlns)
+SedListOfRanges::SedListOfRanges(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
   , mElementName("listOfRanges")
 {
@@ -146,6 +146,7 @@ SedListOfRanges::get(unsigned int n) const
 SedRange*
 SedListOfRanges::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedRange*>(static_cast<const
     SedListOfRanges&>(*this).get(sid));
 }
@@ -157,10 +158,7 @@ SedListOfRanges::get(const std::string& sid)
 const SedRange*
 SedListOfRanges::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedRange>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedRange*>
-    (*result);
+  return static_cast<const SedRange*>(getItemById(sid));
 }
 
 
@@ -182,18 +180,7 @@ SedListOfRanges::remove(unsigned int n)
 SedRange*
 SedListOfRanges::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedRange>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedRange*> (item);
+  return static_cast<SedRange*>(removeItemById(sid));
 }
 
 
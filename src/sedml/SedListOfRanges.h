@@ -99,7 +99,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfRanges(SedNamespaces *sedmlns);
+  SedListOfRanges(const SedNamespaces *sedmlns);
 
 
   /**
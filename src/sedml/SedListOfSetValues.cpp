@@ -64,7 +64,7 @@ SedListOfSetValues::SedListOfSetValues(unsigned int level,
  * Creates a new SedListOfSetValues using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfSetValues::SedListOfSetValues(SedNamespaces *sedmlns)
+SedListOfSetValues::SedListOfSetValues(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -139,6 +139,7 @@ SedListOfSetValues::get(unsigned int n) const
 SedSetValue*
 SedListOfSetValues::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSetValue*>(static_cast<const
     SedListOfSetValues&>(*this).get(sid));
 }
@@ -150,10 +151,7 @@ SedListOfSetValues::get(const std::string& sid)
 const SedSetValue*
 SedListOfSetValues::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSetValue>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSetValue*>
-    (*result);
+  return static_cast<const SedSetValue*>(getItemById(sid));
 }
 
 
@@ -175,18 +173,7 @@ SedListOfSetValues::remove(unsigned int n)
 SedSetValue*
 SedListOfSetValues::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSetValue>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedSetValue*> (item);
+  return static_cast<SedSetValue*>(removeItemById(sid));
 }
 
 
@@ -288,8 +275,9 @@ const SedSetValue*
 SedListOfSetValues::getByModelReference(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqMR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSetValue*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqMR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSetValue*>
     (*result);
 }
 
@@ -301,6 +289,7 @@ SedListOfSetValues::getByModelReference(const std::string& sid) const
 SedSetValue*
 SedListOfSetValues::getByModelReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSetValue*>(static_cast<const
     SedListOfSetValues&>(*this).getByModelReference(sid));
 }
@@ -330,8 +319,9 @@ const SedSetValue*
 SedListOfSetValues::getByRange(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSetValue*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSetValue*>
     (*result);
 }
 
@@ -343,6 +333,7 @@ SedListOfSetValues::getByRange(const std::string& sid) const
 SedSetValue*
 SedListOfSetValues::getByRange(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSetValue*>(static_cast<const
     SedListOfSetValues&>(*this).getByRange(sid));
 }
@@ -68,7 +68,7 @@ SedListOfSimulations::SedListOfSimulations(unsigned int level,
  * Creates a new SedListOfSimulations using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfSimulations::SedListOfSimulations(SedNamespaces *sedmlns)
+SedListOfSimulations::SedListOfSimulations(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -143,6 +143,7 @@ SedListOfSimulations::get(unsigned int n) const
 SedSimulation*
 SedListOfSimulations::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSimulation*>(static_cast<const
     SedListOfSimulations&>(*this).get(sid));
 }
@@ -154,10 +155,7 @@ SedListOfSimulations::get(const std::string& sid)
 const SedSimulation*
 SedListOfSimulations::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSimulation>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSimulation*>
-    (*result);
+  return static_cast<const SedSimulation*>(getItemById(sid));
 }
 
 
@@ -179,18 +177,7 @@ SedListOfSimulations::remove(unsigned int n)
 SedSimulation*
 SedListOfSimulations::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSimulation>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedSimulation*> (item);
+  return static_cast<SedSimulation*>(removeItemById(sid));
 }
 
 
@@ -92,7 +92,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfSimulations(SedNamespaces *sedmlns);
+  SedListOfSimulations(const SedNamespaces *sedmlns);
 
 
   /**
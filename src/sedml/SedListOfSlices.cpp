@@ -62,7 +62,7 @@ SedListOfSlices::SedListOfSlices(unsigned int level, unsigned int version)
  * Creates a new SedListOfSlices using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfSlices::SedListOfSlices(SedNamespaces *sedmlns)
+SedListOfSlices::SedListOfSlices(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -137,6 +137,7 @@ SedListOfSlices::get(unsigned int n) const
 SedSlice*
 SedListOfSlices::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSlice*>(static_cast<const
     SedListOfSlices&>(*this).get(sid));
 }
@@ -148,10 +149,7 @@ SedListOfSlices::get(const std::string& sid)
 const SedSlice*
 SedListOfSlices::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSlice>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSlice*>
-    (*result);
+  return static_cast<const SedSlice*>(getItemById(sid));
 }
 
 
@@ -173,18 +171,7 @@ SedListOfSlices::remove(unsigned int n)
 SedSlice*
 SedListOfSlices::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSlice>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedSlice*> (item);
+  return static_cast<SedSlice*>(removeItemById(sid));
 }
 
 
@@ -281,8 +268,9 @@ const SedSlice*
 SedListOfSlices::getByReference(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSlice*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSlice*>
     (*result);
 }
 
@@ -294,6 +282,7 @@ SedListOfSlices::getByReference(const std::string& sid) const
 SedSlice*
 SedListOfSlices::getByReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSlice*>(static_cast<const
     SedListOfSlices&>(*this).getByReference(sid));
 }
@@ -322,8 +311,9 @@ const SedSlice*
 SedListOfSlices::getByIndex(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqI(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSlice*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqI(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSlice*>
     (*result);
 }
 
@@ -335,6 +325,7 @@ SedListOfSlices::getByIndex(const std::string& sid) const
 SedSlice*
 SedListOfSlices::getByIndex(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSlice*>(static_cast<const
     SedListOfSlices&>(*this).getByIndex(sid));
 }
@@ -62,7 +62,7 @@ SedListOfStyles::SedListOfStyles(unsigned int level, unsigned int version)
  * Creates a new SedListOfStyles using the given SedNamespaces object @p
  * sedMLns.
  */
-SedListOfStyles::SedListOfStyles(SedNamespaces *sedMLns)
+SedListOfStyles::SedListOfStyles(const SedNamespaces *sedMLns)
   : SedListOf(sedMLns)
 {
   setElementNamespace(sedMLns->getURI());
@@ -137,6 +137,7 @@ SedListOfStyles::get(unsigned int n) const
 SedStyle*
 SedListOfStyles::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedStyle*>(static_cast<const
     SedListOfStyles&>(*this).get(sid));
 }
@@ -148,10 +149,7 @@ SedListOfStyles::get(const std::string& sid)
 const SedStyle*
 SedListOfStyles::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedStyle>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedStyle*>
-    (*result);
+  return static_cast<const SedStyle*>(getItemById(sid));
 }
 
 
@@ -173,18 +171,7 @@ SedListOfStyles::remove(unsigned int n)
 SedStyle*
 SedListOfStyles::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedStyle>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedStyle*> (item);
+  return static_cast<SedStyle*>(removeItemById(sid));
 }
 
 
@@ -281,8 +268,9 @@ const SedStyle*
 SedListOfStyles::getByBaseStyle(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqBS(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedStyle*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqBS(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedStyle*>
     (*result);
 }
 
@@ -294,6 +282,7 @@ SedListOfStyles::getByBaseStyle(const std::string& sid) const
 SedStyle*
 SedListOfStyles::getByBaseStyle(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedStyle*>(static_cast<const
     SedListOfStyles&>(*this).getByBaseStyle(sid));
 }
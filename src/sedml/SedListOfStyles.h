@@ -87,7 +87,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfStyles(SedNamespaces *sedMLns);
+  SedListOfStyles(const SedNamespaces *sedMLns);
 
 
   /**
@@ -62,7 +62,7 @@ SedListOfSubPlots::SedListOfSubPlots(unsigned int level, unsigned int version)
  * Creates a new SedListOfSubPlots using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfSubPlots::SedListOfSubPlots(SedNamespaces *sedmlns)
+SedListOfSubPlots::SedListOfSubPlots(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -137,6 +137,7 @@ SedListOfSubPlots::get(unsigned int n) const
 SedSubPlot*
 SedListOfSubPlots::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSubPlot*>(static_cast<const
     SedListOfSubPlots&>(*this).get(sid));
 }
@@ -148,10 +149,7 @@ SedListOfSubPlots::get(const std::string& sid)
 const SedSubPlot*
 SedListOfSubPlots::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSubPlot>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSubPlot*>
-    (*result);
+  return static_cast<const SedSubPlot*>(getItemById(sid));
 }
 
 
@@ -173,18 +171,7 @@ SedListOfSubPlots::remove(unsigned int n)
 SedSubPlot*
 SedListOfSubPlots::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSubPlot>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedSubPlot*> (item);
+  return static_cast<SedSubPlot*>(removeItemById(sid));
 }
 
 
@@ -281,8 +268,9 @@ const SedSubPlot*
 SedListOfSubPlots::getByPlot(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqP(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSubPlot*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqP(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSubPlot*>
     (*result);
 }
 
@@ -294,6 +282,7 @@ SedListOfSubPlots::getByPlot(const std::string& sid) const
 SedSubPlot*
 SedListOfSubPlots::getByPlot(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSubPlot*>(static_cast<const
     SedListOfSubPlots&>(*this).getByPlot(sid));
 }
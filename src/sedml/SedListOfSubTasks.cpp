@@ -62,7 +62,7 @@ SedListOfSubTasks::SedListOfSubTasks(unsigned int level, unsigned int version)
  * Creates a new SedListOfSubTasks using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfSubTasks::SedListOfSubTasks(SedNamespaces *sedmlns)
+SedListOfSubTasks::SedListOfSubTasks(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -133,7 +133,9 @@ struct SubTaskOrderComparator
 
 void SedListOfSubTasks::sort()
 {
+    loadLazyItems();
     std::sort(mItems.begin(), mItems.end(), SubTaskOrderComparator());
+    invalidateIdIndexes();
 }
 
 
@@ -164,6 +166,7 @@ SedListOfSubTasks::get(unsigned int n) const
 SedSubTask*
 SedListOfSubTasks::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSubTask*>(static_cast<const
     SedListOfSubTasks&>(*this).get(sid));
 }
@@ -175,10 +178,7 @@ SedListOfSubTasks::get(const std::string& sid)
 const SedSubTask*
 SedListOfSubTasks::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSubTask>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSubTask*>
-    (*result);
+  return static_cast<const SedSubTask*>(getItemById(sid));
 }
 
 
@@ -200,18 +200,7 @@ SedListOfSubTasks::remove(unsigned int n)
 SedSubTask*
 SedListOfSubTasks::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSubTask>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedSubTask*> (item);
+  return static_cast<SedSubTask*>(removeItemById(sid));
 }
 
 
@@ -308,8 +297,9 @@ const SedSubTask*
 SedListOfSubTasks::getByTask(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqT(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSubTask*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqT(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSubTask*>
     (*result);
 }
 
@@ -321,6 +311,7 @@ SedListOfSubTasks::getByTask(const std::string& sid) const
 SedSubTask*
 SedListOfSubTasks::getByTask(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSubTask*>(static_cast<const
     SedListOfSubTasks&>(*this).getByTask(sid));
 }
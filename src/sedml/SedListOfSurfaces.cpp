@@ -62,7 +62,7 @@ SedListOfSurfaces::SedListOfSurfaces(unsigned int level, unsigned int version)
  * Creates a new SedListOfSurfaces using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfSurfaces::SedListOfSurfaces(SedNamespaces *sedmlns)
+SedListOfSurfaces::SedListOfSurfaces(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -115,7 +115,9 @@ struct SurfaceOrderComparator
 
 void SedListOfSurfaces::sort()
 {
+    loadLazyItems();
     std::sort(mItems.begin(), mItems.end(), SurfaceOrderComparator());
+    invalidateIdIndexes();
 }
 
 /*
@@ -162,6 +164,7 @@ SedListOfSurfaces::get(unsigned int n) const
 SedSurface*
 SedListOfSurfaces::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSurface*>(static_cast<const
     SedListOfSurfaces&>(*this).get(sid));
 }
@@ -173,10 +176,7 @@ SedListOfSurfaces::get(const std::string& sid)
 const SedSurface*
 SedListOfSurfaces::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSurface>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSurface*>
-    (*result);
+  return static_cast<const SedSurface*>(getItemById(sid));
 }
 
 
@@ -198,18 +198,7 @@ SedListOfSurfaces::remove(unsigned int n)
 SedSurface*
 SedListOfSurfaces::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSurface>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedSurface*> (item);
+  return static_cast<SedSurface*>(removeItemById(sid));
 }
 
 
@@ -307,8 +296,9 @@ const SedSurface*
 SedListOfSurfaces::getByXDataReference(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqXDR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSurface*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqXDR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSurface*>
     (*result);
 }
 
@@ -320,6 +310,7 @@ SedListOfSurfaces::getByXDataReference(const std::string& sid) const
 SedSurface*
 SedListOfSurfaces::getByXDataReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSurface*>(static_cast<const
     SedListOfSurfaces&>(*this).getByXDataReference(sid));
 }
@@ -349,8 +340,9 @@ const SedSurface*
 SedListOfSurfaces::getByYDataReference(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqYDR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSurface*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqYDR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSurface*>
     (*result);
 }
 
@@ -362,6 +354,7 @@ SedListOfSurfaces::getByYDataReference(const std::string& sid) const
 SedSurface*
 SedListOfSurfaces::getByYDataReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSurface*>(static_cast<const
     SedListOfSurfaces&>(*this).getByYDataReference(sid));
 }
@@ -391,8 +384,9 @@ const SedSurface*
 SedListOfSurfaces::getByZDataReference(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqZDR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSurface*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqZDR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSurface*>
     (*result);
 }
 
@@ -404,6 +398,7 @@ SedListOfSurfaces::getByZDataReference(const std::string& sid) const
 SedSurface*
 SedListOfSurfaces::getByZDataReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSurface*>(static_cast<const
     SedListOfSurfaces&>(*this).getByZDataReference(sid));
 }
@@ -432,8 +427,9 @@ const SedSurface*
 SedListOfSurfaces::getByStyle(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqS(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedSurface*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqS(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedSurface*>
     (*result);
 }
 
@@ -445,6 +441,7 @@ SedListOfSurfaces::getByStyle(const std::string& sid) const
 SedSurface*
 SedListOfSurfaces::getByStyle(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedSurface*>(static_cast<const
     SedListOfSurfaces&>(*this).getByStyle(sid));
 }
@@ -87,7 +87,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedListOfSurfaces(SedNamespaces *sedmlns);
+  SedListOfSurfaces(const SedNamespaces *sedmlns);
 
 
   /**
@@ -67,7 +67,7 @@ SedListOfTasks::SedListOfTasks(unsigned int level, unsigned int version)
  * Creates a new SedListOfTasks using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfTasks::SedListOfTasks(SedNamespaces *sedmlns)
+SedListOfTasks::SedListOfTasks(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
   , mElementName("listOfTasks")
 {
@@ -145,6 +145,7 @@ SedListOfTasks::get(unsigned int n) const
 SedAbstractTask*
 SedListOfTasks::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedAbstractTask*>(static_cast<const
     SedListOfTasks&>(*this).get(sid));
 }
@@ -156,11 +157,7 @@ SedListOfTasks::get(const std::string& sid)
 const SedAbstractTask*
 SedListOfTasks::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAbstractTask>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedAbstractTask*>
-    (*result);
+  return static_cast<const SedAbstractTask*>(getItemById(sid));
 }
 
 
@@ -182,19 +179,7 @@ SedListOfTasks::remove(unsigned int n)
 SedAbstractTask*
 SedListOfTasks::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(),
-    SedIdEq<SedAbstractTask>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedAbstractTask*> (item);
+  return static_cast<SedAbstractTask*>(removeItemById(sid));
 }
 
 
@@ -64,7 +64,7 @@ SedListOfVariables::SedListOfVariables(unsigned int level,
  * Creates a new SedListOfVariables using the given SedNamespaces object @p
  * sedmlns.
  */
-SedListOfVariables::SedListOfVariables(SedNamespaces *sedmlns)
+SedListOfVariables::SedListOfVariables(const SedNamespaces *sedmlns)
   : SedListOf(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -139,6 +139,7 @@ SedListOfVariables::get(unsigned int n) const
 SedVariable*
 SedListOfVariables::get(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedVariable*>(static_cast<const
     SedListOfVariables&>(*this).get(sid));
 }
@@ -150,10 +151,7 @@ SedListOfVariables::get(const std::string& sid)
 const SedVariable*
 SedListOfVariables::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedVariable>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedVariable*>
-    (*result);
+  return static_cast<const SedVariable*>(getItemById(sid));
 }
 
 
@@ -175,18 +173,7 @@ SedListOfVariables::remove(unsigned int n)
 SedVariable*
 SedListOfVariables::remove(const std::string& sid)
 {
-  SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedVariable>(sid));
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SedVariable*> (item);
+  return static_cast<SedVariable*>(removeItemById(sid));
 }
 
 
@@ -300,8 +287,9 @@ const SedVariable*
 SedListOfVariables::getByTaskReference(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqTR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedVariable*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqTR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedVariable*>
     (*result);
 }
 
@@ -313,6 +301,7 @@ SedListOfVariables::getByTaskReference(const std::string& sid) const
 SedVariable*
 SedListOfVariables::getByTaskReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedVariable*>(static_cast<const
     SedListOfVariables&>(*this).getByTaskReference(sid));
 }
@@ -342,8 +331,9 @@ const SedVariable*
 SedListOfVariables::getByModelReference(const std::string& sid) const
 {
   vector<SedBase*>::const_iterator result;
-  result = find_if(mItems.begin(), mItems.end(), SedIdEqMR(sid));
-  return (result == mItems.end()) ? 0 : static_cast <const SedVariable*>
+  const ListItem& items = getReadableItems();
+  result = find_if(items.begin(), items.end(), SedIdEqMR(sid));
+  return (result == items.end()) ? 0 : static_cast <const SedVariable*>
     (*result);
 }
 
@@ -355,6 +345,7 @@ SedListOfVariables::getByModelReference(const std::string& sid) const
 SedVariable*
 SedListOfVariables::getByModelReference(const std::string& sid)
 {
+  loadLazyItems();
   return const_cast<SedVariable*>(static_cast<const
     SedListOfVariables&>(*this).getByModelReference(sid));
 }
@@ -0,0 +1,224 @@
+/**
+ * @file SedMappedFile.cpp
+ * @brief Implementation of the SedMappedFile class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedMappedFile.h>
+
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Creates a new, empty SedMappedFile.
+ */
+SedMappedFile::SedMappedFile ()
+  : mData(NULL)
+  , mSize(0)
+  , mIsMapped(false)
+  , mBuffer()
+#ifdef _WIN32
+  , mFile(NULL)
+  , mMapping(NULL)
+#endif
+{
+}
+
+
+/*
+ * Destroys this SedMappedFile.
+ */
+SedMappedFile::~SedMappedFile ()
+{
+  close();
+}
+
+
+bool
+SedMappedFile::open (const std::string& fileName)
+{
+  close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file != INVALID_HANDLE_VALUE)
+  {
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart == 0)
+    {
+      CloseHandle(file);
+      return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* data = (mapping != NULL)
+      ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (data != NULL)
+    {
+      mFile = file;
+      mMapping = mapping;
+      mData = static_cast<const char*>(data);
+      mSize = (size_t)size.QuadPart;
+      mIsMapped = true;
+      return true;
+    }
+
+    if (mapping != NULL) CloseHandle(mapping);
+    CloseHandle(file);
+  }
+#else
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+    {
+      if (info.st_size == 0)
+      {
+        ::close(fd);
+        return true;
+      }
+
+      void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE,
+                        fd, 0);
+      if (data != MAP_FAILED)
+      {
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+        madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+        mData = static_cast<const char*>(data);
+        mSize = (size_t)info.st_size;
+        mIsMapped = true;
+        return true;
+      }
+    }
+
+    ::close(fd);
+  }
+#endif
+
+  // fall back to reading the file, e.g. for pipes
+  ifstream stream(fileName.c_str(), ios::in | ios::binary);
+  if (!stream) return false;
+
+  mBuffer.assign(istreambuf_iterator<char>(stream), istreambuf_iterator<char>());
+  mData = mBuffer.data();
+  mSize = mBuffer.size();
+  return true;
+}
+
+
+void
+SedMappedFile::assign (const std::string& contents)
+{
+  close();
+
+  mBuffer = contents;
+  mData = mBuffer.data();
+  mSize = mBuffer.size();
+}
+
+
+void
+SedMappedFile::close ()
+{
+  if (mIsMapped)
+  {
+#ifdef _WIN32
+    UnmapViewOfFile(mData);
+    CloseHandle((HANDLE)mMapping);
+    CloseHandle((HANDLE)mFile);
+    mMapping = NULL;
+    mFile = NULL;
+#else
+    munmap(const_cast<char*>(mData), mSize);
+#endif
+  }
+
+  mBuffer.clear();
+  mData = NULL;
+  mSize = 0;
+  mIsMapped = false;
+}
+
+
+const char*
+SedMappedFile::getData () const
+{
+  return mData;
+}
+
+
+size_t
+SedMappedFile::getSize () const
+{
+  return mSize;
+}
+
+
+bool
+SedMappedFile::isMapped () const
+{
+  return mIsMapped;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,145 @@
+/**
+ * @file SedMappedFile.h
+ * @brief Definition of the SedMappedFile class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedMappedFile
+ * @sbmlbrief{} Read-only view of the contents of a file.
+ *
+ * The SedMappedFile is used internally to read data files without copying
+ * them: the file is mapped into memory where the platform supports it, and
+ * read into a buffer otherwise.  Contents can also be supplied directly,
+ * in which case they are copied once.
+ */
+
+
+#ifndef SedMappedFile_h
+#define SedMappedFile_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <string>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/** @cond doxygenLibsedmlInternal */
+class LIBSEDML_EXTERN SedMappedFile
+{
+public:
+
+  /**
+   * Creates a new, empty SedMappedFile.
+   */
+  SedMappedFile ();
+
+
+  /**
+   * Destroys this SedMappedFile, unmapping the file.
+   */
+  ~SedMappedFile ();
+
+
+  /**
+   * Maps the file with the given name, replacing the current contents.
+   *
+   * @param fileName the name of the file.
+   *
+   * @return @c true if the file could be read, @c false otherwise.
+   */
+  bool open (const std::string& fileName);
+
+
+  /**
+   * Replaces the current contents with a copy of the given string.
+   *
+   * @param contents the new contents.
+   */
+  void assign (const std::string& contents);
+
+
+  /**
+   * Unmaps the file, or releases the supplied contents.
+   */
+  void close ();
+
+
+  /**
+   * @return the first character of the contents; the contents are not
+   * terminated by a null character.
+   */
+  const char* getData () const;
+
+
+  /**
+   * @return the number of characters of the contents.
+   */
+  size_t getSize () const;
+
+
+  /**
+   * @return @c true if the contents are mapped from a file rather than
+   * held in a buffer.
+   */
+  bool isMapped () const;
+
+
+private:
+
+  SedMappedFile (const SedMappedFile& orig);
+  SedMappedFile& operator= (const SedMappedFile& rhs);
+
+  const char* mData;
+  size_t mSize;
+  bool mIsMapped;
+  std::string mBuffer;
+
+#ifdef _WIN32
+  void* mFile;
+  void* mMapping;
+#endif
+};
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedMappedFile_h */
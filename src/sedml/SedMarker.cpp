@@ -67,7 +67,7 @@ SedMarker::SedMarker(unsigned int level, unsigned int version)
 /*
  * Creates a new SedMarker using the given SedNamespaces object @p sedmlns.
  */
-SedMarker::SedMarker(SedNamespaces *sedmlns)
+SedMarker::SedMarker(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mSize (util_NaN())
   , mIsSetSize (false)
@@ -256,6 +256,8 @@ SedMarker::isSetLineThickness() const
 int
 SedMarker::setSize(double size)
 {
+  invalidateEffectiveStyles();
+
   mSize = size;
   mIsSetSize = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -268,6 +270,8 @@ SedMarker::setSize(double size)
 int
 SedMarker::setType(const MarkerType_t type)
 {
+  invalidateEffectiveStyles();
+
   if (MarkerType_isValid(type) == 0)
   {
     mType = SEDML_MARKERTYPE_INVALID;
@@ -287,6 +291,8 @@ SedMarker::setType(const MarkerType_t type)
 int
 SedMarker::setType(const std::string& type)
 {
+  invalidateEffectiveStyles();
+
   mType = MarkerType_fromString(type.c_str());
 
   if (mType == SEDML_MARKERTYPE_INVALID)
@@ -304,6 +310,8 @@ SedMarker::setType(const std::string& type)
 int
 SedMarker::setFill(const std::string& fill)
 {
+  invalidateEffectiveStyles();
+
   mFill = fill;
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -315,6 +323,8 @@ SedMarker::setFill(const std::string& fill)
 int
 SedMarker::setLineColor(const std::string& lineColor)
 {
+  invalidateEffectiveStyles();
+
   mLineColor = lineColor;
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -326,6 +336,8 @@ SedMarker::setLineColor(const std::string& lineColor)
 int
 SedMarker::setLineThickness(double lineThickness)
 {
+  invalidateEffectiveStyles();
+
   mLineThickness = lineThickness;
   mIsSetLineThickness = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -338,6 +350,8 @@ SedMarker::setLineThickness(double lineThickness)
 int
 SedMarker::unsetSize()
 {
+  invalidateEffectiveStyles();
+
   mSize = util_NaN();
   mIsSetSize = false;
 
@@ -358,6 +372,8 @@ SedMarker::unsetSize()
 int
 SedMarker::unsetType()
 {
+  invalidateEffectiveStyles();
+
   mType = SEDML_MARKERTYPE_INVALID;
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -369,6 +385,8 @@ SedMarker::unsetType()
 int
 SedMarker::unsetFill()
 {
+  invalidateEffectiveStyles();
+
   mFill.erase();
 
   if (mFill.empty() == true)
@@ -388,6 +406,8 @@ SedMarker::unsetFill()
 int
 SedMarker::unsetLineColor()
 {
+  invalidateEffectiveStyles();
+
   mLineColor.erase();
 
   if (mLineColor.empty() == true)
@@ -407,6 +427,8 @@ SedMarker::unsetLineColor()
 int
 SedMarker::unsetLineThickness()
 {
+  invalidateEffectiveStyles();
+
   mLineThickness = util_NaN();
   mIsSetLineThickness = false;
 
@@ -480,7 +502,11 @@ SedMarker::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedMarker::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
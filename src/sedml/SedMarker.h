@@ -145,7 +145,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedMarker(SedNamespaces *sedmlns);
+  SedMarker(const SedNamespaces *sedmlns);
 
 
   /**
@@ -0,0 +1,284 @@
+/**
+ * @file SedMockSimulator.cpp
+ * @brief Implementation of the SedMockSimulator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedMockSimulator.h>
+#include <sedml/SedTaskResult.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedOneStep.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <sbml/xml/XMLNode.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+SedMockSimulator::SedMockSimulator (unsigned int workPerPoint)
+  : SedSimulator()
+  , mWorkPerPoint(workPerPoint)
+  , mIds()
+  , mInitialValues()
+  , mValues()
+  , mIndex()
+  , mTime(0)
+{
+}
+
+
+SedMockSimulator::~SedMockSimulator ()
+{
+}
+
+
+int
+SedMockSimulator::loadModel (const SedModel*, const XMLNode* xml)
+{
+  mIds.clear();
+  mInitialValues.clear();
+  mIndex.clear();
+
+  if (xml != NULL) addQuantities(*xml);
+
+  return resetModel();
+}
+
+
+int
+SedMockSimulator::resetModel ()
+{
+  mValues = mInitialValues;
+  mTime = 0;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedMockSimulator::setValue (const SedSetValue* change, double value)
+{
+  int index = (change == NULL) ? -1 : findQuantity(change->getTarget());
+  if (index < 0) return LIBSEDML_OPERATION_FAILED;
+
+  mValues[index] = value;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedMockSimulator::simulate (const SedSimulation* simulation,
+                            SedTaskResult& result)
+{
+  if (simulation == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  switch (simulation->getTypeCode())
+  {
+  case SEDML_SIMULATION_UNIFORMTIMECOURSE:
+  {
+    const SedUniformTimeCourse* timeCourse =
+      static_cast<const SedUniformTimeCourse*>(simulation);
+    int numSteps = timeCourse->getNumberOfSteps();
+    double start = timeCourse->getOutputStartTime();
+    double end = timeCourse->getOutputEndTime();
+    if (numSteps < 0 || end < start) return LIBSEDML_OPERATION_FAILED;
+
+    mTime = timeCourse->getInitialTime();
+    advance(start - mTime);
+    addPoint(start, result);
+
+    for (int i = 1; i <= numSteps; ++i)
+    {
+      double time = start + (end - start) * i / numSteps;
+      advance(time - mTime);
+      addPoint(time, result);
+    }
+    break;
+  }
+
+  case SEDML_SIMULATION_ONESTEP:
+    addPoint(mTime, result);
+    advance(static_cast<const SedOneStep*>(simulation)->getStep());
+    addPoint(mTime, result);
+    break;
+
+  case SEDML_SIMULATION_STEADYSTATE:
+    // every quantity decays to zero
+    mValues.assign(mValues.size(), 0.0);
+    addPoint(mTime, result);
+    break;
+
+  default:
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+double
+SedMockSimulator::getVariableValue (const SedVariable* variable)
+{
+  if (variable == NULL) return numeric_limits<double>::quiet_NaN();
+
+  if (variable->getSymbol() == "urn:sedml:symbol:time") return mTime;
+
+  int index = findQuantity(variable->getTarget());
+  return (index < 0) ? numeric_limits<double>::quiet_NaN() : mValues[index];
+}
+
+
+unsigned int
+SedMockSimulator::getNumQuantities () const
+{
+  return (unsigned int)mIds.size();
+}
+
+
+const std::string&
+SedMockSimulator::getQuantityId (unsigned int n) const
+{
+  static const string empty;
+  return (n < mIds.size()) ? mIds[n] : empty;
+}
+
+
+double
+SedMockSimulator::getQuantityValue (const std::string& id) const
+{
+  IndexMap::const_iterator it = mIndex.find(id);
+  return (it == mIndex.end())
+    ? numeric_limits<double>::quiet_NaN() : mValues[it->second];
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+void
+SedMockSimulator::addQuantities (const XMLNode& xml)
+{
+  static const char* names[] =
+    { "value", "initialConcentration", "initialAmount", "size" };
+
+  if (xml.isElement() && xml.hasAttr("id"))
+  {
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+    {
+      if (!xml.hasAttr(names[i])) continue;
+
+      const string& id = xml.getAttrValue("id");
+      if (mIndex.find(id) == mIndex.end())
+      {
+        mIndex[id] = (unsigned int)mIds.size();
+        mIds.push_back(id);
+        mInitialValues.push_back(strtod(xml.getAttrValue(names[i]).c_str(), NULL));
+      }
+      break;
+    }
+  }
+
+  for (unsigned int i = 0; i < xml.getNumChildren(); ++i)
+  {
+    addQuantities(xml.getChild(i));
+  }
+}
+
+
+/*
+ * Returns the quantity named by the first "@id='...'" predicate of the
+ * given target.
+ */
+int
+SedMockSimulator::findQuantity (const std::string& target) const
+{
+  size_t pos = target.find("@id=");
+  if (pos == string::npos || pos + 5 > target.size()) return -1;
+
+  char quote = target[pos + 4];
+  if (quote != '\'' && quote != '"') return -1;
+
+  size_t end = target.find(quote, pos + 5);
+  if (end == string::npos) return -1;
+
+  IndexMap::const_iterator it = mIndex.find(target.substr(pos + 5, end - pos - 5));
+  return (it == mIndex.end()) ? -1 : (int)it->second;
+}
+
+
+void
+SedMockSimulator::advance (double duration)
+{
+  double factor = exp(-duration);
+  for (size_t i = 0; i < mValues.size(); ++i)
+  {
+    mValues[i] *= factor;
+  }
+  mTime += duration;
+}
+
+
+void
+SedMockSimulator::addPoint (double time, SedTaskResult& result)
+{
+  // stands in for the work of a solver step
+  volatile double work = 0;
+  for (unsigned int i = 0; i < mWorkPerPoint; ++i)
+  {
+    work = work + sqrt((double)i);
+  }
+
+  result.addColumn("time").push_back(time);
+  for (size_t i = 0; i < mIds.size(); ++i)
+  {
+    result.addColumn(mIds[i]).push_back(mValues[i]);
+  }
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,153 @@
+/**
+ * @file SedMockSimulator.h
+ * @brief Definition of the SedMockSimulator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedMockSimulator
+ * @sbmlbrief{} A SedSimulator that needs no solver, for tests and
+ * benchmarks.
+ *
+ * The SedMockSimulator treats every element of the model that has an
+ * "id" and a "value", "initialConcentration", "initialAmount" or "size"
+ * attribute as a quantity that decays exponentially at rate 1, so that
+ * its value after a time @em t is its initial value times exp(-@em t).
+ * Uniform time courses, one step and steady state simulations are
+ * supported; the output has a "time" column and a column per quantity.
+ * Changes and variables refer to quantities by targets of the form
+ * <code>...[@id='name']...</code>.
+ *
+ * To measure the scaling of SedTaskExecutor, each output point can be
+ * made to cost a configurable amount of computation.
+ */
+
+
+#ifndef SedMockSimulator_h
+#define SedMockSimulator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedSimulator.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedMockSimulator : public SedSimulator
+{
+public:
+
+  /**
+   * Creates a new SedMockSimulator.
+   *
+   * @param workPerPoint the number of floating point operations spent on
+   * every output point, to simulate the cost of a real solver.
+   */
+  explicit SedMockSimulator (unsigned int workPerPoint = 0);
+
+
+  /**
+   * Destroys this SedMockSimulator.
+   */
+  virtual ~SedMockSimulator ();
+
+
+  virtual int loadModel (const SedModel* model,
+                         const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* xml);
+
+
+  virtual int resetModel ();
+
+
+  virtual int setValue (const SedSetValue* change, double value);
+
+
+  virtual int simulate (const SedSimulation* simulation,
+                        SedTaskResult& result);
+
+
+  virtual double getVariableValue (const SedVariable* variable);
+
+
+  /**
+   * @return the number of quantities of the loaded model.
+   */
+  unsigned int getNumQuantities () const;
+
+
+  /**
+   * @return the id of the nth quantity, or an empty string.
+   */
+  const std::string& getQuantityId (unsigned int n) const;
+
+
+  /**
+   * @return the current value of the quantity with the given id, or NaN
+   * if there is no such quantity.
+   */
+  double getQuantityValue (const std::string& id) const;
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  typedef std::unordered_map<std::string, unsigned int> IndexMap;
+
+  void addQuantities (const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& xml);
+  int findQuantity (const std::string& target) const;
+  void advance (double duration);
+  void addPoint (double time, SedTaskResult& result);
+
+  unsigned int mWorkPerPoint;
+  std::vector<std::string> mIds;
+  std::vector<double> mInitialValues;
+  std::vector<double> mValues;
+  IndexMap mIndex;
+  double mTime;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedMockSimulator_h */
@@ -73,7 +73,7 @@ SedModel::SedModel(unsigned int level, unsigned int version)
 /*
  * Creates a new SedModel using the given SedNamespaces object @p sedmlns.
  */
-SedModel::SedModel(SedNamespaces *sedmlns)
+SedModel::SedModel(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mLanguage ("")
   , mSource ("")
@@ -534,7 +534,46 @@ SedModel::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedModel::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedModel
+ */
+unsigned int
+SedModel::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mChanges
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedModel
+ */
+const SedBase*
+SedModel::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mChanges
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
@@ -0,0 +1,631 @@
+/**
+ * @file SedModelBuilder.cpp
+ * @brief Implementation of the SedModelBuilder class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedModelBuilder.h>
+#include <sedml/SedXPathSelector.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedAddXML.h>
+#include <sedml/SedChangeXML.h>
+#include <sedml/SedRemoveXML.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <sbml/SBMLDocument.h>
+#include <sbml/SBMLReader.h>
+#include <sbml/SBMLWriter.h>
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLErrorLog.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Returns the index of the attribute with the given local name, or -1.
+ */
+static int
+getAttributeIndex(const XMLNode& element, const std::string& name)
+{
+  for (int i = 0; i < element.getAttributesLength(); ++i)
+  {
+    if (element.getAttrName(i) == name) return i;
+  }
+
+  return -1;
+}
+
+
+/*
+ * Sets the attribute with the given local name, keeping its prefix.
+ */
+static void
+setAttribute(XMLNode& element, const std::string& name,
+             const std::string& value)
+{
+  int index = getAttributeIndex(element, name);
+  if (index < 0)
+  {
+    element.addAttr(name, value);
+  }
+  else
+  {
+    element.addAttr(name, value, element.getAttrURI(index),
+                    element.getAttrPrefix(index));
+  }
+}
+
+
+/*
+ * Formats the given value with as few digits as still read back exactly.
+ */
+static std::string
+formatValue(double value)
+{
+  if (value != value) return "NaN";
+  if (std::isinf(value)) return (value > 0) ? "INF" : "-INF";
+
+  ostringstream str;
+  str.precision(15);
+  str << value;
+
+  if (strtod(str.str().c_str(), NULL) != value)
+  {
+    str.str("");
+    str.precision(17);
+    str << value;
+  }
+
+  return str.str();
+}
+
+
+/*
+ * Returns the nodes held by the newXML of a change: either the single
+ * node, or the children of the unnamed node wrapping several of them.
+ */
+static void
+getNewNodes(const XMLNode& newXML, std::vector<const XMLNode*>& nodes)
+{
+  if (newXML.isText() || !newXML.getName().empty())
+  {
+    nodes.push_back(&newXML);
+    return;
+  }
+
+  for (unsigned int i = 0; i < newXML.getNumChildren(); ++i)
+  {
+    nodes.push_back(&newXML.getChild(i));
+  }
+}
+
+
+static XMLNode*
+readXML(XMLInputStream& stream)
+{
+  stream.skipText();
+  if (!stream.isGood()) return NULL;
+
+  XMLNode* xml = new XMLNode(stream);
+  if (stream.isError() || !xml->isElement())
+  {
+    delete xml;
+    return NULL;
+  }
+
+  return xml;
+}
+
+/** @endcond */
+
+
+SedModelBuilder::SedModelBuilder (const SedDocument* document)
+  : mDocument(document)
+  , mBaseDirectory()
+  , mSuppliedSources()
+  , mSources()
+  , mModels()
+  , mSelectors()
+  , mBuilding()
+{
+}
+
+
+SedModelBuilder::~SedModelBuilder ()
+{
+  clearCache();
+
+  for (NodeMap::iterator it = mSuppliedSources.begin();
+       it != mSuppliedSources.end(); ++it)
+  {
+    delete it->second;
+  }
+
+  for (SelectorMap::iterator it = mSelectors.begin();
+       it != mSelectors.end(); ++it)
+  {
+    delete it->second;
+  }
+}
+
+
+void
+SedModelBuilder::setBaseDirectory (const std::string& directory)
+{
+  mBaseDirectory = directory;
+}
+
+
+const std::string&
+SedModelBuilder::getBaseDirectory () const
+{
+  return mBaseDirectory;
+}
+
+
+int
+SedModelBuilder::setModelSource (const std::string& source,
+                                 const XMLNode& xml)
+{
+  if (source.empty() || source[0] == '#')
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  NodeMap::iterator it = mSuppliedSources.find(source);
+  if (it != mSuppliedSources.end())
+  {
+    delete it->second;
+    it->second = new XMLNode(xml);
+  }
+  else
+  {
+    mSuppliedSources[source] = new XMLNode(xml);
+  }
+
+  // any model might have been derived from the previous source
+  clearCache();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+const XMLNode*
+SedModelBuilder::getModel (const std::string& modelId)
+{
+  NodeMap::const_iterator it = mModels.find(modelId);
+  if (it != mModels.end()) return it->second;
+
+  const SedModel* model =
+    (mDocument == NULL) ? NULL : mDocument->getModel(modelId);
+  if (model == NULL) return NULL;
+
+  // a model that is being built already has circular sources
+  if (!mBuilding.insert(modelId).second) return NULL;
+
+  const string& source = model->getSource();
+  const XMLNode* base = (!source.empty() && source[0] == '#')
+    ? getModel(source.substr(1))
+    : getSource(source);
+
+  XMLNode* xml = NULL;
+  if (base != NULL)
+  {
+    xml = new XMLNode(*base);
+    if (applyChanges(model, *xml) != LIBSEDML_OPERATION_SUCCESS)
+    {
+      delete xml;
+      xml = NULL;
+    }
+  }
+
+  mBuilding.erase(modelId);
+
+  if (xml != NULL) mModels[modelId] = xml;
+  return xml;
+}
+
+
+XMLNode*
+SedModelBuilder::createModel (const std::string& modelId)
+{
+  const XMLNode* xml = getModel(modelId);
+  return (xml == NULL) ? NULL : new XMLNode(*xml);
+}
+
+
+int
+SedModelBuilder::applyChanges (const SedModel* model, XMLNode& xml)
+{
+  if (model == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  // compute changes referring to the model itself see the changes so far
+  bool isBuilding = !mBuilding.insert(model->getId()).second;
+
+  int result = LIBSEDML_OPERATION_SUCCESS;
+  for (unsigned int i = 0; i < model->getNumChanges(); ++i)
+  {
+    result = applyChange(model->getChange(i), xml);
+    if (result != LIBSEDML_OPERATION_SUCCESS) break;
+  }
+
+  if (!isBuilding) mBuilding.erase(model->getId());
+  return result;
+}
+
+
+int
+SedModelBuilder::applyChanges (const SedModel* model,
+                               SBMLDocument* document)
+{
+  if (model == NULL || document == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  string sbml = writeSBMLToStdString(document);
+  XMLErrorLog log;
+  XMLInputStream stream(sbml.c_str(), false, "", &log);
+
+  XMLNode* xml = readXML(stream);
+  if (xml == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  int result = applyChanges(model, *xml);
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+  {
+    string changed = XMLNode::convertXMLNodeToString(xml);
+    SBMLDocument* copy = readSBMLFromString(changed.c_str());
+
+    if (copy == NULL || copy->getNumErrors(LIBSBML_SEV_FATAL) > 0)
+    {
+      result = LIBSEDML_OPERATION_FAILED;
+    }
+    else
+    {
+      *document = *copy;
+    }
+
+    delete copy;
+  }
+
+  delete xml;
+  return result;
+}
+
+
+int
+SedModelBuilder::applyChange (const SedChange* change, XMLNode& xml)
+{
+  if (change == NULL || !change->isSetTarget())
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  const SedXPathSelector* selector = getSelector(change->getTarget());
+  if (!selector->isCompiled()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  int type = change->getTypeCode();
+
+  if (type == SEDML_CHANGE_COMPUTECHANGE)
+  {
+    const SedComputeChange* compute =
+      static_cast<const SedComputeChange*>(change);
+    if (!compute->isSetMath()) return LIBSEDML_INVALID_OBJECT;
+
+    return applyValue(change->getTarget(), evaluate(compute, xml), xml);
+  }
+
+  bool isAttributeChange =
+    (type == SEDML_CHANGE_ATTRIBUTE || type == SEDML_CHANGE_REMOVEXML);
+  if (selector->selectsAttribute() && !isAttributeChange)
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  vector<const XMLNode*> nodes;
+  switch (type)
+  {
+  case SEDML_CHANGE_ATTRIBUTE:
+    if (!selector->selectsAttribute()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    if (!static_cast<const SedChangeAttribute*>(change)->isSetNewValue())
+    {
+      return LIBSEDML_INVALID_OBJECT;
+    }
+    break;
+
+  case SEDML_CHANGE_ADDXML:
+    if (static_cast<const SedAddXML*>(change)->getNewXML() == NULL)
+    {
+      return LIBSEDML_INVALID_OBJECT;
+    }
+    getNewNodes(*static_cast<const SedAddXML*>(change)->getNewXML(), nodes);
+    break;
+
+  case SEDML_CHANGE_CHANGEXML:
+    if (static_cast<const SedChangeXML*>(change)->getNewXML() == NULL)
+    {
+      return LIBSEDML_INVALID_OBJECT;
+    }
+    getNewNodes(*static_cast<const SedChangeXML*>(change)->getNewXML(), nodes);
+    break;
+
+  case SEDML_CHANGE_REMOVEXML:
+    break;
+
+  default:
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  vector<SedXPathSelector::Match> matches;
+  if (selector->select(xml, matches) == 0) return LIBSEDML_OPERATION_FAILED;
+
+  if (type == SEDML_CHANGE_ATTRIBUTE)
+  {
+    const string& value =
+      static_cast<const SedChangeAttribute*>(change)->getNewValue();
+    for (size_t i = 0; i < matches.size(); ++i)
+    {
+      setAttribute(*matches[i].element, selector->getAttributeName(), value);
+    }
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  if (type == SEDML_CHANGE_ADDXML)
+  {
+    for (size_t i = 0; i < matches.size(); ++i)
+    {
+      for (size_t n = 0; n < nodes.size(); ++n)
+      {
+        matches[i].element->addChild(*nodes[n]);
+      }
+    }
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  // removing elements in reverse document order keeps the indices of the
+  // remaining matches valid
+  for (size_t i = matches.size(); i-- > 0; )
+  {
+    const SedXPathSelector::Match& match = matches[i];
+
+    if (type == SEDML_CHANGE_REMOVEXML && selector->selectsAttribute())
+    {
+      int index =
+        getAttributeIndex(*match.element, selector->getAttributeName());
+      if (index >= 0) match.element->removeAttr(index);
+      continue;
+    }
+
+    if (match.parent == NULL)
+    {
+      // the root element can only be replaced by a single element
+      if (type == SEDML_CHANGE_REMOVEXML
+        || nodes.size() != 1 || !nodes[0]->isElement())
+      {
+        return LIBSEDML_OPERATION_FAILED;
+      }
+
+      xml = *nodes[0];
+      continue;
+    }
+
+    delete match.parent->removeChild(match.index);
+
+    for (size_t n = nodes.size(); n-- > 0; )
+    {
+      match.parent->insertChild(match.index, *nodes[n]);
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedModelBuilder::applyValue (const std::string& target, double value,
+                             XMLNode& xml)
+{
+  const SedXPathSelector* selector = getSelector(target);
+  if (!selector->isCompiled() || !selector->selectsAttribute())
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  vector<SedXPathSelector::Match> matches;
+  if (selector->select(xml, matches) == 0) return LIBSEDML_OPERATION_FAILED;
+
+  string str = formatValue(value);
+  for (size_t i = 0; i < matches.size(); ++i)
+  {
+    setAttribute(*matches[i].element, selector->getAttributeName(), str);
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+double
+SedModelBuilder::evaluate (const SedComputeChange* change, const XMLNode& xml)
+{
+  SedCompiledMath math;
+  if (math.compile(change) != LIBSEDML_OPERATION_SUCCESS)
+  {
+    return numeric_limits<double>::quiet_NaN();
+  }
+
+  for (unsigned int i = 0; i < change->getNumVariables(); ++i)
+  {
+    const SedVariable* variable = change->getVariable(i);
+    math.setSlotValue(math.getSlotIndex(variable->getId()),
+                      getValue(variable, xml));
+  }
+
+  return math.evaluate();
+}
+
+
+const SedXPathSelector*
+SedModelBuilder::getSelector (const std::string& target)
+{
+  SelectorMap::const_iterator it = mSelectors.find(target);
+  if (it != mSelectors.end()) return it->second;
+
+  SedXPathSelector* selector = new SedXPathSelector(target);
+  mSelectors[target] = selector;
+  return selector;
+}
+
+
+void
+SedModelBuilder::clearCache ()
+{
+  for (NodeMap::iterator it = mModels.begin(); it != mModels.end(); ++it)
+  {
+    delete it->second;
+  }
+  mModels.clear();
+
+  for (NodeMap::iterator it = mSources.begin(); it != mSources.end(); ++it)
+  {
+    delete it->second;
+  }
+  mSources.clear();
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Returns the unchanged XML of the given source, reading it on first use.
+ */
+const XMLNode*
+SedModelBuilder::getSource (const std::string& source)
+{
+  if (source.empty()) return NULL;
+
+  NodeMap::const_iterator it = mSuppliedSources.find(source);
+  if (it != mSuppliedSources.end()) return it->second;
+
+  it = mSources.find(source);
+  if (it != mSources.end()) return it->second;
+
+  string path = source;
+  if (path.compare(0, 7, "file://") == 0) path = path.substr(7);
+  if (path.empty()) return NULL;
+
+  bool isAbsolute = (path[0] == '/' || path[0] == '\\'
+    || (path.size() > 1 && path[1] == ':'));
+  if (!isAbsolute && !mBaseDirectory.empty())
+  {
+    path = mBaseDirectory + "/" + path;
+  }
+
+  XMLErrorLog log;
+  XMLInputStream stream(path.c_str(), true, "", &log);
+
+  XMLNode* xml = readXML(stream);
+  if (xml != NULL) mSources[source] = xml;
+  return xml;
+}
+
+
+/*
+ * Returns the value of the model element selected by the target of the
+ * given variable.
+ */
+double
+SedModelBuilder::getValue (const SedVariable* variable, const XMLNode& xml)
+{
+  const double nan = numeric_limits<double>::quiet_NaN();
+  if (!variable->isSetTarget()) return nan;
+
+  const XMLNode* model = &xml;
+  const string& reference = variable->getModelReference();
+  if (!reference.empty() && mBuilding.find(reference) == mBuilding.end())
+  {
+    model = getModel(reference);
+    if (model == NULL) return nan;
+  }
+
+  const SedXPathSelector* selector = getSelector(variable->getTarget());
+
+  // selecting does not modify the tree
+  XMLNode* element = selector->selectFirst(const_cast<XMLNode&>(*model));
+  if (element == NULL) return nan;
+
+  int index = -1;
+  if (selector->selectsAttribute())
+  {
+    index = getAttributeIndex(*element, selector->getAttributeName());
+  }
+  else
+  {
+    static const char* names[] =
+      { "value", "initialConcentration", "initialAmount", "size" };
+    for (size_t i = 0; index < 0 && i < sizeof(names) / sizeof(names[0]); ++i)
+    {
+      index = getAttributeIndex(*element, names[i]);
+    }
+  }
+
+  if (index < 0) return nan;
+
+  const string value = element->getAttrValue(index);
+  char* end = NULL;
+  double result = strtod(value.c_str(), &end);
+  return (end == value.c_str()) ? nan : result;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,315 @@
+/**
+ * @file SedModelBuilder.h
+ * @brief Definition of the SedModelBuilder class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedModelBuilder
+ * @sbmlbrief{} Builds the models of a SED-ML document by applying their
+ * changes.
+ *
+ * A SedModelBuilder reads the source of each model of a SedDocument and
+ * applies the changes listed for it: SedChangeAttribute, SedAddXML,
+ * SedChangeXML, SedRemoveXML and SedComputeChange.  The target of every
+ * change is compiled into a SedXPathSelector only once, and reused for all
+ * models and all later applications of a change with the same target.
+ *
+ * Models are built as XMLNode trees that the builder caches.  A model whose
+ * source is <code>\#otherModel</code> is built from a copy of the cached
+ * tree of @c otherModel, so that a chain of derived models reads the
+ * underlying source file only once and applies each list of changes only
+ * once.  Source files are resolved relative to the base directory, and
+ * sources that cannot be read from disk (such as URNs) can be supplied
+ * with setModelSource().
+ *
+ * @code{.cpp}
+SedModelBuilder builder(doc);
+builder.setBaseDirectory("/path/to/archive");
+
+const XMLNode* xml = builder.getModel("model2");
+if (xml != NULL)
+{
+  std::string sbml = XMLNode::convertXMLNodeToString(xml);
+  // ... pass the changed model to a simulator
+}
+ * @endcode
+ */
+
+
+#ifndef SedModelBuilder_h
+#define SedModelBuilder_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sbml/common/libsbml-namespace.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+class XMLNode;
+class SBMLDocument;
+LIBSBML_CPP_NAMESPACE_END
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedModel;
+class SedChange;
+class SedComputeChange;
+class SedVariable;
+class SedXPathSelector;
+
+
+class LIBSEDML_EXTERN SedModelBuilder
+{
+public:
+
+  /**
+   * Creates a new SedModelBuilder for the models of the given document.
+   *
+   * @param document the SED-ML document; it has to outlive this builder.
+   */
+  explicit SedModelBuilder (const SedDocument* document);
+
+
+  /**
+   * Destroys this SedModelBuilder, along with all cached models.
+   */
+  ~SedModelBuilder ();
+
+
+  /**
+   * Sets the directory that relative model sources are resolved against.
+   *
+   * @param directory the base directory.
+   */
+  void setBaseDirectory (const std::string& directory);
+
+
+  /**
+   * @return the directory that relative model sources are resolved against.
+   */
+  const std::string& getBaseDirectory () const;
+
+
+  /**
+   * Supplies the XML for the given model source, so that it is not read
+   * from disk.  Models built from the source before are discarded.
+   *
+   * @param source the value of the "source" attribute of a model.
+   * @param xml the root element of the model.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if @p source is empty or refers to another model.
+   */
+  int setModelSource (const std::string& source,
+                      const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& xml);
+
+
+  /**
+   * Returns the model with the given id, with all its changes applied.
+   *
+   * The model is built on the first call and cached afterwards.
+   *
+   * @param modelId the id of a SedModel of the document.
+   *
+   * @return the root element of the changed model, owned by this builder,
+   * or @c NULL if there is no such model, if its source cannot be read, if
+   * its sources are circular or if one of its changes cannot be applied.
+   */
+  const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* getModel (
+    const std::string& modelId);
+
+
+  /**
+   * Returns a copy of the model with the given id, with all its changes
+   * applied.
+   *
+   * @param modelId the id of a SedModel of the document.
+   *
+   * @return a new XMLNode owned by the caller, or @c NULL if getModel()
+   * fails.
+   */
+  LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* createModel (
+    const std::string& modelId);
+
+
+  /**
+   * Applies the changes of the given model, in order, to the given XML.
+   * Changes following a failed one are not applied.
+   *
+   * @param model the model whose changes are applied.
+   * @param xml the root element of the XML to change.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   */
+  int applyChanges (const SedModel* model,
+                    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& xml);
+
+
+  /**
+   * Applies the changes of the given model, in order, to the given libSBML
+   * document, which is replaced by the changed model.
+   *
+   * @param model the model whose changes are applied.
+   * @param document the SBML document to change.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if a change cannot be applied, or the changed model is no valid SBML.
+   */
+  int applyChanges (const SedModel* model,
+                    LIBSBML_CPP_NAMESPACE_QUALIFIER SBMLDocument* document);
+
+
+  /**
+   * Applies a single change to the given XML.
+   *
+   * @param change the change to apply.
+   * @param xml the root element of the XML to change.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if @p change is @c NULL or lacks required attributes or elements.
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if the target of @p change is not supported.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if the target of @p change selects nothing.
+   */
+  int applyChange (const SedChange* change,
+                   LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& xml);
+
+
+  /**
+   * Sets the attribute selected by the given target to the given value.
+   *
+   * @param target an XPath expression ending in an attribute step.
+   * @param value the new value.
+   * @param xml the root element of the XML to change.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if @p target is not supported or does not select an attribute.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if @p target selects nothing.
+   */
+  int applyValue (const std::string& target, double value,
+                  LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& xml);
+
+
+  /**
+   * Evaluates the math of the given compute change.
+   *
+   * Variables without a model reference take their value from the given
+   * XML; other variables from the referenced model, as returned by
+   * getModel().  A variable whose target selects an attribute takes the
+   * value of that attribute, otherwise the first of the "value",
+   * "initialConcentration", "initialAmount" and "size" attributes of the
+   * selected element is used.
+   *
+   * @param change the compute change.
+   * @param xml the root element of the model being changed.
+   *
+   * @return the new value, or NaN if it cannot be computed.
+   */
+  double evaluate (const SedComputeChange* change,
+                   const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& xml);
+
+
+  /**
+   * Returns the compiled selector for the given target.
+   *
+   * @param target an XPath expression.
+   *
+   * @return the selector, owned by this builder; check
+   * SedXPathSelector::isCompiled() to see whether @p target is supported.
+   */
+  const SedXPathSelector* getSelector (const std::string& target);
+
+
+  /**
+   * Discards all cached models and sources.  Compiled selectors and
+   * sources supplied with setModelSource() are kept.
+   */
+  void clearCache ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  SedModelBuilder (const SedModelBuilder& orig);
+  SedModelBuilder& operator= (const SedModelBuilder& rhs);
+
+  typedef std::unordered_map<std::string,
+    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode*> NodeMap;
+  typedef std::unordered_map<std::string, SedXPathSelector*> SelectorMap;
+
+  const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* getSource (
+    const std::string& source);
+  double getValue (const SedVariable* variable,
+                   const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& xml);
+
+  const SedDocument* mDocument;
+  std::string mBaseDirectory;
+  NodeMap mSuppliedSources;
+  NodeMap mSources;
+  NodeMap mModels;
+  SelectorMap mSelectors;
+  std::unordered_set<std::string> mBuilding;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedModelBuilder_h */
@@ -37,6 +37,9 @@
 #include <sstream>
 #include <sedml/common/common.h>
 #include <iostream>
+#include <atomic>
+#include <mutex>
+#include <map>
 
 /** @cond doxygenIgnored */
 
@@ -50,44 +53,144 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
 /** @cond doxygenLibsedmlInternal */
-void 
-SedNamespaces::initSedNamespace()
+
+/*
+ * The XML namespaces of a SedNamespaces object, shared between all copies
+ * until one of them modifies it.
+ */
+struct SedSharedXMLNamespaces
 {
-  if (mNamespaces != NULL)
-    delete mNamespaces;
-  mNamespaces = new XMLNamespaces();
+  SedSharedXMLNamespaces()
+    : mXmlns()
+    , mRefCount(1)
+  {
+  }
 
-  switch (mLevel)
+  SedSharedXMLNamespaces(const XMLNamespaces& orig)
+    : mXmlns(orig)
+    , mRefCount(1)
   {
-  case 1:
-  default:
-    switch (mVersion)
-    {
-    case 1:
-      mNamespaces->add(SEDML_XMLNS_L1V1);
-      break;
-    case 2:
-      mNamespaces->add(SEDML_XMLNS_L1V2);
-      break;
-    case 3:
-    default:
-      mNamespaces->add(SEDML_XMLNS_L1V3);
-      break;
-    case 4:
-      mNamespaces->add(SEDML_XMLNS_L1V4);
-      break;
-    }
-    break;
   }
 
-  if (mNamespaces->getLength() == 0)
+  XMLNamespaces mXmlns;
+  std::atomic<unsigned int> mRefCount;
+};
+
+
+static SedSharedXMLNamespaces*
+createInternedNamespaces(const char* uri)
+{
+  SedSharedXMLNamespaces* result = new SedSharedXMLNamespaces();
+  result->mXmlns.add(uri);
+  return result;
+}
+
+
+/*
+ * Returns the interned default namespaces for the given SED-ML namespace
+ * URI, or NULL if it is not one.  The table entries are never freed, so
+ * that SedNamespaces objects that are destroyed during static destruction
+ * can still release their reference.
+ */
+static SedSharedXMLNamespaces*
+findInternedNamespaces(const std::string& uri)
+{
+  static const char* uris[] = {
+    SEDML_XMLNS_L1V1,
+    SEDML_XMLNS_L1V2,
+    SEDML_XMLNS_L1V3,
+    SEDML_XMLNS_L1V4
+  };
+  static SedSharedXMLNamespaces* table[] = {
+    createInternedNamespaces(uris[0]),
+    createInternedNamespaces(uris[1]),
+    createInternedNamespaces(uris[2]),
+    createInternedNamespaces(uris[3])
+  };
+
+  for (size_t i = 0; i < 4; ++i)
+  {
+    if (uri == uris[i])
+      return table[i];
+  }
+
+  return NULL;
+}
+
+
+/*
+ * Returns the interned default namespaces for the given SED-ML namespace
+ * URI with an additional reference held by the caller.
+ */
+static SedSharedXMLNamespaces*
+getInternedNamespaces(const std::string& uri)
+{
+  SedSharedXMLNamespaces* result = findInternedNamespaces(uri);
+  if (result != NULL)
+    ++result->mRefCount;
+  return result;
+}
+
+
+void 
+SedNamespaces::initSedNamespace()
+{
+  releaseNamespaces();
+
+  mNamespaces = getInternedNamespaces(getSedNamespaceURI(mLevel, mVersion));
+
+  if (mNamespaces == NULL)
   {
     mLevel = SEDML_INT_MAX;
     mVersion = SEDML_INT_MAX;
-    delete mNamespaces;
-    mNamespaces = NULL;
   }
 }
+
+
+void
+SedNamespaces::releaseNamespaces()
+{
+  if (mNamespaces != NULL && --mNamespaces->mRefCount == 0)
+    delete mNamespaces;
+  mNamespaces = NULL;
+}
+
+
+void
+SedNamespaces::detachNamespaces()
+{
+  // if we hold the only reference nobody else can acquire a new one
+  if (mNamespaces == NULL || mNamespaces->mRefCount == 1) return;
+
+  SedSharedXMLNamespaces* copy =
+    new SedSharedXMLNamespaces(mNamespaces->mXmlns);
+  releaseNamespaces();
+  mNamespaces = copy;
+}
+
+
+bool
+SedNamespaces::hasDefaultNamespaces() const
+{
+  return mNamespaces != NULL &&
+    mNamespaces == findInternedNamespaces(getSedNamespaceURI(mLevel, mVersion));
+}
+
+
+SedNamespaces*
+SedNamespaces::share(SedNamespaces* sedmlns)
+{
+  sedmlns->mSharedCount = 1;
+  return sedmlns;
+}
+
+
+SedNamespaces*
+SedNamespaces::shareWithoutNamespaces(SedNamespaces* sedmlns)
+{
+  sedmlns->releaseNamespaces();
+  return share(sedmlns);
+}
 /** @endcond */
 
 
@@ -95,6 +198,7 @@ SedNamespaces::SedNamespaces(unsigned int level, unsigned int version)
  : mLevel(level)
   ,mVersion(version)
   ,mNamespaces(NULL)
+  ,mSharedCount(0)
 {
   initSedNamespace();
 }
@@ -102,8 +206,7 @@ SedNamespaces::SedNamespaces(unsigned int level, unsigned int version)
 
 SedNamespaces::~SedNamespaces()
 {
-  if (mNamespaces != NULL)
-    delete mNamespaces;
+  releaseNamespaces();
 }
 
 
@@ -113,11 +216,11 @@ SedNamespaces::~SedNamespaces()
 SedNamespaces::SedNamespaces(const SedNamespaces& orig)
  : mLevel(orig.mLevel)
  , mVersion(orig.mVersion)
- , mNamespaces(NULL)
+ , mNamespaces(orig.mNamespaces)
+ , mSharedCount(0)
 {
-  if(orig.mNamespaces != NULL)
-    this->mNamespaces = 
-          new XMLNamespaces(*const_cast<SedNamespaces&>(orig).mNamespaces);
+  if (mNamespaces != NULL)
+    ++mNamespaces->mRefCount;
 }
 
 
@@ -154,12 +257,10 @@ SedNamespaces::operator=(const SedNamespaces& rhs)
   {
     mLevel   = rhs.mLevel;
     mVersion = rhs.mVersion;
-    delete this->mNamespaces;
-    if(rhs.mNamespaces != NULL)
-      this->mNamespaces = 
-            new XMLNamespaces(*const_cast<SedNamespaces&>(rhs).mNamespaces);
-    else
-      this->mNamespaces = NULL;
+    if (rhs.mNamespaces != NULL)
+      ++rhs.mNamespaces->mRefCount;
+    releaseNamespaces();
+    mNamespaces = rhs.mNamespaces;
   }
 
   return *this;
@@ -246,14 +347,15 @@ SedNamespaces::getVersion() const
 XMLNamespaces * 
 SedNamespaces::getNamespaces()
 {
-  return mNamespaces;
+  detachNamespaces();
+  return mNamespaces != NULL ? &mNamespaces->mXmlns : NULL;
 }
 
 
 const XMLNamespaces * 
 SedNamespaces::getNamespaces() const
 {
-  return mNamespaces;
+  return mNamespaces != NULL ? &mNamespaces->mXmlns : NULL;
 }
 
 
@@ -275,9 +377,10 @@ SedNamespaces::addNamespaces(const XMLNamespaces * xmlns)
    */
   for (int i = 0; i < xmlns->getLength(); i++)
   {
-    if (mNamespaces != NULL && !(mNamespaces->hasNS(xmlns->getURI(i), xmlns->getPrefix(i))))
+    if (mNamespaces != NULL && !(mNamespaces->mXmlns.hasNS(xmlns->getURI(i), xmlns->getPrefix(i))))
     {
-      success = mNamespaces->add(xmlns->getURI(i), xmlns->getPrefix(i));
+      detachNamespaces();
+      success = mNamespaces->mXmlns.add(xmlns->getURI(i), xmlns->getPrefix(i));
     }
   }
 
@@ -293,7 +396,11 @@ SedNamespaces::addNamespace(const std::string &uri, const std::string &prefix)
     initSedNamespace();
   }
 
-  return mNamespaces != NULL ? mNamespaces->add(uri, prefix) : LIBSEDML_INVALID_OBJECT;
+  if (mNamespaces == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  detachNamespaces();
+  return mNamespaces->mXmlns.add(uri, prefix);
 }
 
 
@@ -305,7 +412,11 @@ SedNamespaces::removeNamespace(const std::string &uri)
     initSedNamespace();
   }
 
-  return mNamespaces != NULL ? mNamespaces->remove(mNamespaces->getIndex(uri)) : LIBSEDML_INVALID_OBJECT;
+  if (mNamespaces == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  detachNamespaces();
+  return mNamespaces->mXmlns.remove(mNamespaces->mXmlns.getIndex(uri));
 }
 
 
@@ -328,7 +439,8 @@ SedNamespaces::isValidCombination()
   bool sedmlDeclared = false;
   std::string declaredURI("");
   unsigned int version = getVersion();
-  XMLNamespaces *xmlns = getNamespaces();
+  const XMLNamespaces *xmlns =
+    (mNamespaces != NULL) ? &mNamespaces->mXmlns : NULL;
 
   if (xmlns != NULL)
   {
@@ -452,11 +564,185 @@ SedNamespaces::setVersion(unsigned int version)
 void 
 SedNamespaces::setNamespaces(XMLNamespaces * xmlns)
 {
-  delete mNamespaces;
+  releaseNamespaces();
   if (xmlns != NULL)
-    mNamespaces = xmlns->clone();
-  else
-    mNamespaces = NULL;
+    mNamespaces = new SedSharedXMLNamespaces(*xmlns);
+}
+
+
+/*
+ * The SED-ML namespace URIs, which are interned for good; any other URI
+ * is only kept while elements refer to it (see releaseURI())
+ */
+static const std::string* const*
+getSedmlURIs()
+{
+  static const std::string* sedmlURIs[] = {
+    new std::string(""),
+    new std::string(SEDML_XMLNS_L1V1),
+    new std::string(SEDML_XMLNS_L1V2),
+    new std::string(SEDML_XMLNS_L1V3),
+    new std::string(SEDML_XMLNS_L1V4)
+  };
+  return sedmlURIs;
+}
+
+
+/* the number of entries returned by getSedmlURIs() */
+static const size_t SED_NUM_SEDML_URIS = 5;
+
+
+/* the other interned URIs, with the number of references to each */
+struct SedInternedURIs
+{
+  std::mutex mMutex;
+  std::map<std::string, unsigned int> mURIs;
+};
+
+
+static SedInternedURIs&
+getOtherURIs()
+{
+  // like the SED-ML URIs this is never freed, as elements may be
+  // destroyed during static destruction
+  static SedInternedURIs* others = new SedInternedURIs();
+  return *others;
+}
+
+
+const std::string&
+SedNamespaces::internURI(const std::string& uri)
+{
+  const std::string* const* sedmlURIs = getSedmlURIs();
+  for (size_t i = 0; i < SED_NUM_SEDML_URIS; ++i)
+  {
+    if (uri == *sedmlURIs[i])
+      return *sedmlURIs[i];
+  }
+
+  SedInternedURIs& others = getOtherURIs();
+  std::lock_guard<std::mutex> lock(others.mMutex);
+  std::map<std::string, unsigned int>::iterator it =
+    others.mURIs.insert(std::make_pair(uri, 0u)).first;
+  ++it->second;
+  return it->first;
+}
+
+
+void
+SedNamespaces::releaseURI(const std::string& uri)
+{
+  const std::string* const* sedmlURIs = getSedmlURIs();
+  for (size_t i = 0; i < SED_NUM_SEDML_URIS; ++i)
+  {
+    if (&uri == sedmlURIs[i])
+      return;
+  }
+
+  SedInternedURIs& others = getOtherURIs();
+  std::lock_guard<std::mutex> lock(others.mMutex);
+  std::map<std::string, unsigned int>::iterator it = others.mURIs.find(uri);
+  if (it != others.mURIs.end() && --it->second == 0)
+    others.mURIs.erase(it);
+}
+
+
+SedNamespaces*
+SedNamespaces::acquireShared(const SedNamespaces* sedmlns)
+{
+  if (sedmlns == NULL)
+    return NULL;
+
+  // the caller refers to a shared object, so its count cannot drop to
+  // zero while we add our reference
+  if (sedmlns->mSharedCount > 0)
+  {
+    ++sedmlns->mSharedCount;
+    return const_cast<SedNamespaces*>(sedmlns);
+  }
+
+  if (sedmlns->hasDefaultNamespaces())
+    return acquireShared(sedmlns->mLevel, sedmlns->mVersion);
+
+  return share(sedmlns->clone());
+}
+
+
+SedNamespaces*
+SedNamespaces::acquireShared(unsigned int level, unsigned int version)
+{
+  // the table keeps a reference of its own, so that these are never freed
+  static SedNamespaces* defaults[] = {
+    share(new SedNamespaces(1, 1)),
+    share(new SedNamespaces(1, 2)),
+    share(new SedNamespaces(1, 3)),
+    share(new SedNamespaces(1, 4))
+  };
+
+  if (level == 1 && version >= 1 && version <= 4)
+  {
+    SedNamespaces* result = defaults[version - 1];
+    ++result->mSharedCount;
+    return result;
+  }
+
+  return share(new SedNamespaces(level, version));
+}
+
+
+SedNamespaces*
+SedNamespaces::acquireSharedWithoutNamespaces(unsigned int level,
+                                              unsigned int version)
+{
+  // the table keeps a reference of its own, so that these are never freed
+  static SedNamespaces* defaults[] = {
+    shareWithoutNamespaces(new SedNamespaces(1, 1)),
+    shareWithoutNamespaces(new SedNamespaces(1, 2)),
+    shareWithoutNamespaces(new SedNamespaces(1, 3)),
+    shareWithoutNamespaces(new SedNamespaces(1, 4))
+  };
+
+  if (level == 1 && version >= 1 && version <= 4)
+  {
+    SedNamespaces* result = defaults[version - 1];
+    ++result->mSharedCount;
+    return result;
+  }
+
+  return shareWithoutNamespaces(new SedNamespaces(level, version));
+}
+
+
+SedNamespaces*
+SedNamespaces::adoptShared(SedNamespaces* sedmlns)
+{
+  if (sedmlns == NULL || !sedmlns->hasDefaultNamespaces())
+    return sedmlns != NULL ? share(sedmlns) : NULL;
+
+  SedNamespaces* result = acquireShared(sedmlns->mLevel, sedmlns->mVersion);
+  delete sedmlns;
+  return result;
+}
+
+
+SedNamespaces*
+SedNamespaces::detachShared(SedNamespaces* sedmlns)
+{
+  // if we hold the only reference nobody else can acquire a new one
+  if (sedmlns == NULL || sedmlns->mSharedCount == 1)
+    return sedmlns;
+
+  SedNamespaces* copy = share(sedmlns->clone());
+  releaseShared(sedmlns);
+  return copy;
+}
+
+
+void
+SedNamespaces::releaseShared(SedNamespaces* sedmlns)
+{
+  if (sedmlns != NULL && --sedmlns->mSharedCount == 0)
+    delete sedmlns;
 }
 /** @endcond */
 
@@ -33,6 +33,18 @@
  *
  * @class SedNamespaces
  * @sbmlbrief{} TODO:Definition of the SedNamespaces class.
+ *
+ * Every SED-ML object refers to a SedNamespaces object.  To keep this
+ * cheap, elements do not own a copy of it: they hold a reference to a
+ * shared SedNamespaces object (usually the one of their document, or the
+ * interned default for their level and version), and only copy it when
+ * their namespaces are modified.  Within a SedNamespaces object the XML
+ * namespaces are reference counted as well: copies share the same
+ * XMLNamespaces, and objects created for a given level and version point
+ * into a table of interned default namespaces.  The namespaces are only
+ * copied once they are about to be modified (copy-on-write), that is when
+ * calling addNamespace(), addNamespaces(), removeNamespace(),
+ * setNamespaces() or the non-const getNamespaces().
  */
 
 
@@ -66,11 +78,16 @@ static const char* const SEDML_XMLNS_L1V4   = "http://sed-ml.org/sed-ml/level1/v
 
 #ifdef __cplusplus
 
+#include <atomic>
 #include <string>
 #include <stdexcept>
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
+/** @cond doxygenLibsedmlInternal */
+struct SedSharedXMLNamespaces;
+/** @endcond */
+
 class LIBSEDML_EXTERN SedNamespaces
 {
 public:
@@ -95,6 +112,9 @@ public:
   
   /**
    * Copy constructor; creates a copy of a SedNamespaces.
+   *
+   * The XML namespaces are shared with @p orig until either of the two
+   * objects modifies them.
    * 
    * @param orig the SedNamespaces instance to copy.
    */
@@ -108,9 +128,10 @@ public:
 
 
   /**
-   * Creates and returns a deep copy of this SedNamespaces object.
+   * Creates and returns a copy of this SedNamespaces object.
    *
-   * @return the (deep) copy of this SedNamespaces object.
+   * @return the copy of this SedNamespaces object; its XML namespaces
+   * are copied lazily, once they are modified.
    */
   virtual SedNamespaces* clone () const;
 
@@ -194,6 +215,10 @@ public:
   /**
    * Get the XML namespaces list for this SedNamespaces object.
    *
+   * As the returned list may be modified, this makes sure it is no longer
+   * shared with other SedNamespaces objects.  Use the const version
+   * where possible.
+   *
    * @return the XML namespaces of this SedNamespaces object.
    */
   XMLNamespaces * getNamespaces();
@@ -277,15 +302,95 @@ public:
 
 
   void setNamespaces(XMLNamespaces * xmlns);
+
+
+  /**
+   * Returns an interned copy of the given namespace URI, so that elements
+   * can refer to their namespace without holding a copy of it.  The
+   * SED-ML namespaces stay interned for the lifetime of the program; any
+   * other URI stays valid until each reference obtained here has been
+   * dropped with releaseURI().
+   */
+  static const std::string& internURI(const std::string& uri);
+
+
+  /**
+   * Drops a reference obtained from internURI(), forgetting the URI once
+   * no element refers to it any more.
+   */
+  static void releaseURI(const std::string& uri);
+
+
+  /**
+   * Returns a SedNamespaces object with the same content as @p sedmlns
+   * that can be shared between elements, with an additional reference
+   * held by the caller.  Shared objects are returned as they are, objects
+   * holding the default namespaces of a level and version are replaced by
+   * the interned one, and any other object is copied once.
+   */
+  static SedNamespaces* acquireShared(const SedNamespaces* sedmlns);
+
+
+  /**
+   * Returns the interned SedNamespaces object for the given level and
+   * version, with an additional reference held by the caller.
+   */
+  static SedNamespaces* acquireShared(unsigned int level,
+                                      unsigned int version);
+
+
+  /**
+   * Returns the interned SedNamespaces object for the given level and
+   * version that declares no XML namespaces (as used by most elements
+   * read from a file), with an additional reference held by the caller.
+   */
+  static SedNamespaces* acquireSharedWithoutNamespaces(unsigned int level,
+                                                       unsigned int version);
+
+
+  /**
+   * Like acquireShared(), but takes ownership of @p sedmlns, which must
+   * not be shared yet.
+   */
+  static SedNamespaces* adoptShared(SedNamespaces* sedmlns);
+
+
+  /**
+   * Returns a SedNamespaces object with the content of the shared
+   * @p sedmlns that only the caller refers to, so that it can be modified.
+   * The caller's reference to @p sedmlns is handed over to the result.
+   */
+  static SedNamespaces* detachShared(SedNamespaces* sedmlns);
+
+
+  /**
+   * Drops a reference obtained from acquireShared(), adoptShared() or
+   * detachShared(), deleting the object once it is no longer used.
+   */
+  static void releaseShared(SedNamespaces* sedmlns);
   /** @endcond */
 
 protected:  
   /** @cond doxygenLibsedmlInternal */
   void initSedNamespace();
 
+  void releaseNamespaces();
+
+  void detachNamespaces();
+
+  bool hasDefaultNamespaces() const;
+
+  static SedNamespaces* share(SedNamespaces* sedmlns);
+
+  static SedNamespaces* shareWithoutNamespaces(SedNamespaces* sedmlns);
+
   unsigned int    mLevel;
   unsigned int    mVersion;
-  XMLNamespaces * mNamespaces;
+  SedSharedXMLNamespaces * mNamespaces;
+
+  // the number of references to a shared object; 0 for objects that are
+  // not shared (see acquireShared())
+  mutable std::atomic<unsigned int> mSharedCount;
 
   /** @endcond */
 };
@@ -0,0 +1,683 @@
+/**
+ * @file SedNumberFormatter.cpp
+ * @brief Implementation of the SedNumberFormatter class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedNumberFormatter.h>
+
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include <stdint.h>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+namespace
+{
+
+/*
+ * A floating point number f * 2^e with a 64 bit significand.
+ */
+struct DiyFp
+{
+  DiyFp () : f(0), e(0) {}
+  DiyFp (uint64_t significand, int exponent) : f(significand), e(exponent) {}
+
+  uint64_t f;
+  int e;
+};
+
+
+const uint64_t SIGNIFICAND_MASK = 0x000FFFFFFFFFFFFFULL;
+const uint64_t EXPONENT_MASK = 0x7FF0000000000000ULL;
+const uint64_t HIDDEN_BIT = 0x0010000000000000ULL;
+const int SIGNIFICAND_SIZE = 52;
+const int EXPONENT_BIAS = 0x3FF + SIGNIFICAND_SIZE;
+
+/*
+ * The powers 10^-348, 10^-340, ..., 10^340, rounded to 64 bit significands.
+ */
+const DiyFp CACHED_POWERS[] =
+{
+  DiyFp(0xfa8fd5a0081c0288ULL, -1220),
+  DiyFp(0xbaaee17fa23ebf76ULL, -1193),
+  DiyFp(0x8b16fb203055ac76ULL, -1166),
+  DiyFp(0xcf42894a5dce35eaULL, -1140),
+  DiyFp(0x9a6bb0aa55653b2dULL, -1113),
+  DiyFp(0xe61acf033d1a45dfULL, -1087),
+  DiyFp(0xab70fe17c79ac6caULL, -1060),
+  DiyFp(0xff77b1fcbebcdc4fULL, -1034),
+  DiyFp(0xbe5691ef416bd60cULL, -1007),
+  DiyFp(0x8dd01fad907ffc3cULL, -980),
+  DiyFp(0xd3515c2831559a83ULL, -954),
+  DiyFp(0x9d71ac8fada6c9b5ULL, -927),
+  DiyFp(0xea9c227723ee8bcbULL, -901),
+  DiyFp(0xaecc49914078536dULL, -874),
+  DiyFp(0x823c12795db6ce57ULL, -847),
+  DiyFp(0xc21094364dfb5637ULL, -821),
+  DiyFp(0x9096ea6f3848984fULL, -794),
+  DiyFp(0xd77485cb25823ac7ULL, -768),
+  DiyFp(0xa086cfcd97bf97f4ULL, -741),
+  DiyFp(0xef340a98172aace5ULL, -715),
+  DiyFp(0xb23867fb2a35b28eULL, -688),
+  DiyFp(0x84c8d4dfd2c63f3bULL, -661),
+  DiyFp(0xc5dd44271ad3cdbaULL, -635),
+  DiyFp(0x936b9fcebb25c996ULL, -608),
+  DiyFp(0xdbac6c247d62a584ULL, -582),
+  DiyFp(0xa3ab66580d5fdaf6ULL, -555),
+  DiyFp(0xf3e2f893dec3f126ULL, -529),
+  DiyFp(0xb5b5ada8aaff80b8ULL, -502),
+  DiyFp(0x87625f056c7c4a8bULL, -475),
+  DiyFp(0xc9bcff6034c13053ULL, -449),
+  DiyFp(0x964e858c91ba2655ULL, -422),
+  DiyFp(0xdff9772470297ebdULL, -396),
+  DiyFp(0xa6dfbd9fb8e5b88fULL, -369),
+  DiyFp(0xf8a95fcf88747d94ULL, -343),
+  DiyFp(0xb94470938fa89bcfULL, -316),
+  DiyFp(0x8a08f0f8bf0f156bULL, -289),
+  DiyFp(0xcdb02555653131b6ULL, -263),
+  DiyFp(0x993fe2c6d07b7facULL, -236),
+  DiyFp(0xe45c10c42a2b3b06ULL, -210),
+  DiyFp(0xaa242499697392d3ULL, -183),
+  DiyFp(0xfd87b5f28300ca0eULL, -157),
+  DiyFp(0xbce5086492111aebULL, -130),
+  DiyFp(0x8cbccc096f5088ccULL, -103),
+  DiyFp(0xd1b71758e219652cULL, -77),
+  DiyFp(0x9c40000000000000ULL, -50),
+  DiyFp(0xe8d4a51000000000ULL, -24),
+  DiyFp(0xad78ebc5ac620000ULL, 3),
+  DiyFp(0x813f3978f8940984ULL, 30),
+  DiyFp(0xc097ce7bc90715b3ULL, 56),
+  DiyFp(0x8f7e32ce7bea5c70ULL, 83),
+  DiyFp(0xd5d238a4abe98068ULL, 109),
+  DiyFp(0x9f4f2726179a2245ULL, 136),
+  DiyFp(0xed63a231d4c4fb27ULL, 162),
+  DiyFp(0xb0de65388cc8ada8ULL, 189),
+  DiyFp(0x83c7088e1aab65dbULL, 216),
+  DiyFp(0xc45d1df942711d9aULL, 242),
+  DiyFp(0x924d692ca61be758ULL, 269),
+  DiyFp(0xda01ee641a708deaULL, 295),
+  DiyFp(0xa26da3999aef774aULL, 322),
+  DiyFp(0xf209787bb47d6b85ULL, 348),
+  DiyFp(0xb454e4a179dd1877ULL, 375),
+  DiyFp(0x865b86925b9bc5c2ULL, 402),
+  DiyFp(0xc83553c5c8965d3dULL, 428),
+  DiyFp(0x952ab45cfa97a0b3ULL, 455),
+  DiyFp(0xde469fbd99a05fe3ULL, 481),
+  DiyFp(0xa59bc234db398c25ULL, 508),
+  DiyFp(0xf6c69a72a3989f5cULL, 534),
+  DiyFp(0xb7dcbf5354e9beceULL, 561),
+  DiyFp(0x88fcf317f22241e2ULL, 588),
+  DiyFp(0xcc20ce9bd35c78a5ULL, 614),
+  DiyFp(0x98165af37b2153dfULL, 641),
+  DiyFp(0xe2a0b5dc971f303aULL, 667),
+  DiyFp(0xa8d9d1535ce3b396ULL, 694),
+  DiyFp(0xfb9b7cd9a4a7443cULL, 720),
+  DiyFp(0xbb764c4ca7a44410ULL, 747),
+  DiyFp(0x8bab8eefb6409c1aULL, 774),
+  DiyFp(0xd01fef10a657842cULL, 800),
+  DiyFp(0x9b10a4e5e9913129ULL, 827),
+  DiyFp(0xe7109bfba19c0c9dULL, 853),
+  DiyFp(0xac2820d9623bf429ULL, 880),
+  DiyFp(0x80444b5e7aa7cf85ULL, 907),
+  DiyFp(0xbf21e44003acdd2dULL, 933),
+  DiyFp(0x8e679c2f5e44ff8fULL, 960),
+  DiyFp(0xd433179d9c8cb841ULL, 986),
+  DiyFp(0x9e19db92b4e31ba9ULL, 1013),
+  DiyFp(0xeb96bf6ebadf77d9ULL, 1039),
+  DiyFp(0xaf87023b9bf0ee6bULL, 1066)
+};
+
+const uint64_t POWERS_OF_TEN[] =
+{
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+  10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+  100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+
+DiyFp
+decompose (double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+
+  int biased = (int)((bits & EXPONENT_MASK) >> SIGNIFICAND_SIZE);
+  uint64_t significand = bits & SIGNIFICAND_MASK;
+
+  if (biased != 0)
+  {
+    return DiyFp(significand + HIDDEN_BIT, biased - EXPONENT_BIAS);
+  }
+
+  // subnormal numbers
+  return DiyFp(significand, 1 - EXPONENT_BIAS);
+}
+
+
+DiyFp
+normalize (DiyFp v)
+{
+  while ((v.f & (1ULL << 63)) == 0)
+  {
+    v.f <<= 1;
+    v.e--;
+  }
+  return v;
+}
+
+
+/*
+ * Returns the upper 64 bits of the product, rounded.
+ */
+DiyFp
+multiply (const DiyFp& a, const DiyFp& b)
+{
+  const uint64_t mask = 0xFFFFFFFFULL;
+  uint64_t ah = a.f >> 32, al = a.f & mask;
+  uint64_t bh = b.f >> 32, bl = b.f & mask;
+
+  uint64_t hh = ah * bh;
+  uint64_t hl = ah * bl;
+  uint64_t lh = al * bh;
+  uint64_t ll = al * bl;
+
+  uint64_t middle = (ll >> 32) + (hl & mask) + (lh & mask) + (1ULL << 31);
+  return DiyFp(hh + (hl >> 32) + (lh >> 32) + (middle >> 32), a.e + b.e + 64);
+}
+
+
+/*
+ * Computes the boundaries halfway to the neighbouring doubles, scaled to
+ * the same exponent, with the upper one normalized.
+ */
+void
+getBoundaries (const DiyFp& v, DiyFp& minus, DiyFp& plus)
+{
+  plus = DiyFp((v.f << 1) + 1, v.e - 1);
+  while ((plus.f & (HIDDEN_BIT << 1)) == 0)
+  {
+    plus.f <<= 1;
+    plus.e--;
+  }
+  plus.f <<= 64 - SIGNIFICAND_SIZE - 2;
+  plus.e -= 64 - SIGNIFICAND_SIZE - 2;
+
+  // the lower neighbour is closer if v is a power of two
+  minus = (v.f == HIDDEN_BIT) ? DiyFp((v.f << 2) - 1, v.e - 2)
+                              : DiyFp((v.f << 1) - 1, v.e - 1);
+  minus.f <<= minus.e - plus.e;
+  minus.e = plus.e;
+}
+
+
+/*
+ * Returns the cached power of ten that scales a number with the binary
+ * exponent @p e into the range needed for digit generation, and sets
+ * @p K to minus its decimal exponent.
+ */
+DiyFp
+getCachedPower (int e, int& K)
+{
+  double dk = (-61 - e) * 0.30102999566398114 + 347;
+  int k = (int)dk;
+  if (k != dk) k++;
+
+  unsigned int index = (unsigned int)((k >> 3) + 1);
+  K = -(-348 + (int)(index << 3));
+  return CACHED_POWERS[index];
+}
+
+
+/*
+ * Moves the last digit towards the exact value while the result stays
+ * within the rounding interval.
+ */
+void
+roundWeed (char* digits, int length, uint64_t delta, uint64_t rest,
+           uint64_t tenKappa, uint64_t distance)
+{
+  while (rest < distance && delta - rest >= tenKappa
+    && (rest + tenKappa < distance
+      || distance - rest > rest + tenKappa - distance))
+  {
+    digits[length - 1]--;
+    rest += tenKappa;
+  }
+}
+
+
+void
+generateDigits (const DiyFp& W, const DiyFp& Mp, uint64_t delta,
+                char* digits, int& length, int& K)
+{
+  const DiyFp one(1ULL << -Mp.e, Mp.e);
+  const uint64_t distance = Mp.f - W.f;
+
+  uint32_t p1 = (uint32_t)(Mp.f >> -one.e);
+  uint64_t p2 = Mp.f & (one.f - 1);
+
+  int kappa = 1;
+  while (kappa < 10 && p1 >= POWERS_OF_TEN[kappa]) kappa++;
+
+  length = 0;
+  while (kappa > 0)
+  {
+    uint32_t divisor = (uint32_t)POWERS_OF_TEN[kappa - 1];
+    uint32_t d = p1 / divisor;
+    p1 %= divisor;
+
+    if (d != 0 || length != 0) digits[length++] = (char)('0' + d);
+    kappa--;
+
+    uint64_t rest = ((uint64_t)p1 << -one.e) + p2;
+    if (rest <= delta)
+    {
+      K += kappa;
+      roundWeed(digits, length, delta, rest,
+                POWERS_OF_TEN[kappa] << -one.e, distance);
+      return;
+    }
+  }
+
+  for (;;)
+  {
+    p2 *= 10;
+    delta *= 10;
+
+    char d = (char)(p2 >> -one.e);
+    if (d != 0 || length != 0) digits[length++] = (char)('0' + d);
+    p2 &= one.f - 1;
+    kappa--;
+
+    if (p2 < delta)
+    {
+      K += kappa;
+      int index = -kappa;
+      roundWeed(digits, length, delta, p2, one.f,
+                distance * (index < 20 ? POWERS_OF_TEN[index] : 0));
+      return;
+    }
+  }
+}
+
+
+/*
+ * Writes digits of the given positive value that read back to it; the
+ * value is digits * 10^K.
+ */
+void
+grisu2 (double value, char* digits, int& length, int& K)
+{
+  const DiyFp v = decompose(value);
+
+  DiyFp minus, plus;
+  getBoundaries(v, minus, plus);
+
+  const DiyFp c = getCachedPower(plus.e, K);
+  const DiyFp W = multiply(normalize(v), c);
+  DiyFp Wp = multiply(plus, c);
+  DiyFp Wm = multiply(minus, c);
+  Wm.f++;
+  Wp.f--;
+
+  generateDigits(W, Wp, Wp.f - Wm.f, digits, length, K);
+}
+
+
+char*
+writeUnsigned (uint64_t value, char* out)
+{
+  char reversed[20];
+  int n = 0;
+  do
+  {
+    reversed[n++] = (char)('0' + value % 10);
+    value /= 10;
+  }
+  while (value != 0);
+
+  while (n > 0) *out++ = reversed[--n];
+  return out;
+}
+
+
+/*
+ * Lays out the given digits like the %g conversion with enough precision
+ * would, with the first digit at the decimal position @p exponent.
+ */
+char*
+writeDigits (const char* digits, int length, int exponent, char* out)
+{
+  if (exponent >= 0 && exponent < 17)
+  {
+    if (length <= exponent + 1)
+    {
+      memcpy(out, digits, length);
+      out += length;
+      for (int i = length; i <= exponent; ++i) *out++ = '0';
+      return out;
+    }
+
+    memcpy(out, digits, exponent + 1);
+    out += exponent + 1;
+    *out++ = '.';
+    memcpy(out, digits + exponent + 1, length - exponent - 1);
+    return out + length - exponent - 1;
+  }
+
+  if (exponent < 0 && exponent >= -4)
+  {
+    *out++ = '0';
+    *out++ = '.';
+    for (int i = -1; i > exponent; --i) *out++ = '0';
+    memcpy(out, digits, length);
+    return out + length;
+  }
+
+  *out++ = digits[0];
+  if (length > 1)
+  {
+    *out++ = '.';
+    memcpy(out, digits + 1, length - 1);
+    out += length - 1;
+  }
+
+  *out++ = 'e';
+  *out++ = (exponent < 0) ? '-' : '+';
+  unsigned int magnitude = (unsigned int)((exponent < 0) ? -exponent : exponent);
+  if (magnitude < 10) *out++ = '0';
+  return writeUnsigned(magnitude, out);
+}
+
+
+/*
+ * The powers of ten that are exactly representable as doubles.
+ */
+const double EXACT_POWERS[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+  1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const uint64_t MAX_EXACT_INTEGER = 1ULL << 53;
+
+
+/*
+ * Returns the length of the given word if the text starts with it,
+ * ignoring case, or 0.
+ */
+size_t
+matchWord (const char* begin, const char* end, const char* word)
+{
+  size_t length = strlen(word);
+  if ((size_t)(end - begin) < length) return 0;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    char c = begin[i];
+    if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+    if (c != word[i]) return 0;
+  }
+  return length;
+}
+
+
+/*
+ * Converts the given number with strtod, after replacing the "." with the
+ * decimal separator of the current locale.
+ */
+double
+convertWithLocale (const char* begin, const char* end)
+{
+  const char* point = localeconv()->decimal_point;
+
+  string text(begin, end);
+  size_t pos = text.find('.');
+  if (pos != string::npos && point != NULL && strcmp(point, ".") != 0)
+  {
+    text.replace(pos, 1, point);
+  }
+
+  return strtod(text.c_str(), NULL);
+}
+
+}
+
+/** @endcond */
+
+
+unsigned int
+SedNumberFormatter::formatDouble (double value, char* buffer)
+{
+  char* out = buffer;
+
+  if (value != value)
+  {
+    memcpy(buffer, "NaN", 4);
+    return 3;
+  }
+
+  if (signbit(value))
+  {
+    *out++ = '-';
+    value = -value;
+  }
+
+  if (value > 1.7976931348623157e308)
+  {
+    memcpy(out, "INF", 4);
+    return (unsigned int)(out - buffer) + 3;
+  }
+
+  // integers, including zero, are written as they are
+  if (value < 1e15 && value == (double)(uint64_t)value)
+  {
+    out = writeUnsigned((uint64_t)value, out);
+    *out = '\0';
+    return (unsigned int)(out - buffer);
+  }
+
+  char digits[20];
+  int length = 0;
+  int K = 0;
+  grisu2(value, digits, length, K);
+
+  out = writeDigits(digits, length, length + K - 1, out);
+  *out = '\0';
+  return (unsigned int)(out - buffer);
+}
+
+
+void
+SedNumberFormatter::appendDouble (double value, std::string& text)
+{
+  char buffer[BUFFER_SIZE];
+  text.append(buffer, formatDouble(value, buffer));
+}
+
+
+std::string
+SedNumberFormatter::toString (double value)
+{
+  char buffer[BUFFER_SIZE];
+  return string(buffer, formatDouble(value, buffer));
+}
+
+
+
+const char*
+SedNumberFormatter::parseDouble (const char* begin, const char* end,
+                                 double& value)
+{
+  if (begin == NULL || begin >= end) return NULL;
+
+  const char* p = begin;
+  bool negative = false;
+  if (*p == '+' || *p == '-')
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+
+  size_t length = matchWord(p, end, "infinity");
+  if (length == 0) length = matchWord(p, end, "inf");
+  if (length > 0)
+  {
+    value = negative ? -numeric_limits<double>::infinity()
+                     : numeric_limits<double>::infinity();
+    return p + length;
+  }
+
+  length = matchWord(p, end, "nan");
+  if (length > 0)
+  {
+    value = numeric_limits<double>::quiet_NaN();
+    return p + length;
+  }
+
+  // collect up to 19 significant digits; the exponent makes up for the rest
+  uint64_t mantissa = 0;
+  int numDigits = 0;
+  int exponent = 0;
+  bool truncated = false;
+  bool hasDigits = false;
+
+  for (; p != end && *p >= '0' && *p <= '9'; ++p)
+  {
+    hasDigits = true;
+    unsigned int digit = (unsigned int)(*p - '0');
+    if (mantissa == 0 && digit == 0) continue;
+
+    if (numDigits < 19)
+    {
+      mantissa = mantissa * 10 + digit;
+      ++numDigits;
+    }
+    else
+    {
+      ++exponent;
+      truncated = truncated || digit != 0;
+    }
+  }
+
+  if (p != end && *p == '.')
+  {
+    for (++p; p != end && *p >= '0' && *p <= '9'; ++p)
+    {
+      hasDigits = true;
+      unsigned int digit = (unsigned int)(*p - '0');
+      if (mantissa == 0 && digit == 0)
+      {
+        --exponent;
+        continue;
+      }
+
+      if (numDigits < 19)
+      {
+        mantissa = mantissa * 10 + digit;
+        ++numDigits;
+        --exponent;
+      }
+      else
+      {
+        truncated = truncated || digit != 0;
+      }
+    }
+  }
+
+  if (!hasDigits) return NULL;
+
+  if (p != end && (*p == 'e' || *p == 'E'))
+  {
+    const char* q = p + 1;
+    bool negativeExponent = false;
+    if (q != end && (*q == '+' || *q == '-'))
+    {
+      negativeExponent = (*q == '-');
+      ++q;
+    }
+
+    if (q != end && *q >= '0' && *q <= '9')
+    {
+      int written = 0;
+      for (; q != end && *q >= '0' && *q <= '9'; ++q)
+      {
+        if (written < 100000) written = written * 10 + (*q - '0');
+      }
+      exponent += negativeExponent ? -written : written;
+      p = q;
+    }
+  }
+
+  if (mantissa == 0)
+  {
+    value = negative ? -0.0 : 0.0;
+    return p;
+  }
+
+  // both the digits and the power of ten are exact, so a single rounding
+  // gives the correct result
+  if (!truncated && mantissa <= MAX_EXACT_INTEGER
+    && exponent >= -22 && exponent <= 22)
+  {
+    double result = (double)mantissa;
+    result = (exponent < 0) ? result / EXACT_POWERS[-exponent]
+                            : result * EXACT_POWERS[exponent];
+    value = negative ? -result : result;
+    return p;
+  }
+
+  value = convertWithLocale(begin, p);
+  return p;
+}
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
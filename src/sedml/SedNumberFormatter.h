@@ -0,0 +1,137 @@
+/**
+ * @file SedNumberFormatter.h
+ * @brief Definition of the SedNumberFormatter class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedNumberFormatter
+ * @sbmlbrief{} Fast conversion of numbers to and from text.
+ *
+ * The SedNumberFormatter writes double values as decimal strings that
+ * read back to the same value, without going through the locale-dependent
+ * printf or iostream machinery.  Digits are generated with the Grisu2
+ * algorithm (Loitsch, "Printing floating-point numbers quickly and
+ * accurately with integers", PLDI 2010), which guarantees the round trip
+ * and is usually, but not always, as short as possible; integral values
+ * take a shorter path.  The output uses the "." decimal separator and
+ * the same notation as the @c %g conversion, with @c NaN, @c INF and
+ * @c -INF for values that are not finite.
+ *
+ * Numbers are read back just as independently of the locale.  Those whose
+ * digits and power of ten are exact doubles, which covers most values
+ * written by hand, are converted with a single floating point operation;
+ * all others are passed on to @c strtod.
+ */
+
+
+#ifndef SedNumberFormatter_h
+#define SedNumberFormatter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/** @cond doxygenLibsedmlInternal */
+class LIBSEDML_EXTERN SedNumberFormatter
+{
+public:
+
+  /**
+   * The size of a buffer that can hold any formatted number, including
+   * the terminating zero.
+   */
+  static const unsigned int BUFFER_SIZE = 32;
+
+
+  /**
+   * Writes a representation of the given value that reads back to the
+   * same value.
+   *
+   * @param value the value to be formatted.
+   * @param buffer the buffer receiving the text, followed by a zero; it
+   * has to hold at least BUFFER_SIZE characters.
+   *
+   * @return the number of characters written, without the terminating
+   * zero.
+   */
+  static unsigned int formatDouble (double value, char* buffer);
+
+
+  /**
+   * Appends a representation of the given value that reads back to the
+   * same value to the given string.
+   *
+   * @param value the value to be formatted.
+   * @param text the string to append to.
+   */
+  static void appendDouble (double value, std::string& text);
+
+
+  /**
+   * @return a representation of the given value that reads back to the
+   * same value.
+   */
+  static std::string toString (double value);
+
+
+  /**
+   * Reads a number from the start of the given text, which is either a
+   * decimal number with an optional sign, fraction and exponent, or one
+   * of @c INF, @c Infinity and @c NaN, in any case and with an optional
+   * sign.  The decimal separator is always ".".
+   *
+   * @param begin the start of the text.
+   * @param end the end of the text.
+   * @param value set to the number read.
+   *
+   * @return a pointer to the first character after the number, or @c NULL
+   * if the text does not start with a number.
+   */
+  static const char* parseDouble (const char* begin, const char* end,
+                                  double& value);
+};
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedNumberFormatter_h */
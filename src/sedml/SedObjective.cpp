@@ -64,7 +64,7 @@ SedObjective::SedObjective(unsigned int level, unsigned int version)
 /*
  * Creates a new SedObjective using the given SedNamespaces object @p sedmlns.
  */
-SedObjective::SedObjective(SedNamespaces *sedmlns)
+SedObjective::SedObjective(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mElementName("objective")
 {
@@ -187,7 +187,11 @@ SedObjective::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedObjective::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -95,7 +95,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedObjective(SedNamespaces *sedmlns);
+  SedObjective(const SedNamespaces *sedmlns);
 
 
   /**
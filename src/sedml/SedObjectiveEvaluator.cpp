@@ -0,0 +1,1094 @@
+/**
+ * @file SedObjectiveEvaluator.cpp
+ * @brief Implementation of the SedObjectiveEvaluator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedObjectiveEvaluator.h>
+#include <sedml/SedSimulator.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedTaskResult.h>
+#include <sedml/SedWorkStealingPool.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedParameterEstimationTask.h>
+#include <sedml/SedAdjustableParameter.h>
+#include <sedml/SedBounds.h>
+#include <sedml/SedExperimentReference.h>
+#include <sedml/SedFitExperiment.h>
+#include <sedml/SedFitMapping.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedDataDescription.h>
+#include <sedml/SedDataSource.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedOneStep.h>
+#include <sedml/SedSteadyState.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * A fit experiment, with its simulator, its data and the buffers used
+ * while it is evaluated.
+ */
+class SedObjectiveEvaluator::Experiment
+{
+public:
+
+  struct Observable
+  {
+    /*
+     * Compiles the math of the target, and finds the slots of its
+     * variables.
+     */
+    int compile ()
+    {
+      if (math.compile(target) != LIBSEDML_OPERATION_SUCCESS)
+      {
+        return LIBSEDML_INVALID_OBJECT;
+      }
+
+      for (unsigned int n = 0; n < target->getNumVariables(); ++n)
+      {
+        const SedVariable* variable = target->getVariable(n);
+        variables.push_back(variable);
+        slots.push_back(math.getSlotIndex(variable->getId()));
+      }
+
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+    const SedDataGenerator* target;
+    SedCompiledMath math;
+    std::vector<const SedVariable*> variables;
+    std::vector<int> slots;
+    Values data;
+    Values weights;
+    double weight;
+    std::vector<double> simulated;
+  };
+
+  struct Condition
+  {
+    SedSetValue* change;
+    Values values;
+  };
+
+
+  Experiment (const SedFitExperiment* fitExperiment, unsigned int level,
+              unsigned int version)
+    : mFitExperiment(fitExperiment)
+    , mModel(NULL)
+    , mModelXml(NULL)
+    , mSimulator(NULL)
+    , mStep(level, version)
+    , mSteadyState(level, version)
+    , mOutput()
+    , mTimes()
+    , mParameters()
+    , mConditions()
+    , mObservables()
+    , mNumPoints(0)
+    , mOffset(0)
+    , mObjective(0)
+    , mStatus(LIBSEDML_OPERATION_SUCCESS)
+  {
+  }
+
+
+  ~Experiment ()
+  {
+    delete mSimulator;
+
+    for (size_t i = 0; i < mConditions.size(); ++i)
+    {
+      delete mConditions[i].change;
+    }
+
+    for (size_t i = 0; i < mObservables.size(); ++i)
+    {
+      delete mObservables[i];
+    }
+  }
+
+
+  /*
+   * Compares the current values of the observables with the data of the
+   * given point.
+   */
+  void addResiduals (unsigned int point, double* residuals)
+  {
+    for (size_t k = 0; k < mObservables.size(); ++k)
+    {
+      Observable& observable = *mObservables[k];
+
+      for (size_t j = 0; j < observable.variables.size(); ++j)
+      {
+        if (observable.slots[j] < 0) continue;
+        observable.math.setSlotValue(observable.slots[j],
+          mSimulator->getVariableValue(observable.variables[j]));
+      }
+
+      double simulated = observable.math.evaluate();
+      observable.simulated[point] = simulated;
+
+      double measured = (*observable.data)[point];
+      double residual = 0;
+      if (!std::isnan(measured))
+      {
+        double weight = observable.weights
+          ? (*observable.weights)[point] : observable.weight;
+        residual = weight * (simulated - measured);
+      }
+
+      residuals[k * mNumPoints + point] = residual;
+      mObjective += residual * residual;
+    }
+  }
+
+
+  const SedFitExperiment* mFitExperiment;
+  const SedModel* mModel;
+  const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* mModelXml;
+  SedSimulator* mSimulator;
+  SedOneStep mStep;
+  SedSteadyState mSteadyState;
+  SedTaskResult mOutput;
+  Values mTimes;
+  std::vector<unsigned int> mParameters;
+  std::vector<Condition> mConditions;
+  std::vector<Observable*> mObservables;
+  unsigned int mNumPoints;
+  unsigned int mOffset;
+  double mObjective;
+  int mStatus;
+};
+
+/** @endcond */
+
+
+SedObjectiveEvaluator::SedObjectiveEvaluator (const SedDocument* document)
+  : mDocument(document)
+  , mFactories()
+  , mNumThreads(0)
+  , mThreadPool(NULL)
+  , mModelBuilder(document)
+  , mDataLoader()
+  , mTask(NULL)
+  , mParameters()
+  , mExperiments()
+  , mModelValues()
+  , mResiduals()
+  , mNumResiduals(0)
+  , mNumEvaluations(0)
+{
+}
+
+
+SedObjectiveEvaluator::~SedObjectiveEvaluator ()
+{
+  unbind();
+}
+
+
+void
+SedObjectiveEvaluator::registerSimulator (const std::string& kisaoId,
+                                          const SimulatorFactory& factory)
+{
+  mFactories[kisaoId] = factory;
+}
+
+
+void
+SedObjectiveEvaluator::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+unsigned int
+SedObjectiveEvaluator::getNumThreads () const
+{
+  return mNumThreads;
+}
+
+
+void
+SedObjectiveEvaluator::setThreadPool (SedWorkStealingPool* pool)
+{
+  mThreadPool = pool;
+}
+
+
+SedWorkStealingPool*
+SedObjectiveEvaluator::getThreadPool () const
+{
+  return mThreadPool;
+}
+
+
+SedModelBuilder&
+SedObjectiveEvaluator::getModelBuilder ()
+{
+  return mModelBuilder;
+}
+
+
+SedDataLoader&
+SedObjectiveEvaluator::getDataLoader ()
+{
+  return mDataLoader;
+}
+
+
+int
+SedObjectiveEvaluator::bind (const std::string& taskId)
+{
+  unbind();
+  if (mDocument == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  const SedAbstractTask* task = mDocument->getTask(taskId);
+  if (task == NULL || task->getTypeCode() != SEDML_TASK_PARAMETER_ESTIMATION)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  const SedParameterEstimationTask* estimation =
+    static_cast<const SedParameterEstimationTask*>(task);
+
+  int status = (estimation->getNumFitExperiments() > 0)
+    ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_INVALID_OBJECT;
+
+  for (unsigned int i = 0; i < estimation->getNumAdjustableParameters()
+       && status == LIBSEDML_OPERATION_SUCCESS; ++i)
+  {
+    status = bindParameter(estimation->getAdjustableParameter(i));
+  }
+
+  for (unsigned int i = 0; i < estimation->getNumFitExperiments()
+       && status == LIBSEDML_OPERATION_SUCCESS; ++i)
+  {
+    status = bindExperiment(estimation->getFitExperiment(i));
+  }
+
+  if (status != LIBSEDML_OPERATION_SUCCESS)
+  {
+    unbind();
+    return status;
+  }
+
+  mTask = estimation;
+  mModelValues.assign(mParameters.size(), 0.0);
+  mResiduals.assign(mNumResiduals, 0.0);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedObjectiveEvaluator::bind (const SedObjectiveEvaluator& other)
+{
+  unbind();
+  if (other.mTask == NULL || other.mDocument != mDocument || &other == this)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  int status = LIBSEDML_OPERATION_SUCCESS;
+
+  for (size_t i = 0; i < other.mParameters.size(); ++i)
+  {
+    Parameter entry = other.mParameters[i];
+    entry.change = entry.change->clone();
+    mParameters.push_back(entry);
+  }
+
+  for (size_t i = 0; i < other.mExperiments.size()
+       && status == LIBSEDML_OPERATION_SUCCESS; ++i)
+  {
+    status = copyExperiment(*other.mExperiments[i]);
+  }
+
+  if (status != LIBSEDML_OPERATION_SUCCESS)
+  {
+    unbind();
+    return status;
+  }
+
+  mTask = other.mTask;
+  mModelValues.assign(mParameters.size(), 0.0);
+  mResiduals.assign(mNumResiduals, 0.0);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+const SedParameterEstimationTask*
+SedObjectiveEvaluator::getTask () const
+{
+  return mTask;
+}
+
+
+unsigned int
+SedObjectiveEvaluator::getNumParameters () const
+{
+  return (unsigned int)mParameters.size();
+}
+
+
+const SedAdjustableParameter*
+SedObjectiveEvaluator::getParameter (unsigned int n) const
+{
+  return (n < mParameters.size()) ? mParameters[n].parameter : NULL;
+}
+
+
+ScaleType_t
+SedObjectiveEvaluator::getScale (unsigned int n) const
+{
+  return (n < mParameters.size()) ? mParameters[n].scale
+                                  : SEDML_SCALETYPE_INVALID;
+}
+
+
+void
+SedObjectiveEvaluator::getInitialValues (double* values) const
+{
+  for (size_t i = 0; i < mParameters.size(); ++i)
+  {
+    values[i] = mParameters[i].initialValue;
+  }
+}
+
+
+void
+SedObjectiveEvaluator::getLowerBounds (double* values) const
+{
+  for (size_t i = 0; i < mParameters.size(); ++i)
+  {
+    values[i] = mParameters[i].lowerBound;
+  }
+}
+
+
+void
+SedObjectiveEvaluator::getUpperBounds (double* values) const
+{
+  for (size_t i = 0; i < mParameters.size(); ++i)
+  {
+    values[i] = mParameters[i].upperBound;
+  }
+}
+
+
+void
+SedObjectiveEvaluator::toModelValues (const double* values,
+                                      double* modelValues) const
+{
+  for (size_t i = 0; i < mParameters.size(); ++i)
+  {
+    modelValues[i] = toModelValue(values[i], mParameters[i].scale);
+  }
+}
+
+
+double
+SedObjectiveEvaluator::toModelValue (double value, ScaleType_t scale)
+{
+  switch (scale)
+  {
+  case SEDML_SCALETYPE_LOG:
+    return exp(value);
+
+  case SEDML_SCALETYPE_LOG10:
+    return pow(10.0, value);
+
+  default:
+    return value;
+  }
+}
+
+
+double
+SedObjectiveEvaluator::toScaledValue (double modelValue, ScaleType_t scale)
+{
+  switch (scale)
+  {
+  case SEDML_SCALETYPE_LOG:
+    return (modelValue > 0) ? log(modelValue)
+                            : numeric_limits<double>::quiet_NaN();
+
+  case SEDML_SCALETYPE_LOG10:
+    return (modelValue > 0) ? log10(modelValue)
+                            : numeric_limits<double>::quiet_NaN();
+
+  default:
+    return modelValue;
+  }
+}
+
+
+unsigned int
+SedObjectiveEvaluator::getNumExperiments () const
+{
+  return (unsigned int)mExperiments.size();
+}
+
+
+const SedFitExperiment*
+SedObjectiveEvaluator::getExperiment (unsigned int n) const
+{
+  return (n < mExperiments.size()) ? mExperiments[n]->mFitExperiment : NULL;
+}
+
+
+unsigned int
+SedObjectiveEvaluator::getNumPoints (unsigned int n) const
+{
+  return (n < mExperiments.size()) ? mExperiments[n]->mNumPoints : 0;
+}
+
+
+const double*
+SedObjectiveEvaluator::getTimes (unsigned int n) const
+{
+  if (n >= mExperiments.size() || !mExperiments[n]->mTimes) return NULL;
+  return mExperiments[n]->mTimes->data();
+}
+
+
+unsigned int
+SedObjectiveEvaluator::getNumObservables (unsigned int n) const
+{
+  return (n < mExperiments.size())
+    ? (unsigned int)mExperiments[n]->mObservables.size() : 0;
+}
+
+
+const SedDataGenerator*
+SedObjectiveEvaluator::getObservable (unsigned int n, unsigned int k) const
+{
+  if (k >= getNumObservables(n)) return NULL;
+  return mExperiments[n]->mObservables[k]->target;
+}
+
+
+const double*
+SedObjectiveEvaluator::getMeasuredValues (unsigned int n, unsigned int k) const
+{
+  if (k >= getNumObservables(n)) return NULL;
+  return mExperiments[n]->mObservables[k]->data->data();
+}
+
+
+const double*
+SedObjectiveEvaluator::getSimulatedValues (unsigned int n, unsigned int k) const
+{
+  if (k >= getNumObservables(n)) return NULL;
+  return mExperiments[n]->mObservables[k]->simulated.data();
+}
+
+
+unsigned int
+SedObjectiveEvaluator::getResidualOffset (unsigned int n) const
+{
+  return (n < mExperiments.size()) ? mExperiments[n]->mOffset
+                                   : mNumResiduals;
+}
+
+
+unsigned int
+SedObjectiveEvaluator::getNumResiduals () const
+{
+  return mNumResiduals;
+}
+
+
+int
+SedObjectiveEvaluator::evaluate (const double* values, double& objective,
+                                 double* residuals)
+{
+  if (mTask == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  toModelValues(values, mModelValues.data());
+  double* output = (residuals != NULL) ? residuals : mResiduals.data();
+
+  SedWorkStealingPool& pool = (mThreadPool != NULL)
+    ? *mThreadPool : SedWorkStealingPool::getSharedPool();
+
+  pool.runJobs(mExperiments.size(), mNumThreads, [this, output](size_t n)
+  {
+    Experiment& experiment = *mExperiments[n];
+
+    try
+    {
+      experiment.mStatus = evaluateExperiment(experiment, output);
+    }
+    catch (...)
+    {
+      experiment.mStatus = LIBSEDML_OPERATION_FAILED;
+    }
+
+    if (experiment.mStatus != LIBSEDML_OPERATION_SUCCESS)
+    {
+      double* begin = output + experiment.mOffset;
+      size_t count = experiment.mObservables.size() * experiment.mNumPoints;
+      fill(begin, begin + count, numeric_limits<double>::quiet_NaN());
+    }
+  });
+
+  ++mNumEvaluations;
+
+  // summed in a fixed order, so that the result does not depend on the
+  // order in which the experiments finished
+  objective = 0;
+  for (size_t i = 0; i < mExperiments.size(); ++i)
+  {
+    if (mExperiments[i]->mStatus != LIBSEDML_OPERATION_SUCCESS)
+    {
+      objective = numeric_limits<double>::infinity();
+      return LIBSEDML_OPERATION_FAILED;
+    }
+    objective += mExperiments[i]->mObjective;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+unsigned long long
+SedObjectiveEvaluator::getNumEvaluations () const
+{
+  return mNumEvaluations;
+}
+
+
+void
+SedObjectiveEvaluator::unbind ()
+{
+  for (size_t i = 0; i < mExperiments.size(); ++i)
+  {
+    delete mExperiments[i];
+  }
+  mExperiments.clear();
+
+  for (size_t i = 0; i < mParameters.size(); ++i)
+  {
+    delete mParameters[i].change;
+  }
+  mParameters.clear();
+
+  mTask = NULL;
+  mModelValues.clear();
+  mResiduals.clear();
+  mNumResiduals = 0;
+  mNumEvaluations = 0;
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Adds the given adjustable parameter, with its bounds and initial value
+ * converted to its scale.
+ */
+int
+SedObjectiveEvaluator::bindParameter (const SedAdjustableParameter* parameter)
+{
+  Parameter entry = { parameter, NULL, SEDML_SCALETYPE_LINEAR,
+                      numeric_limits<double>::quiet_NaN(),
+                      -numeric_limits<double>::infinity(),
+                      numeric_limits<double>::infinity() };
+
+  const SedBounds* bounds = parameter->getBounds();
+  if (bounds != NULL)
+  {
+    if (bounds->isSetScale()) entry.scale = bounds->getScale();
+    if (entry.scale == SEDML_SCALETYPE_INVALID)
+    {
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+
+    // a lower bound of 0 on a logarithmic scale is no bound at all
+    if (bounds->isSetLowerBound())
+    {
+      double lower = toScaledValue(bounds->getLowerBound(), entry.scale);
+      if (!std::isnan(lower)) entry.lowerBound = lower;
+    }
+
+    if (bounds->isSetUpperBound())
+    {
+      entry.upperBound = toScaledValue(bounds->getUpperBound(), entry.scale);
+      if (std::isnan(entry.upperBound)) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+  }
+
+  if (parameter->isSetInitialValue())
+  {
+    entry.initialValue = toScaledValue(parameter->getInitialValue(),
+                                       entry.scale);
+  }
+  else if (std::isfinite(entry.lowerBound) && std::isfinite(entry.upperBound))
+  {
+    entry.initialValue = 0.5 * (entry.lowerBound + entry.upperBound);
+  }
+
+  if (std::isnan(entry.initialValue)) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  entry.change = new SedSetValue(mDocument->getLevel(),
+                                 mDocument->getVersion());
+  entry.change->setModelReference(parameter->getModelReference());
+  entry.change->setTarget(parameter->getTarget());
+  mParameters.push_back(entry);
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Reads the data of the given fit experiment, selects the parameters
+ * that apply to it and creates its simulator.
+ */
+int
+SedObjectiveEvaluator::bindExperiment (const SedFitExperiment* fitExperiment)
+{
+  unique_ptr<Experiment> experiment(new Experiment(fitExperiment,
+    mDocument->getLevel(), mDocument->getVersion()));
+
+  bool steadyState =
+    (fitExperiment->getType() == SEDML_EXPERIMENTTYPE_STEADYSTATE);
+  string modelId;
+  int status;
+
+  for (unsigned int i = 0; i < fitExperiment->getNumFitMappings(); ++i)
+  {
+    const SedFitMapping* mapping = fitExperiment->getFitMapping(i);
+
+    switch (mapping->getType())
+    {
+    case SEDML_MAPPINGTYPE_TIME:
+      if (experiment->mTimes) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      status = readValues(mapping->getDataSource(), experiment->mTimes);
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+      break;
+
+    case SEDML_MAPPINGTYPE_EXPERIMENTALCONDITION:
+    {
+      Experiment::Condition condition = { createChange(mapping->getTarget()),
+                                          Values() };
+      if (condition.change == NULL) return LIBSEDML_INVALID_OBJECT;
+      experiment->mConditions.push_back(condition);
+
+      status = readValues(mapping->getDataSource(),
+                          experiment->mConditions.back().values);
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+      if (experiment->mConditions.back().values->empty())
+      {
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+      }
+
+      if (modelId.empty()) modelId = condition.change->getModelReference();
+      break;
+    }
+
+    case SEDML_MAPPINGTYPE_OBSERVABLE:
+    {
+      const SedDataGenerator* target =
+        mDocument->getDataGenerator(mapping->getTarget());
+      if (target == NULL) return LIBSEDML_INVALID_OBJECT;
+
+      Experiment::Observable* observable = new Experiment::Observable();
+      experiment->mObservables.push_back(observable);
+      observable->target = target;
+      observable->weight = mapping->isSetWeight() ? mapping->getWeight() : 1.0;
+
+      status = observable->compile();
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+      for (size_t n = 0; n < observable->variables.size() && modelId.empty();
+           ++n)
+      {
+        modelId = observable->variables[n]->getModelReference();
+      }
+
+      status = readValues(mapping->getDataSource(), observable->data);
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+      if (mapping->isSetPointWeight())
+      {
+        status = readValues(mapping->getPointWeight(), observable->weights);
+        if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+      }
+      break;
+    }
+
+    default:
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+  }
+
+  // every observable and condition needs a value for every point; the
+  // points of a time course are its time points, which must not decrease
+  if (experiment->mObservables.empty()) return LIBSEDML_INVALID_OBJECT;
+
+  if (steadyState)
+  {
+    experiment->mNumPoints =
+      (unsigned int)experiment->mObservables[0]->data->size();
+  }
+  else
+  {
+    if (!experiment->mTimes) return LIBSEDML_INVALID_OBJECT;
+
+    const vector<double>& times = *experiment->mTimes;
+    for (size_t n = 0; n < times.size(); ++n)
+    {
+      if (!(times[n] >= ((n > 0) ? times[n - 1] : 0.0)))
+      {
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+      }
+    }
+    experiment->mNumPoints = (unsigned int)times.size();
+  }
+
+  for (size_t k = 0; k < experiment->mObservables.size(); ++k)
+  {
+    const Experiment::Observable* observable = experiment->mObservables[k];
+    if (observable->data->size() != experiment->mNumPoints
+      || (observable->weights
+          && observable->weights->size() != experiment->mNumPoints))
+    {
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+  }
+
+  for (size_t k = 0; k < experiment->mConditions.size() && steadyState; ++k)
+  {
+    size_t numValues = experiment->mConditions[k].values->size();
+    if (numValues != 1 && numValues != experiment->mNumPoints)
+    {
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+  }
+
+  // parameters apply to the experiments they list, or else to all, as
+  // long as they belong to the same model
+  for (size_t i = 0; i < mParameters.size(); ++i)
+  {
+    const SedAdjustableParameter* parameter = mParameters[i].parameter;
+
+    bool applies = (parameter->getNumExperimentReferences() == 0);
+    for (unsigned int n = 0; n < parameter->getNumExperimentReferences()
+         && !applies; ++n)
+    {
+      applies = (parameter->getExperimentReference(n)->getExperimentId()
+                 == fitExperiment->getId());
+    }
+    if (!applies) continue;
+
+    if (modelId.empty()) modelId = parameter->getModelReference();
+    if (parameter->getModelReference() == modelId)
+    {
+      experiment->mParameters.push_back((unsigned int)i);
+    }
+  }
+
+  experiment->mModel = mDocument->getModel(modelId);
+  if (experiment->mModel == NULL) return LIBSEDML_INVALID_OBJECT;
+  experiment->mModelXml = mModelBuilder.getModel(modelId);
+
+  return addExperiment(experiment.release());
+}
+
+
+/*
+ * Adds an experiment of the task bound by another evaluator, sharing its
+ * data and model.
+ */
+int
+SedObjectiveEvaluator::copyExperiment (const Experiment& orig)
+{
+  unique_ptr<Experiment> experiment(new Experiment(orig.mFitExperiment,
+    mDocument->getLevel(), mDocument->getVersion()));
+
+  experiment->mModel = orig.mModel;
+  experiment->mModelXml = orig.mModelXml;
+  experiment->mTimes = orig.mTimes;
+  experiment->mParameters = orig.mParameters;
+  experiment->mNumPoints = orig.mNumPoints;
+
+  for (size_t k = 0; k < orig.mConditions.size(); ++k)
+  {
+    Experiment::Condition condition = { orig.mConditions[k].change->clone(),
+                                        orig.mConditions[k].values };
+    experiment->mConditions.push_back(condition);
+  }
+
+  for (size_t k = 0; k < orig.mObservables.size(); ++k)
+  {
+    const Experiment::Observable& source = *orig.mObservables[k];
+
+    Experiment::Observable* observable = new Experiment::Observable();
+    experiment->mObservables.push_back(observable);
+    observable->target = source.target;
+    observable->data = source.data;
+    observable->weights = source.weights;
+    observable->weight = source.weight;
+
+    int status = observable->compile();
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+  }
+
+  return addExperiment(experiment.release());
+}
+
+
+/*
+ * Creates and loads the simulator of the given experiment, and takes
+ * ownership of it.
+ */
+int
+SedObjectiveEvaluator::addExperiment (Experiment* experiment)
+{
+  mExperiments.push_back(experiment);
+
+  experiment->mSimulator = createSimulator(experiment->mFitExperiment);
+  if (experiment->mSimulator == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  int status = experiment->mSimulator->loadModel(experiment->mModel,
+                                                 experiment->mModelXml);
+  if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+  for (size_t k = 0; k < experiment->mObservables.size(); ++k)
+  {
+    experiment->mObservables[k]->simulated.assign(experiment->mNumPoints,
+      numeric_limits<double>::quiet_NaN());
+  }
+
+  experiment->mOffset = mNumResiduals;
+  mNumResiduals += (unsigned int)experiment->mObservables.size()
+    * experiment->mNumPoints;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Reads the values of the data source with the given id.
+ */
+int
+SedObjectiveEvaluator::readValues (const std::string& sourceId,
+                                   Values& values)
+{
+  const SedDataSource* source = getDataSource(sourceId);
+  if (source == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  SedDataView view;
+  int status = mDataLoader.getValues(source, view);
+  if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+  shared_ptr< vector<double> > copy = make_shared< vector<double> >();
+  view.copyTo(*copy);
+  values = copy;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+const SedDataSource*
+SedObjectiveEvaluator::getDataSource (const std::string& id) const
+{
+  const SedDataSource* source = NULL;
+  for (unsigned int i = 0;
+       i < mDocument->getNumDataDescriptions() && source == NULL; ++i)
+  {
+    source = mDocument->getDataDescription(i)->getDataSource(id);
+  }
+  return source;
+}
+
+
+/*
+ * Returns a new change setting the model quantity of the first variable
+ * of the data generator with the given id, or NULL if there is none.
+ */
+SedSetValue*
+SedObjectiveEvaluator::createChange (const std::string& targetId) const
+{
+  const SedDataGenerator* target = mDocument->getDataGenerator(targetId);
+  if (target == NULL || target->getNumVariables() == 0) return NULL;
+
+  const SedVariable* variable = target->getVariable(0u);
+  if (!variable->isSetTarget()) return NULL;
+
+  SedSetValue* change = new SedSetValue(mDocument->getLevel(),
+                                        mDocument->getVersion());
+  change->setModelReference(variable->getModelReference());
+  change->setTarget(variable->getTarget());
+  return change;
+}
+
+
+/*
+ * Returns a new simulator for the algorithm of the given fit experiment,
+ * or NULL if none has been registered.
+ */
+SedSimulator*
+SedObjectiveEvaluator::createSimulator (
+  const SedFitExperiment* fitExperiment) const
+{
+  const SedAlgorithm* algorithm = fitExperiment->getAlgorithm();
+
+  FactoryMap::const_iterator it = mFactories.end();
+  if (algorithm != NULL) it = mFactories.find(algorithm->getKisaoID());
+  if (it == mFactories.end()) it = mFactories.find("");
+
+  return (it == mFactories.end()) ? NULL : it->second();
+}
+
+
+/*
+ * Simulates the given experiment with the current parameter values and
+ * writes its residuals.  Called from the threads of the pool; each
+ * experiment is evaluated by one thread only.
+ */
+int
+SedObjectiveEvaluator::evaluateExperiment (Experiment& experiment,
+                                           double* residuals) const
+{
+  experiment.mObjective = 0;
+  residuals += experiment.mOffset;
+
+  SedSimulator* simulator = experiment.mSimulator;
+  int status;
+
+  if (experiment.mFitExperiment->getType() == SEDML_EXPERIMENTTYPE_STEADYSTATE)
+  {
+    // each point is a steady state under its own conditions
+    for (unsigned int n = 0; n < experiment.mNumPoints; ++n)
+    {
+      status = applyParameters(experiment);
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+      for (size_t k = 0; k < experiment.mConditions.size(); ++k)
+      {
+        const Experiment::Condition& condition = experiment.mConditions[k];
+        status = simulator->setValue(condition.change,
+          (*condition.values)[(condition.values->size() > 1) ? n : 0]);
+        if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+      }
+
+      status = simulator->simulate(&experiment.mSteadyState,
+                                   experiment.mOutput);
+      experiment.mOutput.clearValues();
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+      experiment.addResiduals(n, residuals);
+    }
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  status = applyParameters(experiment);
+  if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+  for (size_t k = 0; k < experiment.mConditions.size(); ++k)
+  {
+    const Experiment::Condition& condition = experiment.mConditions[k];
+    status = simulator->setValue(condition.change, (*condition.values)[0]);
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+  }
+
+  double time = 0;
+  for (unsigned int n = 0; n < experiment.mNumPoints; ++n)
+  {
+    double next = (*experiment.mTimes)[n];
+    if (next > time)
+    {
+      experiment.mStep.setStep(next - time);
+      status = simulator->simulate(&experiment.mStep, experiment.mOutput);
+      experiment.mOutput.clearValues();
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+      time = next;
+    }
+
+    experiment.addResiduals(n, residuals);
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Restores the initial state of the model of the given experiment and
+ * sets the parameters that apply to it.
+ */
+int
+SedObjectiveEvaluator::applyParameters (Experiment& experiment) const
+{
+  int status = experiment.mSimulator->resetModel();
+  if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+  for (size_t i = 0; i < experiment.mParameters.size(); ++i)
+  {
+    unsigned int index = experiment.mParameters[i];
+    status = experiment.mSimulator->setValue(mParameters[index].change,
+                                             mModelValues[index]);
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
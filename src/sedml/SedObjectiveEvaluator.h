@@ -0,0 +1,500 @@
+/**
+ * @file SedObjectiveEvaluator.h
+ * @brief Definition of the SedObjectiveEvaluator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedObjectiveEvaluator
+ * @sbmlbrief{} Evaluates the objective of a parameter estimation task.
+ *
+ * A SedObjectiveEvaluator binds the adjustable parameters of a
+ * SedParameterEstimationTask to a flat vector of values, so that an
+ * optimizer can evaluate the objective function for any such vector.
+ * Values are given on the scale of the bounds of each parameter: the
+ * value @em x of a parameter with a "log" scale stands for the model
+ * value exp(@em x), with a "log10" scale for 10<sup>@em x</sup>.
+ *
+ * Each fit experiment is simulated by a SedSimulator of its own, created
+ * through the factory registered for the KiSAO id of its algorithm (see
+ * registerSimulator()) and loaded with the model built by a
+ * SedModelBuilder.  The model is the one that the variables of the
+ * observables refer to, or else that of the adjustable parameters.  The
+ * fit mappings of an experiment are read once, when the task is bound:
+ *
+ * @li the data source of the "time" mapping supplies the time points of
+ * a time course experiment, which are simulated from time 0 in steps of
+ * a SedOneStep;
+ * @li the data source of each "experimentalCondition" mapping supplies a
+ * value that is set on the model quantity of the first variable of its
+ * target data generator before simulating: the value of each point for a
+ * steady state experiment, where every point is simulated separately,
+ * and the first value for a time course;
+ * @li the data source of each "observable" mapping supplies the measured
+ * values, which are compared with the values of its target data
+ * generator.  Its math is compiled by a SedCompiledMath and evaluated for
+ * each point from the values the simulator reports for its variables.
+ *
+ * The residual of an observable at a point is the difference of the
+ * simulated and the measured value times the weight of the point, taken
+ * from the data source named by the "pointWeight" of the mapping, or else
+ * from its "weight" (by default 1).  Points without a measured value
+ * (NaN) have a residual of 0.  The objective is the sum of the squared
+ * residuals, as for a SedLeastSquareObjectiveFunction.
+ *
+ * Fit experiments are evaluated concurrently on a SedWorkStealingPool,
+ * by default the one shared by all of libSEDML, whose threads are started
+ * once and reused by every call.  All buffers are allocated when the task
+ * is bound, so that evaluate() allocates no memory.  Further
+ * evaluators for the same task, for instance to run several optimizations
+ * at once, can be bound to an evaluator that has read the data already;
+ * they share its data and models, and only have simulators of their own.
+ *
+ * @code{.cpp}
+SedObjectiveEvaluator evaluator(doc);
+evaluator.registerSimulator("KISAO:0000019", createCvodeSimulator);
+evaluator.getDataLoader().setBaseDirectory("/path/to/archive");
+
+if (evaluator.bind("estimation") == LIBSEDML_OPERATION_SUCCESS)
+{
+  std::vector<double> values(evaluator.getNumParameters());
+  std::vector<double> residuals(evaluator.getNumResiduals());
+  evaluator.getInitialValues(&values[0]);
+
+  double objective;
+  evaluator.evaluate(&values[0], objective, &residuals[0]);
+  // ...
+}
+ * @endcode
+ */
+
+
+#ifndef SedObjectiveEvaluator_h
+#define SedObjectiveEvaluator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/common/SedmlEnumerations.h>
+#include <sedml/SedModelBuilder.h>
+#include <sedml/SedDataLoader.h>
+
+
+#ifdef __cplusplus
+
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedDataGenerator;
+class SedParameterEstimationTask;
+class SedAdjustableParameter;
+class SedFitExperiment;
+class SedDataSource;
+class SedSetValue;
+class SedSimulator;
+class SedWorkStealingPool;
+
+
+class LIBSEDML_EXTERN SedObjectiveEvaluator
+{
+public:
+
+  /**
+   * Creates a new simulator, owned by the caller.
+   */
+  typedef std::function<SedSimulator* ()> SimulatorFactory;
+
+
+  /**
+   * Creates a new SedObjectiveEvaluator for the parameter estimation tasks
+   * of the given document.
+   *
+   * @param document the SED-ML document; it has to outlive this evaluator
+   * and must not be modified while a task is bound.
+   */
+  explicit SedObjectiveEvaluator (const SedDocument* document);
+
+
+  /**
+   * Destroys this SedObjectiveEvaluator, along with its simulators.
+   */
+  ~SedObjectiveEvaluator ();
+
+
+  /**
+   * Registers the simulator used for the given algorithm.  Simulators are
+   * created when a task is bound.
+   *
+   * @param kisaoId the KiSAO id of the algorithm of a fit experiment, or
+   * an empty string for the simulator used for all algorithms without a
+   * simulator of their own.
+   * @param factory the function creating the simulators.
+   */
+  void registerSimulator (const std::string& kisaoId,
+                          const SimulatorFactory& factory);
+
+
+  /**
+   * Sets the number of threads used for evaluating fit experiments.
+   *
+   * @param numThreads the number of threads, or 0 to use all threads of
+   * the thread pool.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads used for evaluating fit experiments,
+   * or 0.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Sets the thread pool fit experiments are evaluated on.
+   *
+   * @param pool the pool, which has to outlive this evaluator, or
+   * @c NULL for the pool shared by all of libSEDML.
+   */
+  void setThreadPool (SedWorkStealingPool* pool);
+
+
+  /**
+   * @return the thread pool fit experiments are evaluated on, or @c NULL
+   * for the pool shared by all of libSEDML.
+   */
+  SedWorkStealingPool* getThreadPool () const;
+
+
+  /**
+   * @return the model builder used for building the models of the fit
+   * experiments, for instance to set its base directory.
+   */
+  SedModelBuilder& getModelBuilder ();
+
+
+  /**
+   * @return the loader reading the data of the fit mappings, for instance
+   * to set its base directory.
+   */
+  SedDataLoader& getDataLoader ();
+
+
+  /**
+   * Binds the parameter estimation task with the given id: numbers its
+   * adjustable parameters, reads the data of its fit experiments and
+   * creates and loads their simulators.  A task bound before is released.
+   *
+   * @param taskId the id of a SedParameterEstimationTask.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if there is no such task, or if a fit experiment lacks a model,
+   * simulator, data source or target.
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if a parameter has no initial value within its scale, or if the data
+   * of a fit experiment do not fit together.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if data cannot be read or a simulator cannot load its model.
+   */
+  int bind (const std::string& taskId);
+
+
+  /**
+   * Binds the task that the given evaluator has bound, sharing its data
+   * and models instead of reading and building them again; only the
+   * simulators are created anew, with the factories registered with this
+   * evaluator.  Several evaluators bound this way can evaluate the same
+   * task concurrently, for instance for different starts of an optimizer.
+   *
+   * @param other an evaluator for the same document, which has to stay
+   * bound as long as this evaluator is.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if @p other has no task bound, belongs to another document, or if a
+   * simulator is missing.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if a simulator cannot load its model.
+   */
+  int bind (const SedObjectiveEvaluator& other);
+
+
+  /**
+   * @return the task that is bound, or @c NULL.
+   */
+  const SedParameterEstimationTask* getTask () const;
+
+
+  /**
+   * @return the number of adjustable parameters, i.e. of values expected
+   * by evaluate().
+   */
+  unsigned int getNumParameters () const;
+
+
+  /**
+   * @return the adjustable parameter that the nth value stands for, or
+   * @c NULL if @p n is out of range.
+   */
+  const SedAdjustableParameter* getParameter (unsigned int n) const;
+
+
+  /**
+   * @return the scale of the nth value, or
+   * @sbmlconstant{SEDML_SCALETYPE_INVALID, ScaleType_t} if @p n is out of
+   * range.
+   */
+  ScaleType_t getScale (unsigned int n) const;
+
+
+  /**
+   * Writes the initial values of the parameters, on their scales.
+   *
+   * @param values array receiving getNumParameters() values.
+   */
+  void getInitialValues (double* values) const;
+
+
+  /**
+   * Writes the lower bounds of the parameters, on their scales; minus
+   * infinity for parameters without a lower bound.
+   *
+   * @param values array receiving getNumParameters() values.
+   */
+  void getLowerBounds (double* values) const;
+
+
+  /**
+   * Writes the upper bounds of the parameters, on their scales; infinity
+   * for parameters without an upper bound.
+   *
+   * @param values array receiving getNumParameters() values.
+   */
+  void getUpperBounds (double* values) const;
+
+
+  /**
+   * Converts values on the scales of the parameters to model values.
+   *
+   * @param values array of getNumParameters() values on their scales.
+   * @param modelValues array receiving getNumParameters() model values;
+   * it may be @p values itself.
+   */
+  void toModelValues (const double* values, double* modelValues) const;
+
+
+  /**
+   * @return the model value that the given value on the given scale
+   * stands for.
+   */
+  static double toModelValue (double value, ScaleType_t scale);
+
+
+  /**
+   * @return the value on the given scale that stands for the given model
+   * value; NaN if a logarithmic scale is used for a value that is not
+   * positive.
+   */
+  static double toScaledValue (double modelValue, ScaleType_t scale);
+
+
+  /**
+   * @return the number of fit experiments of the bound task.
+   */
+  unsigned int getNumExperiments () const;
+
+
+  /**
+   * @return the nth fit experiment, or @c NULL if @p n is out of range.
+   */
+  const SedFitExperiment* getExperiment (unsigned int n) const;
+
+
+  /**
+   * @return the number of points of the nth fit experiment, or 0 if @p n
+   * is out of range.
+   */
+  unsigned int getNumPoints (unsigned int n) const;
+
+
+  /**
+   * @return the time points of the nth fit experiment, or @c NULL for a
+   * steady state experiment or if @p n is out of range.
+   */
+  const double* getTimes (unsigned int n) const;
+
+
+  /**
+   * @return the number of observables of the nth fit experiment, or 0 if
+   * @p n is out of range.
+   */
+  unsigned int getNumObservables (unsigned int n) const;
+
+
+  /**
+   * @return the data generator that the kth observable of the nth fit
+   * experiment is compared with, or @c NULL if @p n or @p k is out of
+   * range.
+   */
+  const SedDataGenerator* getObservable (unsigned int n, unsigned int k) const;
+
+
+  /**
+   * @return the getNumPoints() measured values of the kth observable of
+   * the nth fit experiment, or @c NULL if @p n or @p k is out of range.
+   */
+  const double* getMeasuredValues (unsigned int n, unsigned int k) const;
+
+
+  /**
+   * @return the getNumPoints() values of the kth observable of the nth fit
+   * experiment as simulated by the last call to evaluate(), or @c NULL if
+   * @p n or @p k is out of range.
+   */
+  const double* getSimulatedValues (unsigned int n, unsigned int k) const;
+
+
+  /**
+   * @return the index of the first residual of the nth fit experiment, or
+   * getNumResiduals() if @p n is out of range.  The residuals of an
+   * experiment are ordered by observable, then by point.
+   */
+  unsigned int getResidualOffset (unsigned int n) const;
+
+
+  /**
+   * @return the number of residuals: for each fit experiment, its number
+   * of observables times its number of points.
+   */
+  unsigned int getNumResiduals () const;
+
+
+  /**
+   * Evaluates the objective for the given parameter values.  This method
+   * must not be called by several threads at once.
+   *
+   * @param values array of getNumParameters() values, on the scales of the
+   * parameters.
+   * @param objective receives the sum of the squared residuals, or
+   * infinity if a simulation failed.
+   * @param residuals array receiving getNumResiduals() residuals, or
+   * @c NULL if they are not needed.  The residuals of an experiment whose
+   * simulation failed are NaN.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if no task is bound.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if a simulation failed.
+   */
+  int evaluate (const double* values, double& objective,
+                double* residuals = NULL);
+
+
+  /**
+   * @return the number of calls to evaluate() since the task was bound.
+   */
+  unsigned long long getNumEvaluations () const;
+
+
+  /**
+   * Releases the bound task, along with the simulators and data.
+   */
+  void unbind ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  class Experiment;
+
+  typedef std::shared_ptr<const std::vector<double> > Values;
+
+  struct Parameter
+  {
+    const SedAdjustableParameter* parameter;
+    SedSetValue* change;
+    ScaleType_t scale;
+    double initialValue;
+    double lowerBound;
+    double upperBound;
+  };
+
+  typedef std::unordered_map<std::string, SimulatorFactory> FactoryMap;
+
+  SedObjectiveEvaluator (const SedObjectiveEvaluator& orig);
+  SedObjectiveEvaluator& operator= (const SedObjectiveEvaluator& rhs);
+
+  int bindParameter (const SedAdjustableParameter* parameter);
+  int bindExperiment (const SedFitExperiment* fitExperiment);
+  int copyExperiment (const Experiment& orig);
+  int addExperiment (Experiment* experiment);
+  int readValues (const std::string& sourceId, Values& values);
+  const SedDataSource* getDataSource (const std::string& id) const;
+  SedSetValue* createChange (const std::string& targetId) const;
+  SedSimulator* createSimulator (const SedFitExperiment* fitExperiment) const;
+  int evaluateExperiment (Experiment& experiment, double* residuals) const;
+  int applyParameters (Experiment& experiment) const;
+
+  const SedDocument* mDocument;
+  FactoryMap mFactories;
+  unsigned int mNumThreads;
+  SedWorkStealingPool* mThreadPool;
+  SedModelBuilder mModelBuilder;
+  SedDataLoader mDataLoader;
+  const SedParameterEstimationTask* mTask;
+  std::vector<Parameter> mParameters;
+  std::vector<Experiment*> mExperiments;
+  std::vector<double> mModelValues;
+  std::vector<double> mResiduals;
+  unsigned int mNumResiduals;
+  unsigned long long mNumEvaluations;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedObjectiveEvaluator_h */
@@ -62,7 +62,7 @@ SedOneStep::SedOneStep(unsigned int level, unsigned int version)
 /*
  * Creates a new SedOneStep using the given SedNamespaces object @p sedmlns.
  */
-SedOneStep::SedOneStep(SedNamespaces *sedmlns)
+SedOneStep::SedOneStep(const SedNamespaces *sedmlns)
   : SedSimulation(sedmlns)
   , mStep (util_NaN())
   , mIsSetStep (false)
@@ -233,7 +233,11 @@ SedOneStep::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedOneStep::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -0,0 +1,130 @@
+/**
+ * @file SedOptimizer.h
+ * @brief Definition of the SedOptimizer class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedOptimizer
+ * @sbmlbrief{} Interface of the optimizers used by SedParameterEstimator.
+ *
+ * A SedOptimizer minimizes the objective of a parameter estimation task,
+ * which it evaluates through a SedObjectiveEvaluator.  The
+ * SedParameterEstimator creates optimizers through factories registered
+ * for the KiSAO ids of the algorithms they implement (see
+ * SedParameterEstimator::registerOptimizer()), configures them with the
+ * algorithm of the task and its algorithm parameters, and asks them to
+ * minimize from one start after another.
+ *
+ * Each optimizer is only ever used by one thread at a time, with an
+ * evaluator of its own, but several optimizers may run concurrently, so
+ * they must not share mutable state.
+ */
+
+
+#ifndef SedOptimizer_h
+#define SedOptimizer_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedAlgorithm;
+class SedObjectiveEvaluator;
+
+
+class LIBSEDML_EXTERN SedOptimizer
+{
+public:
+
+  /**
+   * Creates a new SedOptimizer.
+   */
+  SedOptimizer ();
+
+
+  /**
+   * Destroys this SedOptimizer.
+   */
+  virtual ~SedOptimizer ();
+
+
+  /**
+   * Configures this optimizer from the algorithm of a parameter
+   * estimation task and its algorithm parameters; it is called once,
+   * before minimize().  The default implementation accepts any algorithm.
+   *
+   * @param algorithm the algorithm, or @c NULL if the task has none.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   */
+  virtual int setAlgorithm (const SedAlgorithm* algorithm);
+
+
+  /**
+   * Minimizes the objective of the task bound by the given evaluator.
+   *
+   * @param evaluator the evaluator, with a task bound.
+   * @param values array of SedObjectiveEvaluator::getNumParameters()
+   * values on the scales of the parameters: the start, which is replaced
+   * by the best values found.
+   * @param objective receives the objective for the best values.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   */
+  virtual int minimize (SedObjectiveEvaluator& evaluator, double* values,
+                        double& objective) = 0;
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  SedOptimizer (const SedOptimizer& orig);
+  SedOptimizer& operator= (const SedOptimizer& rhs);
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedOptimizer_h */
@@ -70,7 +70,7 @@ SedOutput::SedOutput(unsigned int level, unsigned int version)
 /*
  * Creates a new SedOutput using the given SedNamespaces object @p sedmlns.
  */
-SedOutput::SedOutput(SedNamespaces *sedmlns)
+SedOutput::SedOutput(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mElementName("output")
 {
@@ -252,7 +252,11 @@ SedOutput::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedOutput::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
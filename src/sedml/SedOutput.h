@@ -97,7 +97,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedOutput(SedNamespaces *sedmlns);
+  SedOutput(const SedNamespaces *sedmlns);
 
 
   /**
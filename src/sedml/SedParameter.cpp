@@ -66,7 +66,7 @@ SedParameter::SedParameter(unsigned int level, unsigned int version)
 /*
  * Creates a new SedParameter using the given SedNamespaces object @p sedmlns.
  */
-SedParameter::SedParameter(SedNamespaces *sedmlns)
+SedParameter::SedParameter(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mValue (util_NaN())
   , mIsSetValue (false)
@@ -244,7 +244,11 @@ SedParameter::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedParameter::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -65,8 +65,8 @@ SedParameterEstimationReport::SedParameterEstimationReport(unsigned int level,
  * Creates a new SedParameterEstimationReport using the given SedNamespaces
  * object @p sedmlns.
  */
-SedParameterEstimationReport::SedParameterEstimationReport(SedNamespaces
-  *sedmlns)
+SedParameterEstimationReport::SedParameterEstimationReport(const
+  SedNamespaces *sedmlns)
   : SedOutput(sedmlns)
   , mTaskReference ("")
 {
@@ -149,6 +149,8 @@ SedParameterEstimationReport::isSetTaskReference() const
 int
 SedParameterEstimationReport::setTaskReference(const std::string& taskReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(taskReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -168,6 +170,8 @@ SedParameterEstimationReport::setTaskReference(const std::string& taskReference)
 int
 SedParameterEstimationReport::unsetTaskReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mTaskReference.erase();
 
   if (mTaskReference.empty() == true)
@@ -259,7 +263,11 @@ SedParameterEstimationReport::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedParameterEstimationReport::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -93,7 +93,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedParameterEstimationReport(SedNamespaces *sedmlns);
+  SedParameterEstimationReport(const SedNamespaces *sedmlns);
 
 
   /**
@@ -67,8 +67,8 @@ SedParameterEstimationResultPlot::SedParameterEstimationResultPlot(
  * Creates a new SedParameterEstimationResultPlot using the given SedNamespaces
  * object @p sedmlns.
  */
-SedParameterEstimationResultPlot::SedParameterEstimationResultPlot(SedNamespaces
-  *sedmlns)
+SedParameterEstimationResultPlot::SedParameterEstimationResultPlot(const
+  SedNamespaces *sedmlns)
   : SedPlot(sedmlns)
   , mTaskReference ("")
 {
@@ -152,6 +152,8 @@ SedParameterEstimationResultPlot::isSetTaskReference() const
 int
 SedParameterEstimationResultPlot::setTaskReference(const std::string& taskReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(taskReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -171,6 +173,8 @@ SedParameterEstimationResultPlot::setTaskReference(const std::string& taskRefere
 int
 SedParameterEstimationResultPlot::unsetTaskReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mTaskReference.erase();
 
   if (mTaskReference.empty() == true)
@@ -264,7 +268,11 @@ SedParameterEstimationResultPlot::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedParameterEstimationResultPlot::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
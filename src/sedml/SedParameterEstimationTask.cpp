@@ -70,7 +70,7 @@ SedParameterEstimationTask::SedParameterEstimationTask(unsigned int level,
  * Creates a new SedParameterEstimationTask using the given SedNamespaces
  * object @p sedmlns.
  */
-SedParameterEstimationTask::SedParameterEstimationTask(SedNamespaces *sedmlns)
+SedParameterEstimationTask::SedParameterEstimationTask(const SedNamespaces *sedmlns)
   : SedAbstractTask(sedmlns)
   , mAlgorithm (NULL)
   , mObjective (NULL)
@@ -787,7 +787,52 @@ SedParameterEstimationTask::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedParameterEstimationTask::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedParameterEstimationTask
+ */
+unsigned int
+SedParameterEstimationTask::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    mAlgorithm,
+    mObjective,
+    &mAdjustableParameters,
+    &mFitExperiments
+  };
+
+  return SedAbstractTask::getNumChildElements() +
+    countChildElements(children, 4);
+}
+
+
+/*
+ * Returns the nth child object of this SedParameterEstimationTask
+ */
+const SedBase*
+SedParameterEstimationTask::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedAbstractTask::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedAbstractTask::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    mAlgorithm,
+    mObjective,
+    &mAdjustableParameters,
+    &mFitExperiments
+  };
+
+  return selectChildElement(children, 4, n - inherited);
 }
 
 /** @endcond */
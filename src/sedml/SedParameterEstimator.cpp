@@ -0,0 +1,523 @@
+/**
+ * @file SedParameterEstimator.cpp
+ * @brief Implementation of the SedParameterEstimator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedParameterEstimator.h>
+#include <sedml/SedOptimizer.h>
+#include <sedml/SedTaskResult.h>
+#include <sedml/SedWorkStealingPool.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedAlgorithmParameter.h>
+#include <sedml/SedParameterEstimationTask.h>
+#include <sedml/SedAdjustableParameter.h>
+#include <sedml/SedFitExperiment.h>
+#include <sedml/SedFitMapping.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+SedParameterEstimator::SedParameterEstimator (const SedDocument* document)
+  : mDocument(document)
+  , mFactories()
+  , mOptimizers()
+  , mNumThreads(0)
+  , mThreadPool(NULL)
+  , mNumStarts(8)
+  , mSeed(0)
+  , mEvaluator(document)
+  , mResults()
+{
+}
+
+
+SedParameterEstimator::~SedParameterEstimator ()
+{
+  clearResults();
+}
+
+
+void
+SedParameterEstimator::registerSimulator (const std::string& kisaoId,
+                                          const SimulatorFactory& factory)
+{
+  mFactories[kisaoId] = factory;
+  mEvaluator.registerSimulator(kisaoId, factory);
+}
+
+
+void
+SedParameterEstimator::registerOptimizer (const std::string& kisaoId,
+                                          const OptimizerFactory& factory)
+{
+  mOptimizers[kisaoId] = factory;
+}
+
+
+bool
+SedParameterEstimator::hasOptimizer (const std::string& kisaoId) const
+{
+  return mOptimizers.find(kisaoId) != mOptimizers.end()
+    || mOptimizers.find("") != mOptimizers.end();
+}
+
+
+void
+SedParameterEstimator::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+unsigned int
+SedParameterEstimator::getNumThreads () const
+{
+  return mNumThreads;
+}
+
+
+void
+SedParameterEstimator::setThreadPool (SedWorkStealingPool* pool)
+{
+  mThreadPool = pool;
+}
+
+
+SedWorkStealingPool*
+SedParameterEstimator::getThreadPool () const
+{
+  return mThreadPool;
+}
+
+
+void
+SedParameterEstimator::setNumStarts (unsigned int numStarts)
+{
+  mNumStarts = max(numStarts, 1u);
+}
+
+
+unsigned int
+SedParameterEstimator::getNumStarts () const
+{
+  return mNumStarts;
+}
+
+
+void
+SedParameterEstimator::setSeed (unsigned long long seed)
+{
+  mSeed = seed;
+}
+
+
+unsigned long long
+SedParameterEstimator::getSeed () const
+{
+  return mSeed;
+}
+
+
+SedModelBuilder&
+SedParameterEstimator::getModelBuilder ()
+{
+  return mEvaluator.getModelBuilder();
+}
+
+
+SedDataLoader&
+SedParameterEstimator::getDataLoader ()
+{
+  return mEvaluator.getDataLoader();
+}
+
+
+int
+SedParameterEstimator::estimate (const std::string& taskId)
+{
+  ResultMap::iterator it = mResults.find(taskId);
+  if (it != mResults.end())
+  {
+    delete it->second;
+    mResults.erase(it);
+  }
+
+  int status = mEvaluator.bind(taskId);
+  if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+  unsigned long long seed = mSeed;
+  status = readSeed(seed);
+
+  vector<Start> starts;
+  if (status == LIBSEDML_OPERATION_SUCCESS)
+  {
+    sampleStarts(starts, seed);
+    status = runStarts(starts);
+  }
+
+  if (status == LIBSEDML_OPERATION_SUCCESS)
+  {
+    mResults[taskId] = createResult(starts);
+  }
+
+  mEvaluator.unbind();
+  return status;
+}
+
+
+const SedTaskResult*
+SedParameterEstimator::getResult (const std::string& taskId) const
+{
+  ResultMap::const_iterator it = mResults.find(taskId);
+  return (it == mResults.end()) ? NULL : it->second;
+}
+
+
+void
+SedParameterEstimator::clearResults ()
+{
+  for (ResultMap::iterator it = mResults.begin(); it != mResults.end(); ++it)
+  {
+    delete it->second;
+  }
+  mResults.clear();
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Creates the optimizer for the algorithm of the bound task, falling back
+ * to the one registered for all algorithms.
+ */
+SedOptimizer*
+SedParameterEstimator::createOptimizer () const
+{
+  const SedAlgorithm* algorithm = mEvaluator.getTask()->getAlgorithm();
+  string kisaoId = (algorithm != NULL) ? algorithm->getKisaoID() : "";
+
+  OptimizerMap::const_iterator it = mOptimizers.find(kisaoId);
+  if (it == mOptimizers.end()) it = mOptimizers.find("");
+  if (it == mOptimizers.end() || !it->second) return NULL;
+
+  return it->second();
+}
+
+
+/*
+ * Reads the seed from the algorithm parameter KISAO:0000488 of the bound
+ * task, if it has one.
+ */
+int
+SedParameterEstimator::readSeed (unsigned long long& seed) const
+{
+  const SedAlgorithm* algorithm = mEvaluator.getTask()->getAlgorithm();
+  if (algorithm == NULL) return LIBSEDML_OPERATION_SUCCESS;
+
+  for (unsigned int i = 0; i < algorithm->getNumAlgorithmParameters(); ++i)
+  {
+    const SedAlgorithmParameter* parameter =
+      algorithm->getAlgorithmParameter(i);
+    if (parameter->getKisaoID() != "KISAO:0000488") continue;
+
+    const char* value = parameter->getValue().c_str();
+    char* end;
+    seed = strtoull(value, &end, 10);
+    if (end == value || *end != '\0') return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Samples the starts before any of them runs, so that they do not depend
+ * on the number of threads.  Parameters that are not bounded on both
+ * sides are sampled within 1 of their initial value.
+ */
+void
+SedParameterEstimator::sampleStarts (std::vector<Start>& starts,
+                                     unsigned long long seed)
+{
+  unsigned int numParameters = mEvaluator.getNumParameters();
+  vector<double> initialValues(numParameters);
+  vector<double> lowerBounds(numParameters);
+  vector<double> upperBounds(numParameters);
+  mEvaluator.getInitialValues(initialValues.data());
+  mEvaluator.getLowerBounds(lowerBounds.data());
+  mEvaluator.getUpperBounds(upperBounds.data());
+
+  mt19937_64 generator(seed);
+  starts.resize(mNumStarts);
+
+  for (unsigned int n = 0; n < mNumStarts; ++n)
+  {
+    Start& start = starts[n];
+    start.values = initialValues;
+    start.objective = numeric_limits<double>::infinity();
+    start.numEvaluations = 0;
+    start.status = LIBSEDML_OPERATION_FAILED;
+
+    if (n == 0) continue;
+
+    for (unsigned int i = 0; i < numParameters; ++i)
+    {
+      double lower = max(lowerBounds[i], initialValues[i] - 1.0);
+      double upper = min(upperBounds[i], initialValues[i] + 1.0);
+      if (std::isfinite(lowerBounds[i]) && std::isfinite(upperBounds[i]))
+      {
+        lower = lowerBounds[i];
+        upper = upperBounds[i];
+      }
+
+      start.values[i] = uniform_real_distribution<double>(lower, upper)(
+        generator);
+    }
+  }
+}
+
+
+/*
+ * Minimizes from all starts, on as many threads as there are starts at
+ * most.  Each start is run by an idle worker: an optimizer with an
+ * evaluator of its own, bound to the primary evaluator.  The starts and
+ * the evaluators share one pool; the evaluators only use its threads when
+ * there is a single worker.
+ */
+int
+SedParameterEstimator::runStarts (std::vector<Start>& starts)
+{
+  SedWorkStealingPool& pool = (mThreadPool != NULL)
+    ? *mThreadPool : SedWorkStealingPool::getSharedPool();
+  unsigned int numThreads = (mNumThreads != 0)
+    ? mNumThreads : pool.getNumThreads();
+  unsigned int numWorkers = min(numThreads, (unsigned int)starts.size());
+  numWorkers = max(numWorkers, 1u);
+
+  vector<unique_ptr<SedObjectiveEvaluator> > evaluators;
+  vector<unique_ptr<SedOptimizer> > optimizers;
+  vector<size_t> idle;
+  int status;
+
+  for (unsigned int w = 0; w < numWorkers; ++w)
+  {
+    SedObjectiveEvaluator* evaluator = &mEvaluator;
+    if (w > 0)
+    {
+      evaluator = new SedObjectiveEvaluator(mDocument);
+      evaluators.push_back(unique_ptr<SedObjectiveEvaluator>(evaluator));
+
+      for (FactoryMap::const_iterator it = mFactories.begin();
+           it != mFactories.end(); ++it)
+      {
+        evaluator->registerSimulator(it->first, it->second);
+      }
+
+      status = evaluator->bind(mEvaluator);
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+    }
+    else
+    {
+      evaluators.push_back(unique_ptr<SedObjectiveEvaluator>());
+    }
+    evaluator->setThreadPool(mThreadPool);
+    evaluator->setNumThreads((numWorkers > 1) ? 1 : numThreads);
+
+    SedOptimizer* optimizer = createOptimizer();
+    if (optimizer == NULL) return LIBSEDML_INVALID_OBJECT;
+    optimizers.push_back(unique_ptr<SedOptimizer>(optimizer));
+
+    status = optimizer->setAlgorithm(mEvaluator.getTask()->getAlgorithm());
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+    idle.push_back(w);
+  }
+
+  mutex idleMutex;
+
+  pool.runJobs(starts.size(), numWorkers, [&](size_t n)
+  {
+    size_t w;
+    {
+      lock_guard<mutex> lock(idleMutex);
+      w = idle.back();
+      idle.pop_back();
+    }
+
+    SedObjectiveEvaluator& evaluator =
+      evaluators[w] ? *evaluators[w] : mEvaluator;
+    Start& start = starts[n];
+    unsigned long long numEvaluations = evaluator.getNumEvaluations();
+
+    start.status = optimizers[w]->minimize(evaluator, start.values.data(),
+                                           start.objective);
+    if (start.status != LIBSEDML_OPERATION_SUCCESS
+        || std::isnan(start.objective))
+    {
+      start.objective = numeric_limits<double>::infinity();
+    }
+    start.numEvaluations = evaluator.getNumEvaluations() - numEvaluations;
+
+    lock_guard<mutex> lock(idleMutex);
+    idle.push_back(w);
+  });
+
+  // the evaluators of the workers share the data of the primary one, and
+  // have to be released before it is
+  evaluators.clear();
+
+  for (size_t n = 0; n < starts.size(); ++n)
+  {
+    if (starts[n].status == LIBSEDML_OPERATION_SUCCESS)
+    {
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  }
+
+  return LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Collects the starts, ordered from the lowest objective, and the data of
+ * the fit experiments with the values simulated for the best start.
+ */
+SedTaskResult*
+SedParameterEstimator::createResult (std::vector<Start>& starts)
+{
+  vector<size_t> order(starts.size());
+  for (size_t n = 0; n < order.size(); ++n) order[n] = n;
+  stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+  {
+    return starts[a].objective < starts[b].objective;
+  });
+
+  unsigned int numParameters = mEvaluator.getNumParameters();
+  SedTaskResult* result = new SedTaskResult();
+  result->setTaskId(mEvaluator.getTask()->getId());
+
+  // columns are added one after the other, as adding one may move the
+  // others
+  vector<double>& startColumn = result->addColumn("start");
+  for (size_t n = 0; n < order.size(); ++n)
+  {
+    startColumn.push_back((double)order[n]);
+  }
+
+  vector<double> modelValues(numParameters);
+  for (unsigned int i = 0; i < numParameters; ++i)
+  {
+    const SedAdjustableParameter* parameter = mEvaluator.getParameter(i);
+    vector<double>& column = result->addColumn(
+      parameter->isSetId() ? parameter->getId() : parameter->getTarget());
+
+    for (size_t n = 0; n < order.size(); ++n)
+    {
+      mEvaluator.toModelValues(starts[order[n]].values.data(),
+                               modelValues.data());
+      column.push_back(modelValues[i]);
+    }
+  }
+
+  vector<double>& objectiveColumn = result->addColumn("objective");
+  for (size_t n = 0; n < order.size(); ++n)
+  {
+    objectiveColumn.push_back(starts[order[n]].objective);
+  }
+
+  vector<double>& evaluationsColumn = result->addColumn("evaluations");
+  for (size_t n = 0; n < order.size(); ++n)
+  {
+    evaluationsColumn.push_back((double)starts[order[n]].numEvaluations);
+  }
+
+  double objective;
+  mEvaluator.evaluate(starts[order[0]].values.data(), objective);
+
+  for (unsigned int n = 0; n < mEvaluator.getNumExperiments(); ++n)
+  {
+    const SedFitExperiment* fitExperiment = mEvaluator.getExperiment(n);
+    unsigned int numPoints = mEvaluator.getNumPoints(n);
+
+    SedTaskResult* child = result->createChild();
+    child->setTaskId(fitExperiment->getId());
+
+    const double* times = mEvaluator.getTimes(n);
+    if (times != NULL)
+    {
+      child->addColumn("time").assign(times, times + numPoints);
+    }
+
+    // the observables are numbered in the order of their fit mappings
+    unsigned int k = 0;
+    for (unsigned int i = 0; i < fitExperiment->getNumFitMappings(); ++i)
+    {
+      const SedFitMapping* mapping = fitExperiment->getFitMapping(i);
+      if (mapping->getType() != SEDML_MAPPINGTYPE_OBSERVABLE) continue;
+
+      const double* measured = mEvaluator.getMeasuredValues(n, k);
+      const double* simulated = mEvaluator.getSimulatedValues(n, k);
+      child->addColumn(mapping->getDataSource())
+        .assign(measured, measured + numPoints);
+      child->addColumn(mEvaluator.getObservable(n, k)->getId())
+        .assign(simulated, simulated + numPoints);
+      ++k;
+    }
+  }
+
+  return result;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,322 @@
+/**
+ * @file SedParameterEstimator.h
+ * @brief Definition of the SedParameterEstimator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedParameterEstimator
+ * @sbmlbrief{} Estimates the parameters of a SED-ML parameter estimation
+ * task from many starts at once.
+ *
+ * A SedParameterEstimator runs a SedOptimizer from several starts, which
+ * are sampled uniformly within the bounds of the adjustable parameters on
+ * their scales; the first start is the initial values of the parameters.
+ * Optimizers and simulators are plugged in through factories, one for
+ * each KiSAO id of the algorithms they implement.
+ *
+ * The starts are distributed over a SedWorkStealingPool, by default the
+ * one shared by all of libSEDML.  Each thread minimizes with an optimizer
+ * and a SedObjectiveEvaluator of its own, but all evaluators share the
+ * experimental data and the models, which are read and built only once.
+ * When several starts run at once, each evaluator runs its experiments
+ * on its own thread; a single start has its experiments evaluated on the
+ * threads of the pool.  A seed for sampling the starts can
+ * be given with the algorithm parameter KISAO:0000488 of the task, or
+ * with setSeed().
+ *
+ * The results of a task are kept as a SedTaskResult with the id of the
+ * task and one row for each start, ordered from the lowest objective: the
+ * columns "start" (the number of the start), one column for each
+ * adjustable parameter named by its id, or its target if it has no id,
+ * with the values the start ended at, "objective" and "evaluations".
+ * Each fit experiment adds a child result with the id of the experiment
+ * and the columns "time", for time courses, a column of measured values
+ * named by the data source of each observable, and a column of the values
+ * simulated for the best parameters, named by the data generator of the
+ * observable.  These are the values that SedParameterEstimationReport and
+ * SedParameterEstimationResultPlot outputs show.
+ *
+ * @code{.cpp}
+SedParameterEstimator estimator(doc);
+estimator.registerSimulator("KISAO:0000019", createCvodeSimulator);
+estimator.registerOptimizer("", createOptimizer);
+estimator.setNumStarts(100);
+
+if (estimator.estimate("task1") == LIBSEDML_OPERATION_SUCCESS)
+{
+  const SedTaskResult* result = estimator.getResult("task1");
+  // ...
+}
+ * @endcode
+ */
+
+
+#ifndef SedParameterEstimator_h
+#define SedParameterEstimator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedObjectiveEvaluator.h>
+
+
+#ifdef __cplusplus
+
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedOptimizer;
+class SedTaskResult;
+class SedWorkStealingPool;
+
+
+class LIBSEDML_EXTERN SedParameterEstimator
+{
+public:
+
+  /**
+   * Creates a new simulator, owned by the caller.
+   */
+  typedef SedObjectiveEvaluator::SimulatorFactory SimulatorFactory;
+
+
+  /**
+   * Creates a new optimizer, owned by the caller.
+   */
+  typedef std::function<SedOptimizer* ()> OptimizerFactory;
+
+
+  /**
+   * Creates a new SedParameterEstimator for the parameter estimation tasks
+   * of the given document.
+   *
+   * @param document the SED-ML document; it has to outlive this estimator
+   * and must not be modified during estimate().
+   */
+  explicit SedParameterEstimator (const SedDocument* document);
+
+
+  /**
+   * Destroys this SedParameterEstimator, along with its results.
+   */
+  ~SedParameterEstimator ();
+
+
+  /**
+   * Registers the simulator used for the given algorithm.
+   *
+   * @param kisaoId the KiSAO id of the algorithm of a fit experiment, or
+   * an empty string for the simulator used for all algorithms without a
+   * simulator of their own.
+   * @param factory the function creating the simulators.
+   */
+  void registerSimulator (const std::string& kisaoId,
+                          const SimulatorFactory& factory);
+
+
+  /**
+   * Registers the optimizer used for the given algorithm.
+   *
+   * @param kisaoId the KiSAO id of the algorithm of a parameter estimation
+   * task, or an empty string for the optimizer used for all algorithms
+   * without an optimizer of their own.
+   * @param factory the function creating the optimizers.
+   */
+  void registerOptimizer (const std::string& kisaoId,
+                          const OptimizerFactory& factory);
+
+
+  /**
+   * @return @c true if an optimizer is registered for the given algorithm,
+   * or for all algorithms.
+   */
+  bool hasOptimizer (const std::string& kisaoId) const;
+
+
+  /**
+   * Sets the number of threads the starts are distributed over.
+   *
+   * @param numThreads the number of threads, or 0 to use all threads of
+   * the thread pool.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads the starts are distributed over, or 0.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Sets the thread pool the starts, and the fit experiments of a single
+   * start, are run on.
+   *
+   * @param pool the pool, which has to outlive this estimator, or
+   * @c NULL for the pool shared by all of libSEDML.
+   */
+  void setThreadPool (SedWorkStealingPool* pool);
+
+
+  /**
+   * @return the thread pool the starts are run on, or @c NULL for the
+   * pool shared by all of libSEDML.
+   */
+  SedWorkStealingPool* getThreadPool () const;
+
+
+  /**
+   * Sets the number of starts of the optimizer.
+   *
+   * @param numStarts the number of starts, at least 1; the default is 8.
+   */
+  void setNumStarts (unsigned int numStarts);
+
+
+  /**
+   * @return the number of starts of the optimizer.
+   */
+  unsigned int getNumStarts () const;
+
+
+  /**
+   * Sets the seed for sampling the starts, unless the algorithm of the
+   * task sets one with the parameter KISAO:0000488.
+   *
+   * @param seed the seed.
+   */
+  void setSeed (unsigned long long seed);
+
+
+  /**
+   * @return the seed for sampling the starts.
+   */
+  unsigned long long getSeed () const;
+
+
+  /**
+   * @return the model builder used for building the models of the fit
+   * experiments, for instance to set its base directory.
+   */
+  SedModelBuilder& getModelBuilder ();
+
+
+  /**
+   * @return the loader reading the data of the fit mappings, for instance
+   * to set its base directory.
+   */
+  SedDataLoader& getDataLoader ();
+
+
+  /**
+   * Estimates the parameters of the parameter estimation task with the
+   * given id, replacing its results.
+   *
+   * @param taskId the id of a SedParameterEstimationTask.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * if at least one start succeeded.
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if the task cannot be bound (see SedObjectiveEvaluator::bind()), or
+   * if there is no optimizer for its algorithm.
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if an algorithm parameter is invalid.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if data cannot be read, a simulator cannot load its model, or no
+   * start succeeded.
+   */
+  int estimate (const std::string& taskId);
+
+
+  /**
+   * @return the results of the parameter estimation task with the given
+   * id, or @c NULL if it has not been estimated.
+   */
+  const SedTaskResult* getResult (const std::string& taskId) const;
+
+
+  /**
+   * Deletes the results of all tasks.
+   */
+  void clearResults ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  struct Start
+  {
+    std::vector<double> values;
+    double objective;
+    unsigned long long numEvaluations;
+    int status;
+  };
+
+  typedef std::unordered_map<std::string, SimulatorFactory> FactoryMap;
+  typedef std::unordered_map<std::string, OptimizerFactory> OptimizerMap;
+  typedef std::unordered_map<std::string, SedTaskResult*> ResultMap;
+
+  SedParameterEstimator (const SedParameterEstimator& orig);
+  SedParameterEstimator& operator= (const SedParameterEstimator& rhs);
+
+  SedOptimizer* createOptimizer () const;
+  int readSeed (unsigned long long& seed) const;
+  void sampleStarts (std::vector<Start>& starts, unsigned long long seed);
+  int runStarts (std::vector<Start>& starts);
+  SedTaskResult* createResult (std::vector<Start>& starts);
+
+  const SedDocument* mDocument;
+  FactoryMap mFactories;
+  OptimizerMap mOptimizers;
+  unsigned int mNumThreads;
+  SedWorkStealingPool* mThreadPool;
+  unsigned int mNumStarts;
+  unsigned long long mSeed;
+  SedObjectiveEvaluator mEvaluator;
+  ResultMap mResults;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedParameterEstimator_h */
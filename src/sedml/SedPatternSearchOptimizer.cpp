@@ -0,0 +1,208 @@
+/**
+ * @file SedPatternSearchOptimizer.cpp
+ * @brief Implementation of the SedPatternSearchOptimizer class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedPatternSearchOptimizer.h>
+#include <sedml/SedObjectiveEvaluator.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedAlgorithmParameter.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+SedPatternSearchOptimizer::SedPatternSearchOptimizer (
+  unsigned int maxIterations, double tolerance)
+  : SedOptimizer()
+  , mMaxIterations(maxIterations)
+  , mTolerance(tolerance)
+  , mNumIterations(0)
+  , mLowerBounds()
+  , mUpperBounds()
+  , mSteps()
+{
+}
+
+
+SedPatternSearchOptimizer::~SedPatternSearchOptimizer ()
+{
+}
+
+
+int
+SedPatternSearchOptimizer::setAlgorithm (const SedAlgorithm* algorithm)
+{
+  if (algorithm == NULL) return LIBSEDML_OPERATION_SUCCESS;
+
+  for (unsigned int i = 0; i < algorithm->getNumAlgorithmParameters(); ++i)
+  {
+    const SedAlgorithmParameter* parameter =
+      algorithm->getAlgorithmParameter(i);
+    const char* value = parameter->getValue().c_str();
+    char* end;
+
+    if (parameter->getKisaoID() == "KISAO:0000486")
+    {
+      long maxIterations = strtol(value, &end, 10);
+      if (end == value || *end != '\0' || maxIterations < 0)
+      {
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+      }
+      mMaxIterations = (unsigned int)maxIterations;
+    }
+    else if (parameter->getKisaoID() == "KISAO:0000211")
+    {
+      double tolerance = strtod(value, &end);
+      if (end == value || *end != '\0' || !(tolerance >= 0))
+      {
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+      }
+      mTolerance = tolerance;
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedPatternSearchOptimizer::minimize (SedObjectiveEvaluator& evaluator,
+                                     double* values, double& objective)
+{
+  mNumIterations = 0;
+
+  unsigned int numParameters = evaluator.getNumParameters();
+  mLowerBounds.resize(numParameters);
+  mUpperBounds.resize(numParameters);
+  mSteps.resize(numParameters);
+  evaluator.getLowerBounds(mLowerBounds.data());
+  evaluator.getUpperBounds(mUpperBounds.data());
+
+  for (unsigned int i = 0; i < numParameters; ++i)
+  {
+    values[i] = min(max(values[i], mLowerBounds[i]), mUpperBounds[i]);
+    bool bounded =
+      std::isfinite(mLowerBounds[i]) && std::isfinite(mUpperBounds[i]);
+    mSteps[i] = bounded ? 0.25 * (mUpperBounds[i] - mLowerBounds[i]) : 1.0;
+  }
+
+  int status = evaluator.evaluate(values, objective);
+  if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+  while (mNumIterations < mMaxIterations)
+  {
+    double largest = 0;
+    for (unsigned int i = 0; i < numParameters; ++i)
+    {
+      largest = max(largest, mSteps[i]);
+    }
+    if (largest <= mTolerance) break;
+
+    ++mNumIterations;
+
+    bool improved = false;
+    for (unsigned int i = 0; i < numParameters && !improved; ++i)
+    {
+      for (int direction = 1; direction >= -1 && !improved; direction -= 2)
+      {
+        double value = values[i];
+        double trial = min(max(value + direction * mSteps[i],
+                               mLowerBounds[i]), mUpperBounds[i]);
+        if (trial == value) continue;
+
+        // points where the simulation fails count as worse
+        double trialObjective;
+        values[i] = trial;
+        if (evaluator.evaluate(values, trialObjective)
+              == LIBSEDML_OPERATION_SUCCESS
+            && trialObjective < objective)
+        {
+          objective = trialObjective;
+          improved = true;
+        }
+        else
+        {
+          values[i] = value;
+        }
+      }
+    }
+
+    if (!improved)
+    {
+      for (unsigned int i = 0; i < numParameters; ++i)
+      {
+        mSteps[i] *= 0.5;
+      }
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+SedPatternSearchOptimizer::getMaxIterations () const
+{
+  return mMaxIterations;
+}
+
+
+double
+SedPatternSearchOptimizer::getTolerance () const
+{
+  return mTolerance;
+}
+
+
+unsigned int
+SedPatternSearchOptimizer::getNumIterations () const
+{
+  return mNumIterations;
+}
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
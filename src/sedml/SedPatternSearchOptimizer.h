@@ -0,0 +1,134 @@
+/**
+ * @file SedPatternSearchOptimizer.h
+ * @brief Definition of the SedPatternSearchOptimizer class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedPatternSearchOptimizer
+ * @sbmlbrief{} A SedOptimizer that needs no derivatives, for tests and
+ * simple problems.
+ *
+ * The SedPatternSearchOptimizer performs a compass search: it tries a
+ * step up and a step down along each parameter in turn, and moves to the
+ * first point that lowers the objective.  If no step does, all steps are
+ * halved.  The search ends when every step is below the tolerance, or
+ * after the maximum number of iterations.  Steps start at a quarter of
+ * the range between the bounds of a parameter, or at 1 if it is not
+ * bounded on both sides, and never leave the bounds.
+ *
+ * The algorithm parameters KISAO:0000486 (maximum iterations) and
+ * KISAO:0000211 (absolute tolerance) of the algorithm of the task
+ * override the defaults.
+ */
+
+
+#ifndef SedPatternSearchOptimizer_h
+#define SedPatternSearchOptimizer_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedOptimizer.h>
+
+
+#ifdef __cplusplus
+
+
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedPatternSearchOptimizer : public SedOptimizer
+{
+public:
+
+  /**
+   * Creates a new SedPatternSearchOptimizer.
+   *
+   * @param maxIterations the maximum number of iterations.
+   * @param tolerance the step size below which the search ends.
+   */
+  explicit SedPatternSearchOptimizer (unsigned int maxIterations = 1000,
+                                      double tolerance = 1e-6);
+
+
+  /**
+   * Destroys this SedPatternSearchOptimizer.
+   */
+  virtual ~SedPatternSearchOptimizer ();
+
+
+  virtual int setAlgorithm (const SedAlgorithm* algorithm);
+
+
+  virtual int minimize (SedObjectiveEvaluator& evaluator, double* values,
+                        double& objective);
+
+
+  /**
+   * @return the maximum number of iterations.
+   */
+  unsigned int getMaxIterations () const;
+
+
+  /**
+   * @return the step size below which the search ends.
+   */
+  double getTolerance () const;
+
+
+  /**
+   * @return the number of iterations of the last call to minimize().
+   */
+  unsigned int getNumIterations () const;
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  unsigned int mMaxIterations;
+  double mTolerance;
+  unsigned int mNumIterations;
+  std::vector<double> mLowerBounds;
+  std::vector<double> mUpperBounds;
+  std::vector<double> mSteps;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedPatternSearchOptimizer_h */
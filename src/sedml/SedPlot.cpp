@@ -69,7 +69,7 @@ SedPlot::SedPlot(unsigned int level, unsigned int version)
 /*
  * Creates a new SedPlot using the given SedNamespaces object @p sedmlns.
  */
-SedPlot::SedPlot(SedNamespaces *sedmlns)
+SedPlot::SedPlot(const SedNamespaces *sedmlns)
   : SedOutput(sedmlns)
   , mLegend (false)
   , mIsSetLegend (false)
@@ -605,7 +605,48 @@ SedPlot::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream& stream)
 bool
 SedPlot::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedPlot
+ */
+unsigned int
+SedPlot::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    mXAxis,
+    mYAxis
+  };
+
+  return SedOutput::getNumChildElements() +
+    countChildElements(children, 2);
+}
+
+
+/*
+ * Returns the nth child object of this SedPlot
+ */
+const SedBase*
+SedPlot::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedOutput::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedOutput::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    mXAxis,
+    mYAxis
+  };
+
+  return selectChildElement(children, 2, n - inherited);
 }
 
 /** @endcond */
@@ -66,7 +66,7 @@ SedPlot2D::SedPlot2D(unsigned int level, unsigned int version)
 /*
  * Creates a new SedPlot2D using the given SedNamespaces object @p sedmlns.
  */
-SedPlot2D::SedPlot2D(SedNamespaces *sedmlns)
+SedPlot2D::SedPlot2D(const SedNamespaces *sedmlns)
   : SedPlot(sedmlns)
   , mAbstractCurves (sedmlns)
   , mRightYAxis (NULL)
@@ -543,7 +543,48 @@ SedPlot2D::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedPlot2D::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedPlot2D
+ */
+unsigned int
+SedPlot2D::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    mRightYAxis,
+    &mAbstractCurves
+  };
+
+  return SedPlot::getNumChildElements() +
+    countChildElements(children, 2);
+}
+
+
+/*
+ * Returns the nth child object of this SedPlot2D
+ */
+const SedBase*
+SedPlot2D::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedPlot::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedPlot::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    mRightYAxis,
+    &mAbstractCurves
+  };
+
+  return selectChildElement(children, 2, n - inherited);
 }
 
 /** @endcond */
@@ -994,7 +1035,7 @@ SedPlot2D::getElementBySId(const std::string& id)
 List*
 SedPlot2D::getAllElements(SedElementFilter* filter)
 {
-  List* ret = new List();
+  List* ret = SedPlot::getAllElements(filter);
   List* sublist = NULL;
   SED_ADD_FILTERED_POINTER(ret, sublist, mRightYAxis, filter);
 
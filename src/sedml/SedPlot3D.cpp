@@ -63,7 +63,7 @@ SedPlot3D::SedPlot3D(unsigned int level, unsigned int version)
 /*
  * Creates a new SedPlot3D using the given SedNamespaces object @p sedmlns.
  */
-SedPlot3D::SedPlot3D(SedNamespaces *sedmlns)
+SedPlot3D::SedPlot3D(const SedNamespaces *sedmlns)
   : SedPlot(sedmlns)
   , mSurfaces (sedmlns)
   , mZAxis (NULL)
@@ -555,7 +555,48 @@ SedPlot3D::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedPlot3D::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedPlot3D
+ */
+unsigned int
+SedPlot3D::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    mZAxis,
+    &mSurfaces
+  };
+
+  return SedPlot::getNumChildElements() +
+    countChildElements(children, 2);
+}
+
+
+/*
+ * Returns the nth child object of this SedPlot3D
+ */
+const SedBase*
+SedPlot3D::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedPlot::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedPlot::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    mZAxis,
+    &mSurfaces
+  };
+
+  return selectChildElement(children, 2, n - inherited);
 }
 
 /** @endcond */
@@ -993,7 +1034,7 @@ SedPlot3D::getElementBySId(const std::string& id)
 List*
 SedPlot3D::getAllElements(SedElementFilter* filter)
 {
-  List* ret = new List();
+  List* ret = SedPlot::getAllElements(filter);
   List* sublist = NULL;
   SED_ADD_FILTERED_POINTER(ret, sublist, mZAxis, filter);
 
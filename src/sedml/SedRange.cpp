@@ -68,7 +68,7 @@ SedRange::SedRange(unsigned int level, unsigned int version)
 /*
  * Creates a new SedRange using the given SedNamespaces object @p sedmlns.
  */
-SedRange::SedRange(SedNamespaces *sedmlns)
+SedRange::SedRange(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mElementName("range")
 {
@@ -243,7 +243,11 @@ SedRange::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedRange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -95,7 +95,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedRange(SedNamespaces *sedmlns);
+  SedRange(const SedNamespaces *sedmlns);
 
 
   /**
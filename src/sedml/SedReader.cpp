@@ -42,6 +42,10 @@
 #include <sedml/SedDocument.h>
 #include <sedml/SedError.h>
 #include <sedml/SedReader.h>
+#include <sedml/SedReaderHandler.h>
+#include <sedml/SedLazyListLoader.h>
+#include <sedml/SedArena.h>
+#include <sedml/SedWorkStealingPool.h>
 
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/InputDecompressor.h>
@@ -60,6 +64,8 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new SedReader and returns it. 
  */
 SedReader::SedReader ()
+  : mLazyListLoading(false)
+  , mUseArena(false)
 {
 }
 
@@ -111,6 +117,41 @@ SedReader::readSedMLFromFile (const std::string& filename)
 }
 
 
+/*
+ * Reads the given files in parallel.
+ */
+std::vector<SedDocument*>
+SedReader::readSedMLBatch (const std::vector<std::string>& filenames,
+                           unsigned int numThreads)
+{
+  std::vector<SedDocument*> documents(filenames.size(), NULL);
+  if (filenames.empty()) return documents;
+
+  // some XML parsers set up their global state on first use, which must
+  // not happen on several threads at once
+  documents[0] = readInternal(filenames[0].c_str(), true);
+
+  try
+  {
+    SedWorkStealingPool::run(filenames.size() - 1, numThreads,
+      [&](size_t n)
+      {
+        documents[n + 1] = readInternal(filenames[n + 1].c_str(), true);
+      });
+  }
+  catch (...)
+  {
+    for (size_t n = 0; n < documents.size(); ++n)
+    {
+      delete documents[n];
+    }
+    throw;
+  }
+
+  return documents;
+}
+
+
 /*
  * Reads an Sed document from the given XML string.
  *
@@ -129,17 +170,82 @@ SedReader::readSedMLFromFile (const std::string& filename)
 SedDocument*
 SedReader::readSedMLFromString (const std::string& xml)
 {
-  const static string dummy_xml ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");  
-  
-  if (!strncmp(xml.c_str(), dummy_xml.c_str(), 14))
-  {
-    return readInternal(xml.c_str(), false);
-  }
-  else
-  {
-    const std::string temp = (dummy_xml + xml);
-    return readInternal(temp.c_str(), false);
-  }
+  return readInternalFromString(xml, NULL);
+}
+
+
+/*
+ * Reads a SED-ML document from the given file, passing the top-level
+ * elements to the given handler.
+ */
+SedDocument*
+SedReader::readSedML (const std::string& filename, SedReaderHandler& handler)
+{
+  return readInternal(filename.c_str(), true, &handler);
+}
+
+
+/*
+ * Reads a SED-ML document from the given file, passing the top-level
+ * elements to the given handler.
+ */
+SedDocument*
+SedReader::readSedMLFromFile (const std::string& filename,
+                              SedReaderHandler& handler)
+{
+  return readInternal(filename.c_str(), true, &handler);
+}
+
+
+/*
+ * Reads a SED-ML document from the given string, passing the top-level
+ * elements to the given handler.
+ */
+SedDocument*
+SedReader::readSedMLFromString (const std::string& xml,
+                                SedReaderHandler& handler)
+{
+  return readInternalFromString(xml, &handler);
+}
+
+
+/*
+ * Sets whether the top-level lists are read on first access.
+ */
+void
+SedReader::setLazyListLoading (bool lazyListLoading)
+{
+  mLazyListLoading = lazyListLoading;
+}
+
+
+/*
+ * Returns whether the top-level lists are read on first access.
+ */
+bool
+SedReader::getLazyListLoading () const
+{
+  return mLazyListLoading;
+}
+
+
+/*
+ * Sets whether documents are read into a memory arena.
+ */
+void
+SedReader::setUseArena (bool useArena)
+{
+  mUseArena = useArena;
+}
+
+
+/*
+ * Returns whether documents are read into a memory arena.
+ */
+bool
+SedReader::getUseArena () const
+{
+  return mUseArena;
 }
 
 
@@ -199,6 +305,18 @@ isCriticalError(const unsigned int errorId)
     return false;
   }
 }
+
+
+/*
+ * Predicate used to remove all but the critical errors from the log.
+ */
+struct IsNonCriticalError
+{
+  bool operator() (const XMLError* error) const
+  {
+    return !isCriticalError(error->getErrorId());
+  }
+};
 /** @endcond */
 
 
@@ -207,7 +325,8 @@ isCriticalError(const unsigned int errorId)
  * Used by readSedML() and readSedMLFromString().
  */
 SedDocument*
-SedReader::readInternal (const char* content, bool isFile)
+SedReader::readInternal (const char* content, bool isFile,
+                         SedReaderHandler* handler)
 {
   SedDocument* d = new SedDocument();
 
@@ -217,16 +336,54 @@ SedReader::readInternal (const char* content, bool isFile)
   }
   else 
   {
-    XMLInputStream stream(content, isFile, "", d->getErrorLog());
+    // when reading lists on first access, the document is read without them
+    std::string remaining;
+    SedLazyListLoader* loader = NULL;
+    if (mLazyListLoading && handler == NULL)
+    {
+      loader = createLazyListLoader(content, isFile, remaining);
+    }
+
+    XMLInputStream stream(loader != NULL ? remaining.c_str() : content,
+                          loader != NULL ? false : isFile, "",
+                          d->getErrorLog());
 
     if (stream.peek().isStart() && stream.peek().getName() != "sedML")
     {
       // the root element ought to be an sedml element. 
       d->getErrorLog()->logError(SedNotSchemaConformant);
+      delete loader;
 	  return d;
     }
 	
-    d->read(stream);
+    if (mUseArena)
+    {
+      d->setUseArena(true);
+    }
+
+    d->setReaderHandler(handler);
+    {
+      SedArenaScope scope(d);
+      d->read(stream);
+    }
+    d->setReaderHandler(NULL);
+
+    if (loader != NULL)
+    {
+      if (stream.isError())
+      {
+        // report the errors for the complete document instead; the
+        // setting is changed on a copy, as other threads may be reading
+        delete loader;
+        delete d;
+
+        SedReader eager(*this);
+        eager.mLazyListLoading = false;
+        return eager.readInternal(content, isFile);
+      }
+
+      d->setLazyListLoader(loader);
+    }
     
     if (stream.isError())
     {
@@ -243,11 +400,7 @@ SedReader::readInternal (const char* content, bool isFile)
           // If we find even one critical error, all other errors are
           // suspect and may be bogus.  Remove them.
 
-          for (int n = (int)d->getNumErrors()-1; n >= 0; --n)
-            if (!isCriticalError(d->getError((unsigned int)n)->getErrorId()))
-            {
-              d->getErrorLog()->remove(d->getError((unsigned int)n)->getErrorId());
-            }
+          d->getErrorLog()->removeIf(IsNonCriticalError());
 
           break;
         }
@@ -277,9 +430,67 @@ SedReader::readInternal (const char* content, bool isFile)
         d->getErrorLog()->logError(BadXMLDecl);
       }
     }
+
+    if (handler != NULL)
+    {
+      handler->endDocument(d);
+    }
   }
   return d;
 }
+
+
+/*
+ * Locates the top-level lists of the document, and returns the document
+ * without them in @p remaining.
+ */
+SedLazyListLoader*
+SedReader::createLazyListLoader (const char* content, bool isFile,
+                                 std::string& remaining)
+{
+  if (content == NULL) return NULL;
+
+  std::string text;
+  if (isFile)
+  {
+    if (!SedLazyListLoader::readFile(content, text)) return NULL;
+  }
+  else
+  {
+    text = content;
+  }
+
+  SedLazyListLoader* loader = new SedLazyListLoader();
+  if (!loader->scan(text, isFile ? std::string(content) : std::string()))
+  {
+    delete loader;
+    return NULL;
+  }
+
+  remaining = loader->getRemainingContent(text);
+  return loader;
+}
+
+
+/*
+ * Used by readSedMLFromString().
+ */
+SedDocument*
+SedReader::readInternalFromString (const std::string& xml,
+                                   SedReaderHandler* handler)
+{
+  const static string dummy_xml ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");  
+  
+  if (!strncmp(xml.c_str(), dummy_xml.c_str(), 14))
+  {
+    return readInternal(xml.c_str(), false, handler);
+  }
+  else
+  {
+    const std::string temp = (dummy_xml + xml);
+    return readInternal(temp.c_str(), false, handler);
+  }
+}
 /** @endcond */
 
 
@@ -48,10 +48,13 @@
 
 
 #include <string>
+#include <vector>
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
 class SedDocument;
+class SedReaderHandler;
+class SedLazyListLoader;
 
 
 class LIBSEDML_EXTERN SedReader
@@ -116,6 +119,134 @@ public:
   SedDocument* readSedMLFromString (const std::string& xml);
 
 
+  /**
+   * Reads the SED-ML document in the given file, passing its top-level
+   * elements to @p handler rather than building the full document tree.
+   *
+   * Each model, simulation, task, data generator, output and so on is
+   * handed to SedReaderHandler::handleElement() as soon as it has been read,
+   * and deleted afterwards (unless the handler takes ownership of it).
+   * Elements for which SedReaderHandler::skipElement() returns @c true are
+   * passed over without being created.
+   *
+   * @param filename the name or full pathname of the file to be read.
+   * @param handler the handler receiving the elements.
+   *
+   * @return a pointer to the SedDocument that has been read; it contains
+   * the attributes, namespaces and errors of the document, but none of the
+   * elements passed to @p handler.
+   *
+   * @see SedReaderHandler
+   */
+  SedDocument* readSedML (const std::string& filename,
+                          SedReaderHandler& handler);
+
+
+  /**
+   * This method is identical to readSedML(const std::string& filename,
+   * SedReaderHandler& handler).
+   *
+   * @param filename the name or full pathname of the file to be read.
+   * @param handler the handler receiving the elements.
+   *
+   * @return a pointer to the SedDocument that has been read.
+   *
+   * @see SedReaderHandler
+   */
+  SedDocument* readSedMLFromFile (const std::string& filename,
+                                  SedReaderHandler& handler);
+
+
+  /**
+   * Reads the SED-ML document in the given string, passing its top-level
+   * elements to @p handler rather than building the full document tree.
+   *
+   * @param xml a string containing a full SED-ML document.
+   * @param handler the handler receiving the elements.
+   *
+   * @return a pointer to the SedDocument that has been read.
+   *
+   * @see readSedML(const std::string& filename, SedReaderHandler& handler)
+   * @see SedReaderHandler
+   */
+  SedDocument* readSedMLFromString (const std::string& xml,
+                                    SedReaderHandler& handler);
+
+
+  /**
+   * Reads the given SED-ML files in parallel.
+   *
+   * Each file is read exactly as by readSedMLFromFile(), with the settings
+   * of this SedReader, and the errors found in a file are logged in the
+   * error log of its SedDocument.  The files are distributed over the
+   * threads dynamically, so that a few large files do not hold up the
+   * others.  Reading from several threads at once is safe, as long as no
+   * thread changes the settings of this SedReader meanwhile.
+   *
+   * @param filenames the names or full pathnames of the files to be read.
+   * @param numThreads the number of threads to use, or 0 to use as many as
+   * the hardware can run concurrently.
+   *
+   * @return the SedDocuments read, in the same order as @p filenames.  The
+   * caller owns them and is responsible for deleting them.
+   *
+   * @see readSedMLFromFile(const std::string& filename)
+   */
+  std::vector<SedDocument*> readSedMLBatch (
+    const std::vector<std::string>& filenames, unsigned int numThreads = 0);
+
+
+  /**
+   * Sets whether the top-level lists of a document (listOfModels,
+   * listOfTasks, listOfOutputs, ...) are read only when they are first
+   * accessed, rather than while the document is read.
+   *
+   * This saves time and memory for applications that only need part of a
+   * large document.  Note however that:
+   * @li errors in a list are only added to the error log of the
+   * SedDocument once that list has been read;
+   * @li when reading from a file, the file must not change until all
+   * lists have been accessed;
+   * @li the first access to a list modifies the document, so documents
+   * that have not been fully loaded must not be shared between threads.
+   *
+   * Documents that cannot be split up (for instance compressed files) are
+   * read completely.  The setting is ignored when reading with a
+   * SedReaderHandler.  The default is @c false.
+   *
+   * @param lazyListLoading @c true to read lists on first access.
+   */
+  void setLazyListLoading (bool lazyListLoading);
+
+
+  /**
+   * @return @c true if lists are read on first access.
+   *
+   * @see setLazyListLoading(bool lazyListLoading)
+   */
+  bool getLazyListLoading () const;
+
+
+  /**
+   * Sets whether the documents read by this SedReader allocate their
+   * elements from a memory arena, which makes reading and freeing large
+   * documents faster.
+   *
+   * @param useArena @c true to read documents into an arena.
+   *
+   * @see SedDocument::setUseArena(bool useArena)
+   */
+  void setUseArena (bool useArena);
+
+
+  /**
+   * @return @c true if documents are read into a memory arena.
+   *
+   * @see setUseArena(bool useArena)
+   */
+  bool getUseArena () const;
+
+
   /**
    * Static method; returns @c true if this copy of libSEDML supports
    * <i>gzip</I> and <i>zip</i> format compression.
@@ -145,7 +276,27 @@ protected:
   /**
    * Used by readSedML() and readSedMLFromString().
    */
-  SedDocument* readInternal (const char* content, bool isFile = true);
+  SedDocument* readInternal (const char* content, bool isFile = true,
+                             SedReaderHandler* handler = NULL);
+
+
+  /**
+   * Used by readSedMLFromString().
+   */
+  SedDocument* readInternalFromString (const std::string& xml,
+                                       SedReaderHandler* handler);
+
+
+  /**
+   * Used by readInternal() when lists are to be read on first access;
+   * returns @c NULL if the document has to be read completely.
+   */
+  SedLazyListLoader* createLazyListLoader (const char* content, bool isFile,
+                                           std::string& remaining);
+
+
+  bool mLazyListLoading;
+  bool mUseArena;
 
   /** @endcond */
 };
@@ -0,0 +1,177 @@
+/**
+ * @file SedReaderHandler.h
+ * @brief Definition of the SedReaderHandler class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedReaderHandler
+ * @sbmlbrief{} Receives the top-level elements of a SED-ML document while
+ * it is being read.
+ *
+ * A SedReaderHandler is passed to the streaming overloads of
+ * SedReader::readSedML(), SedReader::readSedMLFromFile() and
+ * SedReader::readSedMLFromString().  Instead of building the full
+ * SedDocument tree, the reader hands each child of the top-level
+ * <code>listOf*</code> elements (i.e. each model, simulation, task, data
+ * generator, output, &hellip;) to handleElement() as soon as it has been
+ * read completely, and then deletes it.  Thus the memory needed to read a
+ * document only depends on the size of its largest top-level element.
+ *
+ * By overriding skipElement() whole subtrees (for instance the
+ * <code>listOfOutputs</code>, or all annotations) can be skipped without
+ * creating any objects for them.
+ *
+ * @code{.cpp}
+class TaskCounter : public SedReaderHandler
+{
+public:
+  TaskCounter() : numTasks(0) {}
+
+  virtual bool skipElement(const SedBase* parent, const std::string& elementName)
+  {
+    return elementName == "listOfOutputs" || elementName == "annotation";
+  }
+
+  virtual bool handleElement(SedBase* element)
+  {
+    if (element->getTypeCode() == SEDML_TASK) ++numTasks;
+    return false;
+  }
+
+  unsigned int numTasks;
+};
+
+SedReader reader;
+TaskCounter counter;
+SedDocument* doc = reader.readSedML("simulation.sedml", counter);
+ * @endcode
+ */
+
+
+#ifndef SedReaderHandler_h
+#define SedReaderHandler_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedReaderHandler
+{
+public:
+
+  /**
+   * Creates a new SedReaderHandler.
+   */
+  SedReaderHandler ();
+
+
+  /**
+   * Destroys this SedReaderHandler.
+   */
+  virtual ~SedReaderHandler ();
+
+
+  /**
+   * Called once the attributes of the <code>&lt;sedML&gt;</code> element
+   * have been read.
+   *
+   * The default implementation does nothing.
+   *
+   * @param doc the SedDocument being read; it carries the level, version
+   * and namespaces of the document.
+   */
+  virtual void startDocument (const SedDocument* doc);
+
+
+  /**
+   * Called before an element is read, to decide whether it should be
+   * skipped.  A skipped element and all of its children are passed over
+   * without creating any objects or logging any errors for them.
+   *
+   * The default implementation does not skip anything.
+   *
+   * @param parent the object the element would be read into, for
+   * example the SedDocument for the <code>listOf*</code> elements.
+   * @param elementName the name of the element, e.g.
+   * <code>"listOfOutputs"</code> or <code>"annotation"</code>.
+   *
+   * @return @c true if the element should be skipped, @c false otherwise.
+   */
+  virtual bool skipElement (const SedBase* parent,
+                            const std::string& elementName);
+
+
+  /**
+   * Called for every child of a top-level <code>listOf*</code> element
+   * once it has been read completely.  While this method runs, the element
+   * is still part of the document.
+   *
+   * The default implementation does nothing.
+   *
+   * @param element the element that has been read.
+   *
+   * @return @c true if the handler takes ownership of @p element, in which
+   * case it is removed from the document but not deleted; @c false if the
+   * reader should delete it.
+   */
+  virtual bool handleElement (SedBase* element);
+
+
+  /**
+   * Called once the document has been read, before the reader returns.
+   *
+   * The default implementation does nothing.
+   *
+   * @param doc the SedDocument that has been read.  It no longer contains
+   * the elements passed to handleElement(), but it does contain all errors
+   * logged while reading.
+   */
+  virtual void endDocument (const SedDocument* doc);
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedReaderHandler_h */
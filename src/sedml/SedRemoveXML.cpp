@@ -61,7 +61,7 @@ SedRemoveXML::SedRemoveXML(unsigned int level, unsigned int version)
 /*
  * Creates a new SedRemoveXML using the given SedNamespaces object @p sedmlns.
  */
-SedRemoveXML::SedRemoveXML(SedNamespaces *sedmlns)
+SedRemoveXML::SedRemoveXML(const SedNamespaces *sedmlns)
   : SedChange(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -169,7 +169,11 @@ SedRemoveXML::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedRemoveXML::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -76,7 +76,7 @@ SedRepeatedTask::SedRepeatedTask(unsigned int level, unsigned int version)
  * Creates a new SedRepeatedTask using the given SedNamespaces object @p
  * sedmlns.
  */
-SedRepeatedTask::SedRepeatedTask(SedNamespaces *sedmlns)
+SedRepeatedTask::SedRepeatedTask(const SedNamespaces *sedmlns)
   : SedAbstractTask(sedmlns)
   , mRange ("")
   , mResetModel (false)
@@ -221,6 +221,8 @@ SedRepeatedTask::isSetConcatenate() const
 int
 SedRepeatedTask::setRangeId(const std::string& rangeId)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(rangeId)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -267,6 +269,8 @@ SedRepeatedTask::setConcatenate(bool concatenate)
 int
 SedRepeatedTask::unsetRangeId()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mRange.erase();
 
   if (mRange.empty() == true)
@@ -968,7 +972,50 @@ SedRepeatedTask::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedRepeatedTask::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedRepeatedTask
+ */
+unsigned int
+SedRepeatedTask::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mRanges,
+    &mSetValues,
+    &mSubTasks
+  };
+
+  return SedAbstractTask::getNumChildElements() +
+    countChildElements(children, 3);
+}
+
+
+/*
+ * Returns the nth child object of this SedRepeatedTask
+ */
+const SedBase*
+SedRepeatedTask::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedAbstractTask::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedAbstractTask::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mRanges,
+    &mSetValues,
+    &mSubTasks
+  };
+
+  return selectChildElement(children, 3, n - inherited);
 }
 
 /** @endcond */
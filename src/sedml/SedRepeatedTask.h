@@ -103,7 +103,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedRepeatedTask(SedNamespaces *sedmlns);
+  SedRepeatedTask(const SedNamespaces *sedmlns);
 
 
   /**
@@ -1018,6 +1018,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedRepeatedTask
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedRepeatedTask
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
@@ -0,0 +1,600 @@
+/**
+ * @file SedRepeatedTaskIterator.cpp
+ * @brief Implementation of the SedRepeatedTaskIterator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedRepeatedTaskIterator.h>
+#include <sedml/SedValueProvider.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedUniformRange.h>
+#include <sedml/SedVectorRange.h>
+#include <sedml/SedFunctionalRange.h>
+#include <sedml/SedDataRange.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedSubTask.h>
+#include <sedml/SedParameter.h>
+#include <sedml/SedVariable.h>
+
+#include <sbml/SBMLTransforms.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+static const double SED_NAN = numeric_limits<double>::quiet_NaN();
+
+
+/*
+ * Orders subtasks by their "order" attribute; subtasks without one keep
+ * their place after those that have one.
+ */
+struct SubTaskOrderComparator
+{
+  bool operator() (const SedSubTask* a, const SedSubTask* b) const
+  {
+    if (!a->isSetOrder()) return false;
+    if (!b->isSetOrder()) return true;
+    return a->getOrder() < b->getOrder();
+  }
+};
+
+
+/*
+ * Collects the names used in the given math.
+ */
+static void
+collectNames(const ASTNode* node, vector<string>& names)
+{
+  if (node == NULL) return;
+
+  if (node->isName())
+  {
+    names.push_back(node->getName());
+  }
+
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+  {
+    collectNames(node->getChild(i), names);
+  }
+}
+
+
+/*
+ * Adds the parameters and variables of a functional range or set value to
+ * the values used to evaluate its math, and removes them again.
+ */
+template <class Element>
+static void
+addLocalValues(const Element* element, SedValueProvider* provider,
+               map<const string, pair<double, bool> >& values,
+               vector<string>& added)
+{
+  for (unsigned int i = 0; i < element->getNumParameters(); ++i)
+  {
+    const SedParameter* parameter = element->getParameter(i);
+    values[parameter->getId()] = make_pair(parameter->getValue(), true);
+    added.push_back(parameter->getId());
+  }
+
+  for (unsigned int i = 0; i < element->getNumVariables(); ++i)
+  {
+    const SedVariable* variable = element->getVariable(i);
+    double value = (provider != NULL) ? provider->getVariableValue(variable)
+                                      : SED_NAN;
+    values[variable->getId()] = make_pair(value, true);
+    added.push_back(variable->getId());
+  }
+}
+
+
+static void
+removeLocalValues(map<const string, pair<double, bool> >& values,
+                  const vector<string>& added)
+{
+  for (vector<string>::const_iterator it = added.begin(); it != added.end(); ++it)
+  {
+    values.erase(*it);
+  }
+}
+
+/** @endcond */
+
+
+SedRepeatedTaskIterator::SedRepeatedTaskIterator (const SedRepeatedTask* task,
+                                                  SedValueProvider* provider)
+  : mTask(task)
+  , mProvider(provider)
+  , mRanges()
+  , mEvaluationOrder()
+  , mDataValues()
+  , mHasDataValues()
+  , mMaster(-1)
+  , mNumIterations(0)
+  , mSubTasks()
+  , mIndex(0)
+  , mRangeValues()
+  , mChangeValues()
+  , mValues()
+{
+  if (mTask == NULL) return;
+
+  for (unsigned int i = 0; i < mTask->getNumRanges(); ++i)
+  {
+    mRanges.push_back(mTask->getRange(i));
+  }
+
+  mDataValues.resize(mRanges.size());
+  mHasDataValues.resize(mRanges.size(), false);
+  mRangeValues.resize(mRanges.size(), SED_NAN);
+  mChangeValues.resize(mTask->getNumTaskChanges(), SED_NAN);
+
+  // a task with a single range does not need to name it
+  mMaster = findRange(mTask->getRangeId());
+  if (mMaster < 0 && mRanges.size() == 1)
+  {
+    mMaster = 0;
+  }
+
+  if (mMaster >= 0)
+  {
+    mNumIterations = getRangeSize((unsigned int)mMaster);
+  }
+
+  for (unsigned int i = 0; i < mTask->getNumSubTasks(); ++i)
+  {
+    mSubTasks.push_back(mTask->getSubTask(i));
+  }
+  stable_sort(mSubTasks.begin(), mSubTasks.end(), SubTaskOrderComparator());
+
+  orderRanges();
+  seek(0);
+}
+
+
+SedRepeatedTaskIterator::~SedRepeatedTaskIterator ()
+{
+}
+
+
+unsigned int
+SedRepeatedTaskIterator::getNumIterations () const
+{
+  return mNumIterations;
+}
+
+
+unsigned int
+SedRepeatedTaskIterator::getIndex () const
+{
+  return mIndex;
+}
+
+
+bool
+SedRepeatedTaskIterator::isAtEnd () const
+{
+  return mIndex >= mNumIterations;
+}
+
+
+bool
+SedRepeatedTaskIterator::next ()
+{
+  if (isAtEnd()) return false;
+
+  seek(mIndex + 1);
+  return !isAtEnd();
+}
+
+
+int
+SedRepeatedTaskIterator::seek (unsigned int index)
+{
+  if (index > mNumIterations)
+  {
+    return LIBSEDML_INDEX_EXCEEDS_SIZE;
+  }
+
+  mIndex = index;
+  if (!isAtEnd())
+  {
+    evaluate();
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+double
+SedRepeatedTaskIterator::getMasterValue () const
+{
+  return (mMaster >= 0) ? mRangeValues[(unsigned int)mMaster] : SED_NAN;
+}
+
+
+unsigned int
+SedRepeatedTaskIterator::getNumRanges () const
+{
+  return (unsigned int)mRanges.size();
+}
+
+
+const SedRange*
+SedRepeatedTaskIterator::getRange (unsigned int n) const
+{
+  return (n < mRanges.size()) ? mRanges[n] : NULL;
+}
+
+
+double
+SedRepeatedTaskIterator::getRangeValue (unsigned int n) const
+{
+  return (n < mRangeValues.size()) ? mRangeValues[n] : SED_NAN;
+}
+
+
+double
+SedRepeatedTaskIterator::getRangeValue (const std::string& id) const
+{
+  int n = findRange(id);
+  return (n >= 0) ? mRangeValues[(unsigned int)n] : SED_NAN;
+}
+
+
+unsigned int
+SedRepeatedTaskIterator::getNumChanges () const
+{
+  return (unsigned int)mChangeValues.size();
+}
+
+
+const SedSetValue*
+SedRepeatedTaskIterator::getChange (unsigned int n) const
+{
+  return (mTask != NULL) ? mTask->getTaskChange(n) : NULL;
+}
+
+
+double
+SedRepeatedTaskIterator::getChangeValue (unsigned int n) const
+{
+  return (n < mChangeValues.size()) ? mChangeValues[n] : SED_NAN;
+}
+
+
+double
+SedRepeatedTaskIterator::evaluateChange (const SedSetValue* change) const
+{
+  if (change == NULL || isAtEnd()) return SED_NAN;
+
+  if (!change->isSetMath())
+  {
+    // without math, the change assigns the value of its range
+    return getRangeValue(change->getRange());
+  }
+
+  vector<string> added;
+  addLocalValues(change, mProvider, mValues, added);
+  double value = SBMLTransforms::evaluateASTNode(change->getMath(), mValues);
+  removeLocalValues(mValues, added);
+
+  return value;
+}
+
+
+unsigned int
+SedRepeatedTaskIterator::getNumSubTasks () const
+{
+  return (unsigned int)mSubTasks.size();
+}
+
+
+const SedSubTask*
+SedRepeatedTaskIterator::getSubTask (unsigned int n) const
+{
+  return (n < mSubTasks.size()) ? mSubTasks[n] : NULL;
+}
+
+
+const SedAbstractTask*
+SedRepeatedTaskIterator::getSubTaskTask (unsigned int n) const
+{
+  const SedSubTask* subTask = getSubTask(n);
+  if (subTask == NULL || mTask == NULL) return NULL;
+
+  const SedDocument* doc = mTask->getSedDocument();
+  return (doc != NULL) ? doc->getTask(subTask->getTask()) : NULL;
+}
+
+
+SedRepeatedTaskIterator*
+SedRepeatedTaskIterator::createSubTaskIterator (unsigned int n) const
+{
+  const SedAbstractTask* task = getSubTaskTask(n);
+  if (task == NULL || task->getTypeCode() != SEDML_TASK_REPEATEDTASK)
+  {
+    return NULL;
+  }
+
+  return new SedRepeatedTaskIterator(
+    static_cast<const SedRepeatedTask*>(task), mProvider);
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+int
+SedRepeatedTaskIterator::findRange (const std::string& id) const
+{
+  if (id.empty()) return -1;
+
+  for (unsigned int i = 0; i < mRanges.size(); ++i)
+  {
+    if (mRanges[i]->getId() == id) return (int)i;
+  }
+
+  return -1;
+}
+
+
+/*
+ * Returns the number of values of the nth range; a functional range has as
+ * many values as the range it refers to.
+ */
+unsigned int
+SedRepeatedTaskIterator::getRangeSize (unsigned int n, unsigned int depth)
+{
+  if (n >= mRanges.size() || depth > mRanges.size()) return 0;
+
+  const SedRange* range = mRanges[n];
+
+  switch (range->getTypeCode())
+  {
+  case SEDML_RANGE_UNIFORMRANGE:
+  {
+    int numberOfSteps =
+      static_cast<const SedUniformRange*>(range)->getNumberOfSteps();
+    return (numberOfSteps < 0) ? 0 : (unsigned int)numberOfSteps + 1;
+  }
+
+  case SEDML_RANGE_VECTORRANGE:
+    return (unsigned int)
+      static_cast<const SedVectorRange*>(range)->getValues().size();
+
+  case SEDML_DATA_RANGE:
+    getPlainRangeValue(n, 0);
+    return (unsigned int)mDataValues[n].size();
+
+  case SEDML_RANGE_FUNCTIONALRANGE:
+  {
+    int index = findRange(
+      static_cast<const SedFunctionalRange*>(range)->getRange());
+    return (index < 0) ? 0 : getRangeSize((unsigned int)index, depth + 1);
+  }
+
+  default:
+    return 0;
+  }
+}
+
+
+/*
+ * Returns the value of a range that is not a functional range.
+ */
+double
+SedRepeatedTaskIterator::getPlainRangeValue (unsigned int n, unsigned int index)
+{
+  const SedRange* range = mRanges[n];
+
+  switch (range->getTypeCode())
+  {
+  case SEDML_RANGE_UNIFORMRANGE:
+  {
+    const SedUniformRange* uniform = static_cast<const SedUniformRange*>(range);
+    int numberOfSteps = uniform->getNumberOfSteps();
+    if (numberOfSteps <= 0) return uniform->getStart();
+
+    double fraction = (double)index / numberOfSteps;
+    if (uniform->getType() == "log")
+    {
+      return uniform->getStart()
+        * pow(uniform->getEnd() / uniform->getStart(), fraction);
+    }
+    return uniform->getStart()
+      + fraction * (uniform->getEnd() - uniform->getStart());
+  }
+
+  case SEDML_RANGE_VECTORRANGE:
+  {
+    const vector<double>& values =
+      static_cast<const SedVectorRange*>(range)->getValues();
+    return (index < values.size()) ? values[index] : SED_NAN;
+  }
+
+  case SEDML_DATA_RANGE:
+  {
+    // data ranges are fetched once, as they are read from a data source
+    if (!mHasDataValues[n])
+    {
+      mHasDataValues[n] = true;
+      if (mProvider == NULL || !mProvider->getDataRangeValues(
+            static_cast<const SedDataRange*>(range), mDataValues[n]))
+      {
+        mDataValues[n].clear();
+      }
+    }
+    return (index < mDataValues[n].size()) ? mDataValues[n][index] : SED_NAN;
+  }
+
+  default:
+    return SED_NAN;
+  }
+}
+
+
+/*
+ * Sorts the functional ranges so that every range is evaluated after the
+ * ranges it uses.  Ranges that depend on each other in a cycle are
+ * evaluated in document order.
+ */
+void
+SedRepeatedTaskIterator::orderRanges ()
+{
+  vector<unsigned int> functional;
+  for (unsigned int i = 0; i < mRanges.size(); ++i)
+  {
+    if (mRanges[i]->getTypeCode() == SEDML_RANGE_FUNCTIONALRANGE)
+      functional.push_back(i);
+    else
+      mEvaluationOrder.push_back(i);
+  }
+
+  vector<bool> done(mRanges.size(), false);
+  for (vector<unsigned int>::const_iterator it = mEvaluationOrder.begin();
+       it != mEvaluationOrder.end(); ++it)
+  {
+    done[*it] = true;
+  }
+
+  while (!functional.empty())
+  {
+    bool progress = false;
+
+    for (vector<unsigned int>::iterator it = functional.begin();
+         it != functional.end(); )
+    {
+      const SedFunctionalRange* range =
+        static_cast<const SedFunctionalRange*>(mRanges[*it]);
+
+      vector<string> names;
+      names.push_back(range->getRange());
+      collectNames(range->getMath(), names);
+
+      bool ready = true;
+      for (vector<string>::const_iterator name = names.begin();
+           name != names.end() && ready; ++name)
+      {
+        int dependency = findRange(*name);
+        ready = dependency < 0 || dependency == (int)*it
+          || done[(unsigned int)dependency];
+      }
+
+      if (ready)
+      {
+        done[*it] = true;
+        mEvaluationOrder.push_back(*it);
+        it = functional.erase(it);
+        progress = true;
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    if (!progress)
+    {
+      mEvaluationOrder.insert(mEvaluationOrder.end(),
+                              functional.begin(), functional.end());
+      break;
+    }
+  }
+}
+
+
+/*
+ * Computes the range and change values of the current iteration.
+ */
+void
+SedRepeatedTaskIterator::evaluate ()
+{
+  mValues.clear();
+
+  for (vector<unsigned int>::const_iterator it = mEvaluationOrder.begin();
+       it != mEvaluationOrder.end(); ++it)
+  {
+    unsigned int n = *it;
+    const SedRange* range = mRanges[n];
+    double value = SED_NAN;
+
+    if (range->getTypeCode() == SEDML_RANGE_FUNCTIONALRANGE)
+    {
+      const SedFunctionalRange* functional =
+        static_cast<const SedFunctionalRange*>(range);
+
+      if (!functional->isSetMath())
+      {
+        value = getRangeValue(functional->getRange());
+      }
+      else
+      {
+        vector<string> added;
+        addLocalValues(functional, mProvider, mValues, added);
+        value = SBMLTransforms::evaluateASTNode(functional->getMath(), mValues);
+        removeLocalValues(mValues, added);
+      }
+    }
+    else
+    {
+      value = getPlainRangeValue(n, mIndex);
+    }
+
+    mRangeValues[n] = value;
+    mValues[range->getId()] = make_pair(value, true);
+  }
+
+  for (unsigned int i = 0; i < mChangeValues.size(); ++i)
+  {
+    mChangeValues[i] = evaluateChange(mTask->getTaskChange(i));
+  }
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,291 @@
+/**
+ * @file SedRepeatedTaskIterator.h
+ * @brief Definition of the SedRepeatedTaskIterator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedRepeatedTaskIterator
+ * @sbmlbrief{} Enumerates the iterations of a SedRepeatedTask.
+ *
+ * A SedRepeatedTaskIterator implements the semantics of a repeated task,
+ * so that simulators do not have to: for each value of the master range
+ * (the range named by the "range" attribute of the task) it provides
+ * @li the current value of every range of the task, including functional
+ * ranges, whose math is evaluated for the current iteration;
+ * @li the values of the task changes (SedSetValue) of the task;
+ * @li the subtasks, sorted by their "order" attribute.
+ *
+ * Only the current iteration is computed and stored, so that even very
+ * large scans are enumerated in constant memory.  Iterations can also be
+ * visited in any order with seek(), which allows a scan to be split
+ * between several workers by iteration index.  Subtasks that are
+ * repeated tasks themselves are not expanded; createSubTaskIterator()
+ * creates an iterator for them when they are executed.
+ *
+ * Values that are not part of the document (model variables and data
+ * sources) are requested from a SedValueProvider.
+ *
+ * @code{.cpp}
+for (SedRepeatedTaskIterator it(repeatedTask, &provider); !it.isAtEnd(); it.next())
+{
+  if (repeatedTask->getResetModel()) resetModel();
+
+  for (unsigned int i = 0; i < it.getNumChanges(); ++i)
+    applyChange(it.getChange(i), it.getChangeValue(i));
+
+  for (unsigned int i = 0; i < it.getNumSubTasks(); ++i)
+    execute(it.getSubTaskTask(i));
+}
+ * @endcode
+ */
+
+
+#ifndef SedRepeatedTaskIterator_h
+#define SedRepeatedTaskIterator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedAbstractTask;
+class SedRange;
+class SedRepeatedTask;
+class SedSetValue;
+class SedSubTask;
+class SedValueProvider;
+
+
+class LIBSEDML_EXTERN SedRepeatedTaskIterator
+{
+public:
+
+  /**
+   * Creates a new iterator positioned at the first iteration of the given
+   * repeated task.
+   *
+   * @param task the repeated task to be enumerated; it must not be
+   * modified while the iterator is in use.
+   * @param provider the provider asked for the values of model variables
+   * and data ranges; may be @c NULL, in which case these values are NaN.
+   */
+  SedRepeatedTaskIterator (const SedRepeatedTask* task,
+                           SedValueProvider* provider = NULL);
+
+
+  /**
+   * Destroys this SedRepeatedTaskIterator.
+   */
+  ~SedRepeatedTaskIterator ();
+
+
+  /**
+   * @return the number of iterations, i.e. the number of values of the
+   * master range of the task, or 0 if there is no master range.
+   */
+  unsigned int getNumIterations () const;
+
+
+  /**
+   * @return the index of the current iteration.
+   */
+  unsigned int getIndex () const;
+
+
+  /**
+   * @return @c true if all iterations have been visited.
+   */
+  bool isAtEnd () const;
+
+
+  /**
+   * Advances to the next iteration.
+   *
+   * @return @c true if there is a next iteration, @c false if the end has
+   * been reached.
+   */
+  bool next ();
+
+
+  /**
+   * Moves to the iteration with the given index.
+   *
+   * @param index the index of the iteration, between 0 and
+   * getNumIterations(); moving to getNumIterations() ends the iteration.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INDEX_EXCEEDS_SIZE, OperationReturnValues_t}
+   */
+  int seek (unsigned int index);
+
+
+  /**
+   * @return the value of the master range in the current iteration.
+   */
+  double getMasterValue () const;
+
+
+  /**
+   * @return the number of ranges of the task.
+   */
+  unsigned int getNumRanges () const;
+
+
+  /**
+   * @return the nth range of the task.
+   */
+  const SedRange* getRange (unsigned int n) const;
+
+
+  /**
+   * @return the value of the nth range in the current iteration, or NaN
+   * if the range has fewer values than the master range.
+   */
+  double getRangeValue (unsigned int n) const;
+
+
+  /**
+   * @return the value of the range with the given id in the current
+   * iteration, or NaN if there is no such range.
+   */
+  double getRangeValue (const std::string& id) const;
+
+
+  /**
+   * @return the number of task changes of the task.
+   */
+  unsigned int getNumChanges () const;
+
+
+  /**
+   * @return the nth task change of the task.
+   */
+  const SedSetValue* getChange (unsigned int n) const;
+
+
+  /**
+   * @return the value the nth task change assigns in the current
+   * iteration.
+   */
+  double getChangeValue (unsigned int n) const;
+
+
+  /**
+   * Evaluates the math of the given change in the context of the current
+   * iteration, i.e. with the current range values.  This is useful for
+   * changes that are not part of the task itself, such as those of a
+   * subtask.
+   *
+   * @param change the change to evaluate.
+   *
+   * @return the value the change assigns.
+   */
+  double evaluateChange (const SedSetValue* change) const;
+
+
+  /**
+   * @return the number of subtasks of the task.
+   */
+  unsigned int getNumSubTasks () const;
+
+
+  /**
+   * @return the nth subtask of the task, in order of execution.
+   */
+  const SedSubTask* getSubTask (unsigned int n) const;
+
+
+  /**
+   * @return the task referenced by the nth subtask (in order of
+   * execution), or @c NULL if it cannot be found.
+   */
+  const SedAbstractTask* getSubTaskTask (unsigned int n) const;
+
+
+  /**
+   * Creates an iterator for the nth subtask, if that is a repeated task.
+   * The nested iterator uses the same SedValueProvider.
+   *
+   * @return the new iterator, which is owned by the caller, or @c NULL if
+   * the subtask is not a repeated task.
+   */
+  SedRepeatedTaskIterator* createSubTaskIterator (unsigned int n) const;
+
+
+private:
+
+  SedRepeatedTaskIterator (const SedRepeatedTaskIterator& orig);
+  SedRepeatedTaskIterator& operator= (const SedRepeatedTaskIterator& rhs);
+
+  typedef std::pair<double, bool> ValueSet;
+  typedef std::map<const std::string, ValueSet> IdValueMap;
+
+  int findRange (const std::string& id) const;
+  unsigned int getRangeSize (unsigned int n, unsigned int depth = 0);
+  double getPlainRangeValue (unsigned int n, unsigned int index);
+  void orderRanges ();
+  void evaluate ();
+
+  const SedRepeatedTask* mTask;
+  SedValueProvider* mProvider;
+
+  std::vector<const SedRange*> mRanges;
+  std::vector<unsigned int> mEvaluationOrder;
+  std::vector<std::vector<double> > mDataValues;
+  std::vector<bool> mHasDataValues;
+  int mMaster;
+  unsigned int mNumIterations;
+
+  std::vector<const SedSubTask*> mSubTasks;
+
+  unsigned int mIndex;
+  std::vector<double> mRangeValues;
+  std::vector<double> mChangeValues;
+  mutable IdValueMap mValues;
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedRepeatedTaskIterator_h */
@@ -62,7 +62,7 @@ SedReport::SedReport(unsigned int level, unsigned int version)
 /*
  * Creates a new SedReport using the given SedNamespaces object @p sedmlns.
  */
-SedReport::SedReport(SedNamespaces *sedmlns)
+SedReport::SedReport(const SedNamespaces *sedmlns)
   : SedOutput(sedmlns)
   , mDataSets (sedmlns)
 {
@@ -371,7 +371,46 @@ SedReport::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedReport::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedReport
+ */
+unsigned int
+SedReport::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mDataSets
+  };
+
+  return SedOutput::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedReport
+ */
+const SedBase*
+SedReport::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedOutput::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedOutput::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mDataSets
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
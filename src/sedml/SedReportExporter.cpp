@@ -0,0 +1,487 @@
+/**
+ * @file SedReportExporter.cpp
+ * @brief Implementation of the SedReportExporter class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedReportExporter.h>
+#include <sedml/SedReportWriter.h>
+#include <sedml/SedTaskResult.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedOutput.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/SedPlot3D.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedShadedArea.h>
+#include <sedml/SedSurface.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <algorithm>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+SedReportExporter::SedReportExporter (const SedDocument* document,
+                                      SedReportWriter& writer)
+  : mDocument(document)
+  , mWriter(writer)
+  , mResolver(&SedResultStore::getDefaultColumnName)
+  , mOutput(NULL)
+  , mDataGenerators()
+  , mMath()
+  , mStreamingTaskId()
+  , mPending()
+  , mNextIteration(0)
+  , mStatus(LIBSEDML_OPERATION_SUCCESS)
+  , mMutex()
+{
+}
+
+
+SedReportExporter::~SedReportExporter ()
+{
+}
+
+
+void
+SedReportExporter::setColumnResolver (
+  const SedResultStore::ColumnResolver& resolver)
+{
+  mResolver = resolver;
+}
+
+
+int
+SedReportExporter::setOutput (const SedOutput* output)
+{
+  lock_guard<mutex> lock(mMutex);
+
+  mOutput = NULL;
+  mDataGenerators.clear();
+  mMath.clear();
+  mStreamingTaskId.clear();
+  mPending.clear();
+  mNextIteration = 0;
+  mStatus = LIBSEDML_OPERATION_SUCCESS;
+
+  if (output == NULL || mDocument == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  vector<string> labels;
+  int status = LIBSEDML_OPERATION_SUCCESS;
+
+  switch (output->getTypeCode())
+  {
+  case SEDML_OUTPUT_REPORT:
+  {
+    const SedReport* report = static_cast<const SedReport*>(output);
+    for (unsigned int i = 0; i < report->getNumDataSets(); ++i)
+    {
+      const SedDataSet* dataSet = report->getDataSet(i);
+      status = addColumn(dataSet->getDataReference(), false);
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+      labels.push_back(dataSet->isSetLabel() ? dataSet->getLabel()
+                                             : dataSet->getId());
+    }
+    break;
+  }
+
+  case SEDML_OUTPUT_PLOT2D:
+  {
+    const SedPlot2D* plot = static_cast<const SedPlot2D*>(output);
+    for (unsigned int i = 0; i < plot->getNumCurves(); ++i)
+    {
+      const SedAbstractCurve* curve = plot->getCurve(i);
+      vector<string> references(1, curve->getXDataReference());
+
+      if (curve->getTypeCode() == SEDML_OUTPUT_CURVE)
+      {
+        references.push_back(
+          static_cast<const SedCurve*>(curve)->getYDataReference());
+      }
+      else if (curve->getTypeCode() == SEDML_SHADEDAREA)
+      {
+        const SedShadedArea* area = static_cast<const SedShadedArea*>(curve);
+        references.push_back(area->getYDataReferenceFrom());
+        references.push_back(area->getYDataReferenceTo());
+      }
+
+      for (size_t n = 0; n < references.size(); ++n)
+      {
+        status = addColumn(references[n], true);
+        if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+      }
+    }
+    break;
+  }
+
+  case SEDML_OUTPUT_PLOT3D:
+  {
+    const SedPlot3D* plot = static_cast<const SedPlot3D*>(output);
+    for (unsigned int i = 0; i < plot->getNumSurfaces(); ++i)
+    {
+      const SedSurface* surface = plot->getSurface(i);
+      const string references[] = { surface->getXDataReference(),
+                                    surface->getYDataReference(),
+                                    surface->getZDataReference() };
+      for (size_t n = 0; n < 3; ++n)
+      {
+        status = addColumn(references[n], true);
+        if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+      }
+    }
+    break;
+  }
+
+  default:
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  // plots show each data generator once
+  if (output->getTypeCode() != SEDML_OUTPUT_REPORT)
+  {
+    for (size_t i = 0; i < mDataGenerators.size(); ++i)
+    {
+      const SedDataGenerator* dataGenerator = mDataGenerators[i];
+      labels.push_back(dataGenerator->isSetName() ? dataGenerator->getName()
+                                                  : dataGenerator->getId());
+    }
+  }
+
+  // the output can be streamed if everything comes from one repeated task
+  string taskId;
+  bool streamable = true;
+  for (size_t i = 0; i < mDataGenerators.size() && streamable; ++i)
+  {
+    const SedDataGenerator* dataGenerator = mDataGenerators[i];
+    for (unsigned int n = 0; n < dataGenerator->getNumVariables(); ++n)
+    {
+      const SedVariable* variable = dataGenerator->getVariable(n);
+      if (variable->getNumAppliedDimensions() > 0
+        || variable->getTaskReference().empty()
+        || (!taskId.empty() && variable->getTaskReference() != taskId))
+      {
+        streamable = false;
+        break;
+      }
+      taskId = variable->getTaskReference();
+    }
+  }
+
+  const SedAbstractTask* task = mDocument->getTask(taskId);
+  if (streamable && task != NULL
+    && task->getTypeCode() == SEDML_TASK_REPEATEDTASK)
+  {
+    mStreamingTaskId = taskId;
+  }
+
+  mOutput = output;
+  return mWriter.setColumns(labels);
+}
+
+
+const SedOutput*
+SedReportExporter::getOutput () const
+{
+  return mOutput;
+}
+
+
+unsigned int
+SedReportExporter::getNumColumns () const
+{
+  return (unsigned int)mMath.size();
+}
+
+
+const SedDataGenerator*
+SedReportExporter::getColumnDataGenerator (unsigned int n) const
+{
+  return (n < mDataGenerators.size()) ? mDataGenerators[n] : NULL;
+}
+
+
+const std::string&
+SedReportExporter::getStreamingTaskId () const
+{
+  return mStreamingTaskId;
+}
+
+
+int
+SedReportExporter::writeResults (const SedResultStore& store)
+{
+  lock_guard<mutex> lock(mMutex);
+
+  if (mOutput == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  Columns columns(mMath.size());
+  vector< vector<double> > buffers;
+
+  for (size_t i = 0; i < mMath.size(); ++i)
+  {
+    size_t numPoints = 0;
+    int status = store.bindVariables(mDataGenerators[i], mMath[i], buffers,
+                                     numPoints);
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+    columns[i].resize(numPoints);
+    if (numPoints > 0) mMath[i].evaluate(numPoints, &columns[i][0]);
+  }
+
+  return writeColumns(columns);
+}
+
+
+int
+SedReportExporter::writeIteration (const SedRepeatedTask* task,
+                                   unsigned int index,
+                                   const SedTaskResult& iteration)
+{
+  if (task == NULL || mOutput == NULL || mStreamingTaskId.empty()
+    || task->getId() != mStreamingTaskId)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  lock_guard<mutex> lock(mMutex);
+
+  if (index < mNextIteration || mPending.find(index) != mPending.end())
+  {
+    return LIBSEDML_INDEX_EXCEEDS_SIZE;
+  }
+
+  Columns columns;
+  int status = evaluate(iteration, columns);
+  if (status != LIBSEDML_OPERATION_SUCCESS)
+  {
+    mStatus = status;
+    return status;
+  }
+
+  if (index != mNextIteration)
+  {
+    mPending[index].swap(columns);
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  status = writeColumns(columns);
+  ++mNextIteration;
+
+  // write the iterations that have been waiting for this one
+  map<unsigned int, Columns>::iterator it = mPending.begin();
+  while (status == LIBSEDML_OPERATION_SUCCESS && it != mPending.end()
+    && it->first == mNextIteration)
+  {
+    status = writeColumns(it->second);
+    mPending.erase(it++);
+    ++mNextIteration;
+  }
+
+  if (status != LIBSEDML_OPERATION_SUCCESS) mStatus = status;
+  return status;
+}
+
+
+SedTaskExecutor::IterationListener
+SedReportExporter::getIterationListener ()
+{
+  return [this](const SedRepeatedTask* task, unsigned int index,
+                const SedTaskResult& iteration)
+  {
+    if (task != NULL && !mStreamingTaskId.empty()
+      && task->getId() == mStreamingTaskId)
+    {
+      writeIteration(task, index, iteration);
+    }
+  };
+}
+
+
+unsigned int
+SedReportExporter::getNumPendingIterations () const
+{
+  lock_guard<mutex> lock(mMutex);
+  return (unsigned int)mPending.size();
+}
+
+
+int
+SedReportExporter::finish ()
+{
+  lock_guard<mutex> lock(mMutex);
+
+  int status = mStatus;
+  if (status == LIBSEDML_OPERATION_SUCCESS && !mPending.empty())
+  {
+    status = LIBSEDML_OPERATION_FAILED;
+  }
+
+  if (mWriter.flush() != LIBSEDML_OPERATION_SUCCESS)
+  {
+    status = LIBSEDML_OPERATION_FAILED;
+  }
+
+  return status;
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Adds a column for the given data generator.  If @p unique is set, data
+ * generators that have a column already are skipped.
+ */
+int
+SedReportExporter::addColumn (const std::string& dataReference, bool unique)
+{
+  const SedDataGenerator* dataGenerator =
+    mDocument->getDataGenerator(dataReference);
+  if (dataGenerator == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  if (unique && find(mDataGenerators.begin(), mDataGenerators.end(),
+                     dataGenerator) != mDataGenerators.end())
+  {
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  mMath.push_back(SedCompiledMath());
+  if (mMath.back().compile(dataGenerator) != LIBSEDML_OPERATION_SUCCESS)
+  {
+    mMath.pop_back();
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  mDataGenerators.push_back(dataGenerator);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Evaluates all columns over the given iteration, whose subtask results
+ * are concatenated, as in a SedResultStore.
+ */
+int
+SedReportExporter::evaluate (const SedTaskResult& iteration, Columns& columns)
+{
+  columns.assign(mMath.size(), vector<double>());
+  vector< vector<double> > buffers;
+
+  for (size_t i = 0; i < mMath.size(); ++i)
+  {
+    const SedDataGenerator* dataGenerator = mDataGenerators[i];
+    SedCompiledMath& math = mMath[i];
+
+    size_t numPoints = 0;
+    bool hasArrays = false;
+    buffers.resize(dataGenerator->getNumVariables());
+
+    for (unsigned int n = 0; n < dataGenerator->getNumVariables(); ++n)
+    {
+      const SedVariable* variable = dataGenerator->getVariable(n);
+      int slot = math.getSlotIndex(variable->getId());
+      if (slot < 0) continue;
+
+      const string column = mResolver(variable);
+      vector<double>& values = buffers[n];
+      values.clear();
+
+      if (iteration.getNumChildren() == 0)
+      {
+        const vector<double>* piece = iteration.getColumn(column);
+        if (piece != NULL) values = *piece;
+      }
+
+      for (unsigned int c = 0; c < iteration.getNumChildren(); ++c)
+      {
+        const vector<double>* piece = iteration.getChild(c)->getColumn(column);
+        if (piece != NULL) values.insert(values.end(), piece->begin(),
+                                         piece->end());
+      }
+
+      if (values.empty()) return LIBSEDML_OPERATION_FAILED;
+
+      if (values.size() == 1)
+      {
+        math.setSlotValue(slot, values[0]);
+        continue;
+      }
+
+      math.setSlotValues(slot, &values[0]);
+      numPoints = hasArrays ? min(numPoints, values.size()) : values.size();
+      hasArrays = true;
+    }
+
+    if (!hasArrays) numPoints = 1;
+
+    columns[i].resize(numPoints);
+    math.evaluate(numPoints, &columns[i][0]);
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedReportExporter::writeColumns (const Columns& columns)
+{
+  vector<SedDataView> views;
+  views.reserve(columns.size());
+
+  for (size_t i = 0; i < columns.size(); ++i)
+  {
+    views.push_back(columns[i].empty() ? SedDataView()
+      : SedDataView(&columns[i][0], (unsigned int)columns[i].size()));
+  }
+
+  return mWriter.writeRows(views);
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,288 @@
+/**
+ * @file SedReportExporter.h
+ * @brief Definition of the SedReportExporter class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedReportExporter
+ * @sbmlbrief{} Evaluates the data generators of an output and streams
+ * them to a SedReportWriter.
+ *
+ * A SedReportExporter turns a SedReport into columns, one for each of its
+ * data sets, labelled with the label of the data set.  Plots are exported
+ * as well: a SedPlot2D gives one column for each data generator that its
+ * curves and shaded areas refer to, a SedPlot3D one for each data
+ * generator of its surfaces; these columns are labelled with the name of
+ * the data generator, or its id.
+ *
+ * The columns can be written in two ways:
+ * @li writeResults() evaluates the data generators over the values held
+ * by a SedResultStore, once all tasks have been executed.
+ * @li writeIteration() evaluates them over the result of a single
+ * iteration of a repeated task, and writes the rows as soon as all
+ * earlier iterations have been written.  The listener returned by
+ * getIterationListener() does so while a SedTaskExecutor executes the
+ * task, so that, with SedTaskExecutor::setKeepIterations() set to
+ * @c false, neither the results nor the output are held in memory.  This
+ * is only possible if all variables of the data generators refer to the
+ * same repeated task and have no applied dimensions.
+ *
+ * @code{.cpp}
+SedReportWriter writer;
+writer.open("report.csv");
+
+SedReportExporter exporter(doc, writer);
+exporter.setOutput(doc->getOutput("report1"));
+
+SedTaskExecutor executor(doc);
+executor.setIterationListener(exporter.getIterationListener());
+executor.setKeepIterations(false);
+executor.execute();
+
+exporter.finish();
+writer.close();
+ * @endcode
+ */
+
+
+#ifndef SedReportExporter_h
+#define SedReportExporter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedResultStore.h>
+#include <sedml/SedTaskExecutor.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedOutput;
+class SedDataGenerator;
+class SedRepeatedTask;
+class SedTaskResult;
+class SedReportWriter;
+
+
+class LIBSEDML_EXTERN SedReportExporter
+{
+public:
+
+  /**
+   * Creates a new SedReportExporter.
+   *
+   * @param document the document holding the outputs; it has to outlive
+   * this exporter.
+   * @param writer the writer receiving the columns; it has to outlive this
+   * exporter.
+   */
+  SedReportExporter (const SedDocument* document, SedReportWriter& writer);
+
+
+  /**
+   * Destroys this SedReportExporter.
+   */
+  ~SedReportExporter ();
+
+
+  /**
+   * Sets the function deciding which column of a task result holds the
+   * values of a variable, for writeIteration(); the default is
+   * SedResultStore::getDefaultColumnName().
+   *
+   * @param resolver the column resolver.
+   */
+  void setColumnResolver (const SedResultStore::ColumnResolver& resolver);
+
+
+  /**
+   * Sets the output to export, compiles the math of its data generators
+   * and writes the header.  The writer has to be open.
+   *
+   * @param output the report or plot to export.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if @p output is @c NULL or not a report or plot, or if the writer is
+   * not open or already has columns.
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if a data reference does not name a data generator, or the math of a
+   * data generator cannot be compiled.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if writing the header fails.
+   */
+  int setOutput (const SedOutput* output);
+
+
+  /**
+   * @return the output being exported.
+   */
+  const SedOutput* getOutput () const;
+
+
+  /**
+   * @return the number of columns of the output.
+   */
+  unsigned int getNumColumns () const;
+
+
+  /**
+   * @return the data generator of the nth column, or @c NULL if @p n is
+   * out of range.
+   */
+  const SedDataGenerator* getColumnDataGenerator (unsigned int n) const;
+
+
+  /**
+   * @return the id of the repeated task that all variables of the output
+   * refer to, or an empty string if there is none, in which case the
+   * output cannot be written iteration by iteration.
+   */
+  const std::string& getStreamingTaskId () const;
+
+
+  /**
+   * Evaluates all columns over the values in the given store, and writes
+   * them.
+   *
+   * @param store the store holding the results of all tasks.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if no output has been set.
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if the values of a variable cannot be reduced.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if values are missing, or writing fails.
+   */
+  int writeResults (const SedResultStore& store);
+
+
+  /**
+   * Evaluates all columns over the result of one iteration of the
+   * repeated task named by getStreamingTaskId(), and writes the rows of
+   * this and all following iterations that are available.  Iterations
+   * that arrive before their predecessors are held back.  This method may
+   * be called from several threads at once.
+   *
+   * @param task the repeated task.
+   * @param index the index of the iteration, starting with 0.
+   * @param iteration the result of the iteration.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if no output has been set, or the output does not depend on @p task
+   * alone.
+   * @li @sedmlconstant{LIBSEDML_INDEX_EXCEEDS_SIZE, OperationReturnValues_t}
+   * if the iteration has been written already.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if values are missing, or writing fails.
+   */
+  int writeIteration (const SedRepeatedTask* task, unsigned int index,
+                      const SedTaskResult& iteration);
+
+
+  /**
+   * @return a listener for SedTaskExecutor::setIterationListener() that
+   * passes the iterations of the task named by getStreamingTaskId() to
+   * writeIteration().  Errors are reported by finish().
+   */
+  SedTaskExecutor::IterationListener getIterationListener ();
+
+
+  /**
+   * @return the number of iterations that are held back, waiting for an
+   * earlier iteration.
+   */
+  unsigned int getNumPendingIterations () const;
+
+
+  /**
+   * Checks that all iterations passed to writeIteration() have been
+   * written, and flushes the writer.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if an iteration is missing, writing an iteration has failed, or
+   * flushing fails.
+   */
+  int finish ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  SedReportExporter (const SedReportExporter& orig);
+  SedReportExporter& operator= (const SedReportExporter& rhs);
+
+  typedef std::vector< std::vector<double> > Columns;
+
+  int addColumn (const std::string& dataReference, bool unique);
+  int evaluate (const SedTaskResult& iteration, Columns& columns);
+  int writeColumns (const Columns& columns);
+
+  const SedDocument* mDocument;
+  SedReportWriter& mWriter;
+  SedResultStore::ColumnResolver mResolver;
+  const SedOutput* mOutput;
+  std::vector<const SedDataGenerator*> mDataGenerators;
+  std::vector<SedCompiledMath> mMath;
+  std::string mStreamingTaskId;
+  std::map<unsigned int, Columns> mPending;
+  unsigned int mNextIteration;
+  int mStatus;
+  mutable std::mutex mMutex;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedReportExporter_h */
@@ -0,0 +1,521 @@
+/**
+ * @file SedReportWriter.cpp
+ * @brief Implementation of the SedReportWriter class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedReportWriter.h>
+#include <sedml/SedNumberFormatter.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <sbml/compress/CompressCommon.h>
+#include <sbml/compress/OutputCompressor.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <ostream>
+
+#include <stdint.h>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+namespace
+{
+
+const char BINARY_MAGIC[] = "SEDMLCOL";
+const unsigned int BINARY_VERSION = 1;
+
+bool
+hasSuffix (const std::string& text, const char* suffix)
+{
+  size_t length = strlen(suffix);
+  return text.size() >= length
+    && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+
+bool
+isLittleEndian ()
+{
+  const uint16_t probe = 1;
+  return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+
+/*
+ * Appends the given values to the buffer as little endian doubles.
+ */
+void
+appendDoubles (const double* values, size_t count, std::string& buffer)
+{
+  if (isLittleEndian())
+  {
+    buffer.append(reinterpret_cast<const char*>(values),
+                  count * sizeof(double));
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    uint64_t bits;
+    memcpy(&bits, &values[i], sizeof(bits));
+    for (int n = 0; n < 8; ++n)
+    {
+      buffer += (char)((bits >> (8 * n)) & 0xFF);
+    }
+  }
+}
+
+}
+
+/** @endcond */
+
+
+SedReportWriter::SedReportWriter ()
+  : mStream(NULL)
+  , mOwnsStream(false)
+  , mFormat(FORMAT_CSV)
+  , mChunkSize(1 << 20)
+  , mDelimiter(',')
+  , mHasHeader(false)
+  , mFailed(false)
+  , mLabels()
+  , mBuffer()
+  , mPending()
+  , mNumPending(0)
+  , mChunkRows(0)
+  , mNumRows(0)
+{
+}
+
+
+SedReportWriter::~SedReportWriter ()
+{
+  close();
+}
+
+
+void
+SedReportWriter::setChunkSize (size_t numBytes)
+{
+  mChunkSize = max(numBytes, (size_t)1);
+}
+
+
+size_t
+SedReportWriter::getChunkSize () const
+{
+  return mChunkSize;
+}
+
+
+void
+SedReportWriter::setDelimiter (char delimiter)
+{
+  mDelimiter = delimiter;
+}
+
+
+char
+SedReportWriter::getDelimiter () const
+{
+  return mDelimiter;
+}
+
+
+int
+SedReportWriter::open (const std::string& fileName, Format format)
+{
+  close();
+
+  std::ostream* stream = NULL;
+  try
+  {
+    if (hasSuffix(fileName, ".gz"))
+    {
+      stream = OutputCompressor::openGzipOStream(fileName);
+    }
+    else if (hasSuffix(fileName, ".bz2"))
+    {
+      stream = OutputCompressor::openBzip2OStream(fileName);
+    }
+    else if (hasSuffix(fileName, ".zip"))
+    {
+      string nameInZip = fileName.substr(0, fileName.length() - 4);
+      size_t pos = nameInZip.find_last_of("/\\");
+      if (pos != string::npos) nameInZip = nameInZip.substr(pos + 1);
+
+      stream = OutputCompressor::openZipOStream(fileName, nameInZip);
+    }
+    else
+    {
+      stream = new(std::nothrow) std::ofstream(fileName.c_str(),
+                                               ios::out | ios::binary);
+    }
+  }
+  catch (ZlibNotLinked&)
+  {
+    return LIBSEDML_OPERATION_FAILED;
+  }
+  catch (Bzip2NotLinked&)
+  {
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  if (stream == NULL || !*stream)
+  {
+    delete stream;
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  mStream = stream;
+  mOwnsStream = true;
+  mFormat = format;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedReportWriter::open (std::ostream& stream, Format format)
+{
+  close();
+
+  if (!stream) return LIBSEDML_OPERATION_FAILED;
+
+  mStream = &stream;
+  mOwnsStream = false;
+  mFormat = format;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+bool
+SedReportWriter::isOpen () const
+{
+  return mStream != NULL;
+}
+
+
+SedReportWriter::Format
+SedReportWriter::getFormat () const
+{
+  return mFormat;
+}
+
+
+int
+SedReportWriter::setColumns (const std::vector<std::string>& labels)
+{
+  if (mStream == NULL || mHasHeader) return LIBSEDML_INVALID_OBJECT;
+
+  mLabels = labels;
+  mHasHeader = true;
+  mBuffer.reserve(mChunkSize + SedNumberFormatter::BUFFER_SIZE * 2);
+
+  if (mFormat == FORMAT_BINARY)
+  {
+    mBuffer.append(BINARY_MAGIC, 8);
+    appendInteger(BINARY_VERSION);
+    appendInteger((unsigned int)mLabels.size());
+    for (size_t i = 0; i < mLabels.size(); ++i)
+    {
+      appendInteger((unsigned int)mLabels[i].size());
+      mBuffer += mLabels[i];
+    }
+
+    size_t rowSize = max(mLabels.size(), (size_t)1) * sizeof(double);
+    mChunkRows = max(mChunkSize / rowSize, (size_t)1);
+    mChunkRows = min(mChunkRows, (size_t)numeric_limits<uint32_t>::max());
+    mPending.assign(mLabels.size(), vector<double>(mChunkRows));
+    mNumPending = 0;
+  }
+  else
+  {
+    for (size_t i = 0; i < mLabels.size(); ++i)
+    {
+      if (i > 0) mBuffer += mDelimiter;
+      appendField(mLabels[i]);
+    }
+    mBuffer += '\n';
+  }
+
+  return (mBuffer.size() >= mChunkSize) ? writeBuffer()
+                                        : LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+SedReportWriter::getNumColumns () const
+{
+  return (unsigned int)mLabels.size();
+}
+
+
+const std::string&
+SedReportWriter::getColumnLabel (unsigned int n) const
+{
+  static const string empty;
+  return (n < mLabels.size()) ? mLabels[n] : empty;
+}
+
+
+int
+SedReportWriter::writeRows (const std::vector<SedDataView>& columns)
+{
+  if (mStream == NULL || !mHasHeader) return LIBSEDML_INVALID_OBJECT;
+  if (columns.size() != mLabels.size()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  if (mFailed) return LIBSEDML_OPERATION_FAILED;
+
+  size_t numRows = 0;
+  for (size_t i = 0; i < columns.size(); ++i)
+  {
+    numRows = max(numRows, (size_t)columns[i].size());
+  }
+
+  if (mFormat == FORMAT_BINARY)
+  {
+    const double missing = numeric_limits<double>::quiet_NaN();
+
+    // copy as many rows as fit into the pending chunk, column by column
+    for (size_t row = 0; row < numRows; )
+    {
+      size_t count = min(numRows - row, mChunkRows - mNumPending);
+      for (size_t i = 0; i < columns.size(); ++i)
+      {
+        const SedDataView& column = columns[i];
+        double* target = &mPending[i][mNumPending];
+        size_t available = (row < column.size())
+          ? min(count, column.size() - row) : 0;
+
+        for (size_t n = 0; n < available; ++n)
+        {
+          target[n] = column[(unsigned int)(row + n)];
+        }
+        fill(target + available, target + count, missing);
+      }
+
+      row += count;
+      mNumPending += count;
+      mNumRows += count;
+
+      if (mNumPending == mChunkRows)
+      {
+        appendBinaryChunk();
+        if (writeBuffer() != LIBSEDML_OPERATION_SUCCESS)
+        {
+          return LIBSEDML_OPERATION_FAILED;
+        }
+      }
+    }
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+      if (i > 0) mBuffer += mDelimiter;
+      if (row < columns[i].size()) appendDouble(columns[i][(unsigned int)row]);
+    }
+    mBuffer += '\n';
+    ++mNumRows;
+
+    if (mBuffer.size() >= mChunkSize
+      && writeBuffer() != LIBSEDML_OPERATION_SUCCESS)
+    {
+      return LIBSEDML_OPERATION_FAILED;
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedReportWriter::writeRow (const double* values)
+{
+  if (mStream == NULL || !mHasHeader || values == NULL)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  vector<SedDataView> columns;
+  columns.reserve(mLabels.size());
+  for (size_t i = 0; i < mLabels.size(); ++i)
+  {
+    columns.push_back(SedDataView(values + i, 1));
+  }
+
+  return writeRows(columns);
+}
+
+
+unsigned long long
+SedReportWriter::getNumRows () const
+{
+  return mNumRows;
+}
+
+
+int
+SedReportWriter::flush ()
+{
+  if (mStream == NULL) return LIBSEDML_OPERATION_SUCCESS;
+
+  if (mFormat == FORMAT_BINARY && mNumPending > 0) appendBinaryChunk();
+
+  int status = writeBuffer();
+  mStream->flush();
+  return (status == LIBSEDML_OPERATION_SUCCESS && *mStream)
+    ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+int
+SedReportWriter::close ()
+{
+  if (mStream == NULL) return LIBSEDML_OPERATION_SUCCESS;
+
+  if (mFormat == FORMAT_BINARY && mHasHeader)
+  {
+    if (mNumPending > 0) appendBinaryChunk();
+    appendInteger(0);
+  }
+
+  int status = flush();
+  if (mFailed) status = LIBSEDML_OPERATION_FAILED;
+
+  // deleting a compressing stream writes its remaining output
+  if (mOwnsStream) delete mStream;
+
+  mStream = NULL;
+  mOwnsStream = false;
+  mHasHeader = false;
+  mFailed = false;
+  mLabels.clear();
+  mBuffer.clear();
+  mPending.clear();
+  mNumPending = 0;
+  mChunkRows = 0;
+  mNumRows = 0;
+
+  return status;
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+void
+SedReportWriter::appendInteger (unsigned int value)
+{
+  for (int n = 0; n < 4; ++n)
+  {
+    mBuffer += (char)((value >> (8 * n)) & 0xFF);
+  }
+}
+
+
+void
+SedReportWriter::appendDouble (double value)
+{
+  char text[SedNumberFormatter::BUFFER_SIZE];
+  mBuffer.append(text, SedNumberFormatter::formatDouble(value, text));
+}
+
+
+/*
+ * Appends a CSV field, quoted if it contains the delimiter, a quote or a
+ * line break.
+ */
+void
+SedReportWriter::appendField (const std::string& text)
+{
+  if (text.find_first_of(string("\"\r\n") + mDelimiter) == string::npos)
+  {
+    mBuffer += text;
+    return;
+  }
+
+  mBuffer += '"';
+  for (size_t i = 0; i < text.size(); ++i)
+  {
+    if (text[i] == '"') mBuffer += '"';
+    mBuffer += text[i];
+  }
+  mBuffer += '"';
+}
+
+
+void
+SedReportWriter::appendBinaryChunk ()
+{
+  appendInteger((unsigned int)mNumPending);
+  for (size_t i = 0; i < mPending.size(); ++i)
+  {
+    appendDoubles(&mPending[i][0], mNumPending, mBuffer);
+  }
+  mNumPending = 0;
+}
+
+
+int
+SedReportWriter::writeBuffer ()
+{
+  if (!mBuffer.empty())
+  {
+    mStream->write(mBuffer.data(), (streamsize)mBuffer.size());
+    mBuffer.clear();
+  }
+
+  if (!*mStream) mFailed = true;
+  return mFailed ? LIBSEDML_OPERATION_FAILED : LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,330 @@
+/**
+ * @file SedReportWriter.h
+ * @brief Definition of the SedReportWriter class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedReportWriter
+ * @sbmlbrief{} Streams columns of numbers to CSV or binary files.
+ *
+ * A SedReportWriter writes the columns of a report, typically the
+ * evaluated data sets of a SedReport or the data generators of a plot (see
+ * SedReportExporter), as they become available: rows are appended with
+ * writeRows() and collected in a buffer that is written out whenever it
+ * holds a chunk, so that the memory used does not grow with the size of
+ * the output.
+ *
+ * Two formats are supported:
+ * @li FORMAT_CSV writes a header line with the column labels, followed by
+ * one line per row.  Numbers are written as text that reads back to the
+ * same value; a column that has fewer rows than the others leaves its
+ * fields empty.
+ * @li FORMAT_BINARY writes a compact columnar file: the eight characters
+ * <code>SEDMLCOL</code>, the format version (1) and the number of
+ * columns as 32 bit integers, and for each column the length of its label
+ * as a 32 bit integer followed by the UTF-8 label.  The rows follow in
+ * chunks: the number of rows of the chunk as a 32 bit integer, followed by
+ * the values of each column in turn as 64 bit IEEE doubles.  A chunk of
+ * zero rows ends the file.  Missing values are NaN; all numbers are
+ * little endian.
+ *
+ * Files whose names end in <code>.gz</code>, <code>.bz2</code> or
+ * <code>.zip</code> are compressed on the fly, if libSBML has been built
+ * with the respective library.
+ *
+ * @code{.cpp}
+SedReportWriter writer;
+if (writer.open("report.csv.gz", SedReportWriter::FORMAT_CSV)
+    == LIBSEDML_OPERATION_SUCCESS)
+{
+  writer.setColumns(labels);
+
+  std::vector<SedDataView> columns;
+  // ... for each batch of rows, point the views at the values
+  writer.writeRows(columns);
+
+  writer.close();
+}
+ * @endcode
+ */
+
+
+#ifndef SedReportWriter_h
+#define SedReportWriter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <sedml/SedDataTable.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedReportWriter
+{
+public:
+
+  /**
+   * The formats a SedReportWriter can write.
+   */
+  enum Format
+  {
+    FORMAT_CSV     /*!< Comma separated values, with a header line. */
+  , FORMAT_BINARY  /*!< Chunks of 64 bit doubles, column by column. */
+  };
+
+
+  /**
+   * Creates a new SedReportWriter.
+   */
+  SedReportWriter ();
+
+
+  /**
+   * Destroys this SedReportWriter, closing its output.
+   */
+  ~SedReportWriter ();
+
+
+  /**
+   * Sets the number of bytes collected before they are written to the
+   * output; the default is one megabyte.
+   *
+   * @param numBytes the size of a chunk.
+   */
+  void setChunkSize (size_t numBytes);
+
+
+  /**
+   * @return the number of bytes collected before they are written to the
+   * output.
+   */
+  size_t getChunkSize () const;
+
+
+  /**
+   * Sets the character that separates the fields of CSV output; the
+   * default is a comma.
+   *
+   * @param delimiter the delimiter, for example @c '\\t'.
+   */
+  void setDelimiter (char delimiter);
+
+
+  /**
+   * @return the character that separates the fields of CSV output.
+   */
+  char getDelimiter () const;
+
+
+  /**
+   * Opens the given file for writing, replacing its contents.
+   *
+   * @param fileName the name of the file; it is compressed if it ends in
+   * <code>.gz</code>, <code>.bz2</code> or <code>.zip</code>.
+   * @param format the format to write.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if the file cannot be created, or the compression it asks for is not
+   * available.
+   */
+  int open (const std::string& fileName, Format format = FORMAT_CSV);
+
+
+  /**
+   * Writes to the given stream, which has to remain valid until close()
+   * is called.  The stream is not closed by this writer.
+   *
+   * @param stream the stream; for binary output it should be opened in
+   * binary mode.
+   * @param format the format to write.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if the stream is in an error state.
+   */
+  int open (std::ostream& stream, Format format = FORMAT_CSV);
+
+
+  /**
+   * @return @c true if this writer has an output.
+   */
+  bool isOpen () const;
+
+
+  /**
+   * @return the format being written.
+   */
+  Format getFormat () const;
+
+
+  /**
+   * Sets the labels of the columns and writes the header.  This has to be
+   * done once, after opening the output and before writing rows.
+   *
+   * @param labels the labels of the columns.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if no output is open, or the header has been written already.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if writing fails.
+   */
+  int setColumns (const std::vector<std::string>& labels);
+
+
+  /**
+   * @return the number of columns.
+   */
+  unsigned int getNumColumns () const;
+
+
+  /**
+   * @return the label of the nth column, or an empty string if @p n is
+   * out of range.
+   */
+  const std::string& getColumnLabel (unsigned int n) const;
+
+
+  /**
+   * Appends rows to the output: row @em i holds the @em ith value of each
+   * column.  As many rows are appended as the longest column has values;
+   * shorter columns leave the remaining rows empty (CSV) or NaN (binary).
+   *
+   * @param columns the values of each column, one view per column.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if no output is open, or the columns have not been set.
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if the number of views differs from the number of columns.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if writing fails.
+   */
+  int writeRows (const std::vector<SedDataView>& columns);
+
+
+  /**
+   * Appends a single row to the output.
+   *
+   * @param values the value of each column; it has to hold getNumColumns()
+   * values.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if no output is open, or the columns have not been set.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if writing fails.
+   */
+  int writeRow (const double* values);
+
+
+  /**
+   * @return the number of rows written so far.
+   */
+  unsigned long long getNumRows () const;
+
+
+  /**
+   * Writes all collected rows to the output, and flushes it.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if writing fails.
+   */
+  int flush ();
+
+
+  /**
+   * Writes all collected rows, ends the output and closes it, if it was
+   * opened by this writer.  The columns are reset, so that the writer can
+   * be opened again.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if writing fails.
+   */
+  int close ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  SedReportWriter (const SedReportWriter& orig);
+  SedReportWriter& operator= (const SedReportWriter& rhs);
+
+  void appendInteger (unsigned int value);
+  void appendDouble (double value);
+  void appendField (const std::string& text);
+  void appendBinaryChunk ();
+  int writeBuffer ();
+
+  std::ostream* mStream;
+  bool mOwnsStream;
+  Format mFormat;
+  size_t mChunkSize;
+  char mDelimiter;
+  bool mHasHeader;
+  bool mFailed;
+  std::vector<std::string> mLabels;
+  std::string mBuffer;
+  std::vector< std::vector<double> > mPending;
+  size_t mNumPending;
+  size_t mChunkRows;
+  unsigned long long mNumRows;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedReportWriter_h */
@@ -0,0 +1,420 @@
+/**
+ * @file SedResultSeries.cpp
+ * @brief Implementation of the SedResultSeries class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedResultSeries.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+namespace
+{
+
+const double NOT_A_NUMBER = numeric_limits<double>::quiet_NaN();
+
+// values are aligned to a cache line
+const size_t ALIGNMENT = 64;
+
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedResultSeries with a single, empty segment.
+ */
+SedResultSeries::SedResultSeries ()
+  : mTaskIds(1)
+  , mSizes()
+  , mLengths(1, 0)
+  , mNumSegments(1)
+  , mStride(0)
+  , mBlock(NULL)
+  , mData(NULL)
+{
+}
+
+
+/*
+ * Destroys this SedResultSeries.
+ */
+SedResultSeries::~SedResultSeries ()
+{
+  free(mBlock);
+}
+
+
+int
+SedResultSeries::setDimensions (const std::vector<std::string>& taskIds,
+                                const std::vector<unsigned int>& sizes)
+{
+  if (taskIds.empty() || sizes.size() + 1 != taskIds.size())
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  unsigned long long numSegments = 1;
+  for (size_t i = 0; i < sizes.size(); ++i) numSegments *= sizes[i];
+  if (numSegments > UINT_MAX) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mTaskIds = taskIds;
+  mSizes = sizes;
+  mNumSegments = (unsigned int)numSegments;
+  mStride = 0;
+  mLengths.assign(mNumSegments, 0);
+
+  free(mBlock);
+  mBlock = NULL;
+  mData = NULL;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+SedResultSeries::getNumDimensions () const
+{
+  return (unsigned int)mTaskIds.size();
+}
+
+
+const std::string&
+SedResultSeries::getDimensionTaskId (unsigned int n) const
+{
+  static const string empty;
+  return (n < mTaskIds.size()) ? mTaskIds[n] : empty;
+}
+
+
+int
+SedResultSeries::getDimensionIndex (const std::string& taskId) const
+{
+  for (size_t i = 0; i < mTaskIds.size(); ++i)
+  {
+    if (mTaskIds[i] == taskId) return (int)i;
+  }
+  return -1;
+}
+
+
+unsigned int
+SedResultSeries::getDimensionSize (unsigned int n) const
+{
+  if (n < mSizes.size()) return mSizes[n];
+  return (n == mSizes.size()) ? mStride : 0;
+}
+
+
+unsigned int
+SedResultSeries::getNumSegments () const
+{
+  return mNumSegments;
+}
+
+
+unsigned int
+SedResultSeries::getStride () const
+{
+  return mStride;
+}
+
+
+void
+SedResultSeries::reserve (unsigned int numPoints)
+{
+  if (numPoints > mStride) relayout(numPoints);
+}
+
+
+double*
+SedResultSeries::writeSegment (unsigned int segment, unsigned int numPoints)
+{
+  if (segment >= mNumSegments) return NULL;
+  if (numPoints > mStride) relayout(numPoints);
+
+  double* values = mData + (size_t)segment * mStride;
+
+  // points the segment no longer has become missing values
+  for (unsigned int i = numPoints; i < mLengths[segment]; ++i)
+  {
+    values[i] = NOT_A_NUMBER;
+  }
+
+  mLengths[segment] = numPoints;
+  return values;
+}
+
+
+int
+SedResultSeries::writeSegment (unsigned int segment, const double* values,
+                               unsigned int numPoints)
+{
+  double* target = writeSegment(segment, numPoints);
+  if (target == NULL) return LIBSEDML_INDEX_EXCEEDS_SIZE;
+
+  if (numPoints > 0) memcpy(target, values, numPoints * sizeof(double));
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedResultSeries::getSegmentIndex (const std::vector<unsigned int>& iterations) const
+{
+  if (iterations.size() != mSizes.size()) return -1;
+
+  unsigned int segment = 0;
+  for (size_t i = 0; i < mSizes.size(); ++i)
+  {
+    if (iterations[i] >= mSizes[i]) return -1;
+    segment = segment * mSizes[i] + iterations[i];
+  }
+
+  return (int)segment;
+}
+
+
+unsigned int
+SedResultSeries::getSegmentLength (unsigned int segment) const
+{
+  return (segment < mNumSegments) ? mLengths[segment] : 0;
+}
+
+
+SedDataView
+SedResultSeries::getSegment (unsigned int segment) const
+{
+  if (segment >= mNumSegments) return SedDataView();
+  return SedDataView(mData + (size_t)segment * mStride, mLengths[segment]);
+}
+
+
+SedDataView
+SedResultSeries::getPoint (unsigned int point) const
+{
+  if (point >= mStride) return SedDataView();
+  return SedDataView(mData + point, mNumSegments, mStride);
+}
+
+
+SedDataView
+SedResultSeries::getValues () const
+{
+  return SedDataView(mData, mNumSegments * mStride);
+}
+
+
+bool
+SedResultSeries::isDense () const
+{
+  for (unsigned int i = 0; i < mNumSegments; ++i)
+  {
+    if (mLengths[i] != mStride) return false;
+  }
+  return true;
+}
+
+
+int
+SedResultSeries::reduce (const std::vector<unsigned int>& dimensions,
+                         Reduction function,
+                         std::vector<double>& result) const
+{
+  const size_t numDimensions = mTaskIds.size();
+  vector<bool> reduced(numDimensions, false);
+  for (size_t i = 0; i < dimensions.size(); ++i)
+  {
+    if (dimensions[i] >= numDimensions) return LIBSEDML_INDEX_EXCEEDS_SIZE;
+    reduced[dimensions[i]] = true;
+  }
+
+  // the points of each segment are either all reduced into one value, or
+  // each kept in a value of its own
+  const bool reducePoints = reduced[numDimensions - 1];
+  size_t numResults = reducePoints ? 1 : mStride;
+  for (size_t d = 0; d < mSizes.size(); ++d)
+  {
+    if (!reduced[d]) numResults *= mSizes[d];
+  }
+
+  vector<double> accumulator(numResults,
+    function == REDUCE_PRODUCT ? 1.0 :
+    function == REDUCE_MIN ? numeric_limits<double>::infinity() :
+    function == REDUCE_MAX ? -numeric_limits<double>::infinity() : 0.0);
+  vector<double> squares;
+  if (function == REDUCE_STANDARD_DEVIATION) squares.assign(numResults, 0.0);
+  vector<unsigned int> counts(numResults, 0);
+
+  vector<unsigned int> iteration(mSizes.size(), 0);
+  for (unsigned int segment = 0; segment < mNumSegments; ++segment)
+  {
+    size_t base = 0;
+    for (size_t d = 0; d < mSizes.size(); ++d)
+    {
+      if (!reduced[d]) base = base * mSizes[d] + iteration[d];
+    }
+    if (!reducePoints) base *= mStride;
+
+    const double* values = mData + (size_t)segment * mStride;
+    const unsigned int length = mLengths[segment];
+    const size_t step = reducePoints ? 0 : 1;
+
+    for (unsigned int p = 0; p < length; ++p)
+    {
+      const size_t n = base + p * step;
+      const double value = values[p];
+      switch (function)
+      {
+      case REDUCE_PRODUCT:
+        accumulator[n] *= value;
+        break;
+      case REDUCE_MIN:
+        if (value < accumulator[n] || value != value) accumulator[n] = value;
+        break;
+      case REDUCE_MAX:
+        if (value > accumulator[n] || value != value) accumulator[n] = value;
+        break;
+      case REDUCE_STANDARD_DEVIATION:
+        squares[n] += value * value;
+        accumulator[n] += value;
+        break;
+      default:
+        accumulator[n] += value;
+        break;
+      }
+      ++counts[n];
+    }
+
+    // advance the iteration indices, the innermost fastest
+    for (size_t d = mSizes.size(); d-- > 0; )
+    {
+      if (++iteration[d] < mSizes[d]) break;
+      iteration[d] = 0;
+    }
+  }
+
+  result.resize(numResults);
+  for (size_t n = 0; n < numResults; ++n)
+  {
+    const double count = counts[n];
+    if (count == 0)
+    {
+      result[n] = NOT_A_NUMBER;
+    }
+    else if (function == REDUCE_MEAN)
+    {
+      result[n] = accumulator[n] / count;
+    }
+    else if (function == REDUCE_STANDARD_DEVIATION)
+    {
+      const double mean = accumulator[n] / count;
+      result[n] = sqrt(max(0.0, squares[n] / count - mean * mean));
+    }
+    else
+    {
+      result[n] = accumulator[n];
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+void
+SedResultSeries::clear ()
+{
+  free(mBlock);
+  mBlock = NULL;
+  mData = NULL;
+  mStride = 0;
+  mLengths.assign(mNumSegments, 0);
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Moves the segments apart so that each has room for the given number of
+ * points.
+ */
+void
+SedResultSeries::relayout (unsigned int stride)
+{
+  const size_t size = (size_t)mNumSegments * stride;
+  void* block = malloc(size * sizeof(double) + ALIGNMENT);
+  if (block == NULL) throw bad_alloc();
+
+  double* data = reinterpret_cast<double*>(
+    (reinterpret_cast<uintptr_t>(block) + ALIGNMENT - 1) & ~(uintptr_t)(ALIGNMENT - 1));
+  fill(data, data + size, NOT_A_NUMBER);
+
+  for (unsigned int i = 0; i < mNumSegments; ++i)
+  {
+    if (mLengths[i] > 0)
+    {
+      memcpy(data + (size_t)i * stride, mData + (size_t)i * mStride,
+             mLengths[i] * sizeof(double));
+    }
+  }
+
+  free(mBlock);
+  mBlock = block;
+  mData = data;
+  mStride = stride;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,290 @@
+/**
+ * @file SedResultSeries.h
+ * @brief Definition of the SedResultSeries class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedResultSeries
+ * @sbmlbrief{} The values of one model quantity over all runs of a task.
+ *
+ * A SedResultSeries stores the values a task produced for one variable in
+ * a single buffer, aligned to a cache line, instead of one vector per run.
+ * The buffer is organized as a grid of segments, one for each run of the
+ * simulation: a plain task has a single segment, a repeated task one
+ * segment per iteration, and a repeated task nested in another one
+ * segment per pair of iterations.  The dimensions of the grid are named by
+ * the ids of the tasks that span them, outermost first; the last dimension
+ * holds the points of a segment and is named by the id of the task that
+ * ran the simulation.
+ *
+ * All segments take the same space, the length of the longest segment,
+ * and the points shorter segments lack are NaN.  Segments, the values of
+ * one point across all segments, and all values at once are returned as
+ * SedDataView objects without copying them.  Values can also be reduced
+ * along any set of dimensions, for instance to compute the mean over the
+ * iterations of a parameter scan.
+ *
+ * Writing is not synchronized: segments may be written from several
+ * threads at once only if the series has been resized to its final shape
+ * before, with reserve().
+ */
+
+
+#ifndef SedResultSeries_h
+#define SedResultSeries_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+#include <sedml/SedDataTable.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedResultSeries
+{
+public:
+
+  /**
+   * The functions that values can be reduced with.
+   */
+  enum Reduction
+  {
+    REDUCE_SUM
+  , REDUCE_PRODUCT
+  , REDUCE_MIN
+  , REDUCE_MAX
+  , REDUCE_MEAN
+  , REDUCE_STANDARD_DEVIATION
+  };
+
+
+  /**
+   * Creates a new SedResultSeries with a single, empty segment.
+   */
+  SedResultSeries ();
+
+
+  /**
+   * Destroys this SedResultSeries.
+   */
+  ~SedResultSeries ();
+
+
+  /**
+   * Sets the dimensions of this series and discards all values.
+   *
+   * @param taskIds the ids of the tasks spanning the dimensions, outermost
+   * first; the last one is the task whose simulation produced the points.
+   * @param sizes the number of iterations of each dimension but the last,
+   * so one less than the number of task ids.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if @p taskIds is empty or does not match @p sizes.
+   */
+  int setDimensions (const std::vector<std::string>& taskIds,
+                     const std::vector<unsigned int>& sizes);
+
+
+  /**
+   * @return the number of dimensions, including the one of the points.
+   */
+  unsigned int getNumDimensions () const;
+
+
+  /**
+   * @return the id of the task spanning the nth dimension, or an empty
+   * string.
+   */
+  const std::string& getDimensionTaskId (unsigned int n) const;
+
+
+  /**
+   * @return the index of the outermost dimension spanned by the task with
+   * the given id, or -1 if there is none.
+   */
+  int getDimensionIndex (const std::string& taskId) const;
+
+
+  /**
+   * @return the size of the nth dimension; for the last dimension, the
+   * length of the longest segment.
+   */
+  unsigned int getDimensionSize (unsigned int n) const;
+
+
+  /**
+   * @return the number of segments.
+   */
+  unsigned int getNumSegments () const;
+
+
+  /**
+   * @return the length of the longest segment, which is the distance
+   * between the starts of consecutive segments.
+   */
+  unsigned int getStride () const;
+
+
+  /**
+   * Makes room for segments of up to the given length, so that writing
+   * them neither moves the values nor changes the layout.
+   *
+   * @param numPoints the length of the longest segment to be written.
+   */
+  void reserve (unsigned int numPoints);
+
+
+  /**
+   * Returns the memory for the given segment, which is to be filled with
+   * @p numPoints values.  The memory is only valid until a longer segment
+   * is written.
+   *
+   * @param segment the index of the segment, see getSegmentIndex().
+   * @param numPoints the number of values of the segment.
+   *
+   * @return the first value of the segment, or @c NULL if there is no such
+   * segment.
+   */
+  double* writeSegment (unsigned int segment, unsigned int numPoints);
+
+
+  /**
+   * Writes the given values into the given segment.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INDEX_EXCEEDS_SIZE, OperationReturnValues_t}
+   */
+  int writeSegment (unsigned int segment, const double* values,
+                    unsigned int numPoints);
+
+
+  /**
+   * @return the index of the segment with the given iteration indices, one
+   * for each dimension but the last, or -1 if they are out of range.
+   */
+  int getSegmentIndex (const std::vector<unsigned int>& iterations) const;
+
+
+  /**
+   * @return the number of values written to the given segment.
+   */
+  unsigned int getSegmentLength (unsigned int segment) const;
+
+
+  /**
+   * @return a view of the values of the given segment.
+   */
+  SedDataView getSegment (unsigned int segment) const;
+
+
+  /**
+   * @return a view of the values of the given point across all segments.
+   */
+  SedDataView getPoint (unsigned int point) const;
+
+
+  /**
+   * @return a view of all values, segment after segment, including the
+   * NaN values that pad shorter segments.
+   */
+  SedDataView getValues () const;
+
+
+  /**
+   * @return @c true if all segments have the same length, so that
+   * getValues() holds no padding.
+   */
+  bool isDense () const;
+
+
+  /**
+   * Reduces the values along the given dimensions.  Values missing from
+   * short segments are ignored.  The standard deviation is that of the
+   * population.
+   *
+   * @param dimensions the indices of the dimensions to reduce.
+   * @param function the reduction.
+   * @param result vector receiving the reduced values, in the order of the
+   * remaining dimensions, the outermost varying slowest.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INDEX_EXCEEDS_SIZE, OperationReturnValues_t}
+   * if a dimension does not exist.
+   */
+  int reduce (const std::vector<unsigned int>& dimensions, Reduction function,
+              std::vector<double>& result) const;
+
+
+  /**
+   * Removes all values, keeping the dimensions.
+   */
+  void clear ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  SedResultSeries (const SedResultSeries& orig);
+  SedResultSeries& operator= (const SedResultSeries& rhs);
+
+  void relayout (unsigned int stride);
+
+  std::vector<std::string> mTaskIds;
+  std::vector<unsigned int> mSizes;
+  std::vector<unsigned int> mLengths;
+  unsigned int mNumSegments;
+  unsigned int mStride;
+  void* mBlock;
+  double* mData;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedResultSeries_h */
@@ -0,0 +1,515 @@
+/**
+ * @file SedResultStore.cpp
+ * @brief Implementation of the SedResultStore class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedResultStore.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedTaskResult.h>
+#include <sedml/SedVariable.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <algorithm>
+#include <functional>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+namespace
+{
+
+/*
+ * Returns the first child of the given iteration that has iterations of
+ * its own, i.e. the result of a nested repeated task.
+ */
+const SedTaskResult*
+findNested (const SedTaskResult& iteration)
+{
+  for (unsigned int i = 0; i < iteration.getNumChildren(); ++i)
+  {
+    const SedTaskResult* child = iteration.getChild(i);
+    if (child->getNumChildren() > 0) return child;
+  }
+  return NULL;
+}
+
+
+/*
+ * Collects the columns that make up one segment: the column of a plain
+ * task result, or those of all subtasks of an iteration, one after the
+ * other.
+ */
+void
+collectPieces (const SedTaskResult& result, const string& column,
+               vector<const vector<double>*>& pieces)
+{
+  pieces.clear();
+
+  if (result.getNumChildren() == 0)
+  {
+    const vector<double>* values = result.getColumn(column);
+    if (values != NULL) pieces.push_back(values);
+    return;
+  }
+
+  for (unsigned int i = 0; i < result.getNumChildren(); ++i)
+  {
+    const vector<double>* values = result.getChild(i)->getColumn(column);
+    if (values != NULL) pieces.push_back(values);
+  }
+}
+
+
+/*
+ * Calls the given function for each segment of the given result, with the
+ * index of the segment and the result holding its pieces.
+ */
+void
+forEachSegment (const SedTaskResult& result, const vector<unsigned int>& sizes,
+                size_t level, unsigned int segment,
+                const function<void (unsigned int, const SedTaskResult&)>& fn)
+{
+  if (level == sizes.size())
+  {
+    fn(segment, result);
+    return;
+  }
+
+  const unsigned int count = min(result.getNumChildren(), sizes[level]);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const SedTaskResult* iteration = result.getChild(i);
+    const unsigned int index = segment * sizes[level] + i;
+
+    if (level + 1 == sizes.size())
+    {
+      fn(index, *iteration);
+      continue;
+    }
+
+    const SedTaskResult* nested = findNested(*iteration);
+    if (nested != NULL)
+    {
+      forEachSegment(*nested, sizes, level + 1, index, fn);
+    }
+  }
+}
+
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedResultStore.
+ */
+SedResultStore::SedResultStore ()
+  : mResolver()
+  , mSeries()
+{
+}
+
+
+/*
+ * Destroys this SedResultStore.
+ */
+SedResultStore::~SedResultStore ()
+{
+  clear();
+}
+
+
+void
+SedResultStore::setColumnResolver (const ColumnResolver& resolver)
+{
+  mResolver = resolver;
+}
+
+
+std::string
+SedResultStore::getDefaultColumnName (const SedVariable* variable)
+{
+  if (variable == NULL) return string();
+
+  if (!variable->isSetTarget())
+  {
+    const string& symbol = variable->getSymbol();
+    return (symbol == "urn:sedml:symbol:time") ? "time" : symbol;
+  }
+
+  const string& target = variable->getTarget();
+  size_t pos = target.rfind("@id=");
+  if (pos == string::npos || pos + 5 > target.size()) return target;
+
+  const char quote = target[pos + 4];
+  if (quote != '\'' && quote != '"') return target;
+
+  size_t end = target.find(quote, pos + 5);
+  if (end == string::npos) return target;
+
+  return target.substr(pos + 5, end - pos - 5);
+}
+
+
+std::string
+SedResultStore::getVariableKey (const SedVariable* variable)
+{
+  if (variable == NULL) return string();
+
+  string key = variable->isSetTarget()
+    ? "target:" + variable->getTarget()
+    : "symbol:" + variable->getSymbol();
+  if (variable->isSetTerm()) key += "\nterm:" + variable->getTerm();
+  return key;
+}
+
+
+int
+SedResultStore::getReduction (const std::string& kisaoTerm)
+{
+  if (kisaoTerm == "KISAO:0000825") return SedResultSeries::REDUCE_MEAN;
+  if (kisaoTerm == "KISAO:0000826") return SedResultSeries::REDUCE_STANDARD_DEVIATION;
+  if (kisaoTerm == "KISAO:0000828") return SedResultSeries::REDUCE_MAX;
+  if (kisaoTerm == "KISAO:0000829") return SedResultSeries::REDUCE_MIN;
+  return -1;
+}
+
+
+SedResultSeries*
+SedResultStore::createSeries (const std::string& taskId,
+                              const std::string& key)
+{
+  SedResultSeries*& series = mSeries[taskId + '\n' + key];
+  if (series == NULL) series = new SedResultSeries();
+  return series;
+}
+
+
+const SedResultSeries*
+SedResultStore::getSeries (const std::string& taskId,
+                           const std::string& key) const
+{
+  SeriesMap::const_iterator it = mSeries.find(taskId + '\n' + key);
+  return (it == mSeries.end()) ? NULL : it->second;
+}
+
+
+const SedResultSeries*
+SedResultStore::getSeries (const SedVariable* variable) const
+{
+  if (variable == NULL) return NULL;
+  return getSeries(variable->getTaskReference(), getVariableKey(variable));
+}
+
+
+unsigned int
+SedResultStore::getNumSeries () const
+{
+  return (unsigned int)mSeries.size();
+}
+
+
+int
+SedResultStore::addTaskResult (const SedDocument* document,
+                               const SedTaskResult& result)
+{
+  if (document == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  const string& taskId = result.getTaskId();
+  removeTask(taskId);
+
+  int status = LIBSEDML_OPERATION_SUCCESS;
+  for (unsigned int i = 0; i < document->getNumDataGenerators(); ++i)
+  {
+    const SedDataGenerator* dataGenerator = document->getDataGenerator(i);
+    for (unsigned int n = 0; n < dataGenerator->getNumVariables(); ++n)
+    {
+      const SedVariable* variable = dataGenerator->getVariable(n);
+      if (variable->getTaskReference() != taskId) continue;
+
+      const string key = getVariableKey(variable);
+      if (getSeries(taskId, key) != NULL) continue;
+
+      const string column = mResolver ? mResolver(variable)
+                                      : getDefaultColumnName(variable);
+      SedResultSeries* series = createSeries(taskId, key);
+      if (storeColumn(result, column, *series) != LIBSEDML_OPERATION_SUCCESS)
+      {
+        mSeries.erase(taskId + '\n' + key);
+        delete series;
+        status = LIBSEDML_OPERATION_FAILED;
+      }
+    }
+  }
+
+  return status;
+}
+
+
+void
+SedResultStore::removeTask (const std::string& taskId)
+{
+  const string prefix = taskId + '\n';
+  for (SeriesMap::iterator it = mSeries.begin(); it != mSeries.end(); )
+  {
+    if (it->first.compare(0, prefix.size(), prefix) == 0)
+    {
+      delete it->second;
+      it = mSeries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+
+int
+SedResultStore::getValues (const SedVariable* variable, SedDataView& values,
+                           std::vector<double>& buffer) const
+{
+  values = SedDataView();
+  if (variable == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  const SedResultSeries* series = getSeries(variable);
+  if (series == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  if (variable->isSetDimensionTerm())
+  {
+    int reduction = getReduction(variable->getDimensionTerm());
+    if (reduction < 0) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+    // without applied dimensions, all values are reduced to one
+    vector<unsigned int> dimensions;
+    for (unsigned int i = 0; i < variable->getNumAppliedDimensions(); ++i)
+    {
+      const SedAppliedDimension* applied = variable->getAppliedDimension(i);
+      int dimension = series->getDimensionIndex(applied->getTarget());
+      if (!applied->isSetTarget() || dimension < 0)
+      {
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+      }
+      dimensions.push_back((unsigned int)dimension);
+    }
+    if (dimensions.empty())
+    {
+      for (unsigned int d = 0; d < series->getNumDimensions(); ++d)
+      {
+        dimensions.push_back(d);
+      }
+    }
+
+    int status = series->reduce(dimensions,
+      static_cast<SedResultSeries::Reduction>(reduction), buffer);
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+    values = SedDataView(buffer.empty() ? NULL : &buffer[0],
+                         (unsigned int)buffer.size());
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  if (variable->getNumAppliedDimensions() > 0)
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  // the segments, one after the other
+  if (series->isDense())
+  {
+    values = series->getValues();
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  buffer.clear();
+  for (unsigned int i = 0; i < series->getNumSegments(); ++i)
+  {
+    SedDataView segment = series->getSegment(i);
+    buffer.insert(buffer.end(), segment.getData(),
+                  segment.getData() + segment.size());
+  }
+
+  values = SedDataView(buffer.empty() ? NULL : &buffer[0],
+                       (unsigned int)buffer.size());
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedResultStore::bindVariables (const SedDataGenerator* dataGenerator,
+                               SedCompiledMath& math,
+                               std::vector< std::vector<double> >& buffers,
+                               size_t& numPoints) const
+{
+  numPoints = 0;
+  if (dataGenerator == NULL || !math.isCompiled())
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  size_t shortest = 0;
+  bool hasArrays = false;
+  buffers.resize(dataGenerator->getNumVariables());
+
+  for (unsigned int i = 0; i < dataGenerator->getNumVariables(); ++i)
+  {
+    const SedVariable* variable = dataGenerator->getVariable(i);
+    int slot = math.getSlotIndex(variable->getId());
+    if (slot < 0) continue;
+
+    SedDataView values;
+    int status = getValues(variable, values, buffers[i]);
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+    if (values.size() == 1)
+    {
+      math.setSlotValue(slot, values[0]);
+      continue;
+    }
+
+    math.setSlotValues(slot, values.getData());
+    shortest = hasArrays ? min(shortest, (size_t)values.size()) : values.size();
+    hasArrays = true;
+  }
+
+  numPoints = hasArrays ? shortest : 1;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+void
+SedResultStore::clear ()
+{
+  for (SeriesMap::iterator it = mSeries.begin(); it != mSeries.end(); ++it)
+  {
+    delete it->second;
+  }
+  mSeries.clear();
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Copies the given column of all runs in the given result into the given
+ * series, shaped after the iterations of the result.
+ */
+int
+SedResultStore::storeColumn (const SedTaskResult& result,
+                             const std::string& column,
+                             SedResultSeries& series) const
+{
+  vector<string> taskIds(1, result.getTaskId());
+  vector<unsigned int> sizes;
+
+  const SedTaskResult* current = &result;
+  while (current->getNumChildren() > 0)
+  {
+    sizes.push_back(current->getNumChildren());
+    const SedTaskResult* iteration = current->getChild(0);
+
+    const SedTaskResult* nested = findNested(*iteration);
+    if (nested != NULL)
+    {
+      taskIds.push_back(nested->getTaskId());
+      current = nested;
+      continue;
+    }
+
+    // the points are named after the subtask that produced them
+    string leaf;
+    for (unsigned int i = 0; i < iteration->getNumChildren() && leaf.empty(); ++i)
+    {
+      if (iteration->getChild(i)->getColumn(column) != NULL)
+      {
+        leaf = iteration->getChild(i)->getTaskId();
+      }
+    }
+    taskIds.push_back(leaf.empty() ? iteration->getTaskId() : leaf);
+    break;
+  }
+
+  int status = series.setDimensions(taskIds, sizes);
+  if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+  // find the longest segment first, so that the values are laid out once
+  bool found = false;
+  vector<const vector<double>*> pieces;
+  unsigned int longest = 0;
+  forEachSegment(result, sizes, 0, 0,
+    [&](unsigned int, const SedTaskResult& run)
+  {
+    collectPieces(run, column, pieces);
+    size_t length = 0;
+    for (size_t i = 0; i < pieces.size(); ++i) length += pieces[i]->size();
+    longest = max(longest, (unsigned int)length);
+    found = found || !pieces.empty();
+  });
+
+  if (!found) return LIBSEDML_OPERATION_FAILED;
+  series.reserve(longest);
+
+  forEachSegment(result, sizes, 0, 0,
+    [&](unsigned int segment, const SedTaskResult& run)
+  {
+    collectPieces(run, column, pieces);
+    size_t length = 0;
+    for (size_t i = 0; i < pieces.size(); ++i) length += pieces[i]->size();
+
+    double* values = series.writeSegment(segment, (unsigned int)length);
+    for (size_t i = 0; i < pieces.size(); ++i)
+    {
+      values = copy(pieces[i]->begin(), pieces[i]->end(), values);
+    }
+  });
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,309 @@
+/**
+ * @file SedResultStore.h
+ * @brief Definition of the SedResultStore class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedResultStore
+ * @sbmlbrief{} Simulation results by task and variable, for evaluating
+ * data generators.
+ *
+ * A SedResultStore holds a SedResultSeries for each task and each model
+ * quantity that the variables of a document refer to with their "target"
+ * or "symbol" (and "term") attributes.  Variables that refer to the same
+ * quantity of the same task share one series, however many data
+ * generators use them.
+ *
+ * addTaskResult() copies the columns of a SedTaskResult that variables
+ * refer to into the store, once; a SedTaskExecutor does so itself when a
+ * store has been set with SedTaskExecutor::setResultStore().  Which column
+ * holds the values of a variable is decided by a column resolver; by
+ * default it is the id the target selects (the last
+ * <code>[\@id='...']</code> predicate), or @c time for the time symbol.
+ *
+ * getValues() then returns the values of a variable without copying
+ * them, or, if the variable has applied dimensions and a dimension term,
+ * reduces them along the dimensions of the tasks named by the applied
+ * dimensions.  The dimension terms understood are KISAO:0000825 (mean),
+ * KISAO:0000826 (standard deviation), KISAO:0000828 (maximum) and
+ * KISAO:0000829 (minimum).
+ *
+ * @code{.cpp}
+SedResultStore store;
+executor.setResultStore(&store);
+executor.execute();
+
+SedCompiledMath math;
+math.compile(dataGenerator);
+
+std::vector< std::vector<double> > buffers;
+size_t numPoints = 0;
+if (store.bindVariables(dataGenerator, math, buffers, numPoints)
+    == LIBSEDML_OPERATION_SUCCESS)
+{
+  std::vector<double> result(numPoints);
+  math.evaluate(numPoints, &result[0]);
+}
+ * @endcode
+ */
+
+
+#ifndef SedResultStore_h
+#define SedResultStore_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sedml/SedResultSeries.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedVariable;
+class SedDataGenerator;
+class SedTaskResult;
+class SedCompiledMath;
+
+
+class LIBSEDML_EXTERN SedResultStore
+{
+public:
+
+  /**
+   * Returns the name of the SedTaskResult column holding the values of
+   * the given variable.
+   */
+  typedef std::function<std::string (const SedVariable*)> ColumnResolver;
+
+
+  /**
+   * Creates a new, empty SedResultStore.
+   */
+  SedResultStore ();
+
+
+  /**
+   * Destroys this SedResultStore, along with all series.
+   */
+  ~SedResultStore ();
+
+
+  /**
+   * Sets the function that maps variables to result columns.
+   *
+   * @param resolver the function, or an empty function to use
+   * getDefaultColumnName().
+   */
+  void setColumnResolver (const ColumnResolver& resolver);
+
+
+  /**
+   * Returns the column name used for the given variable by default: @c time
+   * for the symbol <code>urn:sedml:symbol:time</code>, the value of the last
+   * <code>\@id</code> predicate of the target, or else the target or symbol
+   * itself.
+   *
+   * @param variable the variable.
+   *
+   * @return the column name.
+   */
+  static std::string getDefaultColumnName (const SedVariable* variable);
+
+
+  /**
+   * Returns the key under which the values of the given variable are
+   * stored for its task: its target or symbol, and its term.
+   *
+   * @param variable the variable.
+   *
+   * @return the key.
+   */
+  static std::string getVariableKey (const SedVariable* variable);
+
+
+  /**
+   * Returns the reduction named by the given KiSAO term.
+   *
+   * @param kisaoTerm the value of the "dimensionTerm" attribute of a
+   * variable.
+   *
+   * @return one of the SedResultSeries::Reduction values, or -1 if the
+   * term is not understood.
+   */
+  static int getReduction (const std::string& kisaoTerm);
+
+
+  /**
+   * Returns the series for the given task and key, adding an empty series
+   * if there is none.
+   *
+   * @param taskId the id of the task.
+   * @param key the key of the variable, see getVariableKey().
+   *
+   * @return the series, owned by this store.
+   */
+  SedResultSeries* createSeries (const std::string& taskId,
+                                 const std::string& key);
+
+
+  /**
+   * @return the series for the given task and key, or @c NULL.
+   */
+  const SedResultSeries* getSeries (const std::string& taskId,
+                                    const std::string& key) const;
+
+
+  /**
+   * @return the series holding the values of the given variable, or
+   * @c NULL.
+   */
+  const SedResultSeries* getSeries (const SedVariable* variable) const;
+
+
+  /**
+   * @return the number of series in this store.
+   */
+  unsigned int getNumSeries () const;
+
+
+  /**
+   * Stores the values that the variables of the given document take from
+   * the given result.  Series of the task stored before are replaced.
+   *
+   * @param document the document whose data generators name the
+   * variables.
+   * @param result the result of a task of @p document.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if @p document is @c NULL.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if the result lacks the column of a variable.
+   */
+  int addTaskResult (const SedDocument* document, const SedTaskResult& result);
+
+
+  /**
+   * Removes the series of the task with the given id.
+   */
+  void removeTask (const std::string& taskId);
+
+
+  /**
+   * Retrieves the values of the given variable, reduced along its applied
+   * dimensions if it has a dimension term.
+   *
+   * @param variable the variable.
+   * @param values view that receives the values; it points into the
+   * series, or into @p buffer.
+   * @param buffer vector holding the values if they cannot be returned
+   * without copying them.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if @p variable is @c NULL.
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if the dimension term is not understood, or an applied dimension does
+   * not name a task of the series.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if no values have been stored for @p variable.
+   */
+  int getValues (const SedVariable* variable, SedDataView& values,
+                 std::vector<double>& buffer) const;
+
+
+  /**
+   * Binds the slots of the variables of the given data generator in the
+   * given compiled math to their values.  Variables whose values reduce
+   * to a single number are bound to that number.
+   *
+   * @param dataGenerator the data generator.
+   * @param math the compiled math of @p dataGenerator.
+   * @param buffers vectors holding values that have to be copied; they
+   * must stay unchanged while @p math is evaluated.
+   * @param numPoints set to the number of points to evaluate: the length
+   * of the shortest array of values, or 1 if all variables are single
+   * numbers.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   */
+  int bindVariables (const SedDataGenerator* dataGenerator,
+                     SedCompiledMath& math,
+                     std::vector< std::vector<double> >& buffers,
+                     size_t& numPoints) const;
+
+
+  /**
+   * Removes all series.
+   */
+  void clear ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  SedResultStore (const SedResultStore& orig);
+  SedResultStore& operator= (const SedResultStore& rhs);
+
+  typedef std::unordered_map<std::string, SedResultSeries*> SeriesMap;
+
+  int storeColumn (const SedTaskResult& result, const std::string& column,
+                   SedResultSeries& series) const;
+
+  ColumnResolver mResolver;
+  SeriesMap mSeries;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedResultStore_h */
@@ -71,7 +71,7 @@ SedSetValue::SedSetValue(unsigned int level, unsigned int version)
 /*
  * Creates a new SedSetValue using the given SedNamespaces object @p sedmlns.
  */
-SedSetValue::SedSetValue(SedNamespaces *sedmlns)
+SedSetValue::SedSetValue(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mModelReference ("")
   , mSymbol ("")
@@ -247,6 +247,8 @@ SedSetValue::isSetRange() const
 int
 SedSetValue::setModelReference(const std::string& modelReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(modelReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -287,6 +289,8 @@ SedSetValue::setTarget(const std::string& target)
 int
 SedSetValue::setRange(const std::string& range)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(range)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -305,6 +309,8 @@ SedSetValue::setRange(const std::string& range)
 int
 SedSetValue::unsetModelReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -362,6 +368,8 @@ SedSetValue::unsetTarget()
 int
 SedSetValue::unsetRange()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mRange.erase();
 
   if (mRange.empty() == true)
@@ -411,6 +419,8 @@ SedSetValue::isSetMath() const
 int
 SedSetValue::setMath(const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* math)
 {
+  markChanged(CHANGE_CHILDREN);
+
   if (mMath == math)
   {
     return LIBSEDML_OPERATION_SUCCESS;
@@ -440,6 +450,8 @@ SedSetValue::setMath(const LIBSBML_CPP_NAMESPACE_QUALIFIER ASTNode* math)
 int
 SedSetValue::unsetMath()
 {
+  markChanged(CHANGE_CHILDREN);
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -904,7 +916,48 @@ SedSetValue::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedSetValue::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedSetValue
+ */
+unsigned int
+SedSetValue::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mVariables,
+    &mParameters
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 2);
+}
+
+
+/*
+ * Returns the nth child object of this SedSetValue
+ */
+const SedBase*
+SedSetValue::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mVariables,
+    &mParameters
+  };
+
+  return selectChildElement(children, 2, n - inherited);
 }
 
 /** @endcond */
@@ -101,7 +101,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedSetValue(SedNamespaces *sedmlns);
+  SedSetValue(const SedNamespaces *sedmlns);
 
 
   /**
@@ -929,6 +929,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedSetValue
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedSetValue
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
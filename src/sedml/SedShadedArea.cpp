@@ -63,7 +63,7 @@ SedShadedArea::SedShadedArea(unsigned int level, unsigned int version)
 /*
  * Creates a new SedShadedArea using the given SedNamespaces object @p sedmlns.
  */
-SedShadedArea::SedShadedArea(SedNamespaces *sedmlns)
+SedShadedArea::SedShadedArea(const SedNamespaces *sedmlns)
   : SedAbstractCurve(sedmlns)
   , mYDataReferenceFrom ("")
   , mYDataReferenceTo ("")
@@ -167,6 +167,8 @@ SedShadedArea::isSetYDataReferenceTo() const
 int
 SedShadedArea::setYDataReferenceFrom(const std::string& yDataReferenceFrom)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(yDataReferenceFrom)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -185,6 +187,8 @@ SedShadedArea::setYDataReferenceFrom(const std::string& yDataReferenceFrom)
 int
 SedShadedArea::setYDataReferenceTo(const std::string& yDataReferenceTo)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(yDataReferenceTo)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -204,6 +208,8 @@ SedShadedArea::setYDataReferenceTo(const std::string& yDataReferenceTo)
 int
 SedShadedArea::unsetYDataReferenceFrom()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mYDataReferenceFrom.erase();
 
   if (mYDataReferenceFrom.empty() == true)
@@ -223,6 +229,8 @@ SedShadedArea::unsetYDataReferenceFrom()
 int
 SedShadedArea::unsetYDataReferenceTo()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mYDataReferenceTo.erase();
 
   if (mYDataReferenceTo.empty() == true)
@@ -324,7 +332,11 @@ SedShadedArea::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedShadedArea::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -94,7 +94,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedShadedArea(SedNamespaces *sedmlns);
+  SedShadedArea(const SedNamespaces *sedmlns);
 
 
   /**
@@ -72,7 +72,7 @@ SedSimulation::SedSimulation(unsigned int level, unsigned int version)
 /*
  * Creates a new SedSimulation using the given SedNamespaces object @p sedmlns.
  */
-SedSimulation::SedSimulation(SedNamespaces *sedmlns)
+SedSimulation::SedSimulation(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mAlgorithm (NULL)
   , mElementName("simulation")
@@ -386,7 +386,46 @@ SedSimulation::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedSimulation::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedSimulation
+ */
+unsigned int
+SedSimulation::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    mAlgorithm
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedSimulation
+ */
+const SedBase*
+SedSimulation::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    mAlgorithm
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
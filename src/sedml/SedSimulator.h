@@ -0,0 +1,164 @@
+/**
+ * @file SedSimulator.h
+ * @brief Definition of the SedSimulator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedSimulator
+ * @sbmlbrief{} Interface of the simulation backends used by
+ * SedTaskExecutor.
+ *
+ * A SedSimulator holds one instance of a model and simulates it.  The
+ * SedTaskExecutor creates simulators through factories registered for the
+ * KiSAO ids of the algorithms they implement (see
+ * SedTaskExecutor::registerSimulator()), loads the model with its changes
+ * applied, applies the changes of repeated tasks, and asks for simulations.
+ * The model state is kept between simulations: a simulation continues
+ * from the state the previous one ended in, until resetModel() is called.
+ *
+ * Each simulator is only ever used by one thread at a time, but several
+ * simulators may run concurrently, so they must not share mutable state.
+ *
+ * As a SedValueProvider, a simulator also supplies the current values of
+ * model quantities that the math of repeated tasks refers to.
+ */
+
+
+#ifndef SedSimulator_h
+#define SedSimulator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedValueProvider.h>
+#include <sbml/common/libsbml-namespace.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+class XMLNode;
+LIBSBML_CPP_NAMESPACE_END
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedModel;
+class SedSetValue;
+class SedSimulation;
+class SedTaskResult;
+
+
+class LIBSEDML_EXTERN SedSimulator : public SedValueProvider
+{
+public:
+
+  /**
+   * Creates a new SedSimulator.
+   */
+  SedSimulator ();
+
+
+  /**
+   * Destroys this SedSimulator.
+   */
+  virtual ~SedSimulator ();
+
+
+  /**
+   * Loads the given model; it is called once, before any other method.
+   *
+   * @param model the model element.
+   * @param xml the model with all its changes applied, as built by a
+   * SedModelBuilder, or @c NULL if it could not be built (for instance
+   * because the simulator reads the source itself).
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   */
+  virtual int loadModel (const SedModel* model,
+                         const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* xml) = 0;
+
+
+  /**
+   * Restores the state the model had after loadModel().
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   */
+  virtual int resetModel () = 0;
+
+
+  /**
+   * Sets the model quantity that the given change refers to.
+   *
+   * @param change the change of a repeated task or subtask.
+   * @param value the value computed for the current iteration.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   */
+  virtual int setValue (const SedSetValue* change, double value) = 0;
+
+
+  /**
+   * Runs the given simulation from the current state of the model and
+   * appends its output to the columns of @p result.
+   *
+   * @param simulation the simulation to run.
+   * @param result the result receiving the output.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   */
+  virtual int simulate (const SedSimulation* simulation,
+                        SedTaskResult& result) = 0;
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  SedSimulator (const SedSimulator& orig);
+  SedSimulator& operator= (const SedSimulator& rhs);
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedSimulator_h */
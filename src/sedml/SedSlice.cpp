@@ -68,7 +68,7 @@ SedSlice::SedSlice(unsigned int level, unsigned int version)
 /*
  * Creates a new SedSlice using the given SedNamespaces object @p sedmlns.
  */
-SedSlice::SedSlice(SedNamespaces *sedmlns)
+SedSlice::SedSlice(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mReference ("")
   , mValue ("")
@@ -494,7 +494,11 @@ SedSlice::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedSlice::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -96,7 +96,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedSlice(SedNamespaces *sedmlns);
+  SedSlice(const SedNamespaces *sedmlns);
 
 
   /**
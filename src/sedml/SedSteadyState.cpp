@@ -62,7 +62,7 @@ SedSteadyState::SedSteadyState(unsigned int level, unsigned int version)
  * Creates a new SedSteadyState using the given SedNamespaces object @p
  * sedmlns.
  */
-SedSteadyState::SedSteadyState(SedNamespaces *sedmlns)
+SedSteadyState::SedSteadyState(const SedNamespaces *sedmlns)
   : SedSimulation(sedmlns)
 {
   setElementNamespace(sedmlns->getURI());
@@ -170,7 +170,11 @@ SedSteadyState::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedSteadyState::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
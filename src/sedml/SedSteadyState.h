@@ -86,7 +86,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedSteadyState(SedNamespaces *sedmlns);
+  SedSteadyState(const SedNamespaces *sedmlns);
 
 
   /**
@@ -66,7 +66,7 @@ SedStyle::SedStyle(unsigned int level, unsigned int version)
 /*
  * Creates a new SedStyle using the given SedNamespaces object @p sedmlns.
  */
-SedStyle::SedStyle(SedNamespaces *sedmlns)
+SedStyle::SedStyle(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mBaseStyle ("")
   , mLineStyle (NULL)
@@ -204,6 +204,9 @@ SedStyle::isSetBaseStyle() const
 int
 SedStyle::setBaseStyle(const std::string& baseStyle)
 {
+  invalidateEffectiveStyles();
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(baseStyle)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -222,6 +225,9 @@ SedStyle::setBaseStyle(const std::string& baseStyle)
 int
 SedStyle::unsetBaseStyle()
 {
+  invalidateEffectiveStyles();
+  markChanged(CHANGE_REFERENCES);
+
   mBaseStyle.erase();
 
   if (mBaseStyle.empty() == true)
@@ -331,6 +337,8 @@ SedStyle::isSetFillStyle() const
 int
 SedStyle::setLineStyle(const SedLine* lineStyle)
 {
+  invalidateEffectiveStyles();
+
   if (mLineStyle == lineStyle)
   {
     return LIBSEDML_OPERATION_SUCCESS;
@@ -361,6 +369,8 @@ SedStyle::setLineStyle(const SedLine* lineStyle)
 int
 SedStyle::setMarkerStyle(const SedMarker* markerStyle)
 {
+  invalidateEffectiveStyles();
+
   if (mMarkerStyle == markerStyle)
   {
     return LIBSEDML_OPERATION_SUCCESS;
@@ -391,6 +401,8 @@ SedStyle::setMarkerStyle(const SedMarker* markerStyle)
 int
 SedStyle::setFillStyle(const SedFill* fillStyle)
 {
+  invalidateEffectiveStyles();
+
   if (mFillStyle == fillStyle)
   {
     return LIBSEDML_OPERATION_SUCCESS;
@@ -484,6 +496,8 @@ SedStyle::createFillStyle()
 int
 SedStyle::unsetLineStyle()
 {
+  invalidateEffectiveStyles();
+
   delete mLineStyle;
   mLineStyle = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -496,6 +510,8 @@ SedStyle::unsetLineStyle()
 int
 SedStyle::unsetMarkerStyle()
 {
+  invalidateEffectiveStyles();
+
   delete mMarkerStyle;
   mMarkerStyle = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -508,6 +524,8 @@ SedStyle::unsetMarkerStyle()
 int
 SedStyle::unsetFillStyle()
 {
+  invalidateEffectiveStyles();
+
   delete mFillStyle;
   mFillStyle = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -606,7 +624,50 @@ SedStyle::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedStyle::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedStyle
+ */
+unsigned int
+SedStyle::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    mLineStyle,
+    mMarkerStyle,
+    mFillStyle
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 3);
+}
+
+
+/*
+ * Returns the nth child object of this SedStyle
+ */
+const SedBase*
+SedStyle::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    mLineStyle,
+    mMarkerStyle,
+    mFillStyle
+  };
+
+  return selectChildElement(children, 3, n - inherited);
 }
 
 /** @endcond */
@@ -70,7 +70,7 @@ SedSubPlot::SedSubPlot(unsigned int level, unsigned int version)
 /*
  * Creates a new SedSubPlot using the given SedNamespaces object @p sedmlns.
  */
-SedSubPlot::SedSubPlot(SedNamespaces *sedmlns)
+SedSubPlot::SedSubPlot(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mPlot ("")
   , mRow (SEDML_INT_MAX)
@@ -252,6 +252,8 @@ SedSubPlot::isSetColSpan() const
 int
 SedSubPlot::setPlot(const std::string& plot)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(plot)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -318,6 +320,8 @@ SedSubPlot::setColSpan(int colSpan)
 int
 SedSubPlot::unsetPlot()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mPlot.erase();
 
   if (mPlot.empty() == true)
@@ -498,7 +502,11 @@ SedSubPlot::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedSubPlot::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -100,7 +100,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedSubPlot(SedNamespaces *sedmlns);
+  SedSubPlot(const SedNamespaces *sedmlns);
 
 
   /**
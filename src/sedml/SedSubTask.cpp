@@ -65,7 +65,7 @@ SedSubTask::SedSubTask(unsigned int level, unsigned int version)
 /*
  * Creates a new SedSubTask using the given SedNamespaces object @p sedmlns.
  */
-SedSubTask::SedSubTask(SedNamespaces *sedmlns)
+SedSubTask::SedSubTask(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mOrder (SEDML_INT_MAX)
   , mIsSetOrder (false)
@@ -184,6 +184,8 @@ SedSubTask::setOrder(int order)
 int
 SedSubTask::setTask(const std::string& task)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(task)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -222,6 +224,8 @@ SedSubTask::unsetOrder()
 int
 SedSubTask::unsetTask()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mTask.erase();
 
   if (mTask.empty() == true)
@@ -510,7 +514,46 @@ SedSubTask::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedSubTask::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedSubTask
+ */
+unsigned int
+SedSubTask::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mSetValues
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedSubTask
+ */
+const SedBase*
+SedSubTask::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mSetValues
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
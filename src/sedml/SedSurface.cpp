@@ -77,7 +77,7 @@ SedSurface::SedSurface(unsigned int level, unsigned int version)
 /*
  * Creates a new SedSurface using the given SedNamespaces object @p sedmlns.
  */
-SedSurface::SedSurface(SedNamespaces *sedmlns)
+SedSurface::SedSurface(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mXDataReference ("")
   , mYDataReference ("")
@@ -465,6 +465,8 @@ SedSurface::isSetOrder() const
 int
 SedSurface::setXDataReference(const std::string& xDataReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(xDataReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -483,6 +485,8 @@ SedSurface::setXDataReference(const std::string& xDataReference)
 int
 SedSurface::setYDataReference(const std::string& yDataReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(yDataReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -501,6 +505,8 @@ SedSurface::setYDataReference(const std::string& yDataReference)
 int
 SedSurface::setZDataReference(const std::string& zDataReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(zDataReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -555,6 +561,8 @@ SedSurface::setType(const std::string& type)
 int
 SedSurface::setStyle(const std::string& style)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(style)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -621,6 +629,8 @@ SedSurface::setOrder(int order)
 int
 SedSurface::unsetXDataReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mXDataReference.erase();
 
   if (mXDataReference.empty() == true)
@@ -640,6 +650,8 @@ SedSurface::unsetXDataReference()
 int
 SedSurface::unsetYDataReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mYDataReference.erase();
 
   if (mYDataReference.empty() == true)
@@ -659,6 +671,8 @@ SedSurface::unsetYDataReference()
 int
 SedSurface::unsetZDataReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mZDataReference.erase();
 
   if (mZDataReference.empty() == true)
@@ -689,6 +703,8 @@ SedSurface::unsetType()
 int
 SedSurface::unsetStyle()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mStyle.erase();
 
   if (mStyle.empty() == true)
@@ -874,7 +890,11 @@ SedSurface::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedSurface::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
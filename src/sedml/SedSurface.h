@@ -140,7 +140,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedSurface(SedNamespaces *sedmlns);
+  SedSurface(const SedNamespaces *sedmlns);
 
 
   /**
@@ -62,7 +62,7 @@ SedTask::SedTask(unsigned int level, unsigned int version)
 /*
  * Creates a new SedTask using the given SedNamespaces object @p sedmlns.
  */
-SedTask::SedTask(SedNamespaces *sedmlns)
+SedTask::SedTask(const SedNamespaces *sedmlns)
   : SedAbstractTask(sedmlns)
   , mModelReference ("")
   , mSimulationReference ("")
@@ -165,6 +165,8 @@ SedTask::isSetSimulationReference() const
 int
 SedTask::setModelReference(const std::string& modelReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(modelReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -183,6 +185,8 @@ SedTask::setModelReference(const std::string& modelReference)
 int
 SedTask::setSimulationReference(const std::string& simulationReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(simulationReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -201,6 +205,8 @@ SedTask::setSimulationReference(const std::string& simulationReference)
 int
 SedTask::unsetModelReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -220,6 +226,8 @@ SedTask::unsetModelReference()
 int
 SedTask::unsetSimulationReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mSimulationReference.erase();
 
   if (mSimulationReference.empty() == true)
@@ -310,7 +318,11 @@ SedTask::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream& stream)
 bool
 SedTask::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -0,0 +1,750 @@
+/**
+ * @file SedTaskExecutor.cpp
+ * @brief Implementation of the SedTaskExecutor class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedTaskExecutor.h>
+#include <sedml/SedSimulator.h>
+#include <sedml/SedTaskResult.h>
+#include <sedml/SedResultStore.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedRepeatedTaskIterator.h>
+#include <sedml/SedWorkStealingPool.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedSubTask.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <memory>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * The simulators used by one job: one for each combination of model and
+ * algorithm, so that subtasks using the same model share its state.  The
+ * set also provides the values that the math of repeated tasks refers to.
+ */
+class SedTaskExecutor::SimulatorSet : public SedValueProvider
+{
+public:
+
+  SimulatorSet (const SedTaskExecutor& executor)
+    : mExecutor(executor)
+    , mEntries()
+  {
+  }
+
+
+  virtual ~SimulatorSet ()
+  {
+    for (size_t i = 0; i < mEntries.size(); ++i)
+    {
+      delete mEntries[i].simulator;
+    }
+  }
+
+
+  SedSimulator* get (const SedModel* model, const SedSimulation* simulation,
+                     int& status)
+  {
+    const SedAlgorithm* algorithm = simulation->getAlgorithm();
+    string kisaoId = (algorithm != NULL) ? algorithm->getKisaoID() : "";
+
+    for (size_t i = 0; i < mEntries.size(); ++i)
+    {
+      if (mEntries[i].model == model && mEntries[i].kisaoId == kisaoId)
+      {
+        status = LIBSEDML_OPERATION_SUCCESS;
+        return mEntries[i].simulator;
+      }
+    }
+
+    SedSimulator* simulator = mExecutor.createSimulator(simulation);
+    if (simulator == NULL)
+    {
+      status = LIBSEDML_INVALID_OBJECT;
+      return NULL;
+    }
+
+    ModelMap::const_iterator it = mExecutor.mModels.find(model->getId());
+    status = simulator->loadModel(model,
+      (it != mExecutor.mModels.end()) ? it->second : NULL);
+    if (status != LIBSEDML_OPERATION_SUCCESS)
+    {
+      delete simulator;
+      return NULL;
+    }
+
+    Entry entry = { model, kisaoId, simulator };
+    mEntries.push_back(entry);
+    return simulator;
+  }
+
+
+  int setValue (const SedSetValue* change, double value)
+  {
+    int status = LIBSEDML_OPERATION_FAILED;
+
+    for (size_t i = 0; i < mEntries.size(); ++i)
+    {
+      if (mEntries[i].model->getId() != change->getModelReference()) continue;
+
+      status = mEntries[i].simulator->setValue(change, value);
+      if (status != LIBSEDML_OPERATION_SUCCESS) break;
+    }
+
+    return status;
+  }
+
+
+  virtual double getVariableValue (const SedVariable* variable)
+  {
+    const string& modelId = variable->getModelReference();
+
+    for (size_t i = 0; i < mEntries.size(); ++i)
+    {
+      if (modelId.empty() || mEntries[i].model->getId() == modelId)
+      {
+        return mEntries[i].simulator->getVariableValue(variable);
+      }
+    }
+
+    return numeric_limits<double>::quiet_NaN();
+  }
+
+
+  virtual bool getDataRangeValues (const SedDataRange* range,
+                                   std::vector<double>& values)
+  {
+    return (mExecutor.mDataProvider != NULL)
+      && mExecutor.mDataProvider->getDataRangeValues(range, values);
+  }
+
+
+private:
+
+  struct Entry
+  {
+    const SedModel* model;
+    std::string kisaoId;
+    SedSimulator* simulator;
+  };
+
+  const SedTaskExecutor& mExecutor;
+  std::vector<Entry> mEntries;
+};
+
+/** @endcond */
+
+
+SedTaskExecutor::SedTaskExecutor (const SedDocument* document)
+  : mDocument(document)
+  , mFactories()
+  , mNumThreads(0)
+  , mDataProvider(NULL)
+  , mResultStore(NULL)
+  , mIterationListener()
+  , mKeepIterations(true)
+  , mModelBuilder(document)
+  , mModels()
+  , mResults()
+  , mStatus()
+{
+}
+
+
+SedTaskExecutor::~SedTaskExecutor ()
+{
+  clearResults();
+}
+
+
+void
+SedTaskExecutor::registerSimulator (const std::string& kisaoId,
+                                    const SimulatorFactory& factory)
+{
+  mFactories[kisaoId] = factory;
+}
+
+
+bool
+SedTaskExecutor::hasSimulator (const std::string& kisaoId) const
+{
+  return mFactories.find(kisaoId) != mFactories.end()
+    || mFactories.find("") != mFactories.end();
+}
+
+
+void
+SedTaskExecutor::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+unsigned int
+SedTaskExecutor::getNumThreads () const
+{
+  return mNumThreads;
+}
+
+
+void
+SedTaskExecutor::setDataProvider (SedValueProvider* provider)
+{
+  mDataProvider = provider;
+}
+
+
+void
+SedTaskExecutor::setResultStore (SedResultStore* store)
+{
+  mResultStore = store;
+}
+
+
+SedResultStore*
+SedTaskExecutor::getResultStore () const
+{
+  return mResultStore;
+}
+
+
+void
+SedTaskExecutor::setIterationListener (const IterationListener& listener)
+{
+  mIterationListener = listener;
+}
+
+
+void
+SedTaskExecutor::setKeepIterations (bool keepIterations)
+{
+  mKeepIterations = keepIterations;
+}
+
+
+bool
+SedTaskExecutor::getKeepIterations () const
+{
+  return mKeepIterations;
+}
+
+
+SedModelBuilder&
+SedTaskExecutor::getModelBuilder ()
+{
+  return mModelBuilder;
+}
+
+
+int
+SedTaskExecutor::execute ()
+{
+  if (mDocument == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  vector<string> taskIds;
+  for (unsigned int i = 0; i < mDocument->getNumTasks(); ++i)
+  {
+    taskIds.push_back(mDocument->getTask(i)->getId());
+  }
+
+  return execute(taskIds);
+}
+
+
+int
+SedTaskExecutor::execute (const std::vector<std::string>& taskIds)
+{
+  if (mDocument == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  prepareDocument();
+
+  SedDependencyGraph graph;
+  mDocument->buildDependencyGraph(graph);
+
+  unsigned int numThreads = (mNumThreads > 0)
+    ? mNumThreads : SedWorkStealingPool::getDefaultNumThreads();
+
+  // the jobs of each stage of the graph only start once the previous
+  // stages are done
+  int result = LIBSEDML_OPERATION_SUCCESS;
+  vector< vector<Job> > stages(graph.getNumStages());
+  vector< pair<const SedAbstractTask*, SedTaskResult*> > tasks;
+  vector<int> statuses;
+
+  for (size_t i = 0; i < taskIds.size(); ++i)
+  {
+    const string& id = taskIds[i];
+    const SedAbstractTask* task = mDocument->getTask(id);
+    int node = graph.getNodeIndex(id);
+
+    if (task == NULL || node < 0 || graph.getNode(node) != task)
+    {
+      mStatus[id] = LIBSEDML_INVALID_OBJECT;
+      result = LIBSEDML_OPERATION_FAILED;
+      continue;
+    }
+
+    int stage = graph.getStageOf(node);
+    if (stage < 0)
+    {
+      // the task depends on itself
+      mStatus[id] = LIBSEDML_OPERATION_FAILED;
+      result = LIBSEDML_OPERATION_FAILED;
+      continue;
+    }
+
+    SedTaskResult* taskResult = new SedTaskResult();
+    taskResult->setTaskId(id);
+    tasks.push_back(make_pair(task, taskResult));
+    statuses.push_back(LIBSEDML_OPERATION_SUCCESS);
+
+    vector<Job>& jobs = stages[stage];
+    Job job = { task, taskResult, tasks.size() - 1, 0, UINT_MAX,
+                LIBSEDML_OPERATION_SUCCESS };
+
+    const SedRepeatedTask* repeated =
+      (task->getTypeCode() == SEDML_TASK_REPEATEDTASK)
+      ? static_cast<const SedRepeatedTask*>(task) : NULL;
+    if (repeated == NULL || !repeated->getResetModel())
+    {
+      jobs.push_back(job);
+      continue;
+    }
+
+    // iterations starting from the same state are split into chunks, so
+    // that each chunk loads its models only once
+    unsigned int numIterations =
+      SedRepeatedTaskIterator(repeated, mDataProvider).getNumIterations();
+    for (unsigned int n = 0; n < numIterations; ++n)
+    {
+      taskResult->createChild();
+    }
+
+    unsigned int numChunks = min(numIterations, 4 * numThreads);
+    for (unsigned int n = 0; n < numChunks; ++n)
+    {
+      job.first = (unsigned int)((unsigned long long)numIterations * n / numChunks);
+      job.count = (unsigned int)
+        ((unsigned long long)numIterations * (n + 1) / numChunks) - job.first;
+      jobs.push_back(job);
+    }
+  }
+
+  for (size_t s = 0; s < stages.size(); ++s)
+  {
+    vector<Job>& jobs = stages[s];
+    SedWorkStealingPool::run(jobs.size(), numThreads, [this, &jobs](size_t n)
+    {
+      try
+      {
+        jobs[n].status = runJob(jobs[n]);
+      }
+      catch (...)
+      {
+        jobs[n].status = LIBSEDML_OPERATION_FAILED;
+      }
+    });
+
+    // a task fails with the first of its jobs that fails
+    for (size_t n = 0; n < jobs.size(); ++n)
+    {
+      int& status = statuses[jobs[n].index];
+      if (status == LIBSEDML_OPERATION_SUCCESS) status = jobs[n].status;
+    }
+  }
+
+  for (size_t i = 0; i < tasks.size(); ++i)
+  {
+    const SedAbstractTask* task = tasks[i].first;
+    SedTaskResult* taskResult = tasks[i].second;
+    int status = statuses[i];
+
+    ResultMap::iterator it = mResults.find(task->getId());
+    if (it != mResults.end())
+    {
+      delete it->second;
+      mResults.erase(it);
+    }
+
+    mStatus[task->getId()] = status;
+    if (status != LIBSEDML_OPERATION_SUCCESS)
+    {
+      if (mResultStore != NULL) mResultStore->removeTask(task->getId());
+      delete taskResult;
+      result = LIBSEDML_OPERATION_FAILED;
+      continue;
+    }
+
+    if (task->getTypeCode() == SEDML_TASK_REPEATEDTASK)
+    {
+      concatenate(static_cast<const SedRepeatedTask*>(task), *taskResult);
+    }
+    mResults[task->getId()] = taskResult;
+
+    // variables whose columns are missing are left out of the store
+    if (mResultStore != NULL) mResultStore->addTaskResult(mDocument, *taskResult);
+  }
+
+  return result;
+}
+
+
+const SedTaskResult*
+SedTaskExecutor::getResult (const std::string& taskId) const
+{
+  ResultMap::const_iterator it = mResults.find(taskId);
+  return (it == mResults.end()) ? NULL : it->second;
+}
+
+
+int
+SedTaskExecutor::getStatus (const std::string& taskId) const
+{
+  StatusMap::const_iterator it = mStatus.find(taskId);
+  return (it == mStatus.end()) ? LIBSEDML_INVALID_OBJECT : it->second;
+}
+
+
+void
+SedTaskExecutor::clearResults ()
+{
+  for (ResultMap::iterator it = mResults.begin(); it != mResults.end(); ++it)
+  {
+    delete it->second;
+  }
+  mResults.clear();
+  mStatus.clear();
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Builds the models, and the id indexes of the lists that the jobs look
+ * up elements in, before the document is shared between threads.
+ */
+void
+SedTaskExecutor::prepareDocument ()
+{
+  mModels.clear();
+  for (unsigned int i = 0; i < mDocument->getNumModels(); ++i)
+  {
+    const string& id = mDocument->getModel(i)->getId();
+    mModels[id] = mModelBuilder.getModel(id);
+  }
+
+  if (mDocument->getNumSimulations() > 0)
+  {
+    mDocument->getSimulation(mDocument->getSimulation(0u)->getId());
+  }
+
+  if (mDocument->getNumTasks() > 0)
+  {
+    mDocument->getTask(mDocument->getTask(0u)->getId());
+  }
+}
+
+
+int
+SedTaskExecutor::runJob (Job& job) const
+{
+  SimulatorSet simulators(*this);
+
+  switch (job.task->getTypeCode())
+  {
+  case SEDML_TASK:
+    return executeTask(static_cast<const SedTask*>(job.task), simulators,
+                       *job.result);
+
+  case SEDML_TASK_REPEATEDTASK:
+  {
+    const SedRepeatedTask* task =
+      static_cast<const SedRepeatedTask*>(job.task);
+
+    // the simulators have to exist before the iterator asks for values
+    vector<SedSimulator*> used;
+    int status = prepare(task, simulators, used);
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+    SedRepeatedTaskIterator iterator(task, &simulators);
+    return executeIterations(iterator, task, job.first, job.count,
+                             simulators, *job.result, true);
+  }
+
+  default:
+    // parameter estimation tasks need an optimizer, not just a simulator
+    return LIBSEDML_OPERATION_FAILED;
+  }
+}
+
+
+/*
+ * Creates the simulators for the given task and all its subtasks, and
+ * collects them in @p used.
+ */
+int
+SedTaskExecutor::prepare (const SedAbstractTask* task,
+                          SimulatorSet& simulators,
+                          std::vector<SedSimulator*>& used) const
+{
+  if (task == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  if (task->getTypeCode() == SEDML_TASK)
+  {
+    const SedTask* simple = static_cast<const SedTask*>(task);
+    const SedModel* model = mDocument->getModel(simple->getModelReference());
+    const SedSimulation* simulation =
+      mDocument->getSimulation(simple->getSimulationReference());
+    if (model == NULL || simulation == NULL) return LIBSEDML_INVALID_OBJECT;
+
+    int status;
+    SedSimulator* simulator = simulators.get(model, simulation, status);
+    if (simulator == NULL) return status;
+
+    if (find(used.begin(), used.end(), simulator) == used.end())
+    {
+      used.push_back(simulator);
+    }
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  if (task->getTypeCode() != SEDML_TASK_REPEATEDTASK)
+  {
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  const SedRepeatedTask* repeated = static_cast<const SedRepeatedTask*>(task);
+  for (unsigned int i = 0; i < repeated->getNumSubTasks(); ++i)
+  {
+    int status = prepare(mDocument->getTask(repeated->getSubTask(i)->getTask()),
+                         simulators, used);
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedTaskExecutor::executeTask (const SedTask* task, SimulatorSet& simulators,
+                              SedTaskResult& result) const
+{
+  const SedModel* model = mDocument->getModel(task->getModelReference());
+  const SedSimulation* simulation =
+    mDocument->getSimulation(task->getSimulationReference());
+  if (model == NULL || simulation == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  int status;
+  SedSimulator* simulator = simulators.get(model, simulation, status);
+  if (simulator == NULL) return status;
+
+  return simulator->simulate(simulation, result);
+}
+
+
+/*
+ * Executes up to @p count iterations, starting with iteration @p first,
+ * into the children of @p result with the same index.  If @p notify is
+ * set, the iteration listener is called for each of them.
+ */
+int
+SedTaskExecutor::executeIterations (SedRepeatedTaskIterator& iterator,
+                                    const SedRepeatedTask* task,
+                                    unsigned int first, unsigned int count,
+                                    SimulatorSet& simulators,
+                                    SedTaskResult& result,
+                                    bool notify) const
+{
+  if (first > 0 && iterator.seek(first) != LIBSEDML_OPERATION_SUCCESS)
+  {
+    return LIBSEDML_INDEX_EXCEEDS_SIZE;
+  }
+
+  vector<SedSimulator*> used;
+  int status = prepare(task, simulators, used);
+  if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+  for (unsigned int i = 0; i < count && !iterator.isAtEnd(); ++i)
+  {
+    if (i > 0 && task->getResetModel())
+    {
+      for (size_t n = 0; n < used.size(); ++n)
+      {
+        status = used[n]->resetModel();
+        if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+      }
+    }
+
+    unsigned int index = iterator.getIndex();
+    while (result.getNumChildren() <= index) result.createChild();
+
+    SedTaskResult* iteration = result.getChild(index);
+    status = executeIteration(iterator, simulators, *iteration);
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+    if (notify && mIterationListener)
+    {
+      mIterationListener(task, index, *iteration);
+      if (!mKeepIterations) iteration->clear();
+    }
+
+    iterator.next();
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedTaskExecutor::executeIteration (SedRepeatedTaskIterator& iterator,
+                                   SimulatorSet& simulators,
+                                   SedTaskResult& result) const
+{
+  int status;
+
+  for (unsigned int i = 0; i < iterator.getNumChanges(); ++i)
+  {
+    status = simulators.setValue(iterator.getChange(i),
+                                 iterator.getChangeValue(i));
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+  }
+
+  for (unsigned int i = 0; i < iterator.getNumSubTasks(); ++i)
+  {
+    const SedSubTask* subTask = iterator.getSubTask(i);
+    const SedAbstractTask* task = iterator.getSubTaskTask(i);
+    if (task == NULL) return LIBSEDML_INVALID_OBJECT;
+
+    for (unsigned int n = 0; n < subTask->getNumTaskChanges(); ++n)
+    {
+      const SedSetValue* change = subTask->getTaskChange(n);
+      status = simulators.setValue(change, iterator.evaluateChange(change));
+      if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+    }
+
+    SedTaskResult* child = result.createChild();
+    child->setTaskId(task->getId());
+
+    if (task->getTypeCode() == SEDML_TASK)
+    {
+      status = executeTask(static_cast<const SedTask*>(task), simulators,
+                           *child);
+    }
+    else if (task->getTypeCode() == SEDML_TASK_REPEATEDTASK)
+    {
+      const SedRepeatedTask* repeated =
+        static_cast<const SedRepeatedTask*>(task);
+      unique_ptr<SedRepeatedTaskIterator> nested(
+        iterator.createSubTaskIterator(i));
+
+      status = executeIterations(*nested, repeated, 0, UINT_MAX, simulators,
+                                 *child, false);
+      if (status == LIBSEDML_OPERATION_SUCCESS) concatenate(repeated, *child);
+    }
+    else
+    {
+      status = LIBSEDML_OPERATION_FAILED;
+    }
+
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns a new simulator for the algorithm of the given simulation, or
+ * NULL if none has been registered.
+ */
+SedSimulator*
+SedTaskExecutor::createSimulator (const SedSimulation* simulation) const
+{
+  const SedAlgorithm* algorithm = simulation->getAlgorithm();
+
+  FactoryMap::const_iterator it = mFactories.end();
+  if (algorithm != NULL) it = mFactories.find(algorithm->getKisaoID());
+  if (it == mFactories.end()) it = mFactories.find("");
+
+  return (it == mFactories.end()) ? NULL : it->second();
+}
+
+
+/*
+ * Appends the results of all subtasks of all iterations to the columns of
+ * the given result, if the task concatenates them.
+ */
+void
+SedTaskExecutor::concatenate (const SedRepeatedTask* task,
+                              SedTaskResult& result)
+{
+  if (!task->getConcatenate()) return;
+
+  for (unsigned int i = 0; i < result.getNumChildren(); ++i)
+  {
+    const SedTaskResult* iteration = result.getChild(i);
+    for (unsigned int n = 0; n < iteration->getNumChildren(); ++n)
+    {
+      result.append(*iteration->getChild(n));
+    }
+  }
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,368 @@
+/**
+ * @file SedTaskExecutor.h
+ * @brief Definition of the SedTaskExecutor class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedTaskExecutor
+ * @sbmlbrief{} Executes the tasks of a SED-ML document on several threads.
+ *
+ * A SedTaskExecutor runs the tasks and repeated tasks of a SedDocument
+ * with simulators that are plugged in through factories, one for each
+ * KiSAO id of the algorithms they implement.  Models are built once by a
+ * SedModelBuilder and passed to every simulator that needs them.
+ *
+ * Tasks are executed in the stages of the SedDependencyGraph of the
+ * document: the tasks of a stage, which do not depend on each other, are
+ * executed concurrently on a work-stealing thread pool, and a stage starts
+ * once the previous one is done.  The iterations of a repeated task whose
+ * "resetModel" attribute is @c true start from the same state, so they
+ * are distributed over the threads as well, each thread using simulators
+ * of its own; the iterations of other repeated tasks build on each other
+ * and are executed in order.  Within an iteration, the task changes are
+ * applied and the subtasks are executed in order, with subtasks that use
+ * the same model and algorithm sharing one simulator.  Tasks that depend
+ * on themselves (see SedDependencyGraph) are not executed.
+ *
+ * The results of each task are kept as a SedTaskResult.  If a
+ * SedResultStore has been set, the values that the variables of the
+ * document refer to are also copied into it, for evaluating the data
+ * generators.
+ *
+ * An iteration listener is told about each iteration of a repeated task
+ * as soon as it has finished, for example to write its results out with a
+ * SedReportExporter.  Iterations that are distributed over threads finish
+ * in no particular order, and the listener is called from the thread that
+ * executed the iteration.  If the iterations are not kept (see
+ * setKeepIterations()), their results are discarded once the listener has
+ * seen them, so that the memory used does not grow with the number of
+ * iterations.
+ *
+ * @code{.cpp}
+SedTaskExecutor executor(doc);
+executor.registerSimulator("KISAO:0000019", createCvodeSimulator);
+executor.getModelBuilder().setBaseDirectory("/path/to/archive");
+
+if (executor.execute() == LIBSEDML_OPERATION_SUCCESS)
+{
+  const SedTaskResult* result = executor.getResult("task1");
+  // ...
+}
+ * @endcode
+ */
+
+
+#ifndef SedTaskExecutor_h
+#define SedTaskExecutor_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedModelBuilder.h>
+#include <sbml/common/libsbml-namespace.h>
+
+
+#ifdef __cplusplus
+
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+class XMLNode;
+LIBSBML_CPP_NAMESPACE_END
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedAbstractTask;
+class SedTask;
+class SedRepeatedTask;
+class SedRepeatedTaskIterator;
+class SedSimulation;
+class SedSimulator;
+class SedTaskResult;
+class SedValueProvider;
+class SedResultStore;
+
+
+class LIBSEDML_EXTERN SedTaskExecutor
+{
+public:
+
+  /**
+   * Creates a new simulator, owned by the caller.  Factories may be called
+   * from several threads at once.
+   */
+  typedef std::function<SedSimulator* ()> SimulatorFactory;
+
+
+  /**
+   * Receives the result of an iteration of a repeated task that is
+   * executed by execute(), along with the index of the iteration.  It is
+   * not called for the iterations of nested repeated tasks, which are part
+   * of the result of the iteration of the enclosing task.  Listeners may
+   * be called from several threads at once.
+   */
+  typedef std::function<void (const SedRepeatedTask* task,
+                              unsigned int index,
+                              const SedTaskResult& iteration)>
+    IterationListener;
+
+
+  /**
+   * Creates a new SedTaskExecutor for the tasks of the given document.
+   *
+   * @param document the SED-ML document; it has to outlive this executor
+   * and must not be modified while tasks are executed.
+   */
+  explicit SedTaskExecutor (const SedDocument* document);
+
+
+  /**
+   * Destroys this SedTaskExecutor, along with all results.
+   */
+  ~SedTaskExecutor ();
+
+
+  /**
+   * Registers the simulator used for the given algorithm.
+   *
+   * @param kisaoId the KiSAO id of the algorithm, such as
+   * <code>KISAO:0000019</code>, or an empty string for the simulator used
+   * for all algorithms without a simulator of their own.
+   * @param factory the function creating the simulators.
+   */
+  void registerSimulator (const std::string& kisaoId,
+                          const SimulatorFactory& factory);
+
+
+  /**
+   * @return @c true if simulations with the given algorithm can be run,
+   * either by a simulator registered for it, or by the default simulator.
+   */
+  bool hasSimulator (const std::string& kisaoId) const;
+
+
+  /**
+   * Sets the number of threads used for executing tasks.
+   *
+   * @param numThreads the number of threads, or 0 to use as many threads
+   * as the hardware can run concurrently.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads used for executing tasks, or 0.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Sets the provider asked for the values of data ranges.
+   *
+   * @param provider the provider, which must be safe to call from several
+   * threads at once; or @c NULL.
+   */
+  void setDataProvider (SedValueProvider* provider);
+
+
+  /**
+   * Sets the store that the values of the variables of the document are
+   * copied to, whenever a task has been executed successfully.  The series
+   * of a task that fails are removed from the store.
+   *
+   * @param store the store, which must outlive this executor; or @c NULL.
+   */
+  void setResultStore (SedResultStore* store);
+
+
+  /**
+   * @return the store that results are copied to, or @c NULL.
+   */
+  SedResultStore* getResultStore () const;
+
+
+  /**
+   * Sets the listener that is called whenever an iteration of a repeated
+   * task has finished.
+   *
+   * @param listener the listener, or an empty function to remove it.
+   */
+  void setIterationListener (const IterationListener& listener);
+
+
+  /**
+   * Sets whether the results of iterations are kept once the iteration
+   * listener has been called; the default is @c true.  If they are not,
+   * the result of a repeated task holds no values when a listener is set.
+   *
+   * @param keepIterations @c false to discard the results of iterations.
+   */
+  void setKeepIterations (bool keepIterations);
+
+
+  /**
+   * @return @c true if the results of iterations are kept once the
+   * iteration listener has been called.
+   */
+  bool getKeepIterations () const;
+
+
+  /**
+   * @return the model builder used for building the models of the tasks,
+   * for instance to set its base directory.
+   */
+  SedModelBuilder& getModelBuilder ();
+
+
+  /**
+   * Executes all tasks of the document.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if any of the tasks failed; see getStatus().
+   */
+  int execute ();
+
+
+  /**
+   * Executes the tasks with the given ids, for instance those affected by
+   * a change of the document.  The results of other tasks are kept.
+   *
+   * @param taskIds the ids of the tasks to execute.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if any of the tasks failed; see getStatus().
+   */
+  int execute (const std::vector<std::string>& taskIds);
+
+
+  /**
+   * @return the result of the task with the given id, or @c NULL if it
+   * has not been executed successfully.
+   */
+  const SedTaskResult* getResult (const std::string& taskId) const;
+
+
+  /**
+   * Returns how the last execution of the task with the given id ended.
+   *
+   * @param taskId the id of the task.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_OBJECT, OperationReturnValues_t}
+   * if the task does not exist, has not been executed, or lacks a model,
+   * simulation or simulator.
+   * @li @sedmlconstant{LIBSEDML_OPERATION_FAILED, OperationReturnValues_t}
+   * if the task depends on itself, is a parameter estimation task, or a
+   * simulator failed.
+   */
+  int getStatus (const std::string& taskId) const;
+
+
+  /**
+   * Discards all results.
+   */
+  void clearResults ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  class SimulatorSet;
+
+  struct Job
+  {
+    const SedAbstractTask* task;
+    SedTaskResult* result;
+    size_t index;
+    unsigned int first;
+    unsigned int count;
+    int status;
+  };
+
+  typedef std::unordered_map<std::string, SimulatorFactory> FactoryMap;
+  typedef std::unordered_map<std::string,
+    const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode*> ModelMap;
+  typedef std::unordered_map<std::string, SedTaskResult*> ResultMap;
+  typedef std::unordered_map<std::string, int> StatusMap;
+
+  SedTaskExecutor (const SedTaskExecutor& orig);
+  SedTaskExecutor& operator= (const SedTaskExecutor& rhs);
+
+  void prepareDocument ();
+  int runJob (Job& job) const;
+  int prepare (const SedAbstractTask* task, SimulatorSet& simulators,
+               std::vector<SedSimulator*>& used) const;
+  int executeTask (const SedTask* task, SimulatorSet& simulators,
+                   SedTaskResult& result) const;
+  int executeIterations (SedRepeatedTaskIterator& iterator,
+                         const SedRepeatedTask* task, unsigned int first,
+                         unsigned int count, SimulatorSet& simulators,
+                         SedTaskResult& result, bool notify) const;
+  int executeIteration (SedRepeatedTaskIterator& iterator,
+                        SimulatorSet& simulators,
+                        SedTaskResult& result) const;
+  SedSimulator* createSimulator (const SedSimulation* simulation) const;
+  static void concatenate (const SedRepeatedTask* task, SedTaskResult& result);
+
+  const SedDocument* mDocument;
+  FactoryMap mFactories;
+  unsigned int mNumThreads;
+  SedValueProvider* mDataProvider;
+  SedResultStore* mResultStore;
+  IterationListener mIterationListener;
+  bool mKeepIterations;
+  SedModelBuilder mModelBuilder;
+  ModelMap mModels;
+  ResultMap mResults;
+  StatusMap mStatus;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedTaskExecutor_h */
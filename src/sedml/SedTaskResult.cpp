@@ -0,0 +1,237 @@
+/**
+ * @file SedTaskResult.cpp
+ * @brief Implementation of the SedTaskResult class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedTaskResult.h>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+SedTaskResult::SedTaskResult ()
+  : mTaskId()
+  , mNames()
+  , mColumns()
+  , mIndex()
+  , mChildren()
+{
+}
+
+
+SedTaskResult::SedTaskResult (const SedTaskResult& orig)
+  : mTaskId(orig.mTaskId)
+  , mNames(orig.mNames)
+  , mColumns(orig.mColumns)
+  , mIndex(orig.mIndex)
+  , mChildren()
+{
+  for (size_t i = 0; i < orig.mChildren.size(); ++i)
+  {
+    mChildren.push_back(new SedTaskResult(*orig.mChildren[i]));
+  }
+}
+
+
+SedTaskResult&
+SedTaskResult::operator= (const SedTaskResult& rhs)
+{
+  if (&rhs != this)
+  {
+    clear();
+    mTaskId = rhs.mTaskId;
+    mNames = rhs.mNames;
+    mColumns = rhs.mColumns;
+    mIndex = rhs.mIndex;
+
+    for (size_t i = 0; i < rhs.mChildren.size(); ++i)
+    {
+      mChildren.push_back(new SedTaskResult(*rhs.mChildren[i]));
+    }
+  }
+
+  return *this;
+}
+
+
+SedTaskResult::~SedTaskResult ()
+{
+  clear();
+}
+
+
+const std::string&
+SedTaskResult::getTaskId () const
+{
+  return mTaskId;
+}
+
+
+void
+SedTaskResult::setTaskId (const std::string& taskId)
+{
+  mTaskId = taskId;
+}
+
+
+unsigned int
+SedTaskResult::getNumColumns () const
+{
+  return (unsigned int)mColumns.size();
+}
+
+
+const std::string&
+SedTaskResult::getColumnName (unsigned int n) const
+{
+  static const string empty;
+  return (n < mNames.size()) ? mNames[n] : empty;
+}
+
+
+const std::vector<double>&
+SedTaskResult::getColumn (unsigned int n) const
+{
+  static const vector<double> empty;
+  return (n < mColumns.size()) ? mColumns[n] : empty;
+}
+
+
+const std::vector<double>*
+SedTaskResult::getColumn (const std::string& name) const
+{
+  IndexMap::const_iterator it = mIndex.find(name);
+  return (it == mIndex.end()) ? NULL : &mColumns[it->second];
+}
+
+
+std::vector<double>&
+SedTaskResult::addColumn (const std::string& name)
+{
+  IndexMap::const_iterator it = mIndex.find(name);
+  if (it != mIndex.end()) return mColumns[it->second];
+
+  mIndex[name] = (unsigned int)mColumns.size();
+  mNames.push_back(name);
+  mColumns.push_back(vector<double>());
+  return mColumns.back();
+}
+
+
+size_t
+SedTaskResult::getNumPoints () const
+{
+  size_t numPoints = 0;
+  for (size_t i = 0; i < mColumns.size(); ++i)
+  {
+    if (mColumns[i].size() > numPoints) numPoints = mColumns[i].size();
+  }
+  return numPoints;
+}
+
+
+void
+SedTaskResult::append (const SedTaskResult& other)
+{
+  for (size_t i = 0; i < other.mColumns.size(); ++i)
+  {
+    const vector<double>& values = other.mColumns[i];
+    vector<double>& column = addColumn(other.mNames[i]);
+    column.insert(column.end(), values.begin(), values.end());
+  }
+}
+
+
+unsigned int
+SedTaskResult::getNumChildren () const
+{
+  return (unsigned int)mChildren.size();
+}
+
+
+const SedTaskResult*
+SedTaskResult::getChild (unsigned int n) const
+{
+  return (n < mChildren.size()) ? mChildren[n] : NULL;
+}
+
+
+SedTaskResult*
+SedTaskResult::getChild (unsigned int n)
+{
+  return (n < mChildren.size()) ? mChildren[n] : NULL;
+}
+
+
+SedTaskResult*
+SedTaskResult::createChild ()
+{
+  mChildren.push_back(new SedTaskResult());
+  return mChildren.back();
+}
+
+
+void
+SedTaskResult::clear ()
+{
+  mNames.clear();
+  mColumns.clear();
+  mIndex.clear();
+
+  for (size_t i = 0; i < mChildren.size(); ++i)
+  {
+    delete mChildren[i];
+  }
+  mChildren.clear();
+}
+
+
+void
+SedTaskResult::clearValues ()
+{
+  for (size_t i = 0; i < mColumns.size(); ++i)
+  {
+    mColumns[i].clear();
+  }
+}
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
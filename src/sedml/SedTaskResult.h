@@ -0,0 +1,220 @@
+/**
+ * @file SedTaskResult.h
+ * @brief Definition of the SedTaskResult class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedTaskResult
+ * @sbmlbrief{} The results of executing a task.
+ *
+ * A SedTaskResult holds named columns of values, as written by a
+ * SedSimulator: typically one column for the time and one for each model
+ * quantity.  The result of a repeated task has a child result for each of
+ * its iterations, which in turn has a child result for each subtask
+ * executed in that iteration.  If the "concatenate" attribute of the
+ * repeated task is @c true, the columns of the repeated task additionally
+ * hold the columns of all subtask results, appended one after the other.
+ */
+
+
+#ifndef SedTaskResult_h
+#define SedTaskResult_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedTaskResult
+{
+public:
+
+  /**
+   * Creates a new, empty SedTaskResult.
+   */
+  SedTaskResult ();
+
+
+  /**
+   * Copy constructor; creates a deep copy of the given result.
+   */
+  SedTaskResult (const SedTaskResult& orig);
+
+
+  /**
+   * Assignment operator; replaces this result by a deep copy of the given
+   * one.
+   */
+  SedTaskResult& operator= (const SedTaskResult& rhs);
+
+
+  /**
+   * Destroys this SedTaskResult and its children.
+   */
+  ~SedTaskResult ();
+
+
+  /**
+   * @return the id of the task this result belongs to.
+   */
+  const std::string& getTaskId () const;
+
+
+  /**
+   * Sets the id of the task this result belongs to.
+   */
+  void setTaskId (const std::string& taskId);
+
+
+  /**
+   * @return the number of columns of this result.
+   */
+  unsigned int getNumColumns () const;
+
+
+  /**
+   * @return the name of the nth column, or an empty string.
+   */
+  const std::string& getColumnName (unsigned int n) const;
+
+
+  /**
+   * @return the values of the nth column; empty if @p n is out of range.
+   */
+  const std::vector<double>& getColumn (unsigned int n) const;
+
+
+  /**
+   * @return the values of the column with the given name, or @c NULL if
+   * there is no such column.
+   */
+  const std::vector<double>* getColumn (const std::string& name) const;
+
+
+  /**
+   * Returns the column with the given name, adding an empty column if
+   * there is none.  Simulators append their values to it.
+   *
+   * @param name the name of the column.
+   *
+   * @return the values of the column.
+   */
+  std::vector<double>& addColumn (const std::string& name);
+
+
+  /**
+   * @return the number of values of the longest column.
+   */
+  size_t getNumPoints () const;
+
+
+  /**
+   * Appends the columns of the given result to the columns with the same
+   * names, adding columns as needed.  Columns that @p other lacks are
+   * left unchanged.
+   *
+   * @param other the result whose columns are appended.
+   */
+  void append (const SedTaskResult& other);
+
+
+  /**
+   * @return the number of child results (iterations of a repeated task,
+   * or subtasks of an iteration).
+   */
+  unsigned int getNumChildren () const;
+
+
+  /**
+   * @return the nth child result, or @c NULL if @p n is out of range.
+   */
+  const SedTaskResult* getChild (unsigned int n) const;
+
+
+  /**
+   * @return the nth child result, or @c NULL if @p n is out of range.
+   */
+  SedTaskResult* getChild (unsigned int n);
+
+
+  /**
+   * Adds a new, empty child result.
+   *
+   * @return the child, owned by this result.
+   */
+  SedTaskResult* createChild ();
+
+
+  /**
+   * Removes all columns and children.
+   */
+  void clear ();
+
+
+  /**
+   * Empties all columns, keeping the columns and their memory, so that
+   * the result can be filled again without allocating.  Children are
+   * left unchanged.
+   */
+  void clearValues ();
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  typedef std::unordered_map<std::string, unsigned int> IndexMap;
+
+  std::string mTaskId;
+  std::vector<std::string> mNames;
+  std::vector< std::vector<double> > mColumns;
+  IndexMap mIndex;
+  std::vector<SedTaskResult*> mChildren;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedTaskResult_h */
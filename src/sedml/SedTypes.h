@@ -105,7 +105,30 @@
 #include <sedml/SedParameterEstimationReport.h>
 
 #include <sedml/SedReader.h>
+#include <sedml/SedReaderHandler.h>
+#include <sedml/SedValueProvider.h>
+#include <sedml/SedRepeatedTaskIterator.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedXPathSelector.h>
+#include <sedml/SedModelBuilder.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedTaskResult.h>
+#include <sedml/SedSimulator.h>
+#include <sedml/SedMockSimulator.h>
+#include <sedml/SedTaskExecutor.h>
+#include <sedml/SedDataTable.h>
+#include <sedml/SedDataLoader.h>
+#include <sedml/SedResultSeries.h>
+#include <sedml/SedResultStore.h>
+#include <sedml/SedReportWriter.h>
+#include <sedml/SedReportExporter.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedValidator.h>
+#include <sedml/SedObjectiveEvaluator.h>
+#include <sedml/SedOptimizer.h>
+#include <sedml/SedPatternSearchOptimizer.h>
+#include <sedml/SedParameterEstimator.h>
 
 #include <sbml/math/FormulaFormatter.h>  
 
@@ -69,7 +69,7 @@ SedUniformRange::SedUniformRange(unsigned int level, unsigned int version)
  * Creates a new SedUniformRange using the given SedNamespaces object @p
  * sedmlns.
  */
-SedUniformRange::SedUniformRange(SedNamespaces *sedmlns)
+SedUniformRange::SedUniformRange(const SedNamespaces *sedmlns)
   : SedRange(sedmlns)
   , mStart (util_NaN())
   , mIsSetStart (false)
@@ -481,7 +481,11 @@ SedUniformRange::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedUniformRange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -71,7 +71,7 @@ SedUniformTimeCourse::SedUniformTimeCourse(unsigned int level,
  * Creates a new SedUniformTimeCourse using the given SedNamespaces object @p
  * sedmlns.
  */
-SedUniformTimeCourse::SedUniformTimeCourse(SedNamespaces *sedmlns)
+SedUniformTimeCourse::SedUniformTimeCourse(const SedNamespaces *sedmlns)
   : SedSimulation(sedmlns)
   , mInitialTime (util_NaN())
   , mIsSetInitialTime (false)
@@ -497,7 +497,11 @@ SedUniformTimeCourse::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedUniformTimeCourse::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
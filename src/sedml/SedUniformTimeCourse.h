@@ -100,7 +100,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedUniformTimeCourse(SedNamespaces *sedmlns);
+  SedUniformTimeCourse(const SedNamespaces *sedmlns);
 
 
   /**
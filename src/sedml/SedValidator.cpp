@@ -0,0 +1,1360 @@
+/**
+ * @file SedValidator.cpp
+ * @brief Implementation of the SedValidator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedValidator.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedWorkStealingPool.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedSubTask.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedFunctionalRange.h>
+#include <sedml/SedDataRange.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedShadedArea.h>
+#include <sedml/SedSurface.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedSubPlot.h>
+#include <sedml/SedAxis.h>
+#include <sedml/SedStyle.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedParameterEstimationTask.h>
+#include <sedml/SedAdjustableParameter.h>
+#include <sedml/SedExperimentReference.h>
+#include <sedml/SedFitMapping.h>
+#include <sedml/SedParameterEstimationReport.h>
+#include <sedml/SedParameterEstimationResultPlot.h>
+#include <sedml/SedWaterfallPlot.h>
+
+#include <algorithm>
+#include <chrono>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Number of elements each job of checkAll() checks: large enough for the
+ * hand-off of a job to the pool to be negligible, small enough for the
+ * jobs of a large document to keep all threads busy.
+ */
+static const size_t SED_VALIDATOR_CHUNK_SIZE = 2048;
+
+/*
+ * The rule groups, in the order in which the failures of an element are
+ * reported.
+ */
+static const unsigned int SED_RULE_GROUPS[] =
+{
+  SedValidator::RULES_IDENTIFIERS
+, SedValidator::RULES_REFERENCES
+, SedValidator::RULES_CARDINALITY
+, SedValidator::RULES_STYLES
+};
+
+static const size_t SED_NUM_RULE_GROUPS =
+  sizeof(SED_RULE_GROUPS) / sizeof(SED_RULE_GROUPS[0]);
+
+
+static bool
+isModel (int typeCode)
+{
+  return typeCode == SEDML_MODEL;
+}
+
+
+static bool
+isSimulation (int typeCode)
+{
+  return typeCode == SEDML_SIMULATION_UNIFORMTIMECOURSE
+    || typeCode == SEDML_SIMULATION_ONESTEP
+    || typeCode == SEDML_SIMULATION_STEADYSTATE
+    || typeCode == SEDML_SIMULATION_ANALYSIS;
+}
+
+
+static bool
+isAbstractTask (int typeCode)
+{
+  return typeCode == SEDML_TASK
+    || typeCode == SEDML_TASK_REPEATEDTASK
+    || typeCode == SEDML_TASK_PARAMETER_ESTIMATION;
+}
+
+
+static bool
+isParameterEstimationTask (int typeCode)
+{
+  return typeCode == SEDML_TASK_PARAMETER_ESTIMATION;
+}
+
+
+static bool
+isDataGenerator (int typeCode)
+{
+  return typeCode == SEDML_DATAGENERATOR;
+}
+
+
+static bool
+isDataSource (int typeCode)
+{
+  return typeCode == SEDML_DATA_SOURCE;
+}
+
+
+/*
+ * Fit mappings may refer to experimental data through either.
+ */
+static bool
+isDataSourceOrGenerator (int typeCode)
+{
+  return typeCode == SEDML_DATA_SOURCE || typeCode == SEDML_DATAGENERATOR;
+}
+
+
+static bool
+isPlot (int typeCode)
+{
+  return typeCode == SEDML_OUTPUT_PLOT2D
+    || typeCode == SEDML_OUTPUT_PLOT3D
+    || typeCode == SEDML_PARAMETERESTIMATIONRESULTPLOT
+    || typeCode == SEDML_WATERFALLPLOT;
+}
+
+
+static bool
+isStyle (int typeCode)
+{
+  return typeCode == SEDML_STYLE;
+}
+
+
+static bool
+isFitExperiment (int typeCode)
+{
+  return typeCode == SEDML_FIT_EXPERIMENT;
+}
+
+
+typedef chrono::steady_clock Clock;
+
+
+static double
+secondsSince (Clock::time_point start)
+{
+  return chrono::duration<double>(Clock::now() - start).count();
+}
+
+
+static string
+describe (const SedBase* element)
+{
+  string description = "<" + element->getElementName() + ">";
+  if (element->isSetId())
+  {
+    description += " '" + element->getId() + "'";
+  }
+  return description;
+}
+
+/** @endcond */
+
+
+SedValidator::SedValidator ()
+  : mRuleGroups(RULES_ALL)
+  , mNumThreads(0)
+  , mLevel(SEDML_DEFAULT_LEVEL)
+  , mVersion(SEDML_DEFAULT_VERSION)
+  , mKeepState(false)
+  , mDocument(NULL)
+  , mStateRuleGroups(0)
+  , mElements()
+  , mDuplicateOf()
+  , mIds()
+  , mDuplicates()
+  , mIndexOf()
+  , mReferrers()
+  , mRetained()
+  , mFailures()
+  , mWasIncremental(false)
+  , mNumChecked(0)
+  , mIndexTime(0)
+  , mCheckTime(0)
+  , mTotalTime(0)
+{
+}
+
+
+SedValidator::~SedValidator ()
+{
+}
+
+
+void
+SedValidator::setRuleGroups (unsigned int ruleGroups)
+{
+  mRuleGroups = ruleGroups & RULES_ALL;
+}
+
+
+unsigned int
+SedValidator::getRuleGroups () const
+{
+  return mRuleGroups;
+}
+
+
+void
+SedValidator::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+unsigned int
+SedValidator::getNumThreads () const
+{
+  return mNumThreads;
+}
+
+
+unsigned int
+SedValidator::validate (const SedDocument* document)
+{
+  Clock::time_point start = Clock::now();
+
+  reset();
+  mWasIncremental = false;
+  mNumChecked = 0;
+  mIndexTime = 0;
+  mCheckTime = 0;
+
+  if (document != NULL)
+  {
+    mLevel = document->getLevel();
+    mVersion = document->getVersion();
+    checkAll(document);
+  }
+
+  collectFailures();
+  reset();
+
+  mTotalTime = secondsSince(start);
+  return (unsigned int)mFailures.size();
+}
+
+
+unsigned int
+SedValidator::getNumFailures () const
+{
+  return (unsigned int)mFailures.size();
+}
+
+
+const SedError*
+SedValidator::getFailure (unsigned int n) const
+{
+  return (n < mFailures.size()) ? &mFailures[n] : NULL;
+}
+
+
+const std::vector<SedError>&
+SedValidator::getFailures () const
+{
+  return mFailures;
+}
+
+
+unsigned int
+SedValidator::revalidate (SedDocument* document)
+{
+  Clock::time_point start = Clock::now();
+
+  mWasIncremental = false;
+  mNumChecked = 0;
+  mIndexTime = 0;
+  mCheckTime = 0;
+
+  if (document == NULL)
+  {
+    reset();
+  }
+  else if (document != mDocument || !document->getTrackChanges()
+           || mStateRuleGroups != mRuleGroups)
+  {
+    // start over, with the document recording its changes from now on
+    reset();
+    document->setTrackChanges(true);
+    mKeepState = true;
+    mDocument = document;
+    mStateRuleGroups = mRuleGroups;
+    mLevel = document->getLevel();
+    mVersion = document->getVersion();
+
+    checkAll(document);
+
+    for (size_t i = 0; i < mElements.size(); ++i)
+    {
+      const_cast<SedBase*>(mElements[i])->clearChanges();
+    }
+  }
+  else
+  {
+    checkChanges(document);
+    mWasIncremental = true;
+  }
+
+  if (document != NULL)
+  {
+    // collecting the elements reads lazily read lists, which the document
+    // records as added
+    std::vector<SedBase*> elements;
+    std::vector<std::string> oldIds;
+    document->takeChanges(elements, oldIds);
+  }
+
+  collectFailures();
+
+  mTotalTime = secondsSince(start);
+  return (unsigned int)mFailures.size();
+}
+
+
+bool
+SedValidator::wasIncremental () const
+{
+  return mWasIncremental;
+}
+
+
+unsigned int
+SedValidator::getNumCheckedElements () const
+{
+  return mNumChecked;
+}
+
+
+double
+SedValidator::getIndexTime () const
+{
+  return mIndexTime;
+}
+
+
+double
+SedValidator::getCheckTime () const
+{
+  return mCheckTime;
+}
+
+
+double
+SedValidator::getTotalTime () const
+{
+  return mTotalTime;
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * Forgets the state kept for revalidate().
+ */
+void
+SedValidator::reset ()
+{
+  mKeepState = false;
+  mDocument = NULL;
+  mStateRuleGroups = 0;
+  mElements.clear();
+  mDuplicateOf.clear();
+  mIds.clear();
+  mDuplicates.clear();
+  mIndexOf.clear();
+  mReferrers.clear();
+  mRetained.clear();
+}
+
+
+/*
+ * Checks all elements of the document, with a job for every enabled rule
+ * group and chunk of elements.
+ */
+void
+SedValidator::checkAll (const SedDocument* document)
+{
+  Clock::time_point start = Clock::now();
+  indexElements(document);
+  mIndexTime = secondsSince(start);
+
+  start = Clock::now();
+
+  vector<unsigned int> groups;
+  for (size_t g = 0; g < SED_NUM_RULE_GROUPS; ++g)
+  {
+    if ((mRuleGroups & SED_RULE_GROUPS[g]) != 0)
+    {
+      groups.push_back(SED_RULE_GROUPS[g]);
+    }
+  }
+
+  size_t numChunks = (mElements.size() + SED_VALIDATOR_CHUNK_SIZE - 1)
+    / SED_VALIDATOR_CHUNK_SIZE;
+  size_t numJobs = numChunks * groups.size();
+  vector<Results> results(numJobs);
+
+  SedWorkStealingPool::run(numJobs, mNumThreads, [&](size_t job)
+  {
+    size_t begin = (job / groups.size()) * SED_VALIDATOR_CHUNK_SIZE;
+    size_t end = min(begin + SED_VALIDATOR_CHUNK_SIZE, mElements.size());
+    checkGroup(groups[job % groups.size()], begin, end, results[job]);
+  });
+
+  mRetained.clear();
+  for (size_t job = 0; job < numJobs; ++job)
+  {
+    mRetained.insert(mRetained.end(), results[job].failures.begin(),
+                     results[job].failures.end());
+    if (mKeepState) addReferrers(results[job], false);
+  }
+
+  // the failures of one element stay in the order of the rule groups
+  stable_sort(mRetained.begin(), mRetained.end(), precedes);
+
+  mNumChecked = (unsigned int)mElements.size();
+  mCheckTime = secondsSince(start);
+}
+
+
+/*
+ * Checks the rules affected by the changes the document recorded.  Every
+ * element that is checked again gets a bit for each rule group to check
+ * in the dirty map; its earlier failures in these groups are replaced.
+ */
+void
+SedValidator::checkChanges (SedDocument* document)
+{
+  Clock::time_point start = Clock::now();
+
+  vector<SedBase*> changed;
+  vector<string> oldIds;
+  bool structureChanged = document->takeChanges(changed, oldIds);
+
+  DirtyMap dirty;
+  IdSet ids(oldIds.begin(), oldIds.end());
+
+  if (structureChanged)
+  {
+    reindexElements(document, ids, dirty);
+
+    // new elements are not known to the document yet, but carry their mark
+    for (size_t i = 0; i < mElements.size(); ++i)
+    {
+      if (mElements[i]->hasChanges())
+      {
+        changed.push_back(const_cast<SedBase*>(mElements[i]));
+      }
+    }
+  }
+
+  DuplicateMap renamed;
+  for (vector<SedBase*>::const_iterator it = changed.begin();
+       it != changed.end(); ++it)
+  {
+    SedBase* element = *it;
+    unsigned int changes = element->getChanges();
+    element->clearChanges();
+
+    IndexMap::const_iterator found = mIndexOf.find(element);
+    if (found == mIndexOf.end() || changes == 0) continue;
+
+    unsigned int groups = 0;
+    if ((changes & (SedBase::CHANGE_STRUCTURE | SedBase::CHANGE_ID)) != 0)
+    {
+      // the failures of a renamed element all mention its id
+      groups |= RULES_ALL;
+      if (element->isSetId())
+      {
+        ids.insert(element->getId());
+        renamed.insert(DuplicateMap::value_type(element->getId(), element));
+      }
+    }
+    if ((changes & SedBase::CHANGE_REFERENCES) != 0)
+    {
+      groups |= RULES_REFERENCES | RULES_STYLES;
+    }
+    if ((changes & SedBase::CHANGE_CHILDREN) != 0)
+    {
+      groups |= RULES_CARDINALITY;
+    }
+
+    dirty[found->second] |= groups;
+  }
+
+  for (IdSet::const_iterator it = ids.begin(); it != ids.end(); ++it)
+  {
+    // after collecting the elements again all ids are up to date
+    if (!structureChanged) updateUsers(*it, renamed, dirty);
+    markReferrers(*it, dirty);
+  }
+
+  markBasedStyles(dirty);
+  mIndexTime = secondsSince(start);
+
+  start = Clock::now();
+
+  Results results;
+  for (DirtyMap::const_iterator it = dirty.begin(); it != dirty.end(); ++it)
+  {
+    for (size_t g = 0; g < SED_NUM_RULE_GROUPS; ++g)
+    {
+      if ((it->second & mRuleGroups & SED_RULE_GROUPS[g]) != 0)
+      {
+        checkGroup(SED_RULE_GROUPS[g], it->first, it->first + 1, results);
+      }
+    }
+  }
+
+  addReferrers(results, true);
+
+  Failures failures;
+  for (Failures::const_iterator it = mRetained.begin();
+       it != mRetained.end(); ++it)
+  {
+    DirtyMap::const_iterator found = dirty.find(it->index);
+    if (found == dirty.end() || (found->second & it->group) == 0)
+    {
+      failures.push_back(*it);
+    }
+  }
+
+  failures.insert(failures.end(), results.failures.begin(),
+                  results.failures.end());
+  stable_sort(failures.begin(), failures.end(), precedes);
+  mRetained.swap(failures);
+
+  mNumChecked = (unsigned int)dirty.size();
+  mCheckTime = secondsSince(start);
+}
+
+
+void
+SedValidator::collectFailures ()
+{
+  mFailures.clear();
+  mFailures.reserve(mRetained.size());
+  for (Failures::const_iterator it = mRetained.begin();
+       it != mRetained.end(); ++it)
+  {
+    mFailures.push_back(it->error);
+  }
+
+  if (!mKeepState) mRetained.clear();
+}
+
+
+/*
+ * Orders failures by element, and the failures of one element by rule
+ * group.
+ */
+bool
+SedValidator::precedes (const Failure& a, const Failure& b)
+{
+  if (a.index != b.index) return a.index < b.index;
+  return a.group < b.group;
+}
+
+
+/*
+ * Collects the elements of the document and their ids.  Walking the
+ * document also loads all lazily read lists, so that the jobs only read
+ * from it.
+ */
+void
+SedValidator::indexElements (const SedDocument* document)
+{
+  mElements.clear();
+  mDuplicateOf.clear();
+  mIds.clear();
+  mDuplicates.clear();
+  mIndexOf.clear();
+
+  SedElementIterator<const SedBase> end;
+  for (SedElementIterator<const SedBase> it(document); it != end; ++it)
+  {
+    if ((*it)->getTypeCode() == SEDML_LIST_OF) continue;
+
+    const SedBase* element = *it;
+    const SedBase* first = NULL;
+    if (element->isSetId())
+    {
+      // the first element in document order owns the id
+      first = mIds.insert(IdMap::value_type(element->getId(), element))
+                .first->second;
+    }
+
+    if (mKeepState)
+    {
+      mIndexOf[element] = mElements.size();
+      if (first != element && first != NULL)
+      {
+        mDuplicates.insert(DuplicateMap::value_type(element->getId(), element));
+      }
+    }
+
+    mElements.push_back(element);
+    mDuplicateOf.push_back(first != element ? first : NULL);
+  }
+}
+
+
+/*
+ * Collects the elements again after elements were added or removed.  The
+ * failures found so far move along with their elements; the ids whose
+ * users changed are added to @p ids, and the elements that became or
+ * stopped being duplicates to @p dirty.
+ */
+void
+SedValidator::reindexElements (const SedDocument* document, IdSet& ids,
+                               DirtyMap& dirty)
+{
+  vector<const SedBase*> oldElements;
+  vector<const SedBase*> oldDuplicateOf;
+  IdMap oldIds;
+  IndexMap oldIndexOf;
+  oldElements.swap(mElements);
+  oldDuplicateOf.swap(mDuplicateOf);
+  oldIds.swap(mIds);
+  oldIndexOf.swap(mIndexOf);
+
+  indexElements(document);
+
+  // removed elements may be deleted, so they are only compared, never used
+  Failures failures;
+  for (Failures::const_iterator it = mRetained.begin();
+       it != mRetained.end(); ++it)
+  {
+    IndexMap::const_iterator found = mIndexOf.find(oldElements[it->index]);
+    if (found == mIndexOf.end()) continue;
+
+    failures.push_back(*it);
+    failures.back().index = found->second;
+  }
+  mRetained.swap(failures);
+
+  for (IdMap::const_iterator it = oldIds.begin(); it != oldIds.end(); ++it)
+  {
+    IdMap::const_iterator found = mIds.find(it->first);
+    if (found == mIds.end() || found->second != it->second)
+    {
+      ids.insert(it->first);
+    }
+  }
+
+  for (IdMap::const_iterator it = mIds.begin(); it != mIds.end(); ++it)
+  {
+    if (oldIds.find(it->first) == oldIds.end()) ids.insert(it->first);
+  }
+
+  for (size_t i = 0; i < mElements.size(); ++i)
+  {
+    IndexMap::const_iterator found = oldIndexOf.find(mElements[i]);
+    if (found != oldIndexOf.end()
+        && oldDuplicateOf[found->second] != mDuplicateOf[i])
+    {
+      dirty[i] |= RULES_IDENTIFIERS;
+    }
+  }
+
+  for (ReferrerMap::iterator it = mReferrers.begin(); it != mReferrers.end(); )
+  {
+    vector<const SedBase*>& referrers = it->second;
+    size_t kept = 0;
+    for (size_t n = 0; n < referrers.size(); ++n)
+    {
+      if (mIndexOf.find(referrers[n]) != mIndexOf.end())
+      {
+        referrers[kept++] = referrers[n];
+      }
+    }
+    referrers.resize(kept);
+
+    if (referrers.empty())
+    {
+      it = mReferrers.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+
+/*
+ * Works out anew which element owns the given id and which elements
+ * duplicate it, after elements were renamed.  The users of an id are its
+ * owner, its duplicates, and the renamed elements now using it.
+ */
+void
+SedValidator::updateUsers (const std::string& id, const DuplicateMap& renamed,
+                           DirtyMap& dirty)
+{
+  vector<pair<size_t, const SedBase*> > users;
+
+  IdMap::iterator owner = mIds.find(id);
+  if (owner != mIds.end())
+  {
+    users.push_back(make_pair(mIndexOf[owner->second], owner->second));
+  }
+
+  pair<DuplicateMap::iterator, DuplicateMap::iterator> duplicates =
+    mDuplicates.equal_range(id);
+  for (DuplicateMap::iterator it = duplicates.first;
+       it != duplicates.second; ++it)
+  {
+    users.push_back(make_pair(mIndexOf[it->second], it->second));
+  }
+  mDuplicates.erase(id);
+
+  pair<DuplicateMap::const_iterator, DuplicateMap::const_iterator> others =
+    renamed.equal_range(id);
+  for (DuplicateMap::const_iterator it = others.first;
+       it != others.second; ++it)
+  {
+    users.push_back(make_pair(mIndexOf[it->second], it->second));
+  }
+
+  sort(users.begin(), users.end());
+  users.erase(unique(users.begin(), users.end()), users.end());
+
+  const SedBase* first = NULL;
+  for (size_t n = 0; n < users.size(); ++n)
+  {
+    size_t index = users[n].first;
+    const SedBase* element = users[n].second;
+    dirty[index] |= RULES_IDENTIFIERS;
+
+    if (element->getId() != id)
+    {
+      // elements using another id now are updated along with that id
+      if (!element->isSetId()) mDuplicateOf[index] = NULL;
+    }
+    else if (first == NULL)
+    {
+      first = element;
+      mDuplicateOf[index] = NULL;
+    }
+    else
+    {
+      mDuplicateOf[index] = first;
+      mDuplicates.insert(DuplicateMap::value_type(id, element));
+    }
+  }
+
+  if (first != NULL)
+  {
+    mIds[id] = first;
+  }
+  else
+  {
+    mIds.erase(id);
+  }
+}
+
+
+/*
+ * Marks the elements referring to the given id; the base style of a style
+ * is checked along with the styles rules.
+ */
+void
+SedValidator::markReferrers (const std::string& id, DirtyMap& dirty) const
+{
+  ReferrerMap::const_iterator it = mReferrers.find(id);
+  if (it == mReferrers.end()) return;
+
+  for (size_t n = 0; n < it->second.size(); ++n)
+  {
+    const SedBase* referrer = it->second[n];
+    IndexMap::const_iterator found = mIndexOf.find(referrer);
+    if (found == mIndexOf.end()) continue;
+
+    dirty[found->second] |= (referrer->getTypeCode() == SEDML_STYLE)
+      ? RULES_STYLES : RULES_REFERENCES;
+  }
+}
+
+
+/*
+ * A style that changes may close or break a cycle of base styles, which is
+ * reported for every style on it; all styles based on it, directly or not,
+ * are therefore checked again.
+ */
+void
+SedValidator::markBasedStyles (DirtyMap& dirty) const
+{
+  vector<const SedBase*> pending;
+  for (DirtyMap::const_iterator it = dirty.begin(); it != dirty.end(); ++it)
+  {
+    if ((it->second & RULES_STYLES) != 0
+        && mElements[it->first]->getTypeCode() == SEDML_STYLE)
+    {
+      pending.push_back(mElements[it->first]);
+    }
+  }
+
+  unordered_set<const SedBase*> seen(pending.begin(), pending.end());
+  while (!pending.empty())
+  {
+    const SedBase* style = pending.back();
+    pending.pop_back();
+
+    ReferrerMap::const_iterator it = mReferrers.find(style->getId());
+    if (!style->isSetId() || it == mReferrers.end()) continue;
+
+    for (size_t n = 0; n < it->second.size(); ++n)
+    {
+      const SedBase* referrer = it->second[n];
+      if (referrer->getTypeCode() != SEDML_STYLE
+          || !seen.insert(referrer).second)
+      {
+        continue;
+      }
+
+      IndexMap::const_iterator found = mIndexOf.find(referrer);
+      if (found == mIndexOf.end()) continue;
+
+      dirty[found->second] |= RULES_STYLES;
+      pending.push_back(referrer);
+    }
+  }
+}
+
+
+/*
+ * Adds the references found by a job to the elements referring to each id.
+ * The lists only ever grow until elements are removed, so an element may
+ * be listed for an id it no longer refers to, which only costs a check.
+ */
+void
+SedValidator::addReferrers (const Results& results, bool unique)
+{
+  for (size_t n = 0; n < results.references.size(); ++n)
+  {
+    const SedBase* element = mElements[results.references[n].second];
+    vector<const SedBase*>& referrers = mReferrers[results.references[n].first];
+    if (!unique
+        || find(referrers.begin(), referrers.end(), element) == referrers.end())
+    {
+      referrers.push_back(element);
+    }
+  }
+}
+
+
+void
+SedValidator::checkGroup (unsigned int group, size_t begin, size_t end,
+                          Results& results) const
+{
+  size_t first = results.failures.size();
+
+  switch (group)
+  {
+  case RULES_IDENTIFIERS:
+    checkIdentifiers(begin, end, results);
+    break;
+  case RULES_REFERENCES:
+    checkReferences(begin, end, results);
+    break;
+  case RULES_CARDINALITY:
+    checkCardinality(begin, end, results);
+    break;
+  case RULES_STYLES:
+    checkStyles(begin, end, results);
+    break;
+  }
+
+  for (size_t n = first; n < results.failures.size(); ++n)
+  {
+    results.failures[n].group = group;
+  }
+}
+
+
+void
+SedValidator::checkIdentifiers (size_t begin, size_t end,
+                                Results& results) const
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    const SedBase* first = mDuplicateOf[i];
+    if (first == NULL) continue;
+
+    addFailure(i, SedmlDuplicateComponentId,
+      "The id '" + first->getId() + "' of this " +
+      describe(mElements[i]) + " is already used by a <" +
+      first->getElementName() + ">.", results);
+  }
+}
+
+
+void
+SedValidator::checkReferences (size_t begin, size_t end,
+                               Results& results) const
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    const SedBase* element = mElements[i];
+
+    switch (element->getTypeCode())
+    {
+    case SEDML_TASK:
+    {
+      const SedTask* task = static_cast<const SedTask*>(element);
+      checkReference(i, "modelReference", task->getModelReference(),
+                     isModel, "model", SedmlTaskModelReferenceMustBeModel,
+                     results);
+      checkReference(i, "simulationReference",
+                     task->getSimulationReference(), isSimulation,
+                     "simulation", SedmlTaskSimulationReferenceMustBeSimulation,
+                     results);
+      break;
+    }
+
+    case SEDML_TASK_REPEATEDTASK:
+      checkRange(i, "range",
+                 static_cast<const SedRepeatedTask*>(element)->getRangeId(),
+                 SedmlRepeatedTaskRangeMustBeRange, results);
+      break;
+
+    case SEDML_TASK_SUBTASK:
+      checkReference(i, "task",
+                     static_cast<const SedSubTask*>(element)->getTask(),
+                     isAbstractTask, "task", SedmlSubTaskTaskMustBeAbstractTask,
+                     results);
+      break;
+
+    case SEDML_TASK_SETVALUE:
+    {
+      const SedSetValue* setValue = static_cast<const SedSetValue*>(element);
+      checkReference(i, "modelReference", setValue->getModelReference(),
+                     isModel, "model", SedmlSetValueModelReferenceMustBeModel,
+                     results);
+      checkRange(i, "range", setValue->getRange(),
+                 SedmlSetValueRangeMustBeRange, results);
+      break;
+    }
+
+    case SEDML_RANGE_FUNCTIONALRANGE:
+      checkRange(i, "range",
+                 static_cast<const SedFunctionalRange*>(element)->getRange(),
+                 SedmlFunctionalRangeRangeMustBeRange, results);
+      break;
+
+    case SEDML_DATA_RANGE:
+      checkReference(i, "sourceReference",
+        static_cast<const SedDataRange*>(element)->getSourceReference(),
+        isDataSource, "dataSource", SedmlDataRangeSourceReferenceMustBeSId,
+        results);
+      break;
+
+    case SEDML_VARIABLE:
+    {
+      const SedVariable* variable = static_cast<const SedVariable*>(element);
+      checkReference(i, "taskReference", variable->getTaskReference(),
+                     isAbstractTask, "task",
+                     SedmlVariableTaskReferenceMustBeAbstractTask, results);
+      checkReference(i, "modelReference", variable->getModelReference(),
+                     isModel, "model", SedmlVariableModelReferenceMustBeModel,
+                     results);
+      break;
+    }
+
+    case SEDML_OUTPUT_CURVE:
+    {
+      const SedCurve* curve = static_cast<const SedCurve*>(element);
+      checkReference(i, "xDataReference", curve->getXDataReference(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlAbstractCurveXDataReferenceMustBeDataReference,
+                     results);
+      checkReference(i, "yDataReference", curve->getYDataReference(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlCurveYDataReferenceMustBeDataGenerator, results);
+      checkReference(i, "xErrorUpper", curve->getXErrorUpper(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlCurveXErrorUpperMustBeDataGenerator, results);
+      checkReference(i, "xErrorLower", curve->getXErrorLower(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlCurveXErrorLowerMustBeDataGenerator, results);
+      checkReference(i, "yErrorUpper", curve->getYErrorUpper(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlCurveYErrorUpperMustBeDataGenerator, results);
+      checkReference(i, "yErrorLower", curve->getYErrorLower(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlCurveYErrorLowerMustBeDataGenerator, results);
+      checkReference(i, "style", curve->getStyle(), isStyle, "style",
+                     SedmlAbstractCurveStyleMustBeStyle, results);
+      break;
+    }
+
+    case SEDML_SHADEDAREA:
+    {
+      const SedShadedArea* area = static_cast<const SedShadedArea*>(element);
+      checkReference(i, "xDataReference", area->getXDataReference(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlAbstractCurveXDataReferenceMustBeDataReference,
+                     results);
+      checkReference(i, "yDataReferenceFrom",
+                     area->getYDataReferenceFrom(), isDataGenerator,
+                     "dataGenerator",
+                     SedmlShadedAreaYDataReferenceFromMustBeDataGenerator,
+                     results);
+      checkReference(i, "yDataReferenceTo", area->getYDataReferenceTo(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlShadedAreaYDataReferenceToMustBeDataGenerator,
+                     results);
+      checkReference(i, "style", area->getStyle(), isStyle, "style",
+                     SedmlAbstractCurveStyleMustBeStyle, results);
+      break;
+    }
+
+    case SEDML_OUTPUT_SURFACE:
+    {
+      const SedSurface* surface = static_cast<const SedSurface*>(element);
+      checkReference(i, "xDataReference", surface->getXDataReference(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlSurfaceXDataReferenceMustBeDataGenerator, results);
+      checkReference(i, "yDataReference", surface->getYDataReference(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlSurfaceYDataReferenceMustBeDataGenerator, results);
+      checkReference(i, "zDataReference", surface->getZDataReference(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlSurfaceZDataReferenceMustBeDataGenerator, results);
+      checkReference(i, "style", surface->getStyle(), isStyle, "style",
+                     SedmlSurfaceStyleMustBeStyle, results);
+      break;
+    }
+
+    case SEDML_OUTPUT_DATASET:
+      checkReference(i, "dataReference",
+                     static_cast<const SedDataSet*>(element)->getDataReference(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlDataSetDataReferenceMustBeDataGenerator, results);
+      break;
+
+    case SEDML_SUBPLOT:
+      checkReference(i, "plot",
+                     static_cast<const SedSubPlot*>(element)->getPlot(),
+                     isPlot, "plot", SedmlSubPlotPlotMustBePlot, results);
+      break;
+
+    case SEDML_AXIS:
+      checkReference(i, "style",
+                     static_cast<const SedAxis*>(element)->getStyle(),
+                     isStyle, "style", SedmlAxisStyleMustBeStyle, results);
+      break;
+
+    case SEDML_ADJUSTABLE_PARAMETER:
+      checkReference(i, "modelReference",
+        static_cast<const SedAdjustableParameter*>(element)->getModelReference(),
+        isModel, "model", SedmlAdjustableParameterModelReferenceMustBeModel,
+        results);
+      break;
+
+    case SEDML_EXPERIMENT_REFERENCE:
+      checkReference(i, "experimentId",
+        static_cast<const SedExperimentReference*>(element)->getExperimentId(),
+        isFitExperiment, "fitExperiment",
+        SedmlExperimentReferenceExperimentIdMustBeFitExperiment, results);
+      break;
+
+    case SEDML_FITMAPPING:
+    {
+      const SedFitMapping* mapping = static_cast<const SedFitMapping*>(element);
+      checkReference(i, "dataSource", mapping->getDataSource(),
+                     isDataSourceOrGenerator, "dataSource",
+                     SedmlFitMappingDataSourceMustBeDataSource, results);
+      checkReference(i, "target", mapping->getTarget(),
+                     isDataGenerator, "dataGenerator",
+                     SedmlFitMappingTargetMustBeDataGenerator, results);
+      checkReference(i, "pointWeight", mapping->getPointWeight(),
+                     isDataSourceOrGenerator, "dataSource",
+                     SedmlFitMappingPointWeightMustBeDataSource, results);
+      break;
+    }
+
+    case SEDML_PARAMETERESTIMATIONREPORT:
+      checkReference(i, "taskReference",
+        static_cast<const SedParameterEstimationReport*>(element)
+          ->getTaskReference(),
+        isParameterEstimationTask, "parameterEstimationTask",
+        SedmlParameterEstimationReportTaskReferenceMustBeTask, results);
+      break;
+
+    case SEDML_PARAMETERESTIMATIONRESULTPLOT:
+      checkReference(i, "taskReference",
+        static_cast<const SedParameterEstimationResultPlot*>(element)
+          ->getTaskReference(),
+        isParameterEstimationTask, "parameterEstimationTask",
+        SedmlParameterEstimationResultPlotTaskReferenceMustBeTask, results);
+      break;
+
+    case SEDML_WATERFALLPLOT:
+      checkReference(i, "taskReference",
+        static_cast<const SedWaterfallPlot*>(element)->getTaskReference(),
+        isAbstractTask, "task", SedmlWaterfallPlotTaskReferenceMustBeTask,
+        results);
+      break;
+
+    default:
+      break;
+    }
+  }
+}
+
+
+void
+SedValidator::checkCardinality (size_t begin, size_t end,
+                                Results& results) const
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    const SedBase* element = mElements[i];
+
+    switch (element->getTypeCode())
+    {
+    case SEDML_SIMULATION_UNIFORMTIMECOURSE:
+    case SEDML_SIMULATION_ONESTEP:
+    case SEDML_SIMULATION_STEADYSTATE:
+    case SEDML_SIMULATION_ANALYSIS:
+      checkChild(i,
+                 static_cast<const SedSimulation*>(element)->isSetAlgorithm(),
+                 "<algorithm>", SedmlSimulationAllowedElements, results);
+      break;
+
+    case SEDML_TASK_REPEATEDTASK:
+      checkChild(i,
+        static_cast<const SedRepeatedTask*>(element)->getNumSubTasks() > 0,
+        "<subTask>", SedmlRepeatedTaskAllowedElements, results);
+      break;
+
+    case SEDML_TASK_PARAMETER_ESTIMATION:
+    {
+      const SedParameterEstimationTask* task =
+        static_cast<const SedParameterEstimationTask*>(element);
+      checkChild(i, task->isSetAlgorithm(), "<algorithm>",
+                 SedmlParameterEstimationTaskAllowedElements, results);
+      checkChild(i, task->isSetObjective(), "objective",
+                 SedmlParameterEstimationTaskAllowedElements, results);
+      checkChild(i, task->getNumAdjustableParameters() > 0,
+                 "<adjustableParameter>",
+                 SedmlParameterEstimationTaskAllowedElements, results);
+      checkChild(i, task->getNumFitExperiments() > 0,
+                 "<fitExperiment>",
+                 SedmlParameterEstimationTaskAllowedElements, results);
+      break;
+    }
+
+    case SEDML_TASK_SETVALUE:
+      checkChild(i,
+                 static_cast<const SedSetValue*>(element)->isSetMath(),
+                 "<math>", SedmlSetValueAllowedElements, results);
+      break;
+
+    case SEDML_CHANGE_COMPUTECHANGE:
+      checkChild(i,
+                 static_cast<const SedComputeChange*>(element)->isSetMath(),
+                 "<math>", SedmlComputeChangeAllowedElements, results);
+      break;
+
+    case SEDML_RANGE_FUNCTIONALRANGE:
+      checkChild(i,
+                 static_cast<const SedFunctionalRange*>(element)->isSetMath(),
+                 "<math>", SedmlFunctionalRangeAllowedElements, results);
+      break;
+
+    case SEDML_DATAGENERATOR:
+      checkChild(i,
+                 static_cast<const SedDataGenerator*>(element)->isSetMath(),
+                 "<math>", SedmlDataGeneratorAllowedElements, results);
+      break;
+
+    default:
+      break;
+    }
+  }
+}
+
+
+void
+SedValidator::checkStyles (size_t begin, size_t end, Results& results) const
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    const SedBase* element = mElements[i];
+    if (element->getTypeCode() != SEDML_STYLE) continue;
+
+    const SedStyle* style = static_cast<const SedStyle*>(element);
+    checkReference(i, "baseStyle", style->getBaseStyle(), isStyle,
+                   "style", SedmlStyleBaseStyleMustBeStyle, results);
+
+    // a chain longer than the number of elements has to contain a cycle,
+    // which is only reported for the styles on it
+    const SedStyle* current = style;
+    for (size_t steps = 0; steps < mElements.size(); ++steps)
+    {
+      IdMap::const_iterator it = mIds.find(current->getBaseStyle());
+      if (it == mIds.end() || it->second->getTypeCode() != SEDML_STYLE) break;
+
+      current = static_cast<const SedStyle*>(it->second);
+      if (current == style)
+      {
+        addFailure(i, SedmlStyleBaseStyleMustNotBeCircular,
+          "Following the base styles of the " + describe(element) +
+          " leads back to it.", results);
+        break;
+      }
+    }
+  }
+}
+
+
+void
+SedValidator::checkReference (size_t index, const std::string& attribute,
+                              const std::string& reference,
+                              KindMatcher matches, const char* expected,
+                              unsigned int errorId, Results& results) const
+{
+  if (reference.empty()) return;
+  if (mKeepState) results.references.push_back(make_pair(reference, index));
+
+  const SedBase* element = mElements[index];
+  IdMap::const_iterator it = mIds.find(reference);
+  if (it == mIds.end())
+  {
+    addFailure(index, errorId, "The '" + attribute + "' of the " +
+      describe(element) + " refers to '" + reference +
+      "', but there is no element with that id.", results);
+  }
+  else if (!matches(it->second->getTypeCode()))
+  {
+    addFailure(index, errorId, "The '" + attribute + "' of the " +
+      describe(element) + " refers to '" + reference + "', which is a <" +
+      it->second->getElementName() + "> rather than a <" + expected + ">.",
+      results);
+  }
+}
+
+
+/*
+ * Ranges are only visible within their repeated task.
+ */
+void
+SedValidator::checkRange (size_t index, const std::string& attribute,
+                          const std::string& reference, unsigned int errorId,
+                          Results& results) const
+{
+  if (reference.empty()) return;
+  if (mKeepState) results.references.push_back(make_pair(reference, index));
+
+  const SedBase* element = mElements[index];
+  const SedBase* task = (element->getTypeCode() == SEDML_TASK_REPEATEDTASK)
+    ? element : element->getAncestorOfType(SEDML_TASK_REPEATEDTASK);
+
+  IdMap::const_iterator it = mIds.find(reference);
+  const SedBase* range = (it != mIds.end()) ? it->second : NULL;
+  int typeCode = (range != NULL) ? range->getTypeCode() : SEDML_UNKNOWN;
+  bool isRange = typeCode == SEDML_RANGE_UNIFORMRANGE
+    || typeCode == SEDML_RANGE_VECTORRANGE
+    || typeCode == SEDML_RANGE_FUNCTIONALRANGE
+    || typeCode == SEDML_DATA_RANGE;
+
+  if (isRange && task != NULL
+      && range->getAncestorOfType(SEDML_TASK_REPEATEDTASK) == task)
+  {
+    return;
+  }
+
+  addFailure(index, errorId, "The '" + attribute + "' of the " +
+    describe(element) + " refers to '" + reference +
+    "', which is not a range of " +
+    (task != NULL ? "the " + describe(task) : string("a <repeatedTask>")) +
+    ".", results);
+}
+
+
+void
+SedValidator::checkChild (size_t index, bool present, const char* child,
+                          unsigned int errorId, Results& results) const
+{
+  if (present) return;
+
+  addFailure(index, errorId, "The " + describe(mElements[index]) +
+    " has no " + child + ".", results);
+}
+
+
+void
+SedValidator::addFailure (size_t index, unsigned int errorId,
+                          const std::string& details, Results& results) const
+{
+  const SedBase* element = mElements[index];
+  Failure failure = { index, 0, SedError(errorId, mLevel, mVersion, details,
+                                         element->getLine(),
+                                         element->getColumn()) };
+  results.failures.push_back(failure);
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
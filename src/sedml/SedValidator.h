@@ -0,0 +1,365 @@
+/**
+ * @file SedValidator.h
+ * @brief Definition of the SedValidator class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ *
+ * @class SedValidator
+ * @sbmlbrief{} Checks the references between the elements of a SED-ML
+ * document and other rules that reading a document does not check.
+ *
+ * When a document is read, the attributes of each element are checked on
+ * their own, so that for instance the syntax of an id is verified; whether
+ * the element a reference points to exists and is of the right kind can
+ * only be checked once the whole document is known.  A SedValidator does
+ * so for a complete document, read from a file or built in memory.  The
+ * rules are divided into groups, see RuleGroup:
+ *
+ * @li identifiers: every id is used by one element only;
+ * @li references: every reference resolves to an element of the kind the
+ * attribute expects, for instance the "yDataReference" of a curve to a data
+ * generator, and the "range" of a set value to a range of its repeated task;
+ * @li cardinality: elements have the children they require, for instance
+ * a data generator its math and a repeated task at least one subtask;
+ * @li styles: base styles exist and do not form a cycle.
+ *
+ * All ids are collected into an index first.  The elements are then split
+ * into chunks, and every enabled rule group is checked on every chunk as a
+ * separate job on the SedWorkStealingPool shared by all of libSEDML,
+ * whose threads are started once and reused by every validation.  The
+ * failures are reported in document order, whatever the number of
+ * threads.
+ *
+ * SedDocument::checkConsistency() runs all rules and adds the failures to
+ * the error log of the document.
+ *
+ * An application that lets users edit a document can check it again after
+ * every edit with revalidate().  The first call checks the whole document
+ * and asks it to record its changes from then on; later calls only check
+ * the elements that changed and the elements referring to them.  For
+ * instance, renaming a data generator checks the curves and data sets that
+ * refer to the old or the new id again, but nothing else.  Adding or
+ * removing elements makes the validator collect the elements of the
+ * document again, which is still considerably faster than checking them
+ * all.  getCheckTime() and related methods tell how long the last call
+ * took.
+ *
+ * @code{.cpp}
+SedValidator validator;
+validator.setRuleGroups(SedValidator::RULES_REFERENCES);
+if (validator.validate(doc) > 0)
+{
+  for (unsigned int n = 0; n < validator.getNumFailures(); ++n)
+  {
+    std::cout << validator.getFailure(n)->getMessage() << std::endl;
+  }
+}
+ * @endcode
+ */
+
+
+#ifndef SedValidator_h
+#define SedValidator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedError.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedValidator
+{
+public:
+
+  /**
+   * The groups of rules a SedValidator checks; they can be combined.
+   */
+  enum RuleGroup
+  {
+    RULES_IDENTIFIERS = 0x01  /*!< Ids are unique within the document. */
+  , RULES_REFERENCES  = 0x02  /*!< References resolve to elements of the right kind. */
+  , RULES_CARDINALITY = 0x04  /*!< Required children are present. */
+  , RULES_STYLES      = 0x08  /*!< Base styles exist and do not form a cycle. */
+  , RULES_ALL         = 0x0f  /*!< All of the above. */
+  };
+
+
+  /**
+   * Creates a new SedValidator that checks all rules.
+   */
+  SedValidator ();
+
+
+  /**
+   * Destroys this SedValidator.
+   */
+  ~SedValidator ();
+
+
+  /**
+   * Sets the groups of rules to check.
+   *
+   * @param ruleGroups a combination of the values of RuleGroup.
+   */
+  void setRuleGroups (unsigned int ruleGroups);
+
+
+  /**
+   * @return the groups of rules that are checked.
+   */
+  unsigned int getRuleGroups () const;
+
+
+  /**
+   * Sets the number of threads used to check the rules.
+   *
+   * @param numThreads the number of threads, or 0 (the default) for as
+   * many as the hardware runs concurrently.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads used to check the rules, 0 meaning as
+   * many as the hardware runs concurrently.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Checks the given document, replacing the failures of any previous
+   * call.  The document must not be modified while it is being checked.
+   *
+   * @param document the document to check.
+   *
+   * @return the number of failures found.
+   */
+  unsigned int validate (const SedDocument* document);
+
+
+  /**
+   * @return the number of failures found by the last call to validate().
+   */
+  unsigned int getNumFailures () const;
+
+
+  /**
+   * @param n the index of the failure.
+   *
+   * @return the nth failure found by the last call to validate(), or
+   * @c NULL if there is no such failure.
+   */
+  const SedError* getFailure (unsigned int n) const;
+
+
+  /**
+   * @return the failures found by the last call to validate(), in document
+   * order.
+   */
+  const std::vector<SedError>& getFailures () const;
+
+
+  /**
+   * Checks the given document again, as far as it changed since the last
+   * call to this method.
+   *
+   * The first call for a document checks all of it, like validate(), and
+   * switches on SedDocument change tracking.  Later calls take the changes
+   * the document recorded since, and only check the rules affected by
+   * them: the changed elements themselves, the elements referring to ids
+   * that were added, changed or removed, the elements sharing such an id,
+   * and the parents of elements that were added or removed.  The failures
+   * found earlier for all other elements are kept, so the result is the
+   * same as that of validate().
+   *
+   * Calling validate(), or changing the rule groups, makes the next call
+   * check the whole document again.  The changes of a document can only be
+   * taken by one SedValidator at a time.
+   *
+   * @param document the document to check.
+   *
+   * @return the number of failures in the document.
+   */
+  unsigned int revalidate (SedDocument* document);
+
+
+  /**
+   * @return @c true if the last call to revalidate() only checked the
+   * changes since the call before.
+   */
+  bool wasIncremental () const;
+
+
+  /**
+   * @return the number of elements the last call to validate() or
+   * revalidate() checked rules for.
+   */
+  unsigned int getNumCheckedElements () const;
+
+
+  /**
+   * @return the time in seconds the last call to validate() or revalidate()
+   * spent collecting the elements, ids and changes of the document.
+   */
+  double getIndexTime () const;
+
+
+  /**
+   * @return the time in seconds the last call to validate() or revalidate()
+   * spent checking rules.
+   */
+  double getCheckTime () const;
+
+
+  /**
+   * @return the time in seconds the last call to validate() or revalidate()
+   * took.
+   */
+  double getTotalTime () const;
+
+
+private:
+  /** @cond doxygenLibsedmlInternal */
+
+  typedef std::unordered_map<std::string, const SedBase*> IdMap;
+  typedef std::unordered_multimap<std::string, const SedBase*> DuplicateMap;
+  typedef std::unordered_map<const SedBase*, size_t> IndexMap;
+  typedef std::unordered_map<std::string, std::vector<const SedBase*> >
+    ReferrerMap;
+  typedef std::unordered_map<size_t, unsigned int> DirtyMap;
+  typedef std::unordered_set<std::string> IdSet;
+  typedef bool (*KindMatcher) (int typeCode);
+
+  /* a failure of the element with the given index */
+  struct Failure
+  {
+    size_t index;
+    unsigned int group;
+    SedError error;
+  };
+
+  typedef std::vector<Failure> Failures;
+
+  /* what one job finds: failures, and for revalidate() the references */
+  struct Results
+  {
+    Failures failures;
+    std::vector<std::pair<std::string, size_t> > references;
+  };
+
+  SedValidator (const SedValidator& orig);
+  SedValidator& operator= (const SedValidator& rhs);
+
+  void reset ();
+  void checkAll (const SedDocument* document);
+  void checkChanges (SedDocument* document);
+  void collectFailures ();
+  static bool precedes (const Failure& a, const Failure& b);
+
+  void indexElements (const SedDocument* document);
+  void reindexElements (const SedDocument* document, IdSet& ids,
+                        DirtyMap& dirty);
+  void updateUsers (const std::string& id, const DuplicateMap& renamed,
+                    DirtyMap& dirty);
+  void markReferrers (const std::string& id, DirtyMap& dirty) const;
+  void markBasedStyles (DirtyMap& dirty) const;
+  void addReferrers (const Results& results, bool unique);
+
+  void checkGroup (unsigned int group, size_t begin, size_t end,
+                   Results& results) const;
+  void checkIdentifiers (size_t begin, size_t end, Results& results) const;
+  void checkReferences (size_t begin, size_t end, Results& results) const;
+  void checkCardinality (size_t begin, size_t end, Results& results) const;
+  void checkStyles (size_t begin, size_t end, Results& results) const;
+
+  void checkReference (size_t index, const std::string& attribute,
+                       const std::string& reference, KindMatcher matches,
+                       const char* expected, unsigned int errorId,
+                       Results& results) const;
+  void checkRange (size_t index, const std::string& attribute,
+                   const std::string& reference, unsigned int errorId,
+                   Results& results) const;
+  void checkChild (size_t index, bool present, const char* child,
+                   unsigned int errorId, Results& results) const;
+  void addFailure (size_t index, unsigned int errorId,
+                   const std::string& details, Results& results) const;
+
+  unsigned int mRuleGroups;
+  unsigned int mNumThreads;
+  unsigned int mLevel;
+  unsigned int mVersion;
+
+  // the state revalidate() keeps between calls
+  bool mKeepState;
+  const SedDocument* mDocument;
+  unsigned int mStateRuleGroups;
+
+  std::vector<const SedBase*> mElements;
+  std::vector<const SedBase*> mDuplicateOf;
+  IdMap mIds;
+  DuplicateMap mDuplicates;
+  IndexMap mIndexOf;
+  ReferrerMap mReferrers;
+  Failures mRetained;
+  std::vector<SedError> mFailures;
+
+  bool mWasIncremental;
+  unsigned int mNumChecked;
+  double mIndexTime;
+  double mCheckTime;
+  double mTotalTime;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedValidator_h */
@@ -0,0 +1,116 @@
+/**
+ * @file SedValueProvider.h
+ * @brief Definition of the SedValueProvider class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedValueProvider
+ * @sbmlbrief{} Supplies the values that a SED-ML document refers to but
+ * does not contain itself.
+ *
+ * Some of the math in a SED-ML document refers to values that only a
+ * simulator knows, such as the current value of a model variable in a
+ * functional range or a set value change, or the contents of a data
+ * source in a data range.  Components of libSEDML that evaluate such
+ * math, for example SedRepeatedTaskIterator, ask a SedValueProvider for
+ * these values.  Simulators override the methods for the values they can
+ * provide.
+ */
+
+
+#ifndef SedValueProvider_h
+#define SedValueProvider_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedVariable;
+class SedDataRange;
+
+
+class LIBSEDML_EXTERN SedValueProvider
+{
+public:
+
+  /**
+   * Creates a new SedValueProvider.
+   */
+  SedValueProvider ();
+
+
+  /**
+   * Destroys this SedValueProvider.
+   */
+  virtual ~SedValueProvider ();
+
+
+  /**
+   * Returns the current value of the model quantity the given variable
+   * refers to (through its "target" or "symbol" attribute).
+   *
+   * The default implementation returns NaN.
+   *
+   * @param variable the variable whose value is requested.
+   *
+   * @return the value of @p variable.
+   */
+  virtual double getVariableValue (const SedVariable* variable);
+
+
+  /**
+   * Retrieves the values of the given data range from its data source.
+   *
+   * The default implementation provides no values.
+   *
+   * @param range the data range whose values are requested.
+   * @param values vector that receives the values.
+   *
+   * @return @c true if the values could be retrieved, @c false otherwise.
+   */
+  virtual bool getDataRangeValues (const SedDataRange* range,
+                                   std::vector<double>& values);
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedValueProvider_h */
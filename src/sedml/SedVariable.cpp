@@ -74,7 +74,7 @@ SedVariable::SedVariable(unsigned int level, unsigned int version)
 /*
  * Creates a new SedVariable using the given SedNamespaces object @p sedmlns.
  */
-SedVariable::SedVariable(SedNamespaces *sedmlns)
+SedVariable::SedVariable(const SedNamespaces *sedmlns)
   : SedBase(sedmlns)
   , mSymbol ("")
   , mTarget ("")
@@ -348,6 +348,8 @@ SedVariable::setTarget(const std::string& target)
 int
 SedVariable::setTaskReference(const std::string& taskReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(taskReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -366,6 +368,8 @@ SedVariable::setTaskReference(const std::string& taskReference)
 int
 SedVariable::setModelReference(const std::string& modelReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(modelReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -466,6 +470,8 @@ SedVariable::unsetTarget()
 int
 SedVariable::unsetTaskReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mTaskReference.erase();
 
   if (mTaskReference.empty() == true)
@@ -485,6 +491,8 @@ SedVariable::unsetTaskReference()
 int
 SedVariable::unsetModelReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -826,7 +834,46 @@ SedVariable::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedVariable::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
+}
+
+
+/*
+ * Returns the number of child objects of this SedVariable
+ */
+unsigned int
+SedVariable::getNumChildElements() const
+{
+  const SedBase* children[] = {
+    &mAppliedDimensions
+  };
+
+  return SedBase::getNumChildElements() +
+    countChildElements(children, 1);
+}
+
+
+/*
+ * Returns the nth child object of this SedVariable
+ */
+const SedBase*
+SedVariable::getChildElement(unsigned int n) const
+{
+  unsigned int inherited = SedBase::getNumChildElements();
+  if (n < inherited)
+  {
+    return SedBase::getChildElement(n);
+  }
+
+  const SedBase* children[] = {
+    &mAppliedDimensions
+  };
+
+  return selectChildElement(children, 1, n - inherited);
 }
 
 /** @endcond */
@@ -101,7 +101,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedVariable(SedNamespaces *sedmlns);
+  SedVariable(const SedNamespaces *sedmlns);
 
 
   /**
@@ -767,6 +767,18 @@ public:
    */
   virtual bool accept(SedVisitor& v) const;
 
+
+  /**
+   * Returns the number of child objects of this SedVariable
+   */
+  virtual unsigned int getNumChildElements() const;
+
+
+  /**
+   * Returns the nth child object of this SedVariable
+   */
+  virtual const SedBase* getChildElement(unsigned int n) const;
+
   /** @endcond */
 
 
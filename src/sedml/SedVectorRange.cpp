@@ -32,8 +32,13 @@
  * ------------------------------------------------------------------------ -->
  */
 #include <sedml/SedVectorRange.h>
+#include <sedml/SedNumberFormatter.h>
 #include <sbml/xml/XMLInputStream.h>
 
+#include <cctype>
+#include <cstring>
+#include <stdint.h>
+
 
 using namespace std;
 
@@ -47,6 +52,148 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
 
+/** @cond doxygenLibSEDMLInternal */
+
+namespace
+{
+
+/*
+ * The namespace of the element holding the values in compact form.
+ */
+const char COMPACT_VALUES_URI[] = "https://github.com/fbergmann/libSEDML#vectorRange";
+
+const char BASE64_DIGITS[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+
+bool
+isLittleEndian()
+{
+  const uint16_t probe = 1;
+  return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+
+/*
+ * Encodes the given values as base64 text of little endian doubles.
+ */
+string
+encodeValues(const vector<double>& values)
+{
+  string bytes(values.size() * sizeof(double), '\0');
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    uint64_t bits;
+    memcpy(&bits, &values[i], sizeof(bits));
+    for (size_t n = 0; n < 8; ++n)
+    {
+      bytes[8 * i + n] = (char)((bits >> (8 * n)) & 0xFF);
+    }
+  }
+
+  string text;
+  text.reserve((bytes.size() + 2) / 3 * 4);
+  for (size_t i = 0; i < bytes.size(); i += 3)
+  {
+    size_t count = min(bytes.size() - i, (size_t)3);
+    uint32_t group = (uint32_t)(unsigned char)bytes[i] << 16;
+    if (count > 1) group |= (uint32_t)(unsigned char)bytes[i + 1] << 8;
+    if (count > 2) group |= (uint32_t)(unsigned char)bytes[i + 2];
+
+    text += BASE64_DIGITS[(group >> 18) & 0x3F];
+    text += BASE64_DIGITS[(group >> 12) & 0x3F];
+    text += (count > 1) ? BASE64_DIGITS[(group >> 6) & 0x3F] : '=';
+    text += (count > 2) ? BASE64_DIGITS[group & 0x3F] : '=';
+  }
+
+  return text;
+}
+
+
+/*
+ * Decodes base64 text of little endian doubles, ignoring white space.
+ * Returns false, with the reason in @p message, if the text is not valid.
+ */
+bool
+decodeValues(const string& text, vector<double>& values, string& message)
+{
+  signed char lookup[256];
+  memset(lookup, -1, sizeof(lookup));
+  for (int i = 0; i < 64; ++i)
+  {
+    lookup[(unsigned char)BASE64_DIGITS[i]] = (signed char)i;
+  }
+
+  string bytes;
+  bytes.reserve(text.size() / 4 * 3);
+
+  uint32_t group = 0;
+  int numBits = 0;
+  size_t i = 0;
+  for (; i < text.size() && text[i] != '='; ++i)
+  {
+    unsigned char c = (unsigned char)text[i];
+    if (isspace(c)) continue;
+    if (lookup[c] < 0)
+    {
+      message = "is not valid base64 text";
+      return false;
+    }
+
+    group = (group << 6) | (uint32_t)lookup[c];
+    numBits += 6;
+    if (numBits >= 8)
+    {
+      numBits -= 8;
+      bytes += (char)((group >> numBits) & 0xFF);
+    }
+  }
+
+  for (; i < text.size(); ++i)
+  {
+    if (text[i] != '=' && !isspace((unsigned char)text[i]))
+    {
+      message = "is not valid base64 text";
+      return false;
+    }
+  }
+
+  if (bytes.size() % sizeof(double) != 0)
+  {
+    message = "holds " + SedNumberFormatter::toString((double)bytes.size())
+      + " bytes, which is not a whole number of doubles";
+    return false;
+  }
+
+  size_t count = bytes.size() / sizeof(double);
+  values.reserve(values.size() + count);
+  for (size_t n = 0; n < count; ++n)
+  {
+    double value;
+    if (isLittleEndian())
+    {
+      memcpy(&value, &bytes[8 * n], sizeof(value));
+    }
+    else
+    {
+      uint64_t bits = 0;
+      for (size_t b = 0; b < 8; ++b)
+      {
+        bits |= (uint64_t)(unsigned char)bytes[8 * n + b] << (8 * b);
+      }
+      memcpy(&value, &bits, sizeof(value));
+    }
+    values.push_back(value);
+  }
+
+  return true;
+}
+
+}
+
+/** @endcond */
+
+
 /*
  * Creates a new SedVectorRange using the given SED-ML Level and @ p version
  * values.
@@ -54,6 +201,7 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 SedVectorRange::SedVectorRange(unsigned int level, unsigned int version)
   : SedRange(level, version)
   , mValue ()
+  , mUseCompactEncoding (false)
 {
   setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
@@ -63,9 +211,10 @@ SedVectorRange::SedVectorRange(unsigned int level, unsigned int version)
  * Creates a new SedVectorRange using the given SedNamespaces object @p
  * sedmlns.
  */
-SedVectorRange::SedVectorRange(SedNamespaces *sedmlns)
+SedVectorRange::SedVectorRange(const SedNamespaces *sedmlns)
   : SedRange(sedmlns)
   , mValue ()
+  , mUseCompactEncoding (false)
 {
   setElementNamespace(sedmlns->getURI());
 }
@@ -77,6 +226,7 @@ SedVectorRange::SedVectorRange(SedNamespaces *sedmlns)
 SedVectorRange::SedVectorRange(const SedVectorRange& orig)
   : SedRange( orig )
   , mValue ( orig.mValue )
+  , mUseCompactEncoding ( orig.mUseCompactEncoding )
 {
 }
 
@@ -91,6 +241,7 @@ SedVectorRange::operator=(const SedVectorRange& rhs)
   {
     SedRange::operator=(rhs);
     mValue = rhs.mValue;
+    mUseCompactEncoding = rhs.mUseCompactEncoding;
   }
 
   return *this;
@@ -179,6 +330,27 @@ SedVectorRange::clearValues()
 }
 
 
+/*
+ * Sets whether the values are written in compact form.
+ */
+int
+SedVectorRange::setUseCompactEncoding(bool useCompactEncoding)
+{
+  mUseCompactEncoding = useCompactEncoding;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Predicate returning @c true if the values are written in compact form.
+ */
+bool
+SedVectorRange::getUseCompactEncoding() const
+{
+  return mUseCompactEncoding;
+}
+
+
 /*
  * Returns the XML element name of this SedVectorRange object.
  */
@@ -223,19 +395,50 @@ void
 SedVectorRange::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
   stream) const
 {
+  if (mUseCompactEncoding && hasValues())
+  {
+    // the values are added to the annotation, which SedBase would write
+    // along with the notes
+    if (mNotes != NULL) stream << *mNotes;
+
+    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode annotation = (mAnnotation != NULL)
+      ? *mAnnotation
+      : LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode(
+          LIBSBML_CPP_NAMESPACE_QUALIFIER XMLTriple("annotation", "", ""),
+          LIBSBML_CPP_NAMESPACE_QUALIFIER XMLAttributes());
+
+    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLAttributes attributes;
+    attributes.add("count", SedNumberFormatter::toString(mValue.size()));
+    attributes.add("encoding", "base64");
+    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNamespaces xmlns;
+    xmlns.add(COMPACT_VALUES_URI);
+
+    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode values(
+      LIBSBML_CPP_NAMESPACE_QUALIFIER XMLTriple("values", COMPACT_VALUES_URI, ""),
+      attributes, xmlns);
+    values.addChild(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode(encodeValues(mValue)));
+    annotation.addChild(values);
+
+    stream << annotation;
+    return;
+  }
+
   SedRange::writeElements(stream);
 
-  if (hasValues())
+  char text[SedNumberFormatter::BUFFER_SIZE + 2];
+  for (std::vector<double>::const_iterator it = mValue.begin(); it !=
+    mValue.end(); ++it)
   {
-    for (std::vector<double>::const_iterator it = mValue.begin(); it !=
-      mValue.end(); ++it)
-    {
-      stream.startElement("value");
-      stream.setAutoIndent(false);
-      stream << " " << *it << " ";
-      stream.endElement("value");
-      stream.setAutoIndent(true);
-    }
+    text[0] = ' ';
+    unsigned int length = SedNumberFormatter::formatDouble(*it, text + 1);
+    text[length + 1] = ' ';
+    text[length + 2] = '\0';
+
+    stream.startElement("value");
+    stream.setAutoIndent(false);
+    stream << text;
+    stream.endElement("value");
+    stream.setAutoIndent(true);
   }
 }
 
@@ -251,7 +454,11 @@ SedVectorRange::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLOutputStream&
 bool
 SedVectorRange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
@@ -585,18 +792,40 @@ SedVectorRange::readOtherXML(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLInputStream&
 {
   bool read = false;
 
+  // the annotation is read as SedBase would, but may hold the values in
+  // compact form
+  if (stream.peek().getName() == "annotation")
+  {
+    if (mAnnotation != NULL)
+    {
+      string msg = "A SED-ML <" + getElementName() + "> element ";
+      msg += "has multiple <annotation> children.";
+      logError(SedMultipleAnnotations, getLevel(), getVersion(), msg);
+    }
+
+    delete mAnnotation;
+    mAnnotation = new LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode(stream);
+    checkAnnotation();
+    expandCompactValues();
+    read = true;
+  }
+
+  string text;
   while (stream.peek().getName() == "value")
   {
     stream.next();
-    stringstream text;
+    text.clear();
     while (stream.isGood() && stream.peek().isText())
     {
-      text << stream.next().getCharacters();
+      text += stream.next().getCharacters();
     }
 
+    const char* begin = text.c_str();
+    const char* end = begin + text.size();
+    while (begin != end && isspace((unsigned char)*begin)) ++begin;
+
     double value;
-    text >> value;
-    if (!text.fail())
+    if (SedNumberFormatter::parseDouble(begin, end, value) != NULL)
     {
       mValue.push_back(value);
     }
@@ -617,6 +846,89 @@ SedVectorRange::readOtherXML(LIBSBML_CPP_NAMESPACE_QUALIFIER XMLInputStream&
 
 
 
+/** @cond doxygenLibSEDMLInternal */
+
+/*
+ * Moves the values of a compact block in the annotation into this range,
+ * and removes the annotation if nothing else is left in it
+ */
+void
+SedVectorRange::expandCompactValues()
+{
+  if (mAnnotation == NULL) return;
+
+  for (unsigned int i = 0; i < mAnnotation->getNumChildren(); ++i)
+  {
+    const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& child =
+      mAnnotation->getChild(i);
+    if (child.getName() != "values" || child.getURI() != COMPACT_VALUES_URI)
+    {
+      continue;
+    }
+
+    string text;
+    for (unsigned int n = 0; n < child.getNumChildren(); ++n)
+    {
+      if (child.getChild(n).isText()) text += child.getChild(n).getCharacters();
+    }
+
+    // blocks that cannot be decoded, or whose number of values differs
+    // from their count, are reported and left where they are
+    if (child.getAttrValue("encoding") != "base64") continue;
+
+    vector<double> values;
+    string problem;
+    if (decodeValues(text, values, problem))
+    {
+      const string& count = child.getAttrValue("count");
+      double expected;
+      const char* end = count.c_str() + count.size();
+      if (SedNumberFormatter::parseDouble(count.c_str(), end, expected) != end
+        || expected != (double)values.size())
+      {
+        problem = "holds " + SedNumberFormatter::toString((double)values.size())
+          + " values, but its 'count' attribute is '" + count + "'";
+      }
+    }
+
+    if (!problem.empty())
+    {
+      string msg = "The compact <values> block of the <" + getElementName()
+        + "> element";
+      if (isSetId()) msg += " with id '" + getId() + "'";
+      msg += " " + problem + ".";
+      logError(SedmlVectorRangeValueMustBeString, getLevel(), getVersion(),
+        msg);
+      continue;
+    }
+
+    mValue.insert(mValue.end(), values.begin(), values.end());
+    mUseCompactEncoding = true;
+    delete mAnnotation->removeChild(i);
+    break;
+  }
+
+  for (unsigned int i = 0; i < mAnnotation->getNumChildren(); ++i)
+  {
+    const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& child =
+      mAnnotation->getChild(i);
+    if (!child.isText()) return;
+
+    const string& chars = child.getCharacters();
+    for (size_t n = 0; n < chars.size(); ++n)
+    {
+      if (!isspace((unsigned char)chars[n])) return;
+    }
+  }
+
+  delete mAnnotation;
+  mAnnotation = NULL;
+}
+
+/** @endcond */
+
+
+
 /** @cond doxygenLibSEDMLInternal */
 
 /*
@@ -33,6 +33,19 @@
  *
  * @class SedVectorRange
  * @sbmlbrief{sedml} TODO:Definition of the SedVectorRange class.
+ *
+ * The values of a SedVectorRange are written as one
+ * <code>&lt;value&gt;</code> element each, as text that reads back to
+ * the same double.  For ranges with many values, a compact encoding
+ * can be enabled with setUseCompactEncoding(): the values are
+ * then written as a single block of base64 encoded, little endian doubles
+ * inside the annotation, in an element
+ * <code>&lt;values count="..." encoding="base64"&gt;</code> of the
+ * namespace <code>https://github.com/fbergmann/libSEDML#vectorRange</code>.
+ * When such a range is read, the block is expanded into the values and
+ * removed from the annotation, so that it makes no difference to the
+ * caller which form was used.  Other SED-ML software does not know this
+ * encoding, so it should only be used for files read with libSEDML.
  */
 
 
@@ -65,6 +78,7 @@ protected:
   /** @cond doxygenLibSEDMLInternal */
 
   std::vector<double> mValue;
+  bool mUseCompactEncoding;
 
   /** @endcond */
 
@@ -94,7 +108,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedVectorRange(SedNamespaces *sedmlns);
+  SedVectorRange(const SedNamespaces *sedmlns);
 
 
   /**
@@ -189,6 +203,29 @@ public:
   int clearValues();
 
 
+  /**
+   * Sets whether the values of this SedVectorRange are written as a single
+   * block of base64 encoded doubles inside the annotation, rather than as
+   * one <code>&lt;value&gt;</code> element each.
+   *
+   * @param useCompactEncoding @c true to write the compact encoding.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   */
+  int setUseCompactEncoding(bool useCompactEncoding);
+
+
+  /**
+   * Predicate returning @c true if the values of this SedVectorRange are
+   * written in compact form.  This is the case for ranges read from such a
+   * form.
+   *
+   * @return @c true if the compact encoding is used, @c false otherwise.
+   */
+  bool getUseCompactEncoding() const;
+
+
   /**
    * Returns the XML element name of this SedVectorRange object.
    *
@@ -552,6 +589,17 @@ protected:
 
 
 
+  /** @cond doxygenLibSEDMLInternal */
+
+  /**
+   * Moves the values of a compact block in the annotation into this range
+   */
+  void expandCompactValues();
+
+  /** @endcond */
+
+
+
   /** @cond doxygenLibSEDMLInternal */
 
   /**
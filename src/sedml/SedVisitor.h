@@ -32,7 +32,16 @@
  * ------------------------------------------------------------------------ -->
  *
  * @class SedVisitor
- * @sbmlbrief{} TODO:Definition of the SedVisitor class.
+ * @sbmlbrief{} Visitor for walking a SED-ML document.
+ *
+ * Calling SedBase::accept() on an object walks the object and all objects
+ * it contains depth first, in the order used by SedBase::getAllElements().
+ * For every object the matching visit() method is called before its
+ * children are visited and the matching leave() method afterwards.  The
+ * values returned by visit() do not stop the traversal.
+ *
+ * To merely iterate over the objects of a document, forEachElement() and
+ * SedElementRange do the same walk without needing a SedVisitor subclass.
  */
 
 
@@ -63,7 +63,7 @@ SedWaterfallPlot::SedWaterfallPlot(unsigned int level, unsigned int version)
  * Creates a new SedWaterfallPlot using the given SedNamespaces object @p
  * sedmlns.
  */
-SedWaterfallPlot::SedWaterfallPlot(SedNamespaces *sedmlns)
+SedWaterfallPlot::SedWaterfallPlot(const SedNamespaces *sedmlns)
   : SedPlot(sedmlns)
   , mTaskReference ("")
 {
@@ -142,6 +142,8 @@ SedWaterfallPlot::isSetTaskReference() const
 int
 SedWaterfallPlot::setTaskReference(const std::string& taskReference)
 {
+  markChanged(CHANGE_REFERENCES);
+
   if (!(SyntaxChecker::isValidInternalSId(taskReference)))
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -160,6 +162,8 @@ SedWaterfallPlot::setTaskReference(const std::string& taskReference)
 int
 SedWaterfallPlot::unsetTaskReference()
 {
+  markChanged(CHANGE_REFERENCES);
+
   mTaskReference.erase();
 
   if (mTaskReference.empty() == true)
@@ -251,7 +255,11 @@ SedWaterfallPlot::writeElements(LIBSBML_CPP_NAMESPACE_QUALIFIER
 bool
 SedWaterfallPlot::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+  acceptChildElements(v);
+  v.leave(*this);
+
+  return result;
 }
 
 /** @endcond */
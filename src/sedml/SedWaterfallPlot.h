@@ -93,7 +93,7 @@ public:
    *
    * @copydetails doc_note_setting_lv_pkg
    */
-  SedWaterfallPlot(SedNamespaces *sedmlns);
+  SedWaterfallPlot(const SedNamespaces *sedmlns);
 
 
   /**
@@ -0,0 +1,393 @@
+/**
+ * @file SedWorkStealingPool.cpp
+ * @brief Implementation of the SedWorkStealingPool class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedWorkStealingPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+/*
+ * The jobs a thread has not started yet.
+ */
+struct SedJobRange
+{
+  mutex mMutex;
+  size_t mBegin;
+  size_t mEnd;
+};
+
+
+/*
+ * The threads of a SedWorkStealingPool and the batch they are running.
+ */
+struct SedPoolState
+{
+  SedPoolState()
+    : mMutex()
+    , mWake()
+    , mDone()
+    , mWorkers()
+    , mBatch(0)
+    , mNumBusy(0)
+    , mStop(false)
+    , mRanges()
+    , mNumRanges(0)
+    , mNumThreads(0)
+    , mJob(NULL)
+    , mFailed(false)
+    , mErrorMutex()
+    , mError()
+    , mRunMutex()
+  {
+  }
+
+  /*
+   * Takes the next job of the given thread.
+   */
+  bool pop(unsigned int thread, size_t& job)
+  {
+    SedJobRange& range = mRanges[thread];
+    lock_guard<mutex> lock(range.mMutex);
+
+    if (range.mBegin == range.mEnd) return false;
+
+    job = range.mBegin++;
+    return true;
+  }
+
+  /*
+   * Moves the upper half of the jobs of another thread to the given
+   * thread, and takes the first of them.
+   */
+  bool steal(unsigned int thread, size_t& job)
+  {
+    for (unsigned int i = 1; i < mNumThreads; ++i)
+    {
+      SedJobRange& victim = mRanges[(thread + i) % mNumThreads];
+      size_t begin;
+      size_t end;
+
+      {
+        lock_guard<mutex> lock(victim.mMutex);
+        size_t remaining = victim.mEnd - victim.mBegin;
+        if (remaining == 0) continue;
+
+        begin = victim.mBegin + remaining / 2;
+        end = victim.mEnd;
+        victim.mEnd = begin;
+      }
+
+      SedJobRange& range = mRanges[thread];
+      lock_guard<mutex> lock(range.mMutex);
+      range.mBegin = begin + 1;
+      range.mEnd = end;
+      job = begin;
+      return true;
+    }
+
+    return false;
+  }
+
+  /*
+   * Runs jobs of the current batch until none are left.
+   */
+  void work(unsigned int thread)
+  {
+    size_t index;
+    while (!mFailed && (pop(thread, index) || steal(thread, index)))
+    {
+      try
+      {
+        (*mJob)(index);
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lock(mErrorMutex);
+        if (!mError) mError = current_exception();
+        mFailed = true;
+      }
+    }
+  }
+
+  /*
+   * The loop of a worker thread: waits for a batch, helps with it if it
+   * takes part in it, and waits for the next one.
+   */
+  void serve(unsigned int thread, unsigned long batch);
+
+  /*
+   * Starts workers until there are @p numThreads threads, counting the
+   * thread that runs the batches.
+   */
+  void startWorkers(unsigned int numThreads);
+
+  unsigned int getNumThreads()
+  {
+    lock_guard<mutex> lock(mMutex);
+    return (unsigned int)mWorkers.size() + 1;
+  }
+
+  // guards the members up to mStop, and the hand-off of a batch
+  mutex mMutex;
+  condition_variable mWake;
+  condition_variable mDone;
+  vector<thread> mWorkers;
+  unsigned long mBatch;
+  unsigned int mNumBusy;
+  bool mStop;
+
+  // the current batch; only changed while no batch is running
+  unique_ptr<SedJobRange[]> mRanges;
+  unsigned int mNumRanges;
+  unsigned int mNumThreads;
+  const SedWorkStealingPool::Job* mJob;
+
+  atomic<bool> mFailed;
+  mutex mErrorMutex;
+  exception_ptr mError;
+
+  // lets one batch run at a time
+  mutex mRunMutex;
+};
+
+
+/*
+ * The pool the current thread is running jobs for, if any.
+ */
+static thread_local const SedPoolState* sCurrentPool = NULL;
+
+
+void
+SedPoolState::serve(unsigned int thread, unsigned long batch)
+{
+  sCurrentPool = this;
+
+  unique_lock<mutex> lock(mMutex);
+  for (;;)
+  {
+    mWake.wait(lock, [&]() { return mStop || mBatch != batch; });
+    if (mStop) return;
+
+    // a worker that takes part in a batch is waited for, so it never
+    // misses one
+    batch = mBatch;
+    if (thread >= mNumThreads) continue;
+
+    lock.unlock();
+    work(thread);
+    lock.lock();
+
+    if (--mNumBusy == 0) mDone.notify_one();
+  }
+}
+
+
+void
+SedPoolState::startWorkers(unsigned int numThreads)
+{
+  lock_guard<mutex> lock(mMutex);
+
+  for (unsigned int t = (unsigned int)mWorkers.size() + 1; t < numThreads;
+       ++t)
+  {
+    // if no more threads can be started, the batches are run by the
+    // threads that are running
+    try
+    {
+      mWorkers.push_back(thread(&SedPoolState::serve, this, t, mBatch));
+    }
+    catch (const system_error&)
+    {
+      break;
+    }
+  }
+}
+
+
+SedWorkStealingPool::SedWorkStealingPool (unsigned int numThreads)
+  : mState(new SedPoolState())
+{
+  mState->startWorkers(numThreads == 0 ? getDefaultNumThreads() : numThreads);
+}
+
+
+SedWorkStealingPool::~SedWorkStealingPool ()
+{
+  {
+    lock_guard<mutex> run(mState->mRunMutex);
+    lock_guard<mutex> lock(mState->mMutex);
+    mState->mStop = true;
+  }
+  mState->mWake.notify_all();
+
+  for (vector<thread>::iterator it = mState->mWorkers.begin();
+       it != mState->mWorkers.end(); ++it)
+  {
+    it->join();
+  }
+
+  delete mState;
+}
+
+
+void
+SedWorkStealingPool::runJobs (size_t numJobs, unsigned int numThreads,
+                              const Job& job)
+{
+  SedPoolState& state = *mState;
+
+  // the threads of this pool may all be waiting for the job that runs
+  // this batch, so its jobs are run right here
+  if (sCurrentPool == mState)
+  {
+    numThreads = 1;
+  }
+
+  if (numThreads == 0) numThreads = getNumThreads();
+  if (numThreads > numJobs) numThreads = (unsigned int)numJobs;
+
+  if (numThreads <= 1)
+  {
+    for (size_t i = 0; i < numJobs; ++i) job(i);
+    return;
+  }
+
+  lock_guard<mutex> run(state.mRunMutex);
+
+  state.startWorkers(numThreads);
+  numThreads = min(numThreads, state.getNumThreads());
+
+  if (state.mNumRanges < numThreads)
+  {
+    state.mRanges.reset(new SedJobRange[numThreads]);
+    state.mNumRanges = numThreads;
+  }
+
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    state.mRanges[t].mBegin = numJobs * t / numThreads;
+    state.mRanges[t].mEnd = numJobs * (t + 1) / numThreads;
+  }
+
+  state.mNumThreads = numThreads;
+  state.mJob = &job;
+  state.mFailed = false;
+  state.mError = exception_ptr();
+
+  {
+    lock_guard<mutex> lock(state.mMutex);
+    state.mNumBusy = numThreads - 1;
+    ++state.mBatch;
+  }
+  state.mWake.notify_all();
+
+  // the calling thread may itself be a worker of another pool
+  const SedPoolState* outer = sCurrentPool;
+  sCurrentPool = mState;
+  state.work(0);
+  sCurrentPool = outer;
+
+  {
+    unique_lock<mutex> lock(state.mMutex);
+    state.mDone.wait(lock, [&]() { return state.mNumBusy == 0; });
+  }
+
+  if (state.mError)
+  {
+    exception_ptr error;
+    swap(error, state.mError);
+    rethrow_exception(error);
+  }
+}
+
+
+unsigned int
+SedWorkStealingPool::getNumThreads () const
+{
+  return mState->getNumThreads();
+}
+
+
+void
+SedWorkStealingPool::run (size_t numJobs, unsigned int numThreads,
+                          const Job& job)
+{
+  getSharedPool().runJobs(numJobs,
+    (numThreads == 0) ? getDefaultNumThreads() : numThreads, job);
+}
+
+
+SedWorkStealingPool&
+SedWorkStealingPool::getSharedPool ()
+{
+  // never deleted: joining threads while the program exits can hang when
+  // the library is being unloaded
+  static SedWorkStealingPool* pool = new SedWorkStealingPool();
+  return *pool;
+}
+
+
+unsigned int
+SedWorkStealingPool::getDefaultNumThreads ()
+{
+  unsigned int numThreads = thread::hardware_concurrency();
+  return (numThreads == 0) ? 1 : numThreads;
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
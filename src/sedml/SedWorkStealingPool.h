@@ -0,0 +1,165 @@
+/**
+ * @file SedWorkStealingPool.h
+ * @brief Definition of the SedWorkStealingPool class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ *
+ * @class SedWorkStealingPool
+ * @sbmlbrief{} Runs independent jobs on a set of long-lived threads.
+ *
+ * The SedWorkStealingPool is used internally wherever libSEDML processes
+ * many independent items (documents, tasks, ...) in parallel.  Its worker
+ * threads are started once and then wait for work, so that running a
+ * batch of jobs only hands the batch to them.  The jobs are numbered, and
+ * each thread starts out with an equal share of the numbers.  A thread
+ * that has run out of jobs steals half of the jobs that another thread has
+ * not started yet, so that threads stay busy even when jobs take very
+ * different amounts of time.
+ *
+ * A pool runs one batch at a time.  A job that runs a batch on the pool it
+ * is running on gets its jobs run one after the other on its own thread,
+ * so nested parallel loops never wait for threads that are busy with the
+ * outer loop.
+ */
+
+
+#ifndef SedWorkStealingPool_h
+#define SedWorkStealingPool_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <functional>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/** @cond doxygenLibsedmlInternal */
+struct SedPoolState;
+
+
+class LIBSEDML_EXTERN SedWorkStealingPool
+{
+public:
+
+  typedef std::function<void (size_t)> Job;
+
+
+  /**
+   * Creates a pool that runs jobs on @p numThreads threads, the thread
+   * calling runJobs() included.
+   *
+   * @param numThreads the number of threads, or 0 for
+   * getDefaultNumThreads().
+   */
+  explicit SedWorkStealingPool (unsigned int numThreads = 0);
+
+
+  /**
+   * Stops the worker threads of this pool, once they have finished the
+   * batch they are running.
+   */
+  ~SedWorkStealingPool ();
+
+
+  /**
+   * Calls @p job once for every number from 0 to @p numJobs - 1, on up to
+   * @p numThreads threads, and returns once all calls have returned.  The
+   * calling thread is one of the threads.  If @p numThreads exceeds the
+   * size of the pool, the pool starts further workers and keeps them; if
+   * the system cannot start as many threads, the jobs are run on those
+   * that are running.
+   *
+   * If a job throws, the remaining jobs are skipped and the first
+   * exception is rethrown in the calling thread.
+   *
+   * @param numJobs the number of jobs.
+   * @param numThreads the number of threads, or 0 for the size of the
+   * pool.
+   * @param job the function to call.
+   */
+  void runJobs (size_t numJobs, unsigned int numThreads, const Job& job);
+
+
+  /**
+   * @return the number of threads of this pool, the calling thread
+   * included.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Calls runJobs() on the pool returned by getSharedPool().
+   *
+   * @param numJobs the number of jobs.
+   * @param numThreads the number of threads, or 0 for
+   * getDefaultNumThreads().
+   * @param job the function to call.
+   */
+  static void run (size_t numJobs, unsigned int numThreads, const Job& job);
+
+
+  /**
+   * @return the pool shared by all of libSEDML, which is started with
+   * getDefaultNumThreads() threads on first use.
+   */
+  static SedWorkStealingPool& getSharedPool ();
+
+
+  /**
+   * @return the number of threads the hardware can run concurrently, or 1
+   * if that is not known.
+   */
+  static unsigned int getDefaultNumThreads ();
+
+
+private:
+
+  SedWorkStealingPool (const SedWorkStealingPool& orig);
+  SedWorkStealingPool& operator= (const SedWorkStealingPool& rhs);
+
+  SedPoolState* mState;
+};
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedWorkStealingPool_h */
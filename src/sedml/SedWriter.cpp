@@ -33,10 +33,25 @@
  */
 
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <ios>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <streambuf>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <sedml/common/common.h>
 #include <sbml/xml/XMLOutputStream.h>
@@ -44,6 +59,8 @@
 #include <sedml/SedError.h>
 #include <sedml/SedErrorLog.h>
 #include <sedml/SedDocument.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedVectorRange.h>
 #include <sedml/SedWriter.h>
 
 #include <sbml/compress/CompressCommon.h>
@@ -59,6 +76,248 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 
 #ifdef __cplusplus
 
+/** @cond doxygenLibsedmlInternal */
+
+namespace
+{
+
+/*
+ * Stream buffer that writes straight into the storage of a string, growing
+ * it as needed.  finish() trims the string to the written text.
+ */
+class StringSinkBuffer : public std::streambuf
+{
+public:
+
+  StringSinkBuffer (std::string& buffer)
+    : mBuffer(buffer)
+    , mOriginalSize(buffer.size())
+  {
+    grow(mOriginalSize, 0);
+  }
+
+  void finish (bool success)
+  {
+    size_t used = success ? size() : mOriginalSize;
+    setp(NULL, NULL);
+    mBuffer.resize(used);
+  }
+
+protected:
+
+  virtual int_type overflow (int_type c)
+  {
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      return traits_type::not_eof(c);
+    }
+
+    grow(size(), 1);
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+  }
+
+  virtual std::streamsize xsputn (const char* s, std::streamsize n)
+  {
+    size_t used = size();
+    if ((size_t)(epptr() - pptr()) < (size_t)n)
+    {
+      grow(used, (size_t)n);
+    }
+
+    memcpy(pptr(), s, (size_t)n);
+    setp(&mBuffer[0] + used + n, &mBuffer[0] + mBuffer.size());
+    return n;
+  }
+
+private:
+
+  size_t size () const
+  {
+    return (pptr() == NULL) ? mBuffer.size() : (size_t)(pptr() - &mBuffer[0]);
+  }
+
+  // makes room for at least count more characters after used ones
+  void grow (size_t used, size_t count)
+  {
+    size_t length = max(mBuffer.capacity(), (size_t)256);
+    while (length < used + count) length *= 2;
+    mBuffer.resize(length);
+    setp(&mBuffer[0] + used, &mBuffer[0] + mBuffer.size());
+  }
+
+  std::string& mBuffer;
+  size_t mOriginalSize;
+};
+
+
+/*
+ * Stream buffer that collects the text in a chunk of fixed size and hands
+ * full chunks to write().  Text longer than a chunk is passed on directly.
+ */
+class ChunkSinkBuffer : public std::streambuf
+{
+public:
+
+  ChunkSinkBuffer (size_t chunkSize)
+    : mChunk(max(chunkSize, (size_t)1))
+  {
+    setp(&mChunk[0], &mChunk[0] + mChunk.size());
+  }
+
+  virtual ~ChunkSinkBuffer ()
+  {
+  }
+
+protected:
+
+  virtual bool write (const char* data, size_t length) = 0;
+
+  virtual int_type overflow (int_type c)
+  {
+    if (!flushChunk()) return traits_type::eof();
+
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+  }
+
+  virtual std::streamsize xsputn (const char* s, std::streamsize n)
+  {
+    size_t length = (size_t)n;
+    size_t available = (size_t)(epptr() - pptr());
+    if (length <= available)
+    {
+      memcpy(pptr(), s, length);
+      pbump((int)length);
+      return n;
+    }
+
+    if (!flushChunk()) return 0;
+    if (length >= mChunk.size())
+    {
+      return write(s, length) ? n : 0;
+    }
+
+    memcpy(pptr(), s, length);
+    pbump((int)length);
+    return n;
+  }
+
+  virtual int sync ()
+  {
+    return flushChunk() ? 0 : -1;
+  }
+
+private:
+
+  bool flushChunk ()
+  {
+    size_t length = (size_t)(pptr() - pbase());
+    setp(&mChunk[0], &mChunk[0] + mChunk.size());
+    return length == 0 || write(&mChunk[0], length);
+  }
+
+  std::vector<char> mChunk;
+};
+
+
+class CallbackSinkBuffer : public ChunkSinkBuffer
+{
+public:
+
+  CallbackSinkBuffer (const SedWriter::ChunkSink& sink, size_t chunkSize)
+    : ChunkSinkBuffer(chunkSize)
+    , mSink(sink)
+  {
+  }
+
+protected:
+
+  virtual bool write (const char* data, size_t length)
+  {
+    return mSink(data, length);
+  }
+
+private:
+
+  const SedWriter::ChunkSink& mSink;
+};
+
+
+class FileDescriptorSinkBuffer : public ChunkSinkBuffer
+{
+public:
+
+  FileDescriptorSinkBuffer (int fd)
+    : ChunkSinkBuffer(65536)
+    , mFd(fd)
+  {
+  }
+
+protected:
+
+  virtual bool write (const char* data, size_t length)
+  {
+    while (length > 0)
+    {
+#ifdef _WIN32
+      unsigned int count = (unsigned int)min(length, (size_t)(1 << 30));
+      int written = _write(mFd, data, count);
+#else
+      ssize_t written = ::write(mFd, data, length);
+#endif
+      if (written < 0 && errno == EINTR) continue;
+      if (written <= 0) return false;
+
+      data += written;
+      length -= (size_t)written;
+    }
+
+    return true;
+  }
+
+private:
+
+  int mFd;
+};
+
+
+/*
+ * Opens the named file for writing without any stream on top.
+ */
+int
+openForWriting (const std::string& filename)
+{
+#ifdef _WIN32
+  return _open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+               _S_IREAD | _S_IWRITE);
+#else
+  return open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+#endif
+}
+
+
+void
+closeFile (int fd)
+{
+#ifdef _WIN32
+  _close(fd);
+#else
+  close(fd);
+#endif
+}
+
+}
+
+/** @endcond */
+
+
 /*
  * Creates a new SedWriter.
  */
@@ -133,13 +392,14 @@ bool
 SedWriter::writeSedML (const SedDocument* d, const std::string& filename)
 {
   std::ostream* stream = NULL;
+  bool uncompressed = false;
 
   try
   {
     // open an uncompressed XML file.
     if ( string::npos != filename.find(".xml", filename.length() - 4) )
     {
-      stream = new(std::nothrow) std::ofstream(filename.c_str());
+      uncompressed = true;
     }
     // open a gzip file
     else if ( string::npos != filename.find(".gz", filename.length() - 3) )
@@ -180,7 +440,7 @@ SedWriter::writeSedML (const SedDocument* d, const std::string& filename)
     }
     else
     {
-      stream = new(std::nothrow) std::ofstream(filename.c_str());
+      uncompressed = true;
     }
   }
   catch ( ZlibNotLinked& )
@@ -205,6 +465,22 @@ SedWriter::writeSedML (const SedDocument* d, const std::string& filename)
   } 
 
 
+  // plain files are written without a stream of their own
+  if (uncompressed)
+  {
+    int fd = openForWriting(filename);
+    if (fd < 0)
+    {
+      SedErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
+      log->logError(XMLFileUnwritable);
+      return false;
+    }
+
+    bool result = writeSedMLToFileDescriptor(d, fd);
+    closeFile(fd);
+    return result;
+  }
+
   if ( stream == NULL || stream->fail() || stream->bad())
   {
     SedErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
@@ -265,10 +541,11 @@ LIBSEDML_EXTERN
 char*
 SedWriter::writeToString (const SedDocument* d)
 {
-  ostringstream stream;
-  writeSedML(d, stream);
+  std::string buffer;
+  buffer.reserve(estimateSize(d));
+  writeSedMLToBuffer(d, buffer);
 
-  return safe_strdup( stream.str().c_str() );
+  return safe_strdup( buffer.c_str() );
 }
 
 std::string 
@@ -276,9 +553,10 @@ SedWriter::writeSedMLToStdString(const SedDocument* d)
 {
   if (d == NULL) return "";
   
-  ostringstream stream;
-  writeSedML(d, stream);
-  return stream.str();
+  std::string buffer;
+  buffer.reserve(estimateSize(d));
+  writeSedMLToBuffer(d, buffer);
+  return buffer;
 }
 
 LIBSEDML_EXTERN
@@ -298,6 +576,83 @@ SedWriter::writeSedMLToFile (const SedDocument* d, const std::string& filename)
 }
 
 
+/*
+ * Writes the given SedDocument into the storage of the given string,
+ * appending to its content.
+ */
+bool
+SedWriter::writeSedMLToBuffer (const SedDocument* d, std::string& buffer)
+{
+  if (d == NULL) return false;
+
+  StringSinkBuffer sink(buffer);
+  std::ostream stream(&sink);
+  bool result = writeSedML(d, stream);
+  sink.finish(result);
+
+  return result;
+}
+
+
+/*
+ * Writes the given SedDocument in chunks to the given callback.
+ */
+bool
+SedWriter::writeSedMLToSink (const SedDocument* d, const ChunkSink& sink,
+                             size_t chunkSize)
+{
+  if (d == NULL || !sink) return false;
+
+  CallbackSinkBuffer buffer(sink, chunkSize);
+  std::ostream stream(&buffer);
+  return writeSedML(d, stream);
+}
+
+
+/*
+ * Writes the given SedDocument to an open file descriptor.
+ */
+bool
+SedWriter::writeSedMLToFileDescriptor (const SedDocument* d, int fd)
+{
+  if (d == NULL || fd < 0) return false;
+
+  FileDescriptorSinkBuffer buffer(fd);
+  std::ostream stream(&buffer);
+  return writeSedML(d, stream);
+}
+
+
+/*
+ * Estimates the size of the given SedDocument once written, from the
+ * number of its elements and vector range values.
+ */
+size_t
+SedWriter::estimateSize (const SedDocument* d) const
+{
+  if (d == NULL) return 0;
+
+  // the XML declaration, the comment and the document element
+  size_t size = 512 + mProgramName.size() + mProgramVersion.size();
+
+  SedElementIterator<const SedBase> end;
+  for (SedElementIterator<const SedBase> it(d); it != end; ++it)
+  {
+    const SedBase* element = *it;
+    size += 128;
+
+    if (element->getTypeCode() == SEDML_RANGE_VECTORRANGE)
+    {
+      const SedVectorRange* range = static_cast<const SedVectorRange*>(element);
+      size_t perValue = range->getUseCompactEncoding() ? 11 : 48;
+      size += perValue * range->getNumValues();
+    }
+  }
+
+  return size;
+}
+
+
 /*
  * Predicate returning @c true if
  * underlying libSEDML is linked with zlib.
@@ -404,6 +759,19 @@ SedWriter_writeSedMLToString (SedWriter_t *sw, const SedDocument_t *d)
 }
 
 
+LIBSEDML_EXTERN
+int
+SedWriter_writeSedMLToFileDescriptor (SedWriter_t         *sw,
+                                      const SedDocument_t *d,
+                                      int                  fd)
+{
+  if (sw == NULL || d == NULL) 
+    return 0;
+  else
+    return static_cast<int>( sw->writeSedMLToFileDescriptor(d, fd) );
+}
+
+
 LIBSEDML_EXTERN
 int
 SedWriter_hasZlib ()
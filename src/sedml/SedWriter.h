@@ -47,6 +47,8 @@
 #ifdef __cplusplus
 
 
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <string>
 
@@ -238,8 +240,87 @@ public:
    * @see setProgramName(const std::string& name)
    */
   std::string writeSedMLToStdString(const SedDocument* d);
+
+
+  /**
+   * Callback receiving the serialized document in consecutive chunks.
+   *
+   * The data is only valid for the duration of the call.  Returning
+   * @c false aborts writing.
+   */
+  typedef std::function<bool (const char* data, size_t length)> ChunkSink;
+
+
+  /**
+   * Writes the given SedDocument directly into the given buffer, appending
+   * to its current content.
+   *
+   * The document is serialized into the storage of @p buffer without any
+   * intermediate copy, so that reserving capacity beforehand (see
+   * estimateSize()) avoids all reallocations.  If writing fails, @p buffer
+   * is left with its original content.
+   *
+   * @param d the SedDocument to be written
+   *
+   * @param buffer the string that the SED-ML is appended to.
+   *
+   * @return @c true on success and @c false if one of the underlying
+   * parser components fail.
+   *
+   * @see estimateSize(const SedDocument* d)
+   */
+  bool writeSedMLToBuffer (const SedDocument* d, std::string& buffer);
+
+
+  /**
+   * Writes the given SedDocument in chunks of the given size to a callback,
+   * for example to hand it to a network connection as it is produced.
+   *
+   * Only one chunk is held in memory at any time; text longer than a chunk
+   * is passed on without being copied.
+   *
+   * @param d the SedDocument to be written
+   *
+   * @param sink the callback receiving the chunks.
+   *
+   * @param chunkSize the size of the chunks, at least 1.
+   *
+   * @return @c true on success and @c false if @p sink returned @c false
+   * or one of the underlying parser components fail.
+   */
+  bool writeSedMLToSink (const SedDocument* d, const ChunkSink& sink,
+                         size_t chunkSize = 65536);
 #endif
-  
+
+
+  /**
+   * Writes the given SedDocument to an open file descriptor, which is
+   * neither rewound nor closed.
+   *
+   * @param d the SedDocument to be written
+   *
+   * @param fd a file descriptor opened for writing, for example a socket,
+   * pipe or file.
+   *
+   * @return @c true on success and @c false if the data could not be
+   * written.
+   */
+  bool writeSedMLToFileDescriptor (const SedDocument* d, int fd);
+
+
+  /**
+   * Returns an estimate of the number of bytes the given SedDocument takes
+   * once written, for reserving buffers ahead of writeSedMLToBuffer().
+   *
+   * The estimate is based on the number of elements in the document, and
+   * may be off by a factor of two either way.
+   *
+   * @param d the SedDocument to be written
+   *
+   * @return the estimated size in bytes, or @c 0 if @p d is @c NULL.
+   */
+  size_t estimateSize (const SedDocument* d) const;
+
 
   /**
    * Predicate returning @c true if this copy of libSEDML has been linked
@@ -450,6 +531,21 @@ char *
 SedWriter_writeSedMLToString (SedWriter_t *sw, const SedDocument_t *d);
 
 
+/**
+ * Writes the given SedDocument to an open file descriptor, which is
+ * neither rewound nor closed.
+ *
+ * @return non-zero on success and zero if the data could not be written.
+ *
+ * @memberof SedWriter_t
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_writeSedMLToFileDescriptor (SedWriter_t         *sw,
+                                      const SedDocument_t *d,
+                                      int                  fd);
+
+
 /**
  * Predicate returning @c non-zero or @c zero depending on whether
  * libSEDML is linked with zlib at compile time.
@@ -0,0 +1,570 @@
+/**
+ * @file SedXPathSelector.cpp
+ * @brief Implementation of the SedXPathSelector class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sedml/SedXPathSelector.h>
+#include <sedml/common/SedOperationReturnValues.h>
+
+#include <sbml/xml/XMLNode.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <unordered_set>
+
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygenLibsedmlInternal */
+
+enum SedXPathComparison
+{
+  SED_XPATH_EXISTS
+, SED_XPATH_EQUALS
+, SED_XPATH_NOT_EQUALS
+};
+
+/*
+ * Marks the context of the first step: the document, whose only child is
+ * the root element.
+ */
+static const unsigned int SED_XPATH_DOCUMENT = (unsigned int)-1;
+
+
+/*
+ * Reads a possibly prefixed name, and returns its local part.
+ */
+static bool
+readName(const std::string& xpath, size_t& pos, std::string& name)
+{
+  size_t start = pos;
+  while (pos < xpath.size()
+    && (isalnum((unsigned char)xpath[pos]) || xpath[pos] == '_'
+     || xpath[pos] == '-' || xpath[pos] == '.' || xpath[pos] == ':'))
+  {
+    ++pos;
+  }
+
+  if (pos == start) return false;
+
+  name = xpath.substr(start, pos - start);
+  size_t colon = name.rfind(':');
+  if (colon != string::npos) name = name.substr(colon + 1);
+  return !name.empty();
+}
+
+
+/*
+ * Reads a quoted string, or an unquoted value such as a number.
+ */
+static bool
+readLiteral(const std::string& xpath, size_t& pos, std::string& value)
+{
+  if (pos >= xpath.size()) return false;
+
+  char quote = xpath[pos];
+  if (quote == '\'' || quote == '"')
+  {
+    size_t end = xpath.find(quote, pos + 1);
+    if (end == string::npos) return false;
+
+    value = xpath.substr(pos + 1, end - pos - 1);
+    pos = end + 1;
+    return true;
+  }
+
+  size_t start = pos;
+  while (pos < xpath.size() && xpath[pos] != ']' && xpath[pos] != ' ')
+  {
+    ++pos;
+  }
+
+  value = xpath.substr(start, pos - start);
+  return !value.empty();
+}
+
+
+static void
+skipSpace(const std::string& xpath, size_t& pos)
+{
+  while (pos < xpath.size() && isspace((unsigned char)xpath[pos])) ++pos;
+}
+
+
+/*
+ * Returns the value of the attribute with the given local name.
+ */
+static bool
+getAttribute(const XMLNode& element, const std::string& name,
+             std::string& value)
+{
+  for (int i = 0; i < element.getAttributesLength(); ++i)
+  {
+    if (element.getAttrName(i) == name)
+    {
+      value = element.getAttrValue(i);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+/*
+ * Adds the given context and all elements below it, in document order.
+ */
+static void
+collectDescendants(const SedXPathSelector::Match& context,
+                   std::vector<SedXPathSelector::Match>& result)
+{
+  result.push_back(context);
+
+  if (context.index == SED_XPATH_DOCUMENT)
+  {
+    SedXPathSelector::Match root = { NULL, 0, context.element };
+    collectDescendants(root, result);
+    return;
+  }
+
+  XMLNode* element = context.element;
+  for (unsigned int i = 0; i < element->getNumChildren(); ++i)
+  {
+    XMLNode& child = element->getChild(i);
+    if (!child.isElement()) continue;
+
+    SedXPathSelector::Match match = { element, i, &child };
+    collectDescendants(match, result);
+  }
+}
+
+/** @endcond */
+
+
+SedXPathSelector::SedXPathSelector ()
+  : mExpression()
+  , mSteps()
+  , mAttribute()
+  , mIsCompiled(false)
+{
+}
+
+
+SedXPathSelector::SedXPathSelector (const std::string& xpath)
+  : mExpression()
+  , mSteps()
+  , mAttribute()
+  , mIsCompiled(false)
+{
+  compile(xpath);
+}
+
+
+SedXPathSelector::~SedXPathSelector ()
+{
+}
+
+
+int
+SedXPathSelector::compile (const std::string& xpath)
+{
+  clear();
+  mExpression = xpath;
+
+  size_t pos = 0;
+  skipSpace(xpath, pos);
+
+  while (pos < xpath.size())
+  {
+    bool isDescendant = false;
+    if (xpath[pos] == '/')
+    {
+      ++pos;
+      if (pos < xpath.size() && xpath[pos] == '/')
+      {
+        isDescendant = true;
+        ++pos;
+      }
+    }
+    else if (!mSteps.empty())
+    {
+      clear();
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+
+    skipSpace(xpath, pos);
+
+    if (pos < xpath.size() && xpath[pos] == '@')
+    {
+      // the attribute step has to be the last one
+      ++pos;
+      if (isDescendant || mSteps.empty()
+        || !readName(xpath, pos, mAttribute))
+      {
+        clear();
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+      }
+
+      skipSpace(xpath, pos);
+      if (pos != xpath.size())
+      {
+        clear();
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+      }
+      break;
+    }
+
+    Step step;
+    step.isDescendant = isDescendant;
+
+    if (pos < xpath.size() && xpath[pos] == '*')
+    {
+      step.name = "*";
+      ++pos;
+    }
+    else if (!readName(xpath, pos, step.name))
+    {
+      clear();
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+
+    skipSpace(xpath, pos);
+
+    while (pos < xpath.size() && xpath[pos] == '[')
+    {
+      ++pos;
+      skipSpace(xpath, pos);
+
+      Predicate predicate;
+      predicate.position = 0;
+
+      if (pos < xpath.size() && isdigit((unsigned char)xpath[pos]))
+      {
+        predicate.position = (unsigned int)strtoul(xpath.c_str() + pos, NULL, 10);
+        while (pos < xpath.size() && isdigit((unsigned char)xpath[pos])) ++pos;
+        if (predicate.position == 0)
+        {
+          clear();
+          return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+        }
+      }
+      else
+      {
+        for (;;)
+        {
+          Condition condition;
+          condition.comparison = SED_XPATH_EXISTS;
+
+          if (pos >= xpath.size() || xpath[pos] != '@')
+          {
+            clear();
+            return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+          }
+          ++pos;
+
+          if (!readName(xpath, pos, condition.attribute))
+          {
+            clear();
+            return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+          }
+          skipSpace(xpath, pos);
+
+          if (xpath.compare(pos, 2, "!=") == 0)
+          {
+            condition.comparison = SED_XPATH_NOT_EQUALS;
+            pos += 2;
+          }
+          else if (xpath.compare(pos, 1, "=") == 0)
+          {
+            condition.comparison = SED_XPATH_EQUALS;
+            pos += 1;
+          }
+
+          if (condition.comparison != SED_XPATH_EXISTS)
+          {
+            skipSpace(xpath, pos);
+            if (!readLiteral(xpath, pos, condition.value))
+            {
+              clear();
+              return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+            }
+            skipSpace(xpath, pos);
+          }
+
+          predicate.conditions.push_back(condition);
+
+          if (xpath.compare(pos, 3, "and") != 0) break;
+          pos += 3;
+          skipSpace(xpath, pos);
+        }
+      }
+
+      skipSpace(xpath, pos);
+      if (pos >= xpath.size() || xpath[pos] != ']')
+      {
+        clear();
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+      }
+      ++pos;
+      skipSpace(xpath, pos);
+
+      step.predicates.push_back(predicate);
+    }
+
+    mSteps.push_back(step);
+  }
+
+  if (mSteps.empty())
+  {
+    clear();
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  mIsCompiled = true;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+bool
+SedXPathSelector::isCompiled () const
+{
+  return mIsCompiled;
+}
+
+
+const std::string&
+SedXPathSelector::getExpression () const
+{
+  return mExpression;
+}
+
+
+bool
+SedXPathSelector::selectsAttribute () const
+{
+  return !mAttribute.empty();
+}
+
+
+const std::string&
+SedXPathSelector::getAttributeName () const
+{
+  return mAttribute;
+}
+
+
+unsigned int
+SedXPathSelector::select (XMLNode& root, std::vector<Match>& matches) const
+{
+  matches.clear();
+  if (!mIsCompiled) return 0;
+
+  Match document = { NULL, SED_XPATH_DOCUMENT, &root };
+  matches.push_back(document);
+
+  vector<Match> next;
+  vector<Match> contexts;
+
+  for (vector<Step>::const_iterator step = mSteps.begin();
+       step != mSteps.end(); ++step)
+  {
+    next.clear();
+
+    if (step->isDescendant)
+    {
+      unordered_set<XMLNode*> seen;
+      vector<Match> selected;
+
+      for (vector<Match>::const_iterator it = matches.begin();
+           it != matches.end(); ++it)
+      {
+        contexts.clear();
+        collectDescendants(*it, contexts);
+
+        for (vector<Match>::const_iterator context = contexts.begin();
+             context != contexts.end(); ++context)
+        {
+          selected.clear();
+          selectChildren(*step, *context, selected);
+
+          // nested contexts can select the same element more than once
+          for (vector<Match>::const_iterator match = selected.begin();
+               match != selected.end(); ++match)
+          {
+            if (seen.insert(match->element).second) next.push_back(*match);
+          }
+        }
+      }
+    }
+    else
+    {
+      for (vector<Match>::const_iterator it = matches.begin();
+           it != matches.end(); ++it)
+      {
+        selectChildren(*step, *it, next);
+      }
+    }
+
+    matches.swap(next);
+    if (matches.empty()) break;
+  }
+
+  return (unsigned int)matches.size();
+}
+
+
+XMLNode*
+SedXPathSelector::selectFirst (XMLNode& root) const
+{
+  vector<Match> matches;
+  if (select(root, matches) == 0) return NULL;
+  return matches[0].element;
+}
+
+
+/** @cond doxygenLibsedmlInternal */
+
+void
+SedXPathSelector::clear ()
+{
+  mSteps.clear();
+  mAttribute.clear();
+  mIsCompiled = false;
+}
+
+
+/*
+ * Checks the name test of the given step.
+ */
+bool
+SedXPathSelector::matches (const Step& step, const XMLNode& element) const
+{
+  return step.name == "*" || step.name == element.getName();
+}
+
+
+/*
+ * Adds the children of the given context that pass the name test and the
+ * predicates of the given step.
+ */
+void
+SedXPathSelector::selectChildren (const Step& step, const Match& context,
+                                  std::vector<Match>& result) const
+{
+  vector<Match> candidates;
+
+  if (context.index == SED_XPATH_DOCUMENT)
+  {
+    if (matches(step, *context.element))
+    {
+      Match root = { NULL, 0, context.element };
+      candidates.push_back(root);
+    }
+  }
+  else
+  {
+    XMLNode* element = context.element;
+    for (unsigned int i = 0; i < element->getNumChildren(); ++i)
+    {
+      XMLNode& child = element->getChild(i);
+      if (child.isElement() && matches(step, child))
+      {
+        Match match = { element, i, &child };
+        candidates.push_back(match);
+      }
+    }
+  }
+
+  for (vector<Predicate>::const_iterator predicate = step.predicates.begin();
+       predicate != step.predicates.end() && !candidates.empty(); ++predicate)
+  {
+    vector<Match> kept;
+
+    if (predicate->position > 0)
+    {
+      if (predicate->position <= candidates.size())
+      {
+        kept.push_back(candidates[predicate->position - 1]);
+      }
+    }
+    else
+    {
+      for (vector<Match>::const_iterator it = candidates.begin();
+           it != candidates.end(); ++it)
+      {
+        bool isMatch = true;
+
+        for (vector<Condition>::const_iterator condition =
+               predicate->conditions.begin();
+             isMatch && condition != predicate->conditions.end(); ++condition)
+        {
+          string value;
+          bool hasValue = getAttribute(*it->element, condition->attribute, value);
+
+          switch (condition->comparison)
+          {
+          case SED_XPATH_EQUALS:
+            isMatch = hasValue && value == condition->value;
+            break;
+          case SED_XPATH_NOT_EQUALS:
+            isMatch = hasValue && value != condition->value;
+            break;
+          default:
+            isMatch = hasValue;
+            break;
+          }
+        }
+
+        if (isMatch) kept.push_back(*it);
+      }
+    }
+
+    candidates.swap(kept);
+  }
+
+  result.insert(result.end(), candidates.begin(), candidates.end());
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
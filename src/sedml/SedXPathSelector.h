@@ -0,0 +1,224 @@
+/**
+ * @file SedXPathSelector.h
+ * @brief Definition of the SedXPathSelector class.
+ * @author Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML. Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+
+ * Copyright (c) 2013-2019, Frank T. Bergmann
+ * All rights reserved.
+ *
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation. A copy of the license agreement is provided in the
+ * file named "LICENSE.txt" included with this software distribution and also
+ * available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ *
+ * @class SedXPathSelector
+ * @sbmlbrief{} An XPath expression compiled for selecting parts of a
+ * model.
+ *
+ * The "target" attribute of changes and variables is an XPath expression
+ * into the XML of a model.  A SedXPathSelector parses such an expression
+ * once, so that it can then be applied to any number of XMLNode trees
+ * without being parsed again.
+ *
+ * The subset of XPath used by SED-ML is supported: absolute paths of
+ * child (@c /) and descendant (<code>//</code>) steps, name tests with
+ * an optional prefix or @c *, predicates testing attributes (such as
+ * <code>[@id='k1']</code>, <code>[@id!='k1']</code> or
+ * <code>[@id]</code>, combined with @c and) or the position of an
+ * element (such as <code>[2]</code>), and a final attribute step (such as
+ * <code>/@value</code>).  Name tests compare local names only: SED-ML
+ * documents frequently bind the @c sbml prefix to a different SBML Level
+ * and Version than the one of the model, so prefixes are not resolved.
+ */
+
+
+#ifndef SedXPathSelector_h
+#define SedXPathSelector_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sbml/common/libsbml-namespace.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+class XMLNode;
+LIBSBML_CPP_NAMESPACE_END
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedXPathSelector
+{
+public:
+
+  /**
+   * An element selected by a SedXPathSelector.
+   */
+  struct Match
+  {
+    /** the parent of the element, or @c NULL for the root element */
+    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* parent;
+
+    /** the index of the element among the children of its parent */
+    unsigned int index;
+
+    /** the selected element */
+    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* element;
+  };
+
+
+  /**
+   * Creates a new SedXPathSelector that selects nothing.
+   */
+  SedXPathSelector ();
+
+
+  /**
+   * Creates a new SedXPathSelector for the given expression.
+   *
+   * @param xpath the XPath expression; check isCompiled() to see whether
+   * it could be compiled.
+   */
+  explicit SedXPathSelector (const std::string& xpath);
+
+
+  /**
+   * Destroys this SedXPathSelector.
+   */
+  ~SedXPathSelector ();
+
+
+  /**
+   * Compiles the given XPath expression.
+   *
+   * @param xpath the XPath expression.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sedmlconstant{LIBSEDML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sedmlconstant{LIBSEDML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   * if @p xpath is not supported; the selector then selects nothing.
+   */
+  int compile (const std::string& xpath);
+
+
+  /**
+   * @return @c true if an expression has been compiled successfully.
+   */
+  bool isCompiled () const;
+
+
+  /**
+   * @return the expression passed to compile().
+   */
+  const std::string& getExpression () const;
+
+
+  /**
+   * @return @c true if the expression selects an attribute of the
+   * selected elements, rather than the elements themselves.
+   */
+  bool selectsAttribute () const;
+
+
+  /**
+   * @return the local name of the selected attribute, or an empty string.
+   */
+  const std::string& getAttributeName () const;
+
+
+  /**
+   * Selects the elements of the given XML tree that the expression
+   * matches, in document order.  If the expression ends with an
+   * attribute step, the elements holding the attribute are selected,
+   * whether or not they already have it.
+   *
+   * @param root the root element of the XML tree.
+   * @param matches vector receiving the selected elements.
+   *
+   * @return the number of selected elements.
+   */
+  unsigned int select (LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& root,
+                       std::vector<Match>& matches) const;
+
+
+  /**
+   * @return the first element of the given XML tree that the expression
+   * matches, or @c NULL.
+   */
+  LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode* selectFirst (
+    LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& root) const;
+
+
+private:
+
+  /** @cond doxygenLibsedmlInternal */
+
+  struct Condition
+  {
+    std::string attribute;
+    int comparison;
+    std::string value;
+  };
+
+  struct Predicate
+  {
+    unsigned int position;
+    std::vector<Condition> conditions;
+  };
+
+  struct Step
+  {
+    bool isDescendant;
+    std::string name;
+    std::vector<Predicate> predicates;
+  };
+
+  void clear ();
+  bool matches (const Step& step,
+                const LIBSBML_CPP_NAMESPACE_QUALIFIER XMLNode& element) const;
+  void selectChildren (const Step& step, const Match& context,
+                       std::vector<Match>& result) const;
+
+  std::string mExpression;
+  std::vector<Step> mSteps;
+  std::string mAttribute;
+  bool mIsCompiled;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedXPathSelector_h */
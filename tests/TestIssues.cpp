@@ -38,6 +38,7 @@
  */
 
 #include "catch.hpp"
+#include <algorithm>
 #include <limits>
 
 #include <iostream>
@@ -55,7 +56,13 @@
 #include <sbml/math/L3Parser.h>
 
 #include <sedml/SedTypes.h>
+#include <sedml/SedWorkStealingPool.h>
+#include <cstdio>
+#include <fstream>
 #include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
 
 /** @cond doxygenIgnored */
 
@@ -974,3 +981,2576 @@ TEST_CASE("Redirect getLog for L1v4, 3d", "[sedml]")
     CHECK(curve->getLogZ() == true);
 }
 
+
+TEST_CASE("Id lookups follow renames and removals", "[sedml]")
+{
+    SedDocument doc(1, 4);
+    for (int i = 0; i < 100; ++i)
+    {
+        std::stringstream str;
+        str << "task" << i;
+        SedTask* task = doc.createTask();
+        task->setId(str.str());
+    }
+    SedDataGenerator* dg = doc.createDataGenerator();
+    dg->setId("dg");
+    SedVariable* var = dg->createVariable();
+    var->setId("var");
+
+    REQUIRE(doc.getTask("task42") == doc.getTask(42));
+    REQUIRE(doc.getElementBySId("task42") == doc.getTask(42));
+    REQUIRE(doc.getElementBySId("var") == var);
+
+    // renaming updates both the list and the document index
+    doc.getTask(42)->setId("renamed");
+    CHECK(doc.getTask("task42") == NULL);
+    CHECK(doc.getElementBySId("task42") == NULL);
+    CHECK(doc.getTask("renamed") == doc.getTask(42));
+    CHECK(doc.getElementBySId("renamed") == doc.getTask(42));
+
+    var->setId("var2");
+    CHECK(doc.getElementBySId("var") == NULL);
+    CHECK(doc.getElementBySId("var2") == var);
+    CHECK(dg->getVariable("var2") == var);
+
+    // removed elements can no longer be found
+    SedAbstractTask* removed = doc.removeTask("renamed");
+    REQUIRE(removed != NULL);
+    CHECK(removed->getParentSedObject() == NULL);
+    CHECK(doc.getTask("renamed") == NULL);
+    CHECK(doc.getElementBySId("renamed") == NULL);
+    CHECK(doc.getNumTasks() == 99);
+    delete removed;
+
+    // the first of several elements with the same id wins
+    doc.getTask(10)->setId("task20");
+    CHECK(doc.getTask("task20") == doc.getTask(10));
+    CHECK(doc.getElementBySId("task20") == doc.getTask(10));
+    doc.getTask(10)->setId("task10");
+    CHECK(doc.getTask("task20") == doc.getTask(20));
+    CHECK(doc.getElementBySId("task20") == doc.getTask(20));
+
+    // nested elements are dropped from the document index as well
+    delete dg->removeVariable("var2");
+    CHECK(doc.getElementBySId("var2") == NULL);
+}
+
+
+TEST_CASE("Removed elements are detached from their list", "[sedml]")
+{
+    SedDocument* doc = new SedDocument(1, 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        SedDataGenerator* dg = doc->createDataGenerator();
+        dg->setId("dg" + std::to_string(i));
+        dg->createVariable()->setId("var" + std::to_string(i));
+    }
+
+    // an element taken out of a list no longer has a parent or document,
+    // and neither have its children
+    SedDataGenerator* removed = doc->removeDataGenerator(1);
+    REQUIRE(removed != NULL);
+    CHECK(removed->getParentSedObject() == NULL);
+    CHECK(removed->getSedDocument() == NULL);
+    CHECK(removed->getVariable(0)->getSedDocument() == NULL);
+
+    // renaming it does not reach the document it came from
+    removed->setId("dg0");
+    CHECK(doc->getDataGenerator("dg0") == doc->getDataGenerator(0));
+    CHECK(doc->getElementBySId("var1") == NULL);
+
+    // clearing a list without deleting the items detaches all of them
+    std::vector<SedDataGenerator*> kept;
+    for (unsigned int i = 0; i < doc->getNumDataGenerators(); ++i)
+    {
+        kept.push_back(doc->getDataGenerator(i));
+    }
+    doc->getListOfDataGenerators()->clear(false);
+    CHECK(doc->getNumDataGenerators() == 0);
+    for (size_t i = 0; i < kept.size(); ++i)
+    {
+        CHECK(kept[i]->getParentSedObject() == NULL);
+        CHECK(kept[i]->getSedDocument() == NULL);
+    }
+
+    // the detached elements outlive the document, and can be added to
+    // another one
+    delete doc;
+    SedDocument other(1, 4);
+    CHECK(other.addDataGenerator(removed) == LIBSEDML_OPERATION_SUCCESS);
+    CHECK(other.getDataGenerator("dg0") != NULL);
+    CHECK(other.getDataGenerator("dg0")->getSedDocument() == &other);
+    CHECK(other.getElementBySId("var1") != NULL);
+    delete removed;
+    for (size_t i = 0; i < kept.size(); ++i)
+    {
+        CHECK(!kept[i]->getId().empty());
+        delete kept[i];
+    }
+}
+
+
+TEST_CASE("Namespaces are shared until they are modified", "[sedml]")
+{
+    SedTask task1(1, 4);
+    SedTask task2(1, 4);
+    const SedBase& base1 = task1;
+    const SedBase& base2 = task2;
+
+    // elements of the same level and version share their namespaces
+    REQUIRE(base1.getElementNamespaces() != NULL);
+    CHECK(base1.getElementNamespaces() == base2.getElementNamespaces());
+    CHECK(base1.getElementNamespaces()->getURI() == SEDML_XMLNS_L1V4);
+
+    // modifying a copy leaves the original alone
+    SedNamespaces ns(1, 4);
+    SedNamespaces copy(ns);
+    CHECK(copy.addNamespace("http://test.org/test", "test") == LIBSEDML_OPERATION_SUCCESS);
+    const SedNamespaces& constNs = ns;
+    const SedNamespaces& constCopy = copy;
+    CHECK(constNs.getNamespaces()->getLength() == 1);
+    CHECK(constCopy.getNamespaces()->getLength() == 2);
+    CHECK(base1.getElementNamespaces()->getLength() == 1);
+
+    ns = copy;
+    CHECK(constNs.getNamespaces() == constCopy.getNamespaces());
+    CHECK(ns.removeNamespace("http://test.org/test") == LIBSEDML_OPERATION_SUCCESS);
+    CHECK(constNs.getNamespaces()->getLength() == 1);
+    CHECK(constCopy.getNamespaces()->getLength() == 2);
+
+    // elements refer to the same SedNamespaces object rather than a copy
+    CHECK(base1.getSedNamespaces() == base2.getSedNamespaces());
+    SedTask task3(task2);
+    CHECK(task3.getSedNamespaces() == base2.getSedNamespaces());
+
+    // until one of them modifies its namespaces
+    XMLNamespaces xmlns;
+    xmlns.add(SEDML_XMLNS_L1V4);
+    xmlns.add("http://test.org/test", "test");
+    CHECK(task1.setNamespaces(&xmlns) == LIBSEDML_OPERATION_SUCCESS);
+    CHECK(base1.getSedNamespaces() != base2.getSedNamespaces());
+    CHECK(base1.getElementNamespaces()->getLength() == 2);
+    CHECK(base2.getElementNamespaces()->getLength() == 1);
+    CHECK(task3.getElementNamespaces()->getLength() == 1);
+
+    // the elements of a document share its namespaces
+    SedDocument doc(1, 4);
+    SedModel* model = doc.createModel();
+    SedTask* task = doc.createTask();
+    CHECK(model->getElementNamespaces() == task->getElementNamespaces());
+    CHECK(doc.getNamespaces()->add("http://test.org/test", "test") == LIBSEDML_OPERATION_SUCCESS);
+    const SedDocument& constDoc = doc;
+    CHECK(constDoc.getNamespaces()->getLength() == 2);
+    CHECK(model->getElementNamespaces()->getLength() == 1);
+    CHECK(task->getElementNamespaces()->getLength() == 1);
+}
+
+
+class CountingReaderHandler : public SedReaderHandler
+{
+public:
+    CountingReaderHandler()
+        : numStarted(0), numEnded(0), numModels(0), numTasks(0)
+        , numDataGenerators(0), numOutputs(0), keptModel(NULL)
+    {
+    }
+
+    virtual void startDocument(const SedDocument*) { ++numStarted; }
+    virtual void endDocument(const SedDocument*) { ++numEnded; }
+
+    virtual bool skipElement(const SedBase*, const std::string& elementName)
+    {
+        return elementName == "listOfOutputs" || elementName == "annotation";
+    }
+
+    virtual bool handleElement(SedBase* element)
+    {
+        if (element->getTypeCode() == SEDML_MODEL)
+        {
+            ++numModels;
+            keptModel = static_cast<SedModel*>(element);
+            return true;
+        }
+        if (dynamic_cast<SedAbstractTask*>(element) != NULL) ++numTasks;
+        if (element->getTypeCode() == SEDML_DATAGENERATOR) ++numDataGenerators;
+        if (dynamic_cast<SedOutput*>(element) != NULL) ++numOutputs;
+        return false;
+    }
+
+    unsigned int numStarted;
+    unsigned int numEnded;
+    unsigned int numModels;
+    unsigned int numTasks;
+    unsigned int numDataGenerators;
+    unsigned int numOutputs;
+    SedModel* keptModel;
+};
+
+
+TEST_CASE("Streaming reader passes on top level elements", "[sedml]")
+{
+    std::string fileName = getTestFile("/test-data/noble_1962_local.sedml");
+    SedDocument* full = readSedMLFromFile(fileName.c_str());
+    REQUIRE(full->getNumErrors(LIBSEDML_SEV_ERROR) == 0);
+
+    SedReader reader;
+    CountingReaderHandler handler;
+    SedDocument* doc = reader.readSedMLFromFile(fileName, handler);
+    REQUIRE(doc != NULL);
+    CHECK(doc->getNumErrors(LIBSEDML_SEV_ERROR) == 0);
+    CHECK(doc->getLevel() == full->getLevel());
+    CHECK(doc->getVersion() == full->getVersion());
+
+    CHECK(handler.numStarted == 1);
+    CHECK(handler.numEnded == 1);
+    CHECK(handler.numModels == full->getNumModels());
+    CHECK(handler.numTasks == full->getNumTasks());
+    CHECK(handler.numDataGenerators == full->getNumDataGenerators());
+    CHECK(handler.numOutputs == 0);
+
+    // elements passed on are no longer part of the document
+    CHECK(doc->getNumModels() == 0);
+    CHECK(doc->getNumTasks() == 0);
+    CHECK(doc->getNumDataGenerators() == 0);
+    CHECK(doc->getNumOutputs() == 0);
+
+    // elements kept by the handler are detached and owned by it
+    REQUIRE(handler.keptModel != NULL);
+    CHECK(handler.keptModel->getParentSedObject() == NULL);
+    CHECK(handler.keptModel->getId() == full->getModel(0)->getId());
+    delete handler.keptModel;
+
+    delete doc;
+    delete full;
+}
+
+
+TEST_CASE("Lazily loaded lists match the eagerly read document", "[sedml]")
+{
+    std::string fileName = getTestFile("/test-data/noble_1962_local.sedml");
+    SedDocument* full = readSedMLFromFile(fileName.c_str());
+    REQUIRE(full->getNumErrors(LIBSEDML_SEV_ERROR) == 0);
+
+    SedReader reader;
+    reader.setLazyListLoading(true);
+    CHECK(reader.getLazyListLoading());
+
+    SedDocument* doc = reader.readSedMLFromFile(fileName);
+    REQUIRE(doc != NULL);
+    CHECK(doc->getNumErrors(LIBSEDML_SEV_ERROR) == 0);
+
+    // the lists are only read once they are used
+    CHECK(doc->getListOfModels()->getHasLazyItems());
+    CHECK(doc->getListOfOutputs()->getHasLazyItems());
+
+    CHECK(doc->getNumOutputs() == full->getNumOutputs());
+    CHECK(!doc->getListOfOutputs()->getHasLazyItems());
+    CHECK(doc->getListOfModels()->getHasLazyItems());
+
+    REQUIRE(doc->getNumModels() == full->getNumModels());
+    CHECK(doc->getModel(0)->getId() == full->getModel(0)->getId());
+    CHECK(doc->getModel(0)->getParentSedObject() == doc->getListOfModels());
+    CHECK(doc->getNumTasks() == full->getNumTasks());
+    CHECK(doc->getNumDataGenerators() == full->getNumDataGenerators());
+
+    // id lookups see lists that have not been accessed yet
+    SedDocument* other = reader.readSedMLFromString(writeSedMLToStdString(full));
+    REQUIRE(other != NULL);
+    const std::string& dgId = full->getDataGenerator(0)->getId();
+    CHECK(other->getElementBySId(dgId) != NULL);
+    CHECK(other->getElementBySId(dgId)->getId() == dgId);
+
+    // writing the document reads all remaining lists
+    CHECK(writeSedMLToStdString(other) == writeSedMLToStdString(full));
+    CHECK(writeSedMLToStdString(doc) == writeSedMLToStdString(full));
+    CHECK(doc->getNumErrors(LIBSEDML_SEV_ERROR) == 0);
+
+    delete other;
+    delete doc;
+    delete full;
+}
+
+
+TEST_CASE("Lazily loaded lists are not read from a changed file", "[sedml]")
+{
+    SedDocument* full = readSedMLFromFile(
+      getTestFile("/test-data/noble_1962_local.sedml").c_str());
+    std::string xml = writeSedMLToStdString(full);
+    const std::string fileName = "lazy_list_changed.sedml";
+    {
+      std::ofstream file(fileName.c_str(), std::ios::binary);
+      file << xml;
+    }
+
+    SedReader reader;
+    reader.setLazyListLoading(true);
+    SedDocument* doc = reader.readSedMLFromFile(fileName);
+    REQUIRE(doc != NULL);
+    REQUIRE(doc->getListOfOutputs()->getHasLazyItems());
+
+    // change one character of the outputs, keeping all offsets
+    size_t pos = xml.find("id=\"", xml.find("<listOfOutputs"));
+    REQUIRE(pos != std::string::npos);
+    xml[pos + 4] = (xml[pos + 4] == 'x') ? 'y' : 'x';
+    {
+      std::ofstream file(fileName.c_str(), std::ios::binary);
+      file << xml;
+    }
+
+    CHECK(doc->getNumOutputs() == 0);
+    CHECK(doc->getErrorLog()->contains(XMLFileUnreadable));
+    CHECK(doc->getNumModels() == full->getNumModels());
+
+    delete doc;
+    delete full;
+    std::remove(fileName.c_str());
+}
+
+
+TEST_CASE("Error messages are assembled from the error table", "[sedml]")
+{
+    SedDocument doc;
+    doc.getErrorLog()->logError(SedNotUTF8, 1, 4, "more details", 3, 7);
+    doc.getErrorLog()->logError(99990, 1, 4, "no such code");
+    REQUIRE(doc.getNumErrors() == 2);
+
+    const SedError* error = doc.getError(0);
+    CHECK(error->getErrorId() == SedNotUTF8);
+    CHECK(error->getSeverity() == LIBSEDML_SEV_ERROR);
+    CHECK(error->getCategory() == LIBSEDML_CAT_SEDML);
+    CHECK(error->getLine() == 3);
+    CHECK(error->getColumn() == 7);
+    CHECK(error->getShortMessage() == "File does not use UTF-8 encoding");
+    CHECK(error->getMessage().find("must use UTF-8") == 0);
+    CHECK(error->getMessage().find(" more details") != std::string::npos);
+
+    SedError copy(*error);
+    CHECK(copy.getMessage() == error->getMessage());
+
+    // the message is the same through the libSBML base class
+    const XMLError& base = *error;
+    CHECK(base.getMessage().find("must use UTF-8") == 0);
+    CHECK(base.getShortMessage() == error->getShortMessage());
+
+    // codes that are not in the table are downgraded to invalid warnings
+    error = doc.getError(1);
+    CHECK(!error->isValid());
+    CHECK(error->getSeverity() == LIBSEDML_SEV_WARNING);
+    CHECK(error->getMessage().find("no such code") != std::string::npos);
+}
+
+
+struct IsUnknownAttributeError
+{
+    bool operator() (const XMLError* error) const
+    {
+        return error->getErrorId() == SedUnknownCoreAttribute;
+    }
+};
+
+
+TEST_CASE("Errors are removed in bulk", "[sedml]")
+{
+    SedErrorLog log;
+    log.logError(SedUnknownCoreAttribute, 1, 4, "", 1);
+    log.logError(SedNotUTF8, 1, 4, "", 2);
+    log.logError(SedUnknownCoreAttribute, 1, 4, "", 3);
+    log.logError(SedNotUTF8, 1, 4, "", 4);
+
+    CHECK(log.removeIf(IsUnknownAttributeError()) == 2);
+    REQUIRE(log.getNumErrors() == 2);
+    CHECK(log.getError(0)->getLine() == 2);
+    CHECK(log.getError(1)->getLine() == 4);
+
+    log.removeAll(SedNotUTF8);
+    CHECK(log.getNumErrors() == 0);
+
+    // a truncated document only reports the critical XML errors
+    std::string xml =
+        "<?xml version='1.0' encoding='UTF-8'?>\n"
+        "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version4' level='1' version='4'>\n"
+        "  <listOfModels>\n"
+        "    <model id='m1' language='urn:sedml:language:sbml' source='a.xml' unknown='1'/>\n"
+        "    <model id='m2' language='urn:sedml:language:sbml' source='a.xml' unknown='2'/>\n"
+        "  </listOfModels>\n";
+    SedDocument* doc = readSedMLFromString(xml.c_str());
+    REQUIRE(doc->getNumErrors() > 0);
+    for (unsigned int i = 0; i < doc->getNumErrors(); ++i)
+    {
+        CHECK(doc->getError(i)->getErrorId() < XMLErrorCodesUpperBound);
+    }
+    delete doc;
+}
+
+
+TEST_CASE("Documents can be read into an arena", "[sedml]")
+{
+    std::string fileName = getTestFile("/test-data/noble_1962_local.sedml");
+    SedDocument* full = readSedMLFromFile(fileName.c_str());
+    REQUIRE(full->getNumErrors(LIBSEDML_SEV_ERROR) == 0);
+
+    SedReader reader;
+    reader.setUseArena(true);
+    CHECK(reader.getUseArena());
+
+    SedDocument* doc = reader.readSedMLFromFile(fileName);
+    REQUIRE(doc != NULL);
+    CHECK(doc->getUseArena());
+    CHECK(doc->getArena()->getNumBytes() > 0);
+    CHECK(doc->getNumErrors(LIBSEDML_SEV_ERROR) == 0);
+    CHECK(writeSedMLToStdString(doc) == writeSedMLToStdString(full));
+
+    // elements created within a scope come from the arena as well
+    size_t numBytes = doc->getArena()->getNumBytes();
+    {
+        SedArenaScope scope(doc);
+        for (unsigned int i = 0; i < 1000; ++i)
+        {
+            doc->createDataGenerator()->createVariable();
+        }
+    }
+    CHECK(doc->getArena()->getNumBytes() > numBytes);
+    CHECK(SedArena::getCurrent() == NULL);
+
+    // elements from the heap are told apart while arenas exist
+    SedModel* heapModel = new SedModel(1, 4);
+    heapModel->setId("heap");
+    delete heapModel;
+    {
+        SedArenaScope scope(doc);
+        SedModel* arenaModel = new SedModel(1, 4);
+        arenaModel->setId("arena");
+        delete arenaModel;
+    }
+
+    // removed elements and copy-on-write clones outlive the document, and
+    // may be freed on another thread
+    SedModel* model = doc->removeModel(0);
+    REQUIRE(model != NULL);
+    SedDocument* copy = doc->cloneCopyOnWrite();
+    const std::string xml = writeSedMLToStdString(doc);
+    delete doc;
+    CHECK(model->getId() == full->getModel(0)->getId());
+    std::thread([model]() { delete model; }).join();
+    CHECK(writeSedMLToStdString(copy) == xml);
+    delete copy;
+
+    delete full;
+}
+
+
+TEST_CASE("Repeated tasks are expanded into iterations", "[sedml]")
+{
+    SedDocument doc(1, 4);
+    SedTask* task = doc.createTask();
+    task->setId("t1");
+
+    SedRepeatedTask* inner = doc.createRepeatedTask();
+    inner->setId("inner");
+    inner->setRangeId("w");
+    SedVectorRange* w = inner->createVectorRange();
+    w->setId("w");
+    w->addValue(5);
+    w->addValue(6);
+    w->addValue(7);
+    inner->createSubTask()->setTask("t1");
+
+    SedRepeatedTask* outer = doc.createRepeatedTask();
+    outer->setId("outer");
+    outer->setRangeId("r");
+
+    SedUniformRange* r = outer->createUniformRange();
+    r->setId("r");
+    r->setStart(0);
+    r->setEnd(10);
+    r->setNumberOfSteps(5);
+    r->setType("linear");
+
+    // defined before the range it uses
+    SedFunctionalRange* f = outer->createFunctionalRange();
+    f->setId("f");
+    f->setRange("r");
+    SedParameter* p = f->createParameter();
+    p->setId("p");
+    p->setValue(1);
+    ASTNode* math = SBML_parseL3Formula("2 * r + p");
+    f->setMath(math);
+    delete math;
+
+    SedVectorRange* v = outer->createVectorRange();
+    v->setId("v");
+    for (int i = 1; i <= 6; ++i) v->addValue(i);
+
+    SedSetValue* change = outer->createTaskChange();
+    change->setModelReference("m1");
+    change->setTarget("k1");
+    change->setRange("v");
+    math = SBML_parseL3Formula("v * 10");
+    change->setMath(math);
+    delete math;
+
+    SedSubTask* second = outer->createSubTask();
+    second->setTask("t1");
+    second->setOrder(2);
+    SedSubTask* first = outer->createSubTask();
+    first->setTask("inner");
+    first->setOrder(1);
+
+    SedRepeatedTaskIterator it(outer);
+    REQUIRE(it.getNumIterations() == 6);
+    CHECK(it.getIndex() == 0);
+    CHECK(it.getMasterValue() == 0);
+
+    unsigned int count = 0;
+    for (; !it.isAtEnd(); it.next()) ++count;
+    CHECK(count == 6);
+    CHECK(!it.next());
+
+    REQUIRE(it.seek(3) == LIBSEDML_OPERATION_SUCCESS);
+    CHECK(it.getMasterValue() == Approx(6));
+    CHECK(it.getRangeValue("v") == 4);
+    CHECK(it.getRangeValue("f") == Approx(13));
+    REQUIRE(it.getNumChanges() == 1);
+    CHECK(it.getChange(0) == change);
+    CHECK(it.getChangeValue(0) == Approx(40));
+    CHECK(it.seek(7) == LIBSEDML_INDEX_EXCEEDS_SIZE);
+
+    // subtasks come in order of execution, nested tasks are not expanded
+    REQUIRE(it.getNumSubTasks() == 2);
+    CHECK(it.getSubTask(0) == first);
+    CHECK(it.getSubTaskTask(0) == inner);
+    CHECK(it.getSubTaskTask(1) == task);
+    CHECK(it.createSubTaskIterator(1) == NULL);
+
+    SedRepeatedTaskIterator* nested = it.createSubTaskIterator(0);
+    REQUIRE(nested != NULL);
+    CHECK(nested->getNumIterations() == 3);
+    CHECK(nested->getMasterValue() == 5);
+    delete nested;
+}
+
+TEST_CASE("Data generator math is compiled", "[sedml]")
+{
+  SedDocument doc(1, 4);
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("dg");
+  SedVariable* var = dg->createVariable();
+  var->setId("x");
+  SedParameter* p = dg->createParameter();
+  p->setId("scale");
+  p->setValue(2);
+  ASTNode* math = SBML_parseL3Formula("scale * x / max(x) + piecewise(1, x > 3, 0)");
+  dg->setMath(math);
+  delete math;
+
+  SedCompiledMath compiled;
+  REQUIRE(compiled.compile(dg) == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(compiled.isCompiled());
+  CHECK(compiled.getNumSlots() == 2);
+  CHECK(compiled.getSlotIndex("undefined") == -1);
+
+  std::vector<double> x;
+  for (int i = 1; i <= 1000; ++i) x.push_back(i % 5);
+  CHECK(compiled.setSlotValues(compiled.getSlotIndex("x"), &x[0]) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(compiled.setSlotValues(7, &x[0]) == LIBSEDML_INDEX_EXCEEDS_SIZE);
+
+  std::vector<double> result(x.size());
+  REQUIRE(compiled.evaluate(x.size(), &result[0]) == LIBSEDML_OPERATION_SUCCESS);
+  for (size_t i = 0; i < x.size(); ++i)
+  {
+    double expected = 2 * x[i] / 4 + (x[i] > 3 ? 1 : 0);
+    CHECK(result[i] == Approx(expected));
+  }
+
+  // single points only aggregate over themselves
+  CHECK(compiled.evaluate(3) == Approx(2 * 4 / 4.0 + 1));
+
+  math = SBML_parseL3Formula("sum(x) / mean(x) + min(x, 2)");
+  REQUIRE(compiled.compile(math) == LIBSEDML_OPERATION_SUCCESS);
+  delete math;
+  compiled.setSlotValues(compiled.getSlotIndex("x"), &x[0]);
+  REQUIRE(compiled.evaluate(x.size(), &result[0]) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(result[0] == Approx(1000 + 1));
+  CHECK(result[3] == Approx(1000 + 2));
+
+  math = SBML_parseL3Formula("f(x)");
+  CHECK(compiled.compile(math) == LIBSEDML_INVALID_OBJECT);
+  delete math;
+  CHECK(!compiled.isCompiled());
+  CHECK(compiled.evaluate(x.size(), &result[0]) == LIBSEDML_INVALID_OBJECT);
+}
+
+TEST_CASE("Effective styles are cached and cycles are reported", "[sedml]")
+{
+  SedDocument doc(1, 4);
+  SedStyle* base = doc.createStyle();
+  base->setId("base");
+  base->createLineStyle()->setColor("ff0000");
+  base->getLineStyle()->setThickness(2);
+
+  SedStyle* derived = doc.createStyle();
+  derived->setId("derived");
+  derived->setBaseStyle("base");
+  derived->createLineStyle()->setThickness(4);
+
+  const SedStyle* resolved = doc.getResolvedStyle("derived");
+  REQUIRE(resolved != NULL);
+  CHECK(resolved->getId() == "derived");
+  CHECK(!resolved->isSetBaseStyle());
+  CHECK(resolved->getLineStyle()->getColor() == "ff0000");
+  CHECK(resolved->getLineStyle()->getThickness() == 4);
+  CHECK(doc.getResolvedStyle("derived") == resolved);
+  CHECK(doc.getResolvedStyle("missing") == NULL);
+
+  SedStyle copy = doc.getEffectiveStyle("derived");
+  CHECK(copy.getLineStyle()->getColor() == "ff0000");
+
+  // changing a base style is seen by the styles derived from it
+  base->getLineStyle()->setColor("00ff00");
+  resolved = doc.getResolvedStyle("derived");
+  REQUIRE(resolved != NULL);
+  CHECK(resolved->getLineStyle()->getColor() == "00ff00");
+
+  SedStyle* first = doc.createStyle();
+  first->setId("first");
+  first->setBaseStyle("second");
+  SedStyle* second = doc.createStyle();
+  second->setId("second");
+  second->setBaseStyle("first");
+  SedStyle* self = doc.createStyle();
+  self->setId("self");
+  self->setBaseStyle("self");
+
+  unsigned int numErrors = doc.getNumErrors();
+  CHECK(doc.getResolvedStyle("first") == NULL);
+  CHECK(doc.getResolvedStyle("second") == NULL);
+  CHECK(doc.getResolvedStyle("self") == NULL);
+  CHECK(doc.getNumErrors() == numErrors + 2);
+  CHECK(doc.getErrorLog()->contains(SedmlStyleBaseStyleMustNotBeCircular));
+  CHECK(!doc.getEffectiveStyle("self").isSetLineStyle());
+
+  // a style that only leads into a cycle is not reported as part of it
+  SedStyle* tail = doc.createStyle();
+  tail->setId("tail");
+  tail->setBaseStyle("first");
+  numErrors = doc.getNumErrors();
+  CHECK(doc.getResolvedStyle("tail") == NULL);
+  REQUIRE(doc.getNumErrors() == numErrors + 1);
+  const std::string message = doc.getError(numErrors)->getMessage();
+  CHECK(message.find("'first'") != std::string::npos);
+  CHECK(message.find("'second'") != std::string::npos);
+  CHECK(message.find("'tail'") == std::string::npos);
+
+  // breaking the cycle resolves the styles again
+  second->unsetBaseStyle();
+  CHECK(doc.getResolvedStyle("first") != NULL);
+}
+
+TEST_CASE("Effective styles are resolved from lazily read styles", "[sedml]")
+{
+  SedReader reader;
+  reader.setLazyListLoading(true);
+  SedDocument* doc =
+    reader.readSedMLFromFile(getTestFile("/test-data/line_uses_style.sedml"));
+  REQUIRE(doc != NULL);
+  REQUIRE(doc->getListOfStyles()->getHasLazyItems());
+
+  // loading the styles discards the cache, which must not be locked then
+  const SedStyle* resolved = doc->getResolvedStyle("red_line");
+  REQUIRE(resolved != NULL);
+  CHECK(!doc->getListOfStyles()->getHasLazyItems());
+  CHECK(resolved->getLineStyle()->getColor() == "#FF0000");
+  CHECK(doc->getResolvedStyle("red_line") == resolved);
+  delete doc;
+}
+
+TEST_CASE("Documents are read in parallel", "[sedml]")
+{
+  const char* names[] = {
+    "/test-data/BIOMD0000000087_fig5.sedml",
+    "/test-data/issue_77.sedml",
+    "/test-data/issue_93.sedml",
+    "/test-data/line_uses_style.sedml",
+    "/test-data/model_nolang_l1v3.sedml",
+    "/test-data/noble_1962_local.sedml",
+    "/test-data/sort_subtasks.sedml",
+    "/test-data/surface_noxy_l1v4.sedml"
+  };
+  const size_t numNames = sizeof(names) / sizeof(names[0]);
+
+  std::vector<std::string> files;
+  for (unsigned int i = 0; i < 25; ++i)
+  {
+    for (size_t n = 0; n < numNames; ++n)
+    {
+      files.push_back(getTestFile(names[n]));
+    }
+  }
+  files.push_back(getTestFile("/test-data/does_not_exist.sedml"));
+
+  SedWriter writer;
+
+  for (int lazy = 0; lazy < 2; ++lazy)
+  {
+    SedReader reader;
+    reader.setLazyListLoading(lazy == 1);
+
+    std::vector<std::string> expected;
+    std::vector<unsigned int> expectedErrors;
+    for (size_t n = 0; n < numNames; ++n)
+    {
+      SedDocument* doc = reader.readSedMLFromFile(files[n]);
+      expected.push_back(writer.writeSedMLToStdString(doc));
+      expectedErrors.push_back(doc->getNumErrors());
+      delete doc;
+    }
+
+    std::vector<SedDocument*> docs = reader.readSedMLBatch(files, 8);
+    REQUIRE(docs.size() == files.size());
+
+    for (size_t i = 0; i + 1 < docs.size(); ++i)
+    {
+      REQUIRE(docs[i] != NULL);
+      CHECK(docs[i]->getNumErrors() == expectedErrors[i % numNames]);
+      CHECK(writer.writeSedMLToStdString(docs[i]) == expected[i % numNames]);
+      delete docs[i];
+    }
+
+    REQUIRE(docs.back() != NULL);
+    CHECK(docs.back()->getErrorLog()->contains(XMLFileUnreadable));
+    delete docs.back();
+  }
+
+  SedReader reader;
+  CHECK(reader.readSedMLBatch(std::vector<std::string>(), 4).empty());
+}
+
+TEST_CASE("Model changes are applied with compiled targets", "[sedml]")
+{
+  SedXPathSelector selector(
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']/@value");
+  CHECK(selector.isCompiled());
+  CHECK(selector.selectsAttribute());
+  CHECK(selector.getAttributeName() == "value");
+  CHECK(SedXPathSelector("//sbml:parameter[2]").isCompiled());
+  CHECK(SedXPathSelector("//*[@id and @value!='0']").isCompiled());
+  CHECK(!SedXPathSelector("/sbml/model/text()").isCompiled());
+  CHECK(!SedXPathSelector("").isCompiled());
+  CHECK(SedXPathSelector().compile("/sbml/@level/model")
+    == LIBSEDML_INVALID_ATTRIBUTE_VALUE);
+
+  XMLNode* sbml = XMLNode::convertStringToXMLNode(
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    "<model id='m'><listOfParameters>"
+    "<parameter id='k1' value='1' constant='true'/>"
+    "<parameter id='k2' value='2' constant='true'/>"
+    "<parameter id='k3' value='3' constant='true'/>"
+    "</listOfParameters></model></sbml>");
+  REQUIRE(sbml != NULL);
+
+  std::vector<SedXPathSelector::Match> matches;
+  CHECK(SedXPathSelector("//sbml:parameter[2]").select(*sbml, matches) == 1);
+  CHECK(matches[0].element->getAttrValue("id") == "k2");
+  CHECK(matches[0].index == 1);
+  CHECK(SedXPathSelector("//*[@value]").select(*sbml, matches) == 3);
+
+  SedDocument doc(1, 4);
+  SedModel* m1 = doc.createModel();
+  m1->setId("m1");
+  m1->setSource("model.xml");
+  m1->setLanguage("urn:sedml:language:sbml");
+
+  SedChangeAttribute* attribute = m1->createChangeAttribute();
+  attribute->setTarget(
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']/@value");
+  attribute->setNewValue("10");
+
+  SedRemoveXML* remove = m1->createRemoveXML();
+  remove->setTarget(
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k3']");
+
+  XMLNode* newXML = XMLNode::convertStringToXMLNode(
+    "<parameter id='k4' value='4' constant='true'/>");
+  SedAddXML* add = m1->createAddXML();
+  add->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters");
+  add->setNewXML(newXML);
+  delete newXML;
+
+  SedModel* m2 = doc.createModel();
+  m2->setId("m2");
+  m2->setSource("#m1");
+
+  SedComputeChange* compute = m2->createComputeChange();
+  compute->setTarget(
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k2']/@value");
+  ASTNode* math = SBML_parseL3Formula("k1 * factor + k4");
+  compute->setMath(math);
+  delete math;
+  SedVariable* variable = compute->createVariable();
+  variable->setId("k1");
+  variable->setTarget(
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']");
+  variable = compute->createVariable();
+  variable->setId("k4");
+  variable->setTarget("//sbml:parameter[@id='k4']/@value");
+  SedParameter* parameter = compute->createParameter();
+  parameter->setId("factor");
+  parameter->setValue(0.5);
+
+  newXML = XMLNode::convertStringToXMLNode(
+    "<parameter id='k5' value='5' constant='false'/>");
+  SedChangeXML* change = m2->createChangeXML();
+  change->setTarget("//sbml:parameter[@id='k4']");
+  change->setNewXML(newXML);
+  delete newXML;
+
+  SedModel* m3 = doc.createModel();
+  m3->setId("m3");
+  m3->setSource("#m4");
+  SedModel* m4 = doc.createModel();
+  m4->setId("m4");
+  m4->setSource("#m3");
+
+  SedModelBuilder builder(&doc);
+  CHECK(builder.getModel("m1") == NULL);
+  CHECK(builder.setModelSource("model.xml", *sbml) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(builder.setModelSource("#m1", *sbml) == LIBSEDML_INVALID_ATTRIBUTE_VALUE);
+
+  const XMLNode* xml1 = builder.getModel("m1");
+  REQUIRE(xml1 != NULL);
+  CHECK(builder.getModel("m1") == xml1);
+  const XMLNode& parameters1 = xml1->getChild(0).getChild(0);
+  REQUIRE(parameters1.getNumChildren() == 3);
+  CHECK(parameters1.getChild(0).getAttrValue("value") == "10");
+  CHECK(parameters1.getChild(1).getAttrValue("id") == "k2");
+  CHECK(parameters1.getChild(2).getAttrValue("id") == "k4");
+
+  const XMLNode* xml2 = builder.getModel("m2");
+  REQUIRE(xml2 != NULL);
+  const XMLNode& parameters2 = xml2->getChild(0).getChild(0);
+  REQUIRE(parameters2.getNumChildren() == 3);
+  CHECK(parameters2.getChild(1).getAttrValue("value") == "9");
+  CHECK(parameters2.getChild(2).getAttrValue("id") == "k5");
+
+  // the base model is not modified by the derived one
+  CHECK(parameters1.getChild(2).getAttrValue("id") == "k4");
+
+  CHECK(builder.getModel("m3") == NULL);
+  CHECK(builder.getModel("unknown") == NULL);
+
+  XMLNode copy(*sbml);
+  CHECK(builder.applyChanges(m1, copy) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(XMLNode::convertXMLNodeToString(&copy)
+    == XMLNode::convertXMLNodeToString(xml1));
+
+  CHECK(builder.applyValue("//sbml:parameter[@id='k2']/@value", 0.1, copy)
+    == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(copy.getChild(0).getChild(0).getChild(1).getAttrValue("value") == "0.1");
+  CHECK(builder.applyValue("//sbml:parameter[@id='k9']/@value", 1, copy)
+    == LIBSEDML_OPERATION_FAILED);
+  CHECK(builder.applyValue("//sbml:parameter", 1, copy)
+    == LIBSEDML_INVALID_ATTRIBUTE_VALUE);
+  CHECK(builder.getSelector("//sbml:parameter")
+    == builder.getSelector("//sbml:parameter"));
+
+  delete sbml;
+}
+
+TEST_CASE("Dependency graph orders the elements of a document", "[sedml]")
+{
+  SedDocument doc(1, 4);
+
+  SedModel* m1 = doc.createModel();
+  m1->setId("m1");
+  m1->setSource("model.xml");
+  SedModel* m2 = doc.createModel();
+  m2->setId("m2");
+  m2->setSource("#m1");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+
+  SedTask* t1 = doc.createTask();
+  t1->setId("t1");
+  t1->setModelReference("m1");
+  t1->setSimulationReference("sim");
+  SedTask* t2 = doc.createTask();
+  t2->setId("t2");
+  t2->setModelReference("m2");
+  t2->setSimulationReference("missing_sim");
+
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->setId("repeated");
+  repeated->createSubTask()->setTask("t1");
+  repeated->createSubTask()->setTask("t2");
+
+  SedRepeatedTask* loop = doc.createRepeatedTask();
+  loop->setId("loop");
+  loop->createSubTask()->setTask("loop");
+
+  SedDataGenerator* dg1 = doc.createDataGenerator();
+  dg1->setId("dg1");
+  dg1->createVariable()->setTaskReference("t1");
+  SedDataGenerator* dg2 = doc.createDataGenerator();
+  dg2->setId("dg2");
+  dg2->createVariable()->setTaskReference("repeated");
+  SedDataGenerator* dg3 = doc.createDataGenerator();
+  dg3->setId("dg3");
+  dg3->createVariable()->setTaskReference("loop");
+
+  SedReport* report = doc.createReport();
+  report->setId("report");
+  report->createDataSet()->setDataReference("dg1");
+  SedPlot2D* plot = doc.createPlot2D();
+  plot->setId("plot");
+  SedCurve* curve = plot->createCurve();
+  curve->setXDataReference("dg1");
+  curve->setYDataReference("dg2");
+
+  SedDependencyGraph graph;
+  CHECK(doc.buildDependencyGraph(graph) == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(graph.getNumNodes() == 12);
+
+  int idx[12];
+  const char* ids[] = { "m1", "m2", "sim", "t1", "t2", "repeated", "loop",
+                        "dg1", "dg2", "dg3", "report", "plot" };
+  for (int i = 0; i < 12; ++i)
+  {
+    idx[i] = graph.getNodeIndex(ids[i]);
+    REQUIRE(idx[i] >= 0);
+    CHECK(graph.getNode(idx[i])->getId() == ids[i]);
+  }
+  CHECK(graph.getNodeIndex("missing_sim") == -1);
+
+  CHECK(graph.getStageOf(idx[0]) == 0);
+  CHECK(graph.getStageOf(idx[2]) == 0);
+  CHECK(graph.getStageOf(idx[1]) == 1);
+  CHECK(graph.getStageOf(idx[3]) == 1);
+  CHECK(graph.getStageOf(idx[4]) == 2);
+  CHECK(graph.getStageOf(idx[5]) == 3);
+  CHECK(graph.getStageOf(idx[7]) == 2);
+  CHECK(graph.getStageOf(idx[8]) == 4);
+  CHECK(graph.getStageOf(idx[10]) == 3);
+  CHECK(graph.getStageOf(idx[11]) == 5);
+  CHECK(graph.getNumStages() == 6);
+  CHECK(graph.getStage(1).size() == 2);
+
+  // the curve refers to both data generators, but only once each
+  CHECK(graph.getDependencies(idx[11]).size() == 2);
+  CHECK(graph.getDependents(idx[7]).size() == 2);
+
+  REQUIRE(graph.getNumDanglingReferences() == 1);
+  CHECK(graph.getDanglingReference(0).node == (unsigned int)idx[4]);
+  CHECK(graph.getDanglingReference(0).attribute == "simulationReference");
+  CHECK(graph.getDanglingReference(0).reference == "missing_sim");
+
+  // the loop refers to itself, and the data generator using it cannot run
+  REQUIRE(graph.getNumCycles() == 1);
+  REQUIRE(graph.getCycle(0).size() == 1);
+  CHECK(graph.getCycle(0)[0] == (unsigned int)idx[6]);
+  CHECK(graph.getStageOf(idx[6]) == -1);
+  CHECK(graph.getStageOf(idx[9]) == -1);
+
+  std::vector<unsigned int> changed(1, (unsigned int)idx[4]);
+  std::vector<unsigned int> affected;
+  graph.getAffectedNodes(changed, affected);
+  REQUIRE(affected.size() == 4);
+  CHECK(affected[0] == (unsigned int)idx[4]);
+  CHECK(affected[1] == (unsigned int)idx[5]);
+  CHECK(affected[2] == (unsigned int)idx[8]);
+  CHECK(affected[3] == (unsigned int)idx[11]);
+
+  // models referring to each other are a cycle as well
+  m1->setSource("#m2");
+  doc.buildDependencyGraph(graph);
+  REQUIRE(graph.getNumCycles() == 2);
+  CHECK(graph.getCycle(0).size() == 2);
+  CHECK(graph.getStageOf(graph.getNodeIndex("report")) == -1);
+}
+
+TEST_CASE("Tasks are executed in parallel", "[sedml]")
+{
+  SedDocument doc(1, 4);
+
+  SedModel* model = doc.createModel();
+  model->setId("m");
+  model->setSource("urn:test:model");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setInitialTime(0);
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(2);
+  sim->setNumberOfSteps(2);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedUniformTimeCourse* other = doc.createUniformTimeCourse();
+  other->setId("other");
+  other->setInitialTime(0);
+  other->setOutputStartTime(0);
+  other->setOutputEndTime(1);
+  other->setNumberOfSteps(1);
+  other->createAlgorithm()->setKisaoID("KISAO:0000088");
+
+  SedTask* t1 = doc.createTask();
+  t1->setId("t1");
+  t1->setModelReference("m");
+  t1->setSimulationReference("sim");
+
+  SedTask* t2 = doc.createTask();
+  t2->setId("t2");
+  t2->setModelReference("m");
+  t2->setSimulationReference("other");
+
+  const char* target =
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k']";
+  SedRepeatedTask* repeated[2];
+  for (int reset = 0; reset < 2; ++reset)
+  {
+    SedRepeatedTask* task = repeated[reset] = doc.createRepeatedTask();
+    task->setId(reset ? "reset" : "continue");
+    task->setResetModel(reset == 1);
+    task->setConcatenate(true);
+    task->setRangeId("r");
+    SedVectorRange* range = task->createVectorRange();
+    range->setId("r");
+    for (int i = 1; i <= 20; ++i) range->addValue(i);
+
+    SedSetValue* change = task->createTaskChange();
+    change->setModelReference("m");
+    change->setTarget(target);
+    change->setRange("r");
+    ASTNode* math = SBML_parseL3Formula("r");
+    change->setMath(math);
+    delete math;
+
+    task->createSubTask()->setTask("t1");
+  }
+
+  SedRepeatedTask* loop = doc.createRepeatedTask();
+  loop->setId("loop");
+  loop->createSubTask()->setTask("loop");
+
+  XMLNode* sbml = XMLNode::convertStringToXMLNode(
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    "<model id='m'><listOfParameters>"
+    "<parameter id='k' value='1' constant='true'/>"
+    "<parameter id='x' value='1' constant='true'/>"
+    "</listOfParameters></model></sbml>");
+  REQUIRE(sbml != NULL);
+
+  SedTaskExecutor executor(&doc);
+  executor.getModelBuilder().setModelSource("urn:test:model", *sbml);
+  executor.registerSimulator("KISAO:0000019",
+    []() -> SedSimulator* { return new SedMockSimulator(); });
+  executor.setNumThreads(4);
+  CHECK(executor.hasSimulator("KISAO:0000019"));
+  CHECK(!executor.hasSimulator("KISAO:0000088"));
+
+  CHECK(executor.execute() == LIBSEDML_OPERATION_FAILED);
+  CHECK(executor.getStatus("t1") == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(executor.getStatus("t2") == LIBSEDML_INVALID_OBJECT);
+  CHECK(executor.getStatus("loop") == LIBSEDML_OPERATION_FAILED);
+  CHECK(executor.getResult("t2") == NULL);
+
+  const SedTaskResult* result = executor.getResult("t1");
+  REQUIRE(result != NULL);
+  REQUIRE(result->getColumn("time") != NULL);
+  CHECK(result->getColumn("time")->size() == 3);
+  REQUIRE(result->getColumn("x") != NULL);
+  CHECK(result->getColumn("x")->at(2) == Approx(exp(-2.0)));
+
+  for (int reset = 0; reset < 2; ++reset)
+  {
+    result = executor.getResult(repeated[reset]->getId());
+    REQUIRE(result != NULL);
+    REQUIRE(result->getNumChildren() == 20);
+
+    for (unsigned int i = 0; i < 20; ++i)
+    {
+      const SedTaskResult* iteration = result->getChild(i);
+      REQUIRE(iteration->getNumChildren() == 1);
+      const SedTaskResult* subTask = iteration->getChild(0);
+      CHECK(subTask->getTaskId() == "t1");
+      CHECK(subTask->getColumn("k")->at(0) == i + 1);
+
+      // without a reset, each iteration continues where the last one ended
+      double x = reset ? 1.0 : exp(-2.0 * i);
+      CHECK(subTask->getColumn("x")->at(0) == Approx(x));
+    }
+
+    REQUIRE(result->getColumn("k") != NULL);
+    CHECK(result->getColumn("k")->size() == 60);
+    CHECK(result->getColumn("k")->at(3) == 2);
+  }
+
+  // running a single task keeps the other results
+  executor.registerSimulator("",
+    []() -> SedSimulator* { return new SedMockSimulator(); });
+  CHECK(executor.execute(std::vector<std::string>(1, "t2"))
+    == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(executor.getResult("t2") != NULL);
+  CHECK(executor.getResult("t1") != NULL);
+
+  delete sbml;
+}
+
+TEST_CASE("Data sources are loaded and sliced", "[sedml]")
+{
+  std::string fileName = getTestFile("/test-data/data_loader.sedml");
+  SedDocument* doc = readSedMLFromFile(fileName.c_str());
+  REQUIRE(doc != NULL);
+  REQUIRE(doc->getNumDataDescriptions() == 3);
+
+  SedDataLoader loader;
+  loader.setBaseDirectory(getTestFile("/test-data"));
+
+  const SedDataDescription* csv = doc->getDataDescription("csv");
+  const SedDataTable* table = loader.getTable(csv);
+  REQUIRE(table != NULL);
+  CHECK(table->getNumRows() == 4);
+  CHECK(table->getNumColumns() == 3);
+  CHECK(table->getColumnName(1) == "S1");
+  CHECK(table->isMapped());
+
+  SedDataView values;
+  REQUIRE(loader.getValues(csv->getDataSource("csv_time"), values)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 4);
+  CHECK(values[3] == 3);
+
+  // views point into the table instead of copying it
+  REQUIRE(loader.getValues(csv->getDataSource("csv_S1_tail"), values)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 2);
+  CHECK(values[0] == 0.25);
+  CHECK(values.getData() == table->getColumn(1).getData() + 2);
+
+  REQUIRE(loader.getValues(csv->getDataSource("csv_row1"), values)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 3);
+  CHECK(values.getStride() == 4);
+  CHECK(values[2] == 0.5);
+
+  // slices with an index need the current value of their range
+  CHECK(loader.getValues(csv->getDataSource("csv_S2_at"), values)
+    == LIBSEDML_INVALID_OBJECT);
+  SedDataLoader::IndexValues indexValues;
+  indexValues["i"] = 3;
+  REQUIRE(loader.getValues(csv->getDataSource("csv_S2_at"), values,
+    &indexValues) == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 1);
+  CHECK(values[0] == 0.875);
+
+  std::vector<std::string> names;
+  REQUIRE(loader.getIndexSet(csv->getDataSource("csv_columns"), names)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(names.size() == 3);
+  CHECK(names[2] == "S2");
+
+  // data descriptions sharing a file share the table
+  const SedDataDescription* again = doc->getDataDescription("csv_again");
+  CHECK(loader.getTable(again) == table);
+  CHECK(loader.getNumTables() == 1);
+  REQUIRE(loader.getValues(again->getDataSource("again_S2"), values)
+    == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(values[1] == 0.5);
+
+  const SedDataDescription* numl = doc->getDataDescription("numl");
+  CHECK(SedDataLoader::getFormat(numl) == "urn:sedml:format:numl");
+  REQUIRE(loader.getValues(numl->getDataSource("numl_S2"), values)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 2);
+  CHECK(values[1] == 0.6);
+  REQUIRE(loader.getValues(numl->getDataSource("numl_late"), values)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 2);
+  CHECK(values[0] == 0.4);
+  CHECK(loader.getNumTables() == 2);
+
+  // the loader provides the values of data ranges
+  const SedRepeatedTask* scan =
+    static_cast<const SedRepeatedTask*>(doc->getTask("scan"));
+  SedRepeatedTaskIterator iterator(scan, &loader);
+  CHECK(iterator.getNumIterations() == 2);
+
+  // supplied contents replace the file
+  loader.setSourceContents("data_loader.csv", "time,S1,S2\n0,7,8\n");
+  REQUIRE(loader.getValues(again->getDataSource("again_S2"), values)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 1);
+  CHECK(values[0] == 8);
+
+  delete doc;
+}
+
+TEST_CASE("Results are stored by task and variable", "[sedml]")
+{
+  SedDocument doc(1, 4);
+
+  SedModel* model = doc.createModel();
+  model->setId("m");
+  model->setSource("urn:test:model");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setInitialTime(0);
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(2);
+  sim->setNumberOfSteps(2);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* t1 = doc.createTask();
+  t1->setId("t1");
+  t1->setModelReference("m");
+  t1->setSimulationReference("sim");
+
+  SedRepeatedTask* scan = doc.createRepeatedTask();
+  scan->setId("scan");
+  scan->setResetModel(true);
+  scan->setRangeId("r");
+  SedVectorRange* range = scan->createVectorRange();
+  range->setId("r");
+  for (int i = 1; i <= 4; ++i) range->addValue(i);
+  SedSetValue* change = scan->createTaskChange();
+  change->setModelReference("m");
+  change->setTarget(
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k']");
+  change->setRange("r");
+  ASTNode* math = SBML_parseL3Formula("r");
+  change->setMath(math);
+  delete math;
+  scan->createSubTask()->setTask("t1");
+
+  const char* target =
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k']/@value";
+  const char* ids[] = { "kAll", "kMean", "kMax" };
+  SedVariable* variables[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    SedDataGenerator* dg = doc.createDataGenerator();
+    dg->setId(std::string("dg_") + ids[i]);
+    SedVariable* var = variables[i] = dg->createVariable();
+    var->setId(ids[i]);
+    var->setTaskReference("scan");
+    var->setTarget(target);
+    math = SBML_parseL3Formula(ids[i]);
+    dg->setMath(math);
+    delete math;
+  }
+
+  // the mean over all iterations, and the maximum over time
+  variables[1]->setDimensionTerm("KISAO:0000825");
+  variables[1]->createAppliedDimension()->setTarget("scan");
+  variables[2]->setDimensionTerm("KISAO:0000828");
+  variables[2]->createAppliedDimension()->setTarget("t1");
+  SedDataGenerator* scaled = doc.getDataGenerator("dg_kMean");
+  math = SBML_parseL3Formula("kMean / 2.5");
+  scaled->setMath(math);
+  delete math;
+
+  SedDataGenerator* time = doc.createDataGenerator();
+  time->setId("dg_time");
+  SedVariable* timeVar = time->createVariable();
+  timeVar->setId("time");
+  timeVar->setTaskReference("t1");
+  timeVar->setSymbol("urn:sedml:symbol:time");
+  math = SBML_parseL3Formula("time");
+  time->setMath(math);
+  delete math;
+
+  XMLNode* sbml = XMLNode::convertStringToXMLNode(
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    "<model id='m'><listOfParameters>"
+    "<parameter id='k' value='1' constant='true'/>"
+    "</listOfParameters></model></sbml>");
+  REQUIRE(sbml != NULL);
+
+  SedResultStore store;
+  SedTaskExecutor executor(&doc);
+  executor.getModelBuilder().setModelSource("urn:test:model", *sbml);
+  executor.registerSimulator("",
+    []() -> SedSimulator* { return new SedMockSimulator(); });
+  executor.setResultStore(&store);
+  REQUIRE(executor.execute() == LIBSEDML_OPERATION_SUCCESS);
+
+  // the three variables of the scan share one series
+  CHECK(store.getNumSeries() == 2);
+  const SedResultSeries* series = store.getSeries(variables[0]);
+  REQUIRE(series != NULL);
+  CHECK(series == store.getSeries(variables[1]));
+  REQUIRE(series->getNumDimensions() == 2);
+  CHECK(series->getDimensionTaskId(0) == "scan");
+  CHECK(series->getDimensionTaskId(1) == "t1");
+  CHECK(series->getNumSegments() == 4);
+  CHECK(series->getStride() == 3);
+
+  SedDataView values;
+  std::vector<double> buffer;
+  REQUIRE(store.getValues(variables[0], values, buffer)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 12);
+  CHECK(values.getData() == series->getValues().getData());
+  CHECK(values[3] == 2);
+  CHECK(values[4] == Approx(2 * exp(-1.0)));
+
+  REQUIRE(store.getValues(variables[1], values, buffer)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 3);
+  CHECK(values[2] == Approx(2.5 * exp(-2.0)));
+
+  REQUIRE(store.getValues(variables[2], values, buffer)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 4);
+  CHECK(values[3] == 4);
+
+  // data generators are evaluated on the stored values
+  SedCompiledMath compiled;
+  REQUIRE(compiled.compile(scaled) == LIBSEDML_OPERATION_SUCCESS);
+  std::vector< std::vector<double> > buffers;
+  size_t numPoints = 0;
+  REQUIRE(store.bindVariables(scaled, compiled, buffers, numPoints)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(numPoints == 3);
+  std::vector<double> result(numPoints);
+  compiled.evaluate(numPoints, &result[0]);
+  CHECK(result[1] == Approx(exp(-1.0)));
+
+  REQUIRE(store.getValues(timeVar, values, buffer)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(values.size() == 3);
+  CHECK(values[2] == 2);
+
+  variables[2]->setDimensionTerm("KISAO:0000000");
+  CHECK(store.getValues(variables[2], values, buffer)
+    == LIBSEDML_INVALID_ATTRIBUTE_VALUE);
+
+  store.removeTask("scan");
+  CHECK(store.getSeries(variables[0]) == NULL);
+  CHECK(store.getValues(variables[0], values, buffer)
+    == LIBSEDML_OPERATION_FAILED);
+
+  delete sbml;
+}
+
+TEST_CASE("Report data is exported while iterations finish", "[sedml]")
+{
+  SedDocument doc(1, 4);
+
+  SedModel* model = doc.createModel();
+  model->setId("m");
+  model->setSource("urn:test:model");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setInitialTime(0);
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(2);
+  sim->setNumberOfSteps(2);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* t1 = doc.createTask();
+  t1->setId("t1");
+  t1->setModelReference("m");
+  t1->setSimulationReference("sim");
+
+  SedRepeatedTask* scan = doc.createRepeatedTask();
+  scan->setId("scan");
+  scan->setResetModel(true);
+  scan->setRangeId("r");
+  SedVectorRange* range = scan->createVectorRange();
+  range->setId("r");
+  for (int i = 1; i <= 4; ++i) range->addValue(i);
+  SedSetValue* change = scan->createTaskChange();
+  change->setModelReference("m");
+  change->setTarget(
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k']");
+  change->setRange("r");
+  ASTNode* math = SBML_parseL3Formula("r");
+  change->setMath(math);
+  delete math;
+  scan->createSubTask()->setTask("t1");
+
+  SedDataGenerator* time = doc.createDataGenerator();
+  time->setId("dg_time");
+  SedVariable* var = time->createVariable();
+  var->setId("time");
+  var->setTaskReference("scan");
+  var->setSymbol("urn:sedml:symbol:time");
+  math = SBML_parseL3Formula("time");
+  time->setMath(math);
+  delete math;
+
+  SedDataGenerator* k = doc.createDataGenerator();
+  k->setId("dg_k");
+  k->setName("k");
+  var = k->createVariable();
+  var->setId("k");
+  var->setTaskReference("scan");
+  var->setTarget(
+    "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k']/@value");
+  math = SBML_parseL3Formula("k");
+  k->setMath(math);
+  delete math;
+
+  SedReport* report = doc.createReport();
+  report->setId("report");
+  SedDataSet* dataSet = report->createDataSet();
+  dataSet->setId("ds_time");
+  dataSet->setLabel("time");
+  dataSet->setDataReference("dg_time");
+  dataSet = report->createDataSet();
+  dataSet->setId("ds_k");
+  dataSet->setLabel("k, scanned");
+  dataSet->setDataReference("dg_k");
+
+  SedPlot2D* plot = doc.createPlot2D();
+  plot->setId("plot");
+  for (int i = 0; i < 2; ++i)
+  {
+    SedCurve* curve = plot->createCurve();
+    curve->setXDataReference("dg_time");
+    curve->setYDataReference(i == 0 ? "dg_k" : "dg_time");
+  }
+
+  XMLNode* sbml = XMLNode::convertStringToXMLNode(
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    "<model id='m'><listOfParameters>"
+    "<parameter id='k' value='1' constant='true'/>"
+    "</listOfParameters></model></sbml>");
+  REQUIRE(sbml != NULL);
+
+  SedTaskExecutor executor(&doc);
+  executor.getModelBuilder().setModelSource("urn:test:model", *sbml);
+  executor.registerSimulator("",
+    []() -> SedSimulator* { return new SedMockSimulator(); });
+  executor.setNumThreads(2);
+
+  // iterations are written in order as they finish, and then discarded
+  std::ostringstream csv;
+  SedReportWriter writer;
+  writer.setChunkSize(8);
+  REQUIRE(writer.open(csv) == LIBSEDML_OPERATION_SUCCESS);
+
+  SedReportExporter exporter(&doc, writer);
+  REQUIRE(exporter.setOutput(report) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(exporter.getNumColumns() == 2);
+  CHECK(exporter.getStreamingTaskId() == "scan");
+
+  executor.setIterationListener(exporter.getIterationListener());
+  executor.setKeepIterations(false);
+  REQUIRE(executor.execute() == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(exporter.getNumPendingIterations() == 0);
+  CHECK(exporter.finish() == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(writer.getNumRows() == 12);
+  REQUIRE(writer.close() == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(executor.getResult("scan")->getChild(3)->getNumChildren() == 0);
+
+  std::vector<std::string> lines;
+  std::istringstream input(csv.str());
+  for (std::string line; std::getline(input, line); ) lines.push_back(line);
+  REQUIRE(lines.size() == 13);
+  CHECK(lines[0] == "time,\"k, scanned\"");
+  CHECK(lines[1] == "0,1");
+  CHECK(lines[4] == "0,2");
+  CHECK(lines[12].substr(0, 2) == "2,");
+  CHECK(strtod(lines[12].c_str() + 2, NULL) == 4 * exp(-2.0));
+
+  // iterations that arrive early are held back
+  SedTaskResult first, second;
+  first.createChild()->addColumn("time").push_back(0);
+  first.getChild(0)->addColumn("k").push_back(1.5);
+  second.createChild()->addColumn("time").push_back(0);
+  second.getChild(0)->addColumn("k").push_back(0.1);
+
+  std::ostringstream rows;
+  REQUIRE(writer.open(rows) == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(exporter.setOutput(report) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(exporter.writeIteration(scan, 1, second) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(exporter.getNumPendingIterations() == 1);
+  CHECK(exporter.finish() == LIBSEDML_OPERATION_FAILED);
+  CHECK(exporter.writeIteration(scan, 0, first) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(exporter.writeIteration(scan, 0, first) == LIBSEDML_INDEX_EXCEEDS_SIZE);
+  CHECK(exporter.finish() == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(writer.close() == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(rows.str() == "time,\"k, scanned\"\n0,1.5\n0,0.1\n");
+
+  // plots export each data generator once, in a binary file
+  SedResultStore store;
+  executor.setResultStore(&store);
+  executor.setIterationListener(SedTaskExecutor::IterationListener());
+  executor.setKeepIterations(true);
+  REQUIRE(executor.execute() == LIBSEDML_OPERATION_SUCCESS);
+
+  std::ostringstream binary;
+  writer.setChunkSize(1 << 20);
+  REQUIRE(writer.open(binary, SedReportWriter::FORMAT_BINARY)
+    == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(exporter.setOutput(plot) == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(exporter.getNumColumns() == 2);
+  CHECK(writer.getColumnLabel(0) == "dg_time");
+  CHECK(writer.getColumnLabel(1) == "k");
+  CHECK(exporter.writeResults(store) == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(writer.close() == LIBSEDML_OPERATION_SUCCESS);
+
+  // magic, version, 2 labels, one chunk of 12 rows and the end marker
+  const std::string data = binary.str();
+  REQUIRE(data.size() == 8 + 8 + (4 + 7) + (4 + 1) + 4 + 2 * 12 * 8 + 4);
+  CHECK(data.compare(0, 8, "SEDMLCOL") == 0);
+  double value = 0;
+  data.copy(reinterpret_cast<char*>(&value), sizeof(value), 36 + 15 * 8);
+  CHECK(value == 2);
+
+  CHECK(exporter.setOutput(NULL) == LIBSEDML_INVALID_OBJECT);
+  delete sbml;
+}
+
+
+TEST_CASE("Vector range values round-trip exactly", "[sedml]")
+{
+  SedDocument doc(1, 4);
+  SedRepeatedTask* task = doc.createRepeatedTask();
+  task->setId("scan");
+  task->setRangeId("v");
+  SedVectorRange* range = task->createVectorRange();
+  range->setId("v");
+
+  std::vector<double> values;
+  values.push_back(0.1 + 0.2);
+  values.push_back(1e-7);
+  values.push_back(-123456789.125);
+  values.push_back(5e-324);
+  values.push_back(std::numeric_limits<double>::infinity());
+  values.push_back(3);
+  for (size_t i = 0; i < values.size(); ++i) range->addValue(values[i]);
+
+  std::string xml = writeSedMLToStdString(&doc);
+  CHECK(xml.find("<value> 0.30000000000000004 </value>") != std::string::npos);
+  CHECK(xml.find("<value> 1e-07 </value>") != std::string::npos);
+  CHECK(xml.find("<value> INF </value>") != std::string::npos);
+  CHECK(xml.find("<value> 3 </value>") != std::string::npos);
+
+  SedDocument* plain = readSedMLFromString(xml.c_str());
+  SedVectorRange* read = static_cast<SedVectorRange*>(
+    static_cast<SedRepeatedTask*>(plain->getTask(0))->getRange("v"));
+  REQUIRE(read != NULL);
+  CHECK(read->getValues() == values);
+  CHECK(!read->getUseCompactEncoding());
+  delete plain;
+
+  // the compact form keeps other annotations next to the values
+  range->appendAnnotation("<annotation><tag xmlns=\"urn:test\"/></annotation>");
+  CHECK(range->setUseCompactEncoding(true) == LIBSEDML_OPERATION_SUCCESS);
+  xml = writeSedMLToStdString(&doc);
+  CHECK(xml.find("<value>") == std::string::npos);
+  CHECK(xml.find("encoding=\"base64\"") != std::string::npos);
+
+  SedDocument* compact = readSedMLFromString(xml.c_str());
+  read = static_cast<SedVectorRange*>(
+    static_cast<SedRepeatedTask*>(compact->getTask(0))->getRange("v"));
+  REQUIRE(read != NULL);
+  CHECK(read->getValues() == values);
+  CHECK(read->getUseCompactEncoding());
+  REQUIRE(read->isSetAnnotation());
+  CHECK(read->getAnnotationString().find("urn:test") != std::string::npos);
+  CHECK(read->getAnnotationString().find("base64") == std::string::npos);
+  delete compact;
+
+  // a range whose only annotation was the compact block has none left
+  range->unsetAnnotation();
+  compact = readSedMLFromString(writeSedMLToStdString(&doc).c_str());
+  read = static_cast<SedVectorRange*>(
+    static_cast<SedRepeatedTask*>(compact->getTask(0))->getRange("v"));
+  REQUIRE(read != NULL);
+  CHECK(read->getValues() == values);
+  CHECK(!read->isSetAnnotation());
+  delete compact;
+
+  // blocks whose length does not match their count are reported and kept
+  xml = writeSedMLToStdString(&doc);
+  std::string miscounted = xml;
+  size_t count = miscounted.find("count=\"6\"");
+  REQUIRE(count != std::string::npos);
+  miscounted.replace(count, 9, "count=\"5\"");
+  compact = readSedMLFromString(miscounted.c_str());
+  read = static_cast<SedVectorRange*>(
+    static_cast<SedRepeatedTask*>(compact->getTask(0))->getRange("v"));
+  REQUIRE(read != NULL);
+  CHECK(read->getNumValues() == 0);
+  CHECK(read->getAnnotationString().find("base64") != std::string::npos);
+  CHECK(compact->getErrorLog()->contains(SedmlVectorRangeValueMustBeString));
+  delete compact;
+
+  std::string truncated = xml;
+  size_t end = truncated.find("</values>");
+  REQUIRE(end != std::string::npos);
+  end = truncated.find_last_not_of(" \n", end - 1) + 1;
+  truncated.erase(end - 4, 4);
+  compact = readSedMLFromString(truncated.c_str());
+  read = static_cast<SedVectorRange*>(
+    static_cast<SedRepeatedTask*>(compact->getTask(0))->getRange("v"));
+  REQUIRE(read != NULL);
+  CHECK(read->getNumValues() == 0);
+  CHECK(compact->getErrorLog()->contains(SedmlVectorRangeValueMustBeString));
+  delete compact;
+}
+
+
+TEST_CASE("Documents are written to buffers, sinks and file descriptors", "[sedml]")
+{
+  SedDocument doc(1, 4);
+  for (int i = 0; i < 50; ++i)
+  {
+    SedModel* model = doc.createModel();
+    model->setId("model" + std::to_string(i));
+    model->setLanguage("urn:sedml:language:sbml");
+    model->setSource("model.xml");
+  }
+
+  SedWriter writer;
+  const std::string xml = writer.writeSedMLToStdString(&doc);
+  REQUIRE(!xml.empty());
+  CHECK(writer.estimateSize(&doc) > xml.size() / 2);
+  CHECK(writer.estimateSize(NULL) == 0);
+
+  // appends to the buffer, without reallocating reserved storage
+  std::string buffer = "<!-- -->";
+  buffer.reserve(buffer.size() + writer.estimateSize(&doc));
+  const char* storage = buffer.data();
+  REQUIRE(writer.writeSedMLToBuffer(&doc, buffer));
+  CHECK(buffer == "<!-- -->" + xml);
+  if (xml.size() < writer.estimateSize(&doc)) CHECK(buffer.data() == storage);
+
+  std::string chunks;
+  size_t numChunks = 0;
+  SedWriter::ChunkSink sink = [&](const char* data, size_t length)
+  {
+    chunks.append(data, length);
+    ++numChunks;
+    return true;
+  };
+  REQUIRE(writer.writeSedMLToSink(&doc, sink, 100));
+  CHECK(chunks == xml);
+  CHECK(numChunks >= xml.size() / 100);
+
+  // a sink that gives up fails the write
+  unsigned int numErrors = doc.getNumErrors();
+  SedWriter::ChunkSink failing = [](const char*, size_t) { return false; };
+  CHECK(!writer.writeSedMLToSink(&doc, failing, 100));
+  CHECK(doc.getNumErrors() == numErrors + 1);
+
+  FILE* file = tmpfile();
+  REQUIRE(file != NULL);
+  REQUIRE(writer.writeSedMLToFileDescriptor(&doc, fileno(file)));
+  rewind(file);
+  std::string written;
+  char data[4096];
+  for (size_t n; (n = fread(data, 1, sizeof(data), file)) > 0; )
+  {
+    written.append(data, n);
+  }
+  fclose(file);
+  CHECK(written == xml);
+  CHECK(!writer.writeSedMLToFileDescriptor(&doc, -1));
+}
+
+
+TEST_CASE("Copy-on-write clones share untouched elements", "[sedml]")
+{
+  SedDocument* original = new SedDocument(1, 4);
+  for (int i = 0; i < 10; ++i)
+  {
+    SedModel* model = original->createModel();
+    model->setId("m" + std::to_string(i));
+    model->setLanguage("urn:sedml:language:sbml");
+    model->setSource("model.xml");
+    model->setNotes("<p xmlns=\"http://www.w3.org/1999/xhtml\">template</p>");
+    SedChangeAttribute* change = model->createChangeAttribute();
+    change->setTarget("/sbml:sbml/sbml:model/@name");
+    change->setNewValue("v" + std::to_string(i));
+
+    SedDataGenerator* dg = original->createDataGenerator();
+    dg->setId("dg" + std::to_string(i));
+    SedVariable* variable = dg->createVariable();
+    variable->setId("x" + std::to_string(i));
+    variable->setTaskReference("t");
+  }
+  const std::string xml = writeSedMLToStdString(original);
+
+  SedDocument* copy = original->cloneCopyOnWrite();
+  CHECK(copy->getListOfModels()->getSharesItems());
+  CHECK(copy->getListOfDataGenerators()->getSharesItems());
+
+  // changing one model only copies the models, not their changes
+  SedModel* model = copy->getModel("m3");
+  REQUIRE(model != NULL);
+  CHECK(model != original->getModel("m3"));
+  CHECK(model->getSedDocument() == copy);
+  CHECK(model->getParentSedObject() == copy->getListOfModels());
+  CHECK(!copy->getListOfModels()->getSharesItems());
+  CHECK(copy->getModel(0)->getListOfChanges()->getSharesItems());
+  CHECK(copy->getListOfDataGenerators()->getSharesItems());
+  model->setSource("changed.xml");
+  static_cast<SedChangeAttribute*>(model->getChange(0))->setNewValue("w");
+  CHECK(!model->getListOfChanges()->getSharesItems());
+  CHECK(copy->getModel(4)->getListOfChanges()->getSharesItems());
+
+  CHECK(writeSedMLToStdString(original) == xml);
+  const std::string changed = writeSedMLToStdString(copy);
+  CHECK(changed != xml);
+  CHECK(changed.find("changed.xml") != std::string::npos);
+  CHECK(changed.find("newValue=\"w\"") != std::string::npos);
+  CHECK(copy->getElementBySId("x7") != original->getElementBySId("x7"));
+
+  // a copy of a copy shares with the original as well, and a plain clone
+  // is independent of both
+  SedDocument* second = copy->cloneCopyOnWrite();
+  SedDocument* independent = second->clone();
+  CHECK(!independent->getListOfModels()->getSharesItems());
+  CHECK(writeSedMLToStdString(second) == changed);
+  delete second;
+  delete copy;
+  delete original;
+  CHECK(writeSedMLToStdString(independent) == changed);
+  delete independent;
+}
+
+
+TEST_CASE("Copy-on-write clones outlive their template", "[sedml]")
+{
+  SedDocument* original = new SedDocument(1, 4);
+  for (int i = 0; i < 5; ++i)
+  {
+    SedModel* model = original->createModel();
+    model->setId("m" + std::to_string(i));
+    model->setLanguage("urn:sedml:language:sbml");
+    model->setSource("model.xml");
+    SedChangeAttribute* change = model->createChangeAttribute();
+    change->setTarget("/sbml:sbml/sbml:model/@name");
+    change->setNewValue("v" + std::to_string(i));
+  }
+  const std::string xml = writeSedMLToStdString(original);
+
+  SedDocument* copy = original->cloneCopyOnWrite();
+  delete original;
+
+  // the store took over the items of the template, and even const reads
+  // return elements that belong to the clone
+  const SedDocument* readOnly = copy;
+  CHECK(copy->getListOfModels()->getSharesItems());
+  CHECK(readOnly->getNumModels() == 5);
+  CHECK(!copy->getListOfModels()->getSharesItems());
+  REQUIRE(readOnly->getModel(2) != NULL);
+  CHECK(readOnly->getModel(2)->getId() == "m2");
+  CHECK(readOnly->getModel(2)->getSedDocument() == copy);
+  REQUIRE(readOnly->getModel("m4") != NULL);
+  CHECK(readOnly->getModel("m4")->getNumChanges() == 1);
+  CHECK(readOnly->getModel("m4")->getChange(0)->getParentSedObject()
+    == readOnly->getModel("m4")->getListOfChanges());
+  CHECK(writeSedMLToStdString(copy) == xml);
+
+  SedModel* model = copy->getModel("m1");
+  REQUIRE(model != NULL);
+  CHECK(model->getSedDocument() == copy);
+  model->setSource("changed.xml");
+  SedBase* element = copy->getElementBySId("m3");
+  REQUIRE(element != NULL);
+  CHECK(element->getSedDocument() == copy);
+  CHECK(writeSedMLToStdString(copy).find("changed.xml") != std::string::npos);
+  delete copy;
+}
+
+
+TEST_CASE("Copy-on-write clones leave their template untouched", "[sedml]")
+{
+  SedDocument* original = new SedDocument(1, 4);
+  for (int i = 0; i < 5; ++i)
+  {
+    SedModel* model = original->createModel();
+    model->setId("m" + std::to_string(i));
+    model->setLanguage("urn:sedml:language:sbml");
+    model->setSource("model.xml");
+    SedChangeAttribute* change = model->createChangeAttribute();
+    change->setTarget("/sbml:sbml/sbml:model/@name");
+    change->setNewValue("v" + std::to_string(i));
+  }
+  const std::string xml = writeSedMLToStdString(original);
+  SedModel* m2 = original->getModel(2);
+
+  SedDocument* copy = original->cloneCopyOnWrite();
+
+  // the template keeps its elements, which still belong to it
+  const SedDocument* constOriginal = original;
+  CHECK(constOriginal->getModel(2) == m2);
+  CHECK(m2->getSedDocument() == original);
+  CHECK(m2->getParentSedObject() == original->getListOfModels());
+  CHECK(m2->getChange(0)->getSedDocument() == original);
+
+  // elements read through the copy belong to the copy
+  const SedDocument* constCopy = copy;
+  const SedModel* c2 = constCopy->getModel(2);
+  REQUIRE(c2 != NULL);
+  CHECK(c2 != m2);
+  CHECK(c2->getSedDocument() == copy);
+  CHECK(c2->getParentSedObject() == copy->getListOfModels());
+  REQUIRE(c2->getChange(0) != NULL);
+  CHECK(c2->getChange(0)->getSedDocument() == copy);
+  CHECK(c2->getChange(0)->getParentSedObject() == c2->getListOfChanges());
+
+  // changing the template, also below lists the copy has not read yet,
+  // leaves the copy alone
+  original->getModel(2)->setSource("changed.xml");
+  static_cast<SedChangeAttribute*>(original->getModel(3)->getChange(0))
+    ->setNewValue("w");
+  CHECK(original->getModel(2) == m2);
+  CHECK(writeSedMLToStdString(copy) == xml);
+  const std::string changed = writeSedMLToStdString(original);
+  CHECK(changed.find("changed.xml") != std::string::npos);
+  CHECK(changed.find("newValue=\"w\"") != std::string::npos);
+
+  // several threads may copy the same template
+  std::vector<std::string> written(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < written.size(); ++i)
+  {
+    threads.push_back(std::thread([&, i]()
+    {
+      SedDocument* clone = constOriginal->cloneCopyOnWrite();
+      written[i] = writeSedMLToStdString(clone);
+      delete clone;
+    }));
+  }
+  for (size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+  }
+  for (size_t i = 0; i < written.size(); ++i)
+  {
+    CHECK(written[i] == changed);
+  }
+
+  delete copy;
+  CHECK(writeSedMLToStdString(original) == changed);
+  delete original;
+}
+
+
+namespace
+{
+  class CountingVisitor : public SedVisitor
+  {
+  public:
+    using SedVisitor::visit;
+    using SedVisitor::leave;
+
+    CountingVisitor()
+      : documents(0), elements(0), lists(0), depth(0), maxDepth(0) {}
+
+    virtual void visit(const SedDocument&) { ++documents; }
+    virtual void leave(const SedDocument&) { --documents; }
+
+    virtual bool visit(const SedBase& x)
+    {
+      ++elements;
+      order.push_back(&x);
+      return false;
+    }
+
+    virtual void visit(const SedListOf& x, int)
+    {
+      ++lists;
+      order.push_back(&x);
+      if (++depth > maxDepth) maxDepth = depth;
+    }
+
+    virtual void leave(const SedListOf&, int) { --depth; }
+
+    int documents;
+    unsigned int elements;
+    unsigned int lists;
+    int depth;
+    int maxDepth;
+    std::vector<const SedBase*> order;
+  };
+}
+
+
+TEST_CASE("Visitors and element iterators walk the whole document", "[sedml]")
+{
+  SedDocument doc(1, 4);
+  SedModel* model = doc.createModel();
+  model->setId("model");
+  model->createChangeAttribute()->setTarget("/sbml:sbml");
+  doc.createUniformTimeCourse()->setId("sim");
+  doc.getSimulation(0)->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->setId("repeated");
+  SedUniformRange* range = repeated->createUniformRange();
+  range->setId("range");
+  SedSetValue* setValue = repeated->createTaskChange();
+  setValue->setModelReference("model");
+  setValue->createVariable()->setId("v0");
+  repeated->createSubTask()->setTask("task");
+
+  SedPlot2D* plot = doc.createPlot2D();
+  plot->setId("plot");
+  plot->createXAxis()->setType("linear");
+  plot->createCurve()->setId("curve");
+
+  // the base class axes used to be missing
+  List* all = doc.getAllElements();
+  std::vector<const SedBase*> expected;
+  unsigned int numLists = 0;
+  for (unsigned int i = 0; i < all->getSize(); ++i)
+  {
+    const SedBase* element = static_cast<const SedBase*>(all->get(i));
+    expected.push_back(element);
+    if (element->getTypeCode() == SEDML_LIST_OF) ++numLists;
+  }
+  delete all;
+  CHECK(std::find(expected.begin(), expected.end(), plot->getXAxis())
+        != expected.end());
+
+  CountingVisitor visitor;
+  CHECK(doc.accept(visitor));
+  CHECK(visitor.documents == 0);
+  CHECK(visitor.depth == 0);
+  CHECK(visitor.maxDepth == 3);
+  CHECK(visitor.lists == numLists);
+  CHECK(visitor.elements + visitor.lists == expected.size());
+  CHECK(visitor.order == expected);
+
+  std::vector<const SedBase*> iterated;
+  unsigned int maxDepth = 0;
+  SedElementRange<const SedBase> elements(&doc);
+  for (SedElementIterator<const SedBase> it = elements.begin();
+       it != elements.end(); ++it)
+  {
+    iterated.push_back(*it);
+    maxDepth = std::max(maxDepth, it.getDepth());
+  }
+  CHECK(iterated == expected);
+  CHECK(maxDepth == 6);
+
+  std::vector<const SedBase*> visited;
+  forEachElement(&doc, [&](SedBase* element) { visited.push_back(element); });
+  CHECK(visited == expected);
+
+  // walking a single element only covers what it contains
+  unsigned int count = 0;
+  forEachElement(static_cast<const SedBase*>(setValue),
+                 [&](const SedBase*) { ++count; });
+  CHECK(count == 2);
+  CHECK(setValue->getNumChildElements() == 1);
+  CHECK(setValue->getChildElement(0) == setValue->getListOfVariables());
+  CHECK(setValue->getChildElement(1) == NULL);
+  CHECK(range->getNumChildElements() == 0);
+}
+
+
+TEST_CASE("The validator checks references, cardinality and styles", "[sedml]")
+{
+  SedDocument doc(1, 4);
+  SedModel* model = doc.createModel();
+  model->setId("model");
+  SedUniformTimeCourse* simulation = doc.createUniformTimeCourse();
+  simulation->setId("sim");
+  simulation->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setModelReference("model");
+  task->setSimulationReference("model");
+
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->setId("repeated");
+  repeated->setRangeId("range");
+  repeated->createUniformRange()->setId("range");
+  SedSetValue* setValue = repeated->createTaskChange();
+  setValue->setModelReference("model");
+  setValue->setRange("task");
+
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("dg");
+  SedVariable* variable = dg->createVariable();
+  variable->setId("time");
+  variable->setTaskReference("repeated");
+  ASTNode* math = SBML_parseL3Formula("time");
+  dg->setMath(math);
+  delete math;
+
+  SedPlot2D* plot = doc.createPlot2D();
+  plot->setId("plot");
+  SedCurve* curve = plot->createCurve();
+  curve->setId("curve");
+  curve->setXDataReference("dg");
+  curve->setYDataReference("missing");
+  curve->setStyle("red");
+
+  SedStyle* red = doc.createStyle();
+  red->setId("red");
+  red->setBaseStyle("blue");
+  SedStyle* blue = doc.createStyle();
+  blue->setId("blue");
+  blue->setBaseStyle("red");
+  doc.createStyle()->setId("dg");
+
+  SedValidator validator;
+  validator.setNumThreads(1);
+  REQUIRE(validator.validate(&doc) == 8);
+
+  std::vector<unsigned int> codes;
+  for (unsigned int n = 0; n < validator.getNumFailures(); ++n)
+  {
+    codes.push_back(validator.getFailure(n)->getErrorId());
+  }
+  std::vector<unsigned int> expected = {
+    SedmlTaskSimulationReferenceMustBeSimulation,
+    SedmlRepeatedTaskAllowedElements,
+    SedmlSetValueRangeMustBeRange,
+    SedmlSetValueAllowedElements,
+    SedmlCurveYDataReferenceMustBeDataGenerator,
+    SedmlStyleBaseStyleMustNotBeCircular,
+    SedmlStyleBaseStyleMustNotBeCircular,
+    SedmlDuplicateComponentId,
+  };
+  CHECK(codes == expected);
+  CHECK(validator.getFailure(8) == NULL);
+  CHECK(validator.getFailure(4)->getMessage().find("'missing'")
+        != std::string::npos);
+
+  // the rule groups can be checked separately, on any number of threads
+  validator.setRuleGroups(SedValidator::RULES_IDENTIFIERS);
+  REQUIRE(validator.validate(&doc) == 1);
+  CHECK(validator.getFailure(0)->getErrorId() == SedmlDuplicateComponentId);
+  CHECK(validator.getFailure(0)->getMessage().find("<dataGenerator>")
+        != std::string::npos);
+
+  validator.setRuleGroups(SedValidator::RULES_ALL);
+  validator.setNumThreads(4);
+  REQUIRE(validator.validate(&doc) == 8);
+  for (unsigned int n = 0; n < validator.getNumFailures(); ++n)
+  {
+    CHECK(validator.getFailure(n)->getErrorId() == codes[n]);
+  }
+
+  // checkConsistency() reports into the error log of the document
+  unsigned int numErrors = doc.getNumErrors();
+  CHECK(doc.checkConsistency() == 8);
+  CHECK(doc.getNumErrors() == numErrors + 8);
+  CHECK(doc.getErrorLog()->contains(SedmlSetValueRangeMustBeRange));
+
+  delete doc.removeStyle("dg");
+  task->setSimulationReference("sim");
+  repeated->createSubTask()->setTask("task");
+  setValue->setRange("range");
+  math = SBML_parseL3Formula("range");
+  setValue->setMath(math);
+  delete math;
+  curve->setYDataReference("dg");
+  blue->unsetBaseStyle();
+  CHECK(validator.validate(&doc) == 0);
+}
+
+
+TEST_CASE("Revalidating only checks the elements affected by changes", "[sedml]")
+{
+  SedDocument doc(1, 4);
+  doc.createModel()->setId("model");
+  SedUniformTimeCourse* simulation = doc.createUniformTimeCourse();
+  simulation->setId("sim");
+  simulation->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setModelReference("model");
+  task->setSimulationReference("sim");
+
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("dg");
+  SedVariable* variable = dg->createVariable();
+  variable->setId("time");
+  variable->setTaskReference("task");
+  ASTNode* math = SBML_parseL3Formula("time");
+  dg->setMath(math);
+  delete math;
+
+  SedPlot2D* plot = doc.createPlot2D();
+  plot->setId("plot");
+  SedCurve* curve = plot->createCurve();
+  curve->setId("curve");
+  curve->setXDataReference("dg");
+  curve->setYDataReference("dg");
+  curve->setStyle("red");
+  SedCurve* other = plot->createCurve();
+  other->setId("other");
+  other->setXDataReference("dg");
+  other->setYDataReference("dg");
+  SedDataSet* dataSet = doc.createReport()->createDataSet();
+  dataSet->setId("ds");
+  dataSet->setDataReference("dg");
+
+  SedStyle* red = doc.createStyle();
+  red->setId("red");
+  SedStyle* blue = doc.createStyle();
+  blue->setId("blue");
+
+  // the result of revalidate() has to match checking the whole document
+  SedValidator validator;
+  SedValidator full;
+  auto matchesFull = [&]()
+  {
+    full.setRuleGroups(validator.getRuleGroups());
+    if (full.validate(&doc) != validator.getNumFailures()) return false;
+    for (unsigned int n = 0; n < full.getNumFailures(); ++n)
+    {
+      if (full.getFailure(n)->getErrorId()
+            != validator.getFailure(n)->getErrorId()
+          || full.getFailure(n)->getMessage()
+            != validator.getFailure(n)->getMessage())
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  REQUIRE(validator.revalidate(&doc) == 0);
+  CHECK(!validator.wasIncremental());
+  CHECK(doc.getTrackChanges());
+  CHECK(!curve->hasChanges());
+  CHECK(validator.getTotalTime() >= validator.getCheckTime());
+
+  // changing a reference only checks the element itself
+  curve->setYDataReference("missing");
+  CHECK(curve->getChanges() == SedBase::CHANGE_REFERENCES);
+  REQUIRE(validator.revalidate(&doc) == 1);
+  CHECK(validator.wasIncremental());
+  CHECK(validator.getNumCheckedElements() == 1);
+  CHECK(validator.getFailure(0)->getErrorId()
+        == SedmlCurveYDataReferenceMustBeDataGenerator);
+  CHECK(!curve->hasChanges());
+
+  REQUIRE(validator.revalidate(&doc) == 1);
+  CHECK(validator.getNumCheckedElements() == 0);
+
+  // renaming a data generator checks the curves and data sets using it
+  dg->setId("dg2");
+  CHECK(dg->getChanges() == SedBase::CHANGE_ID);
+  REQUIRE(validator.revalidate(&doc) == 5);
+  CHECK(validator.getNumCheckedElements() == 4);
+  CHECK(matchesFull());
+
+  dg->setId("dg");
+  REQUIRE(validator.revalidate(&doc) == 1);
+  CHECK(matchesFull());
+
+  // so does giving another element the same id
+  blue->setId("dg");
+  REQUIRE(validator.revalidate(&doc) == 2);
+  CHECK(validator.getFailure(1)->getErrorId() == SedmlDuplicateComponentId);
+  CHECK(matchesFull());
+  blue->setId("blue");
+  REQUIRE(validator.revalidate(&doc) == 1);
+  CHECK(matchesFull());
+
+  // adding and removing elements
+  SedCurve* added = plot->createCurve();
+  added->setId("added");
+  added->setXDataReference("dg");
+  added->setYDataReference("nothing");
+  REQUIRE(validator.revalidate(&doc) == 2);
+  CHECK(validator.wasIncremental());
+  CHECK(matchesFull());
+  delete plot->removeCurve("added");
+  REQUIRE(validator.revalidate(&doc) == 1);
+  CHECK(matchesFull());
+
+  // base styles that form a cycle, and no longer do
+  red->setBaseStyle("blue");
+  blue->setBaseStyle("red");
+  REQUIRE(validator.revalidate(&doc) == 3);
+  CHECK(matchesFull());
+  blue->unsetBaseStyle();
+  REQUIRE(validator.revalidate(&doc) == 1);
+  CHECK(matchesFull());
+
+  // removing required children
+  dg->unsetMath();
+  simulation->unsetAlgorithm();
+  REQUIRE(validator.revalidate(&doc) == 3);
+  CHECK(validator.getFailure(0)->getErrorId() == SedmlSimulationAllowedElements);
+  CHECK(matchesFull());
+
+  // other rule groups start over
+  validator.setRuleGroups(SedValidator::RULES_REFERENCES);
+  REQUIRE(validator.revalidate(&doc) == 1);
+  CHECK(!validator.wasIncremental());
+  CHECK(matchesFull());
+}
+
+TEST_CASE("The objective of a parameter estimation task is evaluated", "[sedml]")
+{
+  SedDocument doc(1, 4);
+
+  SedModel* model = doc.createModel();
+  model->setId("m");
+  model->setSource("urn:test:model");
+
+  SedDataDescription* data = doc.createDataDescription();
+  data->setId("data");
+  data->setSource("fit.csv");
+  const char* columns[] = { "time", "x", "w", "k", "ss" };
+  for (int i = 0; i < 5; ++i)
+  {
+    SedDataSource* source = data->createDataSource();
+    source->setId(std::string("data_") + columns[i]);
+    SedSlice* slice = source->createSlice();
+    slice->setReference("columns");
+    slice->setValue(columns[i]);
+  }
+
+  const char* targets[] = { "x", "k" };
+  for (int i = 0; i < 2; ++i)
+  {
+    SedDataGenerator* dg = doc.createDataGenerator();
+    dg->setId(std::string("dg_") + targets[i]);
+    SedVariable* variable = dg->createVariable();
+    variable->setId(std::string("v") + targets[i]);
+    variable->setModelReference("m");
+    variable->setTarget(std::string("/sbml:sbml/sbml:model/sbml:listOfParameters"
+                                    "/sbml:parameter[@id='") + targets[i] + "']");
+    ASTNode* math = SBML_parseL3Formula(variable->getId().c_str());
+    dg->setMath(math);
+    delete math;
+  }
+
+  SedParameterEstimationTask* task = doc.createParameterEstimationTask();
+  task->setId("fit");
+  task->createLeastSquareObjectiveFunction();
+
+  SedAdjustableParameter* parameter = task->createAdjustableParameter();
+  parameter->setModelReference("m");
+  parameter->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters"
+                       "/sbml:parameter[@id='x']");
+  parameter->setInitialValue(1);
+  SedBounds* bounds = parameter->createBounds();
+  bounds->setScale(SEDML_SCALETYPE_LOG);
+  bounds->setLowerBound(0.1);
+  bounds->setUpperBound(10);
+  parameter->createExperimentReference()->setExperimentId("course");
+
+  SedFitExperiment* course = task->createFitExperiment();
+  course->setId("course");
+  course->setType(SEDML_EXPERIMENTTYPE_TIMECOURSE);
+  course->createAlgorithm()->setKisaoID("KISAO:0000019");
+  SedFitMapping* mapping = course->createFitMapping();
+  mapping->setType(SEDML_MAPPINGTYPE_TIME);
+  mapping->setDataSource("data_time");
+  mapping = course->createFitMapping();
+  mapping->setType(SEDML_MAPPINGTYPE_OBSERVABLE);
+  mapping->setDataSource("data_x");
+  mapping->setTarget("dg_x");
+  mapping->setPointWeight("data_w");
+
+  SedFitExperiment* steady = task->createFitExperiment();
+  steady->setId("steady");
+  steady->setType(SEDML_EXPERIMENTTYPE_STEADYSTATE);
+  steady->createAlgorithm()->setKisaoID("KISAO:0000019");
+  mapping = steady->createFitMapping();
+  mapping->setType(SEDML_MAPPINGTYPE_EXPERIMENTALCONDITION);
+  mapping->setDataSource("data_k");
+  mapping->setTarget("dg_k");
+  mapping = steady->createFitMapping();
+  mapping->setType(SEDML_MAPPINGTYPE_OBSERVABLE);
+  mapping->setDataSource("data_ss");
+  mapping->setTarget("dg_x");
+  mapping->setWeight(2);
+
+  XMLNode* sbml = XMLNode::convertStringToXMLNode(
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    "<model id='m'><listOfParameters>"
+    "<parameter id='k' value='1' constant='true'/>"
+    "<parameter id='x' value='1' constant='true'/>"
+    "</listOfParameters></model></sbml>");
+  REQUIRE(sbml != NULL);
+
+  // x decays from its initial value, and is 0 at steady state
+  SedObjectiveEvaluator evaluator(&doc);
+  evaluator.getModelBuilder().setModelSource("urn:test:model", *sbml);
+  evaluator.getDataLoader().setSourceContents("fit.csv",
+    "time,x,w,k,ss\n"
+    "0,3,2,1,0.5\n"
+    "1,1.1036383235143269,2,2,0.25\n"
+    "2,0.40600584970983811,2,3,0\n");
+
+  double objective = 0;
+  CHECK(evaluator.evaluate(NULL, objective) == LIBSEDML_INVALID_OBJECT);
+  CHECK(evaluator.bind("fit") == LIBSEDML_INVALID_OBJECT);
+
+  evaluator.registerSimulator("KISAO:0000019",
+    []() -> SedSimulator* { return new SedMockSimulator(); });
+  CHECK(evaluator.bind("m") == LIBSEDML_INVALID_OBJECT);
+  REQUIRE(evaluator.bind("fit") == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(evaluator.getTask() == task);
+
+  REQUIRE(evaluator.getNumParameters() == 1);
+  CHECK(evaluator.getParameter(0) == parameter);
+  CHECK(evaluator.getScale(0) == SEDML_SCALETYPE_LOG);
+  double value, lower, upper;
+  evaluator.getInitialValues(&value);
+  evaluator.getLowerBounds(&lower);
+  evaluator.getUpperBounds(&upper);
+  CHECK(value == 0);
+  CHECK(lower == Approx(log(0.1)));
+  CHECK(upper == Approx(log(10.0)));
+  CHECK(SedObjectiveEvaluator::toModelValue(2, SEDML_SCALETYPE_LOG10) == Approx(100));
+  CHECK(std::isnan(SedObjectiveEvaluator::toScaledValue(0, SEDML_SCALETYPE_LOG)));
+
+  REQUIRE(evaluator.getNumExperiments() == 2);
+  CHECK(evaluator.getExperiment(1) == steady);
+  CHECK(evaluator.getNumPoints(0) == 3);
+  CHECK(evaluator.getResidualOffset(1) == 3);
+  REQUIRE(evaluator.getNumResiduals() == 6);
+
+  // the steady state experiment contributes (2 * 0.5)^2 + (2 * 0.25)^2
+  std::vector<double> residuals(6);
+  evaluator.setNumThreads(2);
+  REQUIRE(evaluator.evaluate(&value, objective, &residuals[0])
+    == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(residuals[0] == Approx(-4));
+  CHECK(residuals[2] == Approx(-4 * exp(-2.0)));
+  CHECK(residuals[3] == Approx(-1));
+  CHECK(residuals[5] == 0);
+  CHECK(objective == Approx(16 * (1 + exp(-2.0) + exp(-4.0)) + 1.25));
+
+  value = log(3.0);
+  REQUIRE(evaluator.evaluate(&value, objective) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(objective == Approx(1.25));
+  CHECK(evaluator.getNumEvaluations() == 2);
+
+  // the experiments can be run on a pool of their own
+  SedWorkStealingPool pool(2);
+  evaluator.setThreadPool(&pool);
+  CHECK(evaluator.getThreadPool() == &pool);
+  REQUIRE(evaluator.evaluate(&value, objective) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(objective == Approx(1.25));
+  evaluator.setThreadPool(NULL);
+
+  // data that do not fit together are refused
+  evaluator.getDataLoader().setSourceContents("fit.csv",
+    "time,x,w,k,ss\n2,3,2,1,0.5\n1,1,2,2,0.25\n");
+  CHECK(evaluator.bind("fit") == LIBSEDML_INVALID_ATTRIBUTE_VALUE);
+  CHECK(evaluator.getTask() == NULL);
+  CHECK(evaluator.getNumResiduals() == 0);
+
+  delete sbml;
+}
+
+TEST_CASE("Parameters are estimated from several starts at once", "[sedml]")
+{
+  SedDocument doc(1, 4);
+
+  SedModel* model = doc.createModel();
+  model->setId("m");
+  model->setSource("urn:test:model");
+
+  SedDataDescription* data = doc.createDataDescription();
+  data->setId("data");
+  data->setSource("fit.csv");
+  const char* columns[] = { "time", "x" };
+  for (int i = 0; i < 2; ++i)
+  {
+    SedDataSource* source = data->createDataSource();
+    source->setId(std::string("data_") + columns[i]);
+    SedSlice* slice = source->createSlice();
+    slice->setReference("columns");
+    slice->setValue(columns[i]);
+  }
+
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("dg_x");
+  SedVariable* variable = dg->createVariable();
+  variable->setId("vx");
+  variable->setModelReference("m");
+  variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters"
+                      "/sbml:parameter[@id='x']");
+  ASTNode* math = SBML_parseL3Formula("vx");
+  dg->setMath(math);
+  delete math;
+
+  SedParameterEstimationTask* task = doc.createParameterEstimationTask();
+  task->setId("fit");
+  task->createLeastSquareObjectiveFunction();
+  SedAlgorithm* algorithm = task->createAlgorithm();
+  algorithm->setKisaoID("KISAO:0000514");
+  SedAlgorithmParameter* seed = algorithm->createAlgorithmParameter();
+  seed->setKisaoID("KISAO:0000488");
+  seed->setValue("42");
+  SedAlgorithmParameter* tolerance = algorithm->createAlgorithmParameter();
+  tolerance->setKisaoID("KISAO:0000211");
+  tolerance->setValue("1e-9");
+
+  SedAdjustableParameter* parameter = task->createAdjustableParameter();
+  parameter->setId("px");
+  parameter->setModelReference("m");
+  parameter->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters"
+                       "/sbml:parameter[@id='x']");
+  parameter->setInitialValue(1);
+  SedBounds* bounds = parameter->createBounds();
+  bounds->setScale(SEDML_SCALETYPE_LOG);
+  bounds->setLowerBound(0.1);
+  bounds->setUpperBound(10);
+  parameter->createExperimentReference()->setExperimentId("course");
+
+  SedFitExperiment* course = task->createFitExperiment();
+  course->setId("course");
+  course->setType(SEDML_EXPERIMENTTYPE_TIMECOURSE);
+  course->createAlgorithm()->setKisaoID("KISAO:0000019");
+  SedFitMapping* mapping = course->createFitMapping();
+  mapping->setType(SEDML_MAPPINGTYPE_TIME);
+  mapping->setDataSource("data_time");
+  mapping = course->createFitMapping();
+  mapping->setType(SEDML_MAPPINGTYPE_OBSERVABLE);
+  mapping->setDataSource("data_x");
+  mapping->setTarget("dg_x");
+
+  XMLNode* sbml = XMLNode::convertStringToXMLNode(
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    "<model id='m'><listOfParameters>"
+    "<parameter id='x' value='1' constant='true'/>"
+    "</listOfParameters></model></sbml>");
+  REQUIRE(sbml != NULL);
+
+  // the data are x = 3 exp(-t)
+  const char* contents =
+    "time,x\n"
+    "0,3\n"
+    "1,1.1036383235143269\n"
+    "2,0.40600584970983811\n";
+
+  // evaluators bound to another one share its data
+  SedObjectiveEvaluator primary(&doc);
+  primary.getModelBuilder().setModelSource("urn:test:model", *sbml);
+  primary.getDataLoader().setSourceContents("fit.csv", contents);
+  primary.registerSimulator("",
+    []() -> SedSimulator* { return new SedMockSimulator(); });
+  SedObjectiveEvaluator worker(&doc);
+  worker.registerSimulator("",
+    []() -> SedSimulator* { return new SedMockSimulator(); });
+  CHECK(worker.bind(primary) == LIBSEDML_INVALID_OBJECT);
+  REQUIRE(primary.bind("fit") == LIBSEDML_OPERATION_SUCCESS);
+  REQUIRE(worker.bind(primary) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(worker.getTask() == task);
+  CHECK(worker.getNumResiduals() == 3);
+
+  double value = log(3.0), objective = 1;
+  REQUIRE(worker.evaluate(&value, objective) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(fabs(objective) < 1e-12);
+  CHECK(worker.getSimulatedValues(0, 0)[1] == Approx(3 * exp(-1.0)));
+  CHECK(worker.getMeasuredValues(0, 0)[2] == Approx(3 * exp(-2.0)));
+  CHECK(primary.getNumEvaluations() == 0);
+  worker.unbind();
+
+  SedPatternSearchOptimizer search;
+  CHECK(search.setAlgorithm(algorithm) == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(search.getTolerance() == 1e-9);
+  value = 0;
+  REQUIRE(search.minimize(primary, &value, objective)
+    == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(exp(value) == Approx(3).epsilon(1e-6));
+  CHECK(search.getNumIterations() > 0);
+
+  SedParameterEstimator estimator(&doc);
+  estimator.getModelBuilder().setModelSource("urn:test:model", *sbml);
+  estimator.getDataLoader().setSourceContents("fit.csv", contents);
+  estimator.registerSimulator("KISAO:0000019",
+    []() -> SedSimulator* { return new SedMockSimulator(); });
+  CHECK(!estimator.hasOptimizer("KISAO:0000514"));
+  CHECK(estimator.estimate("fit") == LIBSEDML_INVALID_OBJECT);
+  CHECK(estimator.getResult("fit") == NULL);
+
+  estimator.registerOptimizer("",
+    []() -> SedOptimizer* { return new SedPatternSearchOptimizer(); });
+  estimator.setNumStarts(5);
+  estimator.setNumThreads(2);
+  REQUIRE(estimator.estimate("fit") == LIBSEDML_OPERATION_SUCCESS);
+
+  const SedTaskResult* result = estimator.getResult("fit");
+  REQUIRE(result != NULL);
+  CHECK(result->getTaskId() == "fit");
+  REQUIRE(result->getNumColumns() == 4);
+  CHECK(result->getColumnName(0) == "start");
+  CHECK(result->getColumnName(1) == "px");
+  CHECK(result->getColumnName(3) == "evaluations");
+  REQUIRE(result->getNumPoints() == 5);
+  CHECK((*result->getColumn("px"))[0] == Approx(3).epsilon(1e-6));
+  CHECK(fabs((*result->getColumn("objective"))[0]) < 1e-9);
+  CHECK((*result->getColumn("objective"))[0]
+    <= (*result->getColumn("objective"))[4]);
+  CHECK((*result->getColumn("evaluations"))[0] > 1);
+
+  REQUIRE(result->getNumChildren() == 1);
+  const SedTaskResult* fitted = result->getChild(0);
+  CHECK(fitted->getTaskId() == "course");
+  REQUIRE(fitted->getNumColumns() == 3);
+  CHECK((*fitted->getColumn("time"))[2] == 2);
+  CHECK((*fitted->getColumn("data_x"))[0] == 3);
+  CHECK((*fitted->getColumn("dg_x"))[2] == Approx(3 * exp(-2.0)).epsilon(1e-6));
+
+  // the starts only depend on the seed, not on the number of threads
+  std::vector<double> starts = *result->getColumn("start");
+  estimator.setNumThreads(1);
+  REQUIRE(estimator.estimate("fit") == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(*estimator.getResult("fit")->getColumn("start") == starts);
+
+  // the starts and their evaluations share the pool they are given
+  SedWorkStealingPool pool(3);
+  estimator.setThreadPool(&pool);
+  estimator.setNumThreads(0);
+  REQUIRE(estimator.estimate("fit") == LIBSEDML_OPERATION_SUCCESS);
+  CHECK(*estimator.getResult("fit")->getColumn("start") == starts);
+  CHECK(pool.getNumThreads() == 3);
+  estimator.setThreadPool(NULL);
+
+  tolerance->setValue("small");
+  CHECK(estimator.estimate("fit") == LIBSEDML_INVALID_ATTRIBUTE_VALUE);
+  CHECK(estimator.getResult("fit") == NULL);
+
+  delete sbml;
+}
+
+TEST_CASE("Work-stealing pools keep their threads between batches", "[sedml]")
+{
+  SedWorkStealingPool pool(2);
+  CHECK(pool.getNumThreads() == 2);
+
+  std::atomic<size_t> sum(0);
+  for (int batch = 0; batch < 100; ++batch)
+  {
+    pool.runJobs(100, 0, [&](size_t n) { sum += n; });
+  }
+  CHECK(sum == 100 * 4950);
+
+  // asking for more threads starts them once
+  pool.runJobs(10, 4, [](size_t) {});
+  CHECK(pool.getNumThreads() == 4);
+
+  // a job running a batch on its own pool runs the jobs itself
+  std::atomic<int> inner(0);
+  pool.runJobs(8, 0, [&](size_t)
+  {
+    pool.runJobs(10, 0, [&](size_t) { ++inner; });
+  });
+  CHECK(inner == 80);
+
+  CHECK_THROWS_AS(pool.runJobs(50, 0, [](size_t n)
+  {
+    if (n == 17) throw std::runtime_error("job failed");
+  }), const std::runtime_error&);
+
+  sum = 0;
+  pool.runJobs(100, 0, [&](size_t n) { sum += n; });
+  CHECK(sum == 4950);
+}